@@ -0,0 +1,1921 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** ASAP2 (A2L) objects of the ELF variables (-a2l).
+**
+** The request names the measurements and the characteristics ("meas=speed+state.*+@meas.txt,char=cal_*"), or an
+** existing A2L file whose addresses are updated ("upd=project.a2l,out=new.a2l"). A name is a variable, a path in a
+** variable ("state.speed", "tab[2].gain", or "tab._2_.gain") or a pattern of variable names.
+**
+** Everything is resolved in one pass over each table, whatever the number of variables:
+**  - the addresses come from the symbol table (hashed by name), the DW_AT_location of the debug information only
+**    breaks the ties between static variables of the same name, or stands for a missing symbol,
+**  - the variables of the debug information are indexed by name from the top-level DIEs of the units only (the
+**    bodies of the functions are skipped by DW_AT_sibling), the types are decoded on request by the lazy DIE
+**    reader (see Dwarf.c) and the members of a structure are decoded once, on its first use.
+** A structure is expanded into one object per member ("state.speed"), an array of scalars is one object with its
+** dimensions (MATRIX_DIM, in declaration order), an array of structures is expanded element by element, a bit-field
+** gets its BIT_MASK. The generated blocks are to be included in the MODULE of a project (/include): the RECORD_LAYOUT
+** of the characteristics are generated with them, the conversion is NO_COMPU_METHOD.
+*******************************************************************************************************************/
+
+#include<A2l.h>
+#include<Dwarf.h>
+#include<Hash.h>
+#include<Vars.h>
+#include<Stats.h>
+#include<io.h>
+#include<ctype.h>
+
+#define A2L_NONE          0xFFFFFFFFUL
+#define A2L_MAX_DIMS      8U          //dimensions of an array
+#define A2L_MAX_DEPTH     16U         //nesting of structures, and chains of typedefs and qualifiers
+#define A2L_MAX_EXPAND    4096U       //objects generated for one variable
+#define A2L_NAME_LEN      512U
+
+//data types of the objects
+#define A2L_UBYTE         0U
+#define A2L_SBYTE         1U
+#define A2L_UWORD         2U
+#define A2L_SWORD         3U
+#define A2L_ULONG         4U
+#define A2L_SLONG         5U
+#define A2L_UINT64        6U
+#define A2L_INT64         7U
+#define A2L_FLOAT32       8U
+#define A2L_FLOAT64       9U
+#define A2L_TYPES         10U
+
+//ASAP2 data type
+typedef struct
+{
+  const char* name;
+  const char* lower;                  //limits of the type
+  const char* upper;
+}sA2lType;
+
+//variable of the debug information: the DIE of its definition, or of its declaration if it is not defined here
+typedef struct
+{
+  const char* name;
+  uint64      die;
+  uint64      address;                //DW_OP_addr (see rank)
+  uint32      hash;
+  uint32      rank;                   //2: address known, 1: defined, 0: declared
+  uint32      located;                //definitions of the name with a known address (static variables)
+}sA2lVar;
+
+//member of a structure (the members of its anonymous structures and unions are flattened into it)
+typedef struct
+{
+  const char* name;
+  uint64      die;
+  uint64      base;                   //offset of the anonymous member holding it
+}sA2lMember;
+
+//members of a structure, sorted by name, decoded on the first use of the structure
+typedef struct
+{
+  uint64      offset;                 //DIE of the structure (DWARF_NONE: free slot)
+  sA2lMember* members;
+  uint32      count;
+}sA2lStruct;
+
+//place of an object: its address and its type, with the array dimensions not indexed yet (type is their element)
+typedef struct
+{
+  uint64    address;
+  sDwarfDie type;                     //tag 0: no debug information
+  uint32    dims[A2L_MAX_DIMS];
+  uint32    DimsNbr;
+  boolean   bitfield;
+  uint32    lsb;
+  uint32    bits;
+}sA2lPlace;
+
+//generated object
+typedef struct
+{
+  char*   name;
+  uint64  address;
+  uint64  mask;                       //BIT_MASK (0: none)
+  uint32  kind;
+  uint32  datatype;
+  uint32  dims[3];                    //MATRIX_DIM
+  uint32  DimsNbr;
+  uint32  bits;                       //width of a bit-field
+}sA2lObject;
+
+//context of a request on one image
+typedef struct
+{
+  sDwarf      dwarf;
+  boolean     debug;                  //the debug information could be read
+  boolean     msb;
+  sElfSymbol* symbols;
+  uint32      SymNbr;
+  uint32*     SymSlots;               //open addressing table of the variable symbols, by name
+  uint32      SymMask;
+  sA2lVar*    vars;
+  uint32      VarsNbr;
+  uint32      VarsCap;
+  uint32*     VarSlots;               //open addressing table of vars, by name
+  uint32      VarMask;
+  sA2lStruct* structs;                //open addressing table of the decoded structures, by DIE offset
+  uint32      StructsNbr;
+  uint32      StructMask;
+  sA2lObject* objects;
+  uint32      ObjectsNbr;
+  uint32      ObjectsCap;
+  uint32      errors;                 //names which cannot be resolved (the report fails)
+  uint32      skipped;                //members of an unsupported type (warnings)
+  sArena      arena;                  //names of the objects, members of the structures
+}sA2l;
+
+static boolean     A2l_AddName(sA2lSpec* spec, uint32 kind, char* name);
+static boolean     A2l_AddList(sA2lSpec* spec, uint32 kind, char* path);
+static boolean     A2l_IsPattern(const char* name);
+static int         A2l_CompareNames(const void* a, const void* b);
+static int         A2l_CompareKey(const void* key, const void* name);
+static uint32      A2l_TableSize(uint32 count);
+static uint32      A2l_OffsetHash(uint64 offset);
+static boolean     A2l_IndexSymbols(sA2l* ctx, sElf* elf);
+static boolean     A2l_IndexVariables(sA2l* ctx);
+static uint32      A2l_FindVar(const sA2l* ctx, const char* name);
+static uint32      A2l_FindSymbol(const sA2l* ctx, const char* name, const sA2lVar* var, uint64* address);
+static boolean     A2l_Strip(sA2l* ctx, uint64 offset, sDwarfDie* die);
+static boolean     A2l_TypeSize(sA2l* ctx, const sDwarfDie* type, uint64* size);
+static boolean     A2l_ArrayDims(sA2l* ctx, sA2lPlace* place);
+static boolean     A2l_Scalar(sA2l* ctx, const sDwarfDie* type, uint32* datatype);
+static boolean     A2l_CollectMembers(sA2l* ctx, const sDwarfDie* type, uint64 base, uint32 depth,
+                                      sA2lMember** members, uint32* count, uint32* capacity);
+static int         A2l_CompareMembers(const void* a, const void* b);
+static const sA2lStruct* A2l_Members(sA2l* ctx, const sDwarfDie* type);
+static boolean     A2l_Member(sA2l* ctx, const sA2lPlace* outer, const sA2lMember* member, sA2lPlace* place);
+static const char* A2l_Step(sA2l* ctx, const char* step, sA2lPlace* place);
+static boolean     A2l_Locate(sA2l* ctx, const char* path, sA2lPlace* place);
+static boolean     A2l_AddObject(sA2l* ctx, const char* name, const sA2lPlace* place, uint32 kind, uint32 datatype);
+static void        A2l_Expand(sA2l* ctx, char* name, size_t length, const sA2lPlace* place, uint32 kind,
+                              uint32 depth, uint32* budget);
+static void        A2l_Select(sA2l* ctx, const char* name, uint32 kind);
+static int         A2l_CompareObjects(const void* a, const void* b);
+static void        A2l_Limits(const sA2lObject* object, char* lower, char* upper, size_t size);
+static boolean     A2l_Write(sA2l* ctx, const sA2lSpec* spec);
+static char*       A2l_Token(char** p, const char* end, size_t* length);
+static boolean     A2l_Update(sA2l* ctx, const sA2lSpec* spec);
+
+static const sA2lType A2lTypes[A2L_TYPES] =
+{
+  {"UBYTE",        "0",                    "255"},
+  {"SBYTE",        "-128",                 "127"},
+  {"UWORD",        "0",                    "65535"},
+  {"SWORD",        "-32768",               "32767"},
+  {"ULONG",        "0",                    "4294967295"},
+  {"SLONG",        "-2147483648",          "2147483647"},
+  {"A_UINT64",     "0",                    "18446744073709551615"},
+  {"A_INT64",      "-9223372036854775808", "9223372036854775807"},
+  {"FLOAT32_IEEE", "-3.4E+38",             "3.4E+38"},
+  {"FLOAT64_IEEE", "-1.7E+308",            "1.7E+308"}
+};
+
+static const char* const A2lKindNames[A2L_KINDS] = {"MEASUREMENT", "CHARACTERISTIC"};
+
+/*******************************************************************************************************************
+** Function:    A2l_AddName
+** Description: add a name or pattern to one kind of object of the request
+** Parameter:   sA2lSpec* spec, uint32 kind, char* name
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_AddName(sA2lSpec* spec, uint32 kind, char* name)
+{
+  sA2lNames* names = &spec->names[kind];
+
+  if(names->NamesNbr == names->capacity)
+  {
+    uint32 capacity = (names->capacity == 0) ? 64U : 2U * names->capacity;
+    char** list     = (char**)realloc(names->names, (size_t)capacity * sizeof(char*));
+
+    if(list == NULL)
+    {
+      printf("\n\r error: Out of memory !\n\r");
+      return(FALSE);
+    }
+    names->names    = list;
+    names->capacity = capacity;
+  }
+
+  names->names[names->NamesNbr++] = name;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_AddList
+** Description: add the names of a list file (one name, path or pattern per line, '#' starts a comment line)
+** Parameter:   sA2lSpec* spec, uint32 kind, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_AddList(sA2lSpec* spec, uint32 kind, char* path)
+{
+  char*   text   = NULL;
+  boolean result = TRUE;
+
+  if(spec->ListsNbr == A2L_MAX_LISTS)
+  {
+    return(FALSE);
+  }
+
+  text = (char*)LoadInputFile(path, NULL);
+
+  if(text == NULL)
+  {
+    return(FALSE);
+  }
+  spec->lists[spec->ListsNbr++] = text;
+
+  for(char* line = text; line != NULL && result; )
+  {
+    char* next = strchr(line, '\n');
+
+    if(next != NULL)
+    {
+      *next++ = '\0';
+    }
+
+    while(isspace((unsigned char)*line)) { line++; }
+    line[strcspn(line, " \t\r")] = '\0';
+
+    if(line[0] != '\0' && line[0] != '#')
+    {
+      result = A2l_AddName(spec, kind, line);
+    }
+    line = next;
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_IsPattern
+** Description: tell whether a name holds a wildcard
+** Parameter:   const char* name
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_IsPattern(const char* name)
+{
+  return((boolean)(strpbrk(name, "*?") != NULL));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_CompareNames
+** Description: qsort callback: the names in alphabetical order, then the patterns
+** Parameter:   const void* a, const void* b (char**)
+** Return:      int
+*******************************************************************************************************************/
+static int A2l_CompareNames(const void* a, const void* b)
+{
+  const char* na = *(const char* const*)a;
+  const char* nb = *(const char* const*)b;
+  boolean     pa = A2l_IsPattern(na);
+  boolean     pb = A2l_IsPattern(nb);
+
+  if(pa != pb)
+  {
+    return(pa ? 1 : -1);
+  }
+  return(strcmp(na, nb));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_CompareKey
+** Description: bsearch callback: variable name against a name of the request
+** Parameter:   const void* key (const char*), const void* name (char**)
+** Return:      int
+*******************************************************************************************************************/
+static int A2l_CompareKey(const void* key, const void* name)
+{
+  return(strcmp((const char*)key, *(const char* const*)name));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_ParseSpec
+** Description: parse "meas=<name>[+<name>...][,char=<name>[+<name>...]][,out=<File>]" or
+**              "upd=<A2lFile>[,out=<File>]". A name is a variable, a path in a variable, a pattern of variable
+**              names ('*', '?') or @<file> (one name per line). The names are kept for all the images of the run
+**              (see A2l_ReleaseSpec).
+** Parameter:   sA2lSpec* spec, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean A2l_ParseSpec(sA2lSpec* spec, const char* text)
+{
+  char*   item   = NULL;
+  boolean result = TRUE;
+
+  memset(spec, 0, sizeof(sA2lSpec));
+
+  if(text == NULL || strlen(text) >= sizeof(spec->copy))
+  {
+    result = FALSE;
+  }
+  else
+  {
+    strcpy(spec->copy, text);
+  }
+
+  for(item = result ? strtok(spec->copy, ",") : NULL; item != NULL && result; item = strtok(NULL, ","))
+  {
+    char* value = strchr(item, '=');
+
+    if(value == NULL)
+    {
+      result = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    if(0 == strcmp(item, "meas") || 0 == strcmp(item, "char"))
+    {
+      uint32 kind = (item[0] == 'm') ? A2L_MEASUREMENT : A2L_CHARACTERISTIC;
+
+      for(char* name = value; name != NULL && result; )
+      {
+        char* next = strchr(name, '+');
+
+        if(next != NULL)
+        {
+          *next++ = '\0';
+        }
+
+        if(*name == '\0')
+        {
+          result = FALSE;
+        }
+        else
+        {
+          result = (name[0] == '@') ? A2l_AddList(spec, kind, &name[1]) : A2l_AddName(spec, kind, name);
+        }
+        name = next;
+      }
+    }
+    else if(0 == strcmp(item, "upd"))
+    {
+      spec->update = value;
+      result       = (boolean)(*value != '\0');
+    }
+    else if(0 == strcmp(item, "out"))
+    {
+      spec->out = value;
+      result    = (boolean)(*value != '\0');
+    }
+    else
+    {
+      result = FALSE;
+    }
+  }
+
+  /* either objects to generate or a file to update */
+  if(result && ((spec->update != NULL) == (spec->names[A2L_MEASUREMENT].NamesNbr +
+                                           spec->names[A2L_CHARACTERISTIC].NamesNbr > 0)))
+  {
+    result = FALSE;
+  }
+
+  for(uint32 kind = 0; kind < A2L_KINDS && result; kind++)
+  {
+    sA2lNames* names  = &spec->names[kind];
+    uint32     unique = 0;
+
+    if(names->NamesNbr > 1U)
+    {
+      qsort(names->names, names->NamesNbr, sizeof(char*), A2l_CompareNames);
+    }
+
+    for(uint32 i = 0; i < names->NamesNbr; i++)
+    {
+      if(unique == 0 || 0 != strcmp(names->names[unique - 1], names->names[i]))
+      {
+        names->names[unique++] = names->names[i];
+      }
+    }
+    names->NamesNbr = unique;
+
+    while(names->ExactNbr < names->NamesNbr && !A2l_IsPattern(names->names[names->ExactNbr]))
+    {
+      names->ExactNbr++;
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Bad A2L request '%s' (meas=|char=<name>[+<name>|+<pattern>|+@<file>][,out=<File>], or "
+           "upd=<A2lFile>[,out=<File>]) !\n\r", (text != NULL) ? text : "");
+    A2l_ReleaseSpec(spec);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_ReleaseSpec
+** Description: free the names of a request
+** Parameter:   sA2lSpec* spec
+** Return:      void
+*******************************************************************************************************************/
+void A2l_ReleaseSpec(sA2lSpec* spec)
+{
+  for(uint32 i = 0; i < spec->ListsNbr; i++)
+  {
+    free(spec->lists[i]);
+  }
+
+  for(uint32 kind = 0; kind < A2L_KINDS; kind++)
+  {
+    free(spec->names[kind].names);
+  }
+
+  memset(spec->names, 0, sizeof(spec->names));
+  spec->ListsNbr = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_TableSize
+** Description: size of an open addressing table kept at most half full (a power of two)
+** Parameter:   uint32 count
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 A2l_TableSize(uint32 count)
+{
+  uint32 size = 16U;
+
+  while(size < 2U * count && size < 0x80000000UL)
+  {
+    size *= 2U;
+  }
+  return(size);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_OffsetHash
+** Description: hash of a DIE offset (Fibonacci hashing)
+** Parameter:   uint64 offset
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 A2l_OffsetHash(uint64 offset)
+{
+  return((uint32)((offset * 0x9E3779B97F4A7C15ULL) >> 32));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_IndexSymbols
+** Description: hash the data symbols of the image by name (a name may be defined more than once)
+** Parameter:   sA2l* ctx, sElf* elf
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_IndexSymbols(sA2l* ctx, sElf* elf)
+{
+  if(!Elf_GetSymbols(elf, &ctx->symbols, &ctx->SymNbr))
+  {
+    ctx->symbols = NULL;
+    ctx->SymNbr  = 0;
+  }
+
+  ctx->SymMask  = A2l_TableSize(ctx->SymNbr) - 1U;
+  ctx->SymSlots = (uint32*)malloc(((size_t)ctx->SymMask + 1U) * sizeof(uint32));
+
+  if(ctx->SymSlots == NULL)
+  {
+    return(FALSE);
+  }
+  memset(ctx->SymSlots, 0xFF, ((size_t)ctx->SymMask + 1U) * sizeof(uint32));
+
+  for(uint32 i = 0; i < ctx->SymNbr; i++)
+  {
+    const sElfSymbol* symbol = &ctx->symbols[i];
+    uint32            type   = ELF32_ST_TYPE(symbol->info);
+    uint32            slot   = 0;
+
+    if(symbol->shndx == 0 || symbol->name[0] == '\0' ||
+       (type != STT_OBJECT && type != STT_NOTYPE && type != STT_COMMON && type != STT_TLS))
+    {
+      continue;
+    }
+
+    for(slot = Hash_String(symbol->name) & ctx->SymMask; ctx->SymSlots[slot] != A2L_NONE;
+        slot = (slot + 1U) & ctx->SymMask)
+    {
+    }
+    ctx->SymSlots[slot] = i;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_IndexVariables
+** Description: index the variables of the debug information by name. Only the top-level DIEs of the units are
+**              read: the variables of the functions have no symbol of their name, and C++ namespaces are not
+**              searched. A variable defined in several units (static variables) keeps its best DIE.
+** Parameter:   sA2l* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_IndexVariables(sA2l* ctx)
+{
+  for(uint32 u = 0; u < ctx->dwarf.UnitsNbr; u++)
+  {
+    sDwarfDie root;
+    uint64    offset = 0;
+
+    if(!Dwarf_ReadDie(&ctx->dwarf, ctx->dwarf.units[u].dies, &root) || !root.children ||
+       (root.tag != DW_TAG_compile_unit && root.tag != DW_TAG_partial_unit))
+    {
+      continue;
+    }
+
+    for(offset = root.next; ; )
+    {
+      sDwarfDie die;
+
+      if(!Dwarf_ReadDie(&ctx->dwarf, offset, &die) || die.tag == 0)
+      {
+        break;
+      }
+
+      if(die.tag == DW_TAG_variable)
+      {
+        const char* name = die.name;
+        sDwarfDie   declaration;
+
+        /* a definition out of its declaration (extern in a header) names its declaration */
+        if(name == NULL && die.specification != DWARF_NONE &&
+           Dwarf_ReadDie(&ctx->dwarf, die.specification, &declaration))
+        {
+          name = declaration.name;
+        }
+
+        if(name != NULL && name[0] != '\0')
+        {
+          sA2lVar* var = NULL;
+
+          if(ctx->VarsNbr == ctx->VarsCap)
+          {
+            uint32   capacity = (ctx->VarsCap == 0) ? 1024U : 2U * ctx->VarsCap;
+            sA2lVar* vars     = (sA2lVar*)realloc(ctx->vars, (size_t)capacity * sizeof(sA2lVar));
+
+            if(vars == NULL)
+            {
+              return(FALSE);
+            }
+            ctx->vars    = vars;
+            ctx->VarsCap = capacity;
+          }
+
+          var          = &ctx->vars[ctx->VarsNbr++];
+          var->name    = name;
+          var->die     = die.offset;
+          var->address = die.address;
+          var->hash    = Hash_String(name);
+          var->rank    = ((die.has & DWARF_HAS_ADDRESS) != 0) ? 2U : ((die.has & DWARF_HAS_LOCATION) != 0) ? 1U : 0U;
+          var->located = (var->rank == 2U) ? 1U : 0U;
+        }
+      }
+
+      if(!Dwarf_NextSibling(&ctx->dwarf, &die, &offset))
+      {
+        break;
+      }
+    }
+  }
+
+  ctx->VarMask  = A2l_TableSize(ctx->VarsNbr) - 1U;
+  ctx->VarSlots = (uint32*)malloc(((size_t)ctx->VarMask + 1U) * sizeof(uint32));
+
+  if(ctx->VarSlots == NULL)
+  {
+    return(FALSE);
+  }
+  memset(ctx->VarSlots, 0xFF, ((size_t)ctx->VarMask + 1U) * sizeof(uint32));
+
+  for(uint32 i = 0; i < ctx->VarsNbr; i++)
+  {
+    const sA2lVar* var  = &ctx->vars[i];
+    uint32         slot = 0;
+
+    for(slot = var->hash & ctx->VarMask; ctx->VarSlots[slot] != A2L_NONE; slot = (slot + 1U) & ctx->VarMask)
+    {
+      const sA2lVar* other = &ctx->vars[ctx->VarSlots[slot]];
+
+      if(other->hash == var->hash && 0 == strcmp(other->name, var->name))
+      {
+        break;
+      }
+    }
+
+    if(ctx->VarSlots[slot] == A2L_NONE)
+    {
+      ctx->VarSlots[slot] = i;
+    }
+    else
+    {
+      uint32 located = ctx->vars[ctx->VarSlots[slot]].located + var->located;
+
+      if(ctx->vars[ctx->VarSlots[slot]].rank < var->rank)
+      {
+        ctx->VarSlots[slot] = i;
+      }
+      ctx->vars[ctx->VarSlots[slot]].located = located;
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_FindVar
+** Description: find a variable of the debug information by name
+** Parameter:   const sA2l* ctx, const char* name
+** Return:      uint32 (index in vars, A2L_NONE if none)
+*******************************************************************************************************************/
+static uint32 A2l_FindVar(const sA2l* ctx, const char* name)
+{
+  uint32 hash = Hash_String(name);
+
+  if(ctx->VarSlots == NULL)
+  {
+    return(A2L_NONE);
+  }
+
+  for(uint32 slot = hash & ctx->VarMask; ctx->VarSlots[slot] != A2L_NONE; slot = (slot + 1U) & ctx->VarMask)
+  {
+    const sA2lVar* var = &ctx->vars[ctx->VarSlots[slot]];
+
+    if(var->hash == hash && 0 == strcmp(var->name, name))
+    {
+      return(ctx->VarSlots[slot]);
+    }
+  }
+  return(A2L_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_FindSymbol
+** Description: address of a variable: its symbol, the one at the address of its debug information if several
+**              symbols have its name (static variables), or the address of its debug information if it has no
+**              symbol
+** Parameter:   const sA2l* ctx, const char* name, const sA2lVar* var (NULL if none), uint64* address
+** Return:      uint32 (number of candidate symbols: 0 not found, 1 found, more: ambiguous)
+*******************************************************************************************************************/
+static uint32 A2l_FindSymbol(const sA2l* ctx, const char* name, const sA2lVar* var, uint64* address)
+{
+  uint32 found   = 0;
+  uint32 globals = 0;
+
+  for(uint32 slot = Hash_String(name) & ctx->SymMask; ctx->SymSlots[slot] != A2L_NONE;
+      slot = (slot + 1U) & ctx->SymMask)
+  {
+    const sElfSymbol* symbol = &ctx->symbols[ctx->SymSlots[slot]];
+
+    if(0 != strcmp(symbol->name, name))
+    {
+      continue;
+    }
+
+    if(var != NULL && var->located == 1U && symbol->value == var->address)
+    {
+      *address = symbol->value;
+      return(1U);
+    }
+
+    if(ELF32_ST_BIND(symbol->info) != STB_LOCAL && globals++ == 0)
+    {
+      *address = symbol->value;
+    }
+    else if(found == 0 && globals == 0)
+    {
+      *address = symbol->value;
+    }
+    found++;
+  }
+
+  if(found == 0 && var != NULL && var->rank == 2U)
+  {
+    *address = var->address;
+    return(1U);
+  }
+  return((globals == 1U) ? 1U : found);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Strip
+** Description: read a type without its typedefs and qualifiers
+** Parameter:   sA2l* ctx, uint64 offset, sDwarfDie* die
+** Return:      boolean (FALSE for void or an unreadable type)
+*******************************************************************************************************************/
+static boolean A2l_Strip(sA2l* ctx, uint64 offset, sDwarfDie* die)
+{
+  for(uint32 depth = 0; depth < A2L_MAX_DEPTH && offset != DWARF_NONE; depth++)
+  {
+    if(!Dwarf_ReadDie(&ctx->dwarf, offset, die))
+    {
+      return(FALSE);
+    }
+
+    if(die->tag != DW_TAG_typedef && die->tag != DW_TAG_const_type && die->tag != DW_TAG_volatile_type &&
+       die->tag != DW_TAG_restrict_type && die->tag != DW_TAG_atomic_type)
+    {
+      return(TRUE);
+    }
+    offset = die->type;
+  }
+
+  die->tag = 0;
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_TypeSize
+** Description: size in bytes of a type (without typedefs and qualifiers)
+** Parameter:   sA2l* ctx, const sDwarfDie* type, uint64* size
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_TypeSize(sA2l* ctx, const sDwarfDie* type, uint64* size)
+{
+  if(type->tag == DW_TAG_array_type)
+  {
+    sA2lPlace array;
+    uint64    count = 1;
+
+    memset(&array, 0, sizeof(sA2lPlace));
+    array.type = *type;
+
+    if(!A2l_ArrayDims(ctx, &array) || !A2l_TypeSize(ctx, &array.type, size))
+    {
+      return(FALSE);
+    }
+
+    for(uint32 i = 0; i < array.DimsNbr; i++)
+    {
+      count *= array.dims[i];
+    }
+    *size *= count;
+    return(TRUE);
+  }
+
+  if((type->has & DWARF_HAS_BYTE_SIZE) != 0)
+  {
+    *size = type->ByteSize;
+    return(TRUE);
+  }
+
+  if(type->tag == DW_TAG_pointer_type || type->tag == DW_TAG_reference_type ||
+     type->tag == DW_TAG_rvalue_reference_type)
+  {
+    *size = type->unit->AddrSize;
+    return(TRUE);
+  }
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_ArrayDims
+** Description: append the dimensions of the array type of a place, its type becomes the element type (the arrays
+**              of arrays are flattened)
+** Parameter:   sA2l* ctx, sA2lPlace* place
+** Return:      boolean (FALSE for an array of unknown size or too many dimensions)
+*******************************************************************************************************************/
+static boolean A2l_ArrayDims(sA2l* ctx, sA2lPlace* place)
+{
+  for(uint32 depth = 0; place->type.tag == DW_TAG_array_type; depth++)
+  {
+    sDwarfDie array  = place->type;
+    uint64    offset = array.next;
+    boolean   result = (boolean)(array.children && depth < A2L_MAX_DEPTH);
+
+    while(result)
+    {
+      sDwarfDie range;
+      sint64    count = 0;
+
+      result = Dwarf_ReadDie(&ctx->dwarf, offset, &range);
+
+      if(!result || range.tag == 0)
+      {
+        break;
+      }
+
+      if(range.tag == DW_TAG_subrange_type)
+      {
+        if((range.has & DWARF_HAS_COUNT) != 0)
+        {
+          count = (sint64)range.count;
+        }
+        else if((range.has & DWARF_HAS_UPPER_BOUND) != 0)
+        {
+          count = range.UpperBound + 1 - (((range.has & DWARF_HAS_LOWER_BOUND) != 0) ? range.LowerBound : 0);
+        }
+
+        result = (boolean)(count > 0 && count <= 0x7FFFFFFF && place->DimsNbr < A2L_MAX_DIMS);
+
+        if(result)
+        {
+          place->dims[place->DimsNbr++] = (uint32)count;
+        }
+      }
+
+      result = (boolean)(result && Dwarf_NextSibling(&ctx->dwarf, &range, &offset));
+    }
+
+    if(!result || !A2l_Strip(ctx, array.type, &place->type))
+    {
+      return(FALSE);
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Scalar
+** Description: ASAP2 data type of a scalar type (base type, enumeration or pointer)
+** Parameter:   sA2l* ctx, const sDwarfDie* type, uint32* datatype
+** Return:      boolean (FALSE if the type is not a scalar of a supported size)
+*******************************************************************************************************************/
+static boolean A2l_Scalar(sA2l* ctx, const sDwarfDie* type, uint32* datatype)
+{
+  uint32    encoding = DW_ATE_unsigned;
+  uint64    size     = 0;
+  sDwarfDie base;
+
+  switch(type->tag)
+  {
+    case DW_TAG_base_type:
+      encoding = type->encoding;
+      break;
+    case DW_TAG_enumeration_type:
+      /* the underlying type gives the sign (DWARF 3 and later) */
+      if(type->type != DWARF_NONE && A2l_Strip(ctx, type->type, &base) && base.tag == DW_TAG_base_type)
+      {
+        encoding = base.encoding;
+      }
+      break;
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type:
+      break;
+    default:
+      return(FALSE);
+  }
+
+  if(!A2l_TypeSize(ctx, type, &size))
+  {
+    return(FALSE);
+  }
+
+  if(encoding == DW_ATE_float)
+  {
+    *datatype = (size == 4U) ? A2L_FLOAT32 : A2L_FLOAT64;
+    return((boolean)(size == 4U || size == 8U));
+  }
+
+  if(encoding != DW_ATE_signed && encoding != DW_ATE_signed_char && encoding != DW_ATE_unsigned &&
+     encoding != DW_ATE_unsigned_char && encoding != DW_ATE_boolean && encoding != DW_ATE_UTF &&
+     encoding != DW_ATE_address)
+  {
+    return(FALSE);
+  }
+
+  switch(size)
+  {
+    case 1U: *datatype = A2L_UBYTE;  break;
+    case 2U: *datatype = A2L_UWORD;  break;
+    case 4U: *datatype = A2L_ULONG;  break;
+    case 8U: *datatype = A2L_UINT64; break;
+    default: return(FALSE);
+  }
+
+  /* the signed type follows its unsigned type */
+  if(encoding == DW_ATE_signed || encoding == DW_ATE_signed_char)
+  {
+    *datatype += 1U;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_CollectMembers
+** Description: collect the named members of a structure or union, and those of its anonymous members
+** Parameter:   sA2l* ctx, const sDwarfDie* type, uint64 base, uint32 depth, sA2lMember** members,
+**              uint32* count, uint32* capacity
+** Return:      boolean (FALSE if out of memory)
+*******************************************************************************************************************/
+static boolean A2l_CollectMembers(sA2l* ctx, const sDwarfDie* type, uint64 base, uint32 depth,
+                                  sA2lMember** members, uint32* count, uint32* capacity)
+{
+  uint64 offset = type->next;
+
+  while(type->children)
+  {
+    sDwarfDie member;
+    sDwarfDie inner;
+
+    if(!Dwarf_ReadDie(&ctx->dwarf, offset, &member) || member.tag == 0)
+    {
+      break;
+    }
+
+    if(member.tag == DW_TAG_member && (member.has & DWARF_HAS_DECLARATION) == 0)
+    {
+      if(member.name != NULL)
+      {
+        if(*count == *capacity)
+        {
+          uint32      size = (*capacity == 0) ? 32U : 2U * *capacity;
+          sA2lMember* list = (sA2lMember*)realloc(*members, (size_t)size * sizeof(sA2lMember));
+
+          if(list == NULL)
+          {
+            return(FALSE);
+          }
+          *members  = list;
+          *capacity = size;
+        }
+
+        (*members)[*count].name = member.name;
+        (*members)[*count].die  = member.offset;
+        (*members)[*count].base = base;
+        (*count)++;
+      }
+      else if(depth < A2L_MAX_DEPTH && A2l_Strip(ctx, member.type, &inner) &&
+              (inner.tag == DW_TAG_structure_type || inner.tag == DW_TAG_union_type ||
+               inner.tag == DW_TAG_class_type) &&
+              !A2l_CollectMembers(ctx, &inner, base + member.MemberLoc, depth + 1U, members, count, capacity))
+      {
+        return(FALSE);
+      }
+    }
+
+    if(!Dwarf_NextSibling(&ctx->dwarf, &member, &offset))
+    {
+      break;
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_CompareMembers
+** Description: qsort/bsearch callback: members by name
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int A2l_CompareMembers(const void* a, const void* b)
+{
+  return(strcmp(((const sA2lMember*)a)->name, ((const sA2lMember*)b)->name));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Members
+** Description: members of a structure, decoded on its first use
+** Parameter:   sA2l* ctx, const sDwarfDie* type
+** Return:      const sA2lStruct* (NULL if out of memory)
+*******************************************************************************************************************/
+static const sA2lStruct* A2l_Members(sA2l* ctx, const sDwarfDie* type)
+{
+  sA2lStruct* entry    = NULL;
+  sA2lMember* members  = NULL;
+  uint32      count    = 0;
+  uint32      capacity = 0;
+  uint32      slot     = 0;
+
+  /* the table is kept at most half full */
+  if(2U * (ctx->StructsNbr + 1U) > ctx->StructMask)
+  {
+    uint32      mask    = (ctx->StructMask == 0) ? 255U : 2U * ctx->StructMask + 1U;
+    sA2lStruct* structs = (sA2lStruct*)malloc(((size_t)mask + 1U) * sizeof(sA2lStruct));
+
+    if(structs == NULL)
+    {
+      return(NULL);
+    }
+
+    for(uint32 i = 0; i <= mask; i++)
+    {
+      structs[i].offset = DWARF_NONE;
+    }
+
+    for(uint32 i = 0; ctx->structs != NULL && i <= ctx->StructMask; i++)
+    {
+      if(ctx->structs[i].offset != DWARF_NONE)
+      {
+        for(slot = A2l_OffsetHash(ctx->structs[i].offset) & mask; structs[slot].offset != DWARF_NONE;
+            slot = (slot + 1U) & mask)
+        {
+        }
+        structs[slot] = ctx->structs[i];
+      }
+    }
+
+    free(ctx->structs);
+    ctx->structs    = structs;
+    ctx->StructMask = mask;
+  }
+
+  for(slot = A2l_OffsetHash(type->offset) & ctx->StructMask; ctx->structs[slot].offset != DWARF_NONE;
+      slot = (slot + 1U) & ctx->StructMask)
+  {
+    if(ctx->structs[slot].offset == type->offset)
+    {
+      return(&ctx->structs[slot]);
+    }
+  }
+
+  if(!A2l_CollectMembers(ctx, type, 0, 0, &members, &count, &capacity))
+  {
+    free(members);
+    return(NULL);
+  }
+
+  entry          = &ctx->structs[slot];
+  entry->members = (sA2lMember*)Arena_Alloc(&ctx->arena, ((size_t)count + 1U) * sizeof(sA2lMember));
+
+  if(entry->members == NULL)
+  {
+    free(members);
+    return(NULL);
+  }
+
+  if(count > 0)
+  {
+    memcpy(entry->members, members, (size_t)count * sizeof(sA2lMember));
+    qsort(entry->members, count, sizeof(sA2lMember), A2l_CompareMembers);
+  }
+  free(members);
+
+  entry->offset = type->offset;
+  entry->count  = count;
+  ctx->StructsNbr++;
+  return(entry);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Member
+** Description: place of a member in the place of its structure. The bit position of a bit-field is counted from
+**              the least significant bit of its storage unit (BIT_MASK).
+** Parameter:   sA2l* ctx, const sA2lPlace* outer, const sA2lMember* member, sA2lPlace* place (may be outer)
+** Return:      boolean (FALSE if the member cannot be read or its bit-field crosses its storage unit)
+*******************************************************************************************************************/
+static boolean A2l_Member(sA2l* ctx, const sA2lPlace* outer, const sA2lMember* member, sA2lPlace* place)
+{
+  sDwarfDie die;
+  uint64    size = 0;
+  uint64    base = outer->address + member->base;
+
+  memset(place, 0, sizeof(sA2lPlace));
+
+  if(!Dwarf_ReadDie(&ctx->dwarf, member->die, &die) || !A2l_Strip(ctx, die.type, &place->type))
+  {
+    return(FALSE);
+  }
+
+  place->address = base + die.MemberLoc;
+
+  if((die.has & DWARF_HAS_BIT_SIZE) == 0)
+  {
+    return(TRUE);
+  }
+
+  size = ((die.has & DWARF_HAS_BYTE_SIZE) != 0) ? die.ByteSize : 0U;
+
+  if((size == 0 && !A2l_TypeSize(ctx, &place->type, &size)) || size == 0 || size > 8U ||
+     die.BitSize == 0 || die.BitSize > 8U * size)
+  {
+    return(FALSE);
+  }
+
+  place->bitfield = TRUE;
+  place->bits     = (uint32)die.BitSize;
+
+  if((die.has & DWARF_HAS_DATA_BIT_OFF) != 0)
+  {
+    /* DWARF 4: bit offset from the start of the structure, in the storage unit which holds the bit-field */
+    uint64 unit  = die.DataBitOffset / (8U * size);
+    uint64 inner = die.DataBitOffset - 8U * size * unit;
+
+    if(inner + die.BitSize > 8U * size)
+    {
+      return(FALSE);
+    }
+
+    place->address = base + unit * size;
+    place->lsb     = (uint32)(ctx->msb ? 8U * size - inner - die.BitSize : inner);
+  }
+  else
+  {
+    /* DWARF 2 and 3: storage unit at the member location, bit offset from its most significant bit */
+    if(die.BitOffset + die.BitSize > 8U * size)
+    {
+      return(FALSE);
+    }
+    place->lsb = (uint32)(8U * size - die.BitOffset - die.BitSize);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Step
+** Description: apply one step of a path to a place: ".<member>", "[<index>]" or "._<index>_"
+** Parameter:   sA2l* ctx, const char* step, sA2lPlace* place
+** Return:      const char* (next step, NULL if the step cannot be applied)
+*******************************************************************************************************************/
+static const char* A2l_Step(sA2l* ctx, const char* step, sA2lPlace* place)
+{
+  boolean array = (boolean)(place->DimsNbr > 0 || place->type.tag == DW_TAG_array_type);
+  char*   end   = NULL;
+  uint64  index = 0;
+  uint64  size  = 0;
+  uint64  count = 1;
+
+  if(place->bitfield)
+  {
+    return(NULL);
+  }
+
+  if(step[0] == '.' && !(array && step[1] == '_'))
+  {
+    const sA2lStruct* type = NULL;
+    sA2lMember        key;
+    const sA2lMember* member = NULL;
+    char              name[A2L_NAME_LEN];
+    size_t            length = strcspn(&step[1], ".[");
+
+    if(array || length == 0 || length >= sizeof(name) ||
+       (place->type.tag != DW_TAG_structure_type && place->type.tag != DW_TAG_union_type &&
+        place->type.tag != DW_TAG_class_type))
+    {
+      return(NULL);
+    }
+
+    memcpy(name, &step[1], length);
+    name[length] = '\0';
+    key.name     = name;
+    type         = A2l_Members(ctx, &place->type);
+    member       = (type != NULL) ? (const sA2lMember*)bsearch(&key, type->members, type->count,
+                                                                sizeof(sA2lMember), A2l_CompareMembers) : NULL;
+
+    return((member != NULL && A2l_Member(ctx, place, member, place)) ? &step[1 + length] : NULL);
+  }
+
+  /* index: "[<n>]" or "._<n>_" */
+  if(!array || (place->DimsNbr == 0 && !A2l_ArrayDims(ctx, place)) || !isdigit((uint8)step[(step[0] == '[') ? 1 : 2]))
+  {
+    return(NULL);
+  }
+
+  index = strtoull(&step[(step[0] == '[') ? 1 : 2], &end, 10);
+
+  if(*end != ((step[0] == '[') ? ']' : '_') || index >= place->dims[0] || !A2l_TypeSize(ctx, &place->type, &size))
+  {
+    return(NULL);
+  }
+
+  for(uint32 i = 1; i < place->DimsNbr; i++)
+  {
+    count *= place->dims[i];
+  }
+
+  place->address += index * count * size;
+  place->DimsNbr--;
+  memmove(&place->dims[0], &place->dims[1], place->DimsNbr * sizeof(uint32));
+  return(end + 1);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Locate
+** Description: find the address and type of a variable or of a path in a variable
+** Parameter:   sA2l* ctx, const char* path, sA2lPlace* place
+** Return:      boolean (FALSE with an error if the path cannot be resolved)
+*******************************************************************************************************************/
+static boolean A2l_Locate(sA2l* ctx, const char* path, sA2lPlace* place)
+{
+  char           name[A2L_NAME_LEN];
+  size_t         length = strcspn(path, ".[");
+  uint32         index  = A2L_NONE;
+  const sA2lVar* var    = NULL;
+  uint32         found  = 0;
+  const char*    step   = &path[length];
+
+  memset(place, 0, sizeof(sA2lPlace));
+
+  if(length == 0 || length >= sizeof(name))
+  {
+    printf("\n\r error: Bad variable name '%s' !\n\r", path);
+    return(FALSE);
+  }
+
+  memcpy(name, path, length);
+  name[length] = '\0';
+  index        = A2l_FindVar(ctx, name);
+  var          = (index != A2L_NONE) ? &ctx->vars[index] : NULL;
+  found        = A2l_FindSymbol(ctx, name, var, &place->address);
+
+  if(found == 0)
+  {
+    printf("\n\r error: No variable '%s' in the symbols or the debug information !\n\r", name);
+    return(FALSE);
+  }
+
+  if(found > 1U)
+  {
+    printf("\n\r error: The variable '%s' is defined %u times (static variables), its address is ambiguous !\n\r",
+           name, found);
+    return(FALSE);
+  }
+
+  if(var != NULL)
+  {
+    sDwarfDie die;
+
+    if(Dwarf_ReadDie(&ctx->dwarf, var->die, &die) && die.type == DWARF_NONE && die.specification != DWARF_NONE)
+    {
+      (void)Dwarf_ReadDie(&ctx->dwarf, die.specification, &die);
+    }
+
+    if(die.type != DWARF_NONE)
+    {
+      (void)A2l_Strip(ctx, die.type, &place->type);
+    }
+  }
+
+  if(*step != '\0' && place->type.tag == 0)
+  {
+    printf("\n\r error: No debug information for '%s', the path '%s' cannot be resolved !\n\r", name, path);
+    return(FALSE);
+  }
+
+  while(*step != '\0')
+  {
+    const char* next = A2l_Step(ctx, step, place);
+
+    if(next == NULL)
+    {
+      printf("\n\r error: Cannot resolve '%s' at '%s' (no such member, index out of bounds or bad syntax) !\n\r",
+             path, step);
+      return(FALSE);
+    }
+    step = next;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_AddObject
+** Description: add an object to the generated ones (more than 3 dimensions are folded into the third one)
+** Parameter:   sA2l* ctx, const char* name, const sA2lPlace* place, uint32 kind, uint32 datatype
+** Return:      boolean (FALSE if out of memory)
+*******************************************************************************************************************/
+static boolean A2l_AddObject(sA2l* ctx, const char* name, const sA2lPlace* place, uint32 kind, uint32 datatype)
+{
+  sA2lObject* object = NULL;
+  size_t      length = strlen(name);
+
+  if(ctx->ObjectsNbr == ctx->ObjectsCap)
+  {
+    uint32      capacity = (ctx->ObjectsCap == 0) ? 1024U : 2U * ctx->ObjectsCap;
+    sA2lObject* objects  = (sA2lObject*)realloc(ctx->objects, (size_t)capacity * sizeof(sA2lObject));
+
+    if(objects == NULL)
+    {
+      return(FALSE);
+    }
+    ctx->objects    = objects;
+    ctx->ObjectsCap = capacity;
+  }
+
+  object       = &ctx->objects[ctx->ObjectsNbr];
+  object->name = (char*)Arena_Alloc(&ctx->arena, length + 1U);
+
+  if(object->name == NULL)
+  {
+    return(FALSE);
+  }
+
+  memcpy(object->name, name, length + 1U);
+  object->address  = place->address;
+  object->kind     = kind;
+  object->datatype = datatype;
+  object->bits     = place->bitfield ? place->bits : 0U;
+  object->mask     = 0;
+  object->DimsNbr  = (place->DimsNbr < 3U) ? place->DimsNbr : 3U;
+
+  for(uint32 i = 0; i < place->DimsNbr; i++)
+  {
+    object->dims[(i < 3U) ? i : 2U] = (i < 3U) ? place->dims[i] : object->dims[2] * place->dims[i];
+  }
+
+  if(place->bitfield)
+  {
+    object->mask = ((place->bits >= 64U) ? ~0ULL : ((1ULL << place->bits) - 1U)) << place->lsb;
+  }
+
+  ctx->ObjectsNbr++;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Expand
+** Description: generate the objects of a place: one for a scalar or an array of scalars, one per member of a
+**              structure and one per element of an array of structures (recursively)
+** Parameter:   sA2l* ctx, char* name (buffer of A2L_NAME_LEN), size_t length, const sA2lPlace* place,
+**              uint32 kind, uint32 depth, uint32* budget (objects left for the variable)
+** Return:      void
+*******************************************************************************************************************/
+static void A2l_Expand(sA2l* ctx, char* name, size_t length, const sA2lPlace* place, uint32 kind, uint32 depth,
+                       uint32* budget)
+{
+  sA2lPlace here     = *place;
+  uint32    datatype = 0;
+
+  name[length] = '\0';
+
+  if(*budget == 0)
+  {
+    return;
+  }
+
+  if(here.DimsNbr == 0 && here.type.tag == DW_TAG_array_type && !A2l_ArrayDims(ctx, &here))
+  {
+    here.type.tag = 0;
+  }
+
+  if(A2l_Scalar(ctx, &here.type, &datatype))
+  {
+    if(!A2l_AddObject(ctx, name, &here, kind, datatype))
+    {
+      *budget = 0;
+      ctx->errors++;
+      printf("\n\r error: Out of memory !\n\r");
+      return;
+    }
+    (*budget)--;
+  }
+  else if(depth < A2L_MAX_DEPTH && (here.type.tag == DW_TAG_structure_type || here.type.tag == DW_TAG_union_type ||
+                                    here.type.tag == DW_TAG_class_type))
+  {
+    uint64 size  = 0;
+    uint64 count = 1;
+
+    for(uint32 i = 0; i < here.DimsNbr; i++)
+    {
+      count *= here.dims[i];
+    }
+
+    if(here.DimsNbr > 0 && !A2l_TypeSize(ctx, &here.type, &size))
+    {
+      count = 0;
+    }
+
+    /* array of structures: one expansion per element, "name[i][j]" */
+    for(uint64 element = 0; here.DimsNbr > 0 && element < count && *budget > 0; element++)
+    {
+      sA2lPlace item   = here;
+      size_t    added  = length;
+      uint64    rest   = element;
+      uint64    stride = count;
+
+      item.address = here.address + element * size;
+      item.DimsNbr = 0;
+
+      for(uint32 i = 0; i < here.DimsNbr && added + 24U < A2L_NAME_LEN; i++)
+      {
+        stride /= here.dims[i];
+        added  += (size_t)sprintf(&name[added], "[%llu]", (unsigned long long)(rest / stride));
+        rest   %= stride;
+      }
+
+      A2l_Expand(ctx, name, added, &item, kind, depth + 1U, budget);
+    }
+
+    if(here.DimsNbr == 0)
+    {
+      const sA2lStruct* type = A2l_Members(ctx, &here.type);
+
+      for(uint32 i = 0; type != NULL && i < type->count && *budget > 0; i++)
+      {
+        sA2lPlace   member;
+        size_t      size = strlen(type->members[i].name);
+
+        if(length + 1U + size >= A2L_NAME_LEN || !A2l_Member(ctx, &here, &type->members[i], &member))
+        {
+          name[length] = '\0';
+          printf("\n\r warning: The member '%s.%s' is not supported, skipped !\n\r", name, type->members[i].name);
+          ctx->skipped++;
+          continue;
+        }
+
+        name[length] = '.';
+        memcpy(&name[length + 1U], type->members[i].name, size);
+        A2l_Expand(ctx, name, length + 1U + size, &member, kind, depth + 1U, budget);
+      }
+    }
+  }
+  else
+  {
+    printf("\n\r warning: The type of '%s' is not supported (no debug information, void, function, array of "
+           "unknown size, ...), skipped !\n\r", name);
+    ctx->skipped++;
+  }
+
+  name[length] = '\0';
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Select
+** Description: generate the objects of one name of the request
+** Parameter:   sA2l* ctx, const char* name, uint32 kind
+** Return:      void
+*******************************************************************************************************************/
+static void A2l_Select(sA2l* ctx, const char* name, uint32 kind)
+{
+  char      buffer[A2L_NAME_LEN];
+  sA2lPlace place;
+  uint32    budget = A2L_MAX_EXPAND;
+  size_t    length = strlen(name);
+
+  if(length >= sizeof(buffer))
+  {
+    printf("\n\r error: Bad variable name '%s' !\n\r", name);
+    ctx->errors++;
+    return;
+  }
+
+  if(!A2l_Locate(ctx, name, &place))
+  {
+    ctx->errors++;
+    return;
+  }
+
+  memcpy(buffer, name, length + 1U);
+  A2l_Expand(ctx, buffer, length, &place, kind, 0, &budget);
+
+  if(budget == 0)
+  {
+    printf("\n\r warning: '%s' expands to more than %u objects, the next ones are skipped !\n\r", name,
+           A2L_MAX_EXPAND);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_CompareObjects
+** Description: qsort callback: objects by name, the characteristic first for a name selected twice
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int A2l_CompareObjects(const void* a, const void* b)
+{
+  const sA2lObject* x      = (const sA2lObject*)a;
+  const sA2lObject* y      = (const sA2lObject*)b;
+  int               result = strcmp(x->name, y->name);
+
+  return((result != 0) ? result : (int)y->kind - (int)x->kind);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Limits
+** Description: limits of an object: those of its data type, or of the width of its bit-field
+** Parameter:   const sA2lObject* object, char* lower, char* upper, size_t size
+** Return:      void
+*******************************************************************************************************************/
+static void A2l_Limits(const sA2lObject* object, char* lower, char* upper, size_t size)
+{
+  boolean sign = (boolean)(object->datatype < A2L_FLOAT32 && (object->datatype & 1U) != 0);
+
+  if(object->bits == 0 || object->bits >= 64U)
+  {
+    snprintf(lower, size, "%s", A2lTypes[object->datatype].lower);
+    snprintf(upper, size, "%s", A2lTypes[object->datatype].upper);
+  }
+  else if(sign)
+  {
+    snprintf(lower, size, "-%llu", 1ULL << (object->bits - 1U));
+    snprintf(upper, size, "%llu", (1ULL << (object->bits - 1U)) - 1U);
+  }
+  else
+  {
+    snprintf(lower, size, "0");
+    snprintf(upper, size, "%llu", (1ULL << object->bits) - 1U);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Write
+** Description: write the RECORD_LAYOUT of the characteristics and the MEASUREMENT and CHARACTERISTIC blocks
+** Parameter:   sA2l* ctx, const sA2lSpec* spec
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean A2l_Write(sA2l* ctx, const sA2lSpec* spec)
+{
+  FILE*   file = (spec->out != NULL) ? fopen(spec->out, "wb") : stdout;
+  boolean used[A2L_TYPES];
+  char    lower[32];
+  char    upper[32];
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Cannot save the file '%s' !\n\r", spec->out);
+    return(FALSE);
+  }
+
+  memset(used, 0, sizeof(used));
+
+  for(uint32 i = 0; i < ctx->ObjectsNbr; i++)
+  {
+    used[ctx->objects[i].datatype] |= (boolean)(ctx->objects[i].kind == A2L_CHARACTERISTIC);
+  }
+
+  fprintf(file, "/* ASAP2 objects of the ELF variables, to be included in a MODULE */\n");
+
+  for(uint32 t = 0; t < A2L_TYPES; t++)
+  {
+    if(used[t])
+    {
+      fprintf(file, "\n/begin RECORD_LAYOUT RL_VALUE_%s\n  FNC_VALUES 1 %s ROW_DIR DIRECT\n/end RECORD_LAYOUT\n",
+              A2lTypes[t].name, A2lTypes[t].name);
+    }
+  }
+
+  for(uint32 i = 0; i < ctx->ObjectsNbr; i++)
+  {
+    const sA2lObject* object = &ctx->objects[i];
+    const char*       type   = A2lTypes[object->datatype].name;
+
+    A2l_Limits(object, lower, upper, sizeof(lower));
+    fprintf(file, "\n/begin %s %s \"\"\n", A2lKindNames[object->kind], object->name);
+
+    if(object->kind == A2L_MEASUREMENT)
+    {
+      fprintf(file, "  %s NO_COMPU_METHOD 0 0 %s %s\n  ECU_ADDRESS 0x%llX\n", type, lower, upper,
+              (unsigned long long)object->address);
+    }
+    else
+    {
+      fprintf(file, "  %s 0x%llX RL_VALUE_%s 0 NO_COMPU_METHOD %s %s\n", (object->DimsNbr > 0) ? "VAL_BLK" : "VALUE",
+              (unsigned long long)object->address, type, lower, upper);
+    }
+
+    if(object->mask != 0)
+    {
+      fprintf(file, "  BIT_MASK 0x%llX\n", (unsigned long long)object->mask);
+    }
+
+    if(object->datatype != A2L_UBYTE && object->datatype != A2L_SBYTE)
+    {
+      fprintf(file, "  BYTE_ORDER %s\n", ctx->msb ? "MSB_FIRST" : "MSB_LAST");
+    }
+
+    if(object->DimsNbr > 0)
+    {
+      fprintf(file, "  MATRIX_DIM %u %u %u\n", object->dims[0], (object->DimsNbr > 1U) ? object->dims[1] : 1U,
+              (object->DimsNbr > 2U) ? object->dims[2] : 1U);
+    }
+
+    fprintf(file, "/end %s\n", A2lKindNames[object->kind]);
+  }
+
+  if(file != stdout)
+  {
+    Stats_AddWritten((uint64)ftell(file));
+    fclose(file);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Token
+** Description: next token of an A2L text: a word, or a quoted string. The comments are skipped.
+** Parameter:   char** p, const char* end, size_t* length
+** Return:      char* (NULL at the end of the text)
+*******************************************************************************************************************/
+static char* A2l_Token(char** p, const char* end, size_t* length)
+{
+  char* s = *p;
+  char* token;
+
+  for(;;)
+  {
+    while(s < end && isspace((uint8)*s)) { s++; }
+
+    if(s + 1 < end && s[0] == '/' && s[1] == '*')
+    {
+      char* close = NULL;
+
+      for(close = s + 2; close + 1 < end && !(close[0] == '*' && close[1] == '/'); close++)
+      {
+      }
+      s = (close + 1 < end) ? close + 2 : (char*)end;
+    }
+    else if(s + 1 < end && s[0] == '/' && s[1] == '/')
+    {
+      while(s < end && *s != '\n') { s++; }
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if(s >= end)
+  {
+    *p = (char*)end;
+    return(NULL);
+  }
+
+  token = s;
+
+  if(*s == '"')
+  {
+    for(s++; s < end && *s != '"'; s++)
+    {
+      s += (*s == '\\' && s + 1 < end) ? 1 : 0;
+    }
+    s += (s < end) ? 1 : 0;
+  }
+  else
+  {
+    while(s < end && !isspace((uint8)*s)) { s++; }
+  }
+
+  *length = (size_t)(s - token);
+  *p      = s;
+  return(token);
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Update
+** Description: update the addresses of the MEASUREMENT (ECU_ADDRESS), CHARACTERISTIC and AXIS_PTS objects of an A2L
+**              file, the rest of the file is copied as is
+** Parameter:   sA2l* ctx, const sA2lSpec* spec
+** Return:      boolean (FALSE if an object could not be resolved)
+*******************************************************************************************************************/
+static boolean A2l_Update(sA2l* ctx, const sA2lSpec* spec)
+{
+  uint32  size     = 0;
+  char*   text     = (char*)LoadInputFile(spec->update, &size);
+  char*   end      = text + size;
+  char*   p        = text;
+  char*   copied   = text;
+  FILE*   file     = NULL;
+  uint32  objects  = 0;
+  uint32  changed  = 0;
+  uint32  failed   = 0;
+  char    name[A2L_NAME_LEN];
+  char    address[32];
+
+  if(text == NULL)
+  {
+    return(FALSE);
+  }
+
+  file = (spec->out != NULL) ? fopen(spec->out, "wb") : stdout;
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Cannot save the file '%s' !\n\r", spec->out);
+    free(text);
+    return(FALSE);
+  }
+
+  for(;;)
+  {
+    size_t      length = 0;
+    char*       token  = A2l_Token(&p, end, &length);
+    char*       value  = NULL;
+    uint32      skip   = 0;
+    sA2lPlace   place;
+
+    if(token == NULL)
+    {
+      break;
+    }
+
+    if(length != 6U || 0 != strncmp(token, "/begin", 6U) || (token = A2l_Token(&p, end, &length)) == NULL)
+    {
+      continue;
+    }
+
+    /* tokens between the name and the address */
+    if(length == 14U && 0 == strncmp(token, "CHARACTERISTIC", 14U))
+    {
+      skip = 2U;
+    }
+    else if(length == 8U && 0 == strncmp(token, "AXIS_PTS", 8U))
+    {
+      skip = 1U;
+    }
+    else if(!(length == 11U && 0 == strncmp(token, "MEASUREMENT", 11U)))
+    {
+      continue;
+    }
+
+    if((token = A2l_Token(&p, end, &length)) == NULL || length >= sizeof(name))
+    {
+      continue;
+    }
+
+    memcpy(name, token, length);
+    name[length] = '\0';
+
+    if(skip == 0)
+    {
+      /* the ECU_ADDRESS of the block, out of its nested blocks */
+      uint32 depth = 0;
+
+      while(value == NULL && (token = A2l_Token(&p, end, &length)) != NULL)
+      {
+        if(length == 6U && 0 == strncmp(token, "/begin", 6U))
+        {
+          depth++;
+        }
+        else if(length == 4U && 0 == strncmp(token, "/end", 4U))
+        {
+          if(depth-- == 0)
+          {
+            break;
+          }
+        }
+        else if(depth == 0 && length == 11U && 0 == strncmp(token, "ECU_ADDRESS", 11U))
+        {
+          value = A2l_Token(&p, end, &length);
+        }
+      }
+    }
+    else
+    {
+      while(skip-- > 0 && A2l_Token(&p, end, &length) != NULL)
+      {
+      }
+      value = A2l_Token(&p, end, &length);
+    }
+
+    if(value == NULL || !isdigit((uint8)value[0]))
+    {
+      printf("\n\r warning: No address found for the object '%s', not updated !\n\r", name);
+      continue;
+    }
+
+    objects++;
+
+    if(!A2l_Locate(ctx, name, &place))
+    {
+      failed++;
+      continue;
+    }
+
+    snprintf(address, sizeof(address), "0x%llX", (unsigned long long)place.address);
+
+    if(length != strlen(address) || 0 != strncmp(value, address, length))
+    {
+      changed++;
+    }
+
+    /* the text up to the old address, then the new one */
+    fwrite(copied, 1, (size_t)(value - copied), file);
+    fputs(address, file);
+    copied = value + length;
+  }
+
+  fwrite(copied, 1, (size_t)(end - copied), file);
+
+  if(file != stdout)
+  {
+    Stats_AddWritten((uint64)ftell(file));
+    fclose(file);
+  }
+  free(text);
+
+  if(spec->out != NULL)
+  {
+    printf("\n\r A2L UPDATE %u object(s), %u address(es) changed, %u not resolved -> %s\n\r", objects, changed,
+           failed, spec->out);
+  }
+  return((boolean)(failed == 0));
+}
+
+/*******************************************************************************************************************
+** Function:    A2l_Report
+** Description: generate the A2L objects of the request, or update the addresses of its A2L file
+** Parameter:   sElf* elf, const sA2lSpec* spec
+** Return:      boolean (FALSE if a name could not be resolved)
+*******************************************************************************************************************/
+boolean A2l_Report(sElf* elf, const sA2lSpec* spec)
+{
+  sA2l    ctx;
+  boolean result = TRUE;
+
+  memset(&ctx, 0, sizeof(sA2l));
+  ctx.msb = Elf_IsBigEndian(elf);
+
+  if(((Elf32_Ehdr*)elf->header)->e_type == TYP_RELOCATABLE_ELF)
+  {
+    printf("\n\r error: The A2L addresses are those of a linked image, not of an object file !\n\r");
+    return(FALSE);
+  }
+
+  ctx.debug = Dwarf_Open(&ctx.dwarf, elf);
+
+  /* the generation needs the types, the update of plain names only needs the symbols */
+  if(!ctx.debug && spec->update == NULL)
+  {
+    printf("\n\r error: No usable debug information in the file (.debug_info, compile with -g) !\n\r");
+    Dwarf_Close(&ctx.dwarf);
+    return(FALSE);
+  }
+
+  if(!A2l_IndexSymbols(&ctx, elf) || (ctx.debug && !A2l_IndexVariables(&ctx)))
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    result = FALSE;
+  }
+  else if(spec->update != NULL)
+  {
+    result = A2l_Update(&ctx, spec);
+  }
+  else
+  {
+    uint32 counts[A2L_KINDS] = {0, 0};
+    uint32 unique            = 0;
+
+    for(uint32 kind = 0; kind < A2L_KINDS; kind++)
+    {
+      const sA2lNames* names = &spec->names[kind];
+
+      for(uint32 i = 0; i < names->ExactNbr; i++)
+      {
+        A2l_Select(&ctx, names->names[i], kind);
+      }
+
+      /* the patterns select the variables of the debug information */
+      for(uint32 v = 0; names->ExactNbr < names->NamesNbr && v < ctx.VarsNbr; v++)
+      {
+        const sA2lVar* var = &ctx.vars[v];
+
+        /* each name once (the DIE kept by the index), and not twice with the exact names */
+        if(A2l_FindVar(&ctx, var->name) != v ||
+           NULL != bsearch(var->name, names->names, names->ExactNbr, sizeof(char*), A2l_CompareKey))
+        {
+          continue;
+        }
+
+        for(uint32 p = names->ExactNbr; p < names->NamesNbr; p++)
+        {
+          if(Vars_Match(names->names[p], var->name))
+          {
+            A2l_Select(&ctx, var->name, kind);
+            break;
+          }
+        }
+      }
+    }
+
+    result = (boolean)(ctx.errors == 0);
+
+    /* a name selected as a measurement and as a characteristic is a characteristic */
+    if(ctx.ObjectsNbr > 1U)
+    {
+      qsort(ctx.objects, ctx.ObjectsNbr, sizeof(sA2lObject), A2l_CompareObjects);
+    }
+
+    for(uint32 i = 0; i < ctx.ObjectsNbr; i++)
+    {
+      if(unique == 0 || 0 != strcmp(ctx.objects[unique - 1U].name, ctx.objects[i].name))
+      {
+        ctx.objects[unique++] = ctx.objects[i];
+        counts[ctx.objects[i].kind]++;
+      }
+    }
+    ctx.ObjectsNbr = unique;
+
+    result = (boolean)(A2l_Write(&ctx, spec) && result);
+
+    if(spec->out != NULL)
+    {
+      printf("\n\r A2L %u measurement(s), %u characteristic(s)", counts[A2L_MEASUREMENT],
+             counts[A2L_CHARACTERISTIC]);
+      if(ctx.errors > 0)
+      {
+        printf(", %u name(s) not resolved", ctx.errors);
+      }
+      if(ctx.skipped > 0)
+      {
+        printf(", %u object(s) of an unsupported type skipped", ctx.skipped);
+      }
+      printf(" -> %s\n\r", spec->out);
+    }
+  }
+
+  free(ctx.SymSlots);
+  free(ctx.vars);
+  free(ctx.VarSlots);
+  free(ctx.structs);
+  free(ctx.objects);
+  Arena_Release(&ctx.arena);
+  Dwarf_Close(&ctx.dwarf);
+  return(result);
+}
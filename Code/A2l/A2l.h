@@ -0,0 +1,44 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __A2L_H__
+#define __A2L_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define A2L_MAX_LISTS       16U       //@<file> lists of one request
+
+#define A2L_MEASUREMENT     0U
+#define A2L_CHARACTERISTIC  1U
+#define A2L_KINDS           2U
+
+//names of one kind of object: variable names or paths ("state.speed", "tab[2]"), sorted, followed by the patterns
+typedef struct
+{
+  char**  names;
+  uint32  ExactNbr;
+  uint32  NamesNbr;
+  uint32  capacity;
+}sA2lNames;
+
+//parsed -a2l request
+typedef struct
+{
+  sA2lNames names[A2L_KINDS];         //A2L_MEASUREMENT (meas=), A2L_CHARACTERISTIC (char=)
+  char*     update;                   //A2L file whose addresses are updated (upd=), NULL: generation
+  char*     out;                      //output file, NULL: standard output
+  char*     lists[A2L_MAX_LISTS];     //contents of the @<file> lists
+  uint32    ListsNbr;
+  char      copy[MAX_LINE_LEN];
+}sA2lSpec;
+
+boolean A2l_ParseSpec(sA2lSpec* spec, const char* text);
+void    A2l_ReleaseSpec(sA2lSpec* spec);
+boolean A2l_Report(sElf* elf, const sA2lSpec* spec);
+
+#endif
@@ -1,73 +1,1011 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#include<common.h>
-#include<param.h>
-#include<io.h>
-#include<Elf.h>
-
-
-char* ElfFilePath = NULL;
-char* S19FilePath = NULL;
-char* CFilePath   = NULL;
-char* SearchTxt   = NULL;
-
-static char* Buffer = NULL;
-
-extern Elf32_Ehdr* pElfHeader;
-extern Elf32_Shdr* pSectionHeader;
-extern char* pSectionName;
-
-/*********************************************************
-**
-*********************************************************/
-int main(sint32 argc,string argv[])
-{
-  if(Param_OptionParser(argc,argv))
-  {
-    Buffer = LoadInputFile(ElfFilePath);
-
-    if(Buffer != NULL)
-    {
-      if(TRUE == Elf_ProcessElfHeader(Buffer, Param_GetHeaderOpFlag()))
-      {
-        if(Param_GetSecTabOpFlag()) 
-        {
-          Elf_SectionHeaderTable(Buffer);
-        }
-
-        if(Param_GetSymTabOpFlag())
-        {
-          Elf_SymbolTable(Buffer);
-        }
-
-        if(Param_GetCOpFlag())
-        {
-          Elf_ExtractBinaryToC(Buffer, CFilePath);
-        }
-
-        if(Param_GetS19OpFlag())
-        {
-          Elf_ExtractBinaryToS19(Buffer, S19FilePath);
-        }
-
-        if(Param_GetSearchOpFlag())
-        {
-          Elf_SearchInfo(Buffer, SearchTxt);
-        }
-
-        if(Param_GetSrcListOpFlag())
-        {
-          Elf_ListSrcFiles(Buffer);
-        }
-      }
-
-    }
-  }
-  return 0;
-}
-
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<common.h>
+#include<param.h>
+#include<io.h>
+#include<Elf.h>
+#include<Elf_Reloc.h>
+#include<Archive.h>
+#include<Diff.h>
+#include<Manifest.h>
+#include<Crc.h>
+#include<Image.h>
+#include<Store.h>
+#include<Thread.h>
+#include<Bench.h>
+#include<Stats.h>
+#include<Watch.h>
+#include<Region.h>
+#include<StrScan.h>
+#include<Sig.h>
+#include<Patch.h>
+#include<Vars.h>
+#include<SRec.h>
+#include<Merge.h>
+#include<Loader.h>
+#include<Map.h>
+#include<A2l.h>
+
+
+char* ElfFilePath = NULL;
+char* S19FilePath = NULL;
+char* CFilePath   = NULL;
+char* SearchTxt   = NULL;
+char* XrefTxt     = NULL;
+char* ArmapTxt    = NULL;
+char* DiffFilePath = NULL;
+char* HashFilePath = NULL;
+char* HashCmpFilePath = NULL;
+char* BinFilePath = NULL;
+char* StoreDirPath = NULL;
+char* RestoreFilePath = NULL;
+char* GenSpecTxt = NULL;
+char* BenchFilePath = NULL;
+char* StatsFilePath = NULL;
+char* MemFilePath = NULL;
+char* StringsTxt = NULL;
+char* SigFilePath = NULL;
+char* CrcRequests[PARAM_MAX_CRC];
+uint32 CrcRequestsNbr = 0;
+char* PatchRequests[PARAM_MAX_PATCH];
+uint32 PatchRequestsNbr = 0;
+char* ElfOutFilePath = NULL;
+char* VarsTxt = NULL;
+char* VerifyFilePath = NULL;
+char* MergeInputs[PARAM_MAX_MERGE];
+uint32 MergeInputsNbr = 0;
+char* MapTxt = NULL;
+char* A2lTxt = NULL;
+
+static char* Buffer = NULL;
+
+/* signatures of -sig, compiled once for all the processed images */
+static sSigSet Signatures;
+
+/* symbols of -vars, read once for all the processed images */
+static sVarsSpec Variables;
+
+/* store of -store, opened once for all the processed images */
+static sStore Builds;
+
+/* request of -map, the map file itself is read with each image (it is rewritten by each link) */
+static sMapSpec MapRequest;
+
+/* names of -a2l, read once for all the processed images */
+static sA2lSpec A2lRequest;
+
+/* image of the -verify file, decoded once for all the processed images */
+static sSRecImage Flash;
+
+//groups of operations of Main_ProcessElf, a watch update only runs the ones whose input changed
+#define MAIN_OPS_REPORTS  0x1U    //text reports and -bench
+#define MAIN_OPS_IMAGE    0x2U    //operations on the load image (-patch, -crc, -verify, -c, -s19, -bin, -elf,
+                                  //-vars, -mem, -map, -a2l, -sig, -hash, -hashcmp)
+#define MAIN_OPS_FILE     0x4U    //operations on the whole file (-store, -diff)
+#define MAIN_OPS_ALL      0x7U
+
+//contexts of the archive members opened in parallel
+typedef struct
+{
+  const sArchive* archive;
+  sElf*           elf;
+}sMainMembers;
+
+//one build of the watched image, the previous build is kept as the reference of the deltas
+typedef struct
+{
+  char*      buffer;
+  sElf       elf;
+  sDiffImage image;
+  boolean    valid;
+}sMainBuild;
+
+/* set when a compared image differs from its reference */
+static int ExitCode = 0;
+
+static void Main_ProcessFile(char* path, boolean PrintPath);
+static void Main_ProcessBuffer(char* path, uint32 size, boolean PrintPath);
+static void Main_ProcessFileList(char* ListPath);
+static void Main_ProcessArchive(char* path, uint32 size);
+static void Main_OpenMember(uint32 index, void* ctx);
+static void Main_ProcessImage(char* Image, uint32 size, char* path, boolean PrintPath);
+static void Main_PrintTitle(char* path, boolean PrintPath);
+static void Main_ProcessElf(sElf* elf, char* path, uint32 ops);
+static void Main_CountImage(sElf* elf);
+static void Main_DiffImage(sElf* elf, char* path);
+static void Main_ProcessManifest(char* path, uint32 size);
+static void Main_CompareManifest(const sManifest* manifest, char* path);
+static void Main_ExtractBinary(sElf* elf);
+static void Main_ProcessBuild(char* path, uint32 size, boolean PrintPath);
+static void Main_ProcessRecordFile(char* path, uint32 size, boolean PrintPath);
+static boolean Main_LoadVerifyFile(void);
+static void Main_MergeFiles(char* path);
+static void Main_WatchFile(char* path);
+static boolean Main_LoadBuild(sMainBuild* build, char* path, const sDiffImage* prev);
+static void Main_ReleaseBuild(sMainBuild* build);
+
+/*********************************************************
+**
+*********************************************************/
+int main(int argc,char* argv[])
+{
+  if(Param_OptionParser(argc,argv))
+  {
+    if(Param_GetStatsOpFlag())
+    {
+      Stats_Enable();
+    }
+
+    /* -gen creates the input file, which is then processed as usual */
+    if(Param_GetGenOpFlag() && !Bench_Generate(ElfFilePath, GenSpecTxt))
+    {
+      return(1);
+    }
+
+    if(Param_GetSigOpFlag() && !Sig_Load(&Signatures, SigFilePath))
+    {
+      return(1);
+    }
+
+    if(Param_GetVarsOpFlag() && !Vars_ParseSpec(&Variables, VarsTxt))
+    {
+      return(1);
+    }
+
+    if(Param_GetStoreOpFlag() && !Store_Open(&Builds, StoreDirPath, TRUE))
+    {
+      return(1);
+    }
+
+    if(Param_GetMapOpFlag() && !Map_ParseSpec(&MapRequest, MapTxt))
+    {
+      return(1);
+    }
+
+    if(Param_GetA2lOpFlag() && !A2l_ParseSpec(&A2lRequest, A2lTxt))
+    {
+      return(1);
+    }
+
+    if(Param_GetVerifyOpFlag() && !Main_LoadVerifyFile())
+    {
+      return(1);
+    }
+
+    if(Param_GetMergeOpFlag())
+    {
+      Main_MergeFiles(ElfFilePath);
+    }
+    else if(Param_GetWatchOpFlag())
+    {
+      Main_WatchFile(ElfFilePath);
+    }
+    else if(ElfFilePath[0] == '@')
+    {
+      Main_ProcessFileList(&ElfFilePath[1]);
+    }
+    else
+    {
+      Main_ProcessFile(ElfFilePath, FALSE);
+    }
+
+    if(Param_GetSigOpFlag())
+    {
+      Sig_Release(&Signatures);
+    }
+
+    if(Param_GetVarsOpFlag())
+    {
+      Vars_ReleaseSpec(&Variables);
+    }
+
+    if(Param_GetA2lOpFlag())
+    {
+      A2l_ReleaseSpec(&A2lRequest);
+    }
+
+    if(Param_GetStoreOpFlag())
+    {
+      Store_Close(&Builds);
+    }
+
+    if(Param_GetVerifyOpFlag())
+    {
+      SRec_Release(&Flash);
+    }
+
+    if(Param_GetStatsOpFlag())
+    {
+      Stats_Report(StatsFilePath);
+    }
+  }
+  return ExitCode;
+}
+
+/*********************************************************
+** process all the ELF files listed (one path per line)
+** in the file ListPath. The next files are read ahead
+** (Loader) while one is processed.
+*********************************************************/
+static void Main_ProcessFileList(char* ListPath)
+{
+  uint32  size   = 0;
+  uint32  count  = 0;
+  char*   list   = (char*)LoadInputFile(ListPath, &size);
+  char**  paths  = NULL;
+  sLoader loader;
+
+  if(list == NULL)
+  {
+    return;
+  }
+
+  /* split the list in place, one path per non empty line */
+  for(uint32 i = 0; i < size; i++)
+  {
+    count += (uint32)(list[i] == '\n');
+  }
+
+  paths = (char**)malloc(((size_t)count + 1U) * sizeof(char*));
+  count = 0;
+
+  for(char* line = list; paths != NULL && line < list + size; )
+  {
+    char* end = line + strcspn(line, "\n");
+
+    *end = '\0';
+    line[strcspn(line, "\r")] = '\0';
+
+    if(line[0] != '\0')
+    {
+      paths[count++] = line;
+    }
+    line = end + 1;
+  }
+
+  if(paths != NULL && Loader_Open(&loader, paths, count))
+  {
+    sLoaderFile file;
+    uint32      phase = Stats_Begin("load");
+
+    while(Loader_Next(&loader, &file))
+    {
+      Stats_End(phase);
+
+      if(file.buffer != NULL)
+      {
+        Buffer = file.buffer;
+        Main_ProcessBuffer(file.path, file.size, TRUE);
+        Buffer = NULL;
+      }
+      phase = Stats_Begin("load");
+    }
+
+    Stats_End(phase);
+    Loader_Close(&loader);
+  }
+
+  free(paths);
+  free(list);
+}
+
+/*********************************************************
+** load one input file (ELF or archive of ELF objects)
+*********************************************************/
+static void Main_ProcessFile(char* path, boolean PrintPath)
+{
+  uint32 size  = 0;
+  uint32 phase = Stats_Begin("load");
+
+  Buffer = (char*)LoadInputFile(path, &size);
+  Stats_End(phase);
+
+  if(Buffer != NULL)
+  {
+    Main_ProcessBuffer(path, size, PrintPath);
+    free(Buffer);
+    Buffer = NULL;
+  }
+}
+
+/*********************************************************
+** process the loaded input file (Buffer)
+*********************************************************/
+static void Main_ProcessBuffer(char* path, uint32 size, boolean PrintPath)
+{
+  uint32 phase = 0;
+
+  if(Ar_IsArchive(Buffer, size))
+  {
+    Main_ProcessArchive(path, size);
+  }
+  else if(Manifest_IsManifest(Buffer, size))
+  {
+    Main_ProcessManifest(path, size);
+  }
+  else if(Store_IsBuild(Buffer, size))
+  {
+    Main_ProcessBuild(path, size, PrintPath);
+  }
+  else if(SRec_IsRecordFile(Buffer, size))
+  {
+    Main_ProcessRecordFile(path, size, PrintPath);
+  }
+  else
+  {
+    Main_ProcessImage(Buffer, size, path, PrintPath);
+  }
+
+  phase = Stats_Begin("flush");
+  fflush(stdout);
+  Stats_End(phase);
+}
+
+/*********************************************************
+** run the requested operations on every archive member
+** (the members are slices of the loaded archive). The
+** members are opened in parallel, one context each, and
+** reported in archive order.
+*********************************************************/
+static void Main_ProcessArchive(char* path, uint32 size)
+{
+  sArchive archive;
+  sElf*    members = NULL;
+  char     MemberPath[MAX_LINE_LEN];
+
+  if(!Ar_Open(&archive, Buffer, size))
+  {
+    return;
+  }
+
+  if(Param_GetArmapOpFlag())
+  {
+    Ar_PrintSymbolMembers(&archive, ArmapTxt);
+  }
+
+  members = (sElf*)calloc((size_t)archive.MembersNbr + 1, sizeof(sElf));
+
+  if(members != NULL)
+  {
+    sMainMembers jobs  = {&archive, members};
+    uint32       phase = Stats_Begin("open");
+
+    Thread_ParallelFor(archive.MembersNbr, Main_OpenMember, &jobs);
+    Stats_End(phase);
+
+    for(uint32 i = 0; i < archive.MembersNbr; i++)
+    {
+      snprintf(MemberPath, sizeof(MemberPath), "%s(%s)", path, archive.members[i].name);
+      Main_PrintTitle(MemberPath, TRUE);
+
+      if(members[i].ops != NULL)
+      {
+        Main_ProcessElf(&members[i], MemberPath, MAIN_OPS_ALL);
+      }
+      else
+      {
+        Elf_PrintError(&members[i]);
+      }
+      Elf_Close(&members[i]);
+    }
+
+    free(members);
+  }
+  else
+  {
+    printf("\n\r error: Out of memory !\n\r");
+  }
+
+  Ar_Close(&archive);
+}
+
+/*********************************************************
+** parallel job: open the context of one archive member
+*********************************************************/
+static void Main_OpenMember(uint32 index, void* ctx)
+{
+  sMainMembers* jobs = (sMainMembers*)ctx;
+
+  Elf_Open(&jobs->elf[index], jobs->archive->members[index].data, jobs->archive->members[index].size);
+}
+
+/*********************************************************
+** run the requested operations on one ELF image
+*********************************************************/
+static void Main_ProcessImage(char* Image, uint32 size, char* path, boolean PrintPath)
+{
+  sElf    elf;
+  uint32  phase  = STATS_NONE;
+  boolean opened = FALSE;
+
+  Main_PrintTitle(path, PrintPath);
+
+  phase  = Stats_Begin("open");
+  opened = Elf_Open(&elf, Image, size);
+  Stats_End(phase);
+
+  if(opened)
+  {
+    Main_ProcessElf(&elf, path, MAIN_OPS_ALL);
+  }
+  else
+  {
+    Elf_PrintError(&elf);
+  }
+  Elf_Close(&elf);
+}
+
+/*********************************************************
+** print the name of the image before its reports
+*********************************************************/
+static void Main_PrintTitle(char* path, boolean PrintPath)
+{
+  /* the cross-reference names the file on each line, the other reports need a title */
+  if(PrintPath && (Param_GetHeaderOpFlag() || Param_GetSecTabOpFlag() || Param_GetSymTabOpFlag() ||
+                   Param_GetRelTabOpFlag() || Param_GetSearchOpFlag() || Param_GetSrcListOpFlag() ||
+                   Param_GetMemOpFlag() || Param_GetStringsOpFlag() || Param_GetSigOpFlag() ||
+                   Param_GetVarsOpFlag() || Param_GetVerifyOpFlag() || Param_GetMapOpFlag() ||
+                   Param_GetA2lOpFlag()))
+  {
+    printf("\n%s :\n", path);
+  }
+}
+
+/*********************************************************
+** run the requested operations of the groups ops on one
+** opened ELF image (each operation is a -stats phase)
+*********************************************************/
+static void Main_ProcessElf(sElf* elf, char* path, uint32 ops)
+{
+  uint32  phase   = STATS_NONE;
+  boolean reports = (boolean)((ops & MAIN_OPS_REPORTS) != 0);
+  boolean image   = (boolean)((ops & MAIN_OPS_IMAGE) != 0);
+  boolean file    = (boolean)((ops & MAIN_OPS_FILE) != 0);
+
+  if(reports && Stats_IsEnabled())
+  {
+    Main_CountImage(elf);
+  }
+
+  if(reports && Param_GetHeaderOpFlag())
+  {
+    phase = Stats_Begin("-header");
+    Elf_PrintHeader(elf);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetSecTabOpFlag()) 
+  {
+    phase = Stats_Begin("-sec");
+    Elf_SectionHeaderTable(elf);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetSymTabOpFlag())
+  {
+    phase = Stats_Begin("-sym");
+    Elf_SymbolTable(elf);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetRelTabOpFlag())
+  {
+    phase = Stats_Begin("-rel");
+    Elf_RelocationTable(elf);
+    Stats_End(phase);
+  }
+
+  /* the file is archived as loaded, before any patch or CRC is stored in it */
+  if(file && Param_GetStoreOpFlag())
+  {
+    phase = Stats_Begin("-store");
+    if(!Store_Ingest(&Builds, elf, path))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  /* a failed patch list fails the run, the image is then exported unpatched */
+  if(image && Param_GetPatchOpFlag())
+  {
+    phase = Stats_Begin("-patch");
+    if(!Patch_Apply(elf, PatchRequests, PatchRequestsNbr))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  /* the CRC values are stored before the image is exported, so they cover the patched symbols */
+  /* a failed CRC request fails the run, the image is then exported without that CRC */
+  if(image && Param_GetCrcOpFlag())
+  {
+    phase = Stats_Begin("-crc");
+    for(uint32 i = 0; i < CrcRequestsNbr; i++)
+    {
+      if(!Crc_InsertInImage(elf, CrcRequests[i]))
+      {
+        ExitCode = 1;
+      }
+    }
+    Stats_End(phase);
+  }
+
+  /* a difference fails the run, the flashed file is checked against the patched image */
+  if(image && Param_GetVerifyOpFlag())
+  {
+    phase = Stats_Begin("-verify");
+    if(!SRec_Verify(elf, &Flash, VerifyFilePath))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  if(image && Param_GetCOpFlag())
+  {
+    phase = Stats_Begin("-c");
+    Elf_ExtractBinaryToC(elf, CFilePath);
+    Stats_End(phase);
+    Stats_AddOutputFile(CFilePath);
+  }
+
+  if(image && Param_GetS19OpFlag())
+  {
+    phase = Stats_Begin("-s19");
+    Elf_ExtractBinaryToS19(elf, S19FilePath);
+    Stats_End(phase);
+    Stats_AddOutputFile(S19FilePath);
+  }
+
+  if(image && Param_GetBinOpFlag())
+  {
+    phase = Stats_Begin("-bin");
+    Main_ExtractBinary(elf);
+    Stats_End(phase);
+    Stats_AddOutputFile(BinFilePath);
+  }
+
+  if(image && Param_GetElfOpFlag())
+  {
+    phase = Stats_Begin("-elf");
+    SaveBinaryFile(ElfOutFilePath, elf->Buffer, elf->size);
+    Stats_End(phase);
+    Stats_AddOutputFile(ElfOutFilePath);
+  }
+
+  /* the variables are read after the patches, as exported */
+  if(image && Param_GetVarsOpFlag())
+  {
+    phase = Stats_Begin("-vars");
+    if(!Vars_Report(elf, &Variables))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  /* a region overflow fails the run, so that a build can be gated on it */
+  if(image && Param_GetMemOpFlag())
+  {
+    phase = Stats_Begin("-mem");
+    if(!Region_Report(elf, MemFilePath))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  /* a map which does not match the image fails the run as well */
+  if(image && Param_GetMapOpFlag())
+  {
+    phase = Stats_Begin("-map");
+    if(!Map_Report(elf, &MapRequest))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  /* a name of the request which cannot be resolved fails the run */
+  if(image && Param_GetA2lOpFlag())
+  {
+    phase = Stats_Begin("-a2l");
+    if(!A2l_Report(elf, &A2lRequest))
+    {
+      ExitCode = 1;
+    }
+    Stats_End(phase);
+  }
+
+  if(image && Param_GetSigOpFlag())
+  {
+    phase = Stats_Begin("-sig");
+    Sig_Report(elf, &Signatures);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetSearchOpFlag())
+  {
+    phase = Stats_Begin("-search");
+    Elf_SearchInfo(elf, SearchTxt);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetXrefOpFlag())
+  {
+    phase = Stats_Begin("-xref");
+    Elf_XrefSymbol(elf, XrefTxt, path);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetSrcListOpFlag())
+  {
+    phase = Stats_Begin("-srclist");
+    Elf_ListSrcFiles(elf);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetStringsOpFlag())
+  {
+    phase = Stats_Begin("-strings");
+    StrScan_Report(elf, StringsTxt);
+    Stats_End(phase);
+  }
+
+  if(image && (Param_GetHashOpFlag() || Param_GetHashCmpOpFlag()))
+  {
+    sManifest manifest;
+
+    phase = Stats_Begin("-hash");
+    if(Manifest_Build(&manifest, elf))
+    {
+      if(Param_GetHashOpFlag())
+      {
+        Manifest_Write(&manifest, HashFilePath);
+        Stats_AddOutputFile(HashFilePath);
+      }
+
+      if(Param_GetHashCmpOpFlag())
+      {
+        Main_CompareManifest(&manifest, path);
+      }
+      Manifest_Release(&manifest);
+    }
+    Stats_End(phase);
+  }
+
+  if(file && Param_GetDiffOpFlag())
+  {
+    phase = Stats_Begin("-diff");
+    Main_DiffImage(elf, path);
+    Stats_End(phase);
+  }
+
+  if(reports && Param_GetBenchOpFlag())
+  {
+    Bench_Run(elf, path, BenchFilePath);
+  }
+}
+
+/*********************************************************
+** add the section and symbol counts of the image to the
+** -stats counters
+*********************************************************/
+static void Main_CountImage(sElf* elf)
+{
+  sElfSection* sections = NULL;
+  sElfSymbol*  symbols  = NULL;
+  uint32       SecNbr   = 0;
+  uint32       SymNbr   = 0;
+
+  Elf_GetSections(elf, &sections, &SecNbr);
+  Elf_GetSymbols(elf, &symbols, &SymNbr);
+
+  Stats_AddImage(SecNbr, SymNbr);
+}
+
+/*********************************************************
+** rebuild the ELF file of an archived build (input file
+** <StoreDir>/<name>-<xxh64>.build) and run the requested
+** operations on it
+*********************************************************/
+static void Main_ProcessBuild(char* path, uint32 size, boolean PrintPath)
+{
+  uint32 ElfSize = 0;
+  char*  Elf     = Store_Restore(Buffer, size, path, &ElfSize);
+
+  if(Elf != NULL)
+  {
+    if(Param_GetRestoreOpFlag())
+    {
+      SaveBinaryFile(RestoreFilePath, Elf, ElfSize);
+    }
+
+    Main_ProcessImage(Elf, ElfSize, path, PrintPath);
+    free(Elf);
+  }
+  else
+  {
+    ExitCode = 1;
+  }
+}
+
+/*********************************************************
+** wrap the image of an S19 or Intel HEX file into a
+** minimal ELF file and run the requested operations on
+** it (-elf writes the wrapped file)
+*********************************************************/
+static void Main_ProcessRecordFile(char* path, uint32 size, boolean PrintPath)
+{
+  sSRecImage rec;
+  uint32     ElfSize = 0;
+  char*      Elf     = NULL;
+  uint32     phase   = Stats_Begin("decode");
+  boolean    loaded  = SRec_Load(&rec, Buffer, size, path);
+
+  Stats_End(phase);
+
+  if(loaded)
+  {
+    Elf = Image_WrapElf(&rec.image, rec.entry, &ElfSize);
+    SRec_Release(&rec);
+  }
+
+  if(Elf != NULL)
+  {
+    Main_ProcessImage(Elf, ElfSize, path, PrintPath);
+    free(Elf);
+  }
+}
+
+/*********************************************************
+** decode the S19 or Intel HEX file of -verify
+*********************************************************/
+static boolean Main_LoadVerifyFile(void)
+{
+  uint32  size   = 0;
+  char*   text   = (char*)LoadInputFile(VerifyFilePath, &size);
+  boolean loaded = FALSE;
+
+  if(text != NULL)
+  {
+    loaded = SRec_Load(&Flash, text, size, VerifyFilePath);
+    free(text);
+  }
+  return(loaded);
+}
+
+/*********************************************************
+** merge the load images of the input file and of the
+** -merge inputs, then run the requested operations on
+** the merged image wrapped into a minimal ELF file (a
+** conflict fails the run, nothing is written)
+*********************************************************/
+static void Main_MergeFiles(char* path)
+{
+  sMerge* merge   = (sMerge*)calloc(1, sizeof(sMerge));
+  uint32  ElfSize = 0;
+  char*   Elf     = NULL;
+  uint32  phase   = Stats_Begin("-merge");
+
+  if(merge == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    ExitCode = 1;
+    return;
+  }
+
+  if(Merge_Load(merge, path, MergeInputs, MergeInputsNbr) && Merge_Build(merge))
+  {
+    Elf = Image_WrapElf(&merge->image, merge->entry, &ElfSize);
+  }
+  Merge_Release(merge);
+  free(merge);
+  Stats_End(phase);
+
+  if(Elf == NULL)
+  {
+    ExitCode = 1;
+    return;
+  }
+
+  Main_ProcessImage(Elf, ElfSize, path, FALSE);
+  free(Elf);
+  fflush(stdout);
+}
+
+/*********************************************************
+** write the load image as a raw binary (-bin)
+*********************************************************/
+static void Main_ExtractBinary(sElf* elf)
+{
+  sImage image;
+
+  if(Image_BuildFromElf(&image, elf))
+  {
+    Image_WriteBinary(&image, BinFilePath, IMAGE_FILL_BYTE);
+    Image_Release(&image);
+  }
+}
+
+/*********************************************************
+** compare one ELF image with the reference image given
+** by -diff (the reference is loaded for each image)
+*********************************************************/
+static void Main_DiffImage(sElf* elf, char* path)
+{
+  sElf RefImage;
+
+  if(Elf_Load(&RefImage, DiffFilePath))
+  {
+    Diff_Images(&RefImage, elf, DiffFilePath, path);
+    Elf_Close(&RefImage);
+  }
+  else
+  {
+    Elf_PrintError(&RefImage);
+  }
+}
+
+/*********************************************************
+** compare a saved hash manifest (input file) with the
+** reference manifest given by -hashcmp
+*********************************************************/
+static void Main_ProcessManifest(char* path, uint32 size)
+{
+  sManifest manifest;
+
+  if(Param_GetHashCmpOpFlag() && Manifest_Parse(&manifest, Buffer, size))
+  {
+    Main_CompareManifest(&manifest, path);
+    Manifest_Release(&manifest);
+  }
+}
+
+/*********************************************************
+** compare a manifest with the reference manifest given
+** by -hashcmp
+*********************************************************/
+static void Main_CompareManifest(const sManifest* manifest, char* path)
+{
+  sManifest ref;
+  uint32    size      = 0;
+  char*     RefBuffer = (char*)LoadInputFile(HashCmpFilePath, &size);
+
+  if(RefBuffer != NULL)
+  {
+    if(Manifest_Parse(&ref, RefBuffer, size))
+    {
+      if(!Manifest_Compare(&ref, manifest, HashCmpFilePath, path))
+      {
+        ExitCode = 1;
+      }
+      Manifest_Release(&ref);
+    }
+    free(RefBuffer);
+  }
+}
+
+/*********************************************************
+** process the ELF file, then watch it: each new build is
+** reported as the section and symbol deltas from the
+** previous build, and only the outputs whose input
+** sections changed are written again
+*********************************************************/
+static void Main_WatchFile(char* path)
+{
+  sWatch     watch;
+  sMainBuild builds[2];
+  uint32     current = 0;
+
+  memset(builds, 0, sizeof(builds));
+
+  if(!Watch_Open(&watch, path))
+  {
+    printf("\n\r error: Cannot watch the file !\n\r");
+    return;
+  }
+
+  if(Main_LoadBuild(&builds[0], path, NULL))
+  {
+    Main_ProcessElf(&builds[0].elf, path, MAIN_OPS_ALL);
+  }
+  fflush(stdout);
+
+  while(Watch_Wait(&watch))
+  {
+    sMainBuild*  prev  = &builds[current];
+    sMainBuild*  next  = &builds[current ^ 1U];
+    double       start = Stats_Now();
+    sDiffSummary summary;
+
+    /* a build that cannot be read keeps the last valid one as the reference */
+    if(Main_LoadBuild(next, path, prev->valid ? &prev->image : NULL))
+    {
+      if(!prev->valid)
+      {
+        Main_ProcessElf(&next->elf, path, MAIN_OPS_ALL);
+      }
+      else
+      {
+        Diff_Summarize(&prev->elf, &prev->image, &next->elf, &next->image, &summary);
+
+        if(summary.sections > 0)
+        {
+          /* the symbols can only change with their table or with the load image */
+          Diff_Report(&prev->image, &next->image, &next->elf.arena, "previous build", path,
+                      (boolean)(summary.symbols || summary.AllocSections > 0));
+
+          /* the patched ELF file (-elf) is also an output of the sections out of the load image */
+          Main_ProcessElf(&next->elf, path, MAIN_OPS_FILE |
+                          ((summary.AllocSections > 0 || Param_GetElfOpFlag()) ? MAIN_OPS_IMAGE : 0U));
+        }
+
+        printf("\nWATCH : %s : %u section(s) changed, %u in the load image, updated in %.2f ms\n", path,
+               summary.sections, summary.AllocSections, (Stats_Now() - start) * 1000.0);
+      }
+
+      Main_ReleaseBuild(prev);
+      current ^= 1U;
+    }
+    fflush(stdout);
+  }
+
+  Main_ReleaseBuild(&builds[0]);
+  Main_ReleaseBuild(&builds[1]);
+  Watch_Close(&watch);
+}
+
+/*********************************************************
+** load, open and hash one build of the watched image
+** (prev: the previous build, its unchanged symbols are
+** not hashed again)
+*********************************************************/
+static boolean Main_LoadBuild(sMainBuild* build, char* path, const sDiffImage* prev)
+{
+  uint32 size = 0;
+
+  memset(build, 0, sizeof(sMainBuild));
+
+  build->buffer = (char*)LoadInputFile(path, &size);
+
+  if(build->buffer == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(!Elf_Open(&build->elf, build->buffer, size))
+  {
+    Elf_PrintError(&build->elf);
+  }
+  else
+  {
+    build->valid = Diff_PrepareImage(&build->elf, &build->image, prev);
+  }
+
+  if(!build->valid)
+  {
+    Main_ReleaseBuild(build);
+  }
+  return(build->valid);
+}
+
+/*********************************************************
+** release one build of the watched image
+*********************************************************/
+static void Main_ReleaseBuild(sMainBuild* build)
+{
+  if(build->buffer != NULL)
+  {
+    Elf_Close(&build->elf);
+    free(build->buffer);
+  }
+  memset(build, 0, sizeof(sMainBuild));
+}
@@ -0,0 +1,502 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Archive.h>
+
+#define AR_GNU_SYMTAB       "/ "
+#define AR_GNU_SYMTAB64     "/SYM64/"
+#define AR_GNU_LONGNAMES    "// "
+#define AR_BSD_LONGNAME     "#1/"
+#define AR_BSD_SYMTAB       "__.SYMDEF"
+
+typedef enum
+{
+  AR_ENTRY_MEMBER = 0,
+  AR_ENTRY_GNU_SYMTAB,
+  AR_ENTRY_GNU_SYMTAB64,
+  AR_ENTRY_GNU_LONGNAMES,
+  AR_ENTRY_BSD_SYMTAB
+}tArEntryKind;
+
+//one raw entry of the archive before the name is resolved
+typedef struct
+{
+  tArEntryKind kind;
+  char*  name;
+  uint32 NameLen;
+  char*  data;
+  uint32 size;
+  uint32 HeaderOffset;
+}sArEntry;
+
+static boolean Ar_NextEntry(char* Buffer, uint32 size, uint32* pos, char* LongNames, uint32 LongNamesSize, sArEntry* entry);
+static uint32  Ar_ParseDecimal(const char* field, uint32 len);
+static uint32  Ar_ReadBe32(const uint8* p);
+static uint64  Ar_ReadBe64(const uint8* p);
+static uint32  Ar_ReadLe32(const uint8* p);
+static boolean Ar_AddSymbol(sArchive* archive, uint32* capacity, char* name, uint64 HeaderOffset);
+static int     Ar_CompareSymbols(const void* a, const void* b);
+static int     Ar_CompareSymbolNames(const void* a, const void* b);
+
+/*******************************************************************************************************************
+** Function:    Ar_IsArchive
+** Description: check the archive magic number
+** Parameter:   char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Ar_IsArchive(char* Buffer, uint32 size)
+{
+  return((boolean)(Buffer != NULL && size >= AR_MAGIC_SIZE && 0 == memcmp(Buffer, AR_MAGIC, AR_MAGIC_SIZE)));
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_Open
+** Description: index the members and the symbol table (GNU "/" and "/SYM64/", or BSD "__.SYMDEF") of an
+**              archive held in Buffer. Member data are slices of Buffer, nothing is copied.
+** Parameter:   sArchive* archive, char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Ar_Open(sArchive* archive, char* Buffer, uint32 size)
+{
+  sArEntry entry;
+  char*    LongNames     = NULL;
+  uint32   LongNamesSize = 0;
+  uint32   NamesSize     = 0;
+  uint32   capacity      = 0;
+  uint32   pos           = 0;
+  sArEntry SymTab        = {AR_ENTRY_MEMBER, NULL, 0, NULL, 0, 0};
+
+  memset(archive, 0, sizeof(sArchive));
+
+  if(!Ar_IsArchive(Buffer, size))
+  {
+    if(Buffer != NULL && size >= AR_MAGIC_SIZE && 0 == memcmp(Buffer, AR_THIN_MAGIC, AR_MAGIC_SIZE))
+    {
+      printf("\n\r error: Thin archives are not supported !\n\r");
+    }
+    return(FALSE);
+  }
+
+  archive->Buffer = Buffer;
+  archive->size   = size;
+
+  /* pass 1: locate the long names table and count the members */
+  pos = AR_MAGIC_SIZE;
+  while(Ar_NextEntry(Buffer, size, &pos, NULL, 0, &entry))
+  {
+    if(entry.kind == AR_ENTRY_GNU_LONGNAMES)
+    {
+      LongNames     = entry.data;
+      LongNamesSize = entry.size;
+    }
+    else if(entry.kind == AR_ENTRY_MEMBER)
+    {
+      archive->MembersNbr++;
+    }
+  }
+
+  /* pass 2: resolve the member names and slice the members */
+  pos = AR_MAGIC_SIZE;
+  while(Ar_NextEntry(Buffer, size, &pos, LongNames, LongNamesSize, &entry))
+  {
+    NamesSize += entry.NameLen + 1;
+  }
+
+  archive->members = (sArMember*)calloc(archive->MembersNbr + 1, sizeof(sArMember));
+  archive->names   = (char*)malloc(NamesSize + 1);
+
+  if(archive->members == NULL || archive->names == NULL)
+  {
+    Ar_Close(archive);
+    return(FALSE);
+  }
+
+  pos       = AR_MAGIC_SIZE;
+  NamesSize = 0;
+  archive->MembersNbr = 0;
+
+  while(Ar_NextEntry(Buffer, size, &pos, LongNames, LongNamesSize, &entry))
+  {
+    if(entry.kind == AR_ENTRY_MEMBER)
+    {
+      sArMember* member = &archive->members[archive->MembersNbr++];
+
+      member->name = &archive->names[NamesSize];
+      memcpy(member->name, entry.name, entry.NameLen);
+      member->name[entry.NameLen] = '\0';
+      NamesSize += entry.NameLen + 1;
+
+      member->data         = entry.data;
+      member->size         = entry.size;
+      member->HeaderOffset = entry.HeaderOffset;
+    }
+    else if(entry.kind != AR_ENTRY_GNU_LONGNAMES && SymTab.data == NULL)
+    {
+      SymTab = entry;
+    }
+  }
+
+  /* symbol table: name -> header offset of the defining member */
+  if(SymTab.data != NULL)
+  {
+    const uint8* p = (const uint8*)SymTab.data;
+
+    /* the offsets table must fit in the index before its strings are located */
+    if(SymTab.kind == AR_ENTRY_GNU_SYMTAB && SymTab.size >= 4 && Ar_ReadBe32(p) <= (SymTab.size - 4) / 4)
+    {
+      uint32 count   = Ar_ReadBe32(p);
+      char*  strings = SymTab.data + 4 + ((uint64)count * 4);
+      char*  end     = SymTab.data + SymTab.size;
+
+      for(uint32 i = 0; i < count && strings < end && (4 + ((uint64)i * 4) + 4) <= SymTab.size; i++)
+      {
+        char* stop = (char*)memchr(strings, '\0', (size_t)(end - strings));
+
+        if(stop == NULL)
+        {
+          break;
+        }
+        Ar_AddSymbol(archive, &capacity, strings, Ar_ReadBe32(p + 4 + (i * 4)));
+        strings = stop + 1;
+      }
+    }
+    else if(SymTab.kind == AR_ENTRY_GNU_SYMTAB64 && SymTab.size >= 8 && Ar_ReadBe64(p) <= (SymTab.size - 8) / 8)
+    {
+      uint64 count   = Ar_ReadBe64(p);
+      char*  strings = SymTab.data + 8 + (count * 8);
+      char*  end     = SymTab.data + SymTab.size;
+
+      for(uint64 i = 0; i < count && strings < end && (8 + (i * 8) + 8) <= SymTab.size; i++)
+      {
+        char* stop = (char*)memchr(strings, '\0', (size_t)(end - strings));
+
+        if(stop == NULL)
+        {
+          break;
+        }
+        Ar_AddSymbol(archive, &capacity, strings, Ar_ReadBe64(p + 8 + (i * 8)));
+        strings = stop + 1;
+      }
+    }
+    else if(SymTab.kind == AR_ENTRY_BSD_SYMTAB && SymTab.size >= 4)
+    {
+      uint32 RanlibSize = Ar_ReadLe32(p);
+
+      if((uint64)RanlibSize + 8 <= SymTab.size)
+      {
+        char*  strings = SymTab.data + 8 + RanlibSize;
+        uint32 StrSize = Ar_ReadLe32(p + 4 + RanlibSize);
+
+        for(uint32 i = 0; (i * 8) + 8 <= RanlibSize; i++)
+        {
+          uint32 strx = Ar_ReadLe32(p + 4 + (i * 8));
+
+          if(strx < StrSize && ((uint64)8 + RanlibSize + StrSize) <= SymTab.size)
+          {
+            Ar_AddSymbol(archive, &capacity, strings + strx, Ar_ReadLe32(p + 4 + (i * 8) + 4));
+          }
+        }
+      }
+    }
+
+    if(archive->SymbolsNbr > 1)
+    {
+      qsort(archive->symbols, archive->SymbolsNbr, sizeof(sArSymbol), Ar_CompareSymbols);
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_Close
+** Description: release the member and symbol indexes (the archive buffer is owned by the caller)
+** Parameter:   sArchive* archive
+** Return:      void
+*******************************************************************************************************************/
+void Ar_Close(sArchive* archive)
+{
+  free(archive->members);
+  free(archive->symbols);
+  free(archive->names);
+  memset(archive, 0, sizeof(sArchive));
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_FindSymbol
+** Description: get the member which defines a symbol, from the archive symbol index (binary search)
+** Parameter:   const sArchive* archive, const char* name, uint32* member
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Ar_FindSymbol(const sArchive* archive, const char* name, uint32* member)
+{
+  sArSymbol  key = {(char*)name, 0};
+  sArSymbol* hit = NULL;
+
+  if(archive->symbols == NULL)
+  {
+    return(FALSE);
+  }
+
+  hit = (sArSymbol*)bsearch(&key, archive->symbols, archive->SymbolsNbr, sizeof(sArSymbol), Ar_CompareSymbolNames);
+
+  if(hit == NULL)
+  {
+    return(FALSE);
+  }
+
+  /* report the first definition in archive order */
+  while(hit > archive->symbols && 0 == strcmp((hit - 1)->name, name))
+  {
+    hit--;
+  }
+
+  *member = hit->member;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_PrintSymbolMembers
+** Description: display every member which defines a symbol according to the archive symbol index
+** Parameter:   const sArchive* archive, const char* name
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Ar_PrintSymbolMembers(const sArchive* archive, const char* name)
+{
+  uint32 first = 0;
+
+  printf("\nARCHIVE SYMBOL INDEX (%s) : \n\n", name);
+
+  if(archive->symbols == NULL)
+  {
+    printf(" the archive has no symbol index !\n");
+    return(FALSE);
+  }
+
+  if(!Ar_FindSymbol(archive, name, &first))
+  {
+    printf(" %s is not defined in the archive\n", name);
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < archive->SymbolsNbr; i++)
+  {
+    if(0 == strcmp(archive->symbols[i].name, name))
+    {
+      printf(" %s\n", archive->members[archive->symbols[i].member].name);
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_NextEntry
+** Description: parse the entry header at *pos and advance *pos to the next entry. The member name is resolved
+**              when the long names table is given (GNU "/<offset>" or BSD "#1/<length>" names).
+** Parameter:   char* Buffer, uint32 size, uint32* pos, char* LongNames, uint32 LongNamesSize, sArEntry* entry
+** Return:      boolean (FALSE at the end of the archive or on a malformed header)
+*******************************************************************************************************************/
+static boolean Ar_NextEntry(char* Buffer, uint32 size, uint32* pos, char* LongNames, uint32 LongNamesSize, sArEntry* entry)
+{
+  sArHeader* header = NULL;
+  uint32     DataSize = 0;
+
+  if((uint64)*pos + AR_HEADER_SIZE > size)
+  {
+    return(FALSE);
+  }
+
+  header   = (sArHeader*)(Buffer + *pos);
+  DataSize = Ar_ParseDecimal(header->ar_size, sizeof(header->ar_size));
+
+  if(header->ar_fmag[0] != '`' || header->ar_fmag[1] != '\n' || ((uint64)*pos + AR_HEADER_SIZE + DataSize) > size)
+  {
+    return(FALSE);
+  }
+
+  entry->kind         = AR_ENTRY_MEMBER;
+  entry->HeaderOffset = *pos;
+  entry->data         = Buffer + *pos + AR_HEADER_SIZE;
+  entry->size         = DataSize;
+  entry->name         = header->ar_name;
+  entry->NameLen      = 0;
+
+  /* next header starts on an even offset */
+  *pos += AR_HEADER_SIZE + DataSize + (DataSize & 1U);
+
+  if(0 == strncmp(header->ar_name, AR_GNU_SYMTAB, strlen(AR_GNU_SYMTAB)))
+  {
+    entry->kind = AR_ENTRY_GNU_SYMTAB;
+  }
+  else if(0 == strncmp(header->ar_name, AR_GNU_SYMTAB64, strlen(AR_GNU_SYMTAB64)))
+  {
+    entry->kind = AR_ENTRY_GNU_SYMTAB64;
+  }
+  else if(0 == strncmp(header->ar_name, AR_GNU_LONGNAMES, strlen(AR_GNU_LONGNAMES)))
+  {
+    entry->kind = AR_ENTRY_GNU_LONGNAMES;
+  }
+  else if(0 == strncmp(header->ar_name, AR_BSD_LONGNAME, strlen(AR_BSD_LONGNAME)))
+  {
+    /* BSD: the name is stored in front of the data */
+    uint32 len = Ar_ParseDecimal(&header->ar_name[3], sizeof(header->ar_name) - 3);
+
+    if(len > DataSize)
+    {
+      return(FALSE);
+    }
+
+    entry->name    = entry->data;
+    entry->NameLen = (uint32)strnlen(entry->data, len);
+    entry->data   += len;
+    entry->size   -= len;
+
+    if(0 == strncmp(entry->name, AR_BSD_SYMTAB, strlen(AR_BSD_SYMTAB)))
+    {
+      entry->kind = AR_ENTRY_BSD_SYMTAB;
+    }
+  }
+  else if(0 == strncmp(header->ar_name, AR_BSD_SYMTAB, strlen(AR_BSD_SYMTAB)))
+  {
+    entry->kind = AR_ENTRY_BSD_SYMTAB;
+  }
+  else if(header->ar_name[0] == '/' && LongNames != NULL)
+  {
+    /* GNU: "/<offset>" in the long names table, terminated by "/\n" */
+    uint32 offset = Ar_ParseDecimal(&header->ar_name[1], sizeof(header->ar_name) - 1);
+
+    if(offset < LongNamesSize)
+    {
+      entry->name = LongNames + offset;
+      while((offset + entry->NameLen) < LongNamesSize && entry->name[entry->NameLen] != '\n')
+      {
+        entry->NameLen++;
+      }
+      if(entry->NameLen > 0 && entry->name[entry->NameLen - 1] == '/')
+      {
+        entry->NameLen--;
+      }
+    }
+  }
+  else
+  {
+    /* short name: GNU terminates it with '/', BSD pads it with spaces */
+    while(entry->NameLen < sizeof(header->ar_name) && header->ar_name[entry->NameLen] != '/' && header->ar_name[entry->NameLen] != ' ')
+    {
+      entry->NameLen++;
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_ParseDecimal
+** Description: parse a space padded decimal header field
+** Parameter:   const char* field, uint32 len
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 Ar_ParseDecimal(const char* field, uint32 len)
+{
+  uint32 value = 0;
+
+  for(uint32 i = 0; i < len && field[i] >= '0' && field[i] <= '9'; i++)
+  {
+    value = (value * 10U) + (uint32)(field[i] - '0');
+  }
+  return(value);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_ReadBe32 / Ar_ReadBe64 / Ar_ReadLe32
+** Description: read the integers of the symbol tables (GNU: big endian, BSD: little endian)
+*******************************************************************************************************************/
+static uint32 Ar_ReadBe32(const uint8* p)
+{
+  return(((uint32)p[0] << 24) | ((uint32)p[1] << 16) | ((uint32)p[2] << 8) | (uint32)p[3]);
+}
+
+static uint64 Ar_ReadBe64(const uint8* p)
+{
+  return(((uint64)Ar_ReadBe32(p) << 32) | (uint64)Ar_ReadBe32(p + 4));
+}
+
+static uint32 Ar_ReadLe32(const uint8* p)
+{
+  return(((uint32)p[3] << 24) | ((uint32)p[2] << 16) | ((uint32)p[1] << 8) | (uint32)p[0]);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_AddSymbol
+** Description: append one symbol index entry, the member is found by its header offset (binary search)
+** Parameter:   sArchive* archive, uint32* capacity, char* name, uint64 HeaderOffset
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Ar_AddSymbol(sArchive* archive, uint32* capacity, char* name, uint64 HeaderOffset)
+{
+  uint32 low  = 0;
+  uint32 high = archive->MembersNbr;
+
+  while(low < high)
+  {
+    uint32 mid = low + ((high - low) / 2U);
+
+    if(archive->members[mid].HeaderOffset < HeaderOffset)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  if(low >= archive->MembersNbr || archive->members[low].HeaderOffset != HeaderOffset)
+  {
+    return(FALSE);
+  }
+
+  if(archive->SymbolsNbr == *capacity)
+  {
+    uint32     NewCapacity = (*capacity == 0) ? 256U : (*capacity * 2U);
+    sArSymbol* symbols     = (sArSymbol*)realloc(archive->symbols, NewCapacity * sizeof(sArSymbol));
+
+    if(symbols == NULL)
+    {
+      return(FALSE);
+    }
+    archive->symbols = symbols;
+    *capacity        = NewCapacity;
+  }
+
+  archive->symbols[archive->SymbolsNbr].name   = name;
+  archive->symbols[archive->SymbolsNbr].member = low;
+  archive->SymbolsNbr++;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Ar_CompareSymbols / Ar_CompareSymbolNames
+** Description: qsort compare function (by name, then by member order) and bsearch compare function (by name)
+*******************************************************************************************************************/
+static int Ar_CompareSymbols(const void* a, const void* b)
+{
+  const sArSymbol* sa = (const sArSymbol*)a;
+  const sArSymbol* sb = (const sArSymbol*)b;
+  int cmp = strcmp(sa->name, sb->name);
+
+  if(cmp != 0)
+  {
+    return(cmp);
+  }
+  return((sa->member > sb->member) - (sa->member < sb->member));
+}
+
+static int Ar_CompareSymbolNames(const void* a, const void* b)
+{
+  return(strcmp(((const sArSymbol*)a)->name, ((const sArSymbol*)b)->name));
+}
@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __ARCHIVE_H__
+#define __ARCHIVE_H__
+
+#include<common.h>
+
+#define AR_MAGIC            "!<arch>\n"
+#define AR_THIN_MAGIC       "!<thin>\n"
+#define AR_MAGIC_SIZE       8U
+#define AR_HEADER_SIZE      60U
+
+//member header as stored in the archive (all fields are ASCII, space padded)
+typedef struct
+{
+  char ar_name[16];
+  char ar_date[12];
+  char ar_uid[6];
+  char ar_gid[6];
+  char ar_mode[8];
+  char ar_size[10];
+  char ar_fmag[2];
+}sArHeader;
+
+//one object of the archive, data is a slice of the archive buffer (no copy)
+typedef struct
+{
+  char*  name;
+  char*  data;
+  uint32 size;
+  uint32 HeaderOffset;
+}sArMember;
+
+//one entry of the archive symbol index (armap)
+typedef struct
+{
+  char*  name;
+  uint32 member;
+}sArSymbol;
+
+typedef struct
+{
+  char*      Buffer;
+  uint32     size;
+  sArMember* members;
+  uint32     MembersNbr;
+  sArSymbol* symbols;
+  uint32     SymbolsNbr;
+  char*      names;        //storage of the member names
+}sArchive;
+
+boolean Ar_IsArchive(char* Buffer, uint32 size);
+boolean Ar_Open(sArchive* archive, char* Buffer, uint32 size);
+void    Ar_Close(sArchive* archive);
+boolean Ar_FindSymbol(const sArchive* archive, const char* name, uint32* member);
+boolean Ar_PrintSymbolMembers(const sArchive* archive, const char* name);
+
+#endif
@@ -0,0 +1,186 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Arena allocation of the per-image structures.
+**
+** Each image context (sElf) owns an arena: the host order tables, the section and symbol views and the tables of
+** the reports built on them are taken from it, and Elf_Close releases them in one call. The worker threads of
+** Thread_ParallelFor have their own arena (Arena_Thread) for the scratch memory of a job, used with
+** Arena_Mark/Arena_Rewind and released when the worker ends.
+*******************************************************************************************************************/
+
+#include<Arena.h>
+
+#if defined(_MSC_VER)
+  #define ARENA_THREAD_LOCAL  __declspec(thread)
+#else
+  #define ARENA_THREAD_LOCAL  __thread
+#endif
+
+//header of a block, the allocations follow it
+struct sArenaBlock
+{
+  sArenaBlock* next;
+  size_t       size;                   //bytes available after the header
+  size_t       used;
+};
+
+#define ARENA_HEADER_SIZE  ((sizeof(sArenaBlock) + ARENA_ALIGN - 1U) & ~(size_t)(ARENA_ALIGN - 1U))
+
+static ARENA_THREAD_LOCAL sArena ArenaThread;
+
+/*******************************************************************************************************************
+** Function:    Arena_Alloc
+** Description: take size bytes (aligned on ARENA_ALIGN) from the arena. The small allocations share blocks of
+**              ARENA_BLOCK_SIZE bytes, a large one (a table of a big image) gets a block of its own.
+** Parameter:   sArena* arena, size_t size
+** Return:      void* (NULL if out of memory)
+*******************************************************************************************************************/
+void* Arena_Alloc(sArena* arena, size_t size)
+{
+  sArenaBlock* block = arena->blocks;
+
+  if(size > ((size_t)-1) - ARENA_HEADER_SIZE - ARENA_ALIGN)
+  {
+    return(NULL);
+  }
+
+  size = (size + ARENA_ALIGN - 1U) & ~(size_t)(ARENA_ALIGN - 1U);
+
+  if(size == 0)
+  {
+    size = ARENA_ALIGN;
+  }
+
+  if(block == NULL || (block->size - block->used) < size)
+  {
+    size_t capacity = (size > ARENA_LARGE_SIZE) ? size : ARENA_BLOCK_SIZE;
+
+    block = (sArenaBlock*)malloc(ARENA_HEADER_SIZE + capacity);
+
+    if(block == NULL)
+    {
+      return(NULL);
+    }
+
+    block->next   = arena->blocks;
+    block->size   = capacity;
+    block->used   = 0;
+    arena->blocks = block;
+  }
+
+  block->used += size;
+  return((char*)block + ARENA_HEADER_SIZE + block->used - size);
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_Calloc
+** Description: take a zero filled array of count elements from the arena
+** Parameter:   sArena* arena, size_t count, size_t size
+** Return:      void* (NULL if out of memory)
+*******************************************************************************************************************/
+void* Arena_Calloc(sArena* arena, size_t count, size_t size)
+{
+  void* data = NULL;
+
+  if(size != 0 && count > ((size_t)-1) / size)
+  {
+    return(NULL);
+  }
+
+  data = Arena_Alloc(arena, count * size);
+
+  if(data != NULL)
+  {
+    memset(data, 0, count * size);
+  }
+  return(data);
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_Mark
+** Description: get the current position of the arena
+** Parameter:   sArena* arena
+** Return:      sArenaMark
+*******************************************************************************************************************/
+sArenaMark Arena_Mark(sArena* arena)
+{
+  sArenaMark mark;
+
+  mark.block = arena->blocks;
+  mark.used  = (arena->blocks != NULL) ? arena->blocks->used : 0;
+  return(mark);
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_Rewind
+** Description: release everything taken from the arena since the mark. Rewinding an arena to empty keeps its
+**              first block for the next allocations (scratch memory of the jobs, see Arena_Thread).
+** Parameter:   sArena* arena, sArenaMark mark
+** Return:      void
+*******************************************************************************************************************/
+void Arena_Rewind(sArena* arena, sArenaMark mark)
+{
+  while(arena->blocks != NULL && arena->blocks != mark.block)
+  {
+    sArenaBlock* block = arena->blocks;
+
+    if(mark.block == NULL && block->next == NULL && block->size == ARENA_BLOCK_SIZE)
+    {
+      block->used = 0;
+      return;
+    }
+
+    arena->blocks = block->next;
+    free(block);
+  }
+
+  if(arena->blocks != NULL)
+  {
+    arena->blocks->used = mark.used;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_Release
+** Description: free all the blocks of the arena (the arena stays usable)
+** Parameter:   sArena* arena
+** Return:      void
+*******************************************************************************************************************/
+void Arena_Release(sArena* arena)
+{
+  while(arena->blocks != NULL)
+  {
+    sArenaBlock* block = arena->blocks;
+
+    arena->blocks = block->next;
+    free(block);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_Thread
+** Description: get the arena of the calling thread (scratch memory of the parallel jobs)
+** Parameter:   void
+** Return:      sArena*
+*******************************************************************************************************************/
+sArena* Arena_Thread(void)
+{
+  return(&ArenaThread);
+}
+
+/*******************************************************************************************************************
+** Function:    Arena_ReleaseThread
+** Description: free the arena of the calling thread (called when a worker thread ends)
+** Parameter:   void
+** Return:      void
+*******************************************************************************************************************/
+void Arena_ReleaseThread(void)
+{
+  Arena_Release(&ArenaThread);
+}
@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include<common.h>
+
+#define ARENA_BLOCK_SIZE      (64U * 1024U)           //size of the blocks shared by the small allocations
+#define ARENA_LARGE_SIZE      (ARENA_BLOCK_SIZE / 4U) //larger allocations get a block of their own
+#define ARENA_ALIGN           16U
+
+typedef struct sArenaBlock sArenaBlock;
+
+//bump allocator: the allocations are never freed one by one, the whole arena is released (or rewound) at once.
+//A zero filled sArena is an empty arena.
+typedef struct
+{
+  sArenaBlock* blocks;                 //current block first
+}sArena;
+
+//position of an arena (see Arena_Mark/Arena_Rewind)
+typedef struct
+{
+  sArenaBlock* block;
+  size_t       used;
+}sArenaMark;
+
+void*      Arena_Alloc(sArena* arena, size_t size);
+void*      Arena_Calloc(sArena* arena, size_t count, size_t size);
+sArenaMark Arena_Mark(sArena* arena);
+void       Arena_Rewind(sArena* arena, sArenaMark mark);
+void       Arena_Release(sArena* arena);
+sArena*    Arena_Thread(void);
+void       Arena_ReleaseThread(void);
+
+#endif
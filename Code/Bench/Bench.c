@@ -0,0 +1,314 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Benchmark of the parser operations (-bench).
+**
+** Each operation is run BENCH_MIN_RUNS times at least, and again until BENCH_MIN_TIME seconds are spent. One CSV row
+** per operation is appended to the report file:
+**
+**   image,bytes,sections,symbols,operation,runs,best_ms,mean_ms,mb_per_s,peak_rss_kb
+**
+** Benchmarking a list of generated images of growing size (@<ListFile>) gives the scaling curve of each operation,
+** and the reports of two commits run on the same images can be compared row by row.
+**
+** The reports of the measured operations are formatted as usual but written to the null device: the timings do
+** not depend on the terminal or the pipe behind stdout.
+*******************************************************************************************************************/
+
+#include<Bench.h>
+#include<Stats.h>
+
+#if defined(_WIN32)
+  //<io.h> of the CRT is hidden by IO/io.h
+  int __cdecl _dup(int fd);
+  int __cdecl _dup2(int fd, int fd2);
+  int __cdecl _close(int fd);
+  #define BENCH_DUP(fd)        _dup(fd)
+  #define BENCH_DUP2(fd, fd2)  _dup2((fd), (fd2))
+  #define BENCH_CLOSE(fd)      _close(fd)
+  #define BENCH_FILENO(file)   _fileno(file)
+  #define BENCH_NULL_DEVICE    "NUL"
+#else
+  #include<unistd.h>
+  #define BENCH_DUP(fd)        dup(fd)
+  #define BENCH_DUP2(fd, fd2)  dup2((fd), (fd2))
+  #define BENCH_CLOSE(fd)      close(fd)
+  #define BENCH_FILENO(file)   fileno(file)
+  #define BENCH_NULL_DEVICE    "/dev/null"
+#endif
+
+#define BENCH_REPORT_HEADER  "image,bytes,sections,symbols,operation,runs,best_ms,mean_ms,mb_per_s,peak_rss_kb\n"
+
+//inputs of the measured operations
+typedef struct
+{
+  char Symbol[MAX_LINE_LEN];         //searched symbol (the last one of the table: worst case of a linear search)
+  char CPath[MAX_LINE_LEN];          //temporary outputs of the exporters
+  char S19Path[MAX_LINE_LEN];
+}sBenchCtx;
+
+//one measured operation
+typedef struct
+{
+  const char* name;
+  boolean     (*run)(sElf* elf, sBenchCtx* ctx);
+}sBenchOp;
+
+static boolean Bench_OpOpen(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpSections(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpSymbols(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpSearch(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpExportC(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpExportS19(sElf* elf, sBenchCtx* ctx);
+static boolean Bench_OpSrcList(sElf* elf, sBenchCtx* ctx);
+static int     Bench_MuteStdout(void);
+static void    Bench_RestoreStdout(int saved);
+
+static const sBenchOp BenchOps[] = {
+                                     {"open"   , Bench_OpOpen     },
+                                     {"sec"    , Bench_OpSections },
+                                     {"sym"    , Bench_OpSymbols  },
+                                     {"search" , Bench_OpSearch   },
+                                     {"c"      , Bench_OpExportC  },
+                                     {"s19"    , Bench_OpExportS19},
+                                     {"srclist", Bench_OpSrcList  }
+                                   };
+
+#define BENCH_OPS_SIZE  ((sizeof(BenchOps))/(sizeof(sBenchOp)))
+
+/*******************************************************************************************************************
+** Function:    Bench_Run
+** Description: time every operation on the opened image and append the results to the report. The output of the
+**              operations is discarded (null device), the summary is printed on stderr.
+** Parameter:   sElf* elf, const char* path, const char* report
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Bench_Run(sElf* elf, const char* path, const char* report)
+{
+  sBenchCtx    ctx;
+  sElfSection* sections = NULL;
+  sElfSymbol*  symbols  = NULL;
+  uint32       SecNbr   = 0;
+  uint32       SymNbr   = 0;
+  FILE*        file     = fopen(report, "a");
+  int          saved    = -1;
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Cannot open the file %s !\n\r", report);
+    return(FALSE);
+  }
+
+  memset(&ctx, 0, sizeof(ctx));
+  snprintf(ctx.CPath,   sizeof(ctx.CPath),   "%s.c",   report);
+  snprintf(ctx.S19Path, sizeof(ctx.S19Path), "%s.s19", report);
+
+  Elf_GetSections(elf, &sections, &SecNbr);
+
+  if(Elf_GetSymbols(elf, &symbols, &SymNbr))
+  {
+    for(uint32 i = SymNbr; i > 0 && ctx.Symbol[0] == '\0'; i--)
+    {
+      if(symbols[i - 1].name != NULL && strlen(symbols[i - 1].name) < sizeof(ctx.Symbol))
+      {
+        strcpy(ctx.Symbol, symbols[i - 1].name);
+      }
+    }
+  }
+
+  fseek(file, 0, SEEK_END);
+  if(ftell(file) == 0)
+  {
+    fprintf(file, BENCH_REPORT_HEADER);
+  }
+
+  fprintf(stderr, "\n BENCH %s : %u bytes, %u sections, %u symbols\n", path, elf->size, SecNbr, SymNbr);
+  fprintf(stderr, " %-10s%8s%14s%14s%12s%14s\n", "operation", "runs", "best ms", "mean ms", "MB/s", "peak RSS kB");
+
+  saved = Bench_MuteStdout();
+
+  for(uint32 op = 0; op < BENCH_OPS_SIZE; op++)
+  {
+    uint32  runs  = 0;
+    double  total = 0.0;
+    double  best  = 0.0;
+    boolean ok    = TRUE;
+
+    Stats_ResetPeak();
+
+    while(ok && (runs < BENCH_MIN_RUNS || (total < BENCH_MIN_TIME && runs < BENCH_MAX_RUNS)))
+    {
+      double start = Stats_Now();
+      double time  = 0.0;
+
+      ok = BenchOps[op].run(elf, &ctx);
+      fflush(stdout);
+      time = Stats_Now() - start;
+
+      if(runs == 0 || time < best)
+      {
+        best = time;
+      }
+      total += time;
+      runs++;
+    }
+
+    if(ok)
+    {
+      double mean = total / (double)runs;
+      double rate = (best > 0.0) ? ((double)elf->size / best / 1e6) : 0.0;
+      uint64 peak = Stats_PeakRss();
+
+      fprintf(file, "%s,%u,%u,%u,%s,%u,%.3f,%.3f,%.1f,%llu\n", path, elf->size, SecNbr, SymNbr, BenchOps[op].name,
+              runs, best * 1e3, mean * 1e3, rate, (unsigned long long)peak);
+      fprintf(stderr, " %-10s%8u%14.3f%14.3f%12.1f%14llu\n", BenchOps[op].name, runs, best * 1e3, mean * 1e3, rate,
+              (unsigned long long)peak);
+    }
+    else
+    {
+      fprintf(stderr, " %-10s%8s\n", BenchOps[op].name, "n/a");
+    }
+  }
+
+  Bench_RestoreStdout(saved);
+
+  remove(ctx.CPath);
+  remove(ctx.S19Path);
+
+  return((boolean)(0 == fclose(file)));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpOpen
+** Description: open (and close) a second context on the image: identification, class selection and, for a big
+**              endian file, the host order conversion of the tables
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpOpen(sElf* elf, sBenchCtx* ctx)
+{
+  sElf    copy;
+  boolean result = Elf_Open(&copy, elf->Buffer, elf->size);
+
+  (void)ctx;
+  Elf_Close(&copy);
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpSections
+** Description: -sec
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpSections(sElf* elf, sBenchCtx* ctx)
+{
+  (void)ctx;
+  return(Elf_SectionHeaderTable(elf));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpSymbols
+** Description: -sym
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpSymbols(sElf* elf, sBenchCtx* ctx)
+{
+  (void)ctx;
+  return(Elf_SymbolTable(elf));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpSearch
+** Description: -search <last symbol>
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpSearch(sElf* elf, sBenchCtx* ctx)
+{
+  return((boolean)(ctx->Symbol[0] != '\0' && Elf_SearchInfo(elf, ctx->Symbol)));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpExportC
+** Description: -c
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpExportC(sElf* elf, sBenchCtx* ctx)
+{
+  return(Elf_ExtractBinaryToC(elf, ctx->CPath));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpExportS19
+** Description: -s19
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpExportS19(sElf* elf, sBenchCtx* ctx)
+{
+  return(Elf_ExtractBinaryToS19(elf, ctx->S19Path));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_OpSrcList
+** Description: -srclist
+** Parameter:   sElf* elf, sBenchCtx* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_OpSrcList(sElf* elf, sBenchCtx* ctx)
+{
+  (void)ctx;
+  return(Elf_ListSrcFiles(elf));
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_MuteStdout
+** Description: send stdout to the null device
+** Parameter:   void
+** Return:      int (saved stdout descriptor, -1 if stdout is left as is)
+*******************************************************************************************************************/
+static int Bench_MuteStdout(void)
+{
+  FILE* sink  = fopen(BENCH_NULL_DEVICE, "w");
+  int   saved = -1;
+
+  fflush(stdout);
+
+  if(sink != NULL)
+  {
+    saved = BENCH_DUP(BENCH_FILENO(stdout));
+
+    if(saved >= 0 && BENCH_DUP2(BENCH_FILENO(sink), BENCH_FILENO(stdout)) < 0)
+    {
+      BENCH_CLOSE(saved);
+      saved = -1;
+    }
+    fclose(sink);
+  }
+  return(saved);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_RestoreStdout
+** Description: restore stdout after Bench_MuteStdout
+** Parameter:   int saved
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_RestoreStdout(int saved)
+{
+  fflush(stdout);
+
+  if(saved >= 0)
+  {
+    BENCH_DUP2(saved, BENCH_FILENO(stdout));
+    BENCH_CLOSE(saved);
+  }
+}
@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define BENCH_MIN_RUNS       3U        //timed runs of each operation
+#define BENCH_MAX_RUNS       50U
+#define BENCH_MIN_TIME       0.5       //seconds: more runs are made until this time is spent
+#define BENCH_MAX_SECTIONS   0xFE00U   //no extended section numbering
+#define BENCH_MAX_UNITS      9999U
+#define BENCH_MAX_FILES      127U      //file index of a line program stays a 1 byte uleb128
+#define BENCH_MAX_NAME_LEN   1024U
+#define BENCH_MIN_NAME_LEN   9U        //"s" + 8 hex digits: symbol names stay unique
+
+//content of a synthetic ELF file (-gen)
+typedef struct
+{
+  uint32 eclass;                       //ELFCLASS32 / ELFCLASS64
+  uint32 edata;                        //ELFDATA2LSB / ELFDATA2MSB
+  uint32 sections;                     //PROGBITS sections (.text/.rodata/.data in turn)
+  uint32 payload;                      //bytes of each PROGBITS section
+  uint32 symbols;                      //global symbols spread over the PROGBITS sections
+  uint32 NameLen;                      //length of each symbol name
+  uint32 units;                        //DWARF line programs in .debug_line (0: no debug info)
+  uint32 files;                        //source files of each line program
+  uint32 rows;                         //line table rows of each line program
+  uint32 seed;                         //payload pseudo random seed
+}sBenchGenSpec;
+
+boolean Bench_ParseSpec(sBenchGenSpec* spec, const char* text);
+boolean Bench_Generate(const char* path, const char* text);
+boolean Bench_Run(sElf* elf, const char* path, const char* report);
+
+#endif
@@ -0,0 +1,739 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Synthetic ELF generator (-gen).
+**
+** Writes a valid executable ELF file of any class and data encoding with a configurable number of PROGBITS sections,
+** global symbols and DWARF (version 2) line programs, so the parser can be measured on images of any size without
+** using a real (confidential) build. The file is streamed, the memory use does not depend on the symbol count.
+**
+** Layout:  ELF header | PROGBITS sections | .debug_line | .symtab | .strtab | .shstrtab | section header table
+** (plus one .bss NOBITS section without file content)
+*******************************************************************************************************************/
+
+#include<Bench.h>
+
+#define BENCH_GEN_BUF         (1U << 16)
+#define BENCH_GEN_BASE_ADDR   0x00010000ULL
+#define BENCH_GEN_MAX_SIZE    0xFFFFFFF0ULL      //LoadInputFile sizes are 32 bit
+#define BENCH_GEN_SHN_ABS     0xFFF1U
+#define BENCH_GEN_PATH_LEN    31U                //strlen("C:/work/gen/unit0000/file0000.c")
+
+//DWARF 2 line program header constants
+#define BENCH_DW_VERSION      2U
+#define BENCH_DW_MIN_INST     2U
+#define BENCH_DW_LINE_BASE    (-5)
+#define BENCH_DW_LINE_RANGE   14U
+#define BENCH_DW_OPCODE_BASE  10U
+#define BENCH_DW_SET_FILE     4U
+#define BENCH_DW_SET_ADDRESS  2U
+#define BENCH_DW_END_SEQUENCE 1U
+#define BENCH_DW_FILE_ROWS    16U                //rows between two file changes
+
+//buffered writer in the byte order and class of the generated file
+typedef struct
+{
+  FILE*   file;
+  uint64  offset;                    //file offset of the next byte
+  uint32  used;
+  boolean msb;
+  boolean wide;                      //64 bit class
+  boolean error;
+  uint8   buf[BENCH_GEN_BUF];
+}sBenchWriter;
+
+//section header of the generated file (written last)
+typedef struct
+{
+  uint32 name;
+  uint32 type;
+  uint64 flags;
+  uint64 addr;
+  uint64 offset;
+  uint64 size;
+  uint32 link;
+  uint32 info;
+  uint64 align;
+  uint64 entsize;
+}sBenchSection;
+
+static void    Bench_Flush(sBenchWriter* w);
+static void    Bench_Put(sBenchWriter* w, const void* data, uint32 size);
+static void    Bench_PutInt(sBenchWriter* w, uint64 value, uint32 bytes);
+static void    Bench_PutAddr(sBenchWriter* w, uint64 value);
+static void    Bench_Align(sBenchWriter* w, uint32 align);
+static boolean Bench_ParseValue(const char* text, uint32* value);
+static uint64  Bench_EstimateSize(const sBenchGenSpec* spec);
+static void    Bench_WritePayload(sBenchWriter* w, uint32 size, uint32* state);
+static void    Bench_WriteDebugLine(sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections);
+static void    Bench_WriteSymbols(sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections);
+static void    Bench_WriteStrings(sBenchWriter* w, const sBenchGenSpec* spec);
+static void    Bench_SymbolName(uint32 index, uint32 NameLen, char* name);
+static void    Bench_WriteSectionHeader(sBenchWriter* w, const sBenchSection* section);
+static void    Bench_WriteElfHeader(sBenchWriter* w, uint64 entry, uint64 shoff, uint32 shnum, uint32 shstrndx);
+
+/*******************************************************************************************************************
+** Function:    Bench_ParseSpec
+** Description: read the generator parameters "<key>=<value>[,<key>=<value>...]". Keys: class (32|64),
+**              data (lsb|msb), sections, payload, symbols, name, units, files, rows, seed. Numbers accept the
+**              k/M/G suffixes (x1000). Missing keys keep their default.
+** Parameter:   sBenchGenSpec* spec, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Bench_ParseSpec(sBenchGenSpec* spec, const char* text)
+{
+  char    copy[MAX_LINE_LEN];
+  char*   item    = NULL;
+  boolean result  = TRUE;
+
+  spec->eclass   = ELFCLASS32;
+  spec->edata    = ELFDATA2LSB;
+  spec->sections = 16;
+  spec->payload  = 4096;
+  spec->symbols  = 1000;
+  spec->NameLen  = 16;
+  spec->units    = 4;
+  spec->files    = 8;
+  spec->rows     = 256;
+  spec->seed     = 1;
+
+  if(text == NULL || strlen(text) >= sizeof(copy))
+  {
+    return(FALSE);
+  }
+  strcpy(copy, text);
+
+  for(item = strtok(copy, ","); item != NULL && result; item = strtok(NULL, ","))
+  {
+    char* value = strchr(item, '=');
+
+    if(value == NULL)
+    {
+      result = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    if(0 == strcmp(item, "class"))
+    {
+      spec->eclass = (0 == strcmp(value, "64")) ? ELFCLASS64 : ELFCLASS32;
+      result = (boolean)(0 == strcmp(value, "64") || 0 == strcmp(value, "32"));
+    }
+    else if(0 == strcmp(item, "data"))
+    {
+      spec->edata = (0 == strcmp(value, "msb")) ? ELFDATA2MSB : ELFDATA2LSB;
+      result = (boolean)(0 == strcmp(value, "msb") || 0 == strcmp(value, "lsb"));
+    }
+    else if(0 == strcmp(item, "sections")) { result = Bench_ParseValue(value, &spec->sections); }
+    else if(0 == strcmp(item, "payload"))  { result = Bench_ParseValue(value, &spec->payload);  }
+    else if(0 == strcmp(item, "symbols"))  { result = Bench_ParseValue(value, &spec->symbols);  }
+    else if(0 == strcmp(item, "name"))     { result = Bench_ParseValue(value, &spec->NameLen);  }
+    else if(0 == strcmp(item, "units"))    { result = Bench_ParseValue(value, &spec->units);    }
+    else if(0 == strcmp(item, "files"))    { result = Bench_ParseValue(value, &spec->files);    }
+    else if(0 == strcmp(item, "rows"))     { result = Bench_ParseValue(value, &spec->rows);     }
+    else if(0 == strcmp(item, "seed"))     { result = Bench_ParseValue(value, &spec->seed);     }
+    else
+    {
+      result = FALSE;
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Invalid generator parameters (class=32|64,data=lsb|msb,sections=,payload=,symbols=,name=,units=,files=,rows=,seed=) !\n\r");
+    return(FALSE);
+  }
+
+  if(spec->sections > BENCH_MAX_SECTIONS || spec->units > BENCH_MAX_UNITS || spec->files == 0 ||
+     spec->files > BENCH_MAX_FILES || spec->NameLen < BENCH_MIN_NAME_LEN || spec->NameLen > BENCH_MAX_NAME_LEN)
+  {
+    printf("\n\r error: Generator parameter out of range (sections <= %u, units <= %u, files 1..%u, name %u..%u) !\n\r",
+           BENCH_MAX_SECTIONS, BENCH_MAX_UNITS, BENCH_MAX_FILES, BENCH_MIN_NAME_LEN, BENCH_MAX_NAME_LEN);
+    return(FALSE);
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_ParseValue
+** Description: read a decimal (or 0x hexadecimal) number with an optional k/M/G suffix
+** Parameter:   const char* text, uint32* value
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Bench_ParseValue(const char* text, uint32* value)
+{
+  char*  end    = NULL;
+  uint64 number = (uint64)strtoul(text, &end, 0);
+
+  if(end == text)
+  {
+    return(FALSE);
+  }
+
+  switch(*end)
+  {
+    case 'k': case 'K': number *= 1000ULL;       end++; break;
+    case 'm': case 'M': number *= 1000000ULL;    end++; break;
+    case 'g': case 'G': number *= 1000000000ULL; end++; break;
+    default: break;
+  }
+
+  if(*end != '\0' || number > 0xFFFFFFFFULL)
+  {
+    return(FALSE);
+  }
+
+  *value = (uint32)number;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_Generate
+** Description: write the synthetic ELF file described by text (see Bench_ParseSpec) to path
+** Parameter:   const char* path, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Bench_Generate(const char* path, const char* text)
+{
+  sBenchGenSpec  spec;
+  sBenchWriter*  w          = NULL;
+  sBenchSection* sections   = NULL;
+  char*          shstrtab   = NULL;
+  uint32         NamesSize  = 1;
+  uint32         SecNbr     = 0;
+  uint32         bss        = 0;
+  uint32         debug      = 0;
+  uint32         symtab     = 0;
+  uint32         strtab     = 0;
+  uint32         shstrndx   = 0;
+  uint32         state      = 0;
+  uint64         addr       = BENCH_GEN_BASE_ADDR;
+  uint64         shoff      = 0;
+  uint64         entry      = 0;
+  boolean        result     = FALSE;
+
+  if(!Bench_ParseSpec(&spec, text))
+  {
+    return(FALSE);
+  }
+
+  if(Bench_EstimateSize(&spec) > BENCH_GEN_MAX_SIZE ||
+     (spec.eclass == ELFCLASS32 && (uint64)spec.sections * (((uint64)spec.payload + 15ULL) & ~15ULL) > 0xF0000000ULL))
+  {
+    printf("\n\r error: The generated file would not fit in 4 GB !\n\r");
+    return(FALSE);
+  }
+
+  /* null, PROGBITS..., .bss, .debug_line, .symtab, .strtab, .shstrtab */
+  w        = (sBenchWriter*)calloc(1, sizeof(sBenchWriter));
+  sections = (sBenchSection*)calloc((size_t)spec.sections + 6U, sizeof(sBenchSection));
+  shstrtab = (char*)malloc(((size_t)spec.sections + 6U) * 24U);
+
+  if(w == NULL || sections == NULL || shstrtab == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    free(shstrtab);
+    free(sections);
+    free(w);
+    return(FALSE);
+  }
+
+  w->file  = fopen(path, "wb");
+  w->msb   = (boolean)(spec.edata == ELFDATA2MSB);
+  w->wide  = (boolean)(spec.eclass == ELFCLASS64);
+  shstrtab[0] = '\0';
+
+  if(w->file == NULL)
+  {
+    printf("\n\r error: Cannot create the file %s !\n\r", path);
+    free(shstrtab);
+    free(sections);
+    free(w);
+    return(FALSE);
+  }
+
+  /* the ELF header is rewritten last, once the section header table offset is known */
+  Bench_WriteElfHeader(w, 0, 0, 0, 0);
+
+  /* PROGBITS sections: .text / .rodata / .data in turn */
+  state = (spec.seed != 0) ? spec.seed : 1;
+  for(uint32 i = 0; i < spec.sections; i++)
+  {
+    static const char* const kind[3]  = {".text", ".rodata", ".data"};
+    static const uint64      flags[3] = {SHF_ALLOC | SHF_EXECU, SHF_ALLOC, SHF_ALLOC | SHF_WRITE};
+    sBenchSection*           section  = &sections[++SecNbr];
+
+    Bench_Align(w, 16U);
+    section->name   = NamesSize;
+    section->type   = SHT_PROGBITS;
+    section->flags  = flags[i % 3U];
+    section->addr   = addr;
+    section->offset = w->offset;
+    section->size   = spec.payload;
+    section->align  = 16U;
+    NamesSize += (uint32)sprintf(&shstrtab[NamesSize], "%s.%u", kind[i % 3U], i) + 1U;
+
+    Bench_WritePayload(w, spec.payload, &state);
+    addr = (addr + spec.payload + 15ULL) & ~15ULL;
+  }
+  entry = (spec.sections > 0) ? sections[1].addr : 0;
+
+  /* .bss (no file content) */
+  bss = ++SecNbr;
+  sections[bss].name   = NamesSize;
+  sections[bss].type   = SHT_NOBITS;
+  sections[bss].flags  = SHF_ALLOC | SHF_WRITE;
+  sections[bss].addr   = addr;
+  sections[bss].offset = w->offset;
+  sections[bss].size   = spec.payload;
+  sections[bss].align  = 16U;
+  NamesSize += (uint32)sprintf(&shstrtab[NamesSize], ".bss") + 1U;
+
+  /* .debug_line */
+  if(spec.units > 0)
+  {
+    debug = ++SecNbr;
+    sections[debug].name   = NamesSize;
+    sections[debug].type   = SHT_PROGBITS;
+    sections[debug].offset = w->offset;
+    sections[debug].align  = 1U;
+    NamesSize += (uint32)sprintf(&shstrtab[NamesSize], ".debug_line") + 1U;
+
+    Bench_WriteDebugLine(w, &spec, sections);
+    sections[debug].size = w->offset - sections[debug].offset;
+  }
+
+  /* .symtab and .strtab */
+  symtab = ++SecNbr;
+  strtab = ++SecNbr;
+
+  Bench_Align(w, w->wide ? 8U : 4U);
+  sections[symtab].name    = NamesSize;
+  sections[symtab].type    = SHT_SYMTAB;
+  sections[symtab].offset  = w->offset;
+  sections[symtab].link    = strtab;
+  sections[symtab].info    = 1U;
+  sections[symtab].align   = w->wide ? 8U : 4U;
+  sections[symtab].entsize = w->wide ? 24U : 16U;
+  NamesSize += (uint32)sprintf(&shstrtab[NamesSize], ".symtab") + 1U;
+
+  Bench_WriteSymbols(w, &spec, sections);
+  sections[symtab].size = w->offset - sections[symtab].offset;
+
+  sections[strtab].name   = NamesSize;
+  sections[strtab].type   = SHT_STRTAB;
+  sections[strtab].offset = w->offset;
+  sections[strtab].align  = 1U;
+  NamesSize += (uint32)sprintf(&shstrtab[NamesSize], ".strtab") + 1U;
+
+  Bench_WriteStrings(w, &spec);
+  sections[strtab].size = w->offset - sections[strtab].offset;
+
+  /* .shstrtab */
+  shstrndx = ++SecNbr;
+  sections[shstrndx].name   = NamesSize;
+  sections[shstrndx].type   = SHT_STRTAB;
+  sections[shstrndx].offset = w->offset;
+  sections[shstrndx].align  = 1U;
+  NamesSize += (uint32)sprintf(&shstrtab[NamesSize], ".shstrtab") + 1U;
+  sections[shstrndx].size   = NamesSize;
+
+  Bench_Put(w, shstrtab, NamesSize);
+
+  /* section header table */
+  Bench_Align(w, 8U);
+  shoff = w->offset;
+  for(uint32 i = 0; i <= SecNbr; i++)
+  {
+    Bench_WriteSectionHeader(w, &sections[i]);
+  }
+  Bench_Flush(w);
+
+  /* ELF header */
+  if(!w->error && 0 == fseek(w->file, 0, SEEK_SET))
+  {
+    uint64 size = w->offset;
+
+    w->offset = 0;
+    Bench_WriteElfHeader(w, entry, shoff, SecNbr + 1U, shstrndx);
+    Bench_Flush(w);
+
+    if(!w->error)
+    {
+      printf("\n Generated %s : %llu bytes, %u sections, %u symbols, %u line programs\n", path,
+             (unsigned long long)size, SecNbr + 1U, spec.symbols, spec.units);
+      result = TRUE;
+    }
+  }
+
+  if(fclose(w->file) != 0 || !result)
+  {
+    printf("\n\r error: Cannot write the file %s !\n\r", path);
+    result = FALSE;
+  }
+
+  free(shstrtab);
+  free(sections);
+  free(w);
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_EstimateSize
+** Description: upper bound of the generated file size
+** Parameter:   const sBenchGenSpec* spec
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Bench_EstimateSize(const sBenchGenSpec* spec)
+{
+  uint64 AddrSize = (spec->eclass == ELFCLASS64) ? 8ULL : 4ULL;
+  uint64 unit     = 64ULL + ((uint64)spec->files * (BENCH_GEN_PATH_LEN + 4ULL)) + (3ULL * spec->rows) + AddrSize;
+  uint64 size     = 0;
+
+  size += (uint64)spec->sections * (((uint64)spec->payload + 15ULL) + 24ULL + (AddrSize * 10ULL));
+  size += (uint64)spec->units * unit;
+  size += ((uint64)spec->symbols + 1ULL) * ((AddrSize * 2ULL + 8ULL) + spec->NameLen + 1ULL);
+  size += 4096ULL;
+
+  return(size);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WritePayload
+** Description: write size pseudo random bytes (xorshift32)
+** Parameter:   sBenchWriter* w, uint32 size, uint32* state
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WritePayload(sBenchWriter* w, uint32 size, uint32* state)
+{
+  uint8  block[256];
+  uint32 x = *state;
+
+  while(size > 0)
+  {
+    uint32 len = (size < sizeof(block)) ? size : (uint32)sizeof(block);
+
+    for(uint32 i = 0; i < len; i++)
+    {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      block[i] = (uint8)x;
+    }
+    Bench_Put(w, block, len);
+    size -= len;
+  }
+
+  *state = x;
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WriteDebugLine
+** Description: write one DWARF 2 line program per unit. The file names are absolute Windows paths (as listed by
+**              -srclist), the rows advance the line by 1 and the address by one instruction.
+** Parameter:   sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WriteDebugLine(sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections)
+{
+  static const uint8 OpcodeLengths[BENCH_DW_OPCODE_BASE - 1U] = {0, 1, 1, 1, 1, 0, 0, 0, 1};
+  uint32 AddrSize  = w->wide ? 8U : 4U;
+  uint32 HeaderLen = 5U + (BENCH_DW_OPCODE_BASE - 1U) + 1U + (spec->files * (BENCH_GEN_PATH_LEN + 4U)) + 1U;
+  uint32 FileOps   = (spec->files > 1U) ? ((spec->rows + BENCH_DW_FILE_ROWS - 1U) / BENCH_DW_FILE_ROWS) : 0U;
+  uint32 ProgLen   = (3U + AddrSize) + spec->rows + (FileOps * 2U) + 3U;
+  uint8  special   = (uint8)((1 - BENCH_DW_LINE_BASE) + (int)BENCH_DW_LINE_RANGE + (int)BENCH_DW_OPCODE_BASE);
+  char   path[64];
+
+  for(uint32 u = 0; u < spec->units; u++)
+  {
+    uint64 addr = (spec->sections > 0) ? sections[1U + (u % spec->sections)].addr : 0;
+
+    /* header */
+    Bench_PutInt(w, 2U + 4U + HeaderLen + ProgLen, 4U);
+    Bench_PutInt(w, BENCH_DW_VERSION, 2U);
+    Bench_PutInt(w, HeaderLen, 4U);
+    Bench_PutInt(w, BENCH_DW_MIN_INST, 1U);
+    Bench_PutInt(w, 1U, 1U);
+    Bench_PutInt(w, (uint8)BENCH_DW_LINE_BASE, 1U);
+    Bench_PutInt(w, BENCH_DW_LINE_RANGE, 1U);
+    Bench_PutInt(w, BENCH_DW_OPCODE_BASE, 1U);
+    Bench_Put(w, OpcodeLengths, sizeof(OpcodeLengths));
+    Bench_PutInt(w, 0U, 1U);                               //no include directory
+
+    for(uint32 f = 0; f < spec->files; f++)
+    {
+      snprintf(path, sizeof(path), "C:/work/gen/unit%04u/file%04u.%c", u, f, (f == 0) ? 'c' : 'h');
+      Bench_Put(w, path, BENCH_GEN_PATH_LEN + 1U);
+      Bench_PutInt(w, 0U, 3U);                             //directory, time, length
+    }
+    Bench_PutInt(w, 0U, 1U);
+
+    /* program */
+    Bench_PutInt(w, 0U, 1U);
+    Bench_PutInt(w, 1U + AddrSize, 1U);
+    Bench_PutInt(w, BENCH_DW_SET_ADDRESS, 1U);
+    Bench_PutAddr(w, addr);
+
+    for(uint32 r = 0; r < spec->rows; r++)
+    {
+      if(FileOps > 0 && (r % BENCH_DW_FILE_ROWS) == 0)
+      {
+        Bench_PutInt(w, BENCH_DW_SET_FILE, 1U);
+        Bench_PutInt(w, 1U + ((r / BENCH_DW_FILE_ROWS) % spec->files), 1U);
+      }
+      Bench_PutInt(w, special, 1U);
+    }
+
+    Bench_PutInt(w, 0U, 1U);
+    Bench_PutInt(w, 1U, 1U);
+    Bench_PutInt(w, BENCH_DW_END_SEQUENCE, 1U);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WriteSymbols
+** Description: write the symbol table: the null symbol then the global symbols, spread in turn over the PROGBITS
+**              sections (functions in .text, objects elsewhere)
+** Parameter:   sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WriteSymbols(sBenchWriter* w, const sBenchGenSpec* spec, const sBenchSection* sections)
+{
+  uint32 SymSize = (spec->payload >= 4U) ? 4U : 0U;
+  uint32 slots   = (spec->payload >= 4U) ? (spec->payload / 4U) : 1U;
+
+  for(uint32 k = 0; k <= spec->symbols; k++)
+  {
+    uint32 name  = 0;
+    uint64 value = 0;
+    uint64 size  = 0;
+    uint8  info  = 0;
+    uint32 shndx = 0;
+
+    if(k > 0)
+    {
+      name = 1U + ((k - 1U) * (spec->NameLen + 1U));
+      size = SymSize;
+
+      if(spec->sections > 0)
+      {
+        uint32 sec = (k - 1U) % spec->sections;
+
+        shndx = 1U + sec;
+        value = sections[shndx].addr + (((uint64)((k - 1U) / spec->sections) % slots) * 4ULL);
+        info  = (uint8)((STB_GLOBAL << 4) | (((sec % 3U) == 0) ? STT_FUNC : STT_OBJECT));
+      }
+      else
+      {
+        shndx = BENCH_GEN_SHN_ABS;
+        value = (uint64)k * 4ULL;
+        info  = (uint8)((STB_GLOBAL << 4) | STT_OBJECT);
+      }
+    }
+
+    Bench_PutInt(w, name, 4U);
+    if(w->wide)
+    {
+      Bench_PutInt(w, info, 1U);
+      Bench_PutInt(w, 0U, 1U);
+      Bench_PutInt(w, shndx, 2U);
+      Bench_PutInt(w, value, 8U);
+      Bench_PutInt(w, size, 8U);
+    }
+    else
+    {
+      Bench_PutInt(w, value, 4U);
+      Bench_PutInt(w, size, 4U);
+      Bench_PutInt(w, info, 1U);
+      Bench_PutInt(w, 0U, 1U);
+      Bench_PutInt(w, shndx, 2U);
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WriteStrings
+** Description: write the symbol string table (names of NameLen characters, in symbol order)
+** Parameter:   sBenchWriter* w, const sBenchGenSpec* spec
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WriteStrings(sBenchWriter* w, const sBenchGenSpec* spec)
+{
+  char name[BENCH_MAX_NAME_LEN + 1U];
+
+  Bench_PutInt(w, 0U, 1U);
+
+  for(uint32 k = 1; k <= spec->symbols; k++)
+  {
+    Bench_SymbolName(k, spec->NameLen, name);
+    Bench_Put(w, name, spec->NameLen + 1U);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_SymbolName
+** Description: unique name of the symbol index: "s<index in hex>" padded with deterministic letters
+** Parameter:   uint32 index, uint32 NameLen, char* name (NameLen + 1 bytes)
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_SymbolName(uint32 index, uint32 NameLen, char* name)
+{
+  static const char letters[] = "abcdefghijklmnopqrstuvwxyz_";
+
+  sprintf(name, "s%08x", index);
+
+  for(uint32 i = BENCH_MIN_NAME_LEN; i < NameLen; i++)
+  {
+    name[i] = letters[((index * 7U) + i) % (sizeof(letters) - 1U)];
+  }
+  name[NameLen] = '\0';
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WriteSectionHeader
+** Description: write one section header entry
+** Parameter:   sBenchWriter* w, const sBenchSection* section
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WriteSectionHeader(sBenchWriter* w, const sBenchSection* section)
+{
+  Bench_PutInt(w, section->name, 4U);
+  Bench_PutInt(w, section->type, 4U);
+  Bench_PutAddr(w, section->flags);
+  Bench_PutAddr(w, section->addr);
+  Bench_PutAddr(w, section->offset);
+  Bench_PutAddr(w, section->size);
+  Bench_PutInt(w, section->link, 4U);
+  Bench_PutInt(w, section->info, 4U);
+  Bench_PutAddr(w, section->align);
+  Bench_PutAddr(w, section->entsize);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_WriteElfHeader
+** Description: write the ELF header of an executable without program header table
+** Parameter:   sBenchWriter* w, uint64 entry, uint64 shoff, uint32 shnum, uint32 shstrndx
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_WriteElfHeader(sBenchWriter* w, uint64 entry, uint64 shoff, uint32 shnum, uint32 shstrndx)
+{
+  uint8 ident[EI_NIDENT] = {0x7F, 'E', 'L', 'F'};
+
+  ident[4]       = (uint8)(w->wide ? ELFCLASS64 : ELFCLASS32);
+  ident[EI_DATA] = (uint8)(w->msb ? ELFDATA2MSB : ELFDATA2LSB);
+  ident[6]       = 1U;
+
+  Bench_Put(w, ident, EI_NIDENT);
+  Bench_PutInt(w, ET_EXEC, 2U);
+  Bench_PutInt(w, w->wide ? EM_PPC64 : (w->msb ? EM_PPC : EM_ARM), 2U);
+  Bench_PutInt(w, 1U, 4U);
+  Bench_PutAddr(w, entry);
+  Bench_PutAddr(w, 0U);
+  Bench_PutAddr(w, shoff);
+  Bench_PutInt(w, 0U, 4U);
+  Bench_PutInt(w, w->wide ? 64U : 52U, 2U);
+  Bench_PutInt(w, 0U, 2U);
+  Bench_PutInt(w, 0U, 2U);
+  Bench_PutInt(w, w->wide ? 64U : 40U, 2U);
+  Bench_PutInt(w, shnum, 2U);
+  Bench_PutInt(w, shstrndx, 2U);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_Flush
+** Description: write the buffered bytes to the file
+** Parameter:   sBenchWriter* w
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_Flush(sBenchWriter* w)
+{
+  if(w->used > 0 && fwrite(w->buf, 1, w->used, w->file) != w->used)
+  {
+    w->error = TRUE;
+  }
+  w->used = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_Put
+** Description: append raw bytes
+** Parameter:   sBenchWriter* w, const void* data, uint32 size
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_Put(sBenchWriter* w, const void* data, uint32 size)
+{
+  const uint8* src = (const uint8*)data;
+
+  w->offset += size;
+
+  while(size > 0)
+  {
+    uint32 len = BENCH_GEN_BUF - w->used;
+
+    if(len > size)
+    {
+      len = size;
+    }
+    memcpy(&w->buf[w->used], src, len);
+    w->used += len;
+    src     += len;
+    size    -= len;
+
+    if(w->used == BENCH_GEN_BUF)
+    {
+      Bench_Flush(w);
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_PutInt
+** Description: append an integer of 1 to 8 bytes in the byte order of the file
+** Parameter:   sBenchWriter* w, uint64 value, uint32 bytes
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_PutInt(sBenchWriter* w, uint64 value, uint32 bytes)
+{
+  uint8 data[8];
+
+  for(uint32 i = 0; i < bytes; i++)
+  {
+    uint32 shift = w->msb ? ((bytes - 1U - i) * 8U) : (i * 8U);
+    data[i] = (uint8)(value >> shift);
+  }
+  Bench_Put(w, data, bytes);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_PutAddr
+** Description: append an address/offset/size field of the file class (4 or 8 bytes)
+** Parameter:   sBenchWriter* w, uint64 value
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_PutAddr(sBenchWriter* w, uint64 value)
+{
+  Bench_PutInt(w, value, w->wide ? 8U : 4U);
+}
+
+/*******************************************************************************************************************
+** Function:    Bench_Align
+** Description: pad with zero bytes up to the next multiple of align
+** Parameter:   sBenchWriter* w, uint32 align
+** Return:      void
+*******************************************************************************************************************/
+static void Bench_Align(sBenchWriter* w, uint32 align)
+{
+  static const uint8 zeros[64] = {0};
+
+  while((w->offset % align) != 0)
+  {
+    uint32 len = align - (uint32)(w->offset % align);
+    Bench_Put(w, zeros, (len < sizeof(zeros)) ? len : (uint32)sizeof(zeros));
+  }
+}
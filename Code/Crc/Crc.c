@@ -0,0 +1,472 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Generic CRC engine (any width up to 64 bits).
+**
+** A CRC of width w with polynomial P is handled as a 64 bit CRC with modulus G = P.x^(64-w): the register is kept
+** left aligned in 64 bits (refin = FALSE) or bit reflected in the low bits (refin = TRUE), so one engine serves all
+** the models. Short inputs run the slicing-by-8 tables, long inputs are folded 64 bytes per iteration with the
+** carry-less multiply (PCLMULQDQ) down to 16 bytes which are finished with the tables.
+*******************************************************************************************************************/
+
+#include<Crc.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  #define CRC_CLMUL
+  #include<wmmintrin.h>
+  #include<tmmintrin.h>
+  #if defined(_MSC_VER)
+    #include<intrin.h>
+    #define CRC_TARGET_CLMUL
+  #else
+    #include<cpuid.h>
+    #define CRC_TARGET_CLMUL  __attribute__((target("pclmul,ssse3")))
+  #endif
+#endif
+
+#define CRC_CLMUL_MIN  128U      //shortest input given to the carry-less multiply kernel
+
+//catalogue of the usual models
+typedef struct
+{
+  sCrcParam param;
+  uint64    check;                     //CRC of the ASCII string "123456789"
+}sCrcModel;
+
+static const sCrcModel CrcModels[] =
+{
+  {{"crc8"             ,  8, 0x07ULL              , 0x00ULL              , FALSE, FALSE, 0x00ULL              }, 0xF4ULL              },
+  {{"crc8-autosar"     ,  8, 0x2FULL              , 0xFFULL              , FALSE, FALSE, 0xFFULL              }, 0xDFULL              },
+  {{"crc16-arc"        , 16, 0x8005ULL            , 0x0000ULL            , TRUE , TRUE , 0x0000ULL            }, 0xBB3DULL            },
+  {{"crc16-ccitt-false", 16, 0x1021ULL            , 0xFFFFULL            , FALSE, FALSE, 0x0000ULL            }, 0x29B1ULL            },
+  {{"crc16-kermit"     , 16, 0x1021ULL            , 0x0000ULL            , TRUE , TRUE , 0x0000ULL            }, 0x2189ULL            },
+  {{"crc16-xmodem"     , 16, 0x1021ULL            , 0x0000ULL            , FALSE, FALSE, 0x0000ULL            }, 0x31C3ULL            },
+  {{"crc32"            , 32, 0x04C11DB7ULL        , 0xFFFFFFFFULL        , TRUE , TRUE , 0xFFFFFFFFULL        }, 0xCBF43926ULL        },
+  {{"crc32-autosar"    , 32, 0xF4ACFB13ULL        , 0xFFFFFFFFULL        , TRUE , TRUE , 0xFFFFFFFFULL        }, 0x1697D06AULL        },
+  {{"crc32-bzip2"      , 32, 0x04C11DB7ULL        , 0xFFFFFFFFULL        , FALSE, FALSE, 0xFFFFFFFFULL        }, 0xFC891918ULL        },
+  {{"crc32-mpeg2"      , 32, 0x04C11DB7ULL        , 0xFFFFFFFFULL        , FALSE, FALSE, 0x00000000ULL        }, 0x0376E6E7ULL        },
+  {{"crc32c"           , 32, 0x1EDC6F41ULL        , 0xFFFFFFFFULL        , TRUE , TRUE , 0xFFFFFFFFULL        }, 0xE3069283ULL        },
+  {{"crc64-ecma"       , 64, 0x42F0E1EBA9EA3693ULL, 0x0000000000000000ULL, FALSE, FALSE, 0x0000000000000000ULL}, 0x6C40DF5F0B497347ULL},
+  {{"crc64-xz"         , 64, 0x42F0E1EBA9EA3693ULL, 0xFFFFFFFFFFFFFFFFULL, TRUE , TRUE , 0xFFFFFFFFFFFFFFFFULL}, 0x995DC9BBDF1939FAULL},
+};
+
+static uint64  Crc_Mask(uint32 width);
+static uint64  Crc_Reflect(uint64 value, uint32 width);
+static uint64  Crc_XPowMod(uint64 g, uint32 n);
+static uint64  Crc_Load64Be(const uint8* p);
+static uint64  Crc_UpdateTable(const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size);
+static boolean Crc_ParseModel(sCrcParam* param, const char* spec);
+
+#if defined(CRC_CLMUL)
+static boolean Crc_HasClmul(void);
+static uint64  Crc_UpdateClmul(const sCrcEngine* engine, uint64* reg, const uint8* data, uint64 size);
+#endif
+
+/*******************************************************************************************************************
+** Function:    Crc_Mask
+** Description: mask of the width low bits
+** Parameter:   uint32 width
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Crc_Mask(uint32 width)
+{
+  return((width >= 64U) ? 0xFFFFFFFFFFFFFFFFULL : ((1ULL << width) - 1ULL));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Reflect
+** Description: mirror the width low bits of value
+** Parameter:   uint64 value, uint32 width
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Crc_Reflect(uint64 value, uint32 width)
+{
+  uint64 result = 0;
+
+  for(uint32 i = 0; i < width; i++)
+  {
+    result = (result << 1) | ((value >> i) & 1ULL);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_XPowMod
+** Description: x^n mod G (G = x^64 + g)
+** Parameter:   uint64 g, uint32 n
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Crc_XPowMod(uint64 g, uint32 n)
+{
+  uint64 r = 1;
+
+  while(n-- > 0)
+  {
+    uint64 carry = r >> 63;
+
+    r <<= 1;
+    if(carry != 0)
+    {
+      r ^= g;
+    }
+  }
+  return(r);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Load64Be
+** Description: read 8 bytes as a big endian value
+** Parameter:   const uint8* p
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Crc_Load64Be(const uint8* p)
+{
+  return(((uint64)p[0] << 56) | ((uint64)p[1] << 48) | ((uint64)p[2] << 40) | ((uint64)p[3] << 32) |
+         ((uint64)p[4] << 24) | ((uint64)p[5] << 16) | ((uint64)p[6] <<  8) |  (uint64)p[7]);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_ParseModel
+** Description: a model name of the catalogue or "width/poly/init/refin/refout/xorout" (hexadecimal values)
+** Parameter:   sCrcParam* param, const char* spec
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Crc_ParseModel(sCrcParam* param, const char* spec)
+{
+  unsigned int       width  = 0;
+  unsigned int       refin  = 0;
+  unsigned int       refout = 0;
+  unsigned long long poly   = 0;
+  unsigned long long init   = 0;
+  unsigned long long xorout = 0;
+
+  for(uint32 i = 0; i < sizeof(CrcModels) / sizeof(sCrcModel); i++)
+  {
+    if(0 == strcmp(CrcModels[i].param.name, spec))
+    {
+      *param = CrcModels[i].param;
+      return(TRUE);
+    }
+  }
+
+  if(6 != sscanf(spec, "%u/%llx/%llx/%u/%u/%llx", &width, &poly, &init, &refin, &refout, &xorout) ||
+     width == 0 || width > CRC_MAX_WIDTH || refin > 1 || refout > 1)
+  {
+    return(FALSE);
+  }
+
+  memset(param, 0, sizeof(sCrcParam));
+  strncpy(param->name, spec, CRC_NAME_LEN - 1);
+  param->width  = width;
+  param->poly   = (uint64)poly   & Crc_Mask(width);
+  param->init   = (uint64)init   & Crc_Mask(width);
+  param->xorout = (uint64)xorout & Crc_Mask(width);
+  param->refin  = (boolean)refin;
+  param->refout = (boolean)refout;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Init
+** Description: select the CRC model and build its tables and folding constants
+** Parameter:   sCrcEngine* engine, const char* spec (see Crc_ParseModel)
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Crc_Init(sCrcEngine* engine, const char* spec)
+{
+  uint64 g = 0;
+
+  memset(engine, 0, sizeof(sCrcEngine));
+
+  if(!Crc_ParseModel(&engine->param, spec))
+  {
+    return(FALSE);
+  }
+
+  g = engine->param.poly << (64U - engine->param.width);
+
+  for(uint32 b = 0; b < 256; b++)
+  {
+    uint64 c = 0;
+
+    if(engine->param.refin)
+    {
+      uint64 rg = Crc_Reflect(g, 64);
+
+      c = b;
+      for(uint32 k = 0; k < 8; k++)
+      {
+        c = ((c & 1ULL) != 0) ? ((c >> 1) ^ rg) : (c >> 1);
+      }
+    }
+    else
+    {
+      c = (uint64)b << 56;
+      for(uint32 k = 0; k < 8; k++)
+      {
+        c = ((c >> 63) != 0) ? ((c << 1) ^ g) : (c << 1);
+      }
+    }
+    engine->table[0][b] = c;
+  }
+
+  for(uint32 t = 1; t < 8; t++)
+  {
+    for(uint32 b = 0; b < 256; b++)
+    {
+      uint64 c = engine->table[t - 1][b];
+
+      engine->table[t][b] = engine->param.refin ? ((c >> 8) ^ engine->table[0][c & 0xFFU])
+                                                : ((c << 8) ^ engine->table[0][c >> 56]);
+    }
+  }
+
+  /* folding distances: 512 bits (4 lanes), then 384, 256 and 128 bits to merge the lanes */
+  for(uint32 i = 0; i < 4; i++)
+  {
+    uint32 distance = 512U - (128U * i);
+
+    if(engine->param.refin)
+    {
+      /* the reflected product comes out one bit short: use x^(n-1) */
+      engine->fold[i][0] = Crc_Reflect(Crc_XPowMod(g, distance + 63U), 64);
+      engine->fold[i][1] = Crc_Reflect(Crc_XPowMod(g, distance - 1U), 64);
+    }
+    else
+    {
+      engine->fold[i][0] = Crc_XPowMod(g, distance);
+      engine->fold[i][1] = Crc_XPowMod(g, distance + 64U);
+    }
+  }
+
+#if defined(CRC_CLMUL)
+  engine->clmul = Crc_HasClmul();
+#endif
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Start
+** Description: register value before the first byte
+** Parameter:   const sCrcEngine* engine
+** Return:      uint64
+*******************************************************************************************************************/
+uint64 Crc_Start(const sCrcEngine* engine)
+{
+  const sCrcParam* p = &engine->param;
+
+  return(p->refin ? Crc_Reflect(p->init, p->width) : (p->init << (64U - p->width)));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_UpdateTable
+** Description: slicing-by-8: 8 table lookups per 8 input bytes
+** Parameter:   const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size
+** Return:      uint64 (register)
+*******************************************************************************************************************/
+static uint64 Crc_UpdateTable(const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size)
+{
+  const uint64 (*t)[256] = engine->table;
+
+  if(engine->param.refin)
+  {
+    for(; size >= 8; size -= 8, data += 8)
+    {
+      uint64 x = 0;
+
+      memcpy(&x, data, 8);
+      x ^= reg;
+      reg = t[7][x & 0xFFU]         ^ t[6][(x >>  8) & 0xFFU] ^ t[5][(x >> 16) & 0xFFU] ^ t[4][(x >> 24) & 0xFFU] ^
+            t[3][(x >> 32) & 0xFFU] ^ t[2][(x >> 40) & 0xFFU] ^ t[1][(x >> 48) & 0xFFU] ^ t[0][x >> 56];
+    }
+    for(; size > 0; size--, data++)
+    {
+      reg = t[0][(reg ^ *data) & 0xFFU] ^ (reg >> 8);
+    }
+  }
+  else
+  {
+    for(; size >= 8; size -= 8, data += 8)
+    {
+      uint64 x = reg ^ Crc_Load64Be(data);
+
+      reg = t[7][x >> 56]           ^ t[6][(x >> 48) & 0xFFU] ^ t[5][(x >> 40) & 0xFFU] ^ t[4][(x >> 32) & 0xFFU] ^
+            t[3][(x >> 24) & 0xFFU] ^ t[2][(x >> 16) & 0xFFU] ^ t[1][(x >>  8) & 0xFFU] ^ t[0][x & 0xFFU];
+    }
+    for(; size > 0; size--, data++)
+    {
+      reg = t[0][(reg >> 56) ^ *data] ^ (reg << 8);
+    }
+  }
+  return(reg);
+}
+
+#if defined(CRC_CLMUL)
+
+/*******************************************************************************************************************
+** Function:    Crc_HasClmul
+** Description: check (once) if the CPU supports PCLMULQDQ and the SSSE3 byte shuffle
+** Parameter:   void
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Crc_HasClmul(void)
+{
+  static int supported = -1;
+
+  if(supported < 0)
+  {
+#if defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 1);
+    supported = ((info[2] & (1 << 1)) != 0 && (info[2] & (1 << 9)) != 0) ? 1 : 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    supported = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && ((ecx & (1U << 1)) != 0) && ((ecx & (1U << 9)) != 0)) ? 1 : 0;
+#endif
+  }
+  return((boolean)(supported == 1));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_UpdateClmul
+** Description: fold the input 64 bytes at a time in 4 lanes of 128 bits, merge the lanes, fold the remaining
+**              16 byte blocks and reduce the last block with the tables. size must be at least CRC_CLMUL_MIN.
+** Parameter:   const sCrcEngine* engine, uint64* reg, const uint8* data, uint64 size
+** Return:      uint64 (number of bytes processed, a multiple of 16)
+*******************************************************************************************************************/
+CRC_TARGET_CLMUL
+static uint64 Crc_UpdateClmul(const sCrcEngine* engine, uint64* reg, const uint8* data, uint64 size)
+{
+  const __m128i swap    = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const boolean natural = (boolean)!engine->param.refin;
+  __m128i       k[4];
+  __m128i       lane[4];
+  __m128i       v;
+  uint64        first[2] = {0, 0};
+  uint8         last[16];
+  uint64        done     = 0;
+
+  for(uint32 i = 0; i < 4; i++)
+  {
+    k[i]    = _mm_loadu_si128((const __m128i*)engine->fold[i]);
+    lane[i] = _mm_loadu_si128((const __m128i*)(data + (16 * i)));
+    lane[i] = natural ? _mm_shuffle_epi8(lane[i], swap) : lane[i];
+  }
+
+  /* the register goes over the first 8 bytes (the highest degree coefficients) */
+  first[natural ? 1 : 0] = *reg;
+  lane[0] = _mm_xor_si128(lane[0], _mm_loadu_si128((const __m128i*)first));
+
+  for(done = 64; size - done >= 64; done += 64)
+  {
+    for(uint32 i = 0; i < 4; i++)
+    {
+      __m128i next = _mm_loadu_si128((const __m128i*)(data + done + (16 * i)));
+
+      next    = natural ? _mm_shuffle_epi8(next, swap) : next;
+      lane[i] = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(lane[i], k[0], 0x00),
+                                            _mm_clmulepi64_si128(lane[i], k[0], 0x11)), next);
+    }
+  }
+
+  v = lane[3];
+  for(uint32 i = 0; i < 3; i++)
+  {
+    v = _mm_xor_si128(v, _mm_xor_si128(_mm_clmulepi64_si128(lane[i], k[i + 1], 0x00),
+                                       _mm_clmulepi64_si128(lane[i], k[i + 1], 0x11)));
+  }
+
+  for(; size - done >= 16; done += 16)
+  {
+    __m128i next = _mm_loadu_si128((const __m128i*)(data + done));
+
+    next = natural ? _mm_shuffle_epi8(next, swap) : next;
+    v    = _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(v, k[3], 0x00),
+                                       _mm_clmulepi64_si128(v, k[3], 0x11)), next);
+  }
+
+  v = natural ? _mm_shuffle_epi8(v, swap) : v;
+  _mm_storeu_si128((__m128i*)last, v);
+  *reg = Crc_UpdateTable(engine, 0, last, sizeof(last));
+  return(done);
+}
+
+#endif
+
+/*******************************************************************************************************************
+** Function:    Crc_Update
+** Description: feed the register with size bytes (may be called several times on consecutive pieces)
+** Parameter:   const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size
+** Return:      uint64 (register)
+*******************************************************************************************************************/
+uint64 Crc_Update(const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size)
+{
+#if defined(CRC_CLMUL)
+  if(engine->clmul && size >= CRC_CLMUL_MIN)
+  {
+    uint64 done = Crc_UpdateClmul(engine, &reg, data, size);
+
+    data += done;
+    size -= done;
+  }
+#endif
+
+  return(Crc_UpdateTable(engine, reg, data, size));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Final
+** Description: CRC value from the register (output reflection and final xor)
+** Parameter:   const sCrcEngine* engine, uint64 reg
+** Return:      uint64
+*******************************************************************************************************************/
+uint64 Crc_Final(const sCrcEngine* engine, uint64 reg)
+{
+  const sCrcParam* p     = &engine->param;
+  uint64           value = p->refin ? reg : (reg >> (64U - p->width));
+
+  if(p->refin != p->refout)
+  {
+    value = Crc_Reflect(value, p->width);
+  }
+  return((value ^ p->xorout) & Crc_Mask(p->width));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_Compute
+** Description: CRC of one buffer
+** Parameter:   const sCrcEngine* engine, const uint8* data, uint64 size
+** Return:      uint64
+*******************************************************************************************************************/
+uint64 Crc_Compute(const sCrcEngine* engine, const uint8* data, uint64 size)
+{
+  return(Crc_Final(engine, Crc_Update(engine, Crc_Start(engine), data, size)));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_PrintModels
+** Description: list the catalogue models
+** Parameter:   void
+** Return:      void
+*******************************************************************************************************************/
+void Crc_PrintModels(void)
+{
+  printf("\n\r %-18s %5s %-18s %-18s %-5s %-6s %-18s %s\n\r", "Model", "Width", "Poly", "Init", "RefIn", "RefOut",
+         "XorOut", "Check");
+
+  for(uint32 i = 0; i < sizeof(CrcModels) / sizeof(sCrcModel); i++)
+  {
+    const sCrcParam* p = &CrcModels[i].param;
+
+    printf(" %-18s %5u 0x%-16llx 0x%-16llx %-5u %-6u 0x%-16llx 0x%llx\n\r", p->name, (unsigned int)p->width,
+           (unsigned long long)p->poly, (unsigned long long)p->init, (unsigned int)p->refin,
+           (unsigned int)p->refout, (unsigned long long)p->xorout, (unsigned long long)CrcModels[i].check);
+  }
+  printf("\n\r or <width>/<poly>/<init>/<refin>/<refout>/<xorout> (hexadecimal)\n\r");
+}
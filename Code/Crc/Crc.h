@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __CRC_H__
+#define __CRC_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define CRC_MAX_WIDTH    64U
+#define CRC_NAME_LEN     32U
+#define CRC_MAX_RANGES   16U
+
+//CRC model (Rocksoft/Williams parameters)
+typedef struct
+{
+  char    name[CRC_NAME_LEN];
+  uint32  width;
+  uint64  poly;
+  uint64  init;
+  boolean refin;
+  boolean refout;
+  uint64  xorout;
+}sCrcParam;
+
+//precomputed tables of one CRC model
+typedef struct
+{
+  sCrcParam param;
+  uint64    table[8][256];             //slicing-by-8 tables
+  uint64    fold[4][2];                //carry-less multiply folding constants (512, 384, 256, 128 bits)
+  boolean   clmul;                     //PCLMULQDQ kernel available
+}sCrcEngine;
+
+boolean Crc_Init(sCrcEngine* engine, const char* spec);
+uint64  Crc_Start(const sCrcEngine* engine);
+uint64  Crc_Update(const sCrcEngine* engine, uint64 reg, const uint8* data, uint64 size);
+uint64  Crc_Final(const sCrcEngine* engine, uint64 reg);
+uint64  Crc_Compute(const sCrcEngine* engine, const uint8* data, uint64 size);
+void    Crc_PrintModels(void);
+
+boolean Crc_InsertInImage(sElf* elf, const char* request);
+
+#endif
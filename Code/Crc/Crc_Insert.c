@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Crc.h>
+#include<Elf.h>
+#include<Image.h>
+
+//address range of a CRC request (end included)
+typedef struct
+{
+  uint64 start;
+  uint64 end;
+}sCrcRange;
+
+//running CRC over the load image
+typedef struct
+{
+  const sCrcEngine* engine;
+  uint64            reg;
+}sCrcWalk;
+
+static boolean Crc_ParseRanges(char* list, sCrcRange* ranges, uint32* count);
+static void    Crc_WalkChunk(uint64 addr, const uint8* data, uint64 size, void* ctx);
+static boolean Crc_WriteSymbol(sElf* elf, const char* name, uint64 value, uint32 bytes, const sCrcRange* ranges,
+                               uint32 count);
+
+/*******************************************************************************************************************
+** Function:    Crc_ParseRanges
+** Description: parse "<start>-<end>[,<start>-<end>...]" (hexadecimal addresses, end included)
+** Parameter:   char* list, sCrcRange* ranges, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Crc_ParseRanges(char* list, sCrcRange* ranges, uint32* count)
+{
+  char* range = strtok(list, ",");
+
+  *count = 0;
+
+  while(range != NULL)
+  {
+    unsigned long long start = 0;
+    unsigned long long end   = 0;
+
+    if(*count == CRC_MAX_RANGES || 2 != sscanf(range, "%llx-%llx", &start, &end) || end < start)
+    {
+      return(FALSE);
+    }
+
+    ranges[*count].start = (uint64)start;
+    ranges[*count].end   = (uint64)end;
+    (*count)++;
+    range = strtok(NULL, ",");
+  }
+  return((boolean)(*count > 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_WalkChunk
+** Description: Image_WalkRange callback: feed the CRC register
+** Parameter:   uint64 addr, const uint8* data, uint64 size, void* ctx (sCrcWalk*)
+** Return:      void
+*******************************************************************************************************************/
+static void Crc_WalkChunk(uint64 addr, const uint8* data, uint64 size, void* ctx)
+{
+  sCrcWalk* walk = (sCrcWalk*)ctx;
+
+  (void)addr;
+  walk->reg = Crc_Update(walk->engine, walk->reg, data, size);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_WriteSymbol
+** Description: store the CRC value in the file content of the symbol, in the byte order of the target
+** Parameter:   sElf* elf, const char* name, uint64 value, uint32 bytes, const sCrcRange* ranges, uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Crc_WriteSymbol(sElf* elf, const char* name, uint64 value, uint32 bytes, const sCrcRange* ranges,
+                               uint32 count)
+{
+  sElfSymbol* symbols = NULL;
+  uint32      SymNbr  = 0;
+  sElfSymbol* target  = NULL;
+  boolean     msb     = Elf_IsBigEndian(elf);
+
+  if(!Elf_GetSymbols(elf, &symbols, &SymNbr))
+  {
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < SymNbr && target == NULL; i++)
+  {
+    if(symbols[i].data != NULL && 0 == strcmp(symbols[i].name, name))
+    {
+      target = &symbols[i];
+    }
+  }
+
+  if(target == NULL || target->size < bytes)
+  {
+    printf("\n\r error: No initialized symbol '%s' of at least %u bytes to store the CRC !\n\r", name,
+           (unsigned int)bytes);
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    if(target->value <= ranges[i].end && ranges[i].start <= target->value + bytes - 1)
+    {
+      printf("\n\r warning: The CRC range 0x%llx-0x%llx includes its own storage '%s' !\n\r",
+             (unsigned long long)ranges[i].start, (unsigned long long)ranges[i].end, name);
+    }
+  }
+
+  for(uint32 b = 0; b < bytes; b++)
+  {
+    uint32 shift = 8U * (msb ? (bytes - 1U - b) : b);
+    target->data[b] = (char)(uint8)(value >> shift);
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Crc_InsertInImage
+** Description: compute the CRC of address ranges of the load image and optionally store it in a symbol.
+**              request: "<model>@<start>-<end>[,<start>-<end>...][=<symbol>]". The ranges are chained in the given
+**              order, the gaps between sections are read as IMAGE_FILL_BYTE. The symbol is patched in the loaded
+**              ELF buffer, so the exports run afterwards (-c, -s19, -bin) contain the CRC.
+** Parameter:   sElf* elf, const char* request
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Crc_InsertInImage(sElf* elf, const char* request)
+{
+  char        spec[MAX_LINE_LEN];
+  char*       list   = NULL;
+  char*       symbol = NULL;
+  sCrcRange   ranges[CRC_MAX_RANGES];
+  uint32      count  = 0;
+  sCrcEngine* engine = NULL;
+  sImage      image;
+  sCrcWalk    walk;
+  uint64      value  = 0;
+  boolean     result = TRUE;
+
+  strncpy(spec, request, sizeof(spec) - 1);
+  spec[sizeof(spec) - 1] = '\0';
+
+  list   = strchr(spec, '@');
+  symbol = strrchr(spec, '=');
+
+  if(list == NULL || (symbol != NULL && symbol < list))
+  {
+    printf("\n\r error: Bad CRC request '%s' (<model>@<start>-<end>[,<start>-<end>][=<symbol>]) !\n\r", request);
+    return(FALSE);
+  }
+
+  *list++ = '\0';
+  if(symbol != NULL)
+  {
+    *symbol++ = '\0';
+  }
+
+  if(!Crc_ParseRanges(list, ranges, &count))
+  {
+    printf("\n\r error: Bad CRC address range in '%s' !\n\r", request);
+    return(FALSE);
+  }
+
+  engine = (sCrcEngine*)Arena_Alloc(&elf->arena, sizeof(sCrcEngine));
+
+  if(engine == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(!Crc_Init(engine, spec))
+  {
+    printf("\n\r error: Unknown CRC model '%s' !\n\r", spec);
+    Crc_PrintModels();
+    return(FALSE);
+  }
+
+  if(!Image_BuildFromElf(&image, elf))
+  {
+    return(FALSE);
+  }
+
+  walk.engine = engine;
+  walk.reg    = Crc_Start(engine);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    Image_WalkRange(&image, ranges[i].start, ranges[i].end, IMAGE_FILL_BYTE, Crc_WalkChunk, &walk);
+  }
+
+  value = Crc_Final(engine, walk.reg);
+
+  printf("\n\r CRC %s", engine->param.name);
+  for(uint32 i = 0; i < count; i++)
+  {
+    printf("%s0x%llx-0x%llx", (i == 0) ? " " : ",", (unsigned long long)ranges[i].start,
+           (unsigned long long)ranges[i].end);
+  }
+  printf(" = 0x%0*llx", (int)((engine->param.width + 3U) / 4U), (unsigned long long)value);
+
+  if(symbol != NULL)
+  {
+    printf(" -> %s", symbol);
+    result = Crc_WriteSymbol(elf, symbol, value, (engine->param.width + 7U) / 8U, ranges, count);
+  }
+  printf("\n\r");
+
+  Image_Release(&image);
+  return(result);
+}
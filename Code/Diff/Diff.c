@@ -0,0 +1,647 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Diff.h>
+#include<Hash.h>
+#include<Thread.h>
+
+#define DIFF_HASH_SEED  0ULL
+
+//one content to hash, the jobs of both images are run by one parallel loop
+typedef struct
+{
+  const void* data;
+  uint64      size;
+  uint64*     hash;
+}sDiffHashJob;
+
+//name index of the entries of the new image, entries with the same name are chained in file order
+typedef struct
+{
+  char**  names;
+  uint32* slots;                    //index of the first entry of each name (DIFF_NONE for an empty slot)
+  uint32* heads;                    //next entry of each name not yet matched
+  uint32* next;                     //next entry with the same name
+  uint32  mask;
+}sDiffIndex;
+
+static boolean Diff_LoadImage(sElf* Image, sDiffImage* image);
+static boolean Diff_IsReportedSymbol(const sElfSymbol* symbol);
+static boolean Diff_SameSection(const sElfSection* a, uint64 HashA, const sElfSection* b, uint64 HashB);
+static const sElfSection* Diff_MatchSection(sElf* Image, const sDiffImage* image, uint32 index, const char* name);
+static void    Diff_HashJob(uint32 index, void* ctx);
+static boolean Diff_HashImages(sArena* arena, sDiffImage* RefImg, sDiffImage* NewImg);
+static boolean Diff_BuildIndex(sArena* arena, sDiffIndex* index, char** names, uint32 count);
+static uint32  Diff_TakeMatch(sDiffIndex* index, const char* name);
+static uint32  Diff_Compare(sArena* arena,
+                            char** RefNames, uint64* RefSizes, uint64* RefHashes, uint8* RefInfo, uint32 RefNbr,
+                            char** NewNames, uint64* NewSizes, uint64* NewHashes, uint8* NewInfo, uint32 NewNbr,
+                            sDiffEntry* entries);
+static int     Diff_CompareEntries(const void* a, const void* b);
+static void    Diff_PrintReport(const char* title, const char* column, sDiffEntry* entries, uint32 count, boolean symbols);
+
+static const char* const DiffStatusStr[] = {"UNCHANGED", "CHANGED", "ADDED", "REMOVED"};
+
+/*******************************************************************************************************************
+** Function:    Diff_Images
+** Description: hash the sections and the symbols of two images and print the delta reports (see Diff_Report).
+**              The tables of the comparison are taken from the arena of the new image.
+** Parameter:   sElf* RefImage, sElf* NewImage, char* RefPath, char* NewPath
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Diff_Images(sElf* RefImage, sElf* NewImage, char* RefPath, char* NewPath)
+{
+  sDiffImage RefImg;
+  sDiffImage NewImg;
+
+  memset(&RefImg, 0, sizeof(RefImg));
+  memset(&NewImg, 0, sizeof(NewImg));
+
+  if(!Diff_LoadImage(RefImage, &RefImg) || !Diff_LoadImage(NewImage, &NewImg) ||
+     !Diff_HashImages(&NewImage->arena, &RefImg, &NewImg))
+  {
+    return(FALSE);
+  }
+
+  return(Diff_Report(&RefImg, &NewImg, &NewImage->arena, RefPath, NewPath, TRUE));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_Report
+** Description: compare the hashed sections and symbols of two images and print the sorted delta reports.
+**              Entries are matched by name, a content change is detected by the hash of the entry bytes
+**              even when the size is unchanged. The symbol report is skipped when symbols is FALSE. The tables
+**              of the comparison are taken from the given arena.
+** Parameter:   sDiffImage* RefImg, sDiffImage* NewImg, sArena* arena, char* RefPath, char* NewPath,
+**              boolean symbols
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Diff_Report(sDiffImage* RefImg, sDiffImage* NewImg, sArena* arena, char* RefPath, char* NewPath,
+                    boolean symbols)
+{
+  uint32      max     = RefImg->SectionsNbr + NewImg->SectionsNbr + RefImg->SymbolsNbr + NewImg->SymbolsNbr;
+  sDiffEntry* entries = (sDiffEntry*)Arena_Alloc(arena, ((size_t)max + 1) * sizeof(sDiffEntry));
+  boolean     result  = FALSE;
+
+  if(entries != NULL)
+  {
+    uint32  RefNbr    = (RefImg->SectionsNbr > RefImg->SymbolsNbr) ? RefImg->SectionsNbr : RefImg->SymbolsNbr;
+    uint32  NewNbr    = (NewImg->SectionsNbr > NewImg->SymbolsNbr) ? NewImg->SectionsNbr : NewImg->SymbolsNbr;
+    char**  RefNames  = (char**)Arena_Alloc(arena, ((size_t)RefNbr + 1) * sizeof(char*));
+    char**  NewNames  = (char**)Arena_Alloc(arena, ((size_t)NewNbr + 1) * sizeof(char*));
+    uint64* RefSizes  = (uint64*)Arena_Alloc(arena, ((size_t)RefNbr + 1) * sizeof(uint64));
+    uint64* NewSizes  = (uint64*)Arena_Alloc(arena, ((size_t)NewNbr + 1) * sizeof(uint64));
+    uint64* RefHashes = (uint64*)Arena_Alloc(arena, ((size_t)RefNbr + 1) * sizeof(uint64));
+    uint64* NewHashes = (uint64*)Arena_Alloc(arena, ((size_t)NewNbr + 1) * sizeof(uint64));
+    uint8*  RefInfo   = (uint8*)Arena_Alloc(arena, (size_t)RefNbr + 1);
+    uint8*  NewInfo   = (uint8*)Arena_Alloc(arena, (size_t)NewNbr + 1);
+
+    if(RefNames != NULL && NewNames != NULL && RefSizes != NULL && NewSizes != NULL &&
+       RefHashes != NULL && NewHashes != NULL && RefInfo != NULL && NewInfo != NULL)
+    {
+      uint32 count = 0;
+      uint32 n     = 0;
+      uint32 m     = 0;
+
+      printf("\nDIFF : %s -> %s\n", RefPath, NewPath);
+
+      /* sections (the null section and the unnamed ones are skipped) */
+      for(uint32 i = 0; i < RefImg->SectionsNbr; i++)
+      {
+        if(RefImg->sections[i].name[0] != '\0')
+        {
+          RefNames[n] = RefImg->sections[i].name; RefSizes[n] = RefImg->sections[i].size; RefHashes[n] = RefImg->SectionHash[i]; RefInfo[n] = 0; n++;
+        }
+      }
+      for(uint32 i = 0; i < NewImg->SectionsNbr; i++)
+      {
+        if(NewImg->sections[i].name[0] != '\0')
+        {
+          NewNames[m] = NewImg->sections[i].name; NewSizes[m] = NewImg->sections[i].size; NewHashes[m] = NewImg->SectionHash[i]; NewInfo[m] = 0; m++;
+        }
+      }
+
+      count = Diff_Compare(arena, RefNames, RefSizes, RefHashes, RefInfo, n, NewNames, NewSizes, NewHashes, NewInfo, m, entries);
+      Diff_PrintReport("SECTIONS DIFF", "Section", entries, count, FALSE);
+
+      /* functions and objects */
+      if(symbols)
+      {
+        n = 0;
+        m = 0;
+        for(uint32 i = 0; i < RefImg->SymbolsNbr; i++)
+        {
+          if(Diff_IsReportedSymbol(&RefImg->symbols[i]))
+          {
+            RefNames[n] = RefImg->symbols[i].name; RefSizes[n] = RefImg->symbols[i].size; RefHashes[n] = RefImg->SymbolHash[i]; RefInfo[n] = RefImg->symbols[i].info; n++;
+          }
+        }
+        for(uint32 i = 0; i < NewImg->SymbolsNbr; i++)
+        {
+          if(Diff_IsReportedSymbol(&NewImg->symbols[i]))
+          {
+            NewNames[m] = NewImg->symbols[i].name; NewSizes[m] = NewImg->symbols[i].size; NewHashes[m] = NewImg->SymbolHash[i]; NewInfo[m] = NewImg->symbols[i].info; m++;
+          }
+        }
+
+        count = Diff_Compare(arena, RefNames, RefSizes, RefHashes, RefInfo, n, NewNames, NewSizes, NewHashes, NewInfo, m, entries);
+        Diff_PrintReport("SYMBOLS DIFF", "Symbol", entries, count, TRUE);
+      }
+
+      result = TRUE;
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+  }
+
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_PrepareImage
+** Description: get and hash the sections and the reported symbols of one image for later comparisons. With the
+**              prepared previous build of the image (prev, or NULL), a symbol at the same place of an unchanged
+**              section keeps its previous hash instead of hashing its bytes again.
+**              The hash tables are taken from the arena of the image.
+** Parameter:   sElf* Image, sDiffImage* image, const sDiffImage* prev
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Diff_PrepareImage(sElf* Image, sDiffImage* image, const sDiffImage* prev)
+{
+  sArena*       scratch = Arena_Thread();
+  sArenaMark    mark    = Arena_Mark(scratch);
+  uint32        max     = 0;
+  uint32        count   = 0;
+  sDiffHashJob* jobs    = NULL;
+  uint8*        same    = NULL;
+
+  memset(image, 0, sizeof(sDiffImage));
+
+  if(!Diff_LoadImage(Image, image))
+  {
+    return(FALSE);
+  }
+
+  max  = (image->SectionsNbr > image->SymbolsNbr) ? image->SectionsNbr : image->SymbolsNbr;
+  jobs = (sDiffHashJob*)Arena_Alloc(scratch, ((size_t)max + 1) * sizeof(sDiffHashJob));
+  same = (uint8*)Arena_Calloc(scratch, (size_t)image->SectionsNbr + 1, sizeof(uint8));
+
+  if(jobs == NULL || same == NULL)
+  {
+    Arena_Rewind(scratch, mark);
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < image->SectionsNbr; i++)
+  {
+    if(image->sections[i].data != NULL && image->sections[i].size > 0)
+    {
+      jobs[count].data = image->sections[i].data;
+      jobs[count].size = image->sections[i].size;
+      jobs[count].hash = &image->SectionHash[i];
+      count++;
+    }
+  }
+  Thread_ParallelFor(count, Diff_HashJob, jobs);
+
+  /* a section is unchanged when the section of the same index has the same name, place and content */
+  if(prev != NULL)
+  {
+    for(uint32 i = 0; i < image->SectionsNbr && i < prev->SectionsNbr; i++)
+    {
+      same[i] = (uint8)Diff_SameSection(&image->sections[i], image->SectionHash[i], &prev->sections[i], prev->SectionHash[i]);
+    }
+  }
+
+  count = 0;
+  for(uint32 i = 0; i < image->SymbolsNbr; i++)
+  {
+    const sElfSymbol* symbol = &image->symbols[i];
+
+    if(symbol->data == NULL || symbol->size == 0 || !Diff_IsReportedSymbol(symbol))
+    {
+      continue;
+    }
+
+    if(prev != NULL && i < prev->SymbolsNbr && symbol->shndx < image->SectionsNbr &&
+       same[symbol->shndx] && prev->symbols[i].shndx == symbol->shndx &&
+       prev->symbols[i].value == symbol->value && prev->symbols[i].size == symbol->size)
+    {
+      image->SymbolHash[i] = prev->SymbolHash[i];
+    }
+    else
+    {
+      jobs[count].data = symbol->data;
+      jobs[count].size = symbol->size;
+      jobs[count].hash = &image->SymbolHash[i];
+      count++;
+    }
+  }
+  Thread_ParallelFor(count, Diff_HashJob, jobs);
+
+  Arena_Rewind(scratch, mark);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_Summarize
+** Description: count the sections changed between two prepared builds of an image. Sections are matched by name
+**              (see Diff_MatchSection).
+** Parameter:   sElf* RefImage, const sDiffImage* RefImg, sElf* NewImage, const sDiffImage* NewImg,
+**              sDiffSummary* summary
+** Return:      void
+*******************************************************************************************************************/
+void Diff_Summarize(sElf* RefImage, const sDiffImage* RefImg, sElf* NewImage, const sDiffImage* NewImg,
+                    sDiffSummary* summary)
+{
+  memset(summary, 0, sizeof(sDiffSummary));
+
+  for(uint32 i = 0; i < NewImg->SectionsNbr; i++)
+  {
+    const sElfSection* section = &NewImg->sections[i];
+    const sElfSection* ref     = Diff_MatchSection(RefImage, RefImg, i, section->name);
+    boolean            changed = TRUE;
+
+    if(ref != NULL)
+    {
+      changed = !Diff_SameSection(section, NewImg->SectionHash[i], ref, RefImg->SectionHash[ref - RefImg->sections]);
+    }
+
+    if(changed)
+    {
+      summary->sections++;
+      summary->AllocSections += ((section->flags & SHF_ALLOC) || (ref != NULL && (ref->flags & SHF_ALLOC))) ? 1U : 0U;
+      summary->symbols       |= (section->type == SHT_SYMTAB || section->type == SHT_STRTAB) ? TRUE : FALSE;
+    }
+  }
+
+  /* removed sections */
+  for(uint32 i = 0; i < RefImg->SectionsNbr; i++)
+  {
+    const sElfSection* ref = &RefImg->sections[i];
+
+    if(Diff_MatchSection(NewImage, NewImg, i, ref->name) == NULL)
+    {
+      summary->sections++;
+      summary->AllocSections += (ref->flags & SHF_ALLOC) ? 1U : 0U;
+      summary->symbols       |= (ref->type == SHT_SYMTAB || ref->type == SHT_STRTAB) ? TRUE : FALSE;
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_MatchSection
+** Description: find the section of the given name in the other build. A relink mostly keeps the section order,
+**              so the section of the same index is tried before the name directory of the image (which gives
+**              the first section of a duplicated name, this can only report more changes).
+** Parameter:   sElf* Image, const sDiffImage* image, uint32 index, const char* name
+** Return:      const sElfSection* (NULL if there is no section of this name)
+*******************************************************************************************************************/
+static const sElfSection* Diff_MatchSection(sElf* Image, const sDiffImage* image, uint32 index, const char* name)
+{
+  if(index < image->SectionsNbr && 0 == strcmp(image->sections[index].name, name))
+  {
+    return(&image->sections[index]);
+  }
+  return(Elf_FindSection(Image, name));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_SameSection
+** Description: two sections are the same when their name, type, flags, place and content are the same
+** Parameter:   const sElfSection* a, uint64 HashA, const sElfSection* b, uint64 HashB
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Diff_SameSection(const sElfSection* a, uint64 HashA, const sElfSection* b, uint64 HashB)
+{
+  return((boolean)(a->type == b->type && a->flags == b->flags && a->addr == b->addr && a->size == b->size &&
+                   HashA == HashB && 0 == strcmp(a->name, b->name)));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_LoadImage
+** Description: get the sections and the symbols of one image (class independent views), the hash tables are
+**              taken from the arena of the image
+** Parameter:   sElf* Image, sDiffImage* image
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Diff_LoadImage(sElf* Image, sDiffImage* image)
+{
+  if(!Elf_GetSections(Image, &image->sections, &image->SectionsNbr))
+  {
+    return(FALSE);
+  }
+
+  /* an image without symbol table is compared by sections only */
+  if(!Elf_GetSymbols(Image, &image->symbols, &image->SymbolsNbr))
+  {
+    image->SymbolsNbr = 0;
+  }
+
+  image->SectionHash = (uint64*)Arena_Calloc(&Image->arena, (size_t)image->SectionsNbr + 1, sizeof(uint64));
+  image->SymbolHash  = (uint64*)Arena_Calloc(&Image->arena, (size_t)image->SymbolsNbr + 1, sizeof(uint64));
+
+  return((boolean)(image->SectionHash != NULL && image->SymbolHash != NULL));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_IsReportedSymbol
+** Description: the symbol report covers the named OBJECT and FUNCTION entries (same filter as -sym)
+** Parameter:   const sElfSymbol* symbol
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Diff_IsReportedSymbol(const sElfSymbol* symbol)
+{
+  uint8 type = ELF32_ST_TYPE(symbol->info);
+
+  return((boolean)((type == STT_OBJECT || type == STT_FUNC) && symbol->name[0] != '\0'));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_HashJob
+** Description: hash the content of one section or symbol
+** Parameter:   uint32 index, void* ctx (sDiffHashJob[])
+** Return:      void
+*******************************************************************************************************************/
+static void Diff_HashJob(uint32 index, void* ctx)
+{
+  sDiffHashJob* job = &((sDiffHashJob*)ctx)[index];
+
+  *job->hash = Hash_Xxh64(job->data, job->size, DIFF_HASH_SEED);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_HashImages
+** Description: hash the content of every section and reported symbol of both images in parallel.
+**              Entries without file data (NOBITS, undefined) keep the hash 0 and are compared by size only.
+** Parameter:   sArena* arena, sDiffImage* RefImg, sDiffImage* NewImg
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Diff_HashImages(sArena* arena, sDiffImage* RefImg, sDiffImage* NewImg)
+{
+  sDiffImage*   images[2] = {RefImg, NewImg};
+  uint32        max       = RefImg->SectionsNbr + RefImg->SymbolsNbr + NewImg->SectionsNbr + NewImg->SymbolsNbr;
+  uint32        count     = 0;
+  sDiffHashJob* jobs      = (sDiffHashJob*)Arena_Alloc(arena, ((size_t)max + 1) * sizeof(sDiffHashJob));
+
+  if(jobs == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 k = 0; k < 2; k++)
+  {
+    sDiffImage* image = images[k];
+
+    for(uint32 i = 0; i < image->SectionsNbr; i++)
+    {
+      if(image->sections[i].data != NULL && image->sections[i].size > 0)
+      {
+        jobs[count].data = image->sections[i].data;
+        jobs[count].size = image->sections[i].size;
+        jobs[count].hash = &image->SectionHash[i];
+        count++;
+      }
+    }
+
+    for(uint32 i = 0; i < image->SymbolsNbr; i++)
+    {
+      if(image->symbols[i].data != NULL && image->symbols[i].size > 0 && Diff_IsReportedSymbol(&image->symbols[i]))
+      {
+        jobs[count].data = image->symbols[i].data;
+        jobs[count].size = image->symbols[i].size;
+        jobs[count].hash = &image->SymbolHash[i];
+        count++;
+      }
+    }
+  }
+
+  Thread_ParallelFor(count, Diff_HashJob, jobs);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_BuildIndex
+** Description: index entries by name in an open addressing hash table
+** Parameter:   sArena* arena, sDiffIndex* index, char** names, uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Diff_BuildIndex(sArena* arena, sDiffIndex* index, char** names, uint32 count)
+{
+  uint32 size = 16;
+
+  while(size < (count * 2))
+  {
+    size <<= 1;
+  }
+
+  index->names = names;
+  index->mask  = size - 1;
+  index->slots = (uint32*)Arena_Alloc(arena, (size_t)size * sizeof(uint32));
+  index->heads = (uint32*)Arena_Alloc(arena, (size_t)size * sizeof(uint32));
+  index->next  = (uint32*)Arena_Alloc(arena, ((size_t)count + 1) * sizeof(uint32));
+
+  if(index->slots == NULL || index->heads == NULL || index->next == NULL)
+  {
+    return(FALSE);
+  }
+
+  memset(index->slots, 0xFF, (size_t)size * sizeof(uint32));
+
+  /* insert backwards so that each chain is in file order */
+  for(uint32 i = count; i-- > 0;)
+  {
+    uint32 slot = Hash_String(names[i]) & index->mask;
+
+    while(index->slots[slot] != DIFF_NONE && 0 != strcmp(names[index->slots[slot]], names[i]))
+    {
+      slot = (slot + 1) & index->mask;
+    }
+
+    index->next[i]     = (index->slots[slot] != DIFF_NONE) ? index->heads[slot] : DIFF_NONE;
+    index->slots[slot] = i;
+    index->heads[slot] = i;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_TakeMatch
+** Description: take the next entry of the given name not matched yet (duplicated local names are matched in
+**              file order)
+** Parameter:   sDiffIndex* index, const char* name
+** Return:      uint32 (entry index, DIFF_NONE if there is none left)
+*******************************************************************************************************************/
+static uint32 Diff_TakeMatch(sDiffIndex* index, const char* name)
+{
+  uint32 slot = Hash_String(name) & index->mask;
+
+  while(index->slots[slot] != DIFF_NONE)
+  {
+    if(0 == strcmp(index->names[index->slots[slot]], name))
+    {
+      uint32 match = index->heads[slot];
+
+      if(match != DIFF_NONE)
+      {
+        index->heads[slot] = index->next[match];
+      }
+      return(match);
+    }
+    slot = (slot + 1) & index->mask;
+  }
+  return(DIFF_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_Compare
+** Description: match two lists of entries by name and fill the sorted list of the changed, added and removed
+**              entries
+** Parameter:   sArena* arena, reference and new lists (names, sizes, content hashes, symbol info),
+**              sDiffEntry* entries
+** Return:      uint32 (number of entries)
+*******************************************************************************************************************/
+static uint32 Diff_Compare(sArena* arena,
+                           char** RefNames, uint64* RefSizes, uint64* RefHashes, uint8* RefInfo, uint32 RefNbr,
+                           char** NewNames, uint64* NewSizes, uint64* NewHashes, uint8* NewInfo, uint32 NewNbr,
+                           sDiffEntry* entries)
+{
+  sDiffIndex index;
+  uint32     count   = 0;
+  uint8*     matched = (uint8*)Arena_Calloc(arena, (size_t)NewNbr + 1, sizeof(uint8));
+
+  if(matched == NULL || !Diff_BuildIndex(arena, &index, NewNames, NewNbr))
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(0);
+  }
+
+  for(uint32 i = 0; i < RefNbr; i++)
+  {
+    uint32      j     = Diff_TakeMatch(&index, RefNames[i]);
+    sDiffEntry* entry = &entries[count];
+
+    entry->name    = RefNames[i];
+    entry->info    = RefInfo[i];
+    entry->RefSize = RefSizes[i];
+
+    if(j == DIFF_NONE)
+    {
+      entry->status  = DIFF_REMOVED;
+      entry->NewSize = 0;
+    }
+    else
+    {
+      matched[j]     = 1;
+      entry->NewSize = NewSizes[j];
+      entry->status  = (RefSizes[i] != NewSizes[j] || RefHashes[i] != NewHashes[j]) ? DIFF_CHANGED : DIFF_UNCHANGED;
+    }
+
+    entry->delta = (sint64)entry->NewSize - (sint64)entry->RefSize;
+
+    if(entry->status != DIFF_UNCHANGED)
+    {
+      count++;
+    }
+  }
+
+  for(uint32 j = 0; j < NewNbr; j++)
+  {
+    if(!matched[j])
+    {
+      sDiffEntry* entry = &entries[count++];
+
+      entry->status  = DIFF_ADDED;
+      entry->name    = NewNames[j];
+      entry->info    = NewInfo[j];
+      entry->RefSize = 0;
+      entry->NewSize = NewSizes[j];
+      entry->delta   = (sint64)NewSizes[j];
+    }
+  }
+
+  qsort(entries, count, sizeof(sDiffEntry), Diff_CompareEntries);
+  return(count);
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_CompareEntries
+** Description: qsort callback: largest size change first, then by status and by name
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Diff_CompareEntries(const void* a, const void* b)
+{
+  const sDiffEntry* x  = (const sDiffEntry*)a;
+  const sDiffEntry* y  = (const sDiffEntry*)b;
+  uint64            dx = (x->delta < 0) ? (uint64)(-x->delta) : (uint64)x->delta;
+  uint64            dy = (y->delta < 0) ? (uint64)(-y->delta) : (uint64)y->delta;
+
+  if(dx != dy)
+  {
+    return((dx > dy) ? -1 : 1);
+  }
+  if(x->status != y->status)
+  {
+    return((x->status < y->status) ? -1 : 1);
+  }
+  return(strcmp(x->name, y->name));
+}
+
+/*******************************************************************************************************************
+** Function:    Diff_PrintReport
+** Description: display one delta report and its totals
+** Parameter:   const char* title, const char* column, sDiffEntry* entries, uint32 count, boolean symbols
+** Return:      void
+*******************************************************************************************************************/
+static void Diff_PrintReport(const char* title, const char* column, sDiffEntry* entries, uint32 count, boolean symbols)
+{
+  uint32 changed = 0;
+  uint32 added   = 0;
+  uint32 removed = 0;
+  sint64 total   = 0;
+
+  printf("\n%s : \n", title);
+  printf("\n%-12s%-*s%-17s%-17s%-13s%s\n\n", "Status", symbols ? 11 : 0, symbols ? "Type" : "", "Old size", "New size", "Delta", column);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    const char* type = "";
+
+    if(symbols)
+    {
+      type = (ELF32_ST_TYPE(entries[i].info) == STT_FUNC) ? "FUNCTION" : "OBJECT";
+    }
+
+    printf("%-12s%-*s0x%-15llx0x%-15llx%+-13lld%s\n",
+           DiffStatusStr[entries[i].status],
+           symbols ? 11 : 0,
+           type,
+           (unsigned long long)entries[i].RefSize,
+           (unsigned long long)entries[i].NewSize,
+           (long long)entries[i].delta,
+           entries[i].name
+          );
+
+    total += entries[i].delta;
+
+    switch(entries[i].status)
+    {
+      case DIFF_CHANGED: changed++; break;
+      case DIFF_ADDED:   added++;   break;
+      case DIFF_REMOVED: removed++; break;
+      default:                      break;
+    }
+  }
+
+  printf("\n%u changed, %u added, %u removed, total size delta %+lld bytes\n", changed, added, removed, (long long)total);
+}
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __DIFF_H__
+#define __DIFF_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define DIFF_NONE  0xFFFFFFFFUL
+
+typedef enum
+{
+  DIFF_UNCHANGED = 0,
+  DIFF_CHANGED,
+  DIFF_ADDED,
+  DIFF_REMOVED
+}tDiffStatus;
+
+//sections and symbols of one image with the content hash of each entry
+typedef struct
+{
+  sElfSection* sections;
+  uint32       SectionsNbr;
+  sElfSymbol*  symbols;
+  uint32       SymbolsNbr;
+  uint64*      SectionHash;
+  uint64*      SymbolHash;
+}sDiffImage;
+
+//one line of the delta report
+typedef struct
+{
+  tDiffStatus status;
+  char*       name;
+  uint8       info;                 //symbol type and bind (symbols only)
+  uint64      RefSize;
+  uint64      NewSize;
+  sint64      delta;
+}sDiffEntry;
+
+//what changed between two builds of an image (see Diff_Summarize)
+typedef struct
+{
+  uint32  sections;                 //changed, added or removed sections
+  uint32  AllocSections;            //the ones of the load image (SHF_ALLOC)
+  boolean symbols;                  //a symbol or string table changed
+}sDiffSummary;
+
+boolean Diff_Images(sElf* RefImage, sElf* NewImage, char* RefPath, char* NewPath);
+boolean Diff_PrepareImage(sElf* Image, sDiffImage* image, const sDiffImage* prev);
+boolean Diff_Report(sDiffImage* RefImg, sDiffImage* NewImg, sArena* arena, char* RefPath, char* NewPath,
+                    boolean symbols);
+void    Diff_Summarize(sElf* RefImage, const sDiffImage* RefImg, sElf* NewImage, const sDiffImage* NewImg,
+                       sDiffSummary* summary);
+
+#endif
@@ -0,0 +1,1039 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Lazy reader of the DWARF debug information (.debug_info, versions 2 to 5, 32 and 64-bit DWARF).
+**
+** Dwarf_Open only walks the unit headers (a few bytes each). The abbreviation table of a unit is read on the first
+** access to one of its DIEs, and a DIE is decoded on request by its .debug_info offset: the attributes needed by the
+** type and variable readers are decoded, the other ones are skipped by their form. Nothing is copied, the strings
+** point into the loaded file. Every read is bounded by its unit, a corrupt DIE fails its request only.
+**
+** Not supported: type units (DW_FORM_ref_sig8), split DWARF (.dwo, DW_FORM_addrx), supplementary files
+** (DW_FORM_GNU_ref_alt) and compressed debug sections.
+*******************************************************************************************************************/
+
+#include<Dwarf.h>
+
+#define DWARF_SHF_COMPRESSED      0x800U
+
+#define DWARF_MAX_ABBREV_CODE     0x100000UL    //abbreviation codes of a unit (they are dense in practice)
+
+//attributes
+#define DW_AT_sibling             0x01U
+#define DW_AT_location            0x02U
+#define DW_AT_name                0x03U
+#define DW_AT_byte_size           0x0BU
+#define DW_AT_bit_offset          0x0CU
+#define DW_AT_bit_size            0x0DU
+#define DW_AT_lower_bound         0x22U
+#define DW_AT_upper_bound         0x2FU
+#define DW_AT_abstract_origin     0x31U
+#define DW_AT_count               0x37U
+#define DW_AT_data_member_location 0x38U
+#define DW_AT_declaration         0x3CU
+#define DW_AT_encoding            0x3EU
+#define DW_AT_specification       0x47U
+#define DW_AT_type                0x49U
+#define DW_AT_data_bit_offset     0x6BU
+#define DW_AT_str_offsets_base    0x72U
+
+//forms
+#define DW_FORM_addr              0x01U
+#define DW_FORM_block2            0x03U
+#define DW_FORM_block4            0x04U
+#define DW_FORM_data2             0x05U
+#define DW_FORM_data4             0x06U
+#define DW_FORM_data8             0x07U
+#define DW_FORM_string            0x08U
+#define DW_FORM_block             0x09U
+#define DW_FORM_block1            0x0AU
+#define DW_FORM_data1             0x0BU
+#define DW_FORM_flag              0x0CU
+#define DW_FORM_sdata             0x0DU
+#define DW_FORM_strp              0x0EU
+#define DW_FORM_udata             0x0FU
+#define DW_FORM_ref_addr          0x10U
+#define DW_FORM_ref1              0x11U
+#define DW_FORM_ref2              0x12U
+#define DW_FORM_ref4              0x13U
+#define DW_FORM_ref8              0x14U
+#define DW_FORM_ref_udata         0x15U
+#define DW_FORM_indirect          0x16U
+#define DW_FORM_sec_offset        0x17U
+#define DW_FORM_exprloc           0x18U
+#define DW_FORM_flag_present      0x19U
+#define DW_FORM_strx              0x1AU
+#define DW_FORM_addrx             0x1BU
+#define DW_FORM_ref_sup4          0x1CU
+#define DW_FORM_strp_sup          0x1DU
+#define DW_FORM_data16            0x1EU
+#define DW_FORM_line_strp         0x1FU
+#define DW_FORM_ref_sig8          0x20U
+#define DW_FORM_implicit_const    0x21U
+#define DW_FORM_loclistx          0x22U
+#define DW_FORM_rnglistx          0x23U
+#define DW_FORM_ref_sup8          0x24U
+#define DW_FORM_strx1             0x25U
+#define DW_FORM_strx2             0x26U
+#define DW_FORM_strx3             0x27U
+#define DW_FORM_strx4             0x28U
+#define DW_FORM_addrx1            0x29U
+#define DW_FORM_addrx2            0x2AU
+#define DW_FORM_addrx3            0x2BU
+#define DW_FORM_addrx4            0x2CU
+#define DW_FORM_GNU_addr_index    0x1F01U
+#define DW_FORM_GNU_str_index     0x1F02U
+#define DW_FORM_GNU_ref_alt       0x1F20U
+#define DW_FORM_GNU_strp_alt      0x1F21U
+
+//unit types (DWARF 5)
+#define DW_UT_compile             0x01U
+#define DW_UT_type                0x02U
+#define DW_UT_partial             0x03U
+#define DW_UT_skeleton            0x04U
+#define DW_UT_split_compile       0x05U
+#define DW_UT_split_type          0x06U
+
+//location operations
+#define DW_OP_addr                0x03U
+#define DW_OP_plus_uconst         0x23U
+
+//classes of the decoded attribute values
+#define DWARF_VAL_NONE            0U      //skipped (unsupported reference or index)
+#define DWARF_VAL_CONST           1U      //unsigned constant (or flag)
+#define DWARF_VAL_SCONST          2U      //signed constant (DW_FORM_sdata, DW_FORM_implicit_const)
+#define DWARF_VAL_REF             3U      //.debug_info offset
+#define DWARF_VAL_STRING          4U
+#define DWARF_VAL_STRX            5U      //index in .debug_str_offsets
+#define DWARF_VAL_BLOCK           6U      //block or expression
+#define DWARF_VAL_OFFSET          7U      //offset in another section
+
+//bounded read position in a section
+typedef struct
+{
+  const uint8* p;
+  const uint8* end;
+  boolean      msb;
+  boolean      error;
+}sDwarfCursor;
+
+//decoded attribute value
+typedef struct
+{
+  uint32       kind;                  //DWARF_VAL_xxx
+  uint32       form;
+  uint64       value;
+  const uint8* block;                 //DWARF_VAL_BLOCK and DWARF_VAL_STRING
+}sDwarfValue;
+
+static uint64      Dwarf_Get(sDwarfCursor* cursor, uint32 size);
+static uint64      Dwarf_ULeb(sDwarfCursor* cursor);
+static sint64      Dwarf_SLeb(sDwarfCursor* cursor);
+static void        Dwarf_Skip(sDwarfCursor* cursor, uint64 size);
+static uint64      Dwarf_StringLimit(const uint8* data, uint64 size);
+static boolean     Dwarf_Section(sElf* elf, const char* name, const uint8** data, uint64* size);
+static uint32      Dwarf_CountUnits(const sDwarf* dwarf);
+static sDwarfUnit* Dwarf_FindUnit(sDwarf* dwarf, uint64 offset);
+static boolean     Dwarf_LoadUnit(sDwarf* dwarf, sDwarfUnit* unit);
+static boolean     Dwarf_ReadValue(sDwarfCursor* cursor, const sDwarfUnit* unit, uint32 form, sint64 implicit,
+                                   sDwarfValue* value);
+static const char* Dwarf_String(const sDwarf* dwarf, const sDwarfUnit* unit, const sDwarfValue* value);
+static boolean     Dwarf_Constant(const sDwarfValue* value, uint64* result);
+static boolean     Dwarf_Bound(const sDwarfValue* value, sint64* result);
+static void        Dwarf_Expression(const sDwarfUnit* unit, const sDwarfValue* value, boolean msb, sDwarfDie* die,
+                                    uint32 attribute);
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Get
+** Description: read an unsigned value of 1 to 8 bytes in the byte order of the file
+** Parameter:   sDwarfCursor* cursor, uint32 size
+** Return:      uint64 (0 past the end, with the error flag set)
+*******************************************************************************************************************/
+static uint64 Dwarf_Get(sDwarfCursor* cursor, uint32 size)
+{
+  uint64 value = 0;
+
+  if(cursor->error || (uint64)(cursor->end - cursor->p) < size)
+  {
+    cursor->error = TRUE;
+    return(0);
+  }
+
+  for(uint32 i = 0; i < size; i++)
+  {
+    uint32 shift = 8U * (cursor->msb ? (size - 1U - i) : i);
+
+    value |= (uint64)cursor->p[i] << shift;
+  }
+
+  cursor->p += size;
+  return(value);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_ULeb
+** Description: read an unsigned LEB128 value (the bits beyond 64 are dropped)
+** Parameter:   sDwarfCursor* cursor
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Dwarf_ULeb(sDwarfCursor* cursor)
+{
+  uint64 value = 0;
+  uint32 shift = 0;
+
+  while(!cursor->error)
+  {
+    uint8 byte;
+
+    if(cursor->p >= cursor->end)
+    {
+      cursor->error = TRUE;
+      break;
+    }
+
+    byte = *cursor->p++;
+
+    if(shift < 64U)
+    {
+      value |= (uint64)(byte & 0x7FU) << shift;
+    }
+    shift += 7U;
+
+    if((byte & 0x80U) == 0)
+    {
+      break;
+    }
+  }
+  return(value);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_SLeb
+** Description: read a signed LEB128 value
+** Parameter:   sDwarfCursor* cursor
+** Return:      sint64
+*******************************************************************************************************************/
+static sint64 Dwarf_SLeb(sDwarfCursor* cursor)
+{
+  uint64 value = 0;
+  uint32 shift = 0;
+  uint8  byte  = 0;
+
+  while(!cursor->error)
+  {
+    if(cursor->p >= cursor->end)
+    {
+      cursor->error = TRUE;
+      break;
+    }
+
+    byte = *cursor->p++;
+
+    if(shift < 64U)
+    {
+      value |= (uint64)(byte & 0x7FU) << shift;
+    }
+    shift += 7U;
+
+    if((byte & 0x80U) == 0)
+    {
+      break;
+    }
+  }
+
+  if(shift < 64U && (byte & 0x40U) != 0)
+  {
+    value |= ~(uint64)0 << shift;
+  }
+  return((sint64)value);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Skip
+** Description: skip bytes
+** Parameter:   sDwarfCursor* cursor, uint64 size
+** Return:      void
+*******************************************************************************************************************/
+static void Dwarf_Skip(sDwarfCursor* cursor, uint64 size)
+{
+  if(cursor->error || (uint64)(cursor->end - cursor->p) < size)
+  {
+    cursor->error = TRUE;
+  }
+  else
+  {
+    cursor->p += size;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_StringLimit
+** Description: size of a string section up to its last terminated string, so that every string starting before
+**              the limit can be used in place
+** Parameter:   const uint8* data, uint64 size
+** Return:      uint64
+*******************************************************************************************************************/
+static uint64 Dwarf_StringLimit(const uint8* data, uint64 size)
+{
+  while(size > 0 && data[size - 1U] != '\0')
+  {
+    size--;
+  }
+  return(size);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Section
+** Description: find a debug section of the image (an absent section is empty)
+** Parameter:   sElf* elf, const char* name, const uint8** data, uint64* size
+** Return:      boolean (FALSE if the section is compressed)
+*******************************************************************************************************************/
+static boolean Dwarf_Section(sElf* elf, const char* name, const uint8** data, uint64* size)
+{
+  sElfSection* section = Elf_FindSection(elf, name);
+
+  *data = NULL;
+  *size = 0;
+
+  if(section == NULL || section->data == NULL || section->type == SHT_NOBITS)
+  {
+    return(TRUE);
+  }
+
+  if((section->flags & DWARF_SHF_COMPRESSED) != 0)
+  {
+    printf("\n\r error: The section '%s' is compressed (not supported) !\n\r", name);
+    return(FALSE);
+  }
+
+  *data = (const uint8*)section->data;
+  *size = section->size;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_CountUnits
+** Description: count the units of .debug_info (up to the first unit whose length is out of the section)
+** Parameter:   const sDwarf* dwarf
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 Dwarf_CountUnits(const sDwarf* dwarf)
+{
+  sDwarfCursor cursor = {dwarf->info, dwarf->info + dwarf->InfoSize, dwarf->msb, FALSE};
+  uint32       count  = 0;
+
+  while(cursor.p < cursor.end && !cursor.error)
+  {
+    uint64 length = Dwarf_Get(&cursor, 4U);
+
+    if(length == 0xFFFFFFFFULL)
+    {
+      length = Dwarf_Get(&cursor, 8U);
+    }
+    else if(length >= 0xFFFFFFF0ULL)
+    {
+      break;
+    }
+
+    Dwarf_Skip(&cursor, length);
+
+    if(!cursor.error)
+    {
+      count++;
+    }
+  }
+  return(count);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Open
+** Description: find the debug sections of an image and index the units of .debug_info by their headers
+** Parameter:   sDwarf* dwarf, sElf* elf
+** Return:      boolean (FALSE if the image has no usable .debug_info)
+*******************************************************************************************************************/
+boolean Dwarf_Open(sDwarf* dwarf, sElf* elf)
+{
+  sDwarfCursor cursor;
+  uint32       count = 0;
+
+  memset(dwarf, 0, sizeof(sDwarf));
+  dwarf->msb = Elf_IsBigEndian(elf);
+
+  if(!Dwarf_Section(elf, ".debug_info", &dwarf->info, &dwarf->InfoSize)            ||
+     !Dwarf_Section(elf, ".debug_abbrev", &dwarf->abbrev, &dwarf->AbbrevSize)      ||
+     !Dwarf_Section(elf, ".debug_str", &dwarf->str, &dwarf->StrSize)               ||
+     !Dwarf_Section(elf, ".debug_line_str", &dwarf->LineStr, &dwarf->LineStrSize)  ||
+     !Dwarf_Section(elf, ".debug_str_offsets", &dwarf->StrOffsets, &dwarf->StrOffsetsSize))
+  {
+    return(FALSE);
+  }
+
+  /* no debug information: the caller tells whether it is an error */
+  if(dwarf->InfoSize == 0 || dwarf->AbbrevSize == 0)
+  {
+    return(FALSE);
+  }
+
+  dwarf->StrSize     = Dwarf_StringLimit(dwarf->str, dwarf->StrSize);
+  dwarf->LineStrSize = Dwarf_StringLimit(dwarf->LineStr, dwarf->LineStrSize);
+
+  count        = Dwarf_CountUnits(dwarf);
+  dwarf->units = (sDwarfUnit*)Arena_Calloc(&dwarf->arena, (size_t)count + 1U, sizeof(sDwarfUnit));
+
+  if(dwarf->units == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  cursor.p     = dwarf->info;
+  cursor.end   = dwarf->info + dwarf->InfoSize;
+  cursor.msb   = dwarf->msb;
+  cursor.error = FALSE;
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    sDwarfUnit*  unit   = &dwarf->units[dwarf->UnitsNbr];
+    sDwarfCursor header = cursor;
+    uint64       length = 0;
+
+    unit->offset  = (uint64)(cursor.p - dwarf->info);
+    unit->OffSize = 4U;
+    length        = Dwarf_Get(&header, 4U);
+
+    if(length == 0xFFFFFFFFULL)
+    {
+      unit->OffSize = 8U;
+      length        = Dwarf_Get(&header, 8U);
+    }
+
+    unit->end    = (uint64)(header.p - dwarf->info) + length;
+    header.end   = dwarf->info + unit->end;
+    cursor.p     = header.end;
+    unit->version = (uint16)Dwarf_Get(&header, 2U);
+
+    if(unit->version >= 5U)
+    {
+      unit->UnitType     = (uint8)Dwarf_Get(&header, 1U);
+      unit->AddrSize     = (uint8)Dwarf_Get(&header, 1U);
+      unit->AbbrevOffset = Dwarf_Get(&header, unit->OffSize);
+
+      if(unit->UnitType == DW_UT_skeleton || unit->UnitType == DW_UT_split_compile)
+      {
+        Dwarf_Skip(&header, 8U);
+      }
+      else if(unit->UnitType == DW_UT_type || unit->UnitType == DW_UT_split_type)
+      {
+        Dwarf_Skip(&header, 8U + (uint64)unit->OffSize);
+      }
+    }
+    else
+    {
+      unit->UnitType     = DW_UT_compile;
+      unit->AbbrevOffset = Dwarf_Get(&header, unit->OffSize);
+      unit->AddrSize     = (uint8)Dwarf_Get(&header, 1U);
+    }
+
+    unit->dies = (uint64)(header.p - dwarf->info);
+
+    /* the units of an unknown version or with a bad header are not indexed, their DIEs are not found */
+    if(!header.error && unit->version >= 2U && unit->version <= 5U && unit->AbbrevOffset < dwarf->AbbrevSize &&
+       (unit->AddrSize == 2U || unit->AddrSize == 4U || unit->AddrSize == 8U))
+    {
+      dwarf->UnitsNbr++;
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Close
+** Description: release the units and abbreviation tables
+** Parameter:   sDwarf* dwarf
+** Return:      void
+*******************************************************************************************************************/
+void Dwarf_Close(sDwarf* dwarf)
+{
+  Arena_Release(&dwarf->arena);
+  memset(dwarf, 0, sizeof(sDwarf));
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_FindUnit
+** Description: find the unit holding a DIE offset (binary search, the units are in section order)
+** Parameter:   sDwarf* dwarf, uint64 offset
+** Return:      sDwarfUnit* (NULL if none)
+*******************************************************************************************************************/
+static sDwarfUnit* Dwarf_FindUnit(sDwarf* dwarf, uint64 offset)
+{
+  uint32 low  = 0;
+  uint32 high = dwarf->UnitsNbr;
+
+  while(low < high)
+  {
+    uint32 mid = low + (high - low) / 2U;
+
+    if(dwarf->units[mid].offset <= offset)
+    {
+      low = mid + 1U;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  if(low > 0 && offset >= dwarf->units[low - 1U].dies && offset < dwarf->units[low - 1U].end)
+  {
+    return(&dwarf->units[low - 1U]);
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_LoadUnit
+** Description: read the abbreviation table of a unit and the string offsets base of its unit DIE
+** Parameter:   sDwarf* dwarf, sDwarfUnit* unit
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Dwarf_LoadUnit(sDwarf* dwarf, sDwarfUnit* unit)
+{
+  sDwarfCursor start  = {dwarf->abbrev + unit->AbbrevOffset, dwarf->abbrev + dwarf->AbbrevSize, dwarf->msb, FALSE};
+  sDwarfCursor cursor = start;
+  uint64       codes  = 0;
+  uint64       MaxCode = 0;
+  sDwarfDie    root;
+
+  /* first pass: size of the table */
+  for(;;)
+  {
+    uint64 code = Dwarf_ULeb(&cursor);
+    uint64 name = 1;
+    uint64 form = 1;
+
+    if(code == 0 || cursor.error)
+    {
+      break;
+    }
+
+    (void)Dwarf_ULeb(&cursor);
+    Dwarf_Skip(&cursor, 1U);
+
+    while((name != 0 || form != 0) && !cursor.error)
+    {
+      name = Dwarf_ULeb(&cursor);
+      form = Dwarf_ULeb(&cursor);
+
+      if(form == DW_FORM_implicit_const)
+      {
+        (void)Dwarf_SLeb(&cursor);
+      }
+    }
+
+    codes++;
+    MaxCode = (code > MaxCode) ? code : MaxCode;
+  }
+
+  unit->loaded = TRUE;
+
+  if(cursor.error || MaxCode >= DWARF_MAX_ABBREV_CODE)
+  {
+    return(FALSE);
+  }
+
+  unit->AbbrevsNbr = (uint32)MaxCode + 1U;
+  unit->abbrevs    = (sDwarfAbbrev*)Arena_Calloc(&dwarf->arena, unit->AbbrevsNbr, sizeof(sDwarfAbbrev));
+
+  if(unit->abbrevs == NULL)
+  {
+    unit->AbbrevsNbr = 0;
+    return(FALSE);
+  }
+
+  /* second pass: the entries, by code */
+  cursor = start;
+
+  for(uint64 i = 0; i < codes; i++)
+  {
+    uint64        code   = Dwarf_ULeb(&cursor);
+    sDwarfAbbrev* abbrev = &unit->abbrevs[code];
+    uint64        name   = 1;
+    uint64        form   = 1;
+
+    abbrev->tag      = (uint32)Dwarf_ULeb(&cursor);
+    abbrev->children = (boolean)(Dwarf_Get(&cursor, 1U) != 0);
+    abbrev->specs    = cursor.p;
+
+    while(name != 0 || form != 0)
+    {
+      name = Dwarf_ULeb(&cursor);
+      form = Dwarf_ULeb(&cursor);
+
+      if(form == DW_FORM_implicit_const)
+      {
+        (void)Dwarf_SLeb(&cursor);
+      }
+    }
+  }
+
+  /* the unit DIE gives the base of the string offsets (DWARF 5), read before any other DIE of the unit */
+  unit->StrOffsetsBase = (unit->version >= 5U) ? 2U * (uint64)unit->OffSize : 0U;
+  return(Dwarf_ReadDie(dwarf, unit->dies, &root));
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_ReadValue
+** Description: read an attribute value by its form
+** Parameter:   sDwarfCursor* cursor, const sDwarfUnit* unit, uint32 form, sint64 implicit, sDwarfValue* value
+** Return:      boolean (FALSE for an unknown form: the rest of the DIE cannot be read)
+*******************************************************************************************************************/
+static boolean Dwarf_ReadValue(sDwarfCursor* cursor, const sDwarfUnit* unit, uint32 form, sint64 implicit,
+                               sDwarfValue* value)
+{
+  uint64 length = 0;
+
+  value->kind  = DWARF_VAL_CONST;
+  value->form  = form;
+  value->value = 0;
+  value->block = NULL;
+
+  switch(form)
+  {
+    case DW_FORM_addr:           value->value = Dwarf_Get(cursor, unit->AddrSize);                         break;
+    case DW_FORM_data1:
+    case DW_FORM_flag:           value->value = Dwarf_Get(cursor, 1U);                                     break;
+    case DW_FORM_data2:          value->value = Dwarf_Get(cursor, 2U);                                     break;
+    case DW_FORM_data4:          value->value = Dwarf_Get(cursor, 4U);                                     break;
+    case DW_FORM_data8:          value->value = Dwarf_Get(cursor, 8U);                                     break;
+    case DW_FORM_udata:          value->value = Dwarf_ULeb(cursor);                                        break;
+    case DW_FORM_flag_present:   value->value = 1U;                                                        break;
+    case DW_FORM_sdata:          value->kind  = DWARF_VAL_SCONST;
+                                 value->value = (uint64)Dwarf_SLeb(cursor);                                break;
+    case DW_FORM_implicit_const: value->kind  = DWARF_VAL_SCONST;
+                                 value->value = (uint64)implicit;                                          break;
+    case DW_FORM_ref1:           value->kind  = DWARF_VAL_REF;
+                                 value->value = unit->offset + Dwarf_Get(cursor, 1U);                      break;
+    case DW_FORM_ref2:           value->kind  = DWARF_VAL_REF;
+                                 value->value = unit->offset + Dwarf_Get(cursor, 2U);                      break;
+    case DW_FORM_ref4:           value->kind  = DWARF_VAL_REF;
+                                 value->value = unit->offset + Dwarf_Get(cursor, 4U);                      break;
+    case DW_FORM_ref8:           value->kind  = DWARF_VAL_REF;
+                                 value->value = unit->offset + Dwarf_Get(cursor, 8U);                      break;
+    case DW_FORM_ref_udata:      value->kind  = DWARF_VAL_REF;
+                                 value->value = unit->offset + Dwarf_ULeb(cursor);                         break;
+    case DW_FORM_ref_addr:       value->kind  = DWARF_VAL_REF;
+                                 value->value = Dwarf_Get(cursor, (unit->version <= 2U) ? unit->AddrSize :
+                                                                                          unit->OffSize);  break;
+    case DW_FORM_strp:
+    case DW_FORM_line_strp:
+    case DW_FORM_sec_offset:     value->kind  = (form == DW_FORM_sec_offset) ? DWARF_VAL_OFFSET : DWARF_VAL_STRING;
+                                 value->value = Dwarf_Get(cursor, unit->OffSize);                          break;
+    case DW_FORM_strx:
+    case DW_FORM_GNU_str_index:  value->kind  = DWARF_VAL_STRX;
+                                 value->value = Dwarf_ULeb(cursor);                                        break;
+    case DW_FORM_strx1:          value->kind  = DWARF_VAL_STRX;
+                                 value->value = Dwarf_Get(cursor, 1U);                                     break;
+    case DW_FORM_strx2:          value->kind  = DWARF_VAL_STRX;
+                                 value->value = Dwarf_Get(cursor, 2U);                                     break;
+    case DW_FORM_strx3:          value->kind  = DWARF_VAL_STRX;
+                                 value->value = Dwarf_Get(cursor, 3U);                                     break;
+    case DW_FORM_strx4:          value->kind  = DWARF_VAL_STRX;
+                                 value->value = Dwarf_Get(cursor, 4U);                                     break;
+    case DW_FORM_string:
+    {
+      const uint8* nul = (const uint8*)memchr(cursor->p, '\0', (size_t)(cursor->end - cursor->p));
+
+      if(nul == NULL)
+      {
+        cursor->error = TRUE;
+      }
+      else
+      {
+        value->kind  = DWARF_VAL_STRING;
+        value->block = cursor->p;
+        cursor->p    = nul + 1;
+      }
+      break;
+    }
+    case DW_FORM_block1:         length = Dwarf_Get(cursor, 1U);                                           break;
+    case DW_FORM_block2:         length = Dwarf_Get(cursor, 2U);                                           break;
+    case DW_FORM_block4:         length = Dwarf_Get(cursor, 4U);                                           break;
+    case DW_FORM_block:
+    case DW_FORM_exprloc:        length = Dwarf_ULeb(cursor);                                              break;
+
+    /* values which are not followed (type units, split DWARF, supplementary files) */
+    case DW_FORM_ref_sig8:
+    case DW_FORM_data16:         value->kind = DWARF_VAL_NONE;
+                                 Dwarf_Skip(cursor, (form == DW_FORM_data16) ? 16U : 8U);                  break;
+    case DW_FORM_ref_sup4:       value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 4U);                    break;
+    case DW_FORM_ref_sup8:       value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 8U);                    break;
+    case DW_FORM_strp_sup:
+    case DW_FORM_GNU_ref_alt:
+    case DW_FORM_GNU_strp_alt:   value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, unit->OffSize);         break;
+    case DW_FORM_addrx:
+    case DW_FORM_loclistx:
+    case DW_FORM_rnglistx:
+    case DW_FORM_GNU_addr_index: value->kind = DWARF_VAL_NONE; (void)Dwarf_ULeb(cursor);                  break;
+    case DW_FORM_addrx1:         value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 1U);                    break;
+    case DW_FORM_addrx2:         value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 2U);                    break;
+    case DW_FORM_addrx3:         value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 3U);                    break;
+    case DW_FORM_addrx4:         value->kind = DWARF_VAL_NONE; Dwarf_Skip(cursor, 4U);                    break;
+    default:
+      return(FALSE);
+  }
+
+  if(form == DW_FORM_block1 || form == DW_FORM_block2 || form == DW_FORM_block4 || form == DW_FORM_block ||
+     form == DW_FORM_exprloc)
+  {
+    value->kind  = DWARF_VAL_BLOCK;
+    value->value = length;
+    value->block = cursor->p;
+    Dwarf_Skip(cursor, length);
+  }
+  return((boolean)!cursor->error);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_String
+** Description: string of an attribute value (in place in the file)
+** Parameter:   const sDwarf* dwarf, const sDwarfUnit* unit, const sDwarfValue* value
+** Return:      const char* (NULL if not a valid string)
+*******************************************************************************************************************/
+static const char* Dwarf_String(const sDwarf* dwarf, const sDwarfUnit* unit, const sDwarfValue* value)
+{
+  uint64 offset = value->value;
+
+  if(value->kind == DWARF_VAL_STRX)
+  {
+    uint64       position = unit->StrOffsetsBase + offset * unit->OffSize;
+    sDwarfCursor cursor   = {dwarf->StrOffsets, dwarf->StrOffsets + dwarf->StrOffsetsSize, dwarf->msb, FALSE};
+
+    if(offset >= dwarf->StrOffsetsSize || position >= dwarf->StrOffsetsSize)
+    {
+      return(NULL);
+    }
+
+    cursor.p = dwarf->StrOffsets + position;
+    offset   = Dwarf_Get(&cursor, unit->OffSize);
+    return((!cursor.error && offset < dwarf->StrSize) ? (const char*)&dwarf->str[offset] : NULL);
+  }
+
+  if(value->kind != DWARF_VAL_STRING)
+  {
+    return(NULL);
+  }
+
+  if(value->block != NULL)
+  {
+    return((const char*)value->block);
+  }
+
+  if(value->form == DW_FORM_line_strp)
+  {
+    return((offset < dwarf->LineStrSize) ? (const char*)&dwarf->LineStr[offset] : NULL);
+  }
+  return((offset < dwarf->StrSize) ? (const char*)&dwarf->str[offset] : NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Constant
+** Description: unsigned constant of an attribute value
+** Parameter:   const sDwarfValue* value, uint64* result
+** Return:      boolean (FALSE if the value is not a constant)
+*******************************************************************************************************************/
+static boolean Dwarf_Constant(const sDwarfValue* value, uint64* result)
+{
+  if(value->kind != DWARF_VAL_CONST && value->kind != DWARF_VAL_SCONST)
+  {
+    return(FALSE);
+  }
+
+  *result = value->value;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Bound
+** Description: array bound of an attribute value: the fixed size forms hold unsigned values, except all ones
+**              which older compilers write for an unknown bound (-1)
+** Parameter:   const sDwarfValue* value, sint64* result
+** Return:      boolean (FALSE if the bound is not a constant, e.g. a variable length array)
+*******************************************************************************************************************/
+static boolean Dwarf_Bound(const sDwarfValue* value, sint64* result)
+{
+  uint64 bits = 0;
+
+  switch(value->form)
+  {
+    case DW_FORM_data1: bits = 8U;  break;
+    case DW_FORM_data2: bits = 16U; break;
+    case DW_FORM_data4: bits = 32U; break;
+    default:                        break;
+  }
+
+  if(!Dwarf_Constant(value, (uint64*)result))
+  {
+    return(FALSE);
+  }
+
+  if(bits != 0 && value->value == (1ULL << bits) - 1U)
+  {
+    *result = -1;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_Expression
+** Description: decode the simple location expressions: DW_OP_addr <address> (static variable) and
+**              DW_OP_plus_uconst <offset> (member location of DWARF 2)
+** Parameter:   const sDwarfUnit* unit, const sDwarfValue* value, boolean msb, sDwarfDie* die, uint32 attribute
+** Return:      void
+*******************************************************************************************************************/
+static void Dwarf_Expression(const sDwarfUnit* unit, const sDwarfValue* value, boolean msb, sDwarfDie* die,
+                             uint32 attribute)
+{
+  sDwarfCursor cursor = {value->block, value->block + value->value, msb, FALSE};
+  uint64       op     = 0;
+
+  if(value->value == 0)
+  {
+    return;
+  }
+
+  op = Dwarf_Get(&cursor, 1U);
+
+  if(attribute == DW_AT_location && op == DW_OP_addr)
+  {
+    uint64 address = Dwarf_Get(&cursor, unit->AddrSize);
+
+    if(!cursor.error && cursor.p == cursor.end)
+    {
+      die->address = address;
+      die->has    |= DWARF_HAS_ADDRESS;
+    }
+  }
+  else if(attribute == DW_AT_data_member_location && op == DW_OP_plus_uconst)
+  {
+    uint64 offset = Dwarf_ULeb(&cursor);
+
+    if(!cursor.error)
+    {
+      die->MemberLoc = offset;
+      die->has      |= DWARF_HAS_MEMBER_LOC;
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_ReadDie
+** Description: decode the DIE at a .debug_info offset (the abbreviations of its unit are read on first use)
+** Parameter:   sDwarf* dwarf, uint64 offset, sDwarfDie* die
+** Return:      boolean (FALSE if the offset is not a DIE of an indexed unit or the DIE is corrupt)
+*******************************************************************************************************************/
+boolean Dwarf_ReadDie(sDwarf* dwarf, uint64 offset, sDwarfDie* die)
+{
+  sDwarfUnit*         unit   = Dwarf_FindUnit(dwarf, offset);
+  sDwarfCursor        cursor;
+  sDwarfCursor        specs;
+  const sDwarfAbbrev* abbrev = NULL;
+  sDwarfValue         name;
+  uint64              code   = 0;
+
+  memset(die, 0, sizeof(sDwarfDie));
+  die->offset        = offset;
+  die->type          = DWARF_NONE;
+  die->specification = DWARF_NONE;
+  die->sibling       = DWARF_NONE;
+  memset(&name, 0, sizeof(sDwarfValue));
+  name.kind          = DWARF_VAL_NONE;
+
+  if(unit == NULL || (!unit->loaded && !Dwarf_LoadUnit(dwarf, unit)) || unit->abbrevs == NULL)
+  {
+    return(FALSE);
+  }
+
+  die->unit    = unit;
+  cursor.p     = dwarf->info + offset;
+  cursor.end   = dwarf->info + unit->end;
+  cursor.msb   = dwarf->msb;
+  cursor.error = FALSE;
+  code         = Dwarf_ULeb(&cursor);
+
+  if(cursor.error || code >= unit->AbbrevsNbr || (code != 0 && unit->abbrevs[code].specs == NULL))
+  {
+    return(FALSE);
+  }
+
+  if(code != 0)
+  {
+    abbrev         = &unit->abbrevs[code];
+    die->tag       = abbrev->tag;
+    die->children  = abbrev->children;
+    specs.p        = abbrev->specs;
+    specs.end      = dwarf->abbrev + dwarf->AbbrevSize;
+    specs.msb      = dwarf->msb;
+    specs.error    = FALSE;
+
+    for(;;)
+    {
+      uint32      attribute = (uint32)Dwarf_ULeb(&specs);
+      uint32      form      = (uint32)Dwarf_ULeb(&specs);
+      sint64      implicit  = (form == DW_FORM_implicit_const) ? Dwarf_SLeb(&specs) : 0;
+      sDwarfValue value;
+
+      if(attribute == 0 && form == 0)
+      {
+        break;
+      }
+
+      /* DW_FORM_indirect: the form is given with the value */
+      while(form == DW_FORM_indirect && !cursor.error)
+      {
+        form = (uint32)Dwarf_ULeb(&cursor);
+      }
+
+      if(specs.error || !Dwarf_ReadValue(&cursor, unit, form, implicit, &value))
+      {
+        return(FALSE);
+      }
+
+      switch(attribute)
+      {
+        case DW_AT_name:
+          name = value;
+          break;
+        case DW_AT_type:
+          die->type = (value.kind == DWARF_VAL_REF) ? value.value : DWARF_NONE;
+          break;
+        case DW_AT_sibling:
+          die->sibling = (value.kind == DWARF_VAL_REF) ? value.value : DWARF_NONE;
+          break;
+        case DW_AT_specification:
+        case DW_AT_abstract_origin:
+          die->specification = (value.kind == DWARF_VAL_REF) ? value.value : DWARF_NONE;
+          break;
+        case DW_AT_byte_size:
+          die->has |= Dwarf_Constant(&value, &die->ByteSize) ? DWARF_HAS_BYTE_SIZE : 0U;
+          break;
+        case DW_AT_encoding:
+          die->encoding = (uint32)value.value;
+          die->has     |= DWARF_HAS_ENCODING;
+          break;
+        case DW_AT_upper_bound:
+          die->has |= Dwarf_Bound(&value, &die->UpperBound) ? DWARF_HAS_UPPER_BOUND : 0U;
+          break;
+        case DW_AT_lower_bound:
+          die->has |= Dwarf_Bound(&value, &die->LowerBound) ? DWARF_HAS_LOWER_BOUND : 0U;
+          break;
+        case DW_AT_count:
+          die->has |= Dwarf_Constant(&value, &die->count) ? DWARF_HAS_COUNT : 0U;
+          break;
+        case DW_AT_data_member_location:
+          if(value.kind == DWARF_VAL_BLOCK)
+          {
+            Dwarf_Expression(unit, &value, dwarf->msb, die, attribute);
+          }
+          else
+          {
+            die->has |= Dwarf_Constant(&value, &die->MemberLoc) ? DWARF_HAS_MEMBER_LOC : 0U;
+          }
+          break;
+        case DW_AT_bit_size:
+          die->has |= Dwarf_Constant(&value, &die->BitSize) ? DWARF_HAS_BIT_SIZE : 0U;
+          break;
+        case DW_AT_bit_offset:
+          die->has |= Dwarf_Constant(&value, &die->BitOffset) ? DWARF_HAS_BIT_OFFSET : 0U;
+          break;
+        case DW_AT_data_bit_offset:
+          die->has |= Dwarf_Constant(&value, &die->DataBitOffset) ? DWARF_HAS_DATA_BIT_OFF : 0U;
+          break;
+        case DW_AT_declaration:
+          die->has |= (value.value != 0) ? DWARF_HAS_DECLARATION : 0U;
+          break;
+        case DW_AT_location:
+          die->has |= DWARF_HAS_LOCATION;
+          if(value.kind == DWARF_VAL_BLOCK)
+          {
+            Dwarf_Expression(unit, &value, dwarf->msb, die, attribute);
+          }
+          break;
+        case DW_AT_str_offsets_base:
+          if(offset == unit->dies)
+          {
+            unit->StrOffsetsBase = value.value;
+          }
+          break;
+        default:
+          break;
+      }
+    }
+
+    if(name.kind != DWARF_VAL_NONE)
+    {
+      die->name = Dwarf_String(dwarf, unit, &name);
+    }
+  }
+
+  die->next = (uint64)(cursor.p - dwarf->info);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Dwarf_NextSibling
+** Description: offset of the next sibling of a DIE: DW_AT_sibling when given, otherwise the children are skipped
+** Parameter:   sDwarf* dwarf, const sDwarfDie* die, uint64* next
+** Return:      boolean (FALSE if the DIE tree is corrupt)
+*******************************************************************************************************************/
+boolean Dwarf_NextSibling(sDwarf* dwarf, const sDwarfDie* die, uint64* next)
+{
+  uint64 offset = die->next;
+  uint32 depth  = 1U;
+
+  if(!die->children || die->tag == 0)
+  {
+    *next = die->next;
+    return(TRUE);
+  }
+
+  /* a forward sibling in the unit (a backward one would loop) */
+  if(die->sibling != DWARF_NONE && die->sibling > die->offset && die->sibling < die->unit->end)
+  {
+    *next = die->sibling;
+    return(TRUE);
+  }
+
+  while(depth > 0)
+  {
+    sDwarfDie child;
+
+    if(!Dwarf_ReadDie(dwarf, offset, &child))
+    {
+      return(FALSE);
+    }
+
+    if(child.tag == 0)
+    {
+      depth--;
+      offset = child.next;
+    }
+    else if(child.children && child.sibling != DWARF_NONE && child.sibling > child.offset &&
+            child.sibling < die->unit->end)
+    {
+      offset = child.sibling;
+    }
+    else
+    {
+      depth  += child.children ? 1U : 0U;
+      offset  = child.next;
+    }
+  }
+
+  *next = offset;
+  return(TRUE);
+}
@@ -0,0 +1,137 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __DWARF_H__
+#define __DWARF_H__
+
+#include<common.h>
+#include<Arena.h>
+#include<Elf.h>
+
+#define DWARF_NONE              0xFFFFFFFFFFFFFFFFULL   //no DIE (offsets are .debug_info offsets)
+
+//tags
+#define DW_TAG_array_type        0x01U
+#define DW_TAG_class_type        0x02U
+#define DW_TAG_enumeration_type  0x04U
+#define DW_TAG_member            0x0DU
+#define DW_TAG_pointer_type      0x0FU
+#define DW_TAG_reference_type    0x10U
+#define DW_TAG_compile_unit      0x11U
+#define DW_TAG_structure_type    0x13U
+#define DW_TAG_typedef           0x16U
+#define DW_TAG_union_type        0x17U
+#define DW_TAG_subrange_type     0x21U
+#define DW_TAG_base_type         0x24U
+#define DW_TAG_const_type        0x26U
+#define DW_TAG_variable          0x34U
+#define DW_TAG_volatile_type     0x35U
+#define DW_TAG_restrict_type     0x37U
+#define DW_TAG_namespace         0x39U
+#define DW_TAG_partial_unit      0x3CU
+#define DW_TAG_rvalue_reference_type 0x42U
+#define DW_TAG_atomic_type       0x47U
+
+//base type encodings
+#define DW_ATE_address           0x01U
+#define DW_ATE_boolean           0x02U
+#define DW_ATE_float             0x04U
+#define DW_ATE_signed            0x05U
+#define DW_ATE_signed_char       0x06U
+#define DW_ATE_unsigned          0x07U
+#define DW_ATE_unsigned_char     0x08U
+#define DW_ATE_UTF               0x10U
+
+//attributes of a DIE kept by Dwarf_ReadDie (see sDwarfDie.has)
+#define DWARF_HAS_BYTE_SIZE      0x0001U
+#define DWARF_HAS_ENCODING       0x0002U
+#define DWARF_HAS_UPPER_BOUND    0x0004U
+#define DWARF_HAS_LOWER_BOUND    0x0008U
+#define DWARF_HAS_COUNT          0x0010U
+#define DWARF_HAS_MEMBER_LOC     0x0020U
+#define DWARF_HAS_BIT_SIZE       0x0040U
+#define DWARF_HAS_BIT_OFFSET     0x0080U
+#define DWARF_HAS_DATA_BIT_OFF   0x0100U
+#define DWARF_HAS_ADDRESS        0x0200U  //DW_AT_location is a single DW_OP_addr
+#define DWARF_HAS_DECLARATION    0x0400U
+#define DWARF_HAS_LOCATION       0x0800U
+
+//abbreviation of a unit: the attribute specifications stay in .debug_abbrev and are read with the DIE
+typedef struct
+{
+  uint32       tag;
+  boolean      children;
+  const uint8* specs;                 //(name, form[, implicit_const]) pairs
+}sDwarfAbbrev;
+
+//one unit of .debug_info, indexed by its header only: its abbreviations are read on its first DIE
+typedef struct
+{
+  uint64        offset;               //unit header
+  uint64        end;
+  uint64        dies;                 //first DIE (the unit DIE)
+  uint64        AbbrevOffset;
+  uint16        version;
+  uint8         AddrSize;
+  uint8         OffSize;              //4 (32-bit DWARF) or 8 (64-bit DWARF)
+  uint8         UnitType;
+  boolean       loaded;
+  sDwarfAbbrev* abbrevs;              //by code (NULL entry: unused code)
+  uint32        AbbrevsNbr;
+  uint64        StrOffsetsBase;       //DW_AT_str_offsets_base of the unit DIE (DWARF 5)
+}sDwarfUnit;
+
+//decoded DIE: the attributes used by the type and variable readers, host order
+typedef struct
+{
+  uint64      offset;
+  uint64      next;                   //first child (children) or next sibling (no children)
+  uint64      sibling;                //DW_AT_sibling (DWARF_NONE if absent)
+  uint32      tag;                    //0: end of a sibling chain
+  boolean     children;
+  sDwarfUnit* unit;
+  const char* name;                   //NULL if absent
+  uint64      type;                   //DW_AT_type (DWARF_NONE if absent)
+  uint64      specification;          //DW_AT_specification or DW_AT_abstract_origin (DWARF_NONE if absent)
+  uint32      has;                    //DWARF_HAS_xxx
+  uint32      encoding;
+  uint64      ByteSize;
+  sint64      UpperBound;
+  sint64      LowerBound;
+  uint64      count;
+  uint64      MemberLoc;              //DW_AT_data_member_location (constant)
+  uint64      BitSize;
+  uint64      BitOffset;              //DW_AT_bit_offset (DWARF 2-3, from the most significant bit)
+  uint64      DataBitOffset;          //DW_AT_data_bit_offset (DWARF 4-5)
+  uint64      address;                //DW_OP_addr of DW_AT_location
+}sDwarfDie;
+
+//debug information of an image
+typedef struct
+{
+  const uint8*  info;
+  uint64        InfoSize;
+  const uint8*  abbrev;
+  uint64        AbbrevSize;
+  const uint8*  str;
+  uint64        StrSize;              //up to the last terminated string
+  const uint8*  LineStr;
+  uint64        LineStrSize;
+  const uint8*  StrOffsets;
+  uint64        StrOffsetsSize;
+  boolean       msb;                  //big endian
+  sDwarfUnit*   units;
+  uint32        UnitsNbr;
+  sArena        arena;                //units and abbreviation tables
+}sDwarf;
+
+boolean Dwarf_Open(sDwarf* dwarf, sElf* elf);
+void    Dwarf_Close(sDwarf* dwarf);
+boolean Dwarf_ReadDie(sDwarf* dwarf, uint64 offset, sDwarfDie* die);
+boolean Dwarf_NextSibling(sDwarf* dwarf, const sDwarfDie* die, uint64* next);
+
+#endif
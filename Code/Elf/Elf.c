@@ -1,859 +1,1572 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#include<Elf.h>
-
-Elf32_Ehdr* pElfHeader     = NULL;
-Elf32_Shdr* pSectionHeader = NULL;
-Elf32_Sym*  pSymTable      = NULL;
-
-char* pSectionName = NULL;
-
-
-const sSymTabBind SymTabBind[] = {
-                                    {STB_LOCAL  , "LOCAL" },
-                                    {STB_GLOBAL , "GLOBAL"},
-                                    {STB_WEAK   , "WEAK"  },
-                                    {STB_NUM    , ""      },
-                                    {STB_LOOS   , ""      },
-                                    {STB_LOPROC , ""      },
-                                    {STB_HIPROC , ""      }
-                                 };
-
-#define SYM_TABLE_BIND_SIZE   (uint32)(sizeof(SymTabBind)/sizeof(sSymTabBind))
-
-
-const sSymTabType SymTabType[] = {
-                                    {STT_NOTYPE    , "UNSPECIFIED"},
-                                    {STT_OBJECT    , "OBJECT"     },
-                                    {STT_FUNC      , "FUNCTION"   },
-                                    {STT_SECTIONS  , "SECTION"    },
-                                    {STT_FILE      , "FILE"       },
-                                    {STT_COMMON    , "COMMON"     },
-                                    {STT_TLS       , ""           },
-                                    {STT_NUM       , ""           },
-                                    {STT_LOOS      , ""           },
-                                    {STT_HIOS      , ""           },
-                                    {STT_LOPROC    , ""           },
-                                    {STT_HIPROC    , ""           }
-                                 };
-
-#define SYM_TABLE_TYPE_SIZE   (uint32)(sizeof(SymTabType)/sizeof(sSymTabBind))
-
-const sElfType ElfType[] = {
-                              {TYP_UNKNOWN_ELF     , "Unknown ELF file type"},
-                              {TYP_RELOCATABLE_ELF , "Relocatable ELF"      },
-                              {TYP_EXECUTABLE_ELF  , "Executable ELF"       }
-                           };
-
-#define ELF_TYPE_TABLE_SIZE   (uint32)(sizeof(ElfType)/sizeof(sElfType))
-
-const sMachine targetMachine[] = {
-                                   {EM_NONE      ,"Invalid machine"               },
-                                   {EM_SPARC     ,"Sun SPARC"                     },
-                                   {EM_386       ,"Intel 80386"                   },
-                                   {EM_68K       ,"Freescale 68000"               },
-                                   {EM_486       ,"Intel 80486"                   },
-                                   {EM_MIPS      ,"MIPS"                          },
-                                   {EM_960       ,"Intel i960"                    },
-                                   {EM_PPC       ,"Power Architecture"            },
-                                   {EM_PPC64     ,"Power Architecture 64-bit mode"},
-                                   {EM_V800      ,"Renesas V800 series"           },
-                                   {EM_FR20      ,"Fujitsu FR"                    },
-                                   {EM_MCORE     ,"Freescale MCore"               },
-                                   {EM_ARM       ,"ARM"                           },
-                                   {EM_SH        ,"Hitachi SH"                    },
-                                   {EM_TRICORE   ,"Infineon TriCore"              },
-                                   {EM_COLDFIRE  ,"Freescale ColdFire"            },
-                                   {EM_STARCORE  ,"Freescale StarCore"            },
-                                   {EM_FIREPATH  ,"Broadcom FirePath"             },
-                                   {EM_M32R      ,"Renesas M32R"                  },
-                                   {EM_BLACKFIN  ,"ADI Blackfin"                  }
-                                 };
-
-#define TARGET_MACHINE_TABLE_SIZE  ((sizeof(targetMachine))/(sizeof(sMachine)))
-
-const sSectionType SectionTypeTable[] = {
-                                           {SHT_NULL     , "NULL"    },
-                                           {SHT_PROGBITS , "PROGBITS"},
-                                           {SHT_SYMTAB   , "SYMTAB"  },
-                                           {SHT_STRTAB   , "STRTAB"  },
-                                           {SHT_RELA     , "RELA"    },
-                                           {SHT_NOTE     , "NOTE"    },
-                                           {SHT_NOBITS   , "NOBITS"  },
-                                           {SHT_REL      , "REL"     }
-                                        };
-
-#define SECTION_TYPE_TABLE_SIZE  ((sizeof(SectionTypeTable))/(sizeof(sSectionType)))
-
-const sSectionAttr SectionAttrTable[] = {
-                                          {SHF_WRITE , 'W'},
-                                          {SHF_ALLOC , 'A'},
-                                          {SHF_EXECU  ,'X'}
-                                        };
-
-#define SECTION_ATTR_TABLE_SIZE  ((sizeof(SectionAttrTable))/(sizeof(sSectionAttr)))
-
-static char* Elf_GetSymTabBindStr(Elf32_Byte bind);
-static char* Elf_GetSymTabTypeStr(Elf32_Byte type);
-static char* Elf_GetMachineNameStr(Elf32_Half machine);
-static char* Elf_GetElfTypeStr(Elf32_Half type);
-static char* Elf_GetSectionNameStr(Elf32_Word type);
-static char* Elf_GetSectionAttrStr(Elf32_Word type);
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_ProcessElfHeader(char* Buffer, boolean PrintInfo)
-{
-
-  if(Buffer != NULL)
-  {
-    pElfHeader = (Elf32_Ehdr*)Buffer;
-
-    if( pElfHeader->e_ident[0] == 0x7F &&
-        pElfHeader->e_ident[1] == 'E'  &&
-        pElfHeader->e_ident[2] == 'L'  &&
-        pElfHeader->e_ident[3] == 'F'  
-      )
-    {
-      if(PrintInfo)
-      {
-        printf("\nELF File Header :\n\n");
-
-        if(pElfHeader->e_ident[4] == ELFCLASS32)
-        {
-          printf("Class      = 32 bit\n");
-        }
-        else if(pElfHeader->e_ident[4] == ELFCLASS64)
-        {
-          printf("Class      = 64 bit\n");
-        }
-        else
-        {
-            printf("Class      = unknown class \n");
-        }
-
-        if(pElfHeader->e_ident[5] == ELFDATA2LSB)
-        {
-          printf("Endianness = little endian \n");
-        }
-        else if(pElfHeader->e_ident[5] == ELFDATA2MSB)
-        {
-          printf("Endianness = big endian \n");
-        }
-        else
-        {
-            printf("Endianness = unknown endian \n");
-        }
-
-        //display the ELF header
-        printf("Type       = 0x%x (%s)\n", pElfHeader->e_type, Elf_GetElfTypeStr(pElfHeader->e_type));
-        printf("Machine    = 0x%x (%s)\n", pElfHeader->e_machine, Elf_GetMachineNameStr(pElfHeader->e_machine));
-        printf("Version    = 0x%x     \n", pElfHeader->e_version   );
-        printf("Entry      = 0x%x     \n", pElfHeader->e_entry     );
-        printf("Phoff      = 0x%x     \n", pElfHeader->e_phoff     );
-        printf("Shoff      = 0x%x     \n", pElfHeader->e_shoff     );
-        printf("Flags      = 0x%x     \n", pElfHeader->e_flags     );
-        printf("Ehsize     = %d       \n", pElfHeader->e_ehsize    );
-        printf("Phentsize  = %d       \n", pElfHeader->e_phentsize );
-        printf("Phnum      = %d       \n", pElfHeader->e_phnum     );
-        printf("Shentsize  = %d       \n", pElfHeader->e_shentsize );
-        printf("Shnum      = %d       \n", pElfHeader->e_shnum     );
-        printf("Shstrndx   = %d       \n", pElfHeader->e_shstrndx  );
-      }
-
-      return(TRUE);
-
-    }
-    else
-    {
-      printf("This is not a valid ELF file [KO]\n");
-      return(FALSE);
-    }
-  }
-  else
-  {
-    return(FALSE);
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_SectionHeaderTable(char* Buffer)
-{
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-    
-  // section string table pointer
-  pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[pElfHeader->e_shstrndx])->sh_offset));
-
-  printf("\nSECTIONS TABLE : \n");
-  printf("\n%-10s%-20s%-20s%-20s%-22s%-22s%-22s\n","ID", "Section", "Type", "Flags", "Addr", "Offset", "Size");
-
-
-  for(uint32 i = 0; i < pElfHeader->e_shnum ; i++)
-  {
-    printf("%-1s%-2d%-7s%-20s%-20s%-20s0x%-20x0x%-20x0x%-20x\n",
-            "[",
-            i, 
-            "]",
-            &pSectionName[(&pSectionHeader[i])->sh_name], 
-            Elf_GetSectionNameStr((&pSectionHeader[i])->sh_type),
-            Elf_GetSectionAttrStr((&pSectionHeader[i])->sh_flags),
-            (&pSectionHeader[i])->sh_addr,
-            (&pSectionHeader[i])->sh_offset,
-            (&pSectionHeader[i])->sh_size
-          );
-  }
-  return(TRUE);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_SymbolTable(char* Buffer)
-{
-  uint32 SymTabSize = 0;
-
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-    
-  /* search for the symbol table index */
-  for(uint32 i=0; i < pElfHeader->e_shnum; i++)
-  {
-    if((&pSectionHeader[i])->sh_type == SHT_SYMTAB)
-    {
-      pSymTable  = (Elf32_Sym*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-      SymTabSize = (uint32)(((&pSectionHeader[i])->sh_size) / sizeof(Elf32_Sym));
-      break;
-    }
-  }
-
-  /* search for the symbol table (string name table) */
-  for(uint32 i=0; i < pElfHeader->e_shnum; i++)
-  {
-    if((&pSectionHeader[i])->sh_type == SHT_STRTAB && (i != pElfHeader->e_shstrndx))
-    {
-      // pointer to the table which contains the symbol names strings
-      pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-      break;
-    }
-  }
-
-  printf("\nSYMBOL TABLE : \n");
-  printf("\n%-17s%-17s%-15s%-15s%-15s\n\n","Value", "Size", "Bind", "Type", "Name");
-
-  /* Display the symbol table */
-  for(uint32 i=0; i< SymTabSize ;i++)
-  {
-    if(STT_OBJECT == ELF32_ST_TYPE((&pSymTable[i])->st_info) || STT_FUNC == ELF32_ST_TYPE((&pSymTable[i])->st_info))
-    {
-      printf("0x%-15x0x%-15x%-15s%-15s%-15s\n",
-              (&pSymTable[i])->st_value,
-              (&pSymTable[i])->st_size,
-              Elf_GetSymTabBindStr(ELF32_ST_BIND((&pSymTable[i])->st_info)),
-              Elf_GetSymTabTypeStr(ELF32_ST_TYPE((&pSymTable[i])->st_info)),
-              &pSectionName[(&pSymTable[i])->st_name]
-            );
-    }
-  }
-
-  return(TRUE);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetSymTabBindStr(Elf32_Byte bind)
-{
-  for(uint32 i=0; i < SYM_TABLE_BIND_SIZE; i++)
-  {
-    if(SymTabBind[i].code == bind)
-    {
-      return((char*)(SymTabBind[i].name));
-    }
-  }
-  return(NULL);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetSymTabTypeStr(Elf32_Byte type)
-{
-  for(uint32 i=0; i < SYM_TABLE_TYPE_SIZE; i++)
-  {
-    if(SymTabType[i].code == type)
-    {
-      return((char*)(SymTabType[i].name));
-    }
-  }
-  return(NULL);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetMachineNameStr(Elf32_Half machine)
-{
-  for(uint32 i = 0; i < TARGET_MACHINE_TABLE_SIZE; i++)
-  {
-    if(machine == targetMachine[i].machine)
-    {
-      return((char*)(targetMachine[i].name));
-    }
-  }
-  return(NULL);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetElfTypeStr(Elf32_Half type)
-{
-  for(uint32 i = 0; i < ELF_TYPE_TABLE_SIZE; i++)
-  {
-    if(type == ElfType[i].code)
-    {
-      return((char*)(ElfType[i].name));
-    }
-  }
-  return(NULL);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetSectionNameStr(Elf32_Word type)
-{
-  for(uint32 i = 0; i < SECTION_TYPE_TABLE_SIZE; i++)
-  {
-    if(type == SectionTypeTable[i].type)
-    {
-      return((char*)(SectionTypeTable[i].name));
-    }
-  }
-  return(NULL);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static char* Elf_GetSectionAttrStr(Elf32_Word type)
-{
-  static char attr[4] = {' ',' ',' ','\0'};
-
-  for(uint32 i=0; i < SECTION_ATTR_TABLE_SIZE; i++)
-  {
-
-    if((type & SectionAttrTable[i].code) == SectionAttrTable[i].code)
-    {
-      attr[i] = SectionAttrTable[i].name;
-    }
-    else
-    {
-      attr[i] = ' ';
-    }
-  }
-
-  return(attr);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_ExtractBinaryToC(char* Buffer, char* path)
-{
-  uint8* OffAdd = NULL;
-  uint32 size   = 0;
-
-  if(Buffer == NULL || path == NULL)
-  {
-    return(FALSE);
-  }
-
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-
-  // section string table pointer
-  pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[pElfHeader->e_shstrndx])->sh_offset));
-
-  // open file
-  FILE* file = fopen(path, "wb");
-
-  if(file != NULL)
-  {
-    for(uint32 i=0; i < pElfHeader->e_shnum  ;i++)
-    {
-      if(((((&pSectionHeader[i])->sh_flags) & (uint32)SHF_ALLOC) == (uint32)SHF_ALLOC) && 
-           ((&pSectionHeader[i])->sh_type == SHT_PROGBITS) && 
-           ((&pSectionHeader[i])->sh_size > 0)
-        )
-      {
-        OffAdd = (uint8*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-        size   = (&pSectionHeader[i])->sh_size;
-
-        /* print the section content */
-        fprintf(file,"\n const unsigned char _%s[] = {\n\n",&pSectionName[(&pSectionHeader[i])->sh_name + 1 /* to avoid '.' in the section name*/]);
-        for(uint32 cpt = 0; cpt < size; cpt++)
-        {
-          fprintf(file,"0x%02x", OffAdd[cpt]);
-
-          if((cpt > 0) && ((cpt + 1) % 16 == 0))
-          {
-            fprintf(file,"\n");
-          }
-          else if (cpt + 1 != size)
-          {
-            fprintf(file,", ");
-          }
-          else
-          {
-            fprintf(file,"\n");
-          }
-        }
-        fprintf(file,"};\n");
-      }
-    }
-    fclose(file);
-    return(TRUE);
-  }
-  else
-  {
-    return(FALSE);
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_ExtractBinaryToS19(char* Buffer, char* path)
-{
-  
-  uint32 PhyAdd   = 0;
-  uint8* OffAdd   = NULL;
-  uint32 size     = 0;
-  uint32 padding  = 0;
-  uint8  checksum = 0;
-  uint32 count    = 0;
-
-  #define S19_HEADER_RECORD       "S0"
-  #define S19_DATA_RECORD_32BIT   "S3"
-  #define S19_COUNT_RECORD        "S503"
-  #define S19_TERM_RECORD_32BIT   "S705"
-  #define S19_PACKAGE_SIZE        28
-
-  const char version[] = {"ELF_PARSER_BY_CHALANDI_AMINE_2019"};
-
-  if(Buffer == NULL || path == NULL)
-  {
-    return(FALSE);
-  }
-
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-
-  // section string table pointer
-  pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[pElfHeader->e_shstrndx])->sh_offset));
-
-  // open the s19 file in write mode
-  FILE* file = fopen(path, "wb");
-
-  if(file != NULL)
-  {
-    /* prepare the count for the S19 record header */
-    count = 3 + (sizeof(version)/sizeof(char));
-
-    /* calculate the checksum for the S19 record header */
-    for(uint32 i=0; i < (sizeof(version)/sizeof(char)); i++)
-    {
-      checksum += (uint8)version[i];
-    }
-
-    checksum += (uint8)count;
-
-    /* print the S19 header record */
-    fprintf(file, "%s%02X%04X", S19_HEADER_RECORD, (uint8)count, (uint16)0);
-
-    /* print the version in the record */
-      for(uint32 i=0; i < (sizeof(version)/sizeof(char)); i++)
-    {
-      fprintf(file, "%02X", version[i]);
-    }
-
-    /* print the checksum */
-    fprintf(file, "%02X\n", (uint8)~checksum);
-
-    /* check all section in the ELF file */
-    for(uint32 i=0; i < pElfHeader->e_shnum  ;i++)
-    {
-      if(((((&pSectionHeader[i])->sh_flags) & (uint32)SHF_ALLOC) == (uint32)SHF_ALLOC) && 
-           ((&pSectionHeader[i])->sh_type == SHT_PROGBITS) && 
-           ((&pSectionHeader[i])->sh_size > 0)
-        )
-      {
-        PhyAdd = (&pSectionHeader[i])->sh_addr;
-        OffAdd = (uint8*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-        size   = (&pSectionHeader[i])->sh_size;
-        padding= (size % S19_PACKAGE_SIZE);
-
-        /* print the S19 data records */
-        for(uint32 cpt = 0; cpt < ((size / S19_PACKAGE_SIZE) * S19_PACKAGE_SIZE); cpt++)
-        {
-        
-          if(cpt % S19_PACKAGE_SIZE == 0)
-          {
-            /* New Data Record */
-            fprintf(file, "%s%02X%08X", S19_DATA_RECORD_32BIT, (uint8)(S19_PACKAGE_SIZE + 5), (uint32)(PhyAdd + cpt));
-
-            /* Init the checksum */
-            checksum = (uint8)(S19_PACKAGE_SIZE + 5)                  +
-                       (uint8)(((PhyAdd + cpt) & 0xFF000000UL) >> 24) +
-                       (uint8)(((PhyAdd + cpt) & 0x00FF0000UL) >> 16) +
-                       (uint8)(((PhyAdd + cpt) & 0x0000FF00UL) >> 8 ) +
-                       (uint8)(((PhyAdd + cpt) & 0x000000FFUL) >> 0 ) ;
-            count ++;
-          }
-
-          /* Print one byte in the file */
-          fprintf(file, "%02X", OffAdd[cpt]);
-        
-          /* Calculate the checksum */
-          checksum += OffAdd[cpt];
-
-          if(((cpt + 1) % S19_PACKAGE_SIZE == 0))
-          {
-            /* The end of one s19 record, insert the checksum */
-            fprintf(file, "%02X\n", (uint8)~checksum); /* 1's complement */
-          }
-
-        }
-        if(padding > 0) /* data size less than one S19 package */
-        {
-          /* prepare the S19 data record */
-          fprintf(file, "%s%02X%08X", S19_DATA_RECORD_32BIT, (uint16)(padding + 5), (uint32)(PhyAdd + size - padding));
-          checksum =  (uint8)(padding + 5)                                      +
-                      (uint8)(((PhyAdd + size - padding) & 0xFF000000UL) >> 24) +
-                      (uint8)(((PhyAdd + size - padding) & 0x00FF0000UL) >> 16) +
-                      (uint8)(((PhyAdd + size - padding) & 0x0000FF00UL) >> 8 ) +
-                      (uint8)(((PhyAdd + size - padding) & 0x000000FFUL) >> 0);
-           count ++;
-
-          for(uint32 cpt = 0; cpt < padding; cpt++)
-          {
-            fprintf(file, "%02X", OffAdd[size - padding + cpt]);
-            checksum += OffAdd[size - padding + cpt];
-          }
-          fprintf(file, "%02X\n", (uint8)~checksum);
-        }
-      }
-    }
-    /* Prepare the S19 count record */
-    checksum =  (uint8)(0x03)                           +
-                (uint8)(((count) & 0x0000FF00UL) >> 8 ) +
-                (uint8)(((count) & 0x000000FFUL) >> 0);
-    fprintf(file, "%s%04X%02X\n", S19_COUNT_RECORD, (uint16)count, (uint8)~checksum);
-
-    /* Prepare the S19 termination record */
-    checksum =  (uint8)(0x05)                                         +
-                (uint8)(((pElfHeader->e_entry) & 0xFF000000UL) >> 24) +
-                (uint8)(((pElfHeader->e_entry) & 0x00FF0000UL) >> 16) +
-                (uint8)(((pElfHeader->e_entry) & 0x0000FF00UL) >> 8 ) +
-                (uint8)(((pElfHeader->e_entry) & 0x000000FFUL) >> 0);
-    fprintf(file, "%s%08X%02X\n", S19_TERM_RECORD_32BIT, (uint32)pElfHeader->e_entry, (uint8)~checksum);
-    fclose(file);
-    return(TRUE);
-  }
-  else
-  {
-    return(FALSE);
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_SearchInfo(char* Buffer, char* Symbol)
-{
-  uint32 SymTabSize = 0;
-
-  if(Symbol == NULL)
-  {
-    return(FALSE);
-  }
-
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-    
-  /* search for the symbol table index */
-  for(uint32 i=0; i < pElfHeader->e_shnum; i++)
-  {
-    if((&pSectionHeader[i])->sh_type == SHT_SYMTAB)
-    {
-      pSymTable  = (Elf32_Sym*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-      SymTabSize = (uint32)(((&pSectionHeader[i])->sh_size) / sizeof(Elf32_Sym));
-      break;
-    }
-  }
-
-  /* search for the symbol table (string name table) */
-  for(uint32 i=0; i < pElfHeader->e_shnum; i++)
-  {
-    if((&pSectionHeader[i])->sh_type == SHT_STRTAB && (i != pElfHeader->e_shstrndx))
-    {
-      // pointer to the table which contains the symbol names strings
-      pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-      break;
-    }
-  }
-
-  //printf("\nSYMBOL TABLE : \n");
-  //printf("\n%-17s%-17s%-15s%-15s%-15s\n\n","Value", "Size", "Bind", "Type", "Name");
-
-  /* Display the symbol table */
-  for(uint32 i=0; i< SymTabSize ;i++)
-  {
-    if(0 == strcmp(Symbol,&pSectionName[(&pSymTable[i])->st_name]))
-    {
-      printf("\nSYMBOL INFO (%s) : \n", Symbol);
-      printf("\n%-17s%-17s%-15s%-15s%-15s\n","Value", "Size", "Bind", "Type", "Name");
-      printf("0x%-15x0x%-15x%-15s%-15s%-15s\n",
-              (&pSymTable[i])->st_value,
-              (&pSymTable[i])->st_size,
-              Elf_GetSymTabBindStr(ELF32_ST_BIND((&pSymTable[i])->st_info)),
-              Elf_GetSymTabTypeStr(ELF32_ST_TYPE((&pSymTable[i])->st_info)),
-              &pSectionName[(&pSymTable[i])->st_name]
-            );
-      break;
-    }
-  }
-
-  return(TRUE);
-}
-
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Elf_ListSrcFiles(char* Buffer)
-{
-  #define BUF_SIZE  1000
-
-   char* startAdd      = NULL;
-   char str[BUF_SIZE]  = {0};
-   char dstr[BUF_SIZE] = {0};
-   uint32 size         = 0;
-   uint32 lines        = 0;
-   uint32 srclst       = 0;
-   uint32 i            = 0;
-   boolean boSrcFound  = FALSE;
-   boolean boFirstCall = TRUE;
-
-
-  // section header table pointer
-  pSectionHeader = (Elf32_Shdr*)((uint32)Buffer + (uint32)(pElfHeader->e_shoff));
-    
-  // section string table pointer
-  pSectionName = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[pElfHeader->e_shstrndx])->sh_offset));
-
-  //search for section ".debug_line"
-  for(i = 0; i < pElfHeader->e_shnum ; i++)
-  {
-    if(0 == strcmp(&pSectionName[(&pSectionHeader[i])->sh_name], ".debug_line"))
-    {
-      break;
-    }
-  }
-
-  if(i == pElfHeader->e_shnum)
-  {
-    printf("\n .debug_line section is not found !\n");
-    return(FALSE);
-  }
-
-  startAdd = (char*)((uint32)Buffer + (uint32)((&pSectionHeader[i])->sh_offset));
-  size     = (&pSectionHeader[i])->sh_size;
-
-  // open the tmp files
-  FILE* tmp1 = fopen("tmp1", "wb+");
-  FILE* tmp2 = fopen("tmp2", "wb+");
-  FILE* tmp3 = fopen("tmp3", "wb+");
-
-  if(tmp1 == NULL ||
-     tmp2 == NULL ||
-     tmp3 == NULL
-    )
-  {
-  return(FALSE);
-  }
-
-  /* STEP 1: Create the full list of strings contains in .debug_line */
-  for(uint32 cpt = 0; cpt < size ; cpt++)
-  {
-    if(startAdd[cpt] == '\0'                        ||
-       startAdd[cpt] == ' '                         ||
-       startAdd[cpt] == '.'                         ||
-       startAdd[cpt] == '_'                         ||
-       startAdd[cpt] == ':'                         ||
-       startAdd[cpt] == '\\'                        ||
-       startAdd[cpt] == '/'                         ||
-       (startAdd[cpt] >= '0'&& startAdd[cpt] <='9') ||
-       (startAdd[cpt] >= 'a'&& startAdd[cpt] <='z') ||
-       (startAdd[cpt] >= 'A'&& startAdd[cpt] <='Z')
-      )
-      {
-        if(startAdd[cpt] == '/')
-        {
-          startAdd[cpt] = '\\';
-        }
-
-        if(startAdd[cpt] != '\0')
-        {
-          fputc(startAdd[cpt], tmp1);
-        }
-        else
-        {
-          lines++;
-          fputc('\n', tmp1);
-        }
-        fflush(tmp1);
-    }
-  }
-
-  /* STEP 2: Create file with all src and inc files (contains duplicates) */
-  fseek(tmp1, 0, SEEK_SET);
-  for(uint32 line = 0; line < (lines + 1); line++)
-  {
-    if(fgets(str, BUF_SIZE, tmp1) != NULL && (strlen(str) >= 6))
-    {
-      for(uint32 pos = 0; pos < strlen(str); pos++)
-      {
-        if( 0 == strncmp((str + pos),".c\n"   , strlen(".c\n"))     ||
-            0 == strncmp((str + pos),".cpp\n" , strlen(".cpp\n"))   ||
-            0 == strncmp((str + pos),".h\n"   , strlen(".h\n"))     ||
-            0 == strncmp((str + pos),".s\n"   , strlen(".s\n"))     ||
-            0 == strncmp((str + pos),".asm\n" , strlen(".asm\n"))   ||
-            0 == strncmp((str + pos),".v850\n", strlen(".v850\n"))
-          )
-        {
-          fputs(str, tmp2);
-          memset(str, 0, BUF_SIZE);
-          srclst++;
-          break;
-        }
-      }
-      fflush(tmp2);
-    }
-  }
-
-  /* STEP 3: Remove the duplicate strings  */
-  fseek(tmp2, 0, SEEK_SET);
-  for(uint32 line = 0; line < srclst; line++)
-  {
-    if(fgets(str, BUF_SIZE, tmp2) != NULL)
-    {
-       /* save the first */
-       if(boFirstCall)
-       {
-          fputs(str, tmp3);
-          fseek(tmp3, 0, SEEK_SET);
-          boFirstCall = FALSE;
-       }
-       else
-       {
-         /* check if the str is already exsist in file 3*/
-         while(fgets(dstr, BUF_SIZE, tmp3) != NULL)
-         {
-          if(0 == strcmp(str,dstr))
-          {
-            boSrcFound = TRUE;
-            break;
-          }
-         }
-       }
-
-       if(!boSrcFound)
-       {
-          /* save it */
-          fputs(str, tmp3);
-       }
-
-      memset(str, 0, BUF_SIZE);
-      memset(dstr, 0, BUF_SIZE);
-      boSrcFound = FALSE;
-      fseek(tmp3, 0, SEEK_SET);
-      fflush(tmp3);
-    }
-  }
-
-  /* STEP 4: List all files */
-  fseek(tmp3, 0, SEEK_SET);
-  while(fgets(str, BUF_SIZE, tmp3) != NULL)
-  {
-    for(uint32 pos = 0; pos < strlen(str); pos++)
-    {
-      if(0 == strncmp((str + pos), ":\\", strlen(":\\")))
-      {
-        printf("%s", str);
-        break;
-      }
-    }
-    memset(str, 0, BUF_SIZE);
-  }
-
-  fclose(tmp1);
-  fclose(tmp2);
-  fclose(tmp3);
-
-  /* delete tmp files */
-  system("del /F tmp1");
-  system("del /F tmp2");
-  system("del /F tmp3");
-
-  return(TRUE);
-}
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Elf.h>
+#include<Elf_Swap.h>
+#include<io.h>
+#include<Hash.h>
+
+const sSymTabBind SymTabBind[] = {
+                                    {STB_LOCAL  , "LOCAL" },
+                                    {STB_GLOBAL , "GLOBAL"},
+                                    {STB_WEAK   , "WEAK"  },
+                                    {STB_NUM    , ""      },
+                                    {STB_LOOS   , ""      },
+                                    {STB_LOPROC , ""      },
+                                    {STB_HIPROC , ""      }
+                                 };
+
+#define SYM_TABLE_BIND_SIZE   (uint32)(sizeof(SymTabBind)/sizeof(sSymTabBind))
+
+
+const sSymTabType SymTabType[] = {
+                                    {STT_NOTYPE    , "UNSPECIFIED"},
+                                    {STT_OBJECT    , "OBJECT"     },
+                                    {STT_FUNC      , "FUNCTION"   },
+                                    {STT_SECTIONS  , "SECTION"    },
+                                    {STT_FILE      , "FILE"       },
+                                    {STT_COMMON    , "COMMON"     },
+                                    {STT_TLS       , ""           },
+                                    {STT_NUM       , ""           },
+                                    {STT_LOOS      , ""           },
+                                    {STT_HIOS      , ""           },
+                                    {STT_LOPROC    , ""           },
+                                    {STT_HIPROC    , ""           }
+                                 };
+
+#define SYM_TABLE_TYPE_SIZE   (uint32)(sizeof(SymTabType)/sizeof(sSymTabBind))
+
+const sElfType ElfType[] = {
+                              {TYP_UNKNOWN_ELF     , "Unknown ELF file type"},
+                              {TYP_RELOCATABLE_ELF , "Relocatable ELF"      },
+                              {TYP_EXECUTABLE_ELF  , "Executable ELF"       },
+                              {TYP_SHARED_ELF      , "Shared object ELF"    },
+                              {TYP_CORE_ELF        , "Core ELF"             }
+                           };
+
+#define ELF_TYPE_TABLE_SIZE   (uint32)(sizeof(ElfType)/sizeof(sElfType))
+
+const sMachine targetMachine[] = {
+                                   {EM_NONE      ,"Invalid machine"               },
+                                   {EM_SPARC     ,"Sun SPARC"                     },
+                                   {EM_386       ,"Intel 80386"                   },
+                                   {EM_68K       ,"Freescale 68000"               },
+                                   {EM_486       ,"Intel 80486"                   },
+                                   {EM_MIPS      ,"MIPS"                          },
+                                   {EM_960       ,"Intel i960"                    },
+                                   {EM_PPC       ,"Power Architecture"            },
+                                   {EM_PPC64     ,"Power Architecture 64-bit mode"},
+                                   {EM_V800      ,"Renesas V800 series"           },
+                                   {EM_FR20      ,"Fujitsu FR"                    },
+                                   {EM_MCORE     ,"Freescale MCore"               },
+                                   {EM_ARM       ,"ARM"                           },
+                                   {EM_SH        ,"Hitachi SH"                    },
+                                   {EM_TRICORE   ,"Infineon TriCore"              },
+                                   {EM_COLDFIRE  ,"Freescale ColdFire"            },
+                                   {EM_STARCORE  ,"Freescale StarCore"            },
+                                   {EM_FIREPATH  ,"Broadcom FirePath"             },
+                                   {EM_M32R      ,"Renesas M32R"                  },
+                                   {EM_V850      ,"Renesas V850"                  },
+                                   {EM_BLACKFIN  ,"ADI Blackfin"                  },
+                                   {EM_X86_64    ,"AMD x86-64"                    },
+                                   {EM_AARCH64   ,"ARM 64-bit"                    },
+                                   {EM_RISCV     ,"RISC-V"                        }
+                                 };
+
+#define TARGET_MACHINE_TABLE_SIZE  ((sizeof(targetMachine))/(sizeof(sMachine)))
+
+const sSectionType SectionTypeTable[] = {
+                                           {SHT_NULL     , "NULL"    },
+                                           {SHT_PROGBITS , "PROGBITS"},
+                                           {SHT_SYMTAB   , "SYMTAB"  },
+                                           {SHT_STRTAB   , "STRTAB"  },
+                                           {SHT_RELA     , "RELA"    },
+                                           {SHT_NOTE     , "NOTE"    },
+                                           {SHT_NOBITS   , "NOBITS"  },
+                                           {SHT_REL      , "REL"     },
+                                           {SHT_DYNSYM   , "DYNSYM"  }
+                                        };
+
+#define SECTION_TYPE_TABLE_SIZE  ((sizeof(SectionTypeTable))/(sizeof(sSectionType)))
+
+const sSectionAttr SectionAttrTable[] = {
+                                          {SHF_WRITE , 'W'},
+                                          {SHF_ALLOC , 'A'},
+                                          {SHF_EXECU  ,'X'}
+                                        };
+
+#define SECTION_ATTR_TABLE_SIZE  ((sizeof(SectionAttrTable))/(sizeof(sSectionAttr)))
+
+static char* Elf_GetSymTabBindStr(Elf32_Byte bind);
+static char* Elf_GetSymTabTypeStr(Elf32_Byte type);
+//sort key of the section directory lists
+typedef struct
+{
+  uint64 key;
+  uint64 size;
+  uint32 index;
+}sElfDirKey;
+
+static char* Elf_GetMachineNameStr(Elf32_Half machine);
+static char* Elf_GetElfTypeStr(Elf32_Half type);
+static char* Elf_GetSectionNameStr(Elf32_Word type);
+static char* Elf_GetSectionAttrStr(uint64 type, char* attr);
+
+static void Elf_PrintSection(uint32 index, char* name, uint32 type, uint64 flags, uint64 addr, uint64 offset, uint64 size);
+static void Elf_PrintSymbol(uint64 value, uint64 size, uint8 info, char* name);
+static void Elf_WriteCArray(FILE* file, char* name, uint8* OffAdd, uint32 size);
+static void Elf_WriteS19Header(FILE* file, uint32* count);
+static void Elf_WriteS19Data(FILE* file, uint32 PhyAdd, uint8* OffAdd, uint32 size, uint32* count);
+static void Elf_WriteS19Trailer(FILE* file, uint32 count, uint32 entry);
+static const sElfClassOps* Elf_FindClassOps(uint32 eclass, uint32 edata);
+static boolean Elf_ConvertTables(sElf* elf, uint32 eclass);
+static void Elf_ReleaseNativeTables(sElf* elf, sArenaMark mark);
+static char* Elf_AlignedTable(sElf* elf, uint64 offset, uint64 size);
+static boolean Elf_SetError(sElf* elf, eElfError error);
+static boolean Elf_BuildDirectory(sElf* elf);
+static sElfDirKey* Elf_SortDirKeys(sElfDirKey* keys, sElfDirKey* tmp, uint32 count);
+static const char* Elf_GetErrorStr(eElfError error);
+
+/*******************************************************************************************************************
+** Byte order helpers used by the big endian specializations
+*******************************************************************************************************************/
+static __inline uint16 Elf_Swap16(uint16 x)
+{
+  return((uint16)((x >> 8) | (x << 8)));
+}
+
+static __inline uint32 Elf_Swap32(uint32 x)
+{
+  return(((x >> 24) & 0x000000FFUL) |
+         ((x >>  8) & 0x0000FF00UL) |
+         ((x <<  8) & 0x00FF0000UL) |
+         ((x << 24) & 0xFF000000UL));
+}
+
+static __inline uint64 Elf_Swap64(uint64 x)
+{
+  return(((uint64)Elf_Swap32((uint32)x) << 32) | (uint64)Elf_Swap32((uint32)(x >> 32)));
+}
+
+/*******************************************************************************************************************
+** Class/endian specializations : 32 bit LSB, 32 bit MSB, 64 bit LSB, 64 bit MSB
+*******************************************************************************************************************/
+#define ELF_CLASS_BITS  32
+#define ELF_CLASS_MSB   0
+#define ELF_FN(name)    Elf32L_##name
+#include<Elf_Class.h>
+
+#define ELF_CLASS_BITS  32
+#define ELF_CLASS_MSB   1
+#define ELF_FN(name)    Elf32B_##name
+#include<Elf_Class.h>
+
+#define ELF_CLASS_BITS  64
+#define ELF_CLASS_MSB   0
+#define ELF_FN(name)    Elf64L_##name
+#include<Elf_Class.h>
+
+#define ELF_CLASS_BITS  64
+#define ELF_CLASS_MSB   1
+#define ELF_FN(name)    Elf64B_##name
+#include<Elf_Class.h>
+
+static const sElfClassOps* const ElfClassOpsTable[] = {
+                                                         &Elf32L_Ops,
+                                                         &Elf32B_Ops,
+                                                         &Elf64L_Ops,
+                                                         &Elf64B_Ops
+                                                      };
+
+#define ELF_CLASS_OPS_TABLE_SIZE  ((sizeof(ElfClassOpsTable))/(sizeof(sElfClassOps*)))
+
+/*******************************************************************************************************************
+** Function:    Elf_Open
+** Description: check the ELF identification, validate once every table and range of the image in Buffer against
+**              its size (see ELF_FN(Validate)) and prepare the context (Buffer is not copied and must stay valid
+**              until Elf_Close; only the headers and tables which are not 8-byte aligned in it, like those of an
+**              archive member, are copied, see Elf_AlignedTable). Nothing is printed, the reason of a failure is
+**              left in elf->ErrorCode, elf->ErrorSection, elf->ErrorEntry and elf->error (see Elf_PrintError).
+** Parameter:   sElf* elf, char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_Open(sElf* elf, char* Buffer, uint32 size)
+{
+  memset(elf, 0, sizeof(sElf));
+  elf->ErrorSection = ELF_NO_INDEX;
+  elf->ErrorEntry   = ELF_NO_INDEX;
+
+  if(Buffer == NULL)
+  {
+    return(FALSE);
+  }
+
+  Elf32_Byte* ident = (Elf32_Byte*)Buffer;
+
+  elf->Buffer = Buffer;
+  elf->size   = size;
+
+  if(size < EI_NIDENT || ident[0] != 0x7F || ident[1] != 'E' || ident[2] != 'L' || ident[3] != 'F')
+  {
+    return(Elf_SetError(elf, ELF_ERR_NOT_ELF));
+  }
+
+  /* select the operations matching the file class and data encoding */
+  elf->ops = Elf_FindClassOps(ident[4], ident[5]);
+
+  if(elf->ops == NULL)
+  {
+    return(Elf_SetError(elf, ELF_ERR_CLASS));
+  }
+
+  /* single validation pass: the operations read the tables without checks afterwards */
+  eElfError error = elf->ops->Validate(elf);
+
+  if(error != ELF_OK)
+  {
+    return(Elf_SetError(elf, error));
+  }
+
+  /* big endian file: convert the header and the tables once into host order and use the native operations */
+  if(ident[5] == ELFDATA2MSB && Elf_ConvertTables(elf, ident[4]))
+  {
+    elf->ops = Elf_FindClassOps(ident[4], ELFDATA2LSB);
+  }
+
+  elf->ops->Open(elf);
+
+  if(!Elf_BuildDirectory(elf))
+  {
+    return(Elf_SetError(elf, ELF_ERR_NO_MEMORY));
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_SetError
+** Description: record the reason of an Elf_Open failure (the faulty section/entry are set by the validation)
+** Parameter:   sElf* elf, eElfError error
+** Return:      boolean (always FALSE)
+*******************************************************************************************************************/
+static boolean Elf_SetError(sElf* elf, eElfError error)
+{
+  elf->ops       = NULL;
+  elf->ErrorCode = error;
+  elf->error     = Elf_GetErrorStr(error);
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_Load
+** Description: load an ELF file and prepare its context (the context owns the loaded buffer)
+** Parameter:   sElf* elf, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_Load(sElf* elf, char* path)
+{
+  uint32 size   = 0;
+  char*  Buffer = (char*)LoadInputFile(path, &size);
+
+  if(Buffer == NULL)
+  {
+    memset(elf, 0, sizeof(sElf));
+    return(FALSE);
+  }
+
+  if(!Elf_Open(elf, Buffer, size))
+  {
+    eElfError   code    = elf->ErrorCode;
+    uint32      section = elf->ErrorSection;
+    uint32      entry   = elf->ErrorEntry;
+    const char* error   = elf->error;
+
+    Elf_Close(elf);
+    free(Buffer);
+    elf->ErrorCode    = code;
+    elf->ErrorSection = section;
+    elf->ErrorEntry   = entry;
+    elf->error        = error;
+    return(FALSE);
+  }
+
+  elf->owner = TRUE;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_PrintError
+** Description: display the reason of an Elf_Open failure
+** Parameter:   sElf* elf
+** Return:      void
+*******************************************************************************************************************/
+void Elf_PrintError(sElf* elf)
+{
+  if(elf->error == NULL)
+  {
+    return;
+  }
+
+  printf("%s", elf->error);
+
+  if(elf->ErrorSection != ELF_NO_INDEX)
+  {
+    printf(" (section %u", (unsigned int)elf->ErrorSection);
+
+    if(elf->ErrorEntry != ELF_NO_INDEX)
+    {
+      printf(", entry %u", (unsigned int)elf->ErrorEntry);
+    }
+    printf(")");
+  }
+  printf(" [KO]\n");
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_Close
+** Description: free the context resources (the image arena, and the buffer loaded by Elf_Load)
+** Parameter:   sElf* elf
+** Return:      void
+*******************************************************************************************************************/
+void Elf_Close(sElf* elf)
+{
+  Arena_Release(&elf->arena);
+
+  if(elf->owner)
+  {
+    free(elf->Buffer);
+  }
+  memset(elf, 0, sizeof(sElf));
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_PrintHeader
+** Description: display the ELF file header
+** Parameter:   sElf* elf
+** Return:      void
+*******************************************************************************************************************/
+void Elf_PrintHeader(sElf* elf)
+{
+  Elf32_Byte* ident = (Elf32_Byte*)elf->Buffer;
+
+  if(ident == NULL || elf->ops == NULL)
+  {
+    return;
+  }
+
+  printf("\nELF File Header :\n\n");
+
+  if(ident[4] == ELFCLASS32)
+  {
+    printf("Class      = 32 bit\n");
+  }
+  else if(ident[4] == ELFCLASS64)
+  {
+    printf("Class      = 64 bit\n");
+  }
+  else
+  {
+      printf("Class      = unknown class \n");
+  }
+
+  if(ident[5] == ELFDATA2LSB)
+  {
+    printf("Endianness = little endian \n");
+  }
+  else if(ident[5] == ELFDATA2MSB)
+  {
+    printf("Endianness = big endian \n");
+  }
+  else
+  {
+      printf("Endianness = unknown endian \n");
+  }
+
+  //display the ELF header
+  elf->ops->PrintHeader(elf);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_FindClassOps
+** Description: get the specialized operations of one class/data encoding pair
+** Parameter:   uint32 eclass, uint32 edata
+** Return:      const sElfClassOps* (NULL if the pair is not supported)
+*******************************************************************************************************************/
+static const sElfClassOps* Elf_FindClassOps(uint32 eclass, uint32 edata)
+{
+  for(uint32 i = 0; i < ELF_CLASS_OPS_TABLE_SIZE; i++)
+  {
+    if(eclass == ElfClassOpsTable[i]->eclass && edata == ElfClassOpsTable[i]->edata)
+    {
+      return(ElfClassOpsTable[i]);
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetErrorStr
+** Description: get the text of an Elf_Open failure
+** Parameter:   eElfError error
+** Return:      const char*
+*******************************************************************************************************************/
+static const char* Elf_GetErrorStr(eElfError error)
+{
+  switch(error)
+  {
+    case ELF_OK:                return("No error");
+    case ELF_ERR_NOT_ELF:       return("This is not a valid ELF file");
+    case ELF_ERR_CLASS:         return("Unsupported ELF class or data encoding");
+    case ELF_ERR_HEADER:        return("Truncated ELF header");
+    case ELF_ERR_SHDR_TABLE:    return("Section header table out of the file");
+    case ELF_ERR_PHDR_TABLE:    return("Program header table out of the file");
+    case ELF_ERR_SHSTRNDX:      return("Invalid section names string table index");
+    case ELF_ERR_SECTION_RANGE: return("Section content out of the file");
+    case ELF_ERR_STRTAB:        return("Invalid string table");
+    case ELF_ERR_SECTION_NAME:  return("Section name out of the string table");
+    case ELF_ERR_TABLE_SIZE:    return("Table size is not a multiple of the entry size");
+    case ELF_ERR_TABLE_LINK:    return("Invalid linked table");
+    case ELF_ERR_SYMBOL_NAME:   return("Symbol name out of the string table");
+    case ELF_ERR_NO_MEMORY:     return("Out of memory");
+    default:                    return("Unknown error");
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_ConvertTables
+** Description: bulk byte swap the header, the section and program header tables and the symbol/relocation
+**              tables of a big endian file into host order copies (see Elf_Swap.c) taken from the image arena. Runs once per
+**              loaded file.
+** Parameter:   sElf* elf, uint32 eclass
+** Return:      boolean (FALSE if the copies could not be allocated, the file is then read in place)
+*******************************************************************************************************************/
+static boolean Elf_ConvertTables(sElf* elf, uint32 eclass)
+{
+  const sElfSwapLayout* EhdrLayout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Ehdr32 : &ElfSwapLayout_Ehdr64;
+  const sElfSwapLayout* ShdrLayout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Shdr32 : &ElfSwapLayout_Shdr64;
+  const sElfSwapLayout* PhdrLayout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Phdr32 : &ElfSwapLayout_Phdr64;
+  sArenaMark            mark       = Arena_Mark(&elf->arena);
+  uint64 shoff = 0;
+  uint32 shnum = elf->SectionsNbr;    //real count, extended section numbering resolved by the validation
+  uint64 phoff = 0;
+  uint32 phnum = 0;
+
+  elf->NativeEhdr = (char*)Arena_Alloc(&elf->arena, EhdrLayout->RecSize);
+
+  if(elf->NativeEhdr == NULL)
+  {
+    return(FALSE);
+  }
+
+  Elf_SwapTable(elf->NativeEhdr, elf->Buffer, EhdrLayout->RecSize, EhdrLayout);
+
+  if(eclass == ELFCLASS32)
+  {
+    shoff = ((Elf32_Ehdr*)elf->NativeEhdr)->e_shoff;
+    phoff = ((Elf32_Ehdr*)elf->NativeEhdr)->e_phoff;
+    phnum = ((Elf32_Ehdr*)elf->NativeEhdr)->e_phnum;
+  }
+  else
+  {
+    shoff = ((Elf64_Ehdr*)elf->NativeEhdr)->e_shoff;
+    phoff = ((Elf64_Ehdr*)elf->NativeEhdr)->e_phoff;
+    phnum = ((Elf64_Ehdr*)elf->NativeEhdr)->e_phnum;
+  }
+
+  elf->NativeShdr   = (char*)Arena_Alloc(&elf->arena, (size_t)shnum * ShdrLayout->RecSize + 1);
+  elf->NativePhdr   = (char*)Arena_Alloc(&elf->arena, (size_t)phnum * PhdrLayout->RecSize + 1);
+  elf->NativeTables = (char**)Arena_Calloc(&elf->arena, (size_t)shnum + 1, sizeof(char*));
+
+  if(elf->NativeShdr == NULL || elf->NativePhdr == NULL || elf->NativeTables == NULL)
+  {
+    Elf_ReleaseNativeTables(elf, mark);
+    return(FALSE);
+  }
+
+  elf->NativeTablesNbr = shnum;
+  Elf_SwapTable(elf->NativeShdr, elf->Buffer + (size_t)shoff, shnum * ShdrLayout->RecSize, ShdrLayout);
+  Elf_SwapTable(elf->NativePhdr, elf->Buffer + (size_t)phoff, phnum * PhdrLayout->RecSize, PhdrLayout);
+
+  /* symbol and relocation tables */
+  for(uint32 i = 0; i < shnum; i++)
+  {
+    const sElfSwapLayout* layout = NULL;
+    uint32 type   = 0;
+    uint64 offset = 0;
+    uint64 size   = 0;
+
+    if(eclass == ELFCLASS32)
+    {
+      type   = ((Elf32_Shdr*)elf->NativeShdr)[i].sh_type;
+      offset = ((Elf32_Shdr*)elf->NativeShdr)[i].sh_offset;
+      size   = ((Elf32_Shdr*)elf->NativeShdr)[i].sh_size;
+    }
+    else
+    {
+      type   = ((Elf64_Shdr*)elf->NativeShdr)[i].sh_type;
+      offset = ((Elf64_Shdr*)elf->NativeShdr)[i].sh_offset;
+      size   = ((Elf64_Shdr*)elf->NativeShdr)[i].sh_size;
+    }
+
+    switch(type)
+    {
+      case SHT_SYMTAB:
+      case SHT_DYNSYM:
+        layout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Sym32 : &ElfSwapLayout_Sym64;
+        break;
+      case SHT_REL:
+        layout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Rel32 : &ElfSwapLayout_Rel64;
+        break;
+      case SHT_RELA:
+        layout = (eclass == ELFCLASS32) ? &ElfSwapLayout_Rela32 : &ElfSwapLayout_Rela64;
+        break;
+      case SHT_SYMTAB_SHNDX:
+        layout = &ElfSwapLayout_Word;
+        break;
+      default:
+        break;
+    }
+
+    if(layout != NULL && size > 0)
+    {
+      elf->NativeTables[i] = (char*)Arena_Alloc(&elf->arena, (size_t)size);
+
+      if(elf->NativeTables[i] == NULL)
+      {
+        Elf_ReleaseNativeTables(elf, mark);
+        return(FALSE);
+      }
+
+      Elf_SwapTable(elf->NativeTables[i], elf->Buffer + (size_t)offset, (uint32)size, layout);
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_AlignedTable
+** Description: get a header or table of the file at an address aligned for its fields: in place when it is
+**              8-byte aligned in Buffer, else a copy taken from the image arena. An archive member is only 2-byte
+**              aligned in the archive, so only its headers and tables are copied, never its whole content.
+**              The range has been checked against the file size by the caller.
+** Parameter:   sElf* elf, uint64 offset, uint64 size
+** Return:      char* (NULL if the copy could not be allocated)
+*******************************************************************************************************************/
+static char* Elf_AlignedTable(sElf* elf, uint64 offset, uint64 size)
+{
+  char* table = elf->Buffer + (size_t)offset;
+  char* copy  = NULL;
+
+  if(((size_t)table & (sizeof(uint64) - 1U)) == 0)
+  {
+    return(table);
+  }
+
+  copy = (char*)Arena_Alloc(&elf->arena, (size_t)size + 1U);
+
+  if(copy != NULL)
+  {
+    memcpy(copy, table, (size_t)size);
+  }
+  return(copy);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_ReleaseNativeTables
+** Description: give back to the arena the host order copies of a big endian file (partial conversion)
+** Parameter:   sElf* elf, sArenaMark mark (arena position before the conversion)
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_ReleaseNativeTables(sElf* elf, sArenaMark mark)
+{
+  Arena_Rewind(&elf->arena, mark);
+
+  elf->NativeTables   = NULL;
+  elf->NativeShdr     = NULL;
+  elf->NativePhdr     = NULL;
+  elf->NativeEhdr     = NULL;
+  elf->NativeTablesNbr = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_SectionHeaderTable(sElf* elf)
+{
+  if(elf == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->SectionHeaderTable(elf));
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_SymbolTable(sElf* elf)
+{
+  if(elf == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->SymbolTable(elf));
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetSymTabBindStr(Elf32_Byte bind)
+{
+  for(uint32 i=0; i < SYM_TABLE_BIND_SIZE; i++)
+  {
+    if(SymTabBind[i].code == bind)
+    {
+      return((char*)(SymTabBind[i].name));
+    }
+  }
+  return("unknown");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetSymTabTypeStr(Elf32_Byte type)
+{
+  for(uint32 i=0; i < SYM_TABLE_TYPE_SIZE; i++)
+  {
+    if(SymTabType[i].code == type)
+    {
+      return((char*)(SymTabType[i].name));
+    }
+  }
+  return("unknown");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetMachineNameStr(Elf32_Half machine)
+{
+  for(uint32 i = 0; i < TARGET_MACHINE_TABLE_SIZE; i++)
+  {
+    if(machine == targetMachine[i].machine)
+    {
+      return((char*)(targetMachine[i].name));
+    }
+  }
+  return("unknown");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetElfTypeStr(Elf32_Half type)
+{
+  for(uint32 i = 0; i < ELF_TYPE_TABLE_SIZE; i++)
+  {
+    if(type == ElfType[i].code)
+    {
+      return((char*)(ElfType[i].name));
+    }
+  }
+  return("unknown");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetSectionNameStr(Elf32_Word type)
+{
+  for(uint32 i = 0; i < SECTION_TYPE_TABLE_SIZE; i++)
+  {
+    if(type == SectionTypeTable[i].type)
+    {
+      return((char*)(SectionTypeTable[i].name));
+    }
+  }
+  return("unknown");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static char* Elf_GetSectionAttrStr(uint64 type, char* attr)
+{
+  for(uint32 i=0; i < SECTION_ATTR_TABLE_SIZE; i++)
+  {
+
+    if((type & SectionAttrTable[i].code) == SectionAttrTable[i].code)
+    {
+      attr[i] = SectionAttrTable[i].name;
+    }
+    else
+    {
+      attr[i] = ' ';
+    }
+  }
+  attr[SECTION_ATTR_TABLE_SIZE] = '\0';
+
+  return(attr);
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_PrintSection(uint32 index, char* name, uint32 type, uint64 flags, uint64 addr, uint64 offset, uint64 size)
+{
+  char  attr[SECTION_ATTR_TABLE_SIZE + 1];
+  char  code[16];
+  char* str = Elf_GetSectionNameStr(type);
+
+  /* the type of an unknown section (GNU, processor or OS specific) is shown by its value */
+  if(0 == strcmp(str, "unknown"))
+  {
+    snprintf(code, sizeof(code), "0x%X", (unsigned int)type);
+    str = code;
+  }
+
+  printf("%-1s%-2d%-7s%-20s%-20s%-20s0x%-20llx0x%-20llx0x%-20llx\n",
+          "[",
+          index, 
+          "]",
+          name, 
+          str,
+          Elf_GetSectionAttrStr(flags, attr),
+          (unsigned long long)addr,
+          (unsigned long long)offset,
+          (unsigned long long)size
+        );
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_PrintSymbol(uint64 value, uint64 size, uint8 info, char* name)
+{
+  printf("0x%-15llx0x%-15llx%-15s%-15s%-15s\n",
+          (unsigned long long)value,
+          (unsigned long long)size,
+          Elf_GetSymTabBindStr(ELF32_ST_BIND(info)),
+          Elf_GetSymTabTypeStr(ELF32_ST_TYPE(info)),
+          name
+        );
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_ExtractBinaryToC(sElf* elf, char* path)
+{
+  if(elf == NULL || path == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->ExtractBinaryToC(elf, path));
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_WriteCArray(FILE* file, char* name, uint8* OffAdd, uint32 size)
+{
+  /* print the section content */
+  fprintf(file,"\n const unsigned char _%s[] = {\n\n", name);
+  for(uint32 cpt = 0; cpt < size; cpt++)
+  {
+    fprintf(file,"0x%02x", OffAdd[cpt]);
+
+    if((cpt > 0) && ((cpt + 1) % 16 == 0))
+    {
+      fprintf(file,"\n");
+    }
+    else if (cpt + 1 != size)
+    {
+      fprintf(file,", ");
+    }
+    else
+    {
+      fprintf(file,"\n");
+    }
+  }
+  fprintf(file,"};\n");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_ExtractBinaryToS19(sElf* elf, char* path)
+{
+  if(elf == NULL || path == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->ExtractBinaryToS19(elf, path));
+}
+
+#define S19_HEADER_RECORD       "S0"
+#define S19_DATA_RECORD_32BIT   "S3"
+#define S19_COUNT_RECORD        "S503"
+#define S19_TERM_RECORD_32BIT   "S705"
+#define S19_PACKAGE_SIZE        28
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_WriteS19Header(FILE* file, uint32* count)
+{
+  uint8 checksum = 0;
+  uint8 length   = 0;
+
+  const char version[] = {"ELF_PARSER_BY_CHALANDI_AMINE_2019"};
+
+  /* prepare the count for the S19 record header, the S5 record only counts the data records */
+  length = (uint8)(3 + (sizeof(version)/sizeof(char)));
+  *count = 0;
+
+  /* calculate the checksum for the S19 record header */
+  for(uint32 i=0; i < (sizeof(version)/sizeof(char)); i++)
+  {
+    checksum += (uint8)version[i];
+  }
+
+  checksum += length;
+
+  /* print the S19 header record */
+  fprintf(file, "%s%02X%04X", S19_HEADER_RECORD, length, (uint16)0);
+
+  /* print the version in the record */
+  for(uint32 i=0; i < (sizeof(version)/sizeof(char)); i++)
+  {
+    fprintf(file, "%02X", version[i]);
+  }
+
+  /* print the checksum */
+  fprintf(file, "%02X\n", (uint8)~checksum);
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_WriteS19Data(FILE* file, uint32 PhyAdd, uint8* OffAdd, uint32 size, uint32* count)
+{
+  uint32 padding  = (size % S19_PACKAGE_SIZE);
+  uint8  checksum = 0;
+
+  /* print the S19 data records */
+  for(uint32 cpt = 0; cpt < ((size / S19_PACKAGE_SIZE) * S19_PACKAGE_SIZE); cpt++)
+  {
+  
+    if(cpt % S19_PACKAGE_SIZE == 0)
+    {
+      /* New Data Record */
+      fprintf(file, "%s%02X%08X", S19_DATA_RECORD_32BIT, (uint8)(S19_PACKAGE_SIZE + 5), (uint32)(PhyAdd + cpt));
+
+      /* Init the checksum */
+      checksum = (uint8)(S19_PACKAGE_SIZE + 5)                  +
+                 (uint8)(((PhyAdd + cpt) & 0xFF000000UL) >> 24) +
+                 (uint8)(((PhyAdd + cpt) & 0x00FF0000UL) >> 16) +
+                 (uint8)(((PhyAdd + cpt) & 0x0000FF00UL) >> 8 ) +
+                 (uint8)(((PhyAdd + cpt) & 0x000000FFUL) >> 0 ) ;
+      (*count)++;
+    }
+
+    /* Print one byte in the file */
+    fprintf(file, "%02X", OffAdd[cpt]);
+  
+    /* Calculate the checksum */
+    checksum += OffAdd[cpt];
+
+    if(((cpt + 1) % S19_PACKAGE_SIZE == 0))
+    {
+      /* The end of one s19 record, insert the checksum */
+      fprintf(file, "%02X\n", (uint8)~checksum); /* 1's complement */
+    }
+
+  }
+  if(padding > 0) /* data size less than one S19 package */
+  {
+    /* prepare the S19 data record */
+    fprintf(file, "%s%02X%08X", S19_DATA_RECORD_32BIT, (uint16)(padding + 5), (uint32)(PhyAdd + size - padding));
+    checksum =  (uint8)(padding + 5)                                      +
+                (uint8)(((PhyAdd + size - padding) & 0xFF000000UL) >> 24) +
+                (uint8)(((PhyAdd + size - padding) & 0x00FF0000UL) >> 16) +
+                (uint8)(((PhyAdd + size - padding) & 0x0000FF00UL) >> 8 ) +
+                (uint8)(((PhyAdd + size - padding) & 0x000000FFUL) >> 0);
+     (*count)++;
+
+    for(uint32 cpt = 0; cpt < padding; cpt++)
+    {
+      fprintf(file, "%02X", OffAdd[size - padding + cpt]);
+      checksum += OffAdd[size - padding + cpt];
+    }
+    fprintf(file, "%02X\n", (uint8)~checksum);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Elf_WriteS19Trailer(FILE* file, uint32 count, uint32 entry)
+{
+  uint8 checksum = 0;
+
+  /* Prepare the S19 count record */
+  checksum =  (uint8)(0x03)                           +
+              (uint8)(((count) & 0x0000FF00UL) >> 8 ) +
+              (uint8)(((count) & 0x000000FFUL) >> 0);
+  fprintf(file, "%s%04X%02X\n", S19_COUNT_RECORD, (uint16)count, (uint8)~checksum);
+
+  /* Prepare the S19 termination record */
+  checksum =  (uint8)(0x05)                             +
+              (uint8)(((entry) & 0xFF000000UL) >> 24) +
+              (uint8)(((entry) & 0x00FF0000UL) >> 16) +
+              (uint8)(((entry) & 0x0000FF00UL) >> 8 ) +
+              (uint8)(((entry) & 0x000000FFUL) >> 0);
+  fprintf(file, "%s%08X%02X\n", S19_TERM_RECORD_32BIT, (uint32)entry, (uint8)~checksum);
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_SearchInfo(sElf* elf, char* Symbol)
+{
+  if(elf == NULL || Symbol == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->SearchInfo(elf, Symbol));
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Elf_ListSrcFiles(sElf* elf)
+{
+  #define BUF_SIZE  1000
+
+   const char* startAdd = NULL;
+   char str[BUF_SIZE]  = {0};
+   char dstr[BUF_SIZE] = {0};
+   uint64 size         = 0;
+   uint32 lines        = 0;
+   uint32 srclst       = 0;
+   boolean boSrcFound  = FALSE;
+   boolean boFirstCall = TRUE;
+
+
+  if(elf == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+
+  //search for section ".debug_line"
+  sElfSection* DebugLine = Elf_FindSection(elf, ".debug_line");
+
+  if(DebugLine == NULL || DebugLine->data == NULL)
+  {
+    printf("\n .debug_line section is not found !\n");
+    return(FALSE);
+  }
+
+  startAdd = DebugLine->data;
+  size     = DebugLine->size;
+
+  // open anonymous tmp files (removed on close, so that concurrent listings do not collide)
+  FILE* tmp1 = tmpfile();
+  FILE* tmp2 = tmpfile();
+  FILE* tmp3 = tmpfile();
+
+  if(tmp1 == NULL ||
+     tmp2 == NULL ||
+     tmp3 == NULL
+    )
+  {
+    if(tmp1 != NULL) { fclose(tmp1); }
+    if(tmp2 != NULL) { fclose(tmp2); }
+    if(tmp3 != NULL) { fclose(tmp3); }
+    return(FALSE);
+  }
+
+  /* STEP 1: Create the full list of strings contains in .debug_line */
+  for(uint64 cpt = 0; cpt < size ; cpt++)
+  {
+    /* the '/' separators are listed as '\\', the section content itself is left untouched */
+    char c = (startAdd[cpt] == '/') ? '\\' : startAdd[cpt];
+
+    if(c == '\0'              ||
+       c == ' '               ||
+       c == '.'               ||
+       c == '_'               ||
+       c == ':'               ||
+       c == '\\'              ||
+       (c >= '0'&& c <='9')   ||
+       (c >= 'a'&& c <='z')   ||
+       (c >= 'A'&& c <='Z')
+      )
+      {
+        if(c != '\0')
+        {
+          fputc(c, tmp1);
+        }
+        else
+        {
+          lines++;
+          fputc('\n', tmp1);
+        }
+        fflush(tmp1);
+    }
+  }
+
+  /* STEP 2: Create file with all src and inc files (contains duplicates) */
+  fseek(tmp1, 0, SEEK_SET);
+  for(uint32 line = 0; line < (lines + 1); line++)
+  {
+    if(fgets(str, BUF_SIZE, tmp1) != NULL && (strlen(str) >= 6))
+    {
+      for(uint32 pos = 0; pos < strlen(str); pos++)
+      {
+        if( 0 == strncmp((str + pos),".c\n"   , strlen(".c\n"))     ||
+            0 == strncmp((str + pos),".cpp\n" , strlen(".cpp\n"))   ||
+            0 == strncmp((str + pos),".h\n"   , strlen(".h\n"))     ||
+            0 == strncmp((str + pos),".s\n"   , strlen(".s\n"))     ||
+            0 == strncmp((str + pos),".asm\n" , strlen(".asm\n"))   ||
+            0 == strncmp((str + pos),".v850\n", strlen(".v850\n"))
+          )
+        {
+          fputs(str, tmp2);
+          memset(str, 0, BUF_SIZE);
+          srclst++;
+          break;
+        }
+      }
+      fflush(tmp2);
+    }
+  }
+
+  /* STEP 3: Remove the duplicate strings  */
+  fseek(tmp2, 0, SEEK_SET);
+  for(uint32 line = 0; line < srclst; line++)
+  {
+    if(fgets(str, BUF_SIZE, tmp2) != NULL)
+    {
+       /* save the first */
+       if(boFirstCall)
+       {
+          fputs(str, tmp3);
+          fseek(tmp3, 0, SEEK_SET);
+          boFirstCall = FALSE;
+       }
+       else
+       {
+         /* check if the str is already exsist in file 3*/
+         while(fgets(dstr, BUF_SIZE, tmp3) != NULL)
+         {
+          if(0 == strcmp(str,dstr))
+          {
+            boSrcFound = TRUE;
+            break;
+          }
+         }
+       }
+
+       if(!boSrcFound)
+       {
+          /* save it */
+          fputs(str, tmp3);
+       }
+
+      memset(str, 0, BUF_SIZE);
+      memset(dstr, 0, BUF_SIZE);
+      boSrcFound = FALSE;
+      fseek(tmp3, 0, SEEK_SET);
+      fflush(tmp3);
+    }
+  }
+
+  /* STEP 4: List all files */
+  fseek(tmp3, 0, SEEK_SET);
+  while(fgets(str, BUF_SIZE, tmp3) != NULL)
+  {
+    for(uint32 pos = 0; pos < strlen(str); pos++)
+    {
+      if(0 == strncmp((str + pos), ":\\", strlen(":\\")))
+      {
+        printf("%s", str);
+        break;
+      }
+    }
+    memset(str, 0, BUF_SIZE);
+  }
+
+  fclose(tmp1);
+  fclose(tmp2);
+  fclose(tmp3);
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_WalkRelocations
+** Description: hand over all relocation entries of the file, batch by batch, to the callback
+** Parameter:   sElf* elf, pfElfRelocBatch callback, void* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_WalkRelocations(sElf* elf, pfElfRelocBatch callback, void* ctx)
+{
+  if(elf == NULL || callback == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->WalkRelocations(elf, callback, ctx));
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_FindSymbolIndex
+** Description: get the index of a symbol by name in the symbol table section symtab
+** Parameter:   sElf* elf, uint32 symtab, const char* name, uint32* index
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_FindSymbolIndex(sElf* elf, uint32 symtab, const char* name, uint32* index)
+{
+  if(elf == NULL || name == NULL || index == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return(elf->ops->FindSymbolIndex(elf, symtab, name, index));
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetSections
+** Description: get the sections of the file as a class independent array. The array is built once and belongs
+**              to the context (released by Elf_Close), the callers must neither free nor modify it.
+** Parameter:   sElf* elf, sElfSection** sections, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_GetSections(sElf* elf, sElfSection** sections, uint32* count)
+{
+  if(elf == NULL || sections == NULL || count == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(elf->SectionList == NULL && !elf->ops->GetSections(elf, &elf->SectionList, &elf->SectionListNbr))
+  {
+    elf->SectionList = NULL;
+    return(FALSE);
+  }
+
+  *sections = elf->SectionList;
+  *count    = elf->SectionListNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetSymbols
+** Description: get the symbols of the file as a class independent array. The array is built once and belongs
+**              to the context (released by Elf_Close), the callers must neither free nor modify it.
+** Parameter:   sElf* elf, sElfSymbol** symbols, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_GetSymbols(sElf* elf, sElfSymbol** symbols, uint32* count)
+{
+  if(elf == NULL || symbols == NULL || count == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(elf->SymbolList == NULL && !elf->ops->GetSymbols(elf, &elf->SymbolList, &elf->SymbolListNbr))
+  {
+    elf->SymbolList = NULL;
+    *symbols        = NULL;
+    *count          = 0;
+    return(FALSE);
+  }
+
+  *symbols = elf->SymbolList;
+  *count   = elf->SymbolListNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetSegments
+** Description: get the segments (program headers) of the file as a class independent array. The array is built
+**              once and belongs to the context (released by Elf_Close), the callers must neither free nor modify
+**              it. A file without program header table (relocatable object) has no segment.
+** Parameter:   sElf* elf, sElfSegment** segments, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_GetSegments(sElf* elf, sElfSegment** segments, uint32* count)
+{
+  if(elf == NULL || segments == NULL || count == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(elf->SegmentList == NULL && !elf->ops->GetSegments(elf, &elf->SegmentList, &elf->SegmentListNbr))
+  {
+    elf->SegmentList = NULL;
+    return(FALSE);
+  }
+
+  *segments = elf->SegmentList;
+  *count    = elf->SegmentListNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetEntry
+** Description: entry point of the file (e_entry of the header)
+** Parameter:   sElf* elf
+** Return:      uint64 (0 if the context is not opened)
+*******************************************************************************************************************/
+uint64 Elf_GetEntry(sElf* elf)
+{
+  if(elf == NULL || elf->ops == NULL)
+  {
+    return(0);
+  }
+
+  if(elf->ops->eclass == ELFCLASS32)
+  {
+    return(((Elf32_Ehdr*)elf->header)->e_entry);
+  }
+  return(((Elf64_Ehdr*)elf->header)->e_entry);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_IsBigEndian
+** Description: data encoding of the file (EI_DATA of the identification, the tables may have been converted to
+**              host order but the section contents are read in place)
+** Parameter:   sElf* elf
+** Return:      boolean (FALSE if the context is not opened)
+*******************************************************************************************************************/
+boolean Elf_IsBigEndian(sElf* elf)
+{
+  if(elf == NULL || elf->ops == NULL)
+  {
+    return(FALSE);
+  }
+  return((boolean)(((uint8*)elf->Buffer)[EI_DATA] == ELFDATA2MSB));
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_BuildDirectory
+** Description: build the section directory from the section view, once per image (called by Elf_Open): the name
+**              hash map (first section of each name), the section indexes sorted by type and the SHF_ALLOC
+**              sections sorted by address. The tables are taken from the image arena, the sort keys from the
+**              scratch arena of the calling thread.
+** Parameter:   sElf* elf
+** Return:      boolean (FALSE if out of memory)
+*******************************************************************************************************************/
+static boolean Elf_BuildDirectory(sElf* elf)
+{
+  sElfDirectory* dir      = &elf->dir;
+  sElfSection*   sections = NULL;
+  uint32         count    = 0;
+  uint32         size     = 16;
+  sElfDirKey*    keys     = NULL;
+  sElfDirKey*    tmp      = NULL;
+  sElfDirKey*    sorted   = NULL;
+  sArena*        scratch  = Arena_Thread();
+  sArenaMark     mark     = Arena_Mark(scratch);
+
+  if(!Elf_GetSections(elf, &sections, &count))
+  {
+    return(FALSE);
+  }
+
+  while(size < (count * 2))
+  {
+    size <<= 1;
+  }
+
+  dir->mask        = size - 1;
+  dir->slots       = (uint32*)Arena_Alloc(&elf->arena, (size_t)size * sizeof(uint32));
+  dir->ByType      = (uint32*)Arena_Alloc(&elf->arena, ((size_t)count + 1) * sizeof(uint32));
+  dir->AllocByAddr = (uint32*)Arena_Alloc(&elf->arena, ((size_t)count + 1) * sizeof(uint32));
+  keys             = (sElfDirKey*)Arena_Alloc(scratch, ((size_t)count + 1) * sizeof(sElfDirKey));
+  tmp              = (sElfDirKey*)Arena_Alloc(scratch, ((size_t)count + 1) * sizeof(sElfDirKey));
+
+  if(dir->slots == NULL || dir->ByType == NULL || dir->AllocByAddr == NULL || keys == NULL || tmp == NULL)
+  {
+    Arena_Rewind(scratch, mark);
+    return(FALSE);
+  }
+
+  /* name hash map, a duplicated name keeps its first section */
+  memset(dir->slots, 0xFF, (size_t)size * sizeof(uint32));
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    uint32 slot = Hash_String(sections[i].name) & dir->mask;
+
+    while(dir->slots[slot] != ELF_NO_INDEX && 0 != strcmp(sections[dir->slots[slot]].name, sections[i].name))
+    {
+      slot = (slot + 1) & dir->mask;
+    }
+
+    if(dir->slots[slot] == ELF_NO_INDEX)
+    {
+      dir->slots[slot] = i;
+    }
+  }
+
+  /* sections by type */
+  for(uint32 i = 0; i < count; i++)
+  {
+    keys[i].key   = sections[i].type;
+    keys[i].size  = 0;
+    keys[i].index = i;
+  }
+
+  sorted = Elf_SortDirKeys(keys, tmp, count);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    dir->ByType[i] = sorted[i].index;
+  }
+
+  /* SHF_ALLOC sections by address */
+  dir->AllocNbr = 0;
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    if((sections[i].flags & (uint64)SHF_ALLOC) != 0)
+    {
+      keys[dir->AllocNbr].key   = sections[i].addr;
+      keys[dir->AllocNbr].size  = sections[i].size;
+      keys[dir->AllocNbr].index = i;
+      dir->AllocNbr++;
+    }
+  }
+
+  sorted = Elf_SortDirKeys(keys, tmp, dir->AllocNbr);
+
+  for(uint32 i = 0; i < dir->AllocNbr; i++)
+  {
+    dir->AllocByAddr[i] = sorted[i].index;
+  }
+
+  Arena_Rewind(scratch, mark);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_SortDirKeys
+** Description: stable sort by key, then by size (the keys are filled in section order, so equal keys stay in
+**              section order). LSD radix sort on bytes: the histograms of the 16 digits are counted in one pass
+**              and the digits which are the same for every key (most of the high bytes) cost no pass.
+** Parameter:   sElfDirKey* keys, sElfDirKey* tmp (count entries), uint32 count (the histograms are taken from
+**              the thread arena)
+** Return:      sElfDirKey* (keys or tmp, the one holding the sorted keys)
+*******************************************************************************************************************/
+static sElfDirKey* Elf_SortDirKeys(sElfDirKey* keys, sElfDirKey* tmp, uint32 count)
+{
+  static const uint32 digits = 16U;
+  uint32 (*hist)[256] = NULL;
+
+  if(count < 2)
+  {
+    return(keys);
+  }
+
+  hist = (uint32(*)[256])Arena_Calloc(Arena_Thread(), digits, sizeof(*hist));
+
+  if(hist == NULL)
+  {
+    return(keys);
+  }
+
+  /* digits 0-7: size (least significant), 8-15: key */
+  for(uint32 i = 0; i < count; i++)
+  {
+    for(uint32 d = 0; d < 8U; d++)
+    {
+      hist[d][(keys[i].size >> (8U * d)) & 0xFFU]++;
+      hist[8U + d][(keys[i].key >> (8U * d)) & 0xFFU]++;
+    }
+  }
+
+  for(uint32 d = 0; d < digits; d++)
+  {
+    uint32 shift  = 8U * (d & 7U);
+    uint32 offset = 0;
+
+    if(hist[d][(((d < 8U) ? keys[0].size : keys[0].key) >> shift) & 0xFFU] == count)
+    {
+      continue;
+    }
+
+    for(uint32 b = 0; b < 256U; b++)
+    {
+      uint32 n = hist[d][b];
+
+      hist[d][b] = offset;
+      offset += n;
+    }
+
+    for(uint32 i = 0; i < count; i++)
+    {
+      uint64 value = (d < 8U) ? keys[i].size : keys[i].key;
+
+      tmp[hist[d][(value >> shift) & 0xFFU]++] = keys[i];
+    }
+
+    sElfDirKey* swap = keys;
+    keys = tmp;
+    tmp  = swap;
+  }
+
+  return(keys);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_FindSection
+** Description: look up a section by name in the section directory (first section of that name)
+** Parameter:   sElf* elf, const char* name
+** Return:      sElfSection* (NULL if the section is not found)
+*******************************************************************************************************************/
+sElfSection* Elf_FindSection(sElf* elf, const char* name)
+{
+  sElfDirectory* dir = &elf->dir;
+
+  if(dir->slots == NULL)
+  {
+    return(NULL);
+  }
+
+  for(uint32 slot = Hash_String(name) & dir->mask; dir->slots[slot] != ELF_NO_INDEX; slot = (slot + 1) & dir->mask)
+  {
+    if(0 == strcmp(elf->SectionList[dir->slots[slot]].name, name))
+    {
+      return(&elf->SectionList[dir->slots[slot]]);
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetSectionsOfType
+** Description: get the indexes of the sections of one type, in section order (binary search of the directory)
+** Parameter:   sElf* elf, uint32 type, const uint32** indexes
+** Return:      uint32 (number of sections)
+*******************************************************************************************************************/
+uint32 Elf_GetSectionsOfType(sElf* elf, uint32 type, const uint32** indexes)
+{
+  const uint32* ByType = elf->dir.ByType;
+  uint32        low    = 0;
+  uint32        high   = elf->SectionListNbr;
+  uint32        first  = 0;
+
+  *indexes = NULL;
+
+  if(ByType == NULL)
+  {
+    return(0);
+  }
+
+  /* first section of the type */
+  while(low < high)
+  {
+    uint32 mid = low + ((high - low) / 2);
+
+    if(elf->SectionList[ByType[mid]].type < type)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  first = low;
+
+  /* end of the type */
+  high = elf->SectionListNbr;
+  while(low < high)
+  {
+    uint32 mid = low + ((high - low) / 2);
+
+    if(elf->SectionList[ByType[mid]].type <= type)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  *indexes = &ByType[first];
+  return(low - first);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetAllocSections
+** Description: get the indexes of the SHF_ALLOC sections sorted by address (then by size and index)
+** Parameter:   sElf* elf, const uint32** indexes
+** Return:      uint32 (number of sections)
+*******************************************************************************************************************/
+uint32 Elf_GetAllocSections(sElf* elf, const uint32** indexes)
+{
+  *indexes = elf->dir.AllocByAddr;
+  return((elf->dir.AllocByAddr != NULL) ? elf->dir.AllocNbr : 0);
+}
@@ -1,199 +1,484 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#ifndef __ELF_H__
-#define __ELF_H__
-
-#include<Common.h>
-
-
-#define EI_NIDENT 16
-
-#define ELFCLASSNONE 0U
-#define ELFCLASS32   1U
-#define ELFCLASS64   2U
-
-#define ELFDATANONE 0U
-#define ELFDATA2LSB 1U //Little endian
-#define ELFDATA2MSB 2U //big endian
-
-#define ET_NONE  0U //No file type
-#define ET_REL   1U //Relocatable file
-#define ET_EXEC  2U //Executable file
-
-#define EM_NONE      0U    //Invalid machine
-#define EM_SPARC     2U    //Sun SPARC
-#define EM_386       3U    //Intel 80386
-#define EM_68K       4U    //Freescale 68000
-#define EM_486       6U    //Intel 80486
-#define EM_MIPS      8U    //MIPS
-#define EM_960       19U   //Intel i960
-#define EM_PPC       20U   //Power Architecture
-#define EM_PPC64     21U   //Power Architecture 64-bit mode
-#define EM_V800      36U   //Renesas V800 series
-#define EM_FR20      37U   //Fujitsu FR
-#define EM_MCORE     39U   //Freescale MCore
-#define EM_ARM       40U   //ARM
-#define EM_SH        42U   //Hitachi SH
-#define EM_TRICORE   44U   //Infineon TriCore
-#define EM_COLDFIRE  52U   //Freescale ColdFire
-#define EM_STARCORE  58U   //Freescale StarCore
-#define EM_FIREPATH  78U   //Broadcom FirePath
-#define EM_M32R      88U   //Renesas M32R
-#define EM_BLACKFIN  106U  //ADI Blackfin
-
-#define SHT_NULL       0u
-#define SHT_PROGBITS   1u
-#define SHT_SYMTAB     2u
-#define SHT_STRTAB     3u
-#define SHT_RELA       4u
-#define SHT_NOTE       7u
-#define SHT_NOBITS     8u
-#define SHT_REL        9u
-
-#define STB_LOCAL     0
-#define STB_GLOBAL    1
-#define STB_WEAK      2
-#define STB_NUM       3
-#define STB_LOOS     10
-#define STB_LOPROC   13
-#define STB_HIPROC   15
-
-#define STT_NOTYPE      0
-#define STT_OBJECT      1
-#define STT_FUNC        2
-#define STT_SECTIONS    3
-#define STT_FILE        4
-#define STT_COMMON      5
-#define STT_TLS         6
-#define STT_NUM         7
-#define STT_LOOS       10
-#define STT_HIOS       12
-#define STT_LOPROC     13
-#define STT_HIPROC     15
-
-#define TYP_UNKNOWN_ELF     0
-#define TYP_RELOCATABLE_ELF 1
-#define TYP_EXECUTABLE_ELF  2
-
-#define SHF_WRITE     1
-#define SHF_ALLOC     2
-#define SHF_EXECU     4
-
-#define ELF32_ST_BIND(x)   (Elf32_Byte)((x)>>4)
-#define ELF32_ST_TYPE(x)   (Elf32_Byte)((x) & 0x0f)
-
-typedef unsigned char  Elf32_Byte;
-typedef unsigned long  Elf32_Addr;
-typedef unsigned short Elf32_Half;
-typedef unsigned long  Elf32_Off;
-typedef signed long    Elf32_Sword;
-typedef unsigned long  Elf32_Word;
-
-
-//ELF header struct
-typedef struct {
-  Elf32_Byte e_ident[EI_NIDENT];    //Identifies the file as an ELF file and provides machine-independent data to decode the contents.
-  Elf32_Half e_type;                //Identifies the ELF file type.
-  Elf32_Half e_machine;             //Specifies the target architecture for an individual file.
-  Elf32_Word e_version;             //Identifies the ELF file version.
-  Elf32_Addr e_entry;               //Specifies the virtual address to which the system first transfers control upon starting the process.
-  Elf32_Off  e_phoff;               //Specifies the program header table's file offset in bytes. Otherwise, this field contains zero.
-  Elf32_Off  e_shoff;               //Specifies the section header table's file offset in bytes. Otherwise, this field contains zero.
-  Elf32_Word e_flags;               //Specifies processor-specific flags associated with the file.
-  Elf32_Half e_ehsize;              //Specifies the ELF header size in bytes.
-  Elf32_Half e_phentsize;           //Specifies the size in bytes of one entry in the file's program header table.
-  Elf32_Half e_phnum;               //Specifies the number of entries in the program header table.
-  Elf32_Half e_shentsize;           //Specifies the section header's size in bytes.
-  Elf32_Half e_shnum;               //Specifies the number of entries in the section header table.
-  Elf32_Half e_shstrndx;            //Specifies the index of the section containing the string table used for section names.
-} Elf32_Ehdr;
-
-
-//section header structure
-typedef struct {
-  Elf32_Word sh_name;              //Specifies the name of the section. Its value is an index into the section header string table section
-  Elf32_Word sh_type;              //Specifies the section's contents and semantics.
-  Elf32_Word sh_flags;             //Specifies 1-bit flags that describe miscellaneous attributes of the section.
-  Elf32_Addr sh_addr;              //Specifies the address at which the section's first byte should reside. Otherwise, this field contains zero. (Physical address)
-  Elf32_Off  sh_offset;            //Specifies the byte offset from the beginning of the file to the first byte in the section.
-  Elf32_Word sh_size;              //Specifies the section's size in bytes.
-  Elf32_Word sh_link;              //Contains a section header table index link, whose interpretation depends on the section type.
-  Elf32_Word sh_info;              //Contains extra information, whose interpretation depends on the section type.
-  Elf32_Word sh_addralign;         //Some sections have address alignment constraints.
-  Elf32_Word sh_entsize;           //Some sections contain a table of fixed-size entries, such as a symbol table.
-} Elf32_Shdr;
-
-//program header struct
-typedef struct {
-  Elf32_Word p_type;              //The kind of segment this array element describes and how to interpret the array element's information.
-  Elf32_Off  p_offset;            //Offset from the beginning of the file at which the first byte of the segment resides.
-  Elf32_Addr p_vaddr;             //Address at which the first byte of the segment resides in memory.
-  Elf32_Addr p_paddr;             //For targets where physical addressing is relevant, this field gives the segment's physical address.
-  Elf32_Word p_filesz;            //Number of bytes in the file image of the segment; it may be zero.
-  Elf32_Word p_memsz;             //Number of bytes in the memory image of the segment; it may be zero.
-  Elf32_Word p_flags;             //Flags relevant to the segment.
-  Elf32_Word p_align;             //This field specifies the value to which the segments are aligned in memory and in the file.
-} Elf32_Phdr;
-
-//symbol table struct
-typedef struct {
-  Elf32_Word st_name;             //Contains an index into the file's symbol string table
-  Elf32_Addr st_value;            //Specifies the associated symbol's value.
-  Elf32_Word st_size;             //Many symbols have associated sizes.
-  Elf32_Byte st_info;             //Specifies the symbol's binding attributes and type.
-  Elf32_Byte st_other;            //Contains the value zero and has no defined meaning. (Pad)
-  Elf32_Half st_shndx;            //Every symbol table entry is defined in relation to some section. this field contains the relevant section header table index.
-} Elf32_Sym;
-
-typedef struct
-{
-  uint32 machine;
-  char const * const  name;
-}sMachine;
-
-typedef struct
-{
-  uint32 type;
-  char const * const name;
-}sSectionType;
-
-
-typedef struct
-{
-  Elf32_Byte code;
-  char const * const name;
-}sSymTabBind;
-
-typedef struct
-{
-  Elf32_Byte code;
-  char const * const name;
-}sSymTabType;
-
-
-typedef struct
-{
-  uint32 code;
-  char   name;
-}sSectionAttr;
-
-
-typedef struct
-{
-  uint32 code;
-  char const * const name;
-}sElfType;
-
-boolean Elf_ProcessElfHeader(char* Buffer, boolean PrintInfo);
-boolean Elf_SectionHeaderTable(char* Buffer);
-boolean Elf_SymbolTable(char* Buffer);
-boolean Elf_ExtractBinaryToC(char* Buffer, char* path);
-boolean Elf_ExtractBinaryToS19(char* Buffer, char* path);
-boolean Elf_SearchInfo(char* Buffer, char* Symbol);
-boolean Elf_ListSrcFiles(char* Buffer);
-#endif
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __ELF_H__
+#define __ELF_H__
+
+#include<common.h>
+#include<Arena.h>
+
+
+#define EI_NIDENT 16
+#define EI_DATA   5U
+
+#define ELFCLASSNONE 0U
+#define ELFCLASS32   1U
+#define ELFCLASS64   2U
+
+#define ELFDATANONE 0U
+#define ELFDATA2LSB 1U //Little endian
+#define ELFDATA2MSB 2U //big endian
+
+#define ET_NONE  0U //No file type
+#define ET_REL   1U //Relocatable file
+#define ET_EXEC  2U //Executable file
+
+#define EV_CURRENT 1U //Current ELF version
+
+#define EM_NONE      0U    //Invalid machine
+#define EM_SPARC     2U    //Sun SPARC
+#define EM_386       3U    //Intel 80386
+#define EM_68K       4U    //Freescale 68000
+#define EM_486       6U    //Intel 80486
+#define EM_MIPS      8U    //MIPS
+#define EM_960       19U   //Intel i960
+#define EM_PPC       20U   //Power Architecture
+#define EM_PPC64     21U   //Power Architecture 64-bit mode
+#define EM_V800      36U   //Renesas V800 series
+#define EM_FR20      37U   //Fujitsu FR
+#define EM_MCORE     39U   //Freescale MCore
+#define EM_ARM       40U   //ARM
+#define EM_SH        42U   //Hitachi SH
+#define EM_TRICORE   44U   //Infineon TriCore
+#define EM_COLDFIRE  52U   //Freescale ColdFire
+#define EM_STARCORE  58U   //Freescale StarCore
+#define EM_FIREPATH  78U   //Broadcom FirePath
+#define EM_M32R      88U   //Renesas M32R
+#define EM_V850      87U   //Renesas V850 (GNU)
+#define EM_BLACKFIN  106U  //ADI Blackfin
+#define EM_X86_64    62U   //AMD x86-64
+#define EM_AARCH64   183U  //ARM 64-bit
+#define EM_RISCV     243U  //RISC-V
+
+#define SHT_NULL       0u
+#define SHT_PROGBITS   1u
+#define SHT_SYMTAB     2u
+#define SHT_STRTAB     3u
+#define SHT_RELA       4u
+#define SHT_NOTE       7u
+#define SHT_NOBITS     8u
+#define SHT_REL        9u
+#define SHT_DYNSYM     11u
+#define SHT_SYMTAB_SHNDX 18u
+
+#define SHN_UNDEF      0u
+#define SHN_LORESERVE  0xFF00u          //first reserved index (SHN_ABS, SHN_COMMON...)
+#define SHN_XINDEX     0xFFFFu          //the index is held elsewhere: section 0 (e_shnum/e_shstrndx) or SHT_SYMTAB_SHNDX
+
+#define STB_LOCAL     0
+#define STB_GLOBAL    1
+#define STB_WEAK      2
+#define STB_NUM       3
+#define STB_LOOS     10
+#define STB_LOPROC   13
+#define STB_HIPROC   15
+
+#define STT_NOTYPE      0
+#define STT_OBJECT      1
+#define STT_FUNC        2
+#define STT_SECTIONS    3
+#define STT_FILE        4
+#define STT_COMMON      5
+#define STT_TLS         6
+#define STT_NUM         7
+#define STT_LOOS       10
+#define STT_HIOS       12
+#define STT_LOPROC     13
+#define STT_HIPROC     15
+
+#define TYP_UNKNOWN_ELF     0
+#define TYP_RELOCATABLE_ELF 1
+#define TYP_EXECUTABLE_ELF  2
+#define TYP_SHARED_ELF      3
+#define TYP_CORE_ELF        4
+
+#define SHF_WRITE     1
+#define SHF_ALLOC     2
+#define SHF_EXECU     4
+#define SHF_TLS       0x400
+
+#define PT_NULL       0
+#define PT_LOAD       1
+
+#define PF_X          1
+#define PF_W          2
+#define PF_R          4
+
+//loadable content of the image: the sections exported by -s19/-c and hashed by -hash
+#define ELF_IS_LOAD_SECTION(type, flags, size)  ((((flags) & (uint64)SHF_ALLOC) == (uint64)SHF_ALLOC) && \
+                                                 ((type) == SHT_PROGBITS) && ((size) > 0))
+
+#define ELF32_ST_BIND(x)   (Elf32_Byte)((x)>>4)
+#define ELF32_ST_TYPE(x)   (Elf32_Byte)((x) & 0x0f)
+
+#define ELF64_ST_BIND(x)   ELF32_ST_BIND(x)
+#define ELF64_ST_TYPE(x)   ELF32_ST_TYPE(x)
+
+#define ELF32_R_SYM(i)     (uint32)((i) >> 8)
+#define ELF32_R_TYPE(i)    (uint32)((i) & 0xffUL)
+#define ELF64_R_SYM(i)     (uint32)((i) >> 32)
+#define ELF64_R_TYPE(i)    (uint32)((i) & 0xffffffffULL)
+
+typedef uint8  Elf32_Byte;
+typedef uint32 Elf32_Addr;
+typedef uint16 Elf32_Half;
+typedef uint32 Elf32_Off;
+typedef sint32 Elf32_Sword;
+typedef uint32 Elf32_Word;
+
+typedef uint8  Elf64_Byte;
+typedef uint64 Elf64_Addr;
+typedef uint16 Elf64_Half;
+typedef uint64 Elf64_Off;
+typedef sint32 Elf64_Sword;
+typedef uint32 Elf64_Word;
+typedef uint64 Elf64_Xword;
+typedef sint64 Elf64_Sxword;
+
+
+//ELF header struct
+typedef struct {
+  Elf32_Byte e_ident[EI_NIDENT];    //Identifies the file as an ELF file and provides machine-independent data to decode the contents.
+  Elf32_Half e_type;                //Identifies the ELF file type.
+  Elf32_Half e_machine;             //Specifies the target architecture for an individual file.
+  Elf32_Word e_version;             //Identifies the ELF file version.
+  Elf32_Addr e_entry;               //Specifies the virtual address to which the system first transfers control upon starting the process.
+  Elf32_Off  e_phoff;               //Specifies the program header table's file offset in bytes. Otherwise, this field contains zero.
+  Elf32_Off  e_shoff;               //Specifies the section header table's file offset in bytes. Otherwise, this field contains zero.
+  Elf32_Word e_flags;               //Specifies processor-specific flags associated with the file.
+  Elf32_Half e_ehsize;              //Specifies the ELF header size in bytes.
+  Elf32_Half e_phentsize;           //Specifies the size in bytes of one entry in the file's program header table.
+  Elf32_Half e_phnum;               //Specifies the number of entries in the program header table.
+  Elf32_Half e_shentsize;           //Specifies the section header's size in bytes.
+  Elf32_Half e_shnum;               //Specifies the number of entries in the section header table.
+  Elf32_Half e_shstrndx;            //Specifies the index of the section containing the string table used for section names.
+} Elf32_Ehdr;
+
+
+//section header structure
+typedef struct {
+  Elf32_Word sh_name;              //Specifies the name of the section. Its value is an index into the section header string table section
+  Elf32_Word sh_type;              //Specifies the section's contents and semantics.
+  Elf32_Word sh_flags;             //Specifies 1-bit flags that describe miscellaneous attributes of the section.
+  Elf32_Addr sh_addr;              //Specifies the address at which the section's first byte should reside. Otherwise, this field contains zero. (Physical address)
+  Elf32_Off  sh_offset;            //Specifies the byte offset from the beginning of the file to the first byte in the section.
+  Elf32_Word sh_size;              //Specifies the section's size in bytes.
+  Elf32_Word sh_link;              //Contains a section header table index link, whose interpretation depends on the section type.
+  Elf32_Word sh_info;              //Contains extra information, whose interpretation depends on the section type.
+  Elf32_Word sh_addralign;         //Some sections have address alignment constraints.
+  Elf32_Word sh_entsize;           //Some sections contain a table of fixed-size entries, such as a symbol table.
+} Elf32_Shdr;
+
+//program header struct
+typedef struct {
+  Elf32_Word p_type;              //The kind of segment this array element describes and how to interpret the array element's information.
+  Elf32_Off  p_offset;            //Offset from the beginning of the file at which the first byte of the segment resides.
+  Elf32_Addr p_vaddr;             //Address at which the first byte of the segment resides in memory.
+  Elf32_Addr p_paddr;             //For targets where physical addressing is relevant, this field gives the segment's physical address.
+  Elf32_Word p_filesz;            //Number of bytes in the file image of the segment; it may be zero.
+  Elf32_Word p_memsz;             //Number of bytes in the memory image of the segment; it may be zero.
+  Elf32_Word p_flags;             //Flags relevant to the segment.
+  Elf32_Word p_align;             //This field specifies the value to which the segments are aligned in memory and in the file.
+} Elf32_Phdr;
+
+//symbol table struct
+typedef struct {
+  Elf32_Word st_name;             //Contains an index into the file's symbol string table
+  Elf32_Addr st_value;            //Specifies the associated symbol's value.
+  Elf32_Word st_size;             //Many symbols have associated sizes.
+  Elf32_Byte st_info;             //Specifies the symbol's binding attributes and type.
+  Elf32_Byte st_other;            //Contains the value zero and has no defined meaning. (Pad)
+  Elf32_Half st_shndx;            //Every symbol table entry is defined in relation to some section. this field contains the relevant section header table index.
+} Elf32_Sym;
+
+//relocation entries
+typedef struct {
+  Elf32_Addr  r_offset;           //Location at which to apply the relocation action.
+  Elf32_Word  r_info;             //Symbol table index and type of relocation to apply.
+} Elf32_Rel;
+
+typedef struct {
+  Elf32_Addr  r_offset;
+  Elf32_Word  r_info;
+  Elf32_Sword r_addend;           //Constant addend used to compute the value to be stored.
+} Elf32_Rela;
+
+//ELF64 header struct
+typedef struct {
+  Elf64_Byte  e_ident[EI_NIDENT];
+  Elf64_Half  e_type;
+  Elf64_Half  e_machine;
+  Elf64_Word  e_version;
+  Elf64_Addr  e_entry;
+  Elf64_Off   e_phoff;
+  Elf64_Off   e_shoff;
+  Elf64_Word  e_flags;
+  Elf64_Half  e_ehsize;
+  Elf64_Half  e_phentsize;
+  Elf64_Half  e_phnum;
+  Elf64_Half  e_shentsize;
+  Elf64_Half  e_shnum;
+  Elf64_Half  e_shstrndx;
+} Elf64_Ehdr;
+
+//ELF64 section header structure
+typedef struct {
+  Elf64_Word  sh_name;
+  Elf64_Word  sh_type;
+  Elf64_Xword sh_flags;
+  Elf64_Addr  sh_addr;
+  Elf64_Off   sh_offset;
+  Elf64_Xword sh_size;
+  Elf64_Word  sh_link;
+  Elf64_Word  sh_info;
+  Elf64_Xword sh_addralign;
+  Elf64_Xword sh_entsize;
+} Elf64_Shdr;
+
+//ELF64 program header struct (p_flags moves up next to p_type)
+typedef struct {
+  Elf64_Word  p_type;
+  Elf64_Word  p_flags;
+  Elf64_Off   p_offset;
+  Elf64_Addr  p_vaddr;
+  Elf64_Addr  p_paddr;
+  Elf64_Xword p_filesz;
+  Elf64_Xword p_memsz;
+  Elf64_Xword p_align;
+} Elf64_Phdr;
+
+//ELF64 symbol table struct (st_value/st_size move behind st_shndx)
+typedef struct {
+  Elf64_Word  st_name;
+  Elf64_Byte  st_info;
+  Elf64_Byte  st_other;
+  Elf64_Half  st_shndx;
+  Elf64_Addr  st_value;
+  Elf64_Xword st_size;
+} Elf64_Sym;
+
+typedef struct {
+  Elf64_Addr   r_offset;
+  Elf64_Xword  r_info;
+} Elf64_Rel;
+
+typedef struct {
+  Elf64_Addr   r_offset;
+  Elf64_Xword  r_info;
+  Elf64_Sxword r_addend;
+} Elf64_Rela;
+
+typedef struct
+{
+  uint32 machine;
+  char const * const  name;
+}sMachine;
+
+typedef struct
+{
+  uint32 type;
+  char const * const name;
+}sSectionType;
+
+
+typedef struct
+{
+  Elf32_Byte code;
+  char const * const name;
+}sSymTabBind;
+
+typedef struct
+{
+  Elf32_Byte code;
+  char const * const name;
+}sSymTabType;
+
+
+typedef struct
+{
+  uint32 code;
+  char   name;
+}sSectionAttr;
+
+
+typedef struct
+{
+  uint32 code;
+  char const * const name;
+}sElfType;
+
+//relocation section being decoded
+typedef struct
+{
+  uint32 index;                   //relocation section index
+  char*  name;                    //relocation section name
+  char*  TargetName;              //name of the section the relocations apply to (sh_info)
+  uint32 symtab;                  //index of the linked symbol table (sh_link)
+  uint32 count;                   //number of entries in the section
+  uint32 machine;                 //e_machine of the file
+  boolean rela;                   //entries carry an explicit addend
+}sElfRelocSection;
+
+//one decoded relocation entry (host order, class independent)
+typedef struct
+{
+  uint64 offset;
+  sint64 addend;
+  uint32 type;
+  uint32 sym;
+  char*  SymName;
+}sElfReloc;
+
+#define ELF_RELOC_BATCH_SIZE  256U
+
+typedef void (*pfElfRelocBatch)(const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx);
+
+//one section of an image, host order and class independent (see Elf_GetSections)
+typedef struct
+{
+  char*  name;
+  uint32 type;
+  uint64 flags;
+  uint64 addr;
+  uint64 size;
+  char*  data;                    //section content in the file (NULL for NOBITS sections)
+}sElfSection;
+
+//one symbol of an image, host order and class independent (see Elf_GetSymbols)
+typedef struct
+{
+  char*  name;
+  uint64 value;
+  uint64 size;
+  uint8  info;
+  uint32 shndx;                   //section index, extended indices resolved (ELF_SHN_RESERVED | st_shndx for a reserved one)
+  char*  data;                    //symbol content in the file (NULL if the symbol has no file data)
+}sElfSymbol;
+
+//one segment (program header) of an image, host order and class independent (see Elf_GetSegments)
+typedef struct
+{
+  uint32 type;
+  uint32 flags;
+  uint64 offset;
+  uint64 vaddr;                   //run address
+  uint64 paddr;                   //load address
+  uint64 filesz;
+  uint64 memsz;
+}sElfSegment;
+
+//reasons of an Elf_Open failure, found by the validation pass of the class specializations
+typedef enum
+{
+  ELF_OK = 0,
+  ELF_ERR_NOT_ELF,                //bad identification or file shorter than the identification
+  ELF_ERR_CLASS,                  //unsupported class or data encoding
+  ELF_ERR_HEADER,                 //file shorter than the ELF header
+  ELF_ERR_SHDR_TABLE,             //section header table out of the file or bad e_shentsize
+  ELF_ERR_PHDR_TABLE,             //program header table out of the file or bad e_phentsize
+  ELF_ERR_SHSTRNDX,               //e_shstrndx is not a string table section
+  ELF_ERR_SECTION_RANGE,          //section content out of the file
+  ELF_ERR_STRTAB,                 //string table out of the file or not terminated
+  ELF_ERR_SECTION_NAME,           //sh_name out of the section names string table
+  ELF_ERR_TABLE_SIZE,             //symbol/relocation table size is not a multiple of the entry size
+  ELF_ERR_TABLE_LINK,             //sh_link of a symbol/relocation table is not a table of the expected type
+  ELF_ERR_SYMBOL_NAME,            //st_name out of the symbol names string table
+  ELF_ERR_NO_MEMORY               //an aligned table copy or the section directory could not be allocated
+}eElfError;
+
+#define ELF_NO_INDEX  0xFFFFFFFFUL
+#define ELF_SHN_RESERVED  0xFFFF0000UL   //sElfSymbol.shndx of a reserved st_shndx, above every section index
+
+//section directory of an image, built once by Elf_Open from the section view (see Elf_FindSection,
+//Elf_GetSectionsOfType and Elf_GetAllocSections)
+typedef struct
+{
+  uint32* slots;                  //name hash map: first section of each name (ELF_NO_INDEX for an empty slot)
+  uint32  mask;
+  uint32* ByType;                 //section indexes sorted by type, then by index
+  uint32* AllocByAddr;            //indexes of the SHF_ALLOC sections sorted by address, then by size and index
+  uint32  AllocNbr;
+}sElfDirectory;
+
+typedef struct sElf sElf;
+
+//operations specialized for one ELF class/data encoding pair (see Elf_Class.h)
+typedef struct
+{
+  uint32 eclass;
+  uint32 edata;
+  eElfError (*Validate)(sElf* elf);
+  void    (*Open)(sElf* elf);
+  void    (*PrintHeader)(sElf* elf);
+  boolean (*SectionHeaderTable)(sElf* elf);
+  boolean (*SymbolTable)(sElf* elf);
+  boolean (*ExtractBinaryToC)(sElf* elf, char* path);
+  boolean (*ExtractBinaryToS19)(sElf* elf, char* path);
+  boolean (*SearchInfo)(sElf* elf, char* Symbol);
+  boolean (*WalkRelocations)(sElf* elf, pfElfRelocBatch callback, void* ctx);
+  boolean (*FindSymbolIndex)(sElf* elf, uint32 symtab, const char* name, uint32* index);
+  boolean (*GetSections)(sElf* elf, sElfSection** sections, uint32* count);
+  boolean (*GetSymbols)(sElf* elf, sElfSymbol** symbols, uint32* count);
+  boolean (*GetSegments)(sElf* elf, sElfSegment** segments, uint32* count);
+}sElfClassOps;
+
+//parser context of one ELF image. The parser keeps no other state, so each thread can work on its own context.
+struct sElf
+{
+  char*               Buffer;             //file content
+  uint32              size;               //file size in bytes
+  boolean             owner;              //Buffer was loaded by Elf_Load and is freed by Elf_Close
+  const sElfClassOps* ops;                //operations selected by Elf_Open
+  char*               header;             //ELF header (host order)
+  char*               sections;           //section header table (host order)
+  char*               segments;           //program header table (host order, NULL if the file has none)
+  char*               names;              //section names string table
+  char*               NativeEhdr;         //host order copies of the header and tables of a big endian file
+  char*               NativeShdr;         //(NULL when the file is read in place)
+  char*               NativePhdr;
+  char**              NativeTables;
+  uint32              NativeTablesNbr;
+  char**              AlignedTables;      //copies of the tables not aligned in Buffer (NULL if every table is read in place)
+  uint32              SectionsNbr;        //section count (e_shnum, or sh_size of section 0 for extended numbering)
+  uint32              ShStrNdx;           //section names string table (e_shstrndx, or sh_link of section 0)
+  uint32              SymTab;             //section index of the symbol table (0 if none)
+  sElfSection*        SectionList;        //class independent views built on the first request (see Elf_GetSections)
+  uint32              SectionListNbr;
+  sElfSymbol*         SymbolList;
+  uint32              SymbolListNbr;
+  sElfSegment*        SegmentList;
+  uint32              SegmentListNbr;
+  sElfDirectory       dir;
+  sArena              arena;              //owns every structure derived from the image, released by Elf_Close
+  eElfError           ErrorCode;          //reason of an Elf_Open failure (ELF_OK if opened)
+  uint32              ErrorSection;       //faulty section (ELF_NO_INDEX if the failure is not tied to a section)
+  uint32              ErrorEntry;         //faulty entry of that section (ELF_NO_INDEX if none)
+  const char*         error;              //text of ErrorCode (NULL if opened)
+};
+
+boolean Elf_Open(sElf* elf, char* Buffer, uint32 size);
+boolean Elf_Load(sElf* elf, char* path);
+void    Elf_Close(sElf* elf);
+void    Elf_PrintError(sElf* elf);
+void    Elf_PrintHeader(sElf* elf);
+boolean Elf_SectionHeaderTable(sElf* elf);
+boolean Elf_SymbolTable(sElf* elf);
+boolean Elf_ExtractBinaryToC(sElf* elf, char* path);
+boolean Elf_ExtractBinaryToS19(sElf* elf, char* path);
+boolean Elf_SearchInfo(sElf* elf, char* Symbol);
+boolean Elf_ListSrcFiles(sElf* elf);
+boolean Elf_WalkRelocations(sElf* elf, pfElfRelocBatch callback, void* ctx);
+boolean Elf_FindSymbolIndex(sElf* elf, uint32 symtab, const char* name, uint32* index);
+boolean Elf_GetSections(sElf* elf, sElfSection** sections, uint32* count);
+boolean Elf_GetSymbols(sElf* elf, sElfSymbol** symbols, uint32* count);
+boolean Elf_GetSegments(sElf* elf, sElfSegment** segments, uint32* count);
+uint64  Elf_GetEntry(sElf* elf);
+boolean Elf_IsBigEndian(sElf* elf);
+sElfSection* Elf_FindSection(sElf* elf, const char* name);
+uint32  Elf_GetSectionsOfType(sElf* elf, uint32 type, const uint32** indexes);
+uint32  Elf_GetAllocSections(sElf* elf, const uint32** indexes);
+#endif
@@ -0,0 +1,909 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Class/endian specialized ELF operations.
+**
+** This file has no include guard on purpose: Elf.c includes it once for each supported pair of
+** {ELFCLASS32, ELFCLASS64} x {ELFDATA2LSB, ELFDATA2MSB}. Before each inclusion the includer defines:
+**
+**   ELF_CLASS_BITS : 32 or 64
+**   ELF_CLASS_MSB  : 0 (little endian file) or 1 (big endian file)
+**   ELF_FN(name)   : the name of the specialized function (e.g. Elf32L_##name)
+**
+** Field accessors are resolved by the preprocessor, so the generated code has no runtime branch per field.
+** The host is assumed to be little endian (x86/x64 build hosts).
+*******************************************************************************************************************/
+
+#if (ELF_CLASS_BITS == 32)
+  #define ELF_T(type)   Elf32_##type
+  #define ELF_CLASS     ELFCLASS32
+  #define ELF_R_SYM     ELF32_R_SYM
+  #define ELF_R_TYPE    ELF32_R_TYPE
+  #define ELF_SA(x)     ((sint64)(sint32)(uint32)ELF_A(x))
+#else
+  #define ELF_T(type)   Elf64_##type
+  #define ELF_CLASS     ELFCLASS64
+  #define ELF_R_SYM     ELF64_R_SYM
+  #define ELF_R_TYPE    ELF64_R_TYPE
+  #define ELF_SA(x)     ((sint64)ELF_A(x))
+#endif
+
+#if (ELF_CLASS_MSB == 1)
+  #define ELF_DATA      ELFDATA2MSB
+  #define ELF_H(x)      Elf_Swap16(x)
+  #define ELF_W(x)      Elf_Swap32(x)
+  #if (ELF_CLASS_BITS == 32)
+    #define ELF_A(x)    ((uint64)Elf_Swap32(x))
+  #else
+    #define ELF_A(x)    Elf_Swap64(x)
+  #endif
+#else
+  #define ELF_DATA      ELFDATA2LSB
+  #define ELF_H(x)      ((uint16)(x))
+  #define ELF_W(x)      ((uint32)(x))
+  #define ELF_A(x)      ((uint64)(x))
+#endif
+
+#define EHDR    ((ELF_T(Ehdr)*)elf->header)
+#define SHDR    ((ELF_T(Shdr)*)elf->sections)
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(InFile)
+** Description: check that the range [offset, offset + size) lies inside the file (without overflow)
+** Parameter:   sElf* elf, uint64 offset, uint64 size
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(InFile)(sElf* elf, uint64 offset, uint64 size)
+{
+  return((boolean)(offset <= (uint64)elf->size && size <= (uint64)elf->size - offset));
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(CheckStrTab)
+** Description: check that a section is a string table inside the file and ends with a '\0', so that every
+**              string starting at an index below its size is terminated inside the table
+** Parameter:   sElf* elf, uint32 index
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(CheckStrTab)(sElf* elf, uint32 index)
+{
+  uint64 offset = ELF_A(SHDR[index].sh_offset);
+  uint64 size   = ELF_A(SHDR[index].sh_size);
+
+  return((boolean)(ELF_W(SHDR[index].sh_type) == SHT_STRTAB &&
+                   size > 0                                 &&
+                   ELF_FN(InFile)(elf, offset, size)        &&
+                   elf->Buffer[(size_t)(offset + size - 1)] == '\0'));
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(SectionTable)
+** Description: get the entries of a table section (host order copy, then aligned copy, when present)
+** Parameter:   sElf* elf, uint32 index
+** Return:      char*
+*******************************************************************************************************************/
+static char* ELF_FN(SectionTable)(sElf* elf, uint32 index)
+{
+  if(elf->NativeTables != NULL && index < elf->NativeTablesNbr && elf->NativeTables[index] != NULL)
+  {
+    return(elf->NativeTables[index]);
+  }
+
+  if(elf->AlignedTables != NULL && index < elf->SectionsNbr && elf->AlignedTables[index] != NULL)
+  {
+    return(elf->AlignedTables[index]);
+  }
+  return(elf->Buffer + (size_t)ELF_A(SHDR[index].sh_offset));
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(AlignSectionTable)
+** Description: copy a table section which is not aligned in the file (see Elf_AlignedTable), the range has been
+**              checked
+** Parameter:   sElf* elf, uint32 index
+** Return:      boolean (FALSE if the copy could not be allocated)
+*******************************************************************************************************************/
+static boolean ELF_FN(AlignSectionTable)(sElf* elf, uint32 index)
+{
+  uint64 offset = ELF_A(SHDR[index].sh_offset);
+  uint64 size   = ELF_A(SHDR[index].sh_size);
+  char*  table  = Elf_AlignedTable(elf, offset, size);
+
+  if(table == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(table != elf->Buffer + (size_t)offset)
+  {
+    if(elf->AlignedTables == NULL)
+    {
+      elf->AlignedTables = (char**)Arena_Calloc(&elf->arena, (size_t)elf->SectionsNbr + 1, sizeof(char*));
+    }
+
+    if(elf->AlignedTables == NULL)
+    {
+      return(FALSE);
+    }
+    elf->AlignedTables[index] = table;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(Validate)
+** Description: check once every offset, size and string index the operations dereference against the file size:
+**              the header, the program and section header tables, the section ranges, the section names, the
+**              symbol tables (entry size, linked string table and every st_name) and the relocation tables (entry
+**              size and linked symbol table). The file is read in place, before any host order conversion; the
+**              headers and tables which are not aligned in it are read from copies (see Elf_AlignedTable).
+**              Extended section numbering (e_shnum 0, e_shstrndx SHN_XINDEX) is resolved from section 0.
+**              On success the operations can read the tables without further checks. The faulty section and
+**              entry are left in the context.
+** Parameter:   sElf* elf
+** Return:      eElfError
+*******************************************************************************************************************/
+static eElfError ELF_FN(Validate)(sElf* elf)
+{
+  if((uint64)elf->size < sizeof(ELF_T(Ehdr)))
+  {
+    return(ELF_ERR_HEADER);
+  }
+
+  elf->header = Elf_AlignedTable(elf, 0, sizeof(ELF_T(Ehdr)));
+
+  if(elf->header == NULL)
+  {
+    return(ELF_ERR_NO_MEMORY);
+  }
+
+  uint32 phnum = ELF_H(EHDR->e_phnum);
+
+  if(phnum != 0 && (ELF_H(EHDR->e_phentsize) != sizeof(ELF_T(Phdr)) ||
+                    !ELF_FN(InFile)(elf, ELF_A(EHDR->e_phoff), (uint64)phnum * sizeof(ELF_T(Phdr)))))
+  {
+    return(ELF_ERR_PHDR_TABLE);
+  }
+
+  if(phnum != 0 && NULL == (elf->segments = Elf_AlignedTable(elf, ELF_A(EHDR->e_phoff), (uint64)phnum * sizeof(ELF_T(Phdr)))))
+  {
+    return(ELF_ERR_NO_MEMORY);
+  }
+
+  uint64 shnum    = ELF_H(EHDR->e_shnum);
+  uint32 shstrndx = ELF_H(EHDR->e_shstrndx);
+  uint64 shoff    = ELF_A(EHDR->e_shoff);
+
+  if(shnum == 0 && shoff == 0)
+  {
+    return(ELF_OK);
+  }
+
+  if(ELF_H(EHDR->e_shentsize) != sizeof(ELF_T(Shdr)) || !ELF_FN(InFile)(elf, shoff, sizeof(ELF_T(Shdr))))
+  {
+    return(ELF_ERR_SHDR_TABLE);
+  }
+
+  elf->sections = Elf_AlignedTable(elf, shoff, sizeof(ELF_T(Shdr)));
+
+  if(elf->sections == NULL)
+  {
+    return(ELF_ERR_NO_MEMORY);
+  }
+
+  /* extended section numbering: the real count and names index are held by section 0 */
+  if(shnum == 0)
+  {
+    shnum = ELF_A(SHDR[0].sh_size);
+  }
+
+  if(shstrndx == SHN_XINDEX)
+  {
+    shstrndx = ELF_W(SHDR[0].sh_link);
+  }
+
+  if(shnum == 0 || shnum > (uint64)elf->size / sizeof(ELF_T(Shdr)) || !ELF_FN(InFile)(elf, shoff, shnum * sizeof(ELF_T(Shdr))))
+  {
+    return(ELF_ERR_SHDR_TABLE);
+  }
+
+  elf->SectionsNbr = (uint32)shnum;
+  elf->ShStrNdx    = shstrndx;
+  elf->sections    = Elf_AlignedTable(elf, shoff, shnum * sizeof(ELF_T(Shdr)));
+
+  if(elf->sections == NULL)
+  {
+    return(ELF_ERR_NO_MEMORY);
+  }
+
+  if(shstrndx >= shnum)
+  {
+    elf->ErrorSection = shstrndx;
+    return(ELF_ERR_SHSTRNDX);
+  }
+
+  if(!ELF_FN(CheckStrTab)(elf, shstrndx))
+  {
+    elf->ErrorSection = shstrndx;
+    return((ELF_W(SHDR[shstrndx].sh_type) == SHT_STRTAB) ? ELF_ERR_STRTAB : ELF_ERR_SHSTRNDX);
+  }
+
+  uint64 NamesSize = ELF_A(SHDR[shstrndx].sh_size);
+
+  for(uint32 i = 0; i < elf->SectionsNbr; i++)
+  {
+    uint32 type = ELF_W(SHDR[i].sh_type);
+    uint64 size = ELF_A(SHDR[i].sh_size);
+    uint32 link = ELF_W(SHDR[i].sh_link);
+
+    elf->ErrorSection = i;
+
+    if(type != SHT_NOBITS && type != SHT_NULL && !ELF_FN(InFile)(elf, ELF_A(SHDR[i].sh_offset), size))
+    {
+      return(ELF_ERR_SECTION_RANGE);
+    }
+
+    if((type == SHT_SYMTAB || type == SHT_DYNSYM || type == SHT_SYMTAB_SHNDX || type == SHT_REL || type == SHT_RELA) &&
+       !ELF_FN(AlignSectionTable)(elf, i))
+    {
+      return(ELF_ERR_NO_MEMORY);
+    }
+
+    if((uint64)ELF_W(SHDR[i].sh_name) >= NamesSize)
+    {
+      return(ELF_ERR_SECTION_NAME);
+    }
+
+    if(type == SHT_SYMTAB || type == SHT_DYNSYM)
+    {
+      ELF_T(Sym)* sym    = (ELF_T(Sym)*)ELF_FN(SectionTable)(elf, i);
+      uint64      symnbr = size / sizeof(ELF_T(Sym));
+
+      if((size % sizeof(ELF_T(Sym))) != 0)
+      {
+        return(ELF_ERR_TABLE_SIZE);
+      }
+
+      if(link >= shnum || !ELF_FN(CheckStrTab)(elf, link))
+      {
+        return(ELF_ERR_TABLE_LINK);
+      }
+
+      uint64 StrSize = ELF_A(SHDR[link].sh_size);
+
+      for(uint64 s = 0; s < symnbr; s++)
+      {
+        if((uint64)ELF_W(sym[s].st_name) >= StrSize)
+        {
+          elf->ErrorEntry = (uint32)s;
+          return(ELF_ERR_SYMBOL_NAME);
+        }
+      }
+
+      if(type == SHT_SYMTAB && elf->SymTab == 0)
+      {
+        elf->SymTab = i;
+      }
+    }
+    else if(type == SHT_SYMTAB_SHNDX)
+    {
+      if((size % sizeof(uint32)) != 0)
+      {
+        return(ELF_ERR_TABLE_SIZE);
+      }
+
+      if(link == 0 || link >= shnum || ELF_W(SHDR[link].sh_type) != SHT_SYMTAB)
+      {
+        return(ELF_ERR_TABLE_LINK);
+      }
+    }
+    else if(type == SHT_REL || type == SHT_RELA)
+    {
+      uint64 entsize = (type == SHT_RELA) ? sizeof(ELF_T(Rela)) : sizeof(ELF_T(Rel));
+
+      if((size % entsize) != 0)
+      {
+        return(ELF_ERR_TABLE_SIZE);
+      }
+
+      /* the symbol table of a relocation section is optional (sh_link = 0) */
+      if(link != 0 && (link >= shnum || (ELF_W(SHDR[link].sh_type) != SHT_SYMTAB && ELF_W(SHDR[link].sh_type) != SHT_DYNSYM)))
+      {
+        return(ELF_ERR_TABLE_LINK);
+      }
+    }
+  }
+
+  elf->ErrorSection = ELF_NO_INDEX;
+  return(ELF_OK);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(Open)
+** Description: cache the header, the section and program header tables and the section names string table
+**              pointers in the context. The host order copies made by Elf_ConvertTables are used when present,
+**              else the (in place or aligned) tables found by ELF_FN(Validate).
+**              The file has been checked by ELF_FN(Validate).
+** Parameter:   sElf* elf
+** Return:      void
+*******************************************************************************************************************/
+static void ELF_FN(Open)(sElf* elf)
+{
+  elf->header   = (elf->NativeEhdr != NULL) ? elf->NativeEhdr : elf->header;
+  elf->sections = (elf->NativeShdr != NULL) ? elf->NativeShdr : elf->sections;
+  elf->segments = (ELF_H(EHDR->e_phnum) == 0) ? NULL :
+                  (elf->NativePhdr != NULL) ? elf->NativePhdr : elf->segments;
+  elf->names    = (elf->SectionsNbr != 0) ? elf->Buffer + (size_t)ELF_A(SHDR[elf->ShStrNdx].sh_offset) : NULL;
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(ExtendedIndexTable)
+** Description: get the SHT_SYMTAB_SHNDX table of a symbol table: the section index of each symbol whose st_shndx
+**              is SHN_XINDEX (files with more than SHN_LORESERVE sections)
+** Parameter:   sElf* elf, uint32 symtab, uint32* count
+** Return:      uint32* (NULL if the symbol table has none)
+*******************************************************************************************************************/
+static uint32* ELF_FN(ExtendedIndexTable)(sElf* elf, uint32 symtab, uint32* count)
+{
+  const uint32* tables    = NULL;
+  uint32        TablesNbr = Elf_GetSectionsOfType(elf, SHT_SYMTAB_SHNDX, &tables);
+
+  *count = 0;
+
+  for(uint32 k = 0; k < TablesNbr; k++)
+  {
+    if(ELF_W(SHDR[tables[k]].sh_link) == symtab)
+    {
+      *count = (uint32)(ELF_A(SHDR[tables[k]].sh_size) / sizeof(uint32));
+      return((uint32*)ELF_FN(SectionTable)(elf, tables[k]));
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(SymbolSection)
+** Description: get the section index of a symbol: st_shndx, the extended index table entry for SHN_XINDEX, or
+**              ELF_SHN_RESERVED | st_shndx for a reserved index (SHN_ABS, SHN_COMMON...)
+** Parameter:   const ELF_T(Sym)* sym, uint32 s, const uint32* xindex, uint32 XindexNbr
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 ELF_FN(SymbolSection)(const ELF_T(Sym)* sym, uint32 s, const uint32* xindex, uint32 XindexNbr)
+{
+  uint32 shndx = ELF_H(sym[s].st_shndx);
+
+  if(shndx == SHN_XINDEX)
+  {
+    return((s < XindexNbr) ? ELF_W(xindex[s]) : SHN_UNDEF);
+  }
+  return((shndx >= SHN_LORESERVE) ? (uint32)(ELF_SHN_RESERVED | shndx) : shndx);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(LoadSymbolTable)
+** Description: get the symbol table found by ELF_FN(Validate) and the symbol names string table (linked by sh_link)
+** Parameter:   sElf* elf, uint32* SymTabSize, char** strtab
+** Return:      ELF_T(Sym)* (NULL if the file has no symbol table)
+*******************************************************************************************************************/
+static ELF_T(Sym)* ELF_FN(LoadSymbolTable)(sElf* elf, uint32* SymTabSize, char** strtab)
+{
+  uint32 i = elf->SymTab;
+
+  *SymTabSize = 0;
+  *strtab     = NULL;
+
+  if(i == 0)
+  {
+    return(NULL);
+  }
+
+  *SymTabSize  = (uint32)(ELF_A(SHDR[i].sh_size) / sizeof(ELF_T(Sym)));
+
+  // pointer to the table which contains the symbol names strings
+  *strtab = elf->Buffer + (size_t)ELF_A(SHDR[ELF_W(SHDR[i].sh_link)].sh_offset);
+  return((ELF_T(Sym)*)ELF_FN(SectionTable)(elf, i));
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(PrintHeader)
+** Description: display the class dependent fields of the ELF header
+** Parameter:   sElf* elf
+** Return:      void
+*******************************************************************************************************************/
+static void ELF_FN(PrintHeader)(sElf* elf)
+{
+  printf("Type       = 0x%x (%s)\n", ELF_H(EHDR->e_type), Elf_GetElfTypeStr(ELF_H(EHDR->e_type)));
+  printf("Machine    = 0x%x (%s)\n", ELF_H(EHDR->e_machine), Elf_GetMachineNameStr(ELF_H(EHDR->e_machine)));
+  printf("Version    = 0x%x     \n", ELF_W(EHDR->e_version)    );
+  printf("Entry      = 0x%llx     \n", (unsigned long long)ELF_A(EHDR->e_entry));
+  printf("Phoff      = 0x%llx     \n", (unsigned long long)ELF_A(EHDR->e_phoff));
+  printf("Shoff      = 0x%llx     \n", (unsigned long long)ELF_A(EHDR->e_shoff));
+  printf("Flags      = 0x%x     \n", ELF_W(EHDR->e_flags)      );
+  printf("Ehsize     = %d       \n", ELF_H(EHDR->e_ehsize)     );
+  printf("Phentsize  = %d       \n", ELF_H(EHDR->e_phentsize)  );
+  printf("Phnum      = %d       \n", ELF_H(EHDR->e_phnum)      );
+  printf("Shentsize  = %d       \n", ELF_H(EHDR->e_shentsize)  );
+  printf("Shnum      = %d       \n", ELF_H(EHDR->e_shnum)      );
+  printf("Shstrndx   = %d       \n", ELF_H(EHDR->e_shstrndx)   );
+
+  if((ELF_H(EHDR->e_shnum) == 0 && elf->SectionsNbr != 0) || ELF_H(EHDR->e_shstrndx) == SHN_XINDEX)
+  {
+    printf("Extended   = %u sections, names in section %u\n", elf->SectionsNbr, elf->ShStrNdx);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(SectionHeaderTable)
+** Description: display the sections table
+** Parameter:   sElf* elf
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(SectionHeaderTable)(sElf* elf)
+{
+  printf("\nSECTIONS TABLE : \n");
+  printf("\n%-10s%-20s%-20s%-20s%-22s%-22s%-22s\n","ID", "Section", "Type", "Flags", "Addr", "Offset", "Size");
+
+  for(uint32 i = 0; i < elf->SectionsNbr; i++)
+  {
+    Elf_PrintSection(i,
+                     &elf->names[ELF_W(SHDR[i].sh_name)],
+                     ELF_W(SHDR[i].sh_type),
+                     ELF_A(SHDR[i].sh_flags),
+                     ELF_A(SHDR[i].sh_addr),
+                     ELF_A(SHDR[i].sh_offset),
+                     ELF_A(SHDR[i].sh_size)
+                    );
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(SymbolTable)
+** Description: display the OBJECT and FUNCTION entries of the symbol table
+** Parameter:   sElf* elf
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(SymbolTable)(sElf* elf)
+{
+  uint32      SymTabSize = 0;
+  char*       strtab     = NULL;
+  ELF_T(Sym)* sym        = ELF_FN(LoadSymbolTable)(elf, &SymTabSize, &strtab);
+
+  printf("\nSYMBOL TABLE : \n");
+  printf("\n%-17s%-17s%-15s%-15s%-15s\n\n","Value", "Size", "Bind", "Type", "Name");
+
+  /* Display the symbol table */
+  for(uint32 i=0; i< SymTabSize ;i++)
+  {
+    if(STT_OBJECT == ELF32_ST_TYPE(sym[i].st_info) || STT_FUNC == ELF32_ST_TYPE(sym[i].st_info))
+    {
+      Elf_PrintSymbol(ELF_A(sym[i].st_value),
+                      ELF_A(sym[i].st_size),
+                      sym[i].st_info,
+                      &strtab[ELF_W(sym[i].st_name)]
+                     );
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(SearchInfo)
+** Description: display the symbol table entry of one symbol
+** Parameter:   sElf* elf, char* Symbol
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(SearchInfo)(sElf* elf, char* Symbol)
+{
+  uint32      SymTabSize = 0;
+  char*       strtab     = NULL;
+  ELF_T(Sym)* sym        = ELF_FN(LoadSymbolTable)(elf, &SymTabSize, &strtab);
+
+  for(uint32 i=0; i< SymTabSize ;i++)
+  {
+    if(0 == strcmp(Symbol,&strtab[ELF_W(sym[i].st_name)]))
+    {
+      printf("\nSYMBOL INFO (%s) : \n", Symbol);
+      printf("\n%-17s%-17s%-15s%-15s%-15s\n","Value", "Size", "Bind", "Type", "Name");
+      Elf_PrintSymbol(ELF_A(sym[i].st_value),
+                      ELF_A(sym[i].st_size),
+                      sym[i].st_info,
+                      &strtab[ELF_W(sym[i].st_name)]
+                     );
+      break;
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(ExtractBinaryToC)
+** Description: write every loadable PROGBITS section as a C array
+** Parameter:   sElf* elf, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(ExtractBinaryToC)(sElf* elf, char* path)
+{
+  const uint32* progbits    = NULL;
+  uint32        ProgbitsNbr = Elf_GetSectionsOfType(elf, SHT_PROGBITS, &progbits);
+
+  // open file
+  FILE* file = fopen(path, "wb");
+
+  if(file != NULL)
+  {
+    for(uint32 k = 0; k < ProgbitsNbr; k++)
+    {
+      uint32 i = progbits[k];
+
+      if(ELF_IS_LOAD_SECTION(ELF_W(SHDR[i].sh_type), ELF_A(SHDR[i].sh_flags), ELF_A(SHDR[i].sh_size)))
+      {
+        char* name = &elf->names[ELF_W(SHDR[i].sh_name)];
+
+        Elf_WriteCArray(file,
+                        (name[0] != '\0') ? name + 1 /* to avoid '.' in the section name*/ : name,
+                        (uint8*)(elf->Buffer + (size_t)ELF_A(SHDR[i].sh_offset)),
+                        (uint32)ELF_A(SHDR[i].sh_size)
+                       );
+      }
+    }
+    fclose(file);
+    return(TRUE);
+  }
+  else
+  {
+    return(FALSE);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(ExtractBinaryToS19)
+** Description: write every loadable PROGBITS section as S3 records (addresses are truncated to 32 bit)
+** Parameter:   sElf* elf, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(ExtractBinaryToS19)(sElf* elf, char* path)
+{
+  const uint32* progbits    = NULL;
+  uint32        ProgbitsNbr = Elf_GetSectionsOfType(elf, SHT_PROGBITS, &progbits);
+  uint32        count       = 0;
+
+  // open the s19 file in write mode
+  FILE* file = fopen(path, "wb");
+
+  if(file != NULL)
+  {
+    Elf_WriteS19Header(file, &count);
+
+    /* check all section in the ELF file */
+    for(uint32 k = 0; k < ProgbitsNbr; k++)
+    {
+      uint32 i = progbits[k];
+
+      if(ELF_IS_LOAD_SECTION(ELF_W(SHDR[i].sh_type), ELF_A(SHDR[i].sh_flags), ELF_A(SHDR[i].sh_size)))
+      {
+        Elf_WriteS19Data(file,
+                         (uint32)ELF_A(SHDR[i].sh_addr),
+                         (uint8*)(elf->Buffer + (size_t)ELF_A(SHDR[i].sh_offset)),
+                         (uint32)ELF_A(SHDR[i].sh_size),
+                         &count
+                        );
+      }
+    }
+
+    Elf_WriteS19Trailer(file, count, (uint32)ELF_A(EHDR->e_entry));
+    fclose(file);
+    return(TRUE);
+  }
+  else
+  {
+    return(FALSE);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(WalkRelocations)
+** Description: decode every REL/RELA section (in section order, taken from the section directory) in batches of
+**              ELF_RELOC_BATCH_SIZE entries. The symbol names of a batch are resolved together against the linked
+**              symbol table before the batch is handed over.
+** Parameter:   sElf* elf, pfElfRelocBatch callback, void* ctx
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(WalkRelocations)(sElf* elf, pfElfRelocBatch callback, void* ctx)
+{
+  sElfReloc     batch[ELF_RELOC_BATCH_SIZE];
+  const uint32* rel     = NULL;
+  const uint32* rela    = NULL;
+  uint32        RelNbr  = Elf_GetSectionsOfType(elf, SHT_REL, &rel);
+  uint32        RelaNbr = Elf_GetSectionsOfType(elf, SHT_RELA, &rela);
+
+  for(uint32 p = 0, q = 0; p < RelNbr || q < RelaNbr; )
+  {
+    uint32 i    = (q >= RelaNbr || (p < RelNbr && rel[p] < rela[q])) ? rel[p++] : rela[q++];
+    uint32 type = ELF_W(SHDR[i].sh_type);
+
+    sElfRelocSection section;
+    uint32 link     = ELF_W(SHDR[i].sh_link);
+    uint32 target   = ELF_W(SHDR[i].sh_info);
+    uint32 entsize  = (type == SHT_RELA) ? (uint32)sizeof(ELF_T(Rela)) : (uint32)sizeof(ELF_T(Rel));
+    char*  table    = ELF_FN(SectionTable)(elf, i);
+    ELF_T(Sym)* sym = NULL;
+    char*  strtab   = NULL;
+    uint32 symnbr   = 0;
+    uint32* xindex  = NULL;
+    uint32 XindexNbr = 0;
+
+    if(link > 0 && link < elf->SectionsNbr)
+    {
+      sym    = (ELF_T(Sym)*)ELF_FN(SectionTable)(elf, link);
+      symnbr = (uint32)(ELF_A(SHDR[link].sh_size) / sizeof(ELF_T(Sym)));
+      strtab = elf->Buffer + (size_t)ELF_A(SHDR[ELF_W(SHDR[link].sh_link)].sh_offset);
+      xindex = ELF_FN(ExtendedIndexTable)(elf, link, &XindexNbr);
+    }
+
+    section.index      = i;
+    section.name       = &elf->names[ELF_W(SHDR[i].sh_name)];
+    section.TargetName = (target < elf->SectionsNbr) ? &elf->names[ELF_W(SHDR[target].sh_name)] : "";
+    section.symtab     = link;
+    section.count      = (uint32)(ELF_A(SHDR[i].sh_size) / entsize);
+    section.machine    = ELF_H(EHDR->e_machine);
+    section.rela       = (boolean)(type == SHT_RELA);
+
+    for(uint32 first = 0; first < section.count; first += ELF_RELOC_BATCH_SIZE)
+    {
+      uint32 n = section.count - first;
+
+      if(n > ELF_RELOC_BATCH_SIZE)
+      {
+        n = ELF_RELOC_BATCH_SIZE;
+      }
+
+      /* decode the batch */
+      for(uint32 r = 0; r < n; r++)
+      {
+        ELF_T(Rela)* entry = (ELF_T(Rela)*)(table + ((size_t)(first + r) * entsize));
+
+        batch[r].offset = ELF_A(entry->r_offset);
+        batch[r].type   = ELF_R_TYPE(ELF_A(entry->r_info));
+        batch[r].sym    = ELF_R_SYM(ELF_A(entry->r_info));
+        batch[r].addend = section.rela ? ELF_SA(entry->r_addend) : 0;
+      }
+
+      /* resolve the symbol names of the batch */
+      for(uint32 r = 0; r < n; r++)
+      {
+        uint32 s = batch[r].sym;
+
+        batch[r].SymName = "";
+
+        if(s != 0 && s < symnbr)
+        {
+          batch[r].SymName = &strtab[ELF_W(sym[s].st_name)];
+
+          /* section symbols have no name, use the name of the section they stand for */
+          if(ELF32_ST_TYPE(sym[s].st_info) == STT_SECTIONS)
+          {
+            uint32 shndx = ELF_FN(SymbolSection)(sym, s, xindex, XindexNbr);
+
+            if(shndx < elf->SectionsNbr)
+            {
+              batch[r].SymName = &elf->names[ELF_W(SHDR[shndx].sh_name)];
+            }
+          }
+        }
+      }
+
+      callback(&section, batch, n, ctx);
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(FindSymbolIndex)
+** Description: get the index of the first symbol with the given name in one symbol table
+** Parameter:   sElf* elf, uint32 symtab, const char* name, uint32* index
+** Return:      boolean (FALSE if the symbol is not found)
+*******************************************************************************************************************/
+static boolean ELF_FN(FindSymbolIndex)(sElf* elf, uint32 symtab, const char* name, uint32* index)
+{
+  if(symtab == 0 || symtab >= elf->SectionsNbr)
+  {
+    return(FALSE);
+  }
+
+  ELF_T(Sym)* sym    = (ELF_T(Sym)*)ELF_FN(SectionTable)(elf, symtab);
+  uint32      symnbr = (uint32)(ELF_A(SHDR[symtab].sh_size) / sizeof(ELF_T(Sym)));
+  char*       strtab = elf->Buffer + (size_t)ELF_A(SHDR[ELF_W(SHDR[symtab].sh_link)].sh_offset);
+
+  for(uint32 s = 1; s < symnbr; s++)
+  {
+    if(0 == strcmp(&strtab[ELF_W(sym[s].st_name)], name))
+    {
+      *index = s;
+      return(TRUE);
+    }
+  }
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(GetSections)
+** Description: copy the section header table into a class independent array (taken from the image arena)
+** Parameter:   sElf* elf, sElfSection** sections, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(GetSections)(sElf* elf, sElfSection** sections, uint32* count)
+{
+  uint32 shnum = elf->SectionsNbr;
+
+  *count    = 0;
+  *sections = (sElfSection*)Arena_Alloc(&elf->arena, ((size_t)shnum + 1) * sizeof(sElfSection));
+
+  if(*sections == NULL)
+  {
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < shnum; i++)
+  {
+    sElfSection* section = &(*sections)[i];
+
+    section->name  = &elf->names[ELF_W(SHDR[i].sh_name)];
+    section->type  = ELF_W(SHDR[i].sh_type);
+    section->flags = ELF_A(SHDR[i].sh_flags);
+    section->addr  = ELF_A(SHDR[i].sh_addr);
+    section->size  = ELF_A(SHDR[i].sh_size);
+    section->data  = (section->type != SHT_NOBITS && section->type != SHT_NULL) ? elf->Buffer + (size_t)ELF_A(SHDR[i].sh_offset) : NULL;
+  }
+
+  *count = shnum;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(GetSymbols)
+** Description: copy the symbol table into a class independent array (taken from the image arena).
+**              data points to the symbol content when the symbol lies inside a section with file data.
+** Parameter:   sElf* elf, sElfSymbol** symbols, uint32* count
+** Return:      boolean (FALSE if the file has no symbol table)
+*******************************************************************************************************************/
+static boolean ELF_FN(GetSymbols)(sElf* elf, sElfSymbol** symbols, uint32* count)
+{
+  uint32      SymTabSize = 0;
+  char*       strtab     = NULL;
+  ELF_T(Sym)* sym        = ELF_FN(LoadSymbolTable)(elf, &SymTabSize, &strtab);
+
+  *count   = 0;
+  *symbols = NULL;
+
+  if(sym == NULL)
+  {
+    return(FALSE);
+  }
+
+  *symbols = (sElfSymbol*)Arena_Alloc(&elf->arena, ((size_t)SymTabSize + 1) * sizeof(sElfSymbol));
+
+  if(*symbols == NULL)
+  {
+    return(FALSE);
+  }
+
+  uint32  shnum  = elf->SectionsNbr;
+  boolean reloc  = (boolean)(ELF_H(EHDR->e_type) == ET_REL);
+  boolean thumb  = (boolean)(ELF_H(EHDR->e_machine) == EM_ARM);
+  uint32  XindexNbr = 0;
+  uint32* xindex = ELF_FN(ExtendedIndexTable)(elf, elf->SymTab, &XindexNbr);
+
+  for(uint32 i = 0; i < SymTabSize; i++)
+  {
+    sElfSymbol* symbol = &(*symbols)[i];
+    uint32      shndx  = ELF_FN(SymbolSection)(sym, i, xindex, XindexNbr);
+
+    symbol->name  = &strtab[ELF_W(sym[i].st_name)];
+    symbol->value = ELF_A(sym[i].st_value);
+    symbol->size  = ELF_A(sym[i].st_size);
+    symbol->info  = sym[i].st_info;
+    symbol->shndx = shndx;
+    symbol->data  = NULL;
+
+    if(shndx != 0 && shndx < shnum && ELF_W(SHDR[shndx].sh_type) != SHT_NOBITS)
+    {
+      uint64 value = symbol->value;
+
+      /* the bit 0 of an ARM function address selects the Thumb state, it is not part of the address */
+      if(thumb && ELF32_ST_TYPE(symbol->info) == STT_FUNC)
+      {
+        value &= ~(uint64)1;
+      }
+
+      uint64 offset = reloc ? value : value - ELF_A(SHDR[shndx].sh_addr);
+
+      if(value >= (reloc ? 0 : ELF_A(SHDR[shndx].sh_addr)) &&
+         offset <= ELF_A(SHDR[shndx].sh_size)                &&
+         symbol->size <= ELF_A(SHDR[shndx].sh_size) - offset)
+      {
+        symbol->data = elf->Buffer + (size_t)(ELF_A(SHDR[shndx].sh_offset) + offset);
+      }
+    }
+  }
+
+  *count = SymTabSize;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    ELF_FN(GetSegments)
+** Description: copy the program header table into a class independent array (taken from the image arena)
+** Parameter:   sElf* elf, sElfSegment** segments, uint32* count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean ELF_FN(GetSegments)(sElf* elf, sElfSegment** segments, uint32* count)
+{
+  ELF_T(Phdr)* phdr  = (ELF_T(Phdr)*)elf->segments;
+  uint32       phnum = (phdr != NULL) ? ELF_H(EHDR->e_phnum) : 0;
+
+  *count    = 0;
+  *segments = (sElfSegment*)Arena_Alloc(&elf->arena, ((size_t)phnum + 1) * sizeof(sElfSegment));
+
+  if(*segments == NULL)
+  {
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < phnum; i++)
+  {
+    sElfSegment* segment = &(*segments)[i];
+
+    segment->type   = ELF_W(phdr[i].p_type);
+    segment->flags  = ELF_W(phdr[i].p_flags);
+    segment->offset = ELF_A(phdr[i].p_offset);
+    segment->vaddr  = ELF_A(phdr[i].p_vaddr);
+    segment->paddr  = ELF_A(phdr[i].p_paddr);
+    segment->filesz = ELF_A(phdr[i].p_filesz);
+    segment->memsz  = ELF_A(phdr[i].p_memsz);
+  }
+
+  *count = phnum;
+  return(TRUE);
+}
+
+static const sElfClassOps ELF_FN(Ops) = {
+                                           ELF_CLASS,
+                                           ELF_DATA,
+                                           ELF_FN(Validate),
+                                           ELF_FN(Open),
+                                           ELF_FN(PrintHeader),
+                                           ELF_FN(SectionHeaderTable),
+                                           ELF_FN(SymbolTable),
+                                           ELF_FN(ExtractBinaryToC),
+                                           ELF_FN(ExtractBinaryToS19),
+                                           ELF_FN(SearchInfo),
+                                           ELF_FN(WalkRelocations),
+                                           ELF_FN(FindSymbolIndex),
+                                           ELF_FN(GetSections),
+                                           ELF_FN(GetSymbols),
+                                           ELF_FN(GetSegments)
+                                        };
+
+#undef SHDR
+#undef EHDR
+#undef ELF_A
+#undef ELF_W
+#undef ELF_H
+#undef ELF_DATA
+#undef ELF_CLASS
+#undef ELF_SA
+#undef ELF_R_TYPE
+#undef ELF_R_SYM
+#undef ELF_T
+#undef ELF_FN
+#undef ELF_CLASS_MSB
+#undef ELF_CLASS_BITS
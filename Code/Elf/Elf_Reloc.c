@@ -0,0 +1,366 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Elf_Reloc.h>
+
+const sRelocType RelocTypeArm[] = {
+                                    {0   , "R_ARM_NONE"            },
+                                    {1   , "R_ARM_PC24"            },
+                                    {2   , "R_ARM_ABS32"           },
+                                    {3   , "R_ARM_REL32"           },
+                                    {4   , "R_ARM_LDR_PC_G0"       },
+                                    {5   , "R_ARM_ABS16"           },
+                                    {6   , "R_ARM_ABS12"           },
+                                    {7   , "R_ARM_THM_ABS5"        },
+                                    {8   , "R_ARM_ABS8"            },
+                                    {9   , "R_ARM_SBREL32"         },
+                                    {10  , "R_ARM_THM_CALL"        },
+                                    {11  , "R_ARM_THM_PC8"         },
+                                    {20  , "R_ARM_COPY"            },
+                                    {21  , "R_ARM_GLOB_DAT"        },
+                                    {22  , "R_ARM_JUMP_SLOT"       },
+                                    {23  , "R_ARM_RELATIVE"        },
+                                    {24  , "R_ARM_GOTOFF32"        },
+                                    {25  , "R_ARM_BASE_PREL"       },
+                                    {26  , "R_ARM_GOT_BREL"        },
+                                    {27  , "R_ARM_PLT32"           },
+                                    {28  , "R_ARM_CALL"            },
+                                    {29  , "R_ARM_JUMP24"          },
+                                    {30  , "R_ARM_THM_JUMP24"      },
+                                    {38  , "R_ARM_TARGET1"         },
+                                    {40  , "R_ARM_V4BX"            },
+                                    {41  , "R_ARM_TARGET2"         },
+                                    {42  , "R_ARM_PREL31"          },
+                                    {43  , "R_ARM_MOVW_ABS_NC"     },
+                                    {44  , "R_ARM_MOVT_ABS"        },
+                                    {45  , "R_ARM_MOVW_PREL_NC"    },
+                                    {46  , "R_ARM_MOVT_PREL"       },
+                                    {47  , "R_ARM_THM_MOVW_ABS_NC" },
+                                    {48  , "R_ARM_THM_MOVT_ABS"    },
+                                    {49  , "R_ARM_THM_MOVW_PREL_NC"},
+                                    {50  , "R_ARM_THM_MOVT_PREL"   },
+                                    {102 , "R_ARM_THM_JUMP11"      },
+                                    {103 , "R_ARM_THM_JUMP8"       }
+                                  };
+
+const sRelocType RelocTypeTriCore[] = {
+                                        {0   , "R_TRICORE_NONE"   },
+                                        {1   , "R_TRICORE_32REL"  },
+                                        {2   , "R_TRICORE_32ABS"  },
+                                        {3   , "R_TRICORE_24REL"  },
+                                        {4   , "R_TRICORE_24ABS"  },
+                                        {5   , "R_TRICORE_16SM"   },
+                                        {6   , "R_TRICORE_HI"     },
+                                        {7   , "R_TRICORE_LO"     },
+                                        {8   , "R_TRICORE_LO2"    },
+                                        {9   , "R_TRICORE_18ABS"  },
+                                        {10  , "R_TRICORE_10SM"   },
+                                        {11  , "R_TRICORE_15REL"  }
+                                      };
+
+const sRelocType RelocTypePpc[] = {
+                                    {0   , "R_PPC_NONE"            },
+                                    {1   , "R_PPC_ADDR32"          },
+                                    {2   , "R_PPC_ADDR24"          },
+                                    {3   , "R_PPC_ADDR16"          },
+                                    {4   , "R_PPC_ADDR16_LO"       },
+                                    {5   , "R_PPC_ADDR16_HI"       },
+                                    {6   , "R_PPC_ADDR16_HA"       },
+                                    {7   , "R_PPC_ADDR14"          },
+                                    {10  , "R_PPC_REL24"           },
+                                    {11  , "R_PPC_REL14"           },
+                                    {18  , "R_PPC_PLTREL24"        },
+                                    {19  , "R_PPC_COPY"            },
+                                    {20  , "R_PPC_GLOB_DAT"        },
+                                    {21  , "R_PPC_JMP_SLOT"        },
+                                    {22  , "R_PPC_RELATIVE"        },
+                                    {24  , "R_PPC_UADDR32"         },
+                                    {25  , "R_PPC_UADDR16"         },
+                                    {26  , "R_PPC_REL32"           },
+                                    {101 , "R_PPC_EMB_NADDR32"     },
+                                    {109 , "R_PPC_EMB_SDA21"       },
+                                    {216 , "R_PPC_VLE_REL8"        },
+                                    {217 , "R_PPC_VLE_REL15"       },
+                                    {218 , "R_PPC_VLE_REL24"       },
+                                    {219 , "R_PPC_VLE_LO16A"       },
+                                    {220 , "R_PPC_VLE_LO16D"       },
+                                    {221 , "R_PPC_VLE_HI16A"       },
+                                    {222 , "R_PPC_VLE_HI16D"       },
+                                    {223 , "R_PPC_VLE_HA16A"       },
+                                    {224 , "R_PPC_VLE_HA16D"       },
+                                    {225 , "R_PPC_VLE_SDA21"       },
+                                    {226 , "R_PPC_VLE_SDA21_LO"    }
+                                  };
+
+/* GNU numbering, used by both EM_V800 and EM_V850 objects from the GNU tools */
+const sRelocType RelocTypeV850[] = {
+                                     {0   , "R_V850_NONE"            },
+                                     {1   , "R_V850_9_PCREL"         },
+                                     {2   , "R_V850_22_PCREL"        },
+                                     {3   , "R_V850_HI16_S"          },
+                                     {4   , "R_V850_HI16"            },
+                                     {5   , "R_V850_LO16"            },
+                                     {6   , "R_V850_ABS32"           },
+                                     {7   , "R_V850_16"              },
+                                     {8   , "R_V850_8"               },
+                                     {9   , "R_V850_SDA_16_16_OFFSET"},
+                                     {10  , "R_V850_SDA_15_16_OFFSET"},
+                                     {11  , "R_V850_ZDA_16_16_OFFSET"},
+                                     {12  , "R_V850_ZDA_15_16_OFFSET"},
+                                     {13  , "R_V850_TDA_6_8_OFFSET"  },
+                                     {14  , "R_V850_TDA_7_8_OFFSET"  },
+                                     {15  , "R_V850_TDA_7_7_OFFSET"  },
+                                     {16  , "R_V850_TDA_16_16_OFFSET"}
+                                   };
+
+#define RELOC_TABLE(machine, table)  {machine, table, (uint32)(sizeof(table)/sizeof(sRelocType))}
+
+const sRelocMachine RelocMachineTable[] = {
+                                            RELOC_TABLE(EM_ARM     , RelocTypeArm    ),
+                                            RELOC_TABLE(EM_TRICORE , RelocTypeTriCore),
+                                            RELOC_TABLE(EM_PPC     , RelocTypePpc    ),
+                                            RELOC_TABLE(EM_V800    , RelocTypeV850   ),
+                                            RELOC_TABLE(EM_V850    , RelocTypeV850   )
+                                          };
+
+#define RELOC_MACHINE_TABLE_SIZE  ((sizeof(RelocMachineTable))/(sizeof(sRelocMachine)))
+
+//relocation count of one section (summary of Elf_RelocationTable)
+typedef struct
+{
+  char*  name;
+  char*  TargetName;
+  uint32 count;
+}sRelocCount;
+
+typedef struct
+{
+  const sRelocMachine* machine;
+  sRelocCount* counts;
+  uint32 CountsNbr;
+  uint32 LastSection;
+}sRelocListCtx;
+
+typedef struct
+{
+  sElf*   elf;
+  char*   Symbol;
+  uint32  symtab;         //symbol table the cached index belongs to
+  uint32  index;          //index of Symbol in symtab
+  boolean found;          //Symbol exists in symtab
+  uint32  LastSection;
+  uint32  SectionRefs;
+  char*   SectionName;
+  uint32  total;
+  char*   path;
+}sRelocXrefCtx;
+
+static const sRelocMachine* Elf_GetRelocMachine(uint32 machine);
+static char* Elf_GetRelocTypeStr(const sRelocMachine* machine, uint32 type);
+static void Elf_RelocListBatch(const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx);
+static void Elf_RelocXrefBatch(const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx);
+static void Elf_RelocXrefFlush(sRelocXrefCtx* xref);
+
+/*******************************************************************************************************************
+** Function:    Elf_GetRelocMachine
+** Description: get the relocation type table of a target machine
+** Parameter:   uint32 machine
+** Return:      const sRelocMachine* (NULL for machines without a table)
+*******************************************************************************************************************/
+static const sRelocMachine* Elf_GetRelocMachine(uint32 machine)
+{
+  for(uint32 i = 0; i < RELOC_MACHINE_TABLE_SIZE; i++)
+  {
+    if(machine == RelocMachineTable[i].machine)
+    {
+      return(&RelocMachineTable[i]);
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_GetRelocTypeStr
+** Description: get the name of a relocation type
+** Parameter:   const sRelocMachine* machine, uint32 type
+** Return:      char* (NULL if the type is unknown)
+*******************************************************************************************************************/
+static char* Elf_GetRelocTypeStr(const sRelocMachine* machine, uint32 type)
+{
+  if(machine != NULL)
+  {
+    for(uint32 i = 0; i < machine->size; i++)
+    {
+      if(type == machine->table[i].type)
+      {
+        return((char*)(machine->table[i].name));
+      }
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_RelocListBatch
+** Description: display one batch of relocation entries
+** Parameter:   const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_RelocListBatch(const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx)
+{
+  sRelocListCtx* list = (sRelocListCtx*)ctx;
+  char   TypeStr[16];
+
+  if(list->LastSection != section->index)
+  {
+    /* first batch of a new relocation section */
+    sRelocCount* counts = (sRelocCount*)realloc(list->counts, (list->CountsNbr + 1) * sizeof(sRelocCount));
+
+    if(counts != NULL)
+    {
+      list->counts = counts;
+      list->counts[list->CountsNbr].name       = section->name;
+      list->counts[list->CountsNbr].TargetName = section->TargetName;
+      list->counts[list->CountsNbr].count      = section->count;
+      list->CountsNbr++;
+    }
+
+    list->LastSection = section->index;
+    list->machine     = Elf_GetRelocMachine(section->machine);
+
+    printf("\nRELOCATIONS (%s -> %s) : %d entries\n", section->name, section->TargetName, section->count);
+    printf("\n%-20s%-26s%-30s%-20s\n\n", "Offset", "Type", "Symbol", "Addend");
+  }
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    char* type = Elf_GetRelocTypeStr(list->machine, relocs[i].type);
+
+    if(type == NULL)
+    {
+      sprintf(TypeStr, "0x%x", relocs[i].type);
+      type = TypeStr;
+    }
+
+    printf("0x%-18llx%-26s%-30s%s0x%llx\n",
+            (unsigned long long)relocs[i].offset,
+            type,
+            relocs[i].SymName,
+            (relocs[i].addend < 0) ? "-" : "",
+            (unsigned long long)((relocs[i].addend < 0) ? -relocs[i].addend : relocs[i].addend)
+          );
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_RelocationTable
+** Description: display all relocation entries followed by the relocation count of each section
+** Parameter:   sElf* elf
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Elf_RelocationTable(sElf* elf)
+{
+  sRelocListCtx list = {NULL, NULL, 0, 0};
+
+  if(FALSE == Elf_WalkRelocations(elf, Elf_RelocListBatch, &list))
+  {
+    return(FALSE);
+  }
+
+  printf("\nRELOCATION COUNT PER SECTION : \n");
+  printf("\n%-30s%-30s%-15s\n\n", "Section", "Applies to", "Count");
+
+  for(uint32 i = 0; i < list.CountsNbr; i++)
+  {
+    printf("%-30s%-30s%-15d\n", list.counts[i].name, list.counts[i].TargetName, list.counts[i].count);
+  }
+
+  free(list.counts);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_RelocXrefFlush
+** Description: display the number of references found in the previous relocation section
+** Parameter:   sRelocXrefCtx* xref
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_RelocXrefFlush(sRelocXrefCtx* xref)
+{
+  if(xref->SectionRefs > 0)
+  {
+    printf("%-40s%-30s%-15d\n", xref->path, xref->SectionName, xref->SectionRefs);
+  }
+  xref->SectionRefs = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_RelocXrefBatch
+** Description: count the relocation entries of one batch that refer to the searched symbol.
+**              The symbol is resolved once per symbol table, the entries are then matched by index.
+** Parameter:   const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_RelocXrefBatch(const sElfRelocSection* section, const sElfReloc* relocs, uint32 count, void* ctx)
+{
+  sRelocXrefCtx* xref = (sRelocXrefCtx*)ctx;
+
+  if(xref->LastSection != section->index)
+  {
+    Elf_RelocXrefFlush(xref);
+    xref->LastSection = section->index;
+    xref->SectionName = section->name;
+
+    if(xref->symtab != section->symtab)
+    {
+      xref->symtab = section->symtab;
+      xref->found  = Elf_FindSymbolIndex(xref->elf, section->symtab, xref->Symbol, &xref->index);
+    }
+  }
+
+  if(xref->found)
+  {
+    for(uint32 i = 0; i < count; i++)
+    {
+      if(relocs[i].sym == xref->index)
+      {
+        xref->SectionRefs++;
+        xref->total++;
+      }
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_XrefSymbol
+** Description: display the relocation sections of the file which refer to Symbol. Only files with references
+**              are reported, so that a batch of objects (see @list input) gives a compact cross-reference.
+** Parameter:   sElf* elf, char* Symbol, char* path
+** Return:      boolean (TRUE if the file refers to Symbol)
+*******************************************************************************************************************/
+boolean Elf_XrefSymbol(sElf* elf, char* Symbol, char* path)
+{
+  static boolean boHeaderPrinted = FALSE;
+  sRelocXrefCtx xref = {elf, Symbol, 0, 0, FALSE, 0, 0, NULL, 0, path};
+
+  if(Symbol == NULL || path == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(!boHeaderPrinted)
+  {
+    printf("\nSYMBOL REFERENCES (%s) : \n", Symbol);
+    printf("\n%-40s%-30s%-15s\n\n", "File", "Section", "References");
+    boHeaderPrinted = TRUE;
+  }
+
+  Elf_WalkRelocations(elf, Elf_RelocXrefBatch, &xref);
+  Elf_RelocXrefFlush(&xref);
+
+  return((boolean)(xref.total > 0));
+}
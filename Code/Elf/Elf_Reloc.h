@@ -0,0 +1,29 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __ELF_RELOC_H__
+#define __ELF_RELOC_H__
+
+#include<Elf.h>
+
+typedef struct
+{
+  uint32 type;
+  char const * const name;
+}sRelocType;
+
+typedef struct
+{
+  uint32 machine;
+  const sRelocType* table;
+  uint32 size;
+}sRelocMachine;
+
+boolean Elf_RelocationTable(sElf* elf);
+boolean Elf_XrefSymbol(sElf* elf, char* Symbol, char* path);
+
+#endif
@@ -0,0 +1,188 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Elf_Swap.h>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+  #define ELF_SWAP_SSSE3
+  #include<tmmintrin.h>
+  #if defined(_MSC_VER)
+    #include<intrin.h>
+    #define ELF_SWAP_TARGET_SSSE3
+  #else
+    #include<cpuid.h>
+    #define ELF_SWAP_TARGET_SSSE3  __attribute__((target("ssse3")))
+  #endif
+#endif
+
+#define ELF_SWAP_MAX_CHUNKS  16
+
+/*******************************************************************************************************************
+** Table entry layouts (field sizes in declaration order, see Elf.h)
+*******************************************************************************************************************/
+const sElfSwapLayout ElfSwapLayout_Ehdr32 = {52, 29, {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 2,2,4,4,4,4,4,2,2,2,2,2,2}};
+const sElfSwapLayout ElfSwapLayout_Ehdr64 = {64, 29, {1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1, 2,2,4,8,8,8,4,2,2,2,2,2,2}};
+const sElfSwapLayout ElfSwapLayout_Shdr32 = {40, 10, {4,4,4,4,4,4,4,4,4,4}};
+const sElfSwapLayout ElfSwapLayout_Shdr64 = {64, 10, {4,4,8,8,8,8,4,4,8,8}};
+const sElfSwapLayout ElfSwapLayout_Phdr32 = {32,  8, {4,4,4,4,4,4,4,4}};
+const sElfSwapLayout ElfSwapLayout_Phdr64 = {56,  8, {4,4,8,8,8,8,8,8}};
+const sElfSwapLayout ElfSwapLayout_Sym32  = {16,  6, {4,4,4,1,1,2}};
+const sElfSwapLayout ElfSwapLayout_Sym64  = {24,  6, {4,1,1,2,8,8}};
+const sElfSwapLayout ElfSwapLayout_Rel32  = { 8,  2, {4,4}};
+const sElfSwapLayout ElfSwapLayout_Rela32 = {12,  3, {4,4,4}};
+const sElfSwapLayout ElfSwapLayout_Rel64  = {16,  2, {8,8}};
+const sElfSwapLayout ElfSwapLayout_Rela64 = {24,  3, {8,8,8}};
+const sElfSwapLayout ElfSwapLayout_Word   = { 4,  1, {4}};
+
+/*******************************************************************************************************************
+** Function:    Elf_SwapBuildPermutation
+** Description: build the byte permutation of one entry: perm[i] is the source byte of the destination byte i
+** Parameter:   const sElfSwapLayout* layout, uint8* perm
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_SwapBuildPermutation(const sElfSwapLayout* layout, uint8* perm)
+{
+  uint32 pos = 0;
+
+  for(uint32 f = 0; f < layout->FieldCount; f++)
+  {
+    for(uint32 b = 0; b < layout->FieldSize[f]; b++)
+    {
+      perm[pos + b] = (uint8)(pos + layout->FieldSize[f] - 1 - b);
+    }
+    pos += layout->FieldSize[f];
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_SwapScalar
+** Description: byte swap whole entries one field at a time (each entry is read into a copy first, so that dst
+**              may be src)
+** Parameter:   uint8* dst, const uint8* src, uint32 size, uint32 RecSize, const uint8* perm
+** Return:      void
+*******************************************************************************************************************/
+static void Elf_SwapScalar(uint8* dst, const uint8* src, uint32 size, uint32 RecSize, const uint8* perm)
+{
+  uint8 entry[256];
+
+  for(uint32 rec = 0; rec + RecSize <= size; rec += RecSize)
+  {
+    memcpy(entry, &src[rec], RecSize);
+
+    for(uint32 b = 0; b < RecSize; b++)
+    {
+      dst[rec + b] = entry[perm[b]];
+    }
+  }
+}
+
+#if defined(ELF_SWAP_SSSE3)
+
+/*******************************************************************************************************************
+** Function:    Elf_SwapHasSsse3
+** Description: check (once) if the CPU supports the SSSE3 byte shuffle
+** Parameter:   void
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Elf_SwapHasSsse3(void)
+{
+  static int supported = -1;
+
+  if(supported < 0)
+  {
+#if defined(_MSC_VER)
+    int info[4] = {0};
+    __cpuid(info, 1);
+    supported = ((info[2] & (1 << 9)) != 0) ? 1 : 0;
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    supported = (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && ((ecx & (1U << 9)) != 0)) ? 1 : 0;
+#endif
+  }
+  return((boolean)(supported == 1));
+}
+
+/*******************************************************************************************************************
+** Function:    Elf_SwapSsse3
+** Description: byte swap blocks of lcm(RecSize, 16) bytes, one pshufb per 16 byte chunk.
+**              Fields are naturally aligned, so no field crosses a 16 byte chunk boundary.
+** Parameter:   uint8* dst, const uint8* src, uint32 size, uint32 RecSize, const uint8* perm
+** Return:      uint32 (number of bytes processed)
+*******************************************************************************************************************/
+ELF_SWAP_TARGET_SSSE3
+static uint32 Elf_SwapSsse3(uint8* dst, const uint8* src, uint32 size, uint32 RecSize, const uint8* perm)
+{
+  __m128i mask[ELF_SWAP_MAX_CHUNKS];
+  uint8   bytes[16];
+  uint32  block  = RecSize;
+  uint32  chunks = 0;
+  uint32  done   = 0;
+
+  while((block % 16) != 0)
+  {
+    block += RecSize;
+  }
+
+  chunks = block / 16;
+
+  if(chunks > ELF_SWAP_MAX_CHUNKS)
+  {
+    return(0);
+  }
+
+  for(uint32 c = 0; c < chunks; c++)
+  {
+    for(uint32 b = 0; b < 16; b++)
+    {
+      uint32 pos = (c * 16) + b;
+      uint32 rec = pos - (pos % RecSize);
+      bytes[b] = (uint8)(rec + perm[pos % RecSize] - (c * 16));
+    }
+    mask[c] = _mm_loadu_si128((const __m128i*)bytes);
+  }
+
+  for(done = 0; done + block <= size; done += block)
+  {
+    for(uint32 c = 0; c < chunks; c++)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i*)(src + done + (c * 16)));
+      _mm_storeu_si128((__m128i*)(dst + done + (c * 16)), _mm_shuffle_epi8(v, mask[c]));
+    }
+  }
+  return(done);
+}
+
+#endif
+
+/*******************************************************************************************************************
+** Function:    Elf_SwapTable
+** Description: convert a table of big endian entries into host (little endian) order.
+**              dst and src may be the same buffer. size is truncated to a whole number of entries.
+** Parameter:   void* dst, const void* src, uint32 size, const sElfSwapLayout* layout
+** Return:      void
+*******************************************************************************************************************/
+void Elf_SwapTable(void* dst, const void* src, uint32 size, const sElfSwapLayout* layout)
+{
+  uint8  perm[256];
+  uint32 done = 0;
+
+  if(dst == NULL || src == NULL || layout == NULL || layout->RecSize == 0)
+  {
+    return;
+  }
+
+  Elf_SwapBuildPermutation(layout, perm);
+
+#if defined(ELF_SWAP_SSSE3)
+  if(Elf_SwapHasSsse3())
+  {
+    done = Elf_SwapSsse3((uint8*)dst, (const uint8*)src, size, layout->RecSize, perm);
+  }
+#endif
+
+  Elf_SwapScalar((uint8*)dst + done, (const uint8*)src + done, size - done, layout->RecSize, perm);
+}
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __ELF_SWAP_H__
+#define __ELF_SWAP_H__
+
+#include<common.h>
+
+#define ELF_SWAP_MAX_FIELDS  32
+
+//field layout of one table entry: size in bytes of each field, in order
+typedef struct
+{
+  uint8 RecSize;
+  uint8 FieldCount;
+  uint8 FieldSize[ELF_SWAP_MAX_FIELDS];
+}sElfSwapLayout;
+
+extern const sElfSwapLayout ElfSwapLayout_Ehdr32;
+extern const sElfSwapLayout ElfSwapLayout_Ehdr64;
+extern const sElfSwapLayout ElfSwapLayout_Shdr32;
+extern const sElfSwapLayout ElfSwapLayout_Shdr64;
+extern const sElfSwapLayout ElfSwapLayout_Phdr32;
+extern const sElfSwapLayout ElfSwapLayout_Phdr64;
+extern const sElfSwapLayout ElfSwapLayout_Sym32;
+extern const sElfSwapLayout ElfSwapLayout_Sym64;
+extern const sElfSwapLayout ElfSwapLayout_Rel32;
+extern const sElfSwapLayout ElfSwapLayout_Rela32;
+extern const sElfSwapLayout ElfSwapLayout_Rel64;
+extern const sElfSwapLayout ElfSwapLayout_Rela64;
+extern const sElfSwapLayout ElfSwapLayout_Word;
+
+void Elf_SwapTable(void* dst, const void* src, uint32 size, const sElfSwapLayout* layout);
+
+#endif
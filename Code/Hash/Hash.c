@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Hash.h>
+
+#define XXH_PRIME64_1  0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2  0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3  0x165667B19E3779F9ULL
+#define XXH_PRIME64_4  0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5  0x27D4EB2F165667C5ULL
+
+#define FNV32_OFFSET   0x811C9DC5UL
+#define FNV32_PRIME    0x01000193UL
+
+#define HASH_ROTL64(x, r)  (((x) << (r)) | ((x) >> (64 - (r))))
+
+/*******************************************************************************************************************
+** Little endian loads (unaligned)
+*******************************************************************************************************************/
+static __inline uint64 Hash_Read64(const uint8* p)
+{
+  uint64 v;
+  memcpy(&v, p, sizeof(v));
+  return(v);
+}
+
+static __inline uint32 Hash_Read32(const uint8* p)
+{
+  uint32 v;
+  memcpy(&v, p, sizeof(v));
+  return(v);
+}
+
+static __inline uint64 Hash_Xxh64Round(uint64 acc, uint64 input)
+{
+  acc += input * XXH_PRIME64_2;
+  acc  = HASH_ROTL64(acc, 31);
+  return(acc * XXH_PRIME64_1);
+}
+
+static __inline uint64 Hash_Xxh64Merge(uint64 acc, uint64 val)
+{
+  acc ^= Hash_Xxh64Round(0, val);
+  return((acc * XXH_PRIME64_1) + XXH_PRIME64_4);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Xxh64
+** Description: XXH64 hash of a memory block (same results as the reference xxHash implementation)
+** Parameter:   const void* data, uint64 size, uint64 seed
+** Return:      uint64
+*******************************************************************************************************************/
+uint64 Hash_Xxh64(const void* data, uint64 size, uint64 seed)
+{
+  const uint8* p   = (const uint8*)data;
+  const uint8* end = p + size;
+  uint64       h   = 0;
+
+  if(size >= 32)
+  {
+    const uint8* limit = end - 32;
+    uint64 v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    uint64 v2 = seed + XXH_PRIME64_2;
+    uint64 v3 = seed;
+    uint64 v4 = seed - XXH_PRIME64_1;
+
+    do
+    {
+      v1 = Hash_Xxh64Round(v1, Hash_Read64(p));      p += 8;
+      v2 = Hash_Xxh64Round(v2, Hash_Read64(p));      p += 8;
+      v3 = Hash_Xxh64Round(v3, Hash_Read64(p));      p += 8;
+      v4 = Hash_Xxh64Round(v4, Hash_Read64(p));      p += 8;
+    }while(p <= limit);
+
+    h = HASH_ROTL64(v1, 1) + HASH_ROTL64(v2, 7) + HASH_ROTL64(v3, 12) + HASH_ROTL64(v4, 18);
+    h = Hash_Xxh64Merge(h, v1);
+    h = Hash_Xxh64Merge(h, v2);
+    h = Hash_Xxh64Merge(h, v3);
+    h = Hash_Xxh64Merge(h, v4);
+  }
+  else
+  {
+    h = seed + XXH_PRIME64_5;
+  }
+
+  h += size;
+
+  while(p + 8 <= end)
+  {
+    h ^= Hash_Xxh64Round(0, Hash_Read64(p));
+    h  = (HASH_ROTL64(h, 27) * XXH_PRIME64_1) + XXH_PRIME64_4;
+    p += 8;
+  }
+
+  if(p + 4 <= end)
+  {
+    h ^= (uint64)Hash_Read32(p) * XXH_PRIME64_1;
+    h  = (HASH_ROTL64(h, 23) * XXH_PRIME64_2) + XXH_PRIME64_3;
+    p += 4;
+  }
+
+  while(p < end)
+  {
+    h ^= (*p) * XXH_PRIME64_5;
+    h  = HASH_ROTL64(h, 11) * XXH_PRIME64_1;
+    p++;
+  }
+
+  /* avalanche */
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+
+  return(h);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_String
+** Description: FNV-1a hash of a null terminated string (hash table keys)
+** Parameter:   const char* str
+** Return:      uint32
+*******************************************************************************************************************/
+uint32 Hash_String(const char* str)
+{
+  uint32 h = FNV32_OFFSET;
+
+  while(*str != '\0')
+  {
+    h ^= (uint8)*str++;
+    h *= FNV32_PRIME;
+  }
+  return(h);
+}
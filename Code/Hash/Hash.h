@@ -0,0 +1,35 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __HASH_H__
+#define __HASH_H__
+
+#include<common.h>
+
+#define HASH_BLAKE3_LEN        32U
+#define HASH_BLAKE3_CHUNK_LEN  1024U
+#define HASH_BLAKE3_LEAF_LEN   65536U      //largest subtree hashed as one leaf
+
+//one independently hashed piece of a BLAKE3 input (see Hash_Blake3Plan)
+typedef struct
+{
+  uint64  offset;
+  uint64  size;
+  uint64  counter;                     //index of the first chunk of the leaf
+  boolean tail;                        //partial chunk at the end of the input
+  uint8   cv[HASH_BLAKE3_LEN];         //chaining value of the leaf
+}sHashBlake3Leaf;
+
+uint64 Hash_Xxh64(const void* data, uint64 size, uint64 seed);
+uint32 Hash_String(const char* str);
+
+void   Hash_Blake3(const void* data, uint64 size, uint8* out);
+uint32 Hash_Blake3Plan(uint64 size, sHashBlake3Leaf* leaves);
+void   Hash_Blake3Leaf(const void* data, sHashBlake3Leaf* leaf);
+void   Hash_Blake3Finish(const void* data, const sHashBlake3Leaf* leaves, uint32 count, uint8* out);
+
+#endif
@@ -0,0 +1,450 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** BLAKE3 hash (default hash mode, 32 byte output).
+**
+** The input is split in leaves (see Hash_Blake3Plan): power of two subtrees of at most HASH_BLAKE3_LEAF_LEN bytes
+** and a last partial chunk. The chaining value of each leaf depends only on its bytes and its chunk counter, so
+** the leaves can be hashed in any order by any thread (Hash_Blake3Leaf). Hash_Blake3Finish merges the leaf
+** chaining values in order into the root. The result is identical to the reference implementation.
+*******************************************************************************************************************/
+
+#include<Hash.h>
+#include<Arena.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #define HASH_BLAKE3_SSE2
+  #include<emmintrin.h>
+#endif
+
+#define BLAKE3_BLOCK_LEN    64U
+#define BLAKE3_CHUNK_START  (1U << 0)
+#define BLAKE3_CHUNK_END    (1U << 1)
+#define BLAKE3_PARENT       (1U << 2)
+#define BLAKE3_ROOT         (1U << 3)
+#define BLAKE3_MAX_DEPTH    54U
+
+//input of the last compression of a chunk or parent node (root or chaining value output)
+typedef struct
+{
+  uint32 cv[8];
+  uint8  block[BLAKE3_BLOCK_LEN];
+  uint8  BlockLen;
+  uint64 counter;
+  uint8  flags;
+}sBlake3Output;
+
+static const uint32 Blake3Iv[8] = {
+                                    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+                                    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+                                  };
+
+static const uint8 Blake3Schedule[7][16] = {
+                                             { 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15},
+                                             { 2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8},
+                                             { 3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1},
+                                             {10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6},
+                                             {12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4},
+                                             { 9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7},
+                                             {11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13}
+                                           };
+
+#if defined(HASH_BLAKE3_SSE2)
+
+#define BLAKE3_ROTR_SSE2(x, n)  _mm_or_si128(_mm_srli_epi32((x), (n)), _mm_slli_epi32((x), 32 - (n)))
+#define BLAKE3_ROTR16_SSE2(x)   _mm_shufflehi_epi16(_mm_shufflelo_epi16((x), 0xB1), 0xB1)
+
+#define BLAKE3_G_SSE2(a, b, c, d, mx, my)                                         \
+  do                                                                              \
+  {                                                                               \
+    a = _mm_add_epi32(_mm_add_epi32(a, b), mx);                                   \
+    d = BLAKE3_ROTR16_SSE2(_mm_xor_si128(d, a));                                  \
+    c = _mm_add_epi32(c, d);                                                      \
+    b = BLAKE3_ROTR_SSE2(_mm_xor_si128(b, c), 12);                                \
+    a = _mm_add_epi32(_mm_add_epi32(a, b), my);                                   \
+    d = BLAKE3_ROTR_SSE2(_mm_xor_si128(d, a), 8);                                 \
+    c = _mm_add_epi32(c, d);                                                      \
+    b = BLAKE3_ROTR_SSE2(_mm_xor_si128(b, c), 7);                                 \
+  }while(0)
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Compress
+** Description: compression function, the four rows of the state are kept in SSE2 registers and the column and
+**              diagonal steps of a round run as one vector G each
+** Parameter:   const uint32* cv, const uint8* block, uint8 BlockLen, uint64 counter, uint8 flags, uint32* out
+** Return:      void (out receives the 8 word chaining value)
+*******************************************************************************************************************/
+static void Hash_Blake3Compress(const uint32* cv, const uint8* block, uint8 BlockLen, uint64 counter, uint8 flags, uint32* out)
+{
+  uint32  m[16];
+  __m128i row0 = _mm_loadu_si128((const __m128i*)&cv[0]);
+  __m128i row1 = _mm_loadu_si128((const __m128i*)&cv[4]);
+  __m128i row2 = _mm_loadu_si128((const __m128i*)&Blake3Iv[0]);
+  __m128i row3 = _mm_set_epi32((int)flags, (int)BlockLen, (int)(uint32)(counter >> 32), (int)(uint32)counter);
+
+  memcpy(m, block, sizeof(m));
+
+  for(uint32 r = 0; r < 7; r++)
+  {
+    const uint8* s = Blake3Schedule[r];
+
+    /* columns */
+    BLAKE3_G_SSE2(row0, row1, row2, row3,
+                  _mm_set_epi32((int)m[s[6]],  (int)m[s[4]],  (int)m[s[2]],  (int)m[s[0]]),
+                  _mm_set_epi32((int)m[s[7]],  (int)m[s[5]],  (int)m[s[3]],  (int)m[s[1]]));
+
+    /* diagonals: rotate the rows so that each diagonal is one lane */
+    row1 = _mm_shuffle_epi32(row1, 0x39);
+    row2 = _mm_shuffle_epi32(row2, 0x4E);
+    row3 = _mm_shuffle_epi32(row3, 0x93);
+
+    BLAKE3_G_SSE2(row0, row1, row2, row3,
+                  _mm_set_epi32((int)m[s[14]], (int)m[s[12]], (int)m[s[10]], (int)m[s[8]]),
+                  _mm_set_epi32((int)m[s[15]], (int)m[s[13]], (int)m[s[11]], (int)m[s[9]]));
+
+    row1 = _mm_shuffle_epi32(row1, 0x93);
+    row2 = _mm_shuffle_epi32(row2, 0x4E);
+    row3 = _mm_shuffle_epi32(row3, 0x39);
+  }
+
+  _mm_storeu_si128((__m128i*)&out[0], _mm_xor_si128(row0, row2));
+  _mm_storeu_si128((__m128i*)&out[4], _mm_xor_si128(row1, row3));
+}
+
+#else
+
+#define BLAKE3_ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+
+#define BLAKE3_G(v, a, b, c, d, mx, my)                                           \
+  do                                                                              \
+  {                                                                               \
+    v[a] = v[a] + v[b] + (mx);                                                    \
+    v[d] = BLAKE3_ROTR(v[d] ^ v[a], 16);                                          \
+    v[c] = v[c] + v[d];                                                           \
+    v[b] = BLAKE3_ROTR(v[b] ^ v[c], 12);                                          \
+    v[a] = v[a] + v[b] + (my);                                                    \
+    v[d] = BLAKE3_ROTR(v[d] ^ v[a], 8);                                           \
+    v[c] = v[c] + v[d];                                                           \
+    v[b] = BLAKE3_ROTR(v[b] ^ v[c], 7);                                           \
+  }while(0)
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Compress
+** Description: compression function (portable version)
+** Parameter:   const uint32* cv, const uint8* block, uint8 BlockLen, uint64 counter, uint8 flags, uint32* out
+** Return:      void (out receives the 8 word chaining value)
+*******************************************************************************************************************/
+static void Hash_Blake3Compress(const uint32* cv, const uint8* block, uint8 BlockLen, uint64 counter, uint8 flags, uint32* out)
+{
+  uint32 m[16];
+  uint32 v[16];
+
+  memcpy(m, block, sizeof(m));
+  memcpy(&v[0], cv, 8 * sizeof(uint32));
+  memcpy(&v[8], Blake3Iv, 4 * sizeof(uint32));
+  v[12] = (uint32)counter;
+  v[13] = (uint32)(counter >> 32);
+  v[14] = BlockLen;
+  v[15] = flags;
+
+  for(uint32 r = 0; r < 7; r++)
+  {
+    const uint8* s = Blake3Schedule[r];
+
+    BLAKE3_G(v, 0, 4,  8, 12, m[s[0]],  m[s[1]]);
+    BLAKE3_G(v, 1, 5,  9, 13, m[s[2]],  m[s[3]]);
+    BLAKE3_G(v, 2, 6, 10, 14, m[s[4]],  m[s[5]]);
+    BLAKE3_G(v, 3, 7, 11, 15, m[s[6]],  m[s[7]]);
+    BLAKE3_G(v, 0, 5, 10, 15, m[s[8]],  m[s[9]]);
+    BLAKE3_G(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+    BLAKE3_G(v, 2, 7,  8, 13, m[s[12]], m[s[13]]);
+    BLAKE3_G(v, 3, 4,  9, 14, m[s[14]], m[s[15]]);
+  }
+
+  for(uint32 i = 0; i < 8; i++)
+  {
+    out[i] = v[i] ^ v[i + 8];
+  }
+}
+
+#endif
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3ChunkOutput
+** Description: compress all the blocks of one chunk but the last one, which is returned as the chunk output
+** Parameter:   const uint8* input, uint32 len (at most one chunk), uint64 counter, sBlake3Output* output
+** Return:      void
+*******************************************************************************************************************/
+static void Hash_Blake3ChunkOutput(const uint8* input, uint32 len, uint64 counter, sBlake3Output* output)
+{
+  uint8 flags = BLAKE3_CHUNK_START;
+
+  memcpy(output->cv, Blake3Iv, sizeof(Blake3Iv));
+
+  while(len > BLAKE3_BLOCK_LEN)
+  {
+    Hash_Blake3Compress(output->cv, input, BLAKE3_BLOCK_LEN, counter, flags, output->cv);
+    input += BLAKE3_BLOCK_LEN;
+    len   -= BLAKE3_BLOCK_LEN;
+    flags  = 0;
+  }
+
+  memset(output->block, 0, BLAKE3_BLOCK_LEN);
+  memcpy(output->block, input, len);
+  output->BlockLen = (uint8)len;
+  output->counter  = counter;
+  output->flags    = (uint8)(flags | BLAKE3_CHUNK_END);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3ParentOutput
+** Description: parent node of two chaining values
+** Parameter:   const uint32* left, const uint32* right, sBlake3Output* output
+** Return:      void
+*******************************************************************************************************************/
+static void Hash_Blake3ParentOutput(const uint32* left, const uint32* right, sBlake3Output* output)
+{
+  memcpy(output->cv, Blake3Iv, sizeof(Blake3Iv));
+  memcpy(&output->block[0], left, 32);
+  memcpy(&output->block[32], right, 32);
+  output->BlockLen = BLAKE3_BLOCK_LEN;
+  output->counter  = 0;
+  output->flags    = BLAKE3_PARENT;
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Subtree
+** Description: chaining value of a power of two number of whole chunks
+** Parameter:   const uint8* input, uint64 chunks, uint64 counter, uint32* cv
+** Return:      void
+*******************************************************************************************************************/
+static void Hash_Blake3Subtree(const uint8* input, uint64 chunks, uint64 counter, uint32* cv)
+{
+  sBlake3Output output;
+
+  if(chunks == 1)
+  {
+    Hash_Blake3ChunkOutput(input, HASH_BLAKE3_CHUNK_LEN, counter, &output);
+  }
+  else
+  {
+    uint32 left[8];
+    uint32 right[8];
+    uint64 half = chunks / 2;
+
+    Hash_Blake3Subtree(input, half, counter, left);
+    Hash_Blake3Subtree(input + (size_t)(half * HASH_BLAKE3_CHUNK_LEN), half, counter + half, right);
+    Hash_Blake3ParentOutput(left, right, &output);
+  }
+
+  Hash_Blake3Compress(output.cv, output.block, output.BlockLen, output.counter, output.flags, cv);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Plan
+** Description: split an input of size bytes in leaves, following the subtree order of the reference
+**              implementation. Large subtrees are cut in HASH_BLAKE3_LEAF_LEN pieces. The last leaf is the partial
+**              (or empty) chunk left at the end of the input, if any.
+** Parameter:   uint64 size, sHashBlake3Leaf* leaves (NULL to only count the leaves)
+** Return:      uint32 (number of leaves)
+*******************************************************************************************************************/
+uint32 Hash_Blake3Plan(uint64 size, sHashBlake3Leaf* leaves)
+{
+  uint32 count   = 0;
+  uint64 offset  = 0;
+  uint64 counter = 0;
+  uint64 left    = size;
+
+  while(left > HASH_BLAKE3_CHUNK_LEN)
+  {
+    uint64 subtree = 1;
+
+    /* largest power of two not above the remaining input and aligned on the bytes already consumed */
+    while((subtree << 1) <= left)
+    {
+      subtree <<= 1;
+    }
+    while(((subtree - 1) & offset) != 0)
+    {
+      subtree >>= 1;
+    }
+
+    /* a subtree of several chunks gives at least its two halves, the root is never hashed as a leaf */
+    uint64 len = (subtree > HASH_BLAKE3_CHUNK_LEN) ? (subtree / 2) : subtree;
+
+    if(len > HASH_BLAKE3_LEAF_LEN)
+    {
+      len = HASH_BLAKE3_LEAF_LEN;
+    }
+
+    for(uint64 piece = 0; piece < subtree; piece += len)
+    {
+      if(leaves != NULL)
+      {
+        leaves[count].offset  = offset + piece;
+        leaves[count].size    = len;
+        leaves[count].counter = counter + (piece / HASH_BLAKE3_CHUNK_LEN);
+        leaves[count].tail    = FALSE;
+      }
+      count++;
+    }
+
+    offset  += subtree;
+    counter += subtree / HASH_BLAKE3_CHUNK_LEN;
+    left    -= subtree;
+  }
+
+  if(left > 0 || count == 0)
+  {
+    if(leaves != NULL)
+    {
+      leaves[count].offset  = offset;
+      leaves[count].size    = left;
+      leaves[count].counter = counter;
+      leaves[count].tail    = TRUE;
+    }
+    count++;
+  }
+  return(count);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Leaf
+** Description: compute the chaining value of one leaf (thread safe, leaves are independent)
+** Parameter:   const void* data (start of the whole input), sHashBlake3Leaf* leaf
+** Return:      void
+*******************************************************************************************************************/
+void Hash_Blake3Leaf(const void* data, sHashBlake3Leaf* leaf)
+{
+  const uint8* input = (const uint8*)data + (size_t)leaf->offset;
+  uint32       cv[8];
+
+  if(leaf->tail)
+  {
+    sBlake3Output output;
+
+    Hash_Blake3ChunkOutput(input, (uint32)leaf->size, leaf->counter, &output);
+    Hash_Blake3Compress(output.cv, output.block, output.BlockLen, output.counter, output.flags, cv);
+  }
+  else
+  {
+    Hash_Blake3Subtree(input, leaf->size / HASH_BLAKE3_CHUNK_LEN, leaf->counter, cv);
+  }
+
+  memcpy(leaf->cv, cv, HASH_BLAKE3_LEN);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3MergeStack
+** Description: merge the completed subtrees of the chaining value stack: before the chunk number chunks, the
+**              stack holds one entry per bit set in chunks
+** Parameter:   uint32 (*stack)[8], uint32* depth, uint64 chunks
+** Return:      void
+*******************************************************************************************************************/
+static void Hash_Blake3MergeStack(uint32 (*stack)[8], uint32* depth, uint64 chunks)
+{
+  sBlake3Output output;
+  uint32        keep = 0;
+
+  while(chunks != 0)
+  {
+    keep   += (uint32)(chunks & 1);
+    chunks >>= 1;
+  }
+
+  while(*depth > keep)
+  {
+    Hash_Blake3ParentOutput(stack[*depth - 2], stack[*depth - 1], &output);
+    Hash_Blake3Compress(output.cv, output.block, output.BlockLen, output.counter, output.flags, stack[*depth - 2]);
+    (*depth)--;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3Finish
+** Description: merge the chaining values of the leaves (computed by Hash_Blake3Leaf) into the root hash
+** Parameter:   const void* data, const sHashBlake3Leaf* leaves, uint32 count, uint8* out (HASH_BLAKE3_LEN bytes)
+** Return:      void
+*******************************************************************************************************************/
+void Hash_Blake3Finish(const void* data, const sHashBlake3Leaf* leaves, uint32 count, uint8* out)
+{
+  uint32        stack[BLAKE3_MAX_DEPTH][8];
+  uint32        depth  = 0;
+  uint32        pushed = count;
+  sBlake3Output output;
+  uint32        root[8];
+
+  if(count > 0 && leaves[count - 1].tail)
+  {
+    pushed = count - 1;
+  }
+
+  /* push the chaining values, a subtree is merged as soon as it is known not to be the root */
+  for(uint32 i = 0; i < pushed; i++)
+  {
+    Hash_Blake3MergeStack(stack, &depth, leaves[i].counter);
+    memcpy(stack[depth++], leaves[i].cv, HASH_BLAKE3_LEN);
+  }
+
+  if(pushed < count)
+  {
+    const sHashBlake3Leaf* tail = &leaves[count - 1];
+
+    Hash_Blake3MergeStack(stack, &depth, tail->counter);
+    Hash_Blake3ChunkOutput((const uint8*)data + (size_t)tail->offset, (uint32)tail->size, tail->counter, &output);
+  }
+  else
+  {
+    /* the input ends on a subtree boundary: the two last chaining values are the children of the root path */
+    depth -= 2;
+    Hash_Blake3ParentOutput(stack[depth], stack[depth + 1], &output);
+  }
+
+  while(depth > 0)
+  {
+    uint32 cv[8];
+
+    depth--;
+    Hash_Blake3Compress(output.cv, output.block, output.BlockLen, output.counter, output.flags, cv);
+    Hash_Blake3ParentOutput(stack[depth], cv, &output);
+  }
+
+  Hash_Blake3Compress(output.cv, output.block, output.BlockLen, 0, (uint8)(output.flags | BLAKE3_ROOT), root);
+  memcpy(out, root, HASH_BLAKE3_LEN);
+}
+
+/*******************************************************************************************************************
+** Function:    Hash_Blake3
+** Description: BLAKE3 hash of a memory block (single thread). The leaves are taken from the arena of the calling
+**              thread (called by the parallel jobs).
+** Parameter:   const void* data, uint64 size, uint8* out (HASH_BLAKE3_LEN bytes)
+** Return:      void
+*******************************************************************************************************************/
+void Hash_Blake3(const void* data, uint64 size, uint8* out)
+{
+  sArena*          arena  = Arena_Thread();
+  sArenaMark       mark   = Arena_Mark(arena);
+  uint32           count  = Hash_Blake3Plan(size, NULL);
+  sHashBlake3Leaf* leaves = (sHashBlake3Leaf*)Arena_Alloc(arena, (size_t)count * sizeof(sHashBlake3Leaf));
+
+  if(leaves == NULL)
+  {
+    memset(out, 0, HASH_BLAKE3_LEN);
+    return;
+  }
+
+  Hash_Blake3Plan(size, leaves);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    Hash_Blake3Leaf(data, &leaves[i]);
+  }
+
+  Hash_Blake3Finish(data, leaves, count, out);
+  Arena_Rewind(arena, mark);
+}
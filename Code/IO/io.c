@@ -1,80 +1,120 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#include<io.h>
-
-
-
-/*******************************************************************************************************************
-** Function:    LoadInputFile2
-** Description: load input file into the RAM
-** Parameter:   char* path
-** Return:      unsigned char*
-*******************************************************************************************************************/
-unsigned char* LoadInputFile(char* path)
-{
-    FILE* file = NULL;
-    unsigned char* buf = NULL;
-    unsigned int filesize = 0;
-
-    if(path != NULL)
-    {
-      file = fopen(path, "rb");
-    }
-
-    if (file != NULL)
-    {
-        /* determinate the size of the file */
-        fseek(file, 0, SEEK_END);
-        filesize = ftell(file) + sizeof(char);
-        fseek(file, 0, SEEK_SET);
-
-        /* dynamic allocation */
-        buf = (char*)malloc(filesize * sizeof(char));
-
-        /* read the data from the file */
-        fread(buf, filesize, sizeof(unsigned char), file);
-
-        fclose(file);
-        return(buf);
-    }
-    else
-    {
-        printf("\n\r error: Cannot open the file !\n\r");
-        return(buf);
-    }
-}
-
-
-/*******************************************************************************************************************
-** Function:    SaveOutputFile
-** Description: Save RAM buffer to a file
-** Parameter:   char* path
-** Return:      boolean
-*******************************************************************************************************************/
-boolean SaveOutputFile(char* path, string buf)
-{
-    FILE* file = NULL;
-
-    if(path != NULL)
-    {
-      file = fopen(path, "w");
-    }
-
-    if (file != NULL)
-    {
-      fwrite(buf, strlen(buf), sizeof(char), file);
-      
-      fclose(file);
-      return(TRUE);
-    }
-    else
-    {
-        DbgPrint("\n\r error: Cannot save the file !\n\r");
-        return(FALSE);
-    }
-}
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<io.h>
+#include<Stats.h>
+
+
+
+/*******************************************************************************************************************
+** Function:    LoadInputFile
+** Description: load input file into the RAM
+** Parameter:   char* path, uint32* size (file size in bytes, may be NULL)
+** Return:      unsigned char*
+*******************************************************************************************************************/
+unsigned char* LoadInputFile(char* path, uint32* size)
+{
+    FILE* file = NULL;
+    unsigned char* buf = NULL;
+    unsigned int filesize = 0;
+
+    if(path != NULL)
+    {
+      file = fopen(path, "rb");
+    }
+
+    if (file != NULL)
+    {
+        /* determinate the size of the file */
+        fseek(file, 0, SEEK_END);
+        filesize = ftell(file) + sizeof(char);
+        fseek(file, 0, SEEK_SET);
+
+        /* dynamic allocation */
+        buf = (unsigned char*)malloc(filesize * sizeof(char));
+
+        /* read the data from the file, the extra byte terminates text files */
+        fread(buf, filesize, sizeof(unsigned char), file);
+        buf[filesize - sizeof(char)] = '\0';
+
+        if(size != NULL)
+        {
+          *size = filesize - sizeof(char);
+        }
+        Stats_AddRead(filesize - sizeof(char));
+
+        fclose(file);
+        return(buf);
+    }
+    else
+    {
+        printf("\n\r error: Cannot open the file !\n\r");
+        return(buf);
+    }
+}
+
+
+/*******************************************************************************************************************
+** Function:    SaveOutputFile
+** Description: Save RAM buffer to a file
+** Parameter:   char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean SaveOutputFile(char* path, string buf)
+{
+    FILE* file = NULL;
+
+    if(path != NULL)
+    {
+      file = fopen(path, "w");
+    }
+
+    if (file != NULL)
+    {
+      fwrite(buf, strlen((const char*)buf), sizeof(char), file);
+      
+      fclose(file);
+      return(TRUE);
+    }
+    else
+    {
+        DbgPrint("\n\r error: Cannot save the file !\n\r");
+        return(FALSE);
+    }
+}
+
+
+/*******************************************************************************************************************
+** Function:    SaveBinaryFile
+** Description: Save RAM buffer of size bytes to a binary file
+** Parameter:   char* path, const char* buf, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean SaveBinaryFile(char* path, const char* buf, uint32 size)
+{
+    FILE* file = NULL;
+    boolean result = FALSE;
+
+    if(path != NULL)
+    {
+      file = fopen(path, "wb");
+    }
+
+    if (file != NULL)
+    {
+      result = (boolean)(size == 0 || 1 == fwrite(buf, size, 1, file));
+      Stats_AddWritten(result ? size : 0);
+
+      fclose(file);
+    }
+
+    if(!result)
+    {
+        printf("\n\r error: Cannot save the file !\n\r");
+    }
+    return(result);
+}
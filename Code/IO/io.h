@@ -1,19 +1,20 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#ifndef __IO_H__
-#define __IO_H__
-
-#include<Common.h>
-
-
-boolean SaveOutputFile(char* path, string buf);
-string LoadInputFile(char* path);
-
-
-
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __IO_H__
+#define __IO_H__
+
+#include<common.h>
+
+
+boolean SaveOutputFile(char* path, string buf);
+string LoadInputFile(char* path, uint32* size);
+boolean SaveBinaryFile(char* path, const char* buf, uint32 size);
+
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,541 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Image.h>
+#include<Elf.h>
+
+static int  Image_CompareRegions(const void* a, const void* b);
+static void Image_WriteChunk(uint64 addr, const uint8* data, uint64 size, void* ctx);
+
+/*******************************************************************************************************************
+** Function:    Image_BuildFromElf
+** Description: build the load image of an opened ELF file from its loadable sections (same content as the
+**              S19 export). The regions point into the ELF buffer, nothing is copied. The SHF_ALLOC sections
+**              of the section directory are already sorted by address, so the regions need no sort.
+** Parameter:   sImage* image, sElf* elf
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Image_BuildFromElf(sImage* image, sElf* elf)
+{
+  sElfSection*  sections = NULL;
+  uint32        count    = 0;
+  const uint32* alloc    = NULL;
+  uint32        AllocNbr = 0;
+
+  memset(image, 0, sizeof(sImage));
+
+  if(!Elf_GetSections(elf, &sections, &count))
+  {
+    return(FALSE);
+  }
+
+  AllocNbr = Elf_GetAllocSections(elf, &alloc);
+
+  for(uint32 k = 0; k < AllocNbr; k++)
+  {
+    sElfSection* section = &sections[alloc[k]];
+
+    if(ELF_IS_LOAD_SECTION(section->type, section->flags, section->size))
+    {
+      if(!Image_AddRegion(image, section->addr, section->size, (uint8*)section->data, section->name))
+      {
+        Image_Release(image);
+        return(FALSE);
+      }
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_AddRegion
+** Description: append one region (call Image_Sort once all the regions are added)
+** Parameter:   sImage* image, uint64 addr, uint64 size, uint8* data, char* name
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Image_AddRegion(sImage* image, uint64 addr, uint64 size, uint8* data, char* name)
+{
+  if(image->RegionsNbr == image->capacity)
+  {
+    uint32        capacity = (image->capacity == 0) ? 16U : (image->capacity * 2U);
+    sImageRegion* regions  = (sImageRegion*)realloc(image->regions, (size_t)capacity * sizeof(sImageRegion));
+
+    if(regions == NULL)
+    {
+      return(FALSE);
+    }
+    image->regions  = regions;
+    image->capacity = capacity;
+  }
+
+  image->regions[image->RegionsNbr].addr = addr;
+  image->regions[image->RegionsNbr].size = size;
+  image->regions[image->RegionsNbr].data = data;
+  image->regions[image->RegionsNbr].name = name;
+  image->RegionsNbr++;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_Sort
+** Description: sort the regions by address
+** Parameter:   sImage* image
+** Return:      void
+*******************************************************************************************************************/
+void Image_Sort(sImage* image)
+{
+  if(image->RegionsNbr > 1)
+  {
+    qsort(image->regions, image->RegionsNbr, sizeof(sImageRegion), Image_CompareRegions);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Image_CompareRegions
+** Description: qsort callback: by address, then by size
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Image_CompareRegions(const void* a, const void* b)
+{
+  const sImageRegion* x = (const sImageRegion*)a;
+  const sImageRegion* y = (const sImageRegion*)b;
+
+  if(x->addr != y->addr)
+  {
+    return((x->addr < y->addr) ? -1 : 1);
+  }
+  if(x->size != y->size)
+  {
+    return((x->size < y->size) ? -1 : 1);
+  }
+  return(0);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_FindRegion
+** Description: binary search of the region which contains addr
+** Parameter:   const sImage* image, uint64 addr
+** Return:      uint32 (region index, IMAGE_NONE if addr is in a gap)
+*******************************************************************************************************************/
+uint32 Image_FindRegion(const sImage* image, uint64 addr)
+{
+  uint32 low  = 0;
+  uint32 high = image->RegionsNbr;
+
+  /* first region starting after addr */
+  while(low < high)
+  {
+    uint32 mid = low + ((high - low) / 2);
+
+    if(image->regions[mid].addr <= addr)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  if(low > 0 && (addr - image->regions[low - 1].addr) < image->regions[low - 1].size)
+  {
+    return(low - 1);
+  }
+  return(IMAGE_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_WalkRange
+** Description: hand over the content of [start, end] (end included) in address order. Bytes not covered by a
+**              region are given as fill bytes. Overlapping regions are read from the lowest region.
+** Parameter:   const sImage* image, uint64 start, uint64 end, uint8 fill, pfImageChunk callback, void* ctx
+** Return:      void
+*******************************************************************************************************************/
+void Image_WalkRange(const sImage* image, uint64 start, uint64 end, uint8 fill, pfImageChunk callback, void* ctx)
+{
+  uint8  pattern[IMAGE_FILL_CHUNK];
+  uint64 addr  = start;
+  uint32 first = 0;
+
+  memset(pattern, fill, sizeof(pattern));
+
+  while(first < image->RegionsNbr && (image->regions[first].addr + image->regions[first].size) <= start)
+  {
+    first++;
+  }
+
+  while(addr <= end)
+  {
+    uint32 r    = Image_FindRegion(image, addr);
+    uint64 next = end;
+
+    if(r != IMAGE_NONE)
+    {
+      const sImageRegion* region = &image->regions[r];
+      uint64              last   = region->addr + region->size - 1;
+
+      next = (last < end) ? last : end;
+      callback(addr, region->data + (size_t)(addr - region->addr), next - addr + 1, ctx);
+    }
+    else
+    {
+      /* gap up to the next region */
+      while(first < image->RegionsNbr && image->regions[first].addr <= addr)
+      {
+        first++;
+      }
+      if(first < image->RegionsNbr && image->regions[first].addr - 1 < end)
+      {
+        next = image->regions[first].addr - 1;
+      }
+
+      for(uint64 pos = addr; pos <= next; pos += IMAGE_FILL_CHUNK)
+      {
+        uint64 size = next - pos + 1;
+
+        callback(pos, pattern, (size < IMAGE_FILL_CHUNK) ? size : IMAGE_FILL_CHUNK, ctx);
+
+        if(size <= IMAGE_FILL_CHUNK)
+        {
+          break;
+        }
+      }
+    }
+
+    if(next == 0xFFFFFFFFFFFFFFFFULL)
+    {
+      break;
+    }
+    addr = next + 1;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Image_WriteChunk
+** Description: Image_WalkRange callback of the binary export
+** Parameter:   uint64 addr, const uint8* data, uint64 size, void* ctx (FILE*)
+** Return:      void
+*******************************************************************************************************************/
+static void Image_WriteChunk(uint64 addr, const uint8* data, uint64 size, void* ctx)
+{
+  (void)addr;
+  fwrite(data, 1, (size_t)size, (FILE*)ctx);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_WriteBinary
+** Description: write the image from its lowest to its highest address as a raw binary, gaps are filled
+** Parameter:   const sImage* image, char* path, uint8 fill
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Image_WriteBinary(const sImage* image, char* path, uint8 fill)
+{
+  uint64 start = 0;
+  uint64 end   = 0;
+  FILE*  file  = NULL;
+
+  if(image->RegionsNbr == 0)
+  {
+    printf("\n\r error: The image has no loadable content !\n\r");
+    return(FALSE);
+  }
+
+  start = image->regions[0].addr;
+
+  for(uint32 i = 0; i < image->RegionsNbr; i++)
+  {
+    uint64 last = image->regions[i].addr + image->regions[i].size - 1;
+    end = (last > end) ? last : end;
+  }
+
+  if(end - start >= IMAGE_MAX_SPAN)
+  {
+    printf("\n\r error: The image spans 0x%llx - 0x%llx, too large for a binary file !\n\r",
+           (unsigned long long)start, (unsigned long long)end);
+    return(FALSE);
+  }
+
+  file = fopen(path, "wb");
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Cannot save the file !\n\r");
+    return(FALSE);
+  }
+
+  Image_WalkRange(image, start, end, fill, Image_WriteChunk, file);
+  fclose(file);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_Release
+** Description: free the region table (the region data are not owned by the image)
+** Parameter:   sImage* image
+** Return:      void
+*******************************************************************************************************************/
+void Image_Release(sImage* image)
+{
+  free(image->regions);
+  memset(image, 0, sizeof(sImage));
+}
+
+/*******************************************************************************************************************
+** Function:    Image_WrapElf
+** Description: build a minimal 32 bit ELF file of a sorted image: the regions of consecutive addresses form one
+**              block, each block is one PROGBITS section (named after its region when it has only one, ".load<n>"
+**              otherwise) and one PT_LOAD segment
+** Parameter:   const sImage* image, uint64 entry, uint32* size
+** Return:      char* (file content to free, NULL on error)
+*******************************************************************************************************************/
+char* Image_WrapElf(const sImage* image, uint64 entry, uint32* size)
+{
+  const sImageRegion* regions = image->regions;
+  uint32              count   = 0;
+  uint64              DataOff = 0;
+  uint64              StrOff  = 0;
+  uint64              StrSize = 1U + sizeof(".shstrtab");
+  uint64              ShOff   = 0;
+  uint64              total   = 0;
+  char*               file    = NULL;
+  Elf32_Ehdr*         ehdr    = NULL;
+  Elf32_Phdr*         phdr    = NULL;
+  Elf32_Shdr*         shdr    = NULL;
+  char*               names   = NULL;
+  uint32              NameLen = 1;
+  uint64              offset  = 0;
+
+  *size = 0;
+
+  /* blocks, data size and names size */
+  for(uint32 i = 0, first = 0; i < image->RegionsNbr; i++)
+  {
+    DataOff += regions[i].size;
+
+    if(i + 1U == image->RegionsNbr || regions[i + 1U].addr != regions[i].addr + regions[i].size)
+    {
+      StrSize += (first == i && regions[i].name != NULL) ? (strlen(regions[i].name) + 1U) : 16U;
+      first    = i + 1U;
+      count++;
+    }
+  }
+
+  StrOff  = sizeof(Elf32_Ehdr) + (uint64)count * sizeof(Elf32_Phdr) + DataOff;
+  DataOff = sizeof(Elf32_Ehdr) + (uint64)count * sizeof(Elf32_Phdr);
+  ShOff   = (StrOff + StrSize + 3U) & ~(uint64)3U;
+  total   = ShOff + ((uint64)count + 2U) * sizeof(Elf32_Shdr);
+
+  if(count + 2U >= 0xFF00U || total > 0xFFFFFFFFULL || (image->RegionsNbr > 0 &&
+     regions[image->RegionsNbr - 1U].addr + regions[image->RegionsNbr - 1U].size > 0x100000000ULL))
+  {
+    printf("\n\r error: The image (%u block(s)) does not fit in a 32 bit ELF file !\n\r", count);
+    return(NULL);
+  }
+
+  file = (char*)calloc((size_t)total, sizeof(char));
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(NULL);
+  }
+
+  ehdr  = (Elf32_Ehdr*)file;
+  phdr  = (Elf32_Phdr*)(file + sizeof(Elf32_Ehdr));
+  shdr  = (Elf32_Shdr*)(file + (size_t)ShOff);
+  names = file + (size_t)StrOff;
+
+  ehdr->e_ident[0]  = 0x7F;
+  ehdr->e_ident[1]  = 'E';
+  ehdr->e_ident[2]  = 'L';
+  ehdr->e_ident[3]  = 'F';
+  ehdr->e_ident[4]  = ELFCLASS32;
+  ehdr->e_ident[5]  = ELFDATA2LSB;
+  ehdr->e_ident[6]  = EV_CURRENT;
+  ehdr->e_type      = ET_EXEC;
+  ehdr->e_machine   = EM_NONE;
+  ehdr->e_version   = EV_CURRENT;
+  ehdr->e_entry     = (Elf32_Addr)entry;
+  ehdr->e_phoff     = (count > 0) ? (Elf32_Off)sizeof(Elf32_Ehdr) : 0;
+  ehdr->e_shoff     = (Elf32_Off)ShOff;
+  ehdr->e_ehsize    = (Elf32_Half)sizeof(Elf32_Ehdr);
+  ehdr->e_phentsize = (Elf32_Half)sizeof(Elf32_Phdr);
+  ehdr->e_phnum     = (Elf32_Half)count;
+  ehdr->e_shentsize = (Elf32_Half)sizeof(Elf32_Shdr);
+  ehdr->e_shnum     = (Elf32_Half)(count + 2U);
+  ehdr->e_shstrndx  = (Elf32_Half)(count + 1U);
+
+  offset = DataOff;
+
+  for(uint32 i = 0, first = 0, block = 0; i < image->RegionsNbr; i++)
+  {
+    memcpy(file + (size_t)offset, regions[i].data, (size_t)regions[i].size);
+    offset += regions[i].size;
+
+    if(i + 1U == image->RegionsNbr || regions[i + 1U].addr != regions[i].addr + regions[i].size)
+    {
+      uint64 BlockSize = regions[i].addr + regions[i].size - regions[first].addr;
+
+      phdr[block].p_type   = PT_LOAD;
+      phdr[block].p_offset = (Elf32_Off)(offset - BlockSize);
+      phdr[block].p_vaddr  = (Elf32_Addr)regions[first].addr;
+      phdr[block].p_paddr  = (Elf32_Addr)regions[first].addr;
+      phdr[block].p_filesz = (Elf32_Word)BlockSize;
+      phdr[block].p_memsz  = (Elf32_Word)BlockSize;
+      phdr[block].p_flags  = PF_R | PF_W | PF_X;
+      phdr[block].p_align  = 1;
+
+      shdr[block + 1U].sh_name      = NameLen;
+      shdr[block + 1U].sh_type      = SHT_PROGBITS;
+      shdr[block + 1U].sh_flags     = SHF_ALLOC | SHF_WRITE | SHF_EXECU;
+      shdr[block + 1U].sh_addr      = (Elf32_Addr)regions[first].addr;
+      shdr[block + 1U].sh_offset    = (Elf32_Off)(offset - BlockSize);
+      shdr[block + 1U].sh_size      = (Elf32_Word)BlockSize;
+      shdr[block + 1U].sh_addralign = 1;
+
+      if(first == i && regions[i].name != NULL)
+      {
+        strcpy(&names[NameLen], regions[i].name);
+        NameLen += (uint32)strlen(regions[i].name) + 1U;
+      }
+      else
+      {
+        NameLen += (uint32)sprintf(&names[NameLen], ".load%u", (unsigned int)block) + 1U;
+      }
+
+      first = i + 1U;
+      block++;
+    }
+  }
+
+  shdr[count + 1U].sh_name      = NameLen;
+  shdr[count + 1U].sh_type      = SHT_STRTAB;
+  shdr[count + 1U].sh_offset    = (Elf32_Off)StrOff;
+  shdr[count + 1U].sh_addralign = 1;
+  strcpy(&names[NameLen], ".shstrtab");
+  NameLen += (uint32)sizeof(".shstrtab");
+  shdr[count + 1U].sh_size      = NameLen;
+
+  *size = (uint32)total;
+  return(file);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_CompareSymbols
+** Description: qsort callback, value order then size order (the largest symbol at an address is the last one)
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Image_CompareSymbols(const void* a, const void* b)
+{
+  const sImageSymbol* x = (const sImageSymbol*)a;
+  const sImageSymbol* y = (const sImageSymbol*)b;
+
+  if(x->value != y->value)
+  {
+    return((x->value < y->value) ? -1 : 1);
+  }
+  return((x->size < y->size) ? -1 : ((x->size > y->size) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Image_GetSymbols
+** Description: the symbols which name an address of the image (defined in a section, not a section or file
+**              symbol, not an ARM mapping symbol such as $d), sorted by address
+** Parameter:   sElf* elf, sImageSymbol** symbols (scratch arena of the thread)
+** Return:      uint32 (number of symbols)
+*******************************************************************************************************************/
+uint32 Image_GetSymbols(sElf* elf, sImageSymbol** symbols)
+{
+  sElfSymbol* all    = NULL;
+  uint32      AllNbr = 0;
+  uint32      count  = 0;
+
+  *symbols = NULL;
+
+  if(!Elf_GetSymbols(elf, &all, &AllNbr) || AllNbr == 0)
+  {
+    return(0);
+  }
+
+  *symbols = (sImageSymbol*)Arena_Alloc(Arena_Thread(), (size_t)AllNbr * sizeof(sImageSymbol));
+
+  for(uint32 i = 0; *symbols != NULL && i < AllNbr; i++)
+  {
+    uint8 type = ELF32_ST_TYPE(all[i].info);
+
+    if(all[i].shndx != 0 && all[i].shndx < ELF_SHN_RESERVED && type != STT_SECTIONS && type != STT_FILE &&
+       all[i].name[0] != '\0' && all[i].name[0] != '$')
+    {
+      (*symbols)[count].value = all[i].value;
+      (*symbols)[count].size  = all[i].size;
+      (*symbols)[count].name  = all[i].name;
+      count++;
+    }
+  }
+
+  if(count > 0)
+  {
+    qsort(*symbols, count, sizeof(sImageSymbol), Image_CompareSymbols);
+  }
+  return(count);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_FindSymbol
+** Description: the nearest symbol at or below an address
+** Parameter:   const sImageSymbol* symbols (sorted by Image_GetSymbols), uint32 count, uint64 addr
+** Return:      const sImageSymbol* (NULL: no symbol below the address)
+*******************************************************************************************************************/
+const sImageSymbol* Image_FindSymbol(const sImageSymbol* symbols, uint32 count, uint64 addr)
+{
+  uint32 lo = 0;
+  uint32 hi = count;
+
+  //first symbol above addr
+  while(lo < hi)
+  {
+    uint32 mid = lo + (hi - lo) / 2U;
+
+    if(symbols[mid].value <= addr)
+    {
+      lo = mid + 1U;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  return((lo == 0) ? NULL : &symbols[lo - 1U]);
+}
+
+/*******************************************************************************************************************
+** Function:    Image_SymbolName
+** Description: name an address by its nearest symbol: "<symbol>", "<symbol>+0x<offset>" or "-" without symbol
+** Parameter:   const sImageSymbol* symbols, uint32 count, uint64 addr, char* text, size_t size
+** Return:      void
+*******************************************************************************************************************/
+void Image_SymbolName(const sImageSymbol* symbols, uint32 count, uint64 addr, char* text, size_t size)
+{
+  const sImageSymbol* symbol = Image_FindSymbol(symbols, count, addr);
+
+  if(symbol == NULL)
+  {
+    snprintf(text, size, "-");
+  }
+  else if(symbol->value == addr)
+  {
+    snprintf(text, size, "%s", symbol->name);
+  }
+  else
+  {
+    snprintf(text, size, "%s+0x%llx", symbol->name, (unsigned long long)(addr - symbol->value));
+  }
+}
@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __IMAGE_H__
+#define __IMAGE_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define IMAGE_NONE           0xFFFFFFFFUL
+#define IMAGE_FILL_BYTE      0xFFU           //erased flash
+#define IMAGE_MAX_SPAN       0x40000000ULL   //largest binary export (1 GiB)
+#define IMAGE_FILL_CHUNK     4096U
+
+//one contiguous block of the load image
+typedef struct
+{
+  uint64 addr;
+  uint64 size;
+  uint8* data;
+  char*  name;
+}sImageRegion;
+
+//load image: the loadable content sorted by address
+typedef struct
+{
+  sImageRegion* regions;
+  uint32        RegionsNbr;
+  uint32        capacity;
+}sImage;
+
+//symbol naming an address of the load image (see Image_GetSymbols)
+typedef struct
+{
+  uint64      value;
+  uint64      size;
+  const char* name;
+}sImageSymbol;
+
+//called for each piece of an address range, data is the fill pattern in the gaps
+typedef void (*pfImageChunk)(uint64 addr, const uint8* data, uint64 size, void* ctx);
+
+boolean Image_BuildFromElf(sImage* image, sElf* elf);
+boolean Image_AddRegion(sImage* image, uint64 addr, uint64 size, uint8* data, char* name);
+void    Image_Sort(sImage* image);
+uint32  Image_FindRegion(const sImage* image, uint64 addr);
+void    Image_WalkRange(const sImage* image, uint64 start, uint64 end, uint8 fill, pfImageChunk callback, void* ctx);
+boolean Image_WriteBinary(const sImage* image, char* path, uint8 fill);
+void    Image_Release(sImage* image);
+char*   Image_WrapElf(const sImage* image, uint64 entry, uint32* size);
+uint32  Image_GetSymbols(sElf* elf, sImageSymbol** symbols);
+const sImageSymbol* Image_FindSymbol(const sImageSymbol* symbols, uint32 count, uint64 addr);
+void    Image_SymbolName(const sImageSymbol* symbols, uint32 count, uint64 addr, char* text, size_t size);
+
+#endif
@@ -0,0 +1,683 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Read-ahead of the files of a list (@<ListFile>).
+**
+** Up to LOADER_DEPTH files (LOADER_MAX_BYTES bytes) are read while the current one is processed, so that the
+** disks and the CPU work at the same time. The files are handed over in list order, their buffers are reused by
+** the following files (a pool, so that only the files in flight hold memory). The reads are:
+**  - queued on an io_uring ring on Linux (the kernel reads all the queued files while the parser runs, the
+**    completions are collected when a file is needed),
+**  - overlapped reads on Windows,
+**  - plain reads when handed over otherwise, after a read-ahead hint (posix_fadvise) given when the file is opened.
+** The files are opened (and their size read) when queued, only the data reads are asynchronous.
+*******************************************************************************************************************/
+
+#include<Loader.h>
+#include<Stats.h>
+
+#if !defined(_WIN32)
+  #include<fcntl.h>
+  #include<unistd.h>
+  #include<errno.h>
+  #include<sys/stat.h>
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+  #if __has_include(<linux/io_uring.h>)
+    #include<linux/io_uring.h>
+    #include<sys/mman.h>
+    #include<sys/syscall.h>
+    #define LOADER_HAS_URING
+  #endif
+#endif
+
+#define LOADER_FREE     0U
+#define LOADER_READING  1U
+#define LOADER_READY    2U
+#define LOADER_FAILED   3U
+
+#if defined(LOADER_HAS_URING)
+//io_uring rings mapped from the kernel
+typedef struct
+{
+  int                  fd;
+  unsigned*            SqHead;
+  unsigned*            SqTail;
+  unsigned*            SqMask;
+  unsigned*            SqArray;
+  struct io_uring_sqe* sqes;
+  unsigned*            CqHead;
+  unsigned*            CqTail;
+  unsigned*            CqMask;
+  struct io_uring_cqe* cqes;
+  void*                SqRing;
+  size_t               SqSize;
+  void*                CqRing;
+  size_t               CqSize;
+  size_t               SqesSize;
+  uint32               queued;        //entries not submitted yet
+}sLoaderRing;
+
+static boolean Loader_RingOpen(sLoader* loader);
+static void    Loader_RingClose(sLoader* loader);
+static void    Loader_RingRead(sLoader* loader, uint32 index);
+static void    Loader_RingWait(sLoader* loader, boolean wait);
+#endif
+
+static boolean Loader_Reserve(sLoader* loader, sLoaderSlot* slot, uint64 size);
+static void    Loader_Release(sLoader* loader, sLoaderSlot* slot);
+static void    Loader_CloseFile(sLoaderSlot* slot);
+static void    Loader_Start(sLoader* loader, uint32 index);
+static void    Loader_Finish(sLoader* loader, sLoaderSlot* slot);
+static void    Loader_Fill(sLoader* loader);
+
+#if defined(LOADER_HAS_URING)
+/*******************************************************************************************************************
+** Function:    Loader_RingOpen
+** Description: create the io_uring rings (FALSE if the kernel has no io_uring or does not allow it)
+** Parameter:   sLoader* loader
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Loader_RingOpen(sLoader* loader)
+{
+  struct io_uring_params params;
+  sLoaderRing*           ring = (sLoaderRing*)calloc(1, sizeof(sLoaderRing));
+
+  if(ring == NULL)
+  {
+    return(FALSE);
+  }
+
+  memset(&params, 0, sizeof(params));
+  ring->fd = (int)syscall(__NR_io_uring_setup, LOADER_DEPTH, &params);
+
+  if(ring->fd < 0)
+  {
+    free(ring);
+    return(FALSE);
+  }
+
+  ring->SqSize   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->CqSize   = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  ring->SqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+  /* one mapping holds both rings on the kernels which support it */
+  if((params.features & IORING_FEAT_SINGLE_MMAP) != 0)
+  {
+    ring->SqSize = (ring->CqSize > ring->SqSize) ? ring->CqSize : ring->SqSize;
+    ring->CqSize = ring->SqSize;
+  }
+
+  ring->SqRing = mmap(NULL, ring->SqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+                      IORING_OFF_SQ_RING);
+  ring->CqRing = ((params.features & IORING_FEAT_SINGLE_MMAP) != 0 || ring->SqRing == MAP_FAILED) ? ring->SqRing :
+                 mmap(NULL, ring->CqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd,
+                      IORING_OFF_CQ_RING);
+  ring->sqes   = (struct io_uring_sqe*)mmap(NULL, ring->SqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                            ring->fd, IORING_OFF_SQES);
+  loader->ring = ring;
+
+  if(ring->SqRing == MAP_FAILED || ring->CqRing == MAP_FAILED || ring->sqes == MAP_FAILED)
+  {
+    Loader_RingClose(loader);
+    return(FALSE);
+  }
+
+  ring->SqHead  = (unsigned*)((char*)ring->SqRing + params.sq_off.head);
+  ring->SqTail  = (unsigned*)((char*)ring->SqRing + params.sq_off.tail);
+  ring->SqMask  = (unsigned*)((char*)ring->SqRing + params.sq_off.ring_mask);
+  ring->SqArray = (unsigned*)((char*)ring->SqRing + params.sq_off.array);
+  ring->CqHead  = (unsigned*)((char*)ring->CqRing + params.cq_off.head);
+  ring->CqTail  = (unsigned*)((char*)ring->CqRing + params.cq_off.tail);
+  ring->CqMask  = (unsigned*)((char*)ring->CqRing + params.cq_off.ring_mask);
+  ring->cqes    = (struct io_uring_cqe*)((char*)ring->CqRing + params.cq_off.cqes);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_RingClose
+** Description: unmap and close the io_uring rings
+** Parameter:   sLoader* loader
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_RingClose(sLoader* loader)
+{
+  sLoaderRing* ring = (sLoaderRing*)loader->ring;
+
+  if(ring->sqes != NULL && ring->sqes != MAP_FAILED)
+  {
+    munmap(ring->sqes, ring->SqesSize);
+  }
+  if(ring->CqRing != NULL && ring->CqRing != MAP_FAILED && ring->CqRing != ring->SqRing)
+  {
+    munmap(ring->CqRing, ring->CqSize);
+  }
+  if(ring->SqRing != NULL && ring->SqRing != MAP_FAILED)
+  {
+    munmap(ring->SqRing, ring->SqSize);
+  }
+
+  close(ring->fd);
+  free(ring);
+  loader->ring = NULL;
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_RingRead
+** Description: queue the read of the rest of a file (submitted by the next Loader_RingWait). There is at most
+**              one read per slot, the submission queue (LOADER_DEPTH entries) cannot overflow.
+** Parameter:   sLoader* loader, uint32 index (slot)
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_RingRead(sLoader* loader, uint32 index)
+{
+  sLoaderRing*         ring = (sLoaderRing*)loader->ring;
+  sLoaderSlot*         slot = &loader->slots[index];
+  unsigned             tail = *ring->SqTail;
+  unsigned             pos  = tail & *ring->SqMask;
+  struct io_uring_sqe* sqe  = &ring->sqes[pos];
+
+  slot->iov.iov_base = slot->buffer + slot->done;
+  slot->iov.iov_len  = slot->size - slot->done;
+
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  sqe->opcode    = IORING_OP_READV;
+  sqe->fd        = slot->file;
+  sqe->addr      = (uint64)(uintptr_t)&slot->iov;
+  sqe->len       = 1;
+  sqe->off       = slot->done;
+  sqe->user_data = index;
+
+  ring->SqArray[pos] = pos;
+  __atomic_store_n(ring->SqTail, tail + 1U, __ATOMIC_RELEASE);
+  ring->queued++;
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_RingWait
+** Description: submit the queued reads and collect the completed ones (wait: block until one completes)
+** Parameter:   sLoader* loader, boolean wait
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_RingWait(sLoader* loader, boolean wait)
+{
+  sLoaderRing* ring = (sLoaderRing*)loader->ring;
+  unsigned     head = 0;
+
+  if(ring->queued > 0 || wait)
+  {
+    long result = syscall(__NR_io_uring_enter, ring->fd, ring->queued, wait ? 1U : 0U,
+                          wait ? IORING_ENTER_GETEVENTS : 0U, NULL, 0);
+
+    if(result >= 0)
+    {
+      ring->queued -= ((uint32)result < ring->queued) ? (uint32)result : ring->queued;
+    }
+  }
+
+  head = *ring->CqHead;
+
+  while(head != __atomic_load_n(ring->CqTail, __ATOMIC_ACQUIRE))
+  {
+    struct io_uring_cqe* cqe  = &ring->cqes[head & *ring->CqMask];
+    uint32               slot = (uint32)cqe->user_data;
+    sLoaderSlot*         s    = &loader->slots[slot];
+    sint32               res  = cqe->res;
+
+    head++;
+
+    if(res == -EINTR || res == -EAGAIN)
+    {
+      Loader_RingRead(loader, slot);
+    }
+    else if(res <= 0)
+    {
+      s->error = (res < 0) ? (uint32)-res : (uint32)EIO;
+      s->state = LOADER_FAILED;
+      Loader_CloseFile(s);
+    }
+    else if((s->done += (uint32)res) < s->size)
+    {
+      Loader_RingRead(loader, slot);
+    }
+    else
+    {
+      s->state = LOADER_READY;
+      Loader_CloseFile(s);
+    }
+  }
+
+  __atomic_store_n(ring->CqHead, head, __ATOMIC_RELEASE);
+}
+#endif
+
+/*******************************************************************************************************************
+** Function:    Loader_Reserve
+** Description: give a slot a buffer large enough for a file (plus the terminating zero of text files): the
+**              smallest buffer of the pool which fits, else the largest one grown
+** Parameter:   sLoader* loader, sLoaderSlot* slot, uint64 size
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Loader_Reserve(sLoader* loader, sLoaderSlot* slot, uint64 size)
+{
+  uint32 best = LOADER_DEPTH;
+
+  if(size >= 0xFFFFFFFFULL)
+  {
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < loader->PoolNbr; i++)
+  {
+    boolean fits = (boolean)(loader->PoolSize[i] > size);
+
+    if(best == LOADER_DEPTH ||
+       (fits && (loader->PoolSize[best] <= size || loader->PoolSize[i] < loader->PoolSize[best])) ||
+       (!fits && loader->PoolSize[best] <= size && loader->PoolSize[i] > loader->PoolSize[best]))
+    {
+      best = i;
+    }
+  }
+
+  if(best != LOADER_DEPTH)
+  {
+    slot->buffer   = loader->pool[best];
+    slot->capacity = loader->PoolSize[best];
+    loader->PoolNbr--;
+    loader->pool[best]     = loader->pool[loader->PoolNbr];
+    loader->PoolSize[best] = loader->PoolSize[loader->PoolNbr];
+  }
+
+  if(slot->capacity <= size)
+  {
+    free(slot->buffer);
+    slot->buffer   = (char*)malloc((size_t)size + 1U);
+    slot->capacity = (slot->buffer != NULL) ? (uint32)size + 1U : 0U;
+  }
+
+  slot->size = (uint32)size;
+  slot->done = 0;
+  return((boolean)(slot->buffer != NULL));
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Release
+** Description: give the buffer of a slot back to the pool
+** Parameter:   sLoader* loader, sLoaderSlot* slot
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_Release(sLoader* loader, sLoaderSlot* slot)
+{
+  if(slot->buffer != NULL)
+  {
+    loader->pool[loader->PoolNbr]     = slot->buffer;
+    loader->PoolSize[loader->PoolNbr] = slot->capacity;
+    loader->PoolNbr++;
+  }
+
+  slot->buffer   = NULL;
+  slot->capacity = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_CloseFile
+** Description: close the file of a slot
+** Parameter:   sLoaderSlot* slot
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_CloseFile(sLoaderSlot* slot)
+{
+#if defined(_WIN32)
+  if(slot->overlapped.hEvent != NULL)
+  {
+    CloseHandle(slot->overlapped.hEvent);
+    slot->overlapped.hEvent = NULL;
+  }
+  if(slot->file != INVALID_HANDLE_VALUE)
+  {
+    CloseHandle(slot->file);
+    slot->file = INVALID_HANDLE_VALUE;
+  }
+#else
+  if(slot->file >= 0)
+  {
+    close(slot->file);
+    slot->file = -1;
+  }
+#endif
+}
+
+#if defined(_WIN32)
+/*******************************************************************************************************************
+** Function:    Loader_ReadOverlapped
+** Description: start the overlapped read of the rest of a file
+** Parameter:   sLoaderSlot* slot
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_ReadOverlapped(sLoaderSlot* slot)
+{
+  ResetEvent(slot->overlapped.hEvent);
+  slot->overlapped.Offset     = slot->done;
+  slot->overlapped.OffsetHigh = 0;
+
+  if(!ReadFile(slot->file, slot->buffer + slot->done, slot->size - slot->done, NULL, &slot->overlapped) &&
+     GetLastError() != ERROR_IO_PENDING)
+  {
+    slot->error = (uint32)GetLastError();
+    slot->state = LOADER_FAILED;
+    Loader_CloseFile(slot);
+  }
+}
+#endif
+
+/*******************************************************************************************************************
+** Function:    Loader_Start
+** Description: open a file of the list, size its buffer and start reading it
+** Parameter:   sLoader* loader, uint32 index (file)
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_Start(sLoader* loader, uint32 index)
+{
+  uint32       number = index % LOADER_DEPTH;
+  sLoaderSlot* slot   = &loader->slots[number];
+
+  slot->path  = loader->paths[index];
+  slot->state = LOADER_FAILED;
+  slot->error = 0;
+  slot->size  = 0;
+
+#if defined(_WIN32)
+  {
+    LARGE_INTEGER size;
+
+    slot->file = CreateFileA(slot->path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                             FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+
+    if(slot->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(slot->file, &size) ||
+       !Loader_Reserve(loader, slot, (uint64)size.QuadPart))
+    {
+      slot->size = 0;
+      Loader_CloseFile(slot);
+      Loader_Release(loader, slot);
+      return;
+    }
+
+    memset(&slot->overlapped, 0, sizeof(OVERLAPPED));
+    slot->overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    slot->state             = (slot->size > 0) ? LOADER_READING : LOADER_READY;
+
+    if(slot->overlapped.hEvent == NULL)
+    {
+      slot->state = LOADER_FAILED;
+    }
+    else if(slot->state == LOADER_READING)
+    {
+      Loader_ReadOverlapped(slot);
+    }
+  }
+#else
+  {
+    struct stat info;
+    boolean     opened = FALSE;
+
+    slot->file = open(slot->path, O_RDONLY);
+
+    if(slot->file >= 0 && fstat(slot->file, &info) == 0 && (uint64)info.st_size < 0xFFFFFFFFULL)
+    {
+      /* the plain reads take their buffer when handed over: the one of the previous file, still in the caches */
+      slot->size = (uint32)info.st_size;
+      opened     = (boolean)((loader->engine == LOADER_SYNC && slot->size > 0) ||
+                             Loader_Reserve(loader, slot, slot->size));
+    }
+
+    if(!opened)
+    {
+      slot->error = (uint32)errno;
+      slot->size = 0;
+      Loader_CloseFile(slot);
+      Loader_Release(loader, slot);
+      return;
+    }
+
+    slot->state = (slot->size > 0) ? LOADER_READING : LOADER_READY;
+
+#if defined(LOADER_HAS_URING)
+    if(loader->engine == LOADER_URING && slot->state == LOADER_READING)
+    {
+      Loader_RingRead(loader, number);
+    }
+#endif
+#if defined(POSIX_FADV_WILLNEED)
+    if(loader->engine == LOADER_SYNC && slot->state == LOADER_READING)
+    {
+      (void)posix_fadvise(slot->file, 0, 0, POSIX_FADV_WILLNEED);
+    }
+#endif
+  }
+#endif
+
+  if(slot->state != LOADER_READING)
+  {
+    Loader_CloseFile(slot);
+  }
+  loader->InFlight += slot->size;
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Finish
+** Description: wait until a file is read
+** Parameter:   sLoader* loader, sLoaderSlot* slot
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_Finish(sLoader* loader, sLoaderSlot* slot)
+{
+#if defined(_WIN32)
+  while(slot->state == LOADER_READING)
+  {
+    DWORD bytes = 0;
+
+    if(!GetOverlappedResult(slot->file, &slot->overlapped, &bytes, TRUE) || bytes == 0)
+    {
+      slot->error = (uint32)GetLastError();
+      slot->state = LOADER_FAILED;
+      Loader_CloseFile(slot);
+    }
+    else if((slot->done += (uint32)bytes) < slot->size)
+    {
+      Loader_ReadOverlapped(slot);
+    }
+    else
+    {
+      slot->state = LOADER_READY;
+      Loader_CloseFile(slot);
+    }
+  }
+  (void)loader;
+#else
+#if defined(LOADER_HAS_URING)
+  while(loader->engine == LOADER_URING && slot->state == LOADER_READING)
+  {
+    Loader_RingWait(loader, TRUE);
+  }
+#endif
+
+  if(slot->state == LOADER_READING && slot->buffer == NULL && !Loader_Reserve(loader, slot, slot->size))
+  {
+    slot->state = LOADER_FAILED;
+    Loader_CloseFile(slot);
+  }
+
+  while(slot->state == LOADER_READING)
+  {
+    ssize_t bytes = read(slot->file, slot->buffer + slot->done, slot->size - slot->done);
+
+    if(bytes < 0 && errno == EINTR)
+    {
+      continue;
+    }
+
+    if(bytes <= 0)
+    {
+      slot->error = (bytes < 0) ? (uint32)errno : (uint32)EIO;
+      slot->state = LOADER_FAILED;
+      Loader_CloseFile(slot);
+    }
+    else if((slot->done += (uint32)bytes) == slot->size)
+    {
+      slot->state = LOADER_READY;
+      Loader_CloseFile(slot);
+    }
+  }
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Fill
+** Description: start the next files of the list, within LOADER_DEPTH files and LOADER_MAX_BYTES bytes ahead
+**              (the slot of the file being processed is not reused before the next Loader_Next)
+** Parameter:   sLoader* loader
+** Return:      void
+*******************************************************************************************************************/
+static void Loader_Fill(sLoader* loader)
+{
+  while(loader->next < loader->count && loader->next - loader->released < LOADER_DEPTH &&
+        (loader->InFlight < LOADER_MAX_BYTES || loader->next == loader->head))
+  {
+    Loader_Start(loader, loader->next++);
+  }
+
+#if defined(LOADER_HAS_URING)
+  if(loader->engine == LOADER_URING)
+  {
+    Loader_RingWait(loader, FALSE);
+  }
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Open
+** Description: prepare the read-ahead of a list of files (the paths must stay valid until Loader_Close)
+** Parameter:   sLoader* loader, char** paths, uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Loader_Open(sLoader* loader, char** paths, uint32 count)
+{
+  memset(loader, 0, sizeof(sLoader));
+  loader->paths = paths;
+  loader->count = count;
+
+  for(uint32 i = 0; i < LOADER_DEPTH; i++)
+  {
+#if defined(_WIN32)
+    loader->slots[i].file = INVALID_HANDLE_VALUE;
+#else
+    loader->slots[i].file = -1;
+#endif
+  }
+
+#if defined(_WIN32)
+  loader->engine = LOADER_OVERLAPPED;
+#else
+  loader->engine = LOADER_SYNC;
+#if defined(LOADER_HAS_URING)
+  if(Loader_RingOpen(loader))
+  {
+    loader->engine = LOADER_URING;
+  }
+#endif
+#endif
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Next
+** Description: hand over the next file of the list (its buffer is valid until the next call), and start reading
+**              the following ones
+** Parameter:   sLoader* loader, sLoaderFile* file
+** Return:      boolean (FALSE at the end of the list)
+*******************************************************************************************************************/
+boolean Loader_Next(sLoader* loader, sLoaderFile* file)
+{
+  sLoaderSlot* slot = NULL;
+
+  /* the previous file is done with, its slot and its buffer can be reused */
+  if(loader->released != loader->head)
+  {
+    Loader_Release(loader, &loader->slots[loader->released % LOADER_DEPTH]);
+    loader->released = loader->head;
+  }
+
+  if(loader->head == loader->count)
+  {
+    return(FALSE);
+  }
+
+  Loader_Fill(loader);
+
+  slot = &loader->slots[loader->head % LOADER_DEPTH];
+  Loader_Finish(loader, slot);
+
+  file->path   = slot->path;
+  file->size   = slot->size;
+  file->buffer = NULL;
+
+  if(slot->state == LOADER_READY)
+  {
+    slot->buffer[slot->size] = '\0';
+    file->buffer = slot->buffer;
+    Stats_AddRead(slot->size);
+  }
+  else
+  {
+    printf("\n\r error: Cannot read the file '%s' !\n\r", slot->path);
+  }
+
+  loader->InFlight -= slot->size;
+  slot->state       = LOADER_FREE;
+  loader->head++;
+
+  /* the next files are read while this one is processed */
+  Loader_Fill(loader);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Loader_Close
+** Description: wait for the reads in progress and free the buffers
+** Parameter:   sLoader* loader
+** Return:      void
+*******************************************************************************************************************/
+void Loader_Close(sLoader* loader)
+{
+  for(uint32 i = 0; i < LOADER_DEPTH; i++)
+  {
+#if defined(_WIN32)
+    if(loader->slots[i].state == LOADER_READING)
+    {
+      CancelIo(loader->slots[i].file);
+    }
+#endif
+    Loader_Finish(loader, &loader->slots[i]);
+    Loader_CloseFile(&loader->slots[i]);
+    Loader_Release(loader, &loader->slots[i]);
+  }
+
+  for(uint32 i = 0; i < loader->PoolNbr; i++)
+  {
+    free(loader->pool[i]);
+  }
+
+#if defined(LOADER_HAS_URING)
+  if(loader->engine == LOADER_URING)
+  {
+    Loader_RingClose(loader);
+  }
+#endif
+  memset(loader, 0, sizeof(sLoader));
+}
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __LOADER_H__
+#define __LOADER_H__
+
+#include<common.h>
+
+#if !defined(_WIN32)
+  #include<sys/uio.h>
+#endif
+
+#define LOADER_DEPTH       32U            //files read ahead of the processed one
+#define LOADER_MAX_BYTES   0x2000000ULL  //bytes read ahead (a larger file is read alone)
+
+#define LOADER_SYNC        0U             //read when handed over (after a read-ahead hint)
+#define LOADER_URING       1U             //io_uring (Linux)
+#define LOADER_OVERLAPPED  2U             //overlapped reads (Windows)
+
+//one file of the list, read ahead into a buffer taken from the pool of the loader
+typedef struct
+{
+  char*      path;
+  char*      buffer;
+  uint32     capacity;
+  uint32     size;
+  uint32     done;                        //bytes read
+  uint32     state;
+  uint32     error;
+#if defined(_WIN32)
+  HANDLE     file;
+  OVERLAPPED overlapped;
+#else
+  int        file;
+  struct iovec iov;
+#endif
+}sLoaderSlot;
+
+//a list of files read ahead of their processing, in list order
+typedef struct
+{
+  char**      paths;
+  uint32      count;
+  uint32      next;                       //next file to start
+  uint32      head;                       //next file to hand over
+  uint32      released;                   //files handed over and done with
+  uint64      InFlight;                   //bytes of the files started and not handed over
+  uint32      engine;
+  sLoaderSlot slots[LOADER_DEPTH];
+  char*       pool[LOADER_DEPTH];         //buffers of the files done with, reused by the next files
+  uint32      PoolSize[LOADER_DEPTH];
+  uint32      PoolNbr;
+  void*       ring;                       //io_uring state (LOADER_URING)
+}sLoader;
+
+//file handed over by Loader_Next, valid until the next call
+typedef struct
+{
+  char*  path;
+  char*  buffer;                          //NULL if the file could not be read
+  uint32 size;
+}sLoaderFile;
+
+boolean Loader_Open(sLoader* loader, char** paths, uint32 count);
+boolean Loader_Next(sLoader* loader, sLoaderFile* file);
+void    Loader_Close(sLoader* loader);
+
+#endif
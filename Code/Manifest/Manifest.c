@@ -0,0 +1,527 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Hash manifest of the loadable sections (reproducible build verification).
+**
+** Each loadable section (ELF_IS_LOAD_SECTION, same content as the S19 export) is hashed with BLAKE3. The sections
+** are split in BLAKE3 leaves (at most HASH_BLAKE3_LEAF_LEN bytes) and the leaves of all the sections are hashed by
+** one parallel loop. The leaf hashes are kept in the manifest so that a difference can be located without the
+** ELF files. The image hash is the BLAKE3 hash of the (address, size, hash) records of the sections.
+**
+** Text format:
+**   ELFPARSER-MANIFEST 1
+**   image   <hash> <total size> <sections>
+**   section <address> <size> <hash> <chunks> <name>
+**   chunk   <offset> <size> <hash>
+*******************************************************************************************************************/
+
+#include<Manifest.h>
+#include<Elf.h>
+#include<Thread.h>
+
+#define MANIFEST_RECORD_SIZE  (8U + 8U + HASH_BLAKE3_LEN)
+
+//leaves of all the sections, hashed by one parallel loop
+typedef struct
+{
+  sHashBlake3Leaf* leaves;
+  const char**     data;             //start of the section of each leaf
+}sManifestJobs;
+
+static void    Manifest_HashLeaf(uint32 index, void* ctx);
+static void    Manifest_HashRoot(sManifest* manifest);
+static void    Manifest_PrintHash(FILE* file, const uint8* hash);
+static boolean Manifest_ParseHash(const char* str, uint8* hash);
+static boolean Manifest_ReadLine(char* Buffer, uint32 size, uint32* pos, char* line);
+static void    Manifest_PrintChunkDiff(const sManifest* ref, const sManifestSection* RefSection,
+                                       const sManifest* cur, const sManifestSection* NewSection);
+
+/*******************************************************************************************************************
+** Function:    Manifest_IsManifest
+** Description: check the manifest header
+** Parameter:   char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Manifest_IsManifest(char* Buffer, uint32 size)
+{
+  return((boolean)(Buffer != NULL && size >= MANIFEST_MAGIC_LEN && 0 == memcmp(Buffer, MANIFEST_MAGIC, MANIFEST_MAGIC_LEN)));
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_Build
+** Description: hash the loadable sections of an opened ELF image
+** Parameter:   sManifest* manifest, sElf* Image
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Manifest_Build(sManifest* manifest, sElf* Image)
+{
+  sElfSection*  sections = NULL;
+  uint32        count    = 0;
+  uint32        leaves   = 0;
+  sManifestJobs jobs;
+
+  memset(manifest, 0, sizeof(sManifest));
+
+  if(!Elf_GetSections(Image, &sections, &count))
+  {
+    return(FALSE);
+  }
+
+  manifest->sections = (sManifestSection*)calloc((size_t)count + 1, sizeof(sManifestSection));
+
+  if(manifest->sections == NULL)
+  {
+    Manifest_Release(manifest);
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    if(ELF_IS_LOAD_SECTION(sections[i].type, sections[i].flags, sections[i].size))
+    {
+      sManifestSection* section = &manifest->sections[manifest->SectionsNbr++];
+
+      section->name       = sections[i].name;
+      section->addr       = sections[i].addr;
+      section->size       = sections[i].size;
+      section->FirstChunk = leaves;
+      section->ChunksNbr  = Hash_Blake3Plan(sections[i].size, NULL);
+
+      leaves         += section->ChunksNbr;
+      manifest->size += sections[i].size;
+    }
+  }
+
+  jobs.leaves     = (sHashBlake3Leaf*)malloc(((size_t)leaves + 1) * sizeof(sHashBlake3Leaf));
+  jobs.data       = (const char**)malloc(((size_t)leaves + 1) * sizeof(char*));
+  manifest->chunks = (sManifestChunk*)malloc(((size_t)leaves + 1) * sizeof(sManifestChunk));
+
+  if(jobs.leaves == NULL || jobs.data == NULL || manifest->chunks == NULL)
+  {
+    free(jobs.data);
+    free(jobs.leaves);
+    Manifest_Release(manifest);
+    return(FALSE);
+  }
+
+  /* plan the leaves of every section, then hash all of them in parallel */
+  for(uint32 s = 0, i = 0; i < count; i++)
+  {
+    if(ELF_IS_LOAD_SECTION(sections[i].type, sections[i].flags, sections[i].size))
+    {
+      sManifestSection* section = &manifest->sections[s++];
+
+      Hash_Blake3Plan(section->size, &jobs.leaves[section->FirstChunk]);
+
+      for(uint32 c = 0; c < section->ChunksNbr; c++)
+      {
+        jobs.data[section->FirstChunk + c] = sections[i].data;
+      }
+    }
+  }
+
+  Thread_ParallelFor(leaves, Manifest_HashLeaf, &jobs);
+
+  for(uint32 s = 0; s < manifest->SectionsNbr; s++)
+  {
+    sManifestSection* section = &manifest->sections[s];
+
+    Hash_Blake3Finish(jobs.data[section->FirstChunk], &jobs.leaves[section->FirstChunk], section->ChunksNbr, section->hash);
+  }
+
+  for(uint32 c = 0; c < leaves; c++)
+  {
+    manifest->chunks[c].offset = jobs.leaves[c].offset;
+    manifest->chunks[c].size   = jobs.leaves[c].size;
+    memcpy(manifest->chunks[c].hash, jobs.leaves[c].cv, HASH_BLAKE3_LEN);
+  }
+  manifest->ChunksNbr = leaves;
+
+  Manifest_HashRoot(manifest);
+
+  free(jobs.data);
+  free(jobs.leaves);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_HashLeaf
+** Description: hash one leaf of one section
+** Parameter:   uint32 index, void* ctx (sManifestJobs*)
+** Return:      void
+*******************************************************************************************************************/
+static void Manifest_HashLeaf(uint32 index, void* ctx)
+{
+  sManifestJobs* jobs = (sManifestJobs*)ctx;
+
+  Hash_Blake3Leaf(jobs->data[index], &jobs->leaves[index]);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_HashRoot
+** Description: image hash: BLAKE3 of the little endian (address, size) and hash of every section, in order
+** Parameter:   sManifest* manifest
+** Return:      void
+*******************************************************************************************************************/
+static void Manifest_HashRoot(sManifest* manifest)
+{
+  uint8* records = (uint8*)malloc((size_t)manifest->SectionsNbr * MANIFEST_RECORD_SIZE + 1);
+
+  memset(manifest->root, 0, HASH_BLAKE3_LEN);
+
+  if(records == NULL)
+  {
+    return;
+  }
+
+  for(uint32 s = 0; s < manifest->SectionsNbr; s++)
+  {
+    uint8* record = &records[s * MANIFEST_RECORD_SIZE];
+
+    for(uint32 b = 0; b < 8; b++)
+    {
+      record[b]     = (uint8)(manifest->sections[s].addr >> (8 * b));
+      record[8 + b] = (uint8)(manifest->sections[s].size >> (8 * b));
+    }
+    memcpy(&record[16], manifest->sections[s].hash, HASH_BLAKE3_LEN);
+  }
+
+  Hash_Blake3(records, (uint64)manifest->SectionsNbr * MANIFEST_RECORD_SIZE, manifest->root);
+  free(records);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_Write
+** Description: save the manifest as text
+** Parameter:   const sManifest* manifest, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Manifest_Write(const sManifest* manifest, char* path)
+{
+  FILE* file = fopen(path, "wb");
+
+  if(file == NULL)
+  {
+    printf("\n\r error: Cannot save the file !\n\r");
+    return(FALSE);
+  }
+
+  fprintf(file, "%s\n", MANIFEST_MAGIC);
+  fprintf(file, "image ");
+  Manifest_PrintHash(file, manifest->root);
+  fprintf(file, " %llx %u\n", (unsigned long long)manifest->size, manifest->SectionsNbr);
+
+  for(uint32 s = 0; s < manifest->SectionsNbr; s++)
+  {
+    const sManifestSection* section = &manifest->sections[s];
+
+    fprintf(file, "section %llx %llx ", (unsigned long long)section->addr, (unsigned long long)section->size);
+    Manifest_PrintHash(file, section->hash);
+    fprintf(file, " %u %s\n", section->ChunksNbr, section->name);
+
+    for(uint32 c = section->FirstChunk; c < section->FirstChunk + section->ChunksNbr; c++)
+    {
+      fprintf(file, "chunk %llx %llx ", (unsigned long long)manifest->chunks[c].offset, (unsigned long long)manifest->chunks[c].size);
+      Manifest_PrintHash(file, manifest->chunks[c].hash);
+      fprintf(file, "\n");
+    }
+  }
+
+  fclose(file);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_PrintHash
+** Description: write a hash as hexadecimal
+** Parameter:   FILE* file, const uint8* hash
+** Return:      void
+*******************************************************************************************************************/
+static void Manifest_PrintHash(FILE* file, const uint8* hash)
+{
+  for(uint32 i = 0; i < HASH_BLAKE3_LEN; i++)
+  {
+    fprintf(file, "%02x", hash[i]);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_ParseHash
+** Description: read a hexadecimal hash
+** Parameter:   const char* str, uint8* hash
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Manifest_ParseHash(const char* str, uint8* hash)
+{
+  for(uint32 i = 0; i < HASH_BLAKE3_LEN; i++)
+  {
+    unsigned int byte = 0;
+
+    if(1 != sscanf(&str[2 * i], "%2x", &byte))
+    {
+      return(FALSE);
+    }
+    hash[i] = (uint8)byte;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_ReadLine
+** Description: copy the next line of Buffer (without the end of line) into line (MAX_LINE_LEN bytes)
+** Parameter:   char* Buffer, uint32 size, uint32* pos, char* line
+** Return:      boolean (FALSE at the end of the buffer)
+*******************************************************************************************************************/
+static boolean Manifest_ReadLine(char* Buffer, uint32 size, uint32* pos, char* line)
+{
+  uint32 len = 0;
+
+  if(*pos >= size)
+  {
+    return(FALSE);
+  }
+
+  while(*pos < size && Buffer[*pos] != '\n')
+  {
+    if(Buffer[*pos] != '\r' && len < (MAX_LINE_LEN - 1))
+    {
+      line[len++] = Buffer[*pos];
+    }
+    (*pos)++;
+  }
+  (*pos)++;
+
+  line[len] = '\0';
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_Parse
+** Description: load a manifest saved by Manifest_Write
+** Parameter:   sManifest* manifest, char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Manifest_Parse(sManifest* manifest, char* Buffer, uint32 size)
+{
+  char   line[MAX_LINE_LEN];
+  char   hash[MAX_LINE_LEN];
+  char   name[MAX_LINE_LEN];
+  uint32 lines   = 1;
+  uint32 pos     = 0;
+  uint32 used    = 0;
+  char*  names   = NULL;
+  boolean result = TRUE;
+
+  memset(manifest, 0, sizeof(sManifest));
+
+  if(!Manifest_IsManifest(Buffer, size))
+  {
+    printf("\n\r error: This is not a hash manifest !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < size; i++)
+  {
+    lines += (Buffer[i] == '\n') ? 1U : 0U;
+  }
+
+  names              = (char*)malloc((size_t)size + 1);
+  manifest->storage  = names;
+  manifest->sections = (sManifestSection*)calloc(lines, sizeof(sManifestSection));
+  manifest->chunks   = (sManifestChunk*)calloc(lines, sizeof(sManifestChunk));
+
+  if(names == NULL || manifest->sections == NULL || manifest->chunks == NULL)
+  {
+    Manifest_Release(manifest);
+    return(FALSE);
+  }
+
+  Manifest_ReadLine(Buffer, size, &pos, line);
+
+  while(result && Manifest_ReadLine(Buffer, size, &pos, line))
+  {
+    unsigned long long a = 0;
+    unsigned long long b = 0;
+    unsigned int       n = 0;
+
+    if(0 == strncmp(line, "image ", 6))
+    {
+      result = (boolean)(3 == sscanf(line, "image %s %llx %u", hash, &a, &n) && Manifest_ParseHash(hash, manifest->root));
+      manifest->size = a;
+    }
+    else if(0 == strncmp(line, "section ", 8))
+    {
+      sManifestSection* section = &manifest->sections[manifest->SectionsNbr];
+
+      result = (boolean)(5 == sscanf(line, "section %llx %llx %s %u %[^\n]", &a, &b, hash, &n, name) &&
+                         Manifest_ParseHash(hash, section->hash));
+
+      if(result)
+      {
+        section->name       = strcpy(&names[used], name);
+        section->addr       = a;
+        section->size       = b;
+        section->FirstChunk = manifest->ChunksNbr;
+        section->ChunksNbr  = 0;
+        used += (uint32)strlen(name) + 1;
+        manifest->SectionsNbr++;
+      }
+    }
+    else if(0 == strncmp(line, "chunk ", 6) && manifest->SectionsNbr > 0)
+    {
+      sManifestChunk* chunk = &manifest->chunks[manifest->ChunksNbr];
+
+      result = (boolean)(3 == sscanf(line, "chunk %llx %llx %s", &a, &b, hash) && Manifest_ParseHash(hash, chunk->hash));
+
+      if(result)
+      {
+        chunk->offset = a;
+        chunk->size   = b;
+        manifest->sections[manifest->SectionsNbr - 1].ChunksNbr++;
+        manifest->ChunksNbr++;
+      }
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Invalid hash manifest line: %s\n\r", line);
+    Manifest_Release(manifest);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_Compare
+** Description: compare two manifests section by section (matched by name) and locate the changed leaves
+** Parameter:   const sManifest* ref, const sManifest* cur, char* RefPath, char* NewPath
+** Return:      boolean (TRUE if both images are identical)
+*******************************************************************************************************************/
+boolean Manifest_Compare(const sManifest* ref, const sManifest* cur, char* RefPath, char* NewPath)
+{
+  boolean identical = (boolean)(0 == memcmp(ref->root, cur->root, HASH_BLAKE3_LEN));
+  uint8*  matched   = (uint8*)calloc((size_t)cur->SectionsNbr + 1, sizeof(uint8));
+
+  printf("\nHASH MANIFEST COMPARE : %s -> %s\n", RefPath, NewPath);
+  printf("\nImage hash : ");
+  Manifest_PrintHash(stdout, cur->root);
+  printf(" (%s)\n", identical ? "IDENTICAL" : "DIFFERENT");
+
+  if(identical || matched == NULL)
+  {
+    free(matched);
+    return(identical);
+  }
+
+  printf("\n%-12s%-19s%-19s%s\n\n", "Status", "Address", "Size", "Section");
+
+  for(uint32 r = 0; r < ref->SectionsNbr; r++)
+  {
+    const sManifestSection* RefSection = &ref->sections[r];
+    const sManifestSection* NewSection = NULL;
+    const char*             status     = "REMOVED";
+
+    for(uint32 n = 0; n < cur->SectionsNbr && NewSection == NULL; n++)
+    {
+      if(!matched[n] && 0 == strcmp(cur->sections[n].name, RefSection->name))
+      {
+        matched[n] = 1;
+        NewSection = &cur->sections[n];
+      }
+    }
+
+    if(NewSection != NULL)
+    {
+      if(0 != memcmp(RefSection->hash, NewSection->hash, HASH_BLAKE3_LEN) || RefSection->size != NewSection->size)
+      {
+        status = "DIFFERENT";
+      }
+      else
+      {
+        status = (RefSection->addr != NewSection->addr) ? "MOVED" : "IDENTICAL";
+      }
+    }
+
+    printf("%-12s0x%-17llx0x%-17llx%s\n",
+           status,
+           (unsigned long long)((NewSection != NULL) ? NewSection->addr : RefSection->addr),
+           (unsigned long long)((NewSection != NULL) ? NewSection->size : RefSection->size),
+           RefSection->name
+          );
+
+    if(NewSection != NULL && status[0] == 'D')
+    {
+      Manifest_PrintChunkDiff(ref, RefSection, cur, NewSection);
+    }
+  }
+
+  for(uint32 n = 0; n < cur->SectionsNbr; n++)
+  {
+    if(!matched[n])
+    {
+      printf("%-12s0x%-17llx0x%-17llx%s\n", "ADDED", (unsigned long long)cur->sections[n].addr,
+             (unsigned long long)cur->sections[n].size, cur->sections[n].name);
+    }
+  }
+
+  free(matched);
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_PrintChunkDiff
+** Description: print the address ranges of the leaves that differ between two versions of a section. Leaves are
+**              compared by offset: a size change moves the leaf boundaries after the first differing leaf.
+** Parameter:   reference manifest and section, new manifest and section
+** Return:      void
+*******************************************************************************************************************/
+static void Manifest_PrintChunkDiff(const sManifest* ref, const sManifestSection* RefSection,
+                                    const sManifest* cur, const sManifestSection* NewSection)
+{
+  uint32 r = 0;
+  uint32 n = 0;
+
+  while(n < NewSection->ChunksNbr)
+  {
+    const sManifestChunk* NewChunk = &cur->chunks[NewSection->FirstChunk + n];
+    const sManifestChunk* RefChunk = NULL;
+
+    while(r < RefSection->ChunksNbr && ref->chunks[RefSection->FirstChunk + r].offset < NewChunk->offset)
+    {
+      r++;
+    }
+
+    if(r < RefSection->ChunksNbr)
+    {
+      RefChunk = &ref->chunks[RefSection->FirstChunk + r];
+    }
+
+    if(RefChunk == NULL || RefChunk->offset != NewChunk->offset || RefChunk->size != NewChunk->size ||
+       0 != memcmp(RefChunk->hash, NewChunk->hash, HASH_BLAKE3_LEN))
+    {
+      printf("%-12s0x%llx - 0x%llx\n", "",
+             (unsigned long long)(NewSection->addr + NewChunk->offset),
+             (unsigned long long)(NewSection->addr + NewChunk->offset + NewChunk->size - ((NewChunk->size > 0) ? 1 : 0)));
+    }
+    n++;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Manifest_Release
+** Description: free a manifest
+** Parameter:   sManifest* manifest
+** Return:      void
+*******************************************************************************************************************/
+void Manifest_Release(sManifest* manifest)
+{
+  free(manifest->chunks);
+  free(manifest->sections);
+  free(manifest->storage);
+  memset(manifest, 0, sizeof(sManifest));
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __MANIFEST_H__
+#define __MANIFEST_H__
+
+#include<common.h>
+#include<Elf.h>
+#include<Hash.h>
+
+#define MANIFEST_MAGIC      "ELFPARSER-MANIFEST 1"
+#define MANIFEST_MAGIC_LEN  20U
+
+//one BLAKE3 leaf of a section (offset relative to the section start)
+typedef struct
+{
+  uint64 offset;
+  uint64 size;
+  uint8  hash[HASH_BLAKE3_LEN];
+}sManifestChunk;
+
+//one loadable section and its BLAKE3 hash
+typedef struct
+{
+  char*  name;
+  uint64 addr;
+  uint64 size;
+  uint8  hash[HASH_BLAKE3_LEN];
+  uint32 FirstChunk;
+  uint32 ChunksNbr;
+}sManifestSection;
+
+typedef struct
+{
+  uint8             root[HASH_BLAKE3_LEN];   //hash over the (address, size, hash) list of the sections
+  uint64            size;                    //total size of the loadable sections
+  sManifestSection* sections;
+  uint32            SectionsNbr;
+  sManifestChunk*   chunks;
+  uint32            ChunksNbr;
+  void*             storage;                 //section names of a parsed manifest
+}sManifest;
+
+boolean Manifest_IsManifest(char* Buffer, uint32 size);
+boolean Manifest_Build(sManifest* manifest, sElf* Image);
+boolean Manifest_Parse(sManifest* manifest, char* Buffer, uint32 size);
+boolean Manifest_Write(const sManifest* manifest, char* path);
+boolean Manifest_Compare(const sManifest* ref, const sManifest* cur, char* RefPath, char* NewPath);
+void    Manifest_Release(sManifest* manifest);
+
+#endif
@@ -0,0 +1,960 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Correlation of a GNU ld map file (-Map=<file>) with the linked ELF file (-map).
+**
+** The ELF symbol table does not tell where a symbol comes from, the "Linker script and memory map" part of the map
+** file does: every input section is listed with its address, its size and its input file (an object file, or an
+** archive member "<library>(<object>)"). The map is read in one pass over the loaded text, each line is split into
+** tokens in place (no copy, no allocation per line): only the input files are interned. The map is then joined to
+** the ELF file by address:
+**  - the output sections of the map are checked against the sections of the ELF file (a stale map is an error),
+**  - the input sections are summed by library (or object) and by kind of output section (code, read-only data,
+**    data, bss),
+**  - the queried symbols are found in the input section which holds their address (binary search).
+*******************************************************************************************************************/
+
+#include<Map.h>
+#include<Hash.h>
+#include<Vars.h>
+#include<io.h>
+#include<ctype.h>
+
+#define MAP_CODE    0U
+#define MAP_RODATA  1U
+#define MAP_DATA    2U
+#define MAP_BSS     3U
+#define MAP_KINDS   4U
+
+//one line of the map, split into tokens in place on request (see Map_Token)
+typedef struct
+{
+  char*  p;                           //next line
+  char*  end;
+  uint32 indent;
+  char*  rest;                        //text after the tokens taken ("" at the end of the line)
+}sMapLine;
+
+//line of the size report: a library, or an object file
+typedef struct
+{
+  const char* name;
+  uint32      files;
+  uint64      size[MAP_KINDS];
+  uint64      total;
+}sMapGroup;
+
+static boolean Map_NextLine(sMapLine* line);
+static char*   Map_Token(sMapLine* line);
+static boolean Map_IsHex(const char* token, uint64* value);
+static boolean Map_AddOutput(sMap* map, char* name, const char* addr, const char* size, const char* rest);
+static boolean Map_AddInput(sMap* map, char* name, const char* addr, const char* size, char* path);
+static uint32  Map_AddFile(sMap* map, char* path);
+static int     Map_CompareInputs(const void* a, const void* b);
+static int     Map_CompareGroups(const void* a, const void* b);
+static int     Map_CompareFiles(const void* a, const void* b);
+static uint32  Map_FindInput(const sMap* map, const sMapOutput* output, uint64 addr);
+static uint32  Map_Kind(const sElfSection* section);
+static uint32  Map_CheckSections(sMap* map, sElf* elf, uint32* OutputOf);
+static void    Map_PrintSizes(sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+                              uint32 SecNbr);
+static uint32  Map_PrintOrigins(sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+                                uint32 SecNbr, const sElfSymbol* symbols, uint32 SymNbr);
+
+static const char* const MapKindNames[MAP_KINDS] = {"Code", "Rodata", "Data", "Bss"};
+
+/* the file being sorted by Map_CompareFiles */
+static const sMap* MapSorted = NULL;
+
+/*******************************************************************************************************************
+** Function:    Map_ParseSpec
+** Description: parse "<MapFile>[,by=lib|obj][,sym=<name>[+<name>...]]". A name is a symbol name or a pattern
+**              ('*' any string, '?' any character).
+** Parameter:   sMapSpec* spec, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Map_ParseSpec(sMapSpec* spec, const char* text)
+{
+  char*   item   = NULL;
+  boolean result = TRUE;
+
+  memset(spec, 0, sizeof(sMapSpec));
+  spec->by = MAP_BY_LIB;
+
+  if(text == NULL || strlen(text) >= sizeof(spec->copy))
+  {
+    result = FALSE;
+  }
+  else
+  {
+    strcpy(spec->copy, text);
+    spec->path = strtok(spec->copy, ",");
+    result     = (boolean)(spec->path != NULL && NULL == strchr(spec->path, '='));
+  }
+
+  for(item = result ? strtok(NULL, ",") : NULL; item != NULL && result; item = strtok(NULL, ","))
+  {
+    char* value = strchr(item, '=');
+
+    if(value == NULL)
+    {
+      result = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    if(0 == strcmp(item, "by"))
+    {
+      if(0 == strcmp(value, "lib"))      { spec->by = MAP_BY_LIB; }
+      else if(0 == strcmp(value, "obj")) { spec->by = MAP_BY_OBJ; }
+      else
+      {
+        result = FALSE;
+      }
+    }
+    else if(0 == strcmp(item, "sym"))
+    {
+      for(char* name = value; name != NULL && result; )
+      {
+        char* next = strchr(name, '+');
+
+        if(next != NULL)
+        {
+          *next++ = '\0';
+        }
+
+        result = (boolean)(*name != '\0' && spec->NamesNbr < MAP_MAX_NAMES);
+
+        if(result)
+        {
+          spec->names[spec->NamesNbr++] = name;
+        }
+        name = next;
+      }
+    }
+    else
+    {
+      result = FALSE;
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Bad map request '%s' (<MapFile>[,by=lib|obj][,sym=<name>[+<name>|+<pattern>]]) !\n\r",
+           (text != NULL) ? text : "");
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_NextLine
+** Description: go to the next line of the map: terminate it in place and skip its indentation
+** Parameter:   sMapLine* line
+** Return:      boolean (FALSE at the end of the text)
+*******************************************************************************************************************/
+static boolean Map_NextLine(sMapLine* line)
+{
+  char* p   = line->p;
+  char* eol = NULL;
+
+  if(p >= line->end)
+  {
+    return(FALSE);
+  }
+
+  eol = (char*)memchr(p, '\n', (size_t)(line->end - p));
+  eol = (eol != NULL) ? eol : line->end;
+  line->p = eol + 1;
+
+  /* the line ends at its line break, without the trailing blanks */
+  while(eol > p && (eol[-1] == '\r' || eol[-1] == ' ' || eol[-1] == '\t'))
+  {
+    eol--;
+  }
+  *eol = '\0';
+
+  for(line->indent = 0; *p == ' ' || *p == '\t'; p++)
+  {
+    line->indent++;
+  }
+
+  line->rest = p;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_Token
+** Description: take the next blank separated token of the line (terminated in place)
+** Parameter:   sMapLine* line
+** Return:      char* ("" at the end of the line)
+*******************************************************************************************************************/
+static char* Map_Token(sMapLine* line)
+{
+  char* token = line->rest;
+  char* p     = token;
+
+  while(*p != '\0' && *p != ' ' && *p != '\t')
+  {
+    p++;
+  }
+
+  if(*p != '\0')
+  {
+    *p++ = '\0';
+
+    while(*p == ' ' || *p == '\t')
+    {
+      p++;
+    }
+  }
+
+  line->rest = p;
+  return(token);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_IsHex
+** Description: read a "0x<hex digits>" token of the map
+** Parameter:   const char* token, uint64* value
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Map_IsHex(const char* token, uint64* value)
+{
+  char* end = NULL;
+
+  if(token[0] != '0' || (token[1] != 'x' && token[1] != 'X') || !isxdigit((uint8)token[2]))
+  {
+    return(FALSE);
+  }
+
+  *value = strtoull(&token[2], &end, 16);
+  return((boolean)(*end == '\0'));
+}
+
+/*******************************************************************************************************************
+** Function:    Map_AddFile
+** Description: intern an input file of the map (open addressing table, by path). The library and object names of
+**              a new file are split from its path.
+** Parameter:   sMap* map, char* path
+** Return:      uint32 (file index, MAP_NONE if out of memory)
+*******************************************************************************************************************/
+static uint32 Map_AddFile(sMap* map, char* path)
+{
+  uint32    hash = Hash_String(path);
+  uint32    slot = 0;
+  sMapFile* file = NULL;
+  size_t    len  = strlen(path);
+  char*     open = strchr(path, '(');
+
+  for(slot = hash & map->mask; map->slots[slot] != MAP_NONE; slot = (slot + 1U) & map->mask)
+  {
+    if(map->files[map->slots[slot]].hash == hash && 0 == strcmp(map->files[map->slots[slot]].path, path))
+    {
+      return(map->slots[slot]);
+    }
+  }
+
+  if(map->FilesNbr == map->FilesCap)
+  {
+    uint32    capacity = map->FilesCap * 2U;
+    sMapFile* files    = (sMapFile*)realloc(map->files, (size_t)capacity * sizeof(sMapFile));
+
+    if(files == NULL)
+    {
+      return(MAP_NONE);
+    }
+    map->files    = files;
+    map->FilesCap = capacity;
+  }
+
+  file          = &map->files[map->FilesNbr];
+  file->path    = path;
+  file->hash    = hash;
+  file->group   = MAP_NONE;
+  file->library = "";
+  file->object  = path;
+
+  /* archive member: "<library>(<object>)" */
+  if(open != NULL && open != path && len > 0 && path[len - 1U] == ')')
+  {
+    size_t LibLen = (size_t)(open - path);
+    size_t ObjLen = len - LibLen - 2U;
+    char*  names  = (char*)Arena_Alloc(&map->arena, len);
+
+    if(names == NULL)
+    {
+      return(MAP_NONE);
+    }
+
+    memcpy(names, path, LibLen);
+    names[LibLen] = '\0';
+    memcpy(&names[LibLen + 1U], open + 1, ObjLen);
+    names[LibLen + 1U + ObjLen] = '\0';
+    file->library = names;
+    file->object  = &names[LibLen + 1U];
+  }
+
+  map->slots[slot] = map->FilesNbr++;
+
+  /* the table is kept at most half full */
+  if(map->FilesNbr * 2U > map->mask)
+  {
+    uint32  mask  = map->mask * 2U + 1U;
+    uint32* slots = (uint32*)malloc(((size_t)mask + 1U) * sizeof(uint32));
+
+    if(slots == NULL)
+    {
+      return(MAP_NONE);
+    }
+
+    memset(slots, 0xFF, ((size_t)mask + 1U) * sizeof(uint32));
+
+    for(uint32 i = 0; i < map->FilesNbr; i++)
+    {
+      for(slot = map->files[i].hash & mask; slots[slot] != MAP_NONE; slot = (slot + 1U) & mask)
+      {
+      }
+      slots[slot] = i;
+    }
+
+    free(map->slots);
+    map->slots = slots;
+    map->mask  = mask;
+  }
+  return(map->FilesNbr - 1U);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_AddOutput
+** Description: add an output section of the map ("<name> <address> <size> [load address <address>]"), a line
+**              which does not hold an address and a size is not an output section and is skipped
+** Parameter:   sMap* map, char* name, const char* addr, const char* size, const char* rest
+** Return:      boolean (FALSE if out of memory)
+*******************************************************************************************************************/
+static boolean Map_AddOutput(sMap* map, char* name, const char* addr, const char* size, const char* rest)
+{
+  sMapOutput* output = NULL;
+  uint64      a      = 0;
+  uint64      s      = 0;
+
+  if(!Map_IsHex(addr, &a) || !Map_IsHex(size, &s))
+  {
+    return(TRUE);
+  }
+
+  if(map->OutputsNbr == map->OutputsCap)
+  {
+    uint32      capacity = map->OutputsCap * 2U;
+    sMapOutput* outputs  = (sMapOutput*)realloc(map->outputs, (size_t)capacity * sizeof(sMapOutput));
+
+    if(outputs == NULL)
+    {
+      return(FALSE);
+    }
+    map->outputs    = outputs;
+    map->OutputsCap = capacity;
+  }
+
+  output        = &map->outputs[map->OutputsNbr++];
+  output->name  = name;
+  output->addr  = a;
+  output->size  = s;
+  output->lma   = a;
+  output->fill  = 0;
+  output->first = map->InputsNbr;
+  output->last  = map->InputsNbr;
+
+  if(0 == strncmp(rest, "load address ", 13U) && !Map_IsHex(rest + 13, &output->lma))
+  {
+    output->lma = a;
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_AddInput
+** Description: add an input section of the map ("<name> <address> <size> <file>", or the padding "*fill*") to the
+**              last output section. A line which does not hold an address and a size is skipped, as well as the
+**              input section patterns of the script ("*(.text*)").
+** Parameter:   sMap* map, char* name, const char* addr, const char* size, char* path
+** Return:      boolean (FALSE if out of memory)
+*******************************************************************************************************************/
+static boolean Map_AddInput(sMap* map, char* name, const char* addr, const char* size, char* path)
+{
+  sMapInput* input = NULL;
+  uint64     a     = 0;
+  uint64     s     = 0;
+
+  if(map->OutputsNbr == 0 || !Map_IsHex(addr, &a) || !Map_IsHex(size, &s))
+  {
+    return(TRUE);
+  }
+
+  if(name[0] == '*')
+  {
+    if(0 == strcmp(name, "*fill*"))
+    {
+      map->outputs[map->OutputsNbr - 1U].fill += s;
+    }
+    return(TRUE);
+  }
+
+  if(map->InputsNbr == map->InputsCap)
+  {
+    uint32     capacity = map->InputsCap * 2U;
+    sMapInput* inputs   = (sMapInput*)realloc(map->inputs, (size_t)capacity * sizeof(sMapInput));
+
+    if(inputs == NULL)
+    {
+      return(FALSE);
+    }
+    map->inputs    = inputs;
+    map->InputsCap = capacity;
+  }
+
+  input         = &map->inputs[map->InputsNbr];
+  input->name   = name;
+  input->addr   = a;
+  input->size   = s;
+  input->output = map->OutputsNbr - 1U;
+  input->file   = Map_AddFile(map, (*path != '\0') ? path : "(linker)");
+
+  if(input->file == MAP_NONE)
+  {
+    return(FALSE);
+  }
+
+  map->InputsNbr++;
+  map->outputs[input->output].last = map->InputsNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_Load
+** Description: load and tokenize a GNU ld map file. Only the memory map part is read: an output section starts at
+**              the first column, an input section (or *fill*) is indented by one blank, a name too long for its
+**              column is followed by its address and size on the next line. The assignments, symbols, input
+**              section patterns and the cross reference table are skipped.
+** Parameter:   sMap* map, const char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Map_Load(sMap* map, const char* path)
+{
+  sMapLine line;
+  uint32   size    = 0;
+  boolean  started = FALSE;
+  boolean  result  = TRUE;
+  char*    pending = NULL;                //name waiting for its address and size on the next line
+  boolean  output  = FALSE;               //the pending name is an output section
+
+  memset(map, 0, sizeof(sMap));
+  map->text = (char*)LoadInputFile((char*)path, &size);
+
+  if(map->text == NULL)
+  {
+    return(FALSE);
+  }
+
+  map->OutputsCap = 64U;
+  map->InputsCap  = 1024U;
+  map->FilesCap   = 64U;
+  map->mask       = 255U;
+  map->outputs    = (sMapOutput*)malloc(map->OutputsCap * sizeof(sMapOutput));
+  map->inputs     = (sMapInput*)malloc(map->InputsCap * sizeof(sMapInput));
+  map->files      = (sMapFile*)malloc(map->FilesCap * sizeof(sMapFile));
+  map->slots      = (uint32*)malloc((map->mask + 1U) * sizeof(uint32));
+
+  if(map->outputs == NULL || map->inputs == NULL || map->files == NULL || map->slots == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Map_Release(map);
+    return(FALSE);
+  }
+  memset(map->slots, 0xFF, (map->mask + 1U) * sizeof(uint32));
+
+  line.p   = map->text;
+  line.end = map->text + size;
+
+  while(result && Map_NextLine(&line))
+  {
+    char* name = pending;
+    char* first;
+
+    map->lines++;
+    pending = NULL;
+
+    if(!started)
+    {
+      started = (boolean)(0 == strcmp(line.rest, "Linker script and memory map"));
+      continue;
+    }
+
+    if(line.indent == 0U && 0 == strcmp(line.rest, "Cross Reference Table"))
+    {
+      break;
+    }
+
+    first = Map_Token(&line);
+
+    if(line.indent > 1U)
+    {
+      /* address and size of the name of the previous line */
+      if(name != NULL)
+      {
+        char* size = Map_Token(&line);
+
+        result = output ? Map_AddOutput(map, name, first, size, line.rest) :
+                          Map_AddInput(map, name, first, size, line.rest);
+      }
+    }
+    else if(first[0] != '\0' && line.rest[0] == '\0')
+    {
+      pending = (first[0] != '*') ? first : NULL;
+      output  = (boolean)(line.indent == 0U);
+    }
+    else if(first[0] != '\0')
+    {
+      char* addr = Map_Token(&line);
+      char* size = Map_Token(&line);
+
+      result = (line.indent == 0U) ? Map_AddOutput(map, first, addr, size, line.rest) :
+                                     Map_AddInput(map, first, addr, size, line.rest);
+    }
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+  }
+  else if(map->OutputsNbr == 0)
+  {
+    printf("\n\r error: No memory map in the file '%s' (not a GNU ld map file) !\n\r", path);
+    result = FALSE;
+  }
+
+  if(!result)
+  {
+    Map_Release(map);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_Release
+** Description: free a loaded map
+** Parameter:   sMap* map
+** Return:      void
+*******************************************************************************************************************/
+void Map_Release(sMap* map)
+{
+  free(map->text);
+  free(map->outputs);
+  free(map->inputs);
+  free(map->files);
+  free(map->slots);
+  Arena_Release(&map->arena);
+  memset(map, 0, sizeof(sMap));
+}
+
+/*******************************************************************************************************************
+** Function:    Map_CompareInputs
+** Description: qsort callback, input sections by address, then by size (the empty sections first)
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Map_CompareInputs(const void* a, const void* b)
+{
+  const sMapInput* x = (const sMapInput*)a;
+  const sMapInput* y = (const sMapInput*)b;
+
+  if(x->addr != y->addr)
+  {
+    return((x->addr < y->addr) ? -1 : 1);
+  }
+  return((x->size < y->size) ? -1 : (x->size > y->size) ? 1 : 0);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_CompareGroups
+** Description: qsort callback, lines of the size report by total size (largest first), then by name
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Map_CompareGroups(const void* a, const void* b)
+{
+  const sMapGroup* x = (const sMapGroup*)a;
+  const sMapGroup* y = (const sMapGroup*)b;
+
+  if(x->total != y->total)
+  {
+    return((x->total > y->total) ? -1 : 1);
+  }
+  return(strcmp(x->name, y->name));
+}
+
+/*******************************************************************************************************************
+** Function:    Map_CompareFiles
+** Description: qsort callback, file indexes by library (objects linked directly: by path), then by path
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Map_CompareFiles(const void* a, const void* b)
+{
+  const sMapFile* x = &MapSorted->files[*(const uint32*)a];
+  const sMapFile* y = &MapSorted->files[*(const uint32*)b];
+  int             c = strcmp((x->library[0] != '\0') ? x->library : x->path,
+                             (y->library[0] != '\0') ? y->library : y->path);
+
+  return((c != 0) ? c : strcmp(x->path, y->path));
+}
+
+/*******************************************************************************************************************
+** Function:    Map_FindInput
+** Description: find the input section of an output section which holds an address (the non-empty input
+**              sections of an output section are disjoint and sorted by address)
+** Parameter:   const sMap* map, const sMapOutput* output, uint64 addr
+** Return:      uint32 (input section index, MAP_NONE if none)
+*******************************************************************************************************************/
+static uint32 Map_FindInput(const sMap* map, const sMapOutput* output, uint64 addr)
+{
+  uint32 low  = output->first;
+  uint32 high = output->last;
+
+  /* first input section starting after addr */
+  while(low < high)
+  {
+    uint32 mid = low + (high - low) / 2U;
+
+    if(map->inputs[mid].addr <= addr)
+    {
+      low = mid + 1U;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  while(low > output->first && map->inputs[low - 1U].size == 0)
+  {
+    low--;
+  }
+
+  if(low > output->first && addr - map->inputs[low - 1U].addr < map->inputs[low - 1U].size)
+  {
+    return(low - 1U);
+  }
+  return(MAP_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_Kind
+** Description: kind of the content of an ELF section
+** Parameter:   const sElfSection* section
+** Return:      uint32 (MAP_CODE, MAP_RODATA, MAP_DATA or MAP_BSS)
+*******************************************************************************************************************/
+static uint32 Map_Kind(const sElfSection* section)
+{
+  if((section->flags & SHF_EXECU) != 0)
+  {
+    return(MAP_CODE);
+  }
+  if(section->type == SHT_NOBITS)
+  {
+    return(MAP_BSS);
+  }
+  return(((section->flags & SHF_WRITE) != 0) ? MAP_DATA : MAP_RODATA);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_CheckSections
+** Description: join the output sections of the map to the ALLOC sections of the ELF file by name, and check their
+**              addresses and sizes. OutputOf receives the output section of each ELF section (MAP_NONE if none).
+** Parameter:   sMap* map, sElf* elf, uint32* OutputOf
+** Return:      uint32 (number of mismatches)
+*******************************************************************************************************************/
+static uint32 Map_CheckSections(sMap* map, sElf* elf, uint32* OutputOf)
+{
+  sElfSection* sections = NULL;
+  uint32       SecNbr   = 0;
+  uint32       errors   = 0;
+
+  (void)Elf_GetSections(elf, &sections, &SecNbr);
+
+  for(uint32 i = 0; i < SecNbr; i++)
+  {
+    OutputOf[i] = MAP_NONE;
+  }
+
+  for(uint32 i = 0; i < map->OutputsNbr; i++)
+  {
+    sMapOutput*  output  = &map->outputs[i];
+    sElfSection* section = Elf_FindSection(elf, output->name);
+
+    /* the input sections are searched by address */
+    qsort(&map->inputs[output->first], output->last - output->first, sizeof(sMapInput), Map_CompareInputs);
+
+    if(section == NULL || (section->flags & SHF_ALLOC) == 0)
+    {
+      continue;
+    }
+
+    if(section->addr != output->addr || section->size != output->size)
+    {
+      printf("\n\r error: The map file does not match the ELF file: section '%s' at 0x%llx (0x%llx bytes) in the"
+             " map, at 0x%llx (0x%llx bytes) in the ELF file !\n\r", output->name,
+             (unsigned long long)output->addr, (unsigned long long)output->size,
+             (unsigned long long)section->addr, (unsigned long long)section->size);
+      errors++;
+    }
+
+    OutputOf[section - sections] = i;
+  }
+  return(errors);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_PrintSizes
+** Description: print the size of the input sections placed in the ALLOC sections, by library or by object file,
+**              and by kind of section (the padding between the input sections is counted apart)
+** Parameter:   sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+**              uint32 SecNbr
+** Return:      void
+*******************************************************************************************************************/
+static void Map_PrintSizes(sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+                           uint32 SecNbr)
+{
+  sArena*    scratch = Arena_Thread();
+  sArenaMark mark    = Arena_Mark(scratch);
+  uint32*    order   = (uint32*)Arena_Alloc(scratch, ((size_t)map->FilesNbr + 1U) * sizeof(uint32));
+  sMapGroup* groups  = (sMapGroup*)Arena_Calloc(scratch, (size_t)map->FilesNbr + 2U, sizeof(sMapGroup));
+  uint32*    kinds   = (uint32*)Arena_Alloc(scratch, ((size_t)map->OutputsNbr + 1U) * sizeof(uint32));
+  sMapGroup* total   = NULL;
+  uint32     count   = 0;
+  uint64     fill    = 0;
+
+  if(order == NULL || groups == NULL || kinds == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Arena_Rewind(scratch, mark);
+    return;
+  }
+
+  /* kind of each output section, MAP_NONE if it is not loaded (not counted) */
+  for(uint32 i = 0; i < map->OutputsNbr; i++)
+  {
+    kinds[i] = MAP_NONE;
+  }
+
+  for(uint32 i = 0; i < SecNbr; i++)
+  {
+    if(OutputOf[i] != MAP_NONE)
+    {
+      kinds[OutputOf[i]] = Map_Kind(&sections[i]);
+      fill              += map->outputs[OutputOf[i]].fill;
+    }
+  }
+
+  /* one line per library (or object file): the files are sorted so that the members of a library follow */
+  for(uint32 i = 0; i < map->FilesNbr; i++)
+  {
+    order[i] = i;
+  }
+
+  MapSorted = map;
+  qsort(order, map->FilesNbr, sizeof(uint32), Map_CompareFiles);
+
+  for(uint32 i = 0; i < map->FilesNbr; i++)
+  {
+    sMapFile*   file = &map->files[order[i]];
+    const char* name = (spec->by == MAP_BY_LIB && file->library[0] != '\0') ? file->library : file->path;
+
+    if(count == 0 || 0 != strcmp(groups[count - 1U].name, name))
+    {
+      groups[count++].name = name;
+    }
+
+    file->group = count - 1U;
+    groups[file->group].files++;
+  }
+
+  total       = &groups[count];
+  total->name = "Total";
+
+  for(uint32 i = 0; i < map->InputsNbr; i++)
+  {
+    const sMapInput* input = &map->inputs[i];
+    uint32           kind  = kinds[input->output];
+
+    if(kind != MAP_NONE)
+    {
+      sMapGroup* group = &groups[map->files[input->file].group];
+
+      group->size[kind] += input->size;
+      group->total      += input->size;
+      total->size[kind] += input->size;
+      total->total      += input->size;
+    }
+  }
+
+  qsort(groups, count, sizeof(sMapGroup), Map_CompareGroups);
+
+  printf("\nSIZE BY %s\n\n%-12s%-12s%-12s%-12s%-12s%-8s%s\n\n", (spec->by == MAP_BY_LIB) ? "LIBRARY" : "OBJECT",
+         MapKindNames[MAP_CODE], MapKindNames[MAP_RODATA], MapKindNames[MAP_DATA], MapKindNames[MAP_BSS],
+         "Total", "Files", (spec->by == MAP_BY_LIB) ? "Library" : "Object");
+
+  for(uint32 i = 0; i <= count; i++)
+  {
+    const sMapGroup* group = (i < count) ? &groups[i] : total;
+
+    /* the files which bring nothing to the image (crt stubs, discarded sections) are not listed */
+    if(group->total == 0 && i < count)
+    {
+      continue;
+    }
+
+    if(i == count)
+    {
+      printf("\n");
+    }
+
+    printf("%-12llu%-12llu%-12llu%-12llu%-12llu%-8u%s\n",
+           (unsigned long long)group->size[MAP_CODE], (unsigned long long)group->size[MAP_RODATA],
+           (unsigned long long)group->size[MAP_DATA], (unsigned long long)group->size[MAP_BSS],
+           (unsigned long long)group->total, (i < count) ? group->files : map->FilesNbr, group->name);
+  }
+
+  printf("%-48s%-12llu%-8s%s\n", "", (unsigned long long)fill, "", "(padding between the input sections)");
+  Arena_Rewind(scratch, mark);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_PrintOrigins
+** Description: print the input section, object file and library of the ELF symbols queried
+** Parameter:   sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+**              uint32 SecNbr, const sElfSymbol* symbols, uint32 SymNbr
+** Return:      uint32 (number of queried names matching no symbol)
+*******************************************************************************************************************/
+static uint32 Map_PrintOrigins(sMap* map, const sMapSpec* spec, const uint32* OutputOf, const sElfSection* sections,
+                               uint32 SecNbr, const sElfSymbol* symbols, uint32 SymNbr)
+{
+  boolean found[MAP_MAX_NAMES];
+  uint32  missing = 0;
+
+  memset(found, 0, sizeof(found));
+
+  printf("\nSYMBOL ORIGINS\n\n%-40s%-20s%-12s%-24s%-32s%s\n\n",
+         "Symbol", "Address", "Size", "Section", "Input section", "Object");
+
+  for(uint32 i = 0; i < SymNbr; i++)
+  {
+    const sElfSymbol* symbol = &symbols[i];
+    uint32            type   = ELF32_ST_TYPE(symbol->info);
+    uint32            name   = 0;
+    uint32            input  = MAP_NONE;
+
+    /* the symbols of the sections of the image (absolute and common symbols have no input section) */
+    if(symbol->shndx == 0 || symbol->shndx >= SecNbr || type == STT_SECTIONS || type == STT_FILE ||
+       symbol->name[0] == '\0')
+    {
+      continue;
+    }
+
+    while(name < spec->NamesNbr && !Vars_Match(spec->names[name], symbol->name))
+    {
+      name++;
+    }
+
+    if(name == spec->NamesNbr)
+    {
+      continue;
+    }
+    found[name] = TRUE;
+
+    if(OutputOf[symbol->shndx] != MAP_NONE)
+    {
+      input = Map_FindInput(map, &map->outputs[OutputOf[symbol->shndx]], symbol->value);
+    }
+
+    printf("%-40s0x%-18llx0x%-10llx%-24s%-32s%s\n", symbol->name,
+           (unsigned long long)symbol->value, (unsigned long long)symbol->size, sections[symbol->shndx].name,
+           (input != MAP_NONE) ? map->inputs[input].name : "-",
+           (input != MAP_NONE) ? map->files[map->inputs[input].file].path : "(not in the map)");
+  }
+
+  for(uint32 i = 0; i < spec->NamesNbr; i++)
+  {
+    if(!found[i])
+    {
+      printf("\n\r error: No symbol '%s' in the ELF file !\n\r", spec->names[i]);
+      missing++;
+    }
+  }
+  return(missing);
+}
+
+/*******************************************************************************************************************
+** Function:    Map_Report
+** Description: load the map file of the request, check it against the ELF file and print the size by library (or
+**              object file) and the origin of the queried symbols
+** Parameter:   sElf* elf, const sMapSpec* spec
+** Return:      boolean (FALSE if the map does not match the ELF file or a queried symbol is missing)
+*******************************************************************************************************************/
+boolean Map_Report(sElf* elf, const sMapSpec* spec)
+{
+  sArena*      scratch  = Arena_Thread();
+  sArenaMark   mark     = Arena_Mark(scratch);
+  sMap         map;
+  sElfSection* sections = NULL;
+  sElfSymbol*  symbols  = NULL;
+  uint32       SecNbr   = 0;
+  uint32       SymNbr   = 0;
+  uint32*      OutputOf = NULL;
+  uint32       errors   = 0;
+
+  if(!Map_Load(&map, spec->path))
+  {
+    return(FALSE);
+  }
+
+  printf("\nLINK MAP : %s\n", spec->path);
+
+  if(((Elf32_Ehdr*)elf->header)->e_type == TYP_RELOCATABLE_ELF)
+  {
+    printf("\n\r error: The link map is joined to a linked image, not to an object file !\n\r");
+    Map_Release(&map);
+    return(FALSE);
+  }
+
+  (void)Elf_GetSections(elf, &sections, &SecNbr);
+  OutputOf = (uint32*)Arena_Alloc(scratch, ((size_t)SecNbr + 1U) * sizeof(uint32));
+
+  if(OutputOf == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Map_Release(&map);
+    return(FALSE);
+  }
+
+  errors = Map_CheckSections(&map, elf, OutputOf);
+
+  printf("\n %u line(s), %u output section(s), %u input section(s) from %u file(s)\n",
+         map.lines, map.OutputsNbr, map.InputsNbr, map.FilesNbr);
+
+  Map_PrintSizes(&map, spec, OutputOf, sections, SecNbr);
+
+  if(spec->NamesNbr > 0)
+  {
+    (void)Elf_GetSymbols(elf, &symbols, &SymNbr);
+    errors += Map_PrintOrigins(&map, spec, OutputOf, sections, SecNbr, symbols, SymNbr);
+  }
+
+  Arena_Rewind(scratch, mark);
+  Map_Release(&map);
+  return((boolean)(errors == 0));
+}
@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __MAP_H__
+#define __MAP_H__
+
+#include<common.h>
+#include<Arena.h>
+#include<Elf.h>
+
+#define MAP_MAX_NAMES  32U            //symbols queried by one request
+#define MAP_NONE       0xFFFFFFFFUL
+
+#define MAP_BY_LIB     0U             //size report by library (the objects linked directly are one group each)
+#define MAP_BY_OBJ     1U             //size report by object file
+
+//parsed -map request
+typedef struct
+{
+  char*   path;                       //GNU ld map file
+  uint32  by;                         //MAP_BY_LIB or MAP_BY_OBJ
+  char*   names[MAP_MAX_NAMES];       //symbols queried (names or patterns, '*' and '?' wildcards)
+  uint32  NamesNbr;
+  char    copy[MAX_LINE_LEN];
+}sMapSpec;
+
+//one input file of the link: an object file, or an archive member "<library>(<object>)"
+typedef struct
+{
+  char*   path;                       //as written in the map file
+  char*   library;                    //archive ("" for an object linked directly)
+  char*   object;
+  uint32  hash;
+  uint32  group;                      //line of the size report
+}sMapFile;
+
+//one output section of the map
+typedef struct
+{
+  char*   name;
+  uint64  addr;
+  uint64  size;
+  uint64  lma;                        //load address ("load address" of the map, addr if none)
+  uint64  fill;                       //padding bytes (*fill*)
+  uint32  first;                      //input sections [first, last) of the output section
+  uint32  last;
+}sMapOutput;
+
+//one input section placed by the linker
+typedef struct
+{
+  char*   name;
+  uint64  addr;
+  uint64  size;
+  uint32  file;
+  uint32  output;
+}sMapInput;
+
+//linker map file, tokenized in place: every name points into the loaded text
+typedef struct
+{
+  char*       text;
+  sMapOutput* outputs;
+  uint32      OutputsNbr;
+  uint32      OutputsCap;
+  sMapInput*  inputs;
+  uint32      InputsNbr;
+  uint32      InputsCap;
+  sMapFile*   files;
+  uint32      FilesNbr;
+  uint32      FilesCap;
+  uint32*     slots;                  //open addressing table of the files, by path
+  uint32      mask;
+  uint32      lines;
+  sArena      arena;                  //library and object names of the files
+}sMap;
+
+boolean Map_ParseSpec(sMapSpec* spec, const char* text);
+boolean Map_Load(sMap* map, const char* path);
+void    Map_Release(sMap* map);
+boolean Map_Report(sElf* elf, const sMapSpec* spec);
+
+#endif
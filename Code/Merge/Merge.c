@@ -0,0 +1,618 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Merge of several load images into one (-merge): bootloader, application, calibration data...
+**
+** The inputs are ELF files, S19/HEX files or raw binaries loaded at a given address ("cal.bin,at=0x80000"). Their
+** regions are merged by a sweep over the region boundaries, sorted once: between two boundaries the address range
+** belongs to the input regions which started and did not end yet, kept in a heap ordered by priority (the input of
+** highest priority, then the first listed input). The sweep costs O(R log R) for R regions, whatever their sizes:
+** no byte is looked at. The pieces of the winning regions form the merged image, which is then wrapped into a
+** minimal ELF file (Image_WrapElf) and processed as any input file (-s19, -c, -bin, -elf, -crc...).
+**
+** An address loaded by two inputs of different priorities is an OVERRIDE, by two inputs of equal priority a
+** CONFLICT (the merge fails), by two regions of the same input an OVERLAP (the first region is kept).
+*******************************************************************************************************************/
+
+#include<Merge.h>
+#include<io.h>
+
+#define MERGE_NONE  0xFFFFFFFFUL
+
+//one region of an input
+typedef struct
+{
+  uint64       addr;
+  uint64       end;
+  const uint8* data;
+  char*        name;
+  uint32       input;
+}sMergeRange;
+
+//start or end of a region
+typedef struct
+{
+  uint64 pos;
+  uint32 range;
+  uint32 start;                       //1: start, 0: end (the ends of a position come first)
+}sMergeEvent;
+
+//state of the sweep
+typedef struct
+{
+  sMerge*      merge;
+  sMergeRange* ranges;
+  uint32*      heap;                  //started ranges, best first (the ended ones are removed when on top)
+  uint32       HeapNbr;
+  uint8*       active;                //per range, started and not ended
+  uint32       ActiveNbr;
+  uint32       kept;                  //pending overlap report (kept == MERGE_NONE: none)
+  uint32       lost;
+  uint64       start;
+  uint64       end;
+  uint32       overlaps;
+  uint32       conflicts;
+}sMergeSweep;
+
+static boolean     Merge_ParseSpec(sMergeInput* input, char* spec);
+static boolean     Merge_LoadInput(sMergeInput* input);
+static int         Merge_CompareEvents(const void* a, const void* b);
+static boolean     Merge_Before(const sMergeSweep* sweep, uint32 a, uint32 b);
+static void        Merge_Push(sMergeSweep* sweep, uint32 range);
+static uint32      Merge_Pop(sMergeSweep* sweep);
+static uint32      Merge_Top(sMergeSweep* sweep);
+static const char* Merge_Describe(const sMergeSweep* sweep, uint32 range, uint64 addr, char* text, size_t size);
+static void        Merge_Flush(sMergeSweep* sweep);
+static void        Merge_Overlap(sMergeSweep* sweep, uint32 kept, uint32 lost, uint64 start, uint64 end);
+static boolean     Merge_AddPiece(sMerge* merge, const sMergeRange* range, uint64 start, uint64 end);
+
+/*******************************************************************************************************************
+** Function:    Merge_ParseSpec
+** Description: parse "<File>[,at=<Address>][,prio=<Priority>]"
+** Parameter:   sMergeInput* input, char* spec
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Merge_ParseSpec(sMergeInput* input, char* spec)
+{
+  char* item  = NULL;
+  char* value = NULL;
+  char* end   = NULL;
+
+  strncpy(input->copy, spec, MAX_LINE_LEN - 1U);
+  input->copy[MAX_LINE_LEN - 1U] = '\0';
+
+  input->path = strtok(input->copy, ",");
+
+  while(input->path != NULL && (item = strtok(NULL, ",")) != NULL)
+  {
+    if(strncmp(item, "at=", 3) == 0)
+    {
+      value        = &item[3];
+      input->at    = strtoull(value, &end, 0);
+      input->HasAt = TRUE;
+    }
+    else if(strncmp(item, "prio=", 5) == 0)
+    {
+      value           = &item[5];
+      input->priority = (sint32)strtol(value, &end, 0);
+    }
+    else
+    {
+      value = end = item;
+    }
+
+    if(end == value || *end != '\0')
+    {
+      printf("\n\r error: Bad merge option '%s' in '%s' !\n\r", item, spec);
+      return(FALSE);
+    }
+  }
+
+  if(input->path == NULL)
+  {
+    printf("\n\r error: Bad merge input '%s' !\n\r", spec);
+    return(FALSE);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_LoadInput
+** Description: load one input and build its image: a raw binary when a load address is given, else an S19/HEX
+**              file or an ELF file
+** Parameter:   sMergeInput* input
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Merge_LoadInput(sMergeInput* input)
+{
+  input->buffer = (char*)LoadInputFile(input->path, &input->size);
+
+  if(input->buffer == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(input->HasAt)
+  {
+    return((boolean)(input->size == 0 ||
+                     Image_AddRegion(&input->image, input->at, input->size, (uint8*)input->buffer, NULL)));
+  }
+
+  if(SRec_IsRecordFile(input->buffer, input->size))
+  {
+    if(!SRec_Load(&input->rec, input->buffer, input->size, input->path))
+    {
+      return(FALSE);
+    }
+
+    for(uint32 i = 0; i < input->rec.image.RegionsNbr; i++)
+    {
+      const sImageRegion* region = &input->rec.image.regions[i];
+
+      if(!Image_AddRegion(&input->image, region->addr, region->size, region->data, NULL))
+      {
+        return(FALSE);
+      }
+    }
+
+    input->entry    = input->rec.entry;
+    input->HasEntry = input->rec.HasEntry;
+    return(TRUE);
+  }
+
+  if(!Elf_Open(&input->elf, input->buffer, input->size))
+  {
+    printf("\n%s : ", input->path);
+    Elf_PrintError(&input->elf);
+
+    if(input->elf.ErrorCode == ELF_ERR_NOT_ELF)
+    {
+      printf("(a raw binary is merged with at=<Address>)\n");
+    }
+    return(FALSE);
+  }
+
+  if(!Image_BuildFromElf(&input->image, &input->elf))
+  {
+    return(FALSE);
+  }
+
+  Image_Sort(&input->image);
+  input->SymNbr   = Image_GetSymbols(&input->elf, &input->symbols);
+  input->entry    = Elf_GetEntry(&input->elf);
+  input->HasEntry = TRUE;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Load
+** Description: load the input file (priority 0) and the -merge inputs
+** Parameter:   sMerge* merge, char* path, char** specs, uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Merge_Load(sMerge* merge, char* path, char** specs, uint32 count)
+{
+  memset(merge, 0, sizeof(sMerge));
+  merge->mark = Arena_Mark(Arena_Thread());
+
+  if(count + 1U > MERGE_MAX_INPUTS)
+  {
+    printf("\n\r error: Too many merge inputs !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i <= count; i++)
+  {
+    sMergeInput* input = &merge->inputs[merge->InputsNbr++];
+
+    if(!Merge_ParseSpec(input, (i == 0) ? path : specs[i - 1U]) || !Merge_LoadInput(input))
+    {
+      return(FALSE);
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_CompareEvents
+** Description: qsort callback: by position, the ends before the starts
+** Parameter:   const void* a, const void* b (sMergeEvent*)
+** Return:      int
+*******************************************************************************************************************/
+static int Merge_CompareEvents(const void* a, const void* b)
+{
+  const sMergeEvent* x = (const sMergeEvent*)a;
+  const sMergeEvent* y = (const sMergeEvent*)b;
+
+  if(x->pos != y->pos)
+  {
+    return((x->pos < y->pos) ? -1 : 1);
+  }
+  if(x->start != y->start)
+  {
+    return((x->start < y->start) ? -1 : 1);
+  }
+  return((x->range < y->range) ? -1 : ((x->range > y->range) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Before
+** Description: heap order: higher priority, then first listed input, then first region
+** Parameter:   const sMergeSweep* sweep, uint32 a, uint32 b (ranges)
+** Return:      boolean (TRUE if a wins over b)
+*******************************************************************************************************************/
+static boolean Merge_Before(const sMergeSweep* sweep, uint32 a, uint32 b)
+{
+  const sMergeInput* x = &sweep->merge->inputs[sweep->ranges[a].input];
+  const sMergeInput* y = &sweep->merge->inputs[sweep->ranges[b].input];
+
+  if(x->priority != y->priority)
+  {
+    return((boolean)(x->priority > y->priority));
+  }
+  return((boolean)(a < b));
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Push
+** Description: insert a range in the heap
+** Parameter:   sMergeSweep* sweep, uint32 range
+** Return:      void
+*******************************************************************************************************************/
+static void Merge_Push(sMergeSweep* sweep, uint32 range)
+{
+  uint32 i = sweep->HeapNbr++;
+
+  while(i > 0 && Merge_Before(sweep, range, sweep->heap[(i - 1U) / 2U]))
+  {
+    sweep->heap[i] = sweep->heap[(i - 1U) / 2U];
+    i = (i - 1U) / 2U;
+  }
+  sweep->heap[i] = range;
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Pop
+** Description: remove the top of the heap
+** Parameter:   sMergeSweep* sweep
+** Return:      uint32 (range)
+*******************************************************************************************************************/
+static uint32 Merge_Pop(sMergeSweep* sweep)
+{
+  uint32 top  = sweep->heap[0];
+  uint32 last = sweep->heap[--sweep->HeapNbr];
+  uint32 i    = 0;
+
+  for(;;)
+  {
+    uint32 child = 2U * i + 1U;
+
+    if(child >= sweep->HeapNbr)
+    {
+      break;
+    }
+    if(child + 1U < sweep->HeapNbr && Merge_Before(sweep, sweep->heap[child + 1U], sweep->heap[child]))
+    {
+      child++;
+    }
+    if(!Merge_Before(sweep, sweep->heap[child], last))
+    {
+      break;
+    }
+    sweep->heap[i] = sweep->heap[child];
+    i = child;
+  }
+
+  if(sweep->HeapNbr > 0)
+  {
+    sweep->heap[i] = last;
+  }
+  return(top);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Top
+** Description: best started range which did not end (the ended ranges met on top are removed)
+** Parameter:   sMergeSweep* sweep
+** Return:      uint32 (range, MERGE_NONE if none)
+*******************************************************************************************************************/
+static uint32 Merge_Top(sMergeSweep* sweep)
+{
+  while(sweep->HeapNbr > 0 && !sweep->active[sweep->heap[0]])
+  {
+    (void)Merge_Pop(sweep);
+  }
+  return((sweep->HeapNbr > 0) ? sweep->heap[0] : MERGE_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Describe
+** Description: "#<input> <section> <symbol>" of an address of a range
+** Parameter:   const sMergeSweep* sweep, uint32 range, uint64 addr, char* text, size_t size
+** Return:      const char* (text)
+*******************************************************************************************************************/
+static const char* Merge_Describe(const sMergeSweep* sweep, uint32 range, uint64 addr, char* text, size_t size)
+{
+  const sMergeRange* r     = &sweep->ranges[range];
+  const sMergeInput* input = &sweep->merge->inputs[r->input];
+  char               symbol[MAX_LINE_LEN / 2U];
+
+  Image_SymbolName(input->symbols, input->SymNbr, addr, symbol, sizeof(symbol));
+  snprintf(text, size, "#%u %s %s", r->input, (r->name != NULL) ? r->name : "-", symbol);
+  return(text);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Flush
+** Description: print the pending overlap (the first MERGE_MAX_OVERLAPS ones, the others are only counted)
+** Parameter:   sMergeSweep* sweep
+** Return:      void
+*******************************************************************************************************************/
+static void Merge_Flush(sMergeSweep* sweep)
+{
+  const sMergeInput* kept = NULL;
+  const sMergeInput* lost = NULL;
+  const char*        status = NULL;
+  char               KeptText[MAX_LINE_LEN];
+  char               LostText[MAX_LINE_LEN];
+
+  if(sweep->kept == MERGE_NONE)
+  {
+    return;
+  }
+
+  kept = &sweep->merge->inputs[sweep->ranges[sweep->kept].input];
+  lost = &sweep->merge->inputs[sweep->ranges[sweep->lost].input];
+
+  if(kept == lost)
+  {
+    status = "OVERLAP";
+  }
+  else if(kept->priority != lost->priority)
+  {
+    status = "OVERRIDE";
+  }
+  else
+  {
+    status = "CONFLICT";
+    sweep->conflicts++;
+  }
+
+  if(sweep->overlaps == 0)
+  {
+    printf("\n%-10s%-20s%-20s%-12s%-40s%s\n\n", "Status", "Start", "End", "Size", "Kept", "Dropped");
+  }
+
+  if(sweep->overlaps < MERGE_MAX_OVERLAPS)
+  {
+    printf("%-10s0x%-18llx0x%-18llx%-12llu%-40s%s\n", status, (unsigned long long)sweep->start,
+           (unsigned long long)(sweep->end - 1U), (unsigned long long)(sweep->end - sweep->start),
+           Merge_Describe(sweep, sweep->kept, sweep->start, KeptText, sizeof(KeptText)),
+           Merge_Describe(sweep, sweep->lost, sweep->start, LostText, sizeof(LostText)));
+  }
+
+  sweep->overlaps++;
+  sweep->kept = MERGE_NONE;
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Overlap
+** Description: record an address range loaded by two ranges (extends the pending one when it continues it)
+** Parameter:   sMergeSweep* sweep, uint32 kept, uint32 lost, uint64 start, uint64 end
+** Return:      void
+*******************************************************************************************************************/
+static void Merge_Overlap(sMergeSweep* sweep, uint32 kept, uint32 lost, uint64 start, uint64 end)
+{
+  if(sweep->kept == kept && sweep->lost == lost && sweep->end == start)
+  {
+    sweep->end = end;
+    return;
+  }
+
+  Merge_Flush(sweep);
+  sweep->kept  = kept;
+  sweep->lost  = lost;
+  sweep->start = start;
+  sweep->end   = end;
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_AddPiece
+** Description: append a piece of a range to the merged image (extends the last region when it continues it)
+** Parameter:   sMerge* merge, const sMergeRange* range, uint64 start, uint64 end
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Merge_AddPiece(sMerge* merge, const sMergeRange* range, uint64 start, uint64 end)
+{
+  uint8*        data = (uint8*)&range->data[start - range->addr];
+  sImageRegion* last = (merge->image.RegionsNbr > 0) ? &merge->image.regions[merge->image.RegionsNbr - 1U] : NULL;
+
+  if(last != NULL && last->addr + last->size == start && last->data + last->size == data)
+  {
+    last->size += end - start;
+    return(TRUE);
+  }
+  return(Image_AddRegion(&merge->image, start, end - start, data, range->name));
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Build
+** Description: merge the images of the inputs and report the overlaps
+** Parameter:   sMerge* merge
+** Return:      boolean (FALSE on a conflict)
+*******************************************************************************************************************/
+boolean Merge_Build(sMerge* merge)
+{
+  sArena*      scratch = Arena_Thread();
+  sMergeEvent* events  = NULL;
+  uint32       count   = 0;
+  uint32       EvNbr   = 0;
+  uint64       bytes   = 0;
+  boolean      ok      = TRUE;
+  boolean      entry   = FALSE;
+  sMergeSweep  sweep;
+
+  memset(&sweep, 0, sizeof(sweep));
+  sweep.merge = merge;
+  sweep.kept  = MERGE_NONE;
+
+  printf("\nMERGE : %u input(s)\n\n%-7s%-10s%-10s%-12s%s\n\n", merge->InputsNbr, "Input", "Priority", "Regions",
+         "Bytes", "File");
+
+  for(uint32 i = 0; i < merge->InputsNbr; i++)
+  {
+    const sMergeInput* input = &merge->inputs[i];
+
+    bytes = 0;
+    for(uint32 k = 0; k < input->image.RegionsNbr; k++)
+    {
+      bytes += input->image.regions[k].size;
+    }
+    printf("#%-6u%-10d%-10u%-12llu%s\n", i, (int)input->priority, input->image.RegionsNbr,
+           (unsigned long long)bytes, input->path);
+    count += input->image.RegionsNbr;
+
+    if(!entry && input->HasEntry)
+    {
+      merge->entry = input->entry;
+      entry        = TRUE;
+    }
+  }
+
+  sweep.ranges = (sMergeRange*)Arena_Alloc(scratch, (size_t)count * sizeof(sMergeRange) + 1U);
+  sweep.heap   = (uint32*)Arena_Alloc(scratch, (size_t)count * sizeof(uint32) + 1U);
+  sweep.active = (uint8*)Arena_Calloc(scratch, (size_t)count + 1U, sizeof(uint8));
+  events       = (sMergeEvent*)Arena_Alloc(scratch, (size_t)count * 2U * sizeof(sMergeEvent) + 1U);
+
+  if(sweep.ranges == NULL || sweep.heap == NULL || sweep.active == NULL || events == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 i = 0, r = 0; i < merge->InputsNbr; i++)
+  {
+    for(uint32 k = 0; k < merge->inputs[i].image.RegionsNbr; k++, r++)
+    {
+      const sImageRegion* region = &merge->inputs[i].image.regions[k];
+
+      sweep.ranges[r].addr  = region->addr;
+      sweep.ranges[r].end   = region->addr + region->size;
+      sweep.ranges[r].data  = region->data;
+      sweep.ranges[r].name  = region->name;
+      sweep.ranges[r].input = i;
+
+      events[EvNbr].pos   = region->addr;
+      events[EvNbr].range = r;
+      events[EvNbr].start = 1;
+      EvNbr++;
+      events[EvNbr].pos   = region->addr + region->size;
+      events[EvNbr].range = r;
+      events[EvNbr].start = 0;
+      EvNbr++;
+    }
+  }
+
+  if(EvNbr > 1)
+  {
+    qsort(events, EvNbr, sizeof(sMergeEvent), Merge_CompareEvents);
+  }
+
+  /* between two boundaries, the best active range keeps the addresses, the second best one is the overlap */
+  for(uint32 e = 0; e < EvNbr && ok;)
+  {
+    uint64 pos  = events[e].pos;
+    uint32 best = MERGE_NONE;
+
+    for(; e < EvNbr && events[e].pos == pos; e++)
+    {
+      uint32 range = events[e].range;
+
+      if(events[e].start)
+      {
+        sweep.active[range] = 1;
+        sweep.ActiveNbr++;
+        Merge_Push(&sweep, range);
+      }
+      else
+      {
+        sweep.active[range] = 0;
+        sweep.ActiveNbr--;
+      }
+    }
+
+    best = Merge_Top(&sweep);
+
+    if(e == EvNbr || best == MERGE_NONE)
+    {
+      continue;
+    }
+
+    if(sweep.ActiveNbr > 1)
+    {
+      uint32 second = MERGE_NONE;
+
+      (void)Merge_Pop(&sweep);
+      second = Merge_Top(&sweep);
+      Merge_Push(&sweep, best);
+      Merge_Overlap(&sweep, best, second, pos, events[e].pos);
+    }
+
+    ok = Merge_AddPiece(merge, &sweep.ranges[best], pos, events[e].pos);
+  }
+  Merge_Flush(&sweep);
+
+  if(sweep.overlaps > MERGE_MAX_OVERLAPS)
+  {
+    printf("... %u more overlap(s)\n", sweep.overlaps - MERGE_MAX_OVERLAPS);
+  }
+
+  if(!ok)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  bytes = 0;
+  for(uint32 i = 0; i < merge->image.RegionsNbr; i++)
+  {
+    bytes += merge->image.regions[i].size;
+  }
+  printf("\nMERGED : %u region(s), %llu byte(s), entry 0x%llx, %u overlap(s)\n", merge->image.RegionsNbr,
+         (unsigned long long)bytes, (unsigned long long)merge->entry, sweep.overlaps);
+
+  if(sweep.conflicts > 0)
+  {
+    printf("\n\r error: %u range(s) loaded by two inputs of equal priority (set prio=<n>) !\n\r", sweep.conflicts);
+    return(FALSE);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Merge_Release
+** Description: free the inputs and the merged image
+** Parameter:   sMerge* merge
+** Return:      void
+*******************************************************************************************************************/
+void Merge_Release(sMerge* merge)
+{
+  for(uint32 i = 0; i < merge->InputsNbr; i++)
+  {
+    sMergeInput* input = &merge->inputs[i];
+
+    Image_Release(&input->image);
+    SRec_Release(&input->rec);
+    Elf_Close(&input->elf);
+    free(input->buffer);
+  }
+
+  Image_Release(&merge->image);
+  Arena_Rewind(Arena_Thread(), merge->mark);
+  memset(merge, 0, sizeof(sMerge));
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __MERGE_H__
+#define __MERGE_H__
+
+#include<common.h>
+#include<Elf.h>
+#include<Image.h>
+#include<SRec.h>
+
+#define MERGE_MAX_INPUTS    17U       //the input file and the -merge files
+#define MERGE_MAX_OVERLAPS  256U      //overlaps listed, the others are only counted
+
+//one input of the merge: ELF file, S19/HEX file or raw binary (at=<Address>)
+typedef struct
+{
+  char*         path;
+  uint64        at;                   //load address of a raw binary
+  boolean       HasAt;
+  sint32        priority;             //the input of higher priority keeps an address loaded by several inputs
+  char*         buffer;               //loaded file
+  uint32        size;
+  sElf          elf;                  //ELF file (elf.ops set once opened)
+  sSRecImage    rec;                  //S19/HEX file
+  sImage        image;                //load image, sorted
+  sImageSymbol* symbols;              //symbols of an ELF file (scratch arena of the thread)
+  uint32        SymNbr;
+  uint64        entry;
+  boolean       HasEntry;
+  char          copy[MAX_LINE_LEN];
+}sMergeInput;
+
+//merged load image of the inputs
+typedef struct
+{
+  sMergeInput inputs[MERGE_MAX_INPUTS];
+  uint32      InputsNbr;
+  sImage      image;                  //pieces of the input images, sorted and disjoint
+  uint64      entry;                  //entry point of the first input which has one
+  sArenaMark  mark;
+}sMerge;
+
+boolean Merge_Load(sMerge* merge, char* path, char** specs, uint32 count);
+boolean Merge_Build(sMerge* merge);
+void    Merge_Release(sMerge* merge);
+
+#endif
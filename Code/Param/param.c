@@ -1,372 +1,1185 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#include<param.h>
-
-
-#define START_PARAMETERS                     const ParamList ParamListAction[] = {
-#define DEFINE_PARAM(param,action,info)      {param, action, info},
-#define END_PARAMETERS                       };
-
-static void Param_SearchOpSetFlag(int* argc,char** argv);
-static void Param_HeaderOpSetFlag(int* argc,char** argv);
-static void Param_S19OpSetFlag(int* argc,char** argv);
-static void Param_COpSetFlag(int* argc,char** argv);
-static void Param_SecTabOpSetFlag(int* argc,char** argv);
-static void Param_SymTabOpSetFlag(int* argc,char** argv);
-static void Param_DisplayHelpOpSetFlag(int* argc,char** argv);
-static void Param_SrcListOpSetFlag(int* argc,char** argv);
-
-
-/*******************************************************************************************************************
-** COMMAND LINE OPTIONS DEFINITION : 
-*******************************************************************************************************************/
-START_PARAMETERS
-  DEFINE_PARAM("-header" , Param_HeaderOpSetFlag     ,  "             : Display the ELF file header")
-  DEFINE_PARAM("-sec"    , Param_SecTabOpSetFlag     ,  "             : Display the sections table")
-  DEFINE_PARAM("-sym"    , Param_SymTabOpSetFlag     ,  "             : Display the symbols table")
-  DEFINE_PARAM("-srclist", Param_SrcListOpSetFlag    ,  "             : List all used files in the program")
-  DEFINE_PARAM("-search" , Param_SearchOpSetFlag     ,  "<Symbol>     : Search for the <symbol> information in the ELF file")
-  DEFINE_PARAM("-s19"    , Param_S19OpSetFlag        ,  "<OutputFile> : Extract the binary in s19 format")
-  DEFINE_PARAM("-c"      , Param_COpSetFlag          ,  "<OutputFile> : Extract the binary in C-Array format")
-  DEFINE_PARAM("-h"      , Param_DisplayHelpOpSetFlag,  "             : Display the information")
-END_PARAMETERS
-
-/*******************************************************************************************************************
-** Globals 
-*******************************************************************************************************************/
-
-boolean Flag_HeaderOpSetFlag       = FALSE;
-boolean Flag_SearchOpSetFlag       = FALSE;
-boolean Flag_S19OpSetFlag          = FALSE;
-boolean Flag_COpSetFlag            = FALSE;
-boolean Flag_SecTabOpSetFlag       = FALSE;
-boolean Flag_SymTabOpSetFlag       = FALSE;
-boolean Flag_DisplayHelpOpSetFlag  = FALSE;
-boolean Flag_SrcListOpSetFlag      = FALSE;
-
-boolean boGlobalParamError         = FALSE;
-
-int TotalOptionsNbr = 0; 
-
-extern char* ElfFilePath;
-extern char* S19FilePath;
-extern char* CFilePath  ;
-extern char* SearchTxt;
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_OptionParser(int argc,char** argv)
-{
-  HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-  CONSOLE_SCREEN_BUFFER_INFO consoleInfo;
-  WORD saved_attributes;
-  boolean boOptionNotFound = TRUE;
-
-  TotalOptionsNbr = argc;
-
-  /* Save current attributes */
-  GetConsoleScreenBufferInfo(hConsole, &consoleInfo);
-  saved_attributes = consoleInfo.wAttributes;
-
-    ElfFilePath = (char*)argv[1];
-
-  for(unsigned int option=1; option < (unsigned int)(argc); option++)
-  {
-
-    boOptionNotFound = TRUE;
-
-    for(unsigned int cpt=0; cpt < (sizeof(ParamListAction)/sizeof(ParamList)); cpt++)
-    {
-      if(0 == strcmp((char*)(ParamListAction[cpt].param), argv[option]) && ParamListAction[cpt].action != NULL)
-      {
-        boOptionNotFound = FALSE;
-        ParamListAction[cpt].action(&option, argv);
-      }
-    }
-
-    if((boOptionNotFound && option != 1) || boGlobalParamError)
-    {
-      SetConsoleTextAttribute(hConsole, FOREGROUND_INTENSITY | FOREGROUND_RED);
-      printf("\n SYNTAX ERROR !!! \n");
-
-      DbgPrint("TotalOptionsNbr            = %d \n",TotalOptionsNbr          );
-      DbgPrint("boGlobalParamError         = %d \n",boGlobalParamError       );
-      DbgPrint("boOptionNotFound           = %d \n",boOptionNotFound         );
-      DbgPrint("Flag_S19OpSetFlag          = %d \n",Flag_S19OpSetFlag        );
-      DbgPrint("Flag_COpSetFlag            = %d \n",Flag_COpSetFlag          );
-      DbgPrint("Flag_SecTabOpSetFlag       = %d \n",Flag_SecTabOpSetFlag     );
-      DbgPrint("Flag_SymTabOpSetFlag       = %d \n",Flag_SymTabOpSetFlag     );
-      DbgPrint("Flag_DisplayHelpOpSetFlag  = %d \n",Flag_DisplayHelpOpSetFlag);
-
-      for(uint32 i=0; i < (uint32)TotalOptionsNbr; i++)
-      {
-        DbgPrint("argv[%d] = %s\n",i, argv[i]);
-      }
-
-      /* Restore original attributes */
-      SetConsoleTextAttribute(hConsole, saved_attributes);
-
-      Param_DisplayHelp();
-      return(FALSE);
-    }
-
-  }
-
-  if(TRUE == Flag_DisplayHelpOpSetFlag || boOptionNotFound)
-  {
-    DbgPrint("boGlobalParamError         = %d \n",boGlobalParamError       );
-    DbgPrint("boOptionNotFound           = %d \n",boOptionNotFound         );
-    DbgPrint("Flag_S19OpSetFlag          = %d \n",Flag_S19OpSetFlag        );
-    DbgPrint("Flag_COpSetFlag            = %d \n",Flag_COpSetFlag          );
-    DbgPrint("Flag_SecTabOpSetFlag       = %d \n",Flag_SecTabOpSetFlag     );
-    DbgPrint("Flag_SymTabOpSetFlag       = %d \n",Flag_SymTabOpSetFlag     );
-    DbgPrint("Flag_DisplayHelpOpSetFlag  = %d \n",Flag_DisplayHelpOpSetFlag);
-
-    Param_DisplayHelp();
-    return(FALSE);
-  }
-  else
-  {
-    return(TRUE);
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-void Param_DisplayHelp(void)
-{
-  //system("cls");
-  printf("\n ***********************************************************");
-  printf("\n   ELF PARSER TOOL V1.0.19 ( DEVELOPED BY CHALANDI AMINE )  ");
-  printf("\n ***********************************************************");
-  printf("\n\n Usage: ElfParser.exe <inElfFile> [option(s)]\n");
-  printf("\n Options are:\n");
-  for(unsigned int i=0; i < (sizeof(ParamListAction)/sizeof(ParamList)); i++)
-  {
-    printf("\n %-8s %s",ParamListAction[i].param, ParamListAction[i].info);
-  }
-  printf("\n");
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_SrcListOpSetFlag(int* argc,char** argv)
-{ 
-  (void)argc;
-  (void)argv;
-  Flag_SrcListOpSetFlag = TRUE;
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_HeaderOpSetFlag(int* argc,char** argv)
-{ 
-  (void)argc;
-  (void)argv;
-  Flag_HeaderOpSetFlag = TRUE;
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_SearchOpSetFlag(int* argc,char** argv)
-{ 
-  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
-  {
-    Flag_SearchOpSetFlag = TRUE;
-    SearchTxt = (char*)argv[++*argc];
-  }
-  else
-  {
-    boGlobalParamError = TRUE;
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_S19OpSetFlag(int* argc,char** argv)
-{ 
-  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
-  {
-    Flag_S19OpSetFlag = TRUE;
-    S19FilePath = (char*)argv[++*argc];
-  }
-  else
-  {
-    boGlobalParamError = TRUE;
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_COpSetFlag(int* argc,char** argv)
-{
-  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
-  {
-    Flag_COpSetFlag = TRUE;
-    CFilePath = (char*)argv[++*argc];
-  }
-  else
-  {
-    boGlobalParamError = TRUE;
-  }
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_SecTabOpSetFlag(int* argc,char** argv)
-{ 
-  (void)argc;
-  (void)argv;
-  Flag_SecTabOpSetFlag = TRUE;
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_SymTabOpSetFlag(int* argc,char** argv)
-{
-  (void)argc;
-  (void)argv;
-  Flag_SymTabOpSetFlag = TRUE; 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-static void Param_DisplayHelpOpSetFlag(int* argc,char** argv)
-{
-  (void)argc;
-  (void)argv;
-  Flag_DisplayHelpOpSetFlag = TRUE; 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetSrcListOpFlag(void)
-{ 
-  return(Flag_SrcListOpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetHeaderOpFlag(void)
-{ 
-  return(Flag_HeaderOpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetSearchOpFlag(void)
-{ 
-  return(Flag_SearchOpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetS19OpFlag(void)
-{ 
-  return(Flag_S19OpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetCOpFlag(void)
-{
-  return(Flag_COpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetSecTabOpFlag(void)
-{ 
-  return(Flag_SecTabOpSetFlag);
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetSymTabOpFlag(void)
-{ 
-  return(Flag_SymTabOpSetFlag); 
-}
-
-/*******************************************************************************************************************
-** Function:    
-** Description: 
-** Parameter:   
-** Return:      
-*******************************************************************************************************************/
-boolean Param_GetDisplayHelpOpFlag(void)
-{ 
-  return(Flag_DisplayHelpOpSetFlag); 
-}
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<param.h>
+
+
+#define START_PARAMETERS                     const ParamList ParamListAction[] = {
+#define DEFINE_PARAM(param,action,info)      {param, action, info},
+#define END_PARAMETERS                       };
+
+static void Param_SearchOpSetFlag(int* argc,char** argv);
+static void Param_HeaderOpSetFlag(int* argc,char** argv);
+static void Param_S19OpSetFlag(int* argc,char** argv);
+static void Param_COpSetFlag(int* argc,char** argv);
+static void Param_SecTabOpSetFlag(int* argc,char** argv);
+static void Param_SymTabOpSetFlag(int* argc,char** argv);
+static void Param_DisplayHelpOpSetFlag(int* argc,char** argv);
+static void Param_SrcListOpSetFlag(int* argc,char** argv);
+static void Param_RelTabOpSetFlag(int* argc,char** argv);
+static void Param_XrefOpSetFlag(int* argc,char** argv);
+static void Param_ArmapOpSetFlag(int* argc,char** argv);
+static void Param_DiffOpSetFlag(int* argc,char** argv);
+static void Param_HashOpSetFlag(int* argc,char** argv);
+static void Param_HashCmpOpSetFlag(int* argc,char** argv);
+static void Param_CrcOpSetFlag(int* argc,char** argv);
+static void Param_BinOpSetFlag(int* argc,char** argv);
+static void Param_PatchOpSetFlag(int* argc,char** argv);
+static void Param_ElfOpSetFlag(int* argc,char** argv);
+static void Param_VarsOpSetFlag(int* argc,char** argv);
+static void Param_VerifyOpSetFlag(int* argc,char** argv);
+static void Param_MergeOpSetFlag(int* argc,char** argv);
+static void Param_StoreOpSetFlag(int* argc,char** argv);
+static void Param_RestoreOpSetFlag(int* argc,char** argv);
+static void Param_GenOpSetFlag(int* argc,char** argv);
+static void Param_BenchOpSetFlag(int* argc,char** argv);
+static void Param_StatsOpSetFlag(int* argc,char** argv);
+static void Param_WatchOpSetFlag(int* argc,char** argv);
+static void Param_MemOpSetFlag(int* argc,char** argv);
+static void Param_MapOpSetFlag(int* argc,char** argv);
+static void Param_A2lOpSetFlag(int* argc,char** argv);
+static void Param_StringsOpSetFlag(int* argc,char** argv);
+static void Param_SigOpSetFlag(int* argc,char** argv);
+
+
+/*******************************************************************************************************************
+** COMMAND LINE OPTIONS DEFINITION : 
+*******************************************************************************************************************/
+START_PARAMETERS
+  DEFINE_PARAM("-header" , Param_HeaderOpSetFlag     ,  "             : Display the ELF file header")
+  DEFINE_PARAM("-sec"    , Param_SecTabOpSetFlag     ,  "             : Display the sections table")
+  DEFINE_PARAM("-sym"    , Param_SymTabOpSetFlag     ,  "             : Display the symbols table")
+  DEFINE_PARAM("-srclist", Param_SrcListOpSetFlag    ,  "             : List all used files in the program")
+  DEFINE_PARAM("-strings", Param_StringsOpSetFlag    ,  "<Spec>       : List the printable strings (min=<n>,enc=ascii|utf16|utf16be|all,sec=<name>[+<name>]|image, - for the defaults)")
+  DEFINE_PARAM("-rel"    , Param_RelTabOpSetFlag     ,  "             : Display the relocation tables")
+  DEFINE_PARAM("-search" , Param_SearchOpSetFlag     ,  "<Symbol>     : Search for the <symbol> information in the ELF file")
+  DEFINE_PARAM("-xref"   , Param_XrefOpSetFlag       ,  "<Symbol>     : List the relocation sections which refer to <symbol>")
+  DEFINE_PARAM("-armap"  , Param_ArmapOpSetFlag      ,  "<Symbol>     : List the archive members which define <symbol>")
+  DEFINE_PARAM("-diff"   , Param_DiffOpSetFlag       ,  "<RefElfFile> : Report the section and symbol changes since <RefElfFile>")
+  DEFINE_PARAM("-hash"   , Param_HashOpSetFlag       ,  "<OutputFile> : Write the hash manifest of the loadable sections")
+  DEFINE_PARAM("-hashcmp", Param_HashCmpOpSetFlag    ,  "<Manifest>   : Compare the loadable sections with the hash <Manifest>")
+  DEFINE_PARAM("-store"  , Param_StoreOpSetFlag      ,  "<StoreDir>   : Archive the ELF file in the deduplicating build store <StoreDir> (as <StoreDir>/<name>-<xxh64>.build)")
+  DEFINE_PARAM("-restore", Param_RestoreOpSetFlag    ,  "<OutputFile> : Rebuild the ELF file of an archived build (input: <StoreDir>/<name>-<xxh64>.build)")
+  DEFINE_PARAM("-merge"  , Param_MergeOpSetFlag      ,  "<Input>      : Merge the load image of <Input> with the input file (<File>[,at=<Address> for a binary][,prio=<n>], higher priority wins an overlap)")
+  DEFINE_PARAM("-patch"  , Param_PatchOpSetFlag      ,  "<Patches>    : Patch symbol values in the loaded file before the exports (<Symbol>=<Value>[,...] or @<ListFile>, values: integer, real, \"text\" or @<File>)")
+  DEFINE_PARAM("-verify" , Param_VerifyOpSetFlag     ,  "<RecordFile> : Compare the load image with an S19 or Intel HEX file (report the differing address ranges)")
+  DEFINE_PARAM("-crc"    , Param_CrcOpSetFlag        ,  "<Model>@<Start>-<End>[,<Start>-<End>][=<Symbol>] : Compute a CRC of the load image and store it in <Symbol>")
+  DEFINE_PARAM("-mem"    , Param_MemOpSetFlag        ,  "<Regions>    : Report the use of the memory regions (<name> <origin> <length> lines, or a GNU ld script MEMORY block)")
+  DEFINE_PARAM("-map"    , Param_MapOpSetFlag        ,  "<Spec>       : Correlate a GNU ld map file with the ELF file (<MapFile>[,by=lib|obj][,sym=<name>|<pattern>[+...]]): size by library, origin of symbols")
+  DEFINE_PARAM("-a2l"    , Param_A2lOpSetFlag        ,  "<Spec>       : Generate the A2L MEASUREMENT/CHARACTERISTIC blocks of variables from the symbols and the DWARF types (meas=|char=<name>|<pattern>|@<ListFile>[+...][,out=<File>]), or update the addresses of an A2L file (upd=<A2lFile>[,out=<File>])")
+  DEFINE_PARAM("-sig"    , Param_SigOpSetFlag        ,  "<Patterns>   : Search the load image for the byte signatures of <Patterns> (<name> <hex bytes> lines, ? for a wildcard nibble)")
+  DEFINE_PARAM("-s19"    , Param_S19OpSetFlag        ,  "<OutputFile> : Extract the binary in s19 format")
+  DEFINE_PARAM("-c"      , Param_COpSetFlag          ,  "<OutputFile> : Extract the binary in C-Array format")
+  DEFINE_PARAM("-bin"    , Param_BinOpSetFlag        ,  "<OutputFile> : Extract the binary as a raw image (gaps filled with 0xFF)")
+  DEFINE_PARAM("-elf"    , Param_ElfOpSetFlag        ,  "<OutputFile> : Write the ELF file with its patched symbols (-patch, -crc)")
+  DEFINE_PARAM("-vars"   , Param_VarsOpSetFlag       ,  "<Spec>       : Extract the initial value of symbols (sym=<name>|<pattern>|@<ListFile>[+...],fmt=hex|bin|json,out=<File>|<Dir>)")
+  DEFINE_PARAM("-gen"    , Param_GenOpSetFlag        ,  "<Spec>       : Generate a synthetic <inElfFile> first (class=32|64,data=lsb|msb,sections=,payload=,symbols=,name=,units=,files=,rows=,seed=)")
+  DEFINE_PARAM("-bench"  , Param_BenchOpSetFlag      ,  "<Report>     : Time every operation on the ELF file and append the results (CSV) to <Report>")
+  DEFINE_PARAM("-stats"  , Param_StatsOpSetFlag      ,  "<OutputFile> : Report the time, CPU, page faults and I/O of each phase (JSON, or text on stderr for -)")
+  DEFINE_PARAM("-watch"  , Param_WatchOpSetFlag      ,  "             : Watch the ELF file and report the changes of each new build (outputs rewritten when their input changed)")
+  DEFINE_PARAM("-h"      , Param_DisplayHelpOpSetFlag,  "             : Display the information")
+END_PARAMETERS
+
+/*******************************************************************************************************************
+** Globals 
+*******************************************************************************************************************/
+
+boolean Flag_HeaderOpSetFlag       = FALSE;
+boolean Flag_SearchOpSetFlag       = FALSE;
+boolean Flag_S19OpSetFlag          = FALSE;
+boolean Flag_COpSetFlag            = FALSE;
+boolean Flag_SecTabOpSetFlag       = FALSE;
+boolean Flag_SymTabOpSetFlag       = FALSE;
+boolean Flag_DisplayHelpOpSetFlag  = FALSE;
+boolean Flag_SrcListOpSetFlag      = FALSE;
+boolean Flag_RelTabOpSetFlag       = FALSE;
+boolean Flag_XrefOpSetFlag         = FALSE;
+boolean Flag_ArmapOpSetFlag        = FALSE;
+boolean Flag_DiffOpSetFlag         = FALSE;
+boolean Flag_HashOpSetFlag         = FALSE;
+boolean Flag_HashCmpOpSetFlag      = FALSE;
+boolean Flag_CrcOpSetFlag          = FALSE;
+boolean Flag_BinOpSetFlag          = FALSE;
+boolean Flag_PatchOpSetFlag        = FALSE;
+boolean Flag_ElfOpSetFlag          = FALSE;
+boolean Flag_VarsOpSetFlag         = FALSE;
+boolean Flag_VerifyOpSetFlag       = FALSE;
+boolean Flag_MergeOpSetFlag        = FALSE;
+boolean Flag_StoreOpSetFlag        = FALSE;
+boolean Flag_RestoreOpSetFlag      = FALSE;
+boolean Flag_GenOpSetFlag          = FALSE;
+boolean Flag_BenchOpSetFlag        = FALSE;
+boolean Flag_StatsOpSetFlag        = FALSE;
+boolean Flag_WatchOpSetFlag        = FALSE;
+boolean Flag_MemOpSetFlag          = FALSE;
+boolean Flag_MapOpSetFlag          = FALSE;
+boolean Flag_A2lOpSetFlag          = FALSE;
+boolean Flag_StringsOpSetFlag      = FALSE;
+boolean Flag_SigOpSetFlag          = FALSE;
+
+boolean boGlobalParamError         = FALSE;
+
+int TotalOptionsNbr = 0; 
+
+extern char* ElfFilePath;
+extern char* S19FilePath;
+extern char* CFilePath  ;
+extern char* SearchTxt;
+extern char* XrefTxt;
+extern char* ArmapTxt;
+extern char* DiffFilePath;
+extern char* HashFilePath;
+extern char* HashCmpFilePath;
+extern char* BinFilePath;
+extern char* StoreDirPath;
+extern char* RestoreFilePath;
+extern char* GenSpecTxt;
+extern char* BenchFilePath;
+extern char* StatsFilePath;
+extern char* MemFilePath;
+extern char* StringsTxt;
+extern char* SigFilePath;
+extern char* CrcRequests[PARAM_MAX_CRC];
+extern uint32 CrcRequestsNbr;
+extern char* PatchRequests[PARAM_MAX_PATCH];
+extern uint32 PatchRequestsNbr;
+extern char* ElfOutFilePath;
+extern char* VarsTxt;
+extern char* VerifyFilePath;
+extern char* MergeInputs[PARAM_MAX_MERGE];
+extern uint32 MergeInputsNbr;
+extern char* MapTxt;
+extern char* A2lTxt;
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_OptionParser(int argc,char** argv)
+{
+#if defined(_WIN32)
+  HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+  CONSOLE_SCREEN_BUFFER_INFO consoleInfo;
+  WORD saved_attributes;
+#endif
+  boolean boOptionNotFound = TRUE;
+
+  TotalOptionsNbr = argc;
+
+#if defined(_WIN32)
+  /* Save current attributes */
+  GetConsoleScreenBufferInfo(hConsole, &consoleInfo);
+  saved_attributes = consoleInfo.wAttributes;
+#endif
+
+    ElfFilePath = (char*)argv[1];
+
+  for(unsigned int option=1; option < (unsigned int)(argc); option++)
+  {
+
+    boOptionNotFound = TRUE;
+
+    for(unsigned int cpt=0; cpt < (sizeof(ParamListAction)/sizeof(ParamList)); cpt++)
+    {
+      if(0 == strcmp((char*)(ParamListAction[cpt].param), argv[option]) && ParamListAction[cpt].action != NULL)
+      {
+        boOptionNotFound = FALSE;
+        ParamListAction[cpt].action((int*)&option, argv);
+      }
+    }
+
+    if((boOptionNotFound && option != 1) || boGlobalParamError)
+    {
+#if defined(_WIN32)
+      SetConsoleTextAttribute(hConsole, FOREGROUND_INTENSITY | FOREGROUND_RED);
+#endif
+      printf("\n SYNTAX ERROR !!! \n");
+
+      DbgPrint("TotalOptionsNbr            = %d \n",TotalOptionsNbr          );
+      DbgPrint("boGlobalParamError         = %d \n",boGlobalParamError       );
+      DbgPrint("boOptionNotFound           = %d \n",boOptionNotFound         );
+      DbgPrint("Flag_S19OpSetFlag          = %d \n",Flag_S19OpSetFlag        );
+      DbgPrint("Flag_COpSetFlag            = %d \n",Flag_COpSetFlag          );
+      DbgPrint("Flag_SecTabOpSetFlag       = %d \n",Flag_SecTabOpSetFlag     );
+      DbgPrint("Flag_SymTabOpSetFlag       = %d \n",Flag_SymTabOpSetFlag     );
+      DbgPrint("Flag_DisplayHelpOpSetFlag  = %d \n",Flag_DisplayHelpOpSetFlag);
+
+      for(uint32 i=0; i < (uint32)TotalOptionsNbr; i++)
+      {
+        DbgPrint("argv[%d] = %s\n",i, argv[i]);
+      }
+
+#if defined(_WIN32)
+      /* Restore original attributes */
+      SetConsoleTextAttribute(hConsole, saved_attributes);
+#endif
+
+      Param_DisplayHelp();
+      return(FALSE);
+    }
+
+  }
+
+  if(TRUE == Flag_DisplayHelpOpSetFlag || boOptionNotFound)
+  {
+    DbgPrint("boGlobalParamError         = %d \n",boGlobalParamError       );
+    DbgPrint("boOptionNotFound           = %d \n",boOptionNotFound         );
+    DbgPrint("Flag_S19OpSetFlag          = %d \n",Flag_S19OpSetFlag        );
+    DbgPrint("Flag_COpSetFlag            = %d \n",Flag_COpSetFlag          );
+    DbgPrint("Flag_SecTabOpSetFlag       = %d \n",Flag_SecTabOpSetFlag     );
+    DbgPrint("Flag_SymTabOpSetFlag       = %d \n",Flag_SymTabOpSetFlag     );
+    DbgPrint("Flag_DisplayHelpOpSetFlag  = %d \n",Flag_DisplayHelpOpSetFlag);
+
+    Param_DisplayHelp();
+    return(FALSE);
+  }
+  else
+  {
+    return(TRUE);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+void Param_DisplayHelp(void)
+{
+  //system("cls");
+  printf("\n ***********************************************************");
+  printf("\n   ELF PARSER TOOL V1.0.19 ( DEVELOPED BY CHALANDI AMINE )  ");
+  printf("\n ***********************************************************");
+  printf("\n\n Usage: ElfParser.exe <inElfFile>|<inArchive>|@<ListFile> [option(s)]\n");
+  printf("\n Options are:\n");
+  for(unsigned int i=0; i < (sizeof(ParamListAction)/sizeof(ParamList)); i++)
+  {
+    printf("\n %-8s %s",ParamListAction[i].param, ParamListAction[i].info);
+  }
+  printf("\n");
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_SrcListOpSetFlag(int* argc,char** argv)
+{ 
+  (void)argc;
+  (void)argv;
+  Flag_SrcListOpSetFlag = TRUE;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_RelTabOpSetFlag(int* argc,char** argv)
+{ 
+  (void)argc;
+  (void)argv;
+  Flag_RelTabOpSetFlag = TRUE;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_XrefOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_XrefOpSetFlag = TRUE;
+    XrefTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_ArmapOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_ArmapOpSetFlag = TRUE;
+    ArmapTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_DiffOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_DiffOpSetFlag = TRUE;
+    DiffFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_HashOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_HashOpSetFlag = TRUE;
+    HashFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_HashCmpOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_HashCmpOpSetFlag = TRUE;
+    HashCmpFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_CrcOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr && CrcRequestsNbr < PARAM_MAX_CRC)
+  {
+    Flag_CrcOpSetFlag = TRUE;
+    CrcRequests[CrcRequestsNbr++] = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_BinOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_BinOpSetFlag = TRUE;
+    BinFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_PatchOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr && PatchRequestsNbr < PARAM_MAX_PATCH)
+  {
+    Flag_PatchOpSetFlag = TRUE;
+    PatchRequests[PatchRequestsNbr++] = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_ElfOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_ElfOpSetFlag = TRUE;
+    ElfOutFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_VarsOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_VarsOpSetFlag = TRUE;
+    VarsTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_VerifyOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_VerifyOpSetFlag = TRUE;
+    VerifyFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_MergeOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr && MergeInputsNbr < PARAM_MAX_MERGE)
+  {
+    Flag_MergeOpSetFlag = TRUE;
+    MergeInputs[MergeInputsNbr++] = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_StoreOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_StoreOpSetFlag = TRUE;
+    StoreDirPath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_RestoreOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_RestoreOpSetFlag = TRUE;
+    RestoreFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_GenOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_GenOpSetFlag = TRUE;
+    GenSpecTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_BenchOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_BenchOpSetFlag = TRUE;
+    BenchFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_StatsOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_StatsOpSetFlag = TRUE;
+    StatsFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_WatchOpSetFlag(int* argc,char** argv)
+{ 
+  (void)argc;
+  (void)argv;
+  Flag_WatchOpSetFlag = TRUE;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_MemOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_MemOpSetFlag = TRUE;
+    MemFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_MapOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_MapOpSetFlag = TRUE;
+    MapTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_A2lOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_A2lOpSetFlag = TRUE;
+    A2lTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_StringsOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_StringsOpSetFlag = TRUE;
+    StringsTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_SigOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_SigOpSetFlag = TRUE;
+    SigFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_HeaderOpSetFlag(int* argc,char** argv)
+{ 
+  (void)argc;
+  (void)argv;
+  Flag_HeaderOpSetFlag = TRUE;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_SearchOpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_SearchOpSetFlag = TRUE;
+    SearchTxt = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_S19OpSetFlag(int* argc,char** argv)
+{ 
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_S19OpSetFlag = TRUE;
+    S19FilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_COpSetFlag(int* argc,char** argv)
+{
+  if((uint32)*argc + 1 < (uint32)TotalOptionsNbr)
+  {
+    Flag_COpSetFlag = TRUE;
+    CFilePath = (char*)argv[++*argc];
+  }
+  else
+  {
+    boGlobalParamError = TRUE;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_SecTabOpSetFlag(int* argc,char** argv)
+{ 
+  (void)argc;
+  (void)argv;
+  Flag_SecTabOpSetFlag = TRUE;
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_SymTabOpSetFlag(int* argc,char** argv)
+{
+  (void)argc;
+  (void)argv;
+  Flag_SymTabOpSetFlag = TRUE; 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+static void Param_DisplayHelpOpSetFlag(int* argc,char** argv)
+{
+  (void)argc;
+  (void)argv;
+  Flag_DisplayHelpOpSetFlag = TRUE; 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetSrcListOpFlag(void)
+{ 
+  return(Flag_SrcListOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetRelTabOpFlag(void)
+{ 
+  return(Flag_RelTabOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetXrefOpFlag(void)
+{ 
+  return(Flag_XrefOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetArmapOpFlag(void)
+{ 
+  return(Flag_ArmapOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetDiffOpFlag(void)
+{ 
+  return(Flag_DiffOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetHashOpFlag(void)
+{ 
+  return(Flag_HashOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetHashCmpOpFlag(void)
+{ 
+  return(Flag_HashCmpOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetCrcOpFlag(void)
+{ 
+  return(Flag_CrcOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetBinOpFlag(void)
+{ 
+  return(Flag_BinOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetPatchOpFlag(void)
+{ 
+  return(Flag_PatchOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetElfOpFlag(void)
+{ 
+  return(Flag_ElfOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetVarsOpFlag(void)
+{ 
+  return(Flag_VarsOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetVerifyOpFlag(void)
+{ 
+  return(Flag_VerifyOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetMergeOpFlag(void)
+{ 
+  return(Flag_MergeOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetStoreOpFlag(void)
+{ 
+  return(Flag_StoreOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetRestoreOpFlag(void)
+{ 
+  return(Flag_RestoreOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetGenOpFlag(void)
+{ 
+  return(Flag_GenOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetBenchOpFlag(void)
+{ 
+  return(Flag_BenchOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetStatsOpFlag(void)
+{ 
+  return(Flag_StatsOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetWatchOpFlag(void)
+{ 
+  return(Flag_WatchOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetMemOpFlag(void)
+{ 
+  return(Flag_MemOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetMapOpFlag(void)
+{ 
+  return(Flag_MapOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetA2lOpFlag(void)
+{ 
+  return(Flag_A2lOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetStringsOpFlag(void)
+{ 
+  return(Flag_StringsOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetSigOpFlag(void)
+{ 
+  return(Flag_SigOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetHeaderOpFlag(void)
+{ 
+  return(Flag_HeaderOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetSearchOpFlag(void)
+{ 
+  return(Flag_SearchOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetS19OpFlag(void)
+{ 
+  return(Flag_S19OpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetCOpFlag(void)
+{
+  return(Flag_COpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetSecTabOpFlag(void)
+{ 
+  return(Flag_SecTabOpSetFlag);
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetSymTabOpFlag(void)
+{ 
+  return(Flag_SymTabOpSetFlag); 
+}
+
+/*******************************************************************************************************************
+** Function:    
+** Description: 
+** Parameter:   
+** Return:      
+*******************************************************************************************************************/
+boolean Param_GetDisplayHelpOpFlag(void)
+{ 
+  return(Flag_DisplayHelpOpSetFlag); 
+}
@@ -1,37 +1,65 @@
-///////////////////////////////////////////////////////////////////////////////
-//  Copyright Amine Chalandi 2019 - 2020.
-//  Distributed under the Boost Software License,
-//  Version 1.0. (See accompanying file LICENSE_1_0.txt
-//  or copy at http://www.boost.org/LICENSE_1_0.txt)
-//
-
-#ifndef __PARAM_H__
-#define __PARAM_H__
-
-#include<common.h>
-
-typedef void (*ParamFunc)(int* argc,char** argv);
-
-typedef struct
-{
-  const char* param;
-  ParamFunc action;
-  const char* info;
-}ParamList;
-
-extern const ParamList ParamListAction[];
-
-
-boolean Param_OptionParser(int argc,char** argv);
-void Param_DisplayHelp(void);
-
-boolean Param_GetSearchOpFlag(void);
-boolean Param_GetS19OpFlag(void);
-boolean Param_GetCOpFlag(void);
-boolean Param_GetSecTabOpFlag(void);
-boolean Param_GetSymTabOpFlag(void);
-boolean Param_GetDisplayHelpOpFlag(void);
-boolean Param_GetHeaderOpFlag(void);
-boolean Param_GetSrcListOpFlag(void);
-
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __PARAM_H__
+#define __PARAM_H__
+
+#include<common.h>
+
+#define PARAM_MAX_CRC    16U   //-crc requests per run
+#define PARAM_MAX_PATCH  16U   //-patch lists per run
+#define PARAM_MAX_MERGE  16U   //-merge inputs per run
+
+typedef void (*ParamFunc)(int* argc,char** argv);
+
+typedef struct
+{
+  const char* param;
+  ParamFunc action;
+  const char* info;
+}ParamList;
+
+extern const ParamList ParamListAction[];
+
+
+boolean Param_OptionParser(int argc,char** argv);
+void Param_DisplayHelp(void);
+
+boolean Param_GetSearchOpFlag(void);
+boolean Param_GetS19OpFlag(void);
+boolean Param_GetCOpFlag(void);
+boolean Param_GetSecTabOpFlag(void);
+boolean Param_GetSymTabOpFlag(void);
+boolean Param_GetDisplayHelpOpFlag(void);
+boolean Param_GetHeaderOpFlag(void);
+boolean Param_GetSrcListOpFlag(void);
+boolean Param_GetRelTabOpFlag(void);
+boolean Param_GetXrefOpFlag(void);
+boolean Param_GetArmapOpFlag(void);
+boolean Param_GetDiffOpFlag(void);
+boolean Param_GetHashOpFlag(void);
+boolean Param_GetHashCmpOpFlag(void);
+boolean Param_GetCrcOpFlag(void);
+boolean Param_GetBinOpFlag(void);
+boolean Param_GetStoreOpFlag(void);
+boolean Param_GetRestoreOpFlag(void);
+boolean Param_GetGenOpFlag(void);
+boolean Param_GetBenchOpFlag(void);
+boolean Param_GetStatsOpFlag(void);
+boolean Param_GetWatchOpFlag(void);
+boolean Param_GetMemOpFlag(void);
+boolean Param_GetMapOpFlag(void);
+boolean Param_GetA2lOpFlag(void);
+boolean Param_GetStringsOpFlag(void);
+boolean Param_GetSigOpFlag(void);
+boolean Param_GetPatchOpFlag(void);
+boolean Param_GetElfOpFlag(void);
+boolean Param_GetVarsOpFlag(void);
+boolean Param_GetVerifyOpFlag(void);
+boolean Param_GetMergeOpFlag(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,556 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Batched patching of symbol values (-patch).
+**
+** Each request is a list of "<symbol>=<value>" entries separated by commas, or "@<file>" for a file holding one
+** entry per line ('#' starts a comment line). A value is an integer (C syntax, negative allowed), a floating point
+** number (4 or 8 byte symbols), a "quoted text" (zero padded to the symbol size) or "@<file>" whose raw content is
+** copied to the start of the symbol. The symbols are resolved in one pass over the symbol table, then every entry is
+** checked (size, overlap) before the first byte is written: a run patches all the entries or none. The patches are
+** written in the loaded file, so the exports run afterwards (-crc, -c, -s19, -bin, -elf) contain them.
+*******************************************************************************************************************/
+
+#include<Patch.h>
+#include<io.h>
+#include<ctype.h>
+#include<errno.h>
+
+//one entry "<symbol>=<value>"
+typedef struct
+{
+  char*             name;
+  char*             value;            //value as given
+  const sElfSymbol* symbol;           //patched symbol (NULL: not found)
+  uint32            matches;          //symbols of the same name and binding rank as symbol
+  char*             target;           //first byte of the symbol in the loaded file
+  const uint8*      bytes;            //bytes written, in the byte order of the target
+  uint32            length;
+  uint8             word[8];          //storage of a numeric value
+  char*             file;             //content of an @<file> value (freed after the run)
+}sPatchEntry;
+
+//entries of all the requests of a run
+typedef struct
+{
+  sPatchEntry* entries;
+  uint32       count;
+  char**       lists;                 //contents of the @<file> lists (freed after the run)
+  uint32       ListsNbr;
+}sPatchBatch;
+
+static boolean Patch_AddEntry(sPatchBatch* batch, char* text);
+static boolean Patch_Split(sPatchBatch* batch, char* list, char separator);
+static int     Patch_CompareNames(const void* a, const void* b);
+static int     Patch_CompareKey(const void* key, const void* entry);
+static int     Patch_CompareTargets(const void* a, const void* b);
+static char*   Patch_Locate(sElf* elf, const sElfSymbol* symbol, const sElfSegment* segments, uint32 SegNbr);
+static boolean Patch_Resolve(sElf* elf, sPatchBatch* batch);
+static boolean Patch_Encode(sPatchEntry* entry, boolean msb);
+static void    Patch_Release(sPatchBatch* batch);
+
+/*******************************************************************************************************************
+** Function:    Patch_AddEntry
+** Description: add the entry "<symbol>=<value>" (blanks around the name and the value are ignored)
+** Parameter:   sPatchBatch* batch, char* text (modified)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Patch_AddEntry(sPatchBatch* batch, char* text)
+{
+  char*        value = strchr(text, '=');
+  char*        end   = NULL;
+  sPatchEntry* entry = NULL;
+
+  if(batch->count == PATCH_MAX_ENTRIES)
+  {
+    printf("\n\r error: Too many patches (%u max) !\n\r", PATCH_MAX_ENTRIES);
+    return(FALSE);
+  }
+
+  if(value == NULL)
+  {
+    printf("\n\r error: Bad patch '%s' (<symbol>=<value>|\"<text>\"|@<file>) !\n\r", text);
+    return(FALSE);
+  }
+
+  *value++ = '\0';
+
+  while(isspace((unsigned char)*text))  { text++; }
+  while(isspace((unsigned char)*value)) { value++; }
+
+  for(end = text + strlen(text); end > text && isspace((unsigned char)end[-1]); end--) { }
+  *end = '\0';
+  for(end = value + strlen(value); end > value && isspace((unsigned char)end[-1]); end--) { }
+  *end = '\0';
+
+  if(text[0] == '\0' || value[0] == '\0')
+  {
+    printf("\n\r error: Bad patch '%s=%s' (<symbol>=<value>|\"<text>\"|@<file>) !\n\r", text, value);
+    return(FALSE);
+  }
+
+  entry = &batch->entries[batch->count++];
+  memset(entry, 0, sizeof(sPatchEntry));
+  entry->name  = text;
+  entry->value = value;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Split
+** Description: add the entries of a list. The separators inside a quoted text do not split the list, the lines
+**              of a list file (separator '\n') starting with '#' are comments.
+** Parameter:   sPatchBatch* batch, char* list (modified), char separator
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Patch_Split(sPatchBatch* batch, char* list, char separator)
+{
+  char*   item   = list;
+  boolean quoted = FALSE;
+
+  for(char* p = list; ; p++)
+  {
+    if(*p == '"')
+    {
+      quoted = (boolean)!quoted;
+    }
+    else if(*p == '\0' || (*p == separator && !quoted) || *p == '\n')
+    {
+      boolean last = (boolean)(*p == '\0');
+      char*   text = item;
+
+      *p   = '\0';
+      item = p + 1;
+      text[strcspn(text, "\r")] = '\0';
+
+      while(isspace((unsigned char)*text)) { text++; }
+
+      if(text[0] != '\0' && !(separator == '\n' && text[0] == '#') && !Patch_AddEntry(batch, text))
+      {
+        return(FALSE);
+      }
+
+      quoted = FALSE;
+      if(last)
+      {
+        break;
+      }
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_CompareNames
+** Description: qsort callback: entries by symbol name
+** Parameter:   const void* a, const void* b (sPatchEntry*)
+** Return:      int
+*******************************************************************************************************************/
+static int Patch_CompareNames(const void* a, const void* b)
+{
+  return(strcmp(((const sPatchEntry*)a)->name, ((const sPatchEntry*)b)->name));
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_CompareKey
+** Description: bsearch callback: symbol name against an entry
+** Parameter:   const void* key (const char*), const void* entry (sPatchEntry*)
+** Return:      int
+*******************************************************************************************************************/
+static int Patch_CompareKey(const void* key, const void* entry)
+{
+  return(strcmp((const char*)key, ((const sPatchEntry*)entry)->name));
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_CompareTargets
+** Description: qsort callback: entries by position in the file
+** Parameter:   const void* a, const void* b (sPatchEntry*)
+** Return:      int
+*******************************************************************************************************************/
+static int Patch_CompareTargets(const void* a, const void* b)
+{
+  const char* ta = ((const sPatchEntry*)a)->target;
+  const char* tb = ((const sPatchEntry*)b)->target;
+
+  return((ta < tb) ? -1 : ((ta > tb) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Locate
+** Description: content of a symbol in the loaded file: in its section, else in the loadable segment holding its
+**              address range (absolute symbols, files without section headers for the symbol)
+** Parameter:   sElf* elf, const sElfSymbol* symbol, const sElfSegment* segments, uint32 SegNbr
+** Return:      char* (NULL if the symbol has no content in the file)
+*******************************************************************************************************************/
+static char* Patch_Locate(sElf* elf, const sElfSymbol* symbol, const sElfSegment* segments, uint32 SegNbr)
+{
+  if(symbol->data != NULL)
+  {
+    return(symbol->data);
+  }
+
+  for(uint32 i = 0; i < SegNbr; i++)
+  {
+    const sElfSegment* segment = &segments[i];
+
+    if(segment->type == PT_LOAD && symbol->value >= segment->vaddr &&
+       symbol->value - segment->vaddr <= segment->filesz &&
+       symbol->size <= segment->filesz - (symbol->value - segment->vaddr) &&
+       segment->offset <= elf->size && segment->filesz <= elf->size - segment->offset)
+    {
+      return(elf->Buffer + (size_t)(segment->offset + (symbol->value - segment->vaddr)));
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Resolve
+** Description: find the symbol of every entry in one pass over the symbol table. A global or weak definition is
+**              preferred to local ones, a name defined more than once at the same rank is ambiguous.
+** Parameter:   sElf* elf, sPatchBatch* batch (entries sorted by name)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Patch_Resolve(sElf* elf, sPatchBatch* batch)
+{
+  sElfSymbol*  symbols  = NULL;
+  sElfSegment* segments = NULL;
+  uint32       SymNbr   = 0;
+  uint32       SegNbr   = 0;
+  boolean      result   = TRUE;
+
+  if(!Elf_GetSymbols(elf, &symbols, &SymNbr))
+  {
+    printf("\n\r error: No symbol table to resolve the patches !\n\r");
+    return(FALSE);
+  }
+
+  if(!Elf_GetSegments(elf, &segments, &SegNbr))
+  {
+    SegNbr = 0;
+  }
+
+  for(uint32 i = 0; i < SymNbr; i++)
+  {
+    const sElfSymbol* symbol = &symbols[i];
+    uint32            type   = ELF32_ST_TYPE(symbol->info);
+    sPatchEntry*      entry  = NULL;
+
+    if(symbol->shndx == 0 || type == STT_SECTIONS || type == STT_FILE || symbol->name[0] == '\0')
+    {
+      continue;
+    }
+
+    entry = (sPatchEntry*)bsearch(symbol->name, batch->entries, batch->count, sizeof(sPatchEntry),
+                                  Patch_CompareKey);
+
+    if(entry != NULL)
+    {
+      boolean local = (boolean)(ELF32_ST_BIND(symbol->info) == STB_LOCAL);
+
+      if(entry->symbol == NULL || (!local && ELF32_ST_BIND(entry->symbol->info) == STB_LOCAL))
+      {
+        entry->symbol  = symbol;
+        entry->matches = 1;
+      }
+      else if(local == (boolean)(ELF32_ST_BIND(entry->symbol->info) == STB_LOCAL))
+      {
+        entry->matches++;
+      }
+    }
+  }
+
+  for(uint32 i = 0; i < batch->count; i++)
+  {
+    sPatchEntry* entry = &batch->entries[i];
+
+    if(entry->symbol == NULL)
+    {
+      printf("\n\r error: No symbol '%s' to patch !\n\r", entry->name);
+      result = FALSE;
+    }
+    else if(entry->matches > 1)
+    {
+      printf("\n\r error: The symbol '%s' to patch is defined %u times !\n\r", entry->name, entry->matches);
+      result = FALSE;
+    }
+    else
+    {
+      entry->target = Patch_Locate(elf, entry->symbol, segments, SegNbr);
+
+      if(entry->target == NULL)
+      {
+        printf("\n\r error: The symbol '%s' has no content in the file (uninitialized data) !\n\r", entry->name);
+        result = FALSE;
+      }
+    }
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Encode
+** Description: convert the value of an entry into the bytes written, checked against the symbol size
+** Parameter:   sPatchEntry* entry, boolean msb (big endian target)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Patch_Encode(sPatchEntry* entry, boolean msb)
+{
+  uint64 size  = entry->symbol->size;
+  char*  value = entry->value;
+  char*  end   = NULL;
+  uint64 bits  = 0;
+
+  if(size == 0)
+  {
+    printf("\n\r error: The symbol '%s' has no size, it cannot be patched !\n\r", entry->name);
+    return(FALSE);
+  }
+
+  if(value[0] == '@')
+  {
+    uint32 length = 0;
+
+    entry->file = (char*)LoadInputFile(&value[1], &length);
+
+    if(entry->file == NULL)
+    {
+      return(FALSE);
+    }
+
+    if((uint64)length > size)
+    {
+      printf("\n\r error: '%s' (%u bytes) does not fit in the %llu byte(s) of '%s' !\n\r", &value[1],
+             (unsigned int)length, (unsigned long long)size, entry->name);
+      return(FALSE);
+    }
+
+    entry->bytes  = (const uint8*)entry->file;
+    entry->length = length;
+    return(TRUE);
+  }
+
+  if(value[0] == '"')
+  {
+    size_t length = strlen(value);
+
+    if(length < 2 || value[length - 1] != '"' || (uint64)(length - 2) > size)
+    {
+      printf("\n\r error: Bad text %s for the %llu byte(s) of '%s' !\n\r", value, (unsigned long long)size,
+             entry->name);
+      return(FALSE);
+    }
+
+    /* the text is written with its zero padding, the closing quote becomes the first padding byte */
+    entry->file = (char*)calloc((size_t)size, sizeof(char));
+
+    if(entry->file == NULL)
+    {
+      printf("\n\r error: Out of memory !\n\r");
+      return(FALSE);
+    }
+
+    memcpy(entry->file, &value[1], length - 2);
+    entry->bytes  = (const uint8*)entry->file;
+    entry->length = (uint32)size;
+    return(TRUE);
+  }
+
+  errno = 0;
+
+  if(strncmp(value, "0x", 2) != 0 && strncmp(value, "0X", 2) != 0 && strpbrk(value, ".eE") != NULL)
+  {
+    double real = strtod(value, &end);
+
+    if(size == 4)
+    {
+      float  single = (float)real;
+      uint32 word   = 0;
+
+      memcpy(&word, &single, sizeof(word));
+      bits = word;
+    }
+    else if(size == 8)
+    {
+      memcpy(&bits, &real, sizeof(bits));
+    }
+    else
+    {
+      end = NULL;
+    }
+  }
+  else if(value[0] == '-')
+  {
+    long long number = strtoll(value, &end, 0);
+
+    bits = (uint64)number;
+    if(size > 8 || (size < 8 && number < -(long long)(1ULL << (8U * size - 1U))))
+    {
+      end = NULL;
+    }
+  }
+  else
+  {
+    unsigned long long number = strtoull(value, &end, 0);
+
+    bits = (uint64)number;
+    if(size > 8 || (size < 8 && (number >> (8U * size)) != 0))
+    {
+      end = NULL;
+    }
+  }
+
+  if(end != NULL && (*end != '\0' || end == value))
+  {
+    printf("\n\r error: Bad value '%s' for '%s' !\n\r", value, entry->name);
+    return(FALSE);
+  }
+
+  if(end == NULL || errno == ERANGE)
+  {
+    printf("\n\r error: The value '%s' does not fit in the %llu byte(s) of '%s' !\n\r", value,
+           (unsigned long long)size, entry->name);
+    return(FALSE);
+  }
+
+  for(uint32 b = 0; b < (uint32)size; b++)
+  {
+    entry->word[b] = (uint8)(bits >> (8U * (msb ? ((uint32)size - 1U - b) : b)));
+  }
+
+  entry->bytes  = entry->word;
+  entry->length = (uint32)size;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Release
+** Description: free the file contents loaded for a run
+** Parameter:   sPatchBatch* batch
+** Return:      void
+*******************************************************************************************************************/
+static void Patch_Release(sPatchBatch* batch)
+{
+  for(uint32 i = 0; i < batch->count; i++)
+  {
+    free(batch->entries[i].file);
+  }
+
+  for(uint32 i = 0; i < batch->ListsNbr; i++)
+  {
+    free(batch->lists[i]);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Patch_Apply
+** Description: patch the symbols of all the requests ("<symbol>=<value>[,...]" or "@<file>") in the loaded file.
+**              Nothing is written if one of the entries cannot be applied.
+** Parameter:   sElf* elf, char** requests, uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Patch_Apply(sElf* elf, char** requests, uint32 count)
+{
+  sArena*     scratch = Arena_Thread();
+  sArenaMark  mark    = Arena_Mark(scratch);
+  boolean     msb     = Elf_IsBigEndian(elf);
+  boolean     result  = TRUE;
+  uint32      written = 0;
+  sPatchBatch batch;
+
+  memset(&batch, 0, sizeof(batch));
+  batch.entries = (sPatchEntry*)Arena_Alloc(scratch, PATCH_MAX_ENTRIES * sizeof(sPatchEntry));
+  batch.lists   = (char**)Arena_Calloc(scratch, (size_t)count + 1, sizeof(char*));
+
+  if(batch.entries == NULL || batch.lists == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Arena_Rewind(scratch, mark);
+    return(FALSE);
+  }
+
+  /* the requests are split in copies, they are applied again to each image of the run */
+  for(uint32 i = 0; i < count && result; i++)
+  {
+    char* list = NULL;
+
+    if(requests[i][0] == '@')
+    {
+      list = (char*)LoadInputFile(&requests[i][1], NULL);
+      batch.lists[batch.ListsNbr++] = list;
+      result = (boolean)(list != NULL && Patch_Split(&batch, list, '\n'));
+    }
+    else
+    {
+      list = (char*)Arena_Alloc(scratch, strlen(requests[i]) + 1);
+      result = (boolean)(list != NULL && Patch_Split(&batch, strcpy(list, requests[i]), ','));
+    }
+  }
+
+  if(result)
+  {
+    qsort(batch.entries, batch.count, sizeof(sPatchEntry), Patch_CompareNames);
+
+    for(uint32 i = 1; i < batch.count; i++)
+    {
+      if(0 == strcmp(batch.entries[i - 1].name, batch.entries[i].name))
+      {
+        printf("\n\r error: The symbol '%s' is patched twice !\n\r", batch.entries[i].name);
+        result = FALSE;
+      }
+    }
+  }
+
+  result = (boolean)(result && Patch_Resolve(elf, &batch));
+
+  if(result)
+  {
+    qsort(batch.entries, batch.count, sizeof(sPatchEntry), Patch_CompareTargets);
+
+    for(uint32 i = 1; i < batch.count; i++)
+    {
+      const sPatchEntry* prev = &batch.entries[i - 1];
+
+      if(prev->target + prev->symbol->size > batch.entries[i].target)
+      {
+        printf("\n\r error: The patched symbols '%s' and '%s' overlap !\n\r", prev->name, batch.entries[i].name);
+        result = FALSE;
+      }
+    }
+  }
+
+  /* encoded once the entries are in place, a numeric value points to the storage of its entry */
+  for(uint32 i = 0; i < batch.count && result; i++)
+  {
+    result = Patch_Encode(&batch.entries[i], msb);
+  }
+
+  if(result)
+  {
+    for(uint32 i = 0; i < batch.count; i++)
+    {
+      const sPatchEntry* entry = &batch.entries[i];
+
+      memcpy(entry->target, entry->bytes, entry->length);
+      written += entry->length;
+
+      printf("\n\r PATCH %s 0x%llx %u/%llu byte(s) = %s", entry->name, (unsigned long long)entry->symbol->value,
+             (unsigned int)entry->length, (unsigned long long)entry->symbol->size, entry->value);
+    }
+    printf("\n\r %u symbol(s) patched, %u byte(s) written\n\r", batch.count, written);
+  }
+  else
+  {
+    printf("\n\r error: No patch applied !\n\r");
+  }
+
+  Patch_Release(&batch);
+  Arena_Rewind(scratch, mark);
+  return(result);
+}
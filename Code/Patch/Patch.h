@@ -0,0 +1,18 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __PATCH_H__
+#define __PATCH_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define PATCH_MAX_ENTRIES  4096U      //patches of one run (all the -patch lists)
+
+boolean Patch_Apply(sElf* elf, char** requests, uint32 count);
+
+#endif
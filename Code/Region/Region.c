@@ -0,0 +1,953 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Region.h>
+#include<io.h>
+#include<ctype.h>
+
+//one address range occupied by the image: an ALLOC section at its run address, or the load copy of an
+//initialized section whose load address differs from its run address
+typedef struct
+{
+  uint64      start;
+  uint64      end;
+  const char* name;
+  boolean     load;
+}sRegionItem;
+
+//cursor of the memory map parser
+typedef struct
+{
+  const char* p;
+  sRegionMap* map;
+}sRegionParser;
+
+//one interval tree query of the address order sweep
+typedef struct
+{
+  sRegionMap* map;
+  uint64      start;
+  uint64      end;
+  boolean     account;                //add the range to the use of the regions (sections only)
+  uint32      inside;                 //region containing the whole range (REGION_NONE if none)
+  uint32      touched;                //a region overlapping the range (REGION_NONE if none)
+}sRegionVisit;
+
+static boolean Region_ParseScript(sRegionParser* parser, const char* memory);
+static boolean Region_ParseList(sRegionParser* parser);
+static const char* Region_FindMemory(const char* text);
+static void    Region_SkipBlanks(sRegionParser* parser);
+static boolean Region_Expect(sRegionParser* parser, char c);
+static boolean Region_ParseName(sRegionParser* parser, char* name);
+static boolean Region_ParseKeyword(sRegionParser* parser, const char* const* keywords);
+static boolean Region_ParseExpr(sRegionParser* parser, uint64* value);
+static boolean Region_ParseProduct(sRegionParser* parser, uint64* value);
+static boolean Region_ParseTerm(sRegionParser* parser, uint64* value);
+static boolean Region_Add(sRegionMap* map, const char* name, uint64 origin, uint64 length);
+static uint32  Region_Find(const sRegionMap* map, const char* name);
+static int     Region_CompareOrigin(const void* a, const void* b);
+static int     Region_CompareItems(const void* a, const void* b);
+static uint64  Region_BuildTree(sRegionMap* map, uint32 lo, uint32 hi);
+static void    Region_Query(sRegionVisit* visit, uint32 lo, uint32 hi);
+static void    Region_Visit(sRegionVisit* visit, uint32 index);
+static uint32  Region_CollectItems(sElf* elf, sArena* arena, sRegionItem** items);
+static uint32  Region_CheckRange(sRegionMap* map, uint64 start, uint64 end, boolean account, const char* kind,
+                                 const char* name);
+static void    Region_PrintTable(const sRegionMap* map);
+
+static const char* const RegionOriginKeywords[] = {"ORIGIN", "org", "o", NULL};
+static const char* const RegionLengthKeywords[] = {"LENGTH", "len", "l", NULL};
+
+/*******************************************************************************************************************
+** Function:    Region_Parse
+** Description: read the memory regions of a description text: the MEMORY block of a GNU ld script, or else one
+**              region per line "<name> <origin> <length>" ('#' starts a comment line). Origins and lengths are
+**              ld expressions: numbers with an optional K/M/G suffix, ORIGIN(<region>), LENGTH(<region>),
+**              + - * and parentheses. The regions are taken from the arena and sorted into an interval tree.
+** Parameter:   sRegionMap* map, sArena* arena, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Region_Parse(sRegionMap* map, sArena* arena, const char* text)
+{
+  sRegionParser parser;
+  const char*   memory = Region_FindMemory(text);
+  boolean       result = FALSE;
+
+  memset(map, 0, sizeof(sRegionMap));
+  map->regions = (sRegion*)Arena_Calloc(arena, REGION_MAX_REGIONS, sizeof(sRegion));
+  map->MaxEnd  = (uint64*)Arena_Calloc(arena, REGION_MAX_REGIONS, sizeof(uint64));
+
+  if(map->regions == NULL || map->MaxEnd == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  parser.p   = text;
+  parser.map = map;
+  result     = (memory != NULL) ? Region_ParseScript(&parser, memory) : Region_ParseList(&parser);
+
+  if(!result)
+  {
+    printf("\n\r error: Bad memory region description near '%.32s' !\n\r", parser.p);
+    return(FALSE);
+  }
+
+  if(map->count == 0)
+  {
+    printf("\n\r error: No memory region found !\n\r");
+    return(FALSE);
+  }
+
+  qsort(map->regions, map->count, sizeof(sRegion), Region_CompareOrigin);
+  Region_BuildTree(map, 0, map->count);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Report
+** Description: map every ALLOC section (at its run address, and at its load address when the segments place its
+**              content elsewhere) and every PT_LOAD segment onto the memory regions of the description file,
+**              then print the used and free bytes, the free blocks and the fragmentation of each region.
+**              A range outside of every region, crossing a region end, or overlapping another section is an
+**              error, as well as two overlapping regions.
+** Parameter:   sElf* elf, char* path (region description file)
+** Return:      boolean (FALSE on error)
+*******************************************************************************************************************/
+boolean Region_Report(sElf* elf, char* path)
+{
+  sArena*      scratch  = Arena_Thread();
+  sArenaMark   mark     = Arena_Mark(scratch);
+  char*        text     = (char*)LoadInputFile(path, NULL);
+  sRegionMap   map;
+  sRegionItem* items    = NULL;
+  sElfSegment* segments = NULL;
+  uint32       SegNbr   = 0;
+  uint32       count    = 0;
+  uint32       errors   = 0;
+  uint64       SweepEnd = 0;
+  const char*  holder   = NULL;
+
+  if(text == NULL)
+  {
+    return(FALSE);
+  }
+
+  if(!Region_Parse(&map, scratch, text))
+  {
+    Arena_Rewind(scratch, mark);
+    free(text);
+    return(FALSE);
+  }
+
+  printf("\nMEMORY REGIONS : %s\n", path);
+
+  if(((Elf32_Ehdr*)elf->header)->e_type == TYP_RELOCATABLE_ELF)
+  {
+    printf("\n\r error: The memory regions are checked on a linked image, not on an object file !\n\r");
+    Arena_Rewind(scratch, mark);
+    free(text);
+    return(FALSE);
+  }
+
+  for(uint32 i = 1, last = 0; i < map.count; i++)
+  {
+    if(map.regions[i].origin < map.regions[last].end)
+    {
+      printf("\n\r error: The regions '%s' and '%s' overlap !\n\r", map.regions[last].name, map.regions[i].name);
+      errors++;
+    }
+
+    last = (map.regions[i].end > map.regions[last].end) ? i : last;
+  }
+
+  /* sections and load copies in address order: the use of each region is swept once */
+  count = Region_CollectItems(elf, scratch, &items);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    if(holder != NULL && items[i].start < SweepEnd)
+    {
+      printf("\n\r error: The section '%s'%s (0x%llx-0x%llx) overlaps the section '%s' !\n\r", items[i].name,
+             items[i].load ? " load copy" : "", (unsigned long long)items[i].start,
+             (unsigned long long)(items[i].end - 1), holder);
+      errors++;
+    }
+
+    if(holder == NULL || items[i].end > SweepEnd)
+    {
+      SweepEnd = items[i].end;
+      holder   = items[i].name;
+    }
+
+    errors += Region_CheckRange(&map, items[i].start, items[i].end, TRUE,
+                                items[i].load ? "The load copy of the section" : "The section", items[i].name);
+  }
+
+  /* segments: run range (memory size) and load range (file size) */
+  if(Elf_GetSegments(elf, &segments, &SegNbr))
+  {
+    for(uint32 i = 0; i < SegNbr; i++)
+    {
+      char name[16];
+
+      if(segments[i].type != PT_LOAD)
+      {
+        continue;
+      }
+
+      snprintf(name, sizeof(name), "%u", i);
+
+      if(segments[i].memsz > 0)
+      {
+        errors += Region_CheckRange(&map, segments[i].vaddr, segments[i].vaddr + segments[i].memsz, FALSE,
+                                    "The segment", name);
+      }
+
+      if(segments[i].filesz > 0 && segments[i].paddr != segments[i].vaddr)
+      {
+        errors += Region_CheckRange(&map, segments[i].paddr, segments[i].paddr + segments[i].filesz, FALSE,
+                                    "The load range of the segment", name);
+      }
+    }
+  }
+
+  /* free space after the last section of each region */
+  for(uint32 i = 0; i < map.count; i++)
+  {
+    sRegion* region = &map.regions[i];
+
+    if(region->end > region->cursor)
+    {
+      uint64 hole = region->end - region->cursor;
+
+      region->FreeBlocks++;
+      region->LargestFree = (hole > region->LargestFree) ? hole : region->LargestFree;
+    }
+  }
+
+  Region_PrintTable(&map);
+  printf("\n%u section range(s) mapped, %u error(s)\n", count, errors);
+
+  Arena_Rewind(scratch, mark);
+  free(text);
+  return((boolean)(errors == 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Region_FindMemory
+** Description: find the MEMORY command of a linker script (the keyword followed by a '{')
+** Parameter:   const char* text
+** Return:      const char* (the '{' of the block, NULL if the text is not a linker script)
+*******************************************************************************************************************/
+static const char* Region_FindMemory(const char* text)
+{
+  for(const char* p = strstr(text, "MEMORY"); p != NULL; p = strstr(p + 6, "MEMORY"))
+  {
+    const char* q = p + 6;
+
+    if(p > text && (isalnum((unsigned char)p[-1]) || p[-1] == '_'))
+    {
+      continue;
+    }
+
+    while(*q == ' ' || *q == '\t' || *q == '\r' || *q == '\n')
+    {
+      q++;
+    }
+
+    if(*q == '{')
+    {
+      return(q);
+    }
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseScript
+** Description: parse the entries "<name> [(<attr>)] : ORIGIN = <expr>, LENGTH = <expr>" of a MEMORY block
+** Parameter:   sRegionParser* parser, const char* memory (the '{' of the block)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseScript(sRegionParser* parser, const char* memory)
+{
+  parser->p = memory + 1;
+
+  for(;;)
+  {
+    char   name[REGION_NAME_LEN];
+    uint64 origin = 0;
+    uint64 length = 0;
+
+    Region_SkipBlanks(parser);
+
+    if(*parser->p == '}')
+    {
+      return(TRUE);
+    }
+
+    if(!Region_ParseName(parser, name))
+    {
+      return(FALSE);
+    }
+
+    Region_SkipBlanks(parser);
+
+    /* access attributes */
+    if(*parser->p == '(')
+    {
+      while(*parser->p != ')' && *parser->p != '\0')
+      {
+        parser->p++;
+      }
+      if(!Region_Expect(parser, ')'))
+      {
+        return(FALSE);
+      }
+      Region_SkipBlanks(parser);
+    }
+
+    if(!Region_Expect(parser, ':') || !Region_ParseKeyword(parser, RegionOriginKeywords) || !Region_ParseExpr(parser, &origin))
+    {
+      return(FALSE);
+    }
+
+    Region_SkipBlanks(parser);
+    if(*parser->p == ',')
+    {
+      parser->p++;
+    }
+
+    if(!Region_ParseKeyword(parser, RegionLengthKeywords) || !Region_ParseExpr(parser, &length) ||
+       !Region_Add(parser->map, name, origin, length))
+    {
+      return(FALSE);
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseList
+** Description: parse the lines "<name> <origin> <length>" of a region description
+** Parameter:   sRegionParser* parser
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseList(sRegionParser* parser)
+{
+  for(;;)
+  {
+    char   name[REGION_NAME_LEN];
+    uint64 origin = 0;
+    uint64 length = 0;
+
+    Region_SkipBlanks(parser);
+
+    if(*parser->p == '#')
+    {
+      parser->p += strcspn(parser->p, "\n");
+      continue;
+    }
+
+    if(*parser->p == '\0')
+    {
+      return(TRUE);
+    }
+
+    if(!Region_ParseName(parser, name) || !Region_ParseExpr(parser, &origin) || !Region_ParseExpr(parser, &length) ||
+       !Region_Add(parser->map, name, origin, length))
+    {
+      return(FALSE);
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_SkipBlanks
+** Description: skip the white spaces, the line ends and the C comments
+** Parameter:   sRegionParser* parser
+** Return:      void
+*******************************************************************************************************************/
+static void Region_SkipBlanks(sRegionParser* parser)
+{
+  for(;;)
+  {
+    const char* p = parser->p;
+
+    while(*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+    {
+      p++;
+    }
+
+    if(p[0] == '/' && p[1] == '*')
+    {
+      const char* end = strstr(p + 2, "*/");
+
+      p = (end != NULL) ? end + 2 : p + strlen(p);
+    }
+
+    if(p == parser->p)
+    {
+      return;
+    }
+    parser->p = p;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Expect
+** Description: step over the character c if it is the next one (the end of the text is never stepped over)
+** Parameter:   sRegionParser* parser, char c
+** Return:      boolean (FALSE if the next character is not c)
+*******************************************************************************************************************/
+static boolean Region_Expect(sRegionParser* parser, char c)
+{
+  if(*parser->p != c)
+  {
+    return(FALSE);
+  }
+  parser->p++;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseName
+** Description: read a region name (letters, digits and _ . $ -)
+** Parameter:   sRegionParser* parser, char* name (REGION_NAME_LEN bytes)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseName(sRegionParser* parser, char* name)
+{
+  uint32 len = 0;
+
+  Region_SkipBlanks(parser);
+
+  while(parser->p[len] != '\0' && len < REGION_NAME_LEN - 1 &&
+        (isalnum((unsigned char)parser->p[len]) || strchr("_.$-", parser->p[len]) != NULL))
+  {
+    name[len] = parser->p[len];
+    len++;
+  }
+
+  name[len]  = '\0';
+  parser->p += len;
+
+  return((boolean)(len > 0 && !isdigit((unsigned char)name[0])));
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseKeyword
+** Description: read one of the given keywords followed by '='
+** Parameter:   sRegionParser* parser, const char* const* keywords (NULL terminated)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseKeyword(sRegionParser* parser, const char* const* keywords)
+{
+  char    word[REGION_NAME_LEN];
+  boolean found = FALSE;
+
+  if(!Region_ParseName(parser, word))
+  {
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; keywords[i] != NULL && !found; i++)
+  {
+    found = (boolean)(0 == strcmp(word, keywords[i]));
+  }
+
+  Region_SkipBlanks(parser);
+  return((boolean)(found && Region_Expect(parser, '=')));
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseExpr
+** Description: <product> { (+|-) <product> }
+** Parameter:   sRegionParser* parser, uint64* value
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseExpr(sRegionParser* parser, uint64* value)
+{
+  if(!Region_ParseProduct(parser, value))
+  {
+    return(FALSE);
+  }
+
+  for(;;)
+  {
+    uint64 operand = 0;
+    char   op      = '\0';
+
+    Region_SkipBlanks(parser);
+    op = *parser->p;
+
+    if(op != '+' && op != '-')
+    {
+      return(TRUE);
+    }
+
+    parser->p++;
+    if(!Region_ParseProduct(parser, &operand))
+    {
+      return(FALSE);
+    }
+    *value = (op == '+') ? (*value + operand) : (*value - operand);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseProduct
+** Description: <term> { * <term> }
+** Parameter:   sRegionParser* parser, uint64* value
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseProduct(sRegionParser* parser, uint64* value)
+{
+  if(!Region_ParseTerm(parser, value))
+  {
+    return(FALSE);
+  }
+
+  for(;;)
+  {
+    uint64 operand = 0;
+
+    Region_SkipBlanks(parser);
+
+    if(*parser->p != '*')
+    {
+      return(TRUE);
+    }
+
+    parser->p++;
+    if(!Region_ParseTerm(parser, &operand))
+    {
+      return(FALSE);
+    }
+    *value *= operand;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_ParseTerm
+** Description: <number>[K|M|G] | ORIGIN(<region>) | LENGTH(<region>) | ( <expr> )
+** Parameter:   sRegionParser* parser, uint64* value
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_ParseTerm(sRegionParser* parser, uint64* value)
+{
+  Region_SkipBlanks(parser);
+
+  if(*parser->p == '(')
+  {
+    parser->p++;
+    if(!Region_ParseExpr(parser, value))
+    {
+      return(FALSE);
+    }
+    Region_SkipBlanks(parser);
+    return(Region_Expect(parser, ')'));
+  }
+
+  if(isdigit((unsigned char)*parser->p))
+  {
+    char* end = NULL;
+
+    *value = (uint64)strtoull(parser->p, &end, 0);
+    parser->p = end;
+
+    switch(*parser->p)
+    {
+      case 'K': case 'k': *value <<= 10; parser->p++; break;
+      case 'M': case 'm': *value <<= 20; parser->p++; break;
+      case 'G': case 'g': *value <<= 30; parser->p++; break;
+      default:                                        break;
+    }
+    return(TRUE);
+  }
+  else
+  {
+    char    function[REGION_NAME_LEN];
+    char    name[REGION_NAME_LEN];
+    boolean origin = FALSE;
+    uint32  index  = REGION_NONE;
+
+    if(!Region_ParseName(parser, function))
+    {
+      return(FALSE);
+    }
+
+    origin = (boolean)(0 == strcmp(function, "ORIGIN"));
+
+    if((!origin && 0 != strcmp(function, "LENGTH")) || (Region_SkipBlanks(parser), !Region_Expect(parser, '(')) ||
+       !Region_ParseName(parser, name) || (Region_SkipBlanks(parser), !Region_Expect(parser, ')')))
+    {
+      return(FALSE);
+    }
+
+    index = Region_Find(parser->map, name);
+
+    if(index == REGION_NONE)
+    {
+      return(FALSE);
+    }
+
+    *value = origin ? parser->map->regions[index].origin :
+                      (parser->map->regions[index].end - parser->map->regions[index].origin);
+    return(TRUE);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Add
+** Description: add one region to the map (the end of a region reaching the top of the address space is clamped)
+** Parameter:   sRegionMap* map, const char* name, uint64 origin, uint64 length
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Region_Add(sRegionMap* map, const char* name, uint64 origin, uint64 length)
+{
+  sRegion* region = NULL;
+
+  if(map->count == REGION_MAX_REGIONS || Region_Find(map, name) != REGION_NONE)
+  {
+    return(FALSE);
+  }
+
+  region = &map->regions[map->count++];
+
+  strcpy(region->name, name);
+  region->origin = origin;
+  region->end    = (length > ~origin) ? ~(uint64)0 : origin + length;
+  region->cursor = origin;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Find
+** Description: find a region by name (the regions are few, the description is read once)
+** Parameter:   const sRegionMap* map, const char* name
+** Return:      uint32 (REGION_NONE if there is no such region)
+*******************************************************************************************************************/
+static uint32 Region_Find(const sRegionMap* map, const char* name)
+{
+  for(uint32 i = 0; i < map->count; i++)
+  {
+    if(0 == strcmp(map->regions[i].name, name))
+    {
+      return(i);
+    }
+  }
+  return(REGION_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_CompareOrigin
+** Description: qsort callback: regions by origin, then by end
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Region_CompareOrigin(const void* a, const void* b)
+{
+  const sRegion* x = (const sRegion*)a;
+  const sRegion* y = (const sRegion*)b;
+
+  if(x->origin != y->origin)
+  {
+    return((x->origin < y->origin) ? -1 : 1);
+  }
+  return((x->end < y->end) ? -1 : ((x->end > y->end) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Region_CompareItems
+** Description: qsort callback: ranges by start address, then by end
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Region_CompareItems(const void* a, const void* b)
+{
+  const sRegionItem* x = (const sRegionItem*)a;
+  const sRegionItem* y = (const sRegionItem*)b;
+
+  if(x->start != y->start)
+  {
+    return((x->start < y->start) ? -1 : 1);
+  }
+  return((x->end < y->end) ? -1 : ((x->end > y->end) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Region_BuildTree
+** Description: fill the subtree maximum ends of the implicit interval tree over the sorted regions [lo, hi)
+** Parameter:   sRegionMap* map, uint32 lo, uint32 hi
+** Return:      uint64 (largest end of the subtree, 0 if empty)
+*******************************************************************************************************************/
+static uint64 Region_BuildTree(sRegionMap* map, uint32 lo, uint32 hi)
+{
+  uint32 mid   = lo + ((hi - lo) / 2U);
+  uint64 max   = 0;
+  uint64 left  = 0;
+  uint64 right = 0;
+
+  if(lo >= hi)
+  {
+    return(0);
+  }
+
+  left  = Region_BuildTree(map, lo, mid);
+  right = Region_BuildTree(map, mid + 1U, hi);
+  max   = map->regions[mid].end;
+  max   = (left > max) ? left : max;
+  max   = (right > max) ? right : max;
+
+  map->MaxEnd[mid] = max;
+  return(max);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Query
+** Description: visit, in origin order, the regions of the subtree [lo, hi) overlapping [visit->start, visit->end).
+**              A subtree whose largest end is below the start is skipped, and so are the nodes starting after
+**              the end of the range: O(log(regions) + overlapping regions).
+** Parameter:   sRegionVisit* visit, uint32 lo, uint32 hi
+** Return:      void
+*******************************************************************************************************************/
+static void Region_Query(sRegionVisit* visit, uint32 lo, uint32 hi)
+{
+  while(lo < hi)
+  {
+    uint32 mid = lo + ((hi - lo) / 2U);
+
+    if(visit->map->MaxEnd[mid] <= visit->start)
+    {
+      return;
+    }
+
+    Region_Query(visit, lo, mid);
+
+    if(visit->map->regions[mid].origin >= visit->end)
+    {
+      return;
+    }
+
+    if(visit->map->regions[mid].end > visit->start)
+    {
+      Region_Visit(visit, mid);
+    }
+    lo = mid + 1U;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_Visit
+** Description: one region overlapping the queried range: record the containment and, for sections, add the part
+**              of the range inside the region to its use. The ranges come in address order, so the part below the
+**              region cursor is already counted and a jump over the cursor is a free block.
+** Parameter:   sRegionVisit* visit, uint32 index
+** Return:      void
+*******************************************************************************************************************/
+static void Region_Visit(sRegionVisit* visit, uint32 index)
+{
+  sRegion* region = &visit->map->regions[index];
+
+  visit->touched = index;
+
+  if(visit->inside == REGION_NONE && visit->start >= region->origin && visit->end <= region->end)
+  {
+    visit->inside = index;
+  }
+
+  if(visit->account)
+  {
+    uint64 start = (visit->start > region->origin) ? visit->start : region->origin;
+    uint64 end   = (visit->end < region->end) ? visit->end : region->end;
+
+    if(start > region->cursor)
+    {
+      uint64 hole = start - region->cursor;
+
+      region->FreeBlocks++;
+      region->LargestFree = (hole > region->LargestFree) ? hole : region->LargestFree;
+    }
+
+    start = (start > region->cursor) ? start : region->cursor;
+
+    if(end > start)
+    {
+      region->used  += end - start;
+      region->cursor = end;
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Region_CheckRange
+** Description: map one address range [start, end) onto the regions and report it when it does not lie inside a
+**              single region
+** Parameter:   sRegionMap* map, uint64 start, uint64 end, boolean account, const char* kind, const char* name
+** Return:      uint32 (number of errors: 0 or 1)
+*******************************************************************************************************************/
+static uint32 Region_CheckRange(sRegionMap* map, uint64 start, uint64 end, boolean account, const char* kind,
+                                const char* name)
+{
+  sRegionVisit visit;
+
+  visit.map     = map;
+  visit.start   = start;
+  visit.end     = end;
+  visit.account = account;
+  visit.inside  = REGION_NONE;
+  visit.touched = REGION_NONE;
+
+  Region_Query(&visit, 0, map->count);
+
+  if(visit.inside != REGION_NONE)
+  {
+    return(0);
+  }
+
+  if(visit.touched != REGION_NONE)
+  {
+    printf("\n\r error: %s '%s' (0x%llx-0x%llx) crosses the end of the region '%s' !\n\r", kind, name,
+           (unsigned long long)start, (unsigned long long)(end - 1), map->regions[visit.touched].name);
+  }
+  else
+  {
+    printf("\n\r error: %s '%s' (0x%llx-0x%llx) is outside of every memory region !\n\r", kind, name,
+           (unsigned long long)start, (unsigned long long)(end - 1));
+  }
+  return(1);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_CollectItems
+** Description: list the address ranges occupied by the image, sorted by address: the ALLOC sections at their run
+**              address (the section directory keeps them sorted) merged with the load copies of the initialized
+**              sections placed elsewhere by their PT_LOAD segment (p_paddr != p_vaddr). Empty sections and the
+**              thread local .tbss templates take no memory. The list is taken from the arena.
+** Parameter:   sElf* elf, sArena* arena, sRegionItem** items
+** Return:      uint32 (number of ranges)
+*******************************************************************************************************************/
+static uint32 Region_CollectItems(sElf* elf, sArena* arena, sRegionItem** items)
+{
+  sElfSection*  sections = NULL;
+  sElfSegment*  segments = NULL;
+  const uint32* alloc    = NULL;
+  uint32        SecNbr   = 0;
+  uint32        SegNbr   = 0;
+  uint32        AllocNbr = Elf_GetAllocSections(elf, &alloc);
+  uint32        RunNbr   = 0;
+  uint32        LoadNbr  = 0;
+  uint32        count    = 0;
+  sRegionItem*  run      = NULL;
+  sRegionItem*  load     = NULL;
+
+  *items = NULL;
+
+  if(!Elf_GetSections(elf, &sections, &SecNbr) || !Elf_GetSegments(elf, &segments, &SegNbr))
+  {
+    return(0);
+  }
+
+  run    = (sRegionItem*)Arena_Alloc(arena, ((size_t)AllocNbr + 1) * sizeof(sRegionItem));
+  load   = (sRegionItem*)Arena_Alloc(arena, ((size_t)AllocNbr + 1) * sizeof(sRegionItem));
+  *items = (sRegionItem*)Arena_Alloc(arena, ((size_t)AllocNbr * 2 + 1) * sizeof(sRegionItem));
+
+  if(run == NULL || load == NULL || *items == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(0);
+  }
+
+  for(uint32 i = 0; i < AllocNbr; i++)
+  {
+    const sElfSection* section = &sections[alloc[i]];
+
+    if(section->size == 0 || (section->type == SHT_NOBITS && (section->flags & SHF_TLS)))
+    {
+      continue;
+    }
+
+    run[RunNbr].start = section->addr;
+    run[RunNbr].end   = section->addr + section->size;
+    run[RunNbr].name  = section->name;
+    run[RunNbr].load  = FALSE;
+    RunNbr++;
+
+    if(section->type == SHT_NOBITS)
+    {
+      continue;
+    }
+
+    for(uint32 s = 0; s < SegNbr; s++)
+    {
+      const sElfSegment* segment = &segments[s];
+
+      if(segment->type == PT_LOAD && segment->paddr != segment->vaddr && section->addr >= segment->vaddr &&
+         section->addr - segment->vaddr < segment->filesz && section->size <= segment->filesz - (section->addr - segment->vaddr))
+      {
+        load[LoadNbr].start = segment->paddr + (section->addr - segment->vaddr);
+        load[LoadNbr].end   = load[LoadNbr].start + section->size;
+        load[LoadNbr].name  = section->name;
+        load[LoadNbr].load  = TRUE;
+        LoadNbr++;
+        break;
+      }
+    }
+  }
+
+  /* the load copies follow the section order, which is not always the address order */
+  qsort(load, LoadNbr, sizeof(sRegionItem), Region_CompareItems);
+
+  for(uint32 r = 0, l = 0; r < RunNbr || l < LoadNbr;)
+  {
+    if(l == LoadNbr || (r < RunNbr && Region_CompareItems(&run[r], &load[l]) <= 0))
+    {
+      (*items)[count++] = run[r++];
+    }
+    else
+    {
+      (*items)[count++] = load[l++];
+    }
+  }
+
+  return(count);
+}
+
+/*******************************************************************************************************************
+** Function:    Region_PrintTable
+** Description: display the use of each region. The fragmentation is the part of the free space outside of the
+**              largest free block (0% when the free space is a single block).
+** Parameter:   const sRegionMap* map
+** Return:      void
+*******************************************************************************************************************/
+static void Region_PrintTable(const sRegionMap* map)
+{
+  printf("\n%-20s%-20s%-14s%-14s%-14s%-9s%-8s%-14s%s\n\n",
+         "Region", "Origin", "Length", "Used", "Free", "Used", "Holes", "Largest free", "Fragmentation");
+
+  for(uint32 i = 0; i < map->count; i++)
+  {
+    const sRegion* region = &map->regions[i];
+    uint64         length = region->end - region->origin;
+    uint64         free   = length - region->used;
+    double         used   = (length > 0) ? (100.0 * (double)region->used / (double)length) : 0.0;
+    double         frag   = (free > 0) ? (100.0 * (double)(free - region->LargestFree) / (double)free) : 0.0;
+
+    printf("%-20s0x%-18llx0x%-12llx0x%-12llx0x%-12llx%6.2f%%  %-8u0x%-12llx%.2f%%\n",
+           region->name,
+           (unsigned long long)region->origin,
+           (unsigned long long)length,
+           (unsigned long long)region->used,
+           (unsigned long long)free,
+           used,
+           (unsigned int)region->FreeBlocks,
+           (unsigned long long)region->LargestFree,
+           frag
+          );
+  }
+}
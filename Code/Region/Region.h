@@ -0,0 +1,42 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __REGION_H__
+#define __REGION_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define REGION_MAX_REGIONS  128U      //regions of one memory map
+#define REGION_NAME_LEN     64U
+#define REGION_NONE         0xFFFFFFFFUL
+
+//one memory region and its use by the image
+typedef struct
+{
+  char   name[REGION_NAME_LEN];
+  uint64 origin;
+  uint64 end;                         //first address after the region
+  uint64 used;                        //bytes covered by sections (overlapping sections are counted once)
+  uint64 cursor;                      //end of the part of the region already covered (address order sweep)
+  uint64 LargestFree;
+  uint32 FreeBlocks;
+}sRegion;
+
+//memory regions sorted by origin, stored as an implicit interval tree: the node of the sub-array [lo, hi) is its
+//middle element and MaxEnd holds the largest end of the node subtree
+typedef struct
+{
+  sRegion* regions;
+  uint64*  MaxEnd;
+  uint32   count;
+}sRegionMap;
+
+boolean Region_Parse(sRegionMap* map, sArena* arena, const char* text);
+boolean Region_Report(sElf* elf, char* path);
+
+#endif
@@ -0,0 +1,685 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** S-record and Intel HEX ingest (-verify, S19/HEX input files).
+**
+** The text is decoded in one pass: each record is converted by a 256 entry table (one lookup per character, the
+** invalid characters are flagged in the same lookup) and its checksum is checked before its bytes are appended to
+** the data buffer. The data records of consecutive addresses form runs; at the end the runs are sorted, checked for
+** overlaps and compacted into blocks of consecutive addresses: the sparse image of the file. This image is either
+** compared with the load image of an ELF file, or wrapped into a minimal ELF file (Image_WrapElf), so that every
+** operation on ELF files also works on an S19/HEX file (for example -elf to write the wrapped file).
+*******************************************************************************************************************/
+
+#include<SRec.h>
+
+#define SREC_BAD  0x10U               //invalid hexadecimal character
+
+//differences found by SRec_Verify
+typedef struct
+{
+  const sImageSymbol* symbols;
+  uint32              SymNbr;
+  uint32              ranges;
+  uint64              differ;
+  uint64              missing;
+  uint64              extra;
+}sSRecCompare;
+
+//hexadecimal value of each character, SREC_BAD for the others
+static const uint8 SRecHex[256] =
+{
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+};
+
+static uint32      SRec_Decode(const uint8* text, uint8* bytes, uint32 count, uint32* sum);
+static boolean     SRec_AddData(sSRecImage* rec, uint64 addr, const uint8* data, uint32 size);
+static const char* SRec_ParseS19(sSRecImage* rec, const uint8** text, const uint8* end);
+static const char* SRec_ParseHex(sSRecImage* rec, const uint8** text, const uint8* end, uint64* base,
+                                 boolean* done);
+static int         SRec_CompareRuns(const void* a, const void* b);
+static const char* SRec_Assemble(sSRecImage* rec, char* message, size_t size);
+static void        SRec_Report(sSRecCompare* cmp, const char* status, uint64 addr, uint64 size, const char* section);
+static void        SRec_CompareBlock(sSRecCompare* cmp, uint64 addr, const uint8* elf, const uint8* file, uint64 size,
+                                     const char* section);
+
+/*******************************************************************************************************************
+** Function:    SRec_IsRecordFile
+** Description: tell whether a buffer starts with an S-record or an Intel HEX record
+** Parameter:   const char* buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean SRec_IsRecordFile(const char* buffer, uint32 size)
+{
+  const uint8* p = (const uint8*)buffer;
+
+  if(size >= 4 && p[0] == 'S' && p[1] >= '0' && p[1] <= '9')
+  {
+    return((boolean)(((SRecHex[p[2]] | SRecHex[p[3]]) & SREC_BAD) == 0));
+  }
+
+  if(size >= 11 && p[0] == ':')
+  {
+    return((boolean)(((SRecHex[p[1]] | SRecHex[p[2]]) & SREC_BAD) == 0));
+  }
+  return(FALSE);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Decode
+** Description: convert count pairs of hexadecimal characters into bytes
+** Parameter:   const uint8* text, uint8* bytes, uint32 count, uint32* sum (sum of the bytes)
+** Return:      uint32 (non zero if a character is not hexadecimal)
+*******************************************************************************************************************/
+static uint32 SRec_Decode(const uint8* text, uint8* bytes, uint32 count, uint32* sum)
+{
+  uint32 bad   = 0;
+  uint32 total = 0;
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    uint32 hi = SRecHex[text[2U * i]];
+    uint32 lo = SRecHex[text[2U * i + 1U]];
+
+    bad     |= hi | lo;
+    bytes[i] = (uint8)((hi << 4) | lo);
+    total   += bytes[i];
+  }
+
+  *sum = total;
+  return(bad & SREC_BAD);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_AddData
+** Description: append the bytes of a data record, extending the last run when the address follows it
+** Parameter:   sSRecImage* rec, uint64 addr, const uint8* data, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean SRec_AddData(sSRecImage* rec, uint64 addr, const uint8* data, uint32 size)
+{
+  sSRecRun* run = (rec->RunsNbr > 0) ? &rec->runs[rec->RunsNbr - 1U] : NULL;
+
+  rec->records++;
+
+  if(size == 0)
+  {
+    return(TRUE);
+  }
+
+  if(run == NULL || run->addr + run->size != addr)
+  {
+    if(rec->RunsNbr == rec->capacity)
+    {
+      uint32    capacity = (rec->capacity == 0) ? 64U : (2U * rec->capacity);
+      sSRecRun* runs     = (sSRecRun*)realloc(rec->runs, (size_t)capacity * sizeof(sSRecRun));
+
+      if(runs == NULL)
+      {
+        return(FALSE);
+      }
+      rec->runs     = runs;
+      rec->capacity = capacity;
+    }
+
+    run         = &rec->runs[rec->RunsNbr++];
+    run->addr   = addr;
+    run->offset = rec->DataSize;
+    run->size   = 0;
+  }
+
+  /* the data buffer holds half the size of the text, a record never holds more bytes than characters */
+  memcpy(&rec->data[rec->DataSize], data, size);
+  rec->DataSize += size;
+  run->size     += size;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_ParseS19
+** Description: decode one S-record: S<type><count><address><data><checksum>, count and checksum cover the address
+**              and the data, the checksum is the one's complement of their sum
+** Parameter:   sSRecImage* rec, const uint8** text (moved after the record), const uint8* end
+** Return:      const char* (NULL, or the error)
+*******************************************************************************************************************/
+static const char* SRec_ParseS19(sSRecImage* rec, const uint8** text, const uint8* end)
+{
+  static const uint8 AddrLen[10] = {2, 2, 3, 4, 0, 2, 3, 4, 3, 2};
+  const uint8* p     = *text;
+  uint8        bytes[SREC_MAX_RECORD];
+  uint32       sum   = 0;
+  uint32       count = 0;
+  uint32       type  = 0;
+  uint32       alen  = 0;
+  uint64       addr  = 0;
+
+  if(end - p < 4 || p[1] < '0' || p[1] > '9' || ((SRecHex[p[2]] | SRecHex[p[3]]) & SREC_BAD) != 0)
+  {
+    return("Bad record");
+  }
+
+  type  = (uint32)(p[1] - '0');
+  alen  = AddrLen[type];
+  count = (SRecHex[p[2]] << 4) | SRecHex[p[3]];
+
+  if(alen == 0 || count < alen + 1U || (uint64)(end - p) < 4U + 2U * (uint64)count)
+  {
+    return("Bad record");
+  }
+
+  if(SRec_Decode(&p[4], bytes, count, &sum) != 0)
+  {
+    return("Bad character");
+  }
+
+  if(((sum + count) & 0xFFU) != 0xFFU)
+  {
+    return("Bad checksum");
+  }
+
+  p += 4U + 2U * count;
+
+  if(p < end && *p != '\r' && *p != '\n')
+  {
+    return("Bad record");
+  }
+  *text = p;
+
+  for(uint32 i = 0; i < alen; i++)
+  {
+    addr = (addr << 8) | bytes[i];
+  }
+
+  switch(type)
+  {
+    case 1: case 2: case 3:
+      return(SRec_AddData(rec, addr, &bytes[alen], count - alen - 1U) ? NULL : "Out of memory");
+
+    /* the count of the data records so far, modulo the width of the field */
+    case 5: case 6:
+      if(addr != (rec->records & ((type == 5) ? 0xFFFFUL : 0xFFFFFFUL)))
+      {
+        return("Wrong record count");
+      }
+      break;
+
+    case 7: case 8: case 9:
+      rec->entry    = addr;
+      rec->HasEntry = TRUE;
+      break;
+
+    default:
+      break;
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_ParseHex
+** Description: decode one Intel HEX record: :<count><offset><type><data><checksum>, the sum of all the bytes of a
+**              record is zero. The extended segment (02) and linear (04) address records set the base of the
+**              following data records, the end of file record (01) ends the file.
+** Parameter:   sSRecImage* rec, const uint8** text (moved after the record), const uint8* end, uint64* base,
+**              boolean* done
+** Return:      const char* (NULL, or the error)
+*******************************************************************************************************************/
+static const char* SRec_ParseHex(sSRecImage* rec, const uint8** text, const uint8* end, uint64* base,
+                                 boolean* done)
+{
+  const uint8* p     = *text;
+  uint8        bytes[SREC_MAX_RECORD];
+  uint32       sum   = 0;
+  uint32       count = 0;
+  const uint8* data  = &bytes[4];
+  uint64       value = 0;
+
+  if(end - p < 11 || ((SRecHex[p[1]] | SRecHex[p[2]]) & SREC_BAD) != 0)
+  {
+    return("Bad record");
+  }
+
+  count = (SRecHex[p[1]] << 4) | SRecHex[p[2]];
+
+  if((uint64)(end - p) < 1U + 2U * ((uint64)count + 5U))
+  {
+    return("Bad record");
+  }
+
+  if(SRec_Decode(&p[1], bytes, count + 5U, &sum) != 0)
+  {
+    return("Bad character");
+  }
+
+  if((sum & 0xFFU) != 0)
+  {
+    return("Bad checksum");
+  }
+
+  p += 1U + 2U * (count + 5U);
+
+  if(p < end && *p != '\r' && *p != '\n')
+  {
+    return("Bad record");
+  }
+  *text = p;
+
+  for(uint32 i = 0; i < count && i < 4U; i++)
+  {
+    value = (value << 8) | data[i];
+  }
+
+  switch(bytes[3])
+  {
+    case 0x00:
+      return(SRec_AddData(rec, *base + (((uint64)bytes[1] << 8) | bytes[2]), data, count) ? NULL : "Out of memory");
+
+    case 0x01:
+      *done = TRUE;
+      break;
+
+    case 0x02:
+      if(count != 2) { return("Bad record"); }
+      *base = value << 4;
+      break;
+
+    case 0x03:
+      if(count != 4) { return("Bad record"); }
+      rec->entry    = ((value >> 16) << 4) + (value & 0xFFFFU);
+      rec->HasEntry = TRUE;
+      break;
+
+    case 0x04:
+      if(count != 2) { return("Bad record"); }
+      *base = value << 16;
+      break;
+
+    case 0x05:
+      if(count != 4) { return("Bad record"); }
+      rec->entry    = value;
+      rec->HasEntry = TRUE;
+      break;
+
+    default:
+      return("Unknown record type");
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_CompareRuns
+** Description: qsort callback: runs by address, then in file order
+** Parameter:   const void* a, const void* b (sSRecRun*)
+** Return:      int
+*******************************************************************************************************************/
+static int SRec_CompareRuns(const void* a, const void* b)
+{
+  const sSRecRun* x = (const sSRecRun*)a;
+  const sSRecRun* y = (const sSRecRun*)b;
+
+  if(x->addr != y->addr)
+  {
+    return((x->addr < y->addr) ? -1 : 1);
+  }
+  return((x->offset < y->offset) ? -1 : ((x->offset > y->offset) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Assemble
+** Description: sort the runs, reject the overlapping ones and put the data in address order (in place when the
+**              records are already in order), the runs of consecutive addresses becoming one block of the image
+** Parameter:   sSRecImage* rec, char* message, size_t size (text of an overlap error)
+** Return:      const char* (NULL, or the error)
+*******************************************************************************************************************/
+static const char* SRec_Assemble(sSRecImage* rec, char* message, size_t size)
+{
+  uint64  fill    = 0;
+  boolean ordered = TRUE;
+
+  if(rec->RunsNbr > 1)
+  {
+    qsort(rec->runs, rec->RunsNbr, sizeof(sSRecRun), SRec_CompareRuns);
+  }
+
+  for(uint32 i = 0; i < rec->RunsNbr; i++)
+  {
+    const sSRecRun* run = &rec->runs[i];
+
+    if(i > 0 && run->addr < rec->runs[i - 1U].addr + rec->runs[i - 1U].size)
+    {
+      snprintf(message, size, "Two records hold the address 0x%llx", (unsigned long long)run->addr);
+      return(message);
+    }
+
+    if(i > 0 && run->addr == rec->runs[i - 1U].addr + rec->runs[i - 1U].size)
+    {
+      rec->image.regions[rec->image.RegionsNbr - 1U].size += run->size;
+    }
+    else if(!Image_AddRegion(&rec->image, run->addr, run->size, NULL, NULL))
+    {
+      return("Out of memory");
+    }
+
+    ordered = (boolean)(ordered && run->offset == fill);
+    fill   += run->size;
+  }
+
+  if(!ordered)
+  {
+    uint8* data = (uint8*)malloc((size_t)rec->DataSize + 1U);
+
+    if(data == NULL)
+    {
+      return("Out of memory");
+    }
+
+    fill = 0;
+    for(uint32 i = 0; i < rec->RunsNbr; i++)
+    {
+      memcpy(&data[fill], &rec->data[rec->runs[i].offset], (size_t)rec->runs[i].size);
+      fill += rec->runs[i].size;
+    }
+
+    free(rec->data);
+    rec->data = data;
+  }
+
+  fill = 0;
+  for(uint32 i = 0; i < rec->image.RegionsNbr; i++)
+  {
+    rec->image.regions[i].data = &rec->data[fill];
+    fill += rec->image.regions[i].size;
+  }
+  return(NULL);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Load
+** Description: decode an S-record or Intel HEX file (the format of the first record) into a sparse image
+** Parameter:   sSRecImage* rec, const char* text, uint32 size, const char* path (for the messages)
+** Return:      boolean
+*******************************************************************************************************************/
+boolean SRec_Load(sSRecImage* rec, const char* text, uint32 size, const char* path)
+{
+  const uint8* p       = (const uint8*)text;
+  const uint8* end     = p + size;
+  const char*  error   = NULL;
+  char         message[MAX_LINE_LEN];
+  uint32       line    = 1;
+  uint64       base    = 0;
+  boolean      done    = FALSE;
+
+  memset(rec, 0, sizeof(sSRecImage));
+  rec->data = (uint8*)malloc((size_t)size / 2U + 1U);
+
+  if(rec->data == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  while(p < end && error == NULL && !done)
+  {
+    if(*p == '\n')
+    {
+      line++;
+      p++;
+    }
+    else if(*p == '\r' || *p == ' ' || *p == '\t')
+    {
+      p++;
+    }
+    else if(*p == 'S' && rec->format != SREC_IHEX)
+    {
+      rec->format = SREC_S19;
+      error = SRec_ParseS19(rec, &p, end);
+    }
+    else if(*p == ':' && rec->format != SREC_S19)
+    {
+      rec->format = SREC_IHEX;
+      error = SRec_ParseHex(rec, &p, end, &base, &done);
+    }
+    else
+    {
+      error = "Bad record";
+    }
+  }
+
+  if(error == NULL)
+  {
+    error = SRec_Assemble(rec, message, sizeof(message));
+  }
+
+  /* the errors found at the end are not errors of one line */
+  if(error != NULL && (p >= end || done))
+  {
+    line = 0;
+  }
+
+  if(error != NULL)
+  {
+    if(line > 0)
+    {
+      printf("\n\r error: %s at line %u of '%s' !\n\r", error, line, path);
+    }
+    else
+    {
+      printf("\n\r error: %s in '%s' !\n\r", error, path);
+    }
+    SRec_Release(rec);
+    return(FALSE);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Release
+** Description: free the image of a record file
+** Parameter:   sSRecImage* rec
+** Return:      void
+*******************************************************************************************************************/
+void SRec_Release(sSRecImage* rec)
+{
+  free(rec->data);
+  free(rec->runs);
+  Image_Release(&rec->image);
+  memset(rec, 0, sizeof(sSRecImage));
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Report
+** Description: print one differing range (the first SREC_MAX_RANGES ones, the others are only counted)
+** Parameter:   sSRecCompare* cmp, const char* status, uint64 addr, uint64 size, const char* section
+** Return:      void
+*******************************************************************************************************************/
+static void SRec_Report(sSRecCompare* cmp, const char* status, uint64 addr, uint64 size, const char* section)
+{
+  char symbol[MAX_LINE_LEN];
+
+  if(cmp->ranges == 0)
+  {
+    printf("\n%-10s%-20s%-20s%-12s%-20s%s\n\n", "Status", "Start", "End", "Size", "Section", "Symbol");
+  }
+
+  if(cmp->ranges < SREC_MAX_RANGES)
+  {
+    Image_SymbolName(cmp->symbols, cmp->SymNbr, addr, symbol, sizeof(symbol));
+    printf("%-10s0x%-18llx0x%-18llx%-12llu%-20s%s\n", status, (unsigned long long)addr,
+           (unsigned long long)(addr + size - 1U), (unsigned long long)size, (section != NULL) ? section : "-",
+           (section != NULL) ? symbol : "-");
+  }
+  cmp->ranges++;
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_CompareBlock
+** Description: compare the bytes present in both images, the differences closer than SREC_MERGE_GAP bytes are
+**              reported as one range
+** Parameter:   sSRecCompare* cmp, uint64 addr, const uint8* elf, const uint8* file, uint64 size,
+**              const char* section
+** Return:      void
+*******************************************************************************************************************/
+static void SRec_CompareBlock(sSRecCompare* cmp, uint64 addr, const uint8* elf, const uint8* file, uint64 size,
+                              const char* section)
+{
+  uint64 i = 0;
+
+  while(i < size)
+  {
+    uint64 chunk = (size - i < 256U) ? (size - i) : 256U;
+    uint64 start = 0;
+    uint64 last  = 0;
+
+    if(0 == memcmp(&elf[i], &file[i], (size_t)chunk))
+    {
+      i += chunk;
+      continue;
+    }
+
+    while(elf[i] == file[i])
+    {
+      i++;
+    }
+
+    for(start = last = i; i < size && i - last <= SREC_MERGE_GAP; i++)
+    {
+      if(elf[i] != file[i])
+      {
+        last = i;
+        cmp->differ++;
+      }
+    }
+
+    SRec_Report(cmp, "DIFFER", addr + start, last - start + 1U, section);
+    i = last + 1U;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    SRec_Verify
+** Description: compare the load image of the ELF file with the image of a record file, range by range: the bytes
+**              that differ, the ones missing from the file and the ones the ELF file does not hold
+** Parameter:   sElf* elf, const sSRecImage* rec, const char* path
+** Return:      boolean (TRUE if the images are identical)
+*******************************************************************************************************************/
+boolean SRec_Verify(sElf* elf, const sSRecImage* rec, const char* path)
+{
+  sArena*             scratch = Arena_Thread();
+  sArenaMark          mark    = Arena_Mark(scratch);
+  sImage              image;
+  sImageSymbol*       symbols = NULL;
+  const sImageRegion* a       = NULL;
+  const sImageRegion* b       = rec->image.regions;
+  uint32              i       = 0;
+  uint32              j       = 0;
+  uint64              addr    = 0;
+  sSRecCompare        cmp;
+
+  if(!Image_BuildFromElf(&image, elf))
+  {
+    return(FALSE);
+  }
+  Image_Sort(&image);
+  a = image.regions;
+
+  memset(&cmp, 0, sizeof(cmp));
+  cmp.SymNbr  = Image_GetSymbols(elf, &symbols);
+  cmp.symbols = symbols;
+
+  printf("\nVERIFY : %s (%s, %u data record(s), %llu byte(s) in %u block(s))\n", path,
+         (rec->format == SREC_IHEX) ? "Intel HEX" : "S-record", rec->records, (unsigned long long)rec->DataSize,
+         rec->image.RegionsNbr);
+
+  addr = (image.RegionsNbr > 0) ? a[0].addr : 0;
+  if(rec->image.RegionsNbr > 0 && (image.RegionsNbr == 0 || b[0].addr < addr))
+  {
+    addr = b[0].addr;
+  }
+
+  /* sweep both images in address order, each step ends at the next region boundary of either image */
+  while(i < image.RegionsNbr || j < rec->image.RegionsNbr)
+  {
+    boolean inA  = FALSE;
+    boolean inB  = FALSE;
+    uint64  next = 0xFFFFFFFFFFFFFFFFULL;
+
+    while(i < image.RegionsNbr && a[i].addr + a[i].size <= addr)        { i++; }
+    while(j < rec->image.RegionsNbr && b[j].addr + b[j].size <= addr)   { j++; }
+
+    if(i < image.RegionsNbr)
+    {
+      inA  = (boolean)(a[i].addr <= addr);
+      next = inA ? (a[i].addr + a[i].size) : a[i].addr;
+    }
+
+    if(j < rec->image.RegionsNbr)
+    {
+      uint64 limit = 0;
+
+      inB   = (boolean)(b[j].addr <= addr);
+      limit = inB ? (b[j].addr + b[j].size) : b[j].addr;
+      next  = (limit < next) ? limit : next;
+    }
+
+    if(inA && inB)
+    {
+      SRec_CompareBlock(&cmp, addr, &a[i].data[addr - a[i].addr], &b[j].data[addr - b[j].addr], next - addr,
+                        a[i].name);
+    }
+    else if(inA)
+    {
+      SRec_Report(&cmp, "MISSING", addr, next - addr, a[i].name);
+      cmp.missing += next - addr;
+    }
+    else if(inB)
+    {
+      SRec_Report(&cmp, "EXTRA", addr, next - addr, NULL);
+      cmp.extra += next - addr;
+    }
+
+    if(next == 0xFFFFFFFFFFFFFFFFULL)
+    {
+      break;
+    }
+    addr = next;
+  }
+
+  if(cmp.ranges > SREC_MAX_RANGES)
+  {
+    printf("... %u more range(s)\n", cmp.ranges - SREC_MAX_RANGES);
+  }
+
+  if(cmp.ranges == 0)
+  {
+    printf("\nMATCH : the %llu byte(s) of the file are the load image\n", (unsigned long long)rec->DataSize);
+  }
+  else
+  {
+    printf("\nMISMATCH : %u range(s), %llu byte(s) differ, %llu missing from the file, %llu not in the ELF file\n",
+           cmp.ranges, (unsigned long long)cmp.differ, (unsigned long long)cmp.missing,
+           (unsigned long long)cmp.extra);
+  }
+
+  Image_Release(&image);
+  Arena_Rewind(scratch, mark);
+  return((boolean)(cmp.ranges == 0));
+}
@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __SREC_H__
+#define __SREC_H__
+
+#include<common.h>
+#include<Elf.h>
+#include<Image.h>
+
+#define SREC_S19          1U          //Motorola S-records (S1/S2/S3)
+#define SREC_IHEX         2U          //Intel HEX
+#define SREC_MAX_RECORD   261U        //bytes of the longest record (Intel HEX: 255 data bytes + 5)
+#define SREC_MAX_RANGES   256U        //differences listed by -verify, the others are only counted
+#define SREC_MERGE_GAP    16U         //equal bytes between two differences reported as one range
+
+//data records of consecutive addresses, in file order
+typedef struct
+{
+  uint64 addr;
+  uint64 offset;                      //first byte in data
+  uint64 size;
+}sSRecRun;
+
+//content of an S-record or Intel HEX file
+typedef struct
+{
+  uint32    format;                   //SREC_S19 or SREC_IHEX
+  uint32    records;                  //data records
+  uint8*    data;                     //decoded bytes, in address order once loaded
+  uint64    DataSize;
+  sSRecRun* runs;
+  uint32    RunsNbr;
+  uint32    capacity;
+  uint64    entry;                    //start address of the termination record
+  boolean   HasEntry;
+  sImage    image;                    //blocks of consecutive addresses, sorted
+}sSRecImage;
+
+boolean SRec_IsRecordFile(const char* buffer, uint32 size);
+boolean SRec_Load(sSRecImage* rec, const char* text, uint32 size, const char* path);
+void    SRec_Release(sSRecImage* rec);
+boolean SRec_Verify(sElf* elf, const sSRecImage* rec, const char* path);
+
+#endif
@@ -0,0 +1,632 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Byte signature search over the load image (-sig).
+**
+** A signature is a byte string with wildcards ("DE AD ?? EF", "A?" for a nibble). Its anchor, the longest run of
+** fully known bytes (at most SIG_ANCHOR_MAX), is entered in an Aho-Corasick automaton, compiled once per run into
+** a complete transition table: the scan reads one table entry per byte, whatever the number of signatures. The
+** entries hold the target state already multiplied by 256 and the SIG_OUTPUT flag, so the inner loop is a load,
+** an add and a test. When a state ends anchors, each signature is checked in full around the anchor. The sections
+** contiguous in memory are scanned as one stream, so a signature may cross a section boundary.
+*******************************************************************************************************************/
+
+#include<Sig.h>
+#include<Image.h>
+#include<io.h>
+#include<ctype.h>
+
+#define SIG_STATE(entry)  (((entry) & ~SIG_OUTPUT) >> 8)
+#define SIG_LANES         4U
+#define SIG_LANES_MIN     4096U       //smallest region scanned in lanes
+
+//one signature found, start address in the load image
+typedef struct
+{
+  uint64 addr;
+  uint32 pattern;
+  uint32 region;
+}sSigHit;
+
+//scan of one load image
+typedef struct
+{
+  const sSigSet* set;
+  const sImage*  image;
+  uint64         StreamStart;         //address of the first byte of the current contiguous stream
+  sSigHit*       hits;
+  uint32         HitsNbr;
+  uint32         capacity;
+  boolean        failed;
+}sSigScan;
+
+static boolean Sig_ParseLine(sSigSet* set, char* line, uint32 number);
+static boolean Sig_Compile(sSigSet* set);
+static boolean Sig_Verify(const sSigScan* scan, uint32 region, uint64 start, const sSigPattern* pattern,
+                          uint32* first);
+static void    Sig_Matches(sSigScan* scan, uint32 region, uint64 end, uint32 state);
+static uint32  Sig_ScanLanes(sSigScan* scan, uint32 region, uint32 state);
+static int     Sig_CompareHits(const void* a, const void* b);
+
+/*******************************************************************************************************************
+** Function:    Sig_Load
+** Description: read a signature file ("<name> <hex bytes>" lines, '?' is a wildcard nibble, '#' starts a comment,
+**              blanks between the digits are ignored) and compile the automaton
+** Parameter:   sSigSet* set, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Sig_Load(sSigSet* set, char* path)
+{
+  uint32  lines  = 1;
+  uint32  number = 0;
+  char*   line   = NULL;
+  boolean result = TRUE;
+
+  memset(set, 0, sizeof(sSigSet));
+  set->path = path;
+  set->text = (char*)LoadInputFile(path, NULL);
+
+  if(set->text == NULL)
+  {
+    return(FALSE);
+  }
+
+  for(const char* p = set->text; *p != '\0'; p++)
+  {
+    lines += (*p == '\n') ? 1U : 0U;
+  }
+
+  //values and masks of all the signatures, never more bytes than digits in the file
+  set->patterns = (sSigPattern*)calloc((lines < SIG_MAX_PATTERNS) ? lines : SIG_MAX_PATTERNS, sizeof(sSigPattern));
+  set->bytes    = (uint8*)malloc(strlen(set->text) + 1U);
+
+  if(set->patterns == NULL || set->bytes == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Sig_Release(set);
+    return(FALSE);
+  }
+
+  for(line = set->text; line != NULL && result; number++)
+  {
+    char* end = strchr(line, '\n');
+
+    if(end != NULL)
+    {
+      *end++ = '\0';
+    }
+
+    result = Sig_ParseLine(set, line, number + 1U);
+    line   = end;
+  }
+
+  if(!result || set->count == 0)
+  {
+    if(result)
+    {
+      printf("\n\r error: No signature found in '%s' !\n\r", path);
+    }
+    Sig_Release(set);
+    return(FALSE);
+  }
+
+  if(!Sig_Compile(set))
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Sig_Release(set);
+    return(FALSE);
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_ParseLine
+** Description: parse one line of the signature file, append the signature to the set. The values and the masks
+**              are stored in set->bytes, after the ones of the previous signatures.
+** Parameter:   sSigSet* set, char* line, uint32 number (line number)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Sig_ParseLine(sSigSet* set, char* line, uint32 number)
+{
+  sSigPattern* pattern = &set->patterns[set->count];
+  uint8*       cursor  = (set->count == 0) ? set->bytes : (set->patterns[set->count - 1].mask +
+                                                           set->patterns[set->count - 1].length);
+  char*        hash    = strchr(line, '#');
+  char*        digits  = NULL;
+  uint32       nibbles = 0;
+  uint32       run     = 0;
+
+  if(hash != NULL)
+  {
+    *hash = '\0';
+  }
+
+  while(isspace((unsigned char)*line))
+  {
+    line++;
+  }
+
+  if(*line == '\0')
+  {
+    return(TRUE);
+  }
+
+  if(set->count == SIG_MAX_PATTERNS)
+  {
+    printf("\n\r error: More than %u signatures !\n\r", SIG_MAX_PATTERNS);
+    return(FALSE);
+  }
+
+  pattern->name = line;
+  while(*line != '\0' && !isspace((unsigned char)*line))
+  {
+    line++;
+  }
+  if(*line != '\0')
+  {
+    *line++ = '\0';
+  }
+
+  //the values are written first, the masks follow once the length is known
+  digits = line;
+  for(; *line != '\0'; line++)
+  {
+    if(isxdigit((unsigned char)*line) || *line == '?')
+    {
+      digits[nibbles++] = *line;
+    }
+    else if(!isspace((unsigned char)*line))
+    {
+      break;
+    }
+  }
+
+  if(*line != '\0' || nibbles == 0 || (nibbles & 1U) != 0 || nibbles / 2U > SIG_MAX_LEN)
+  {
+    printf("\n\r error: Bad signature at line %u (<name> <hex bytes>, ? for a wildcard nibble, at most %u bytes) !\n\r",
+           number, SIG_MAX_LEN);
+    return(FALSE);
+  }
+
+  pattern->length = nibbles / 2U;
+  pattern->value  = cursor;
+  pattern->mask   = cursor + pattern->length;
+
+  for(uint32 i = 0; i < pattern->length; i++)
+  {
+    uint8 value = 0;
+    uint8 mask  = 0;
+
+    for(uint32 n = 0; n < 2U; n++)
+    {
+      char digit = digits[2U * i + n];
+
+      value = (uint8)(value << 4);
+      mask  = (uint8)(mask << 4);
+      if(digit != '?')
+      {
+        value |= (uint8)(isdigit((unsigned char)digit) ? (digit - '0') : (tolower((unsigned char)digit) - 'a' + 10));
+        mask  |= 0x0FU;
+      }
+    }
+    pattern->value[i] = value;
+    pattern->mask[i]  = mask;
+
+    run = (mask == 0xFFU) ? (run + 1U) : 0U;
+    if(run > pattern->AnchorLen)
+    {
+      pattern->AnchorLen = run;
+      pattern->anchor    = i + 1U - run;
+    }
+  }
+
+  if(pattern->AnchorLen == 0)
+  {
+    printf("\n\r error: The signature '%s' has no fully known byte !\n\r", pattern->name);
+    return(FALSE);
+  }
+
+  if(pattern->AnchorLen > SIG_ANCHOR_MAX)
+  {
+    pattern->AnchorLen = SIG_ANCHOR_MAX;
+  }
+
+  set->count++;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_Compile
+** Description: build the trie of the anchors, then complete it in breadth first order: a missing transition of a
+**              state is the transition of its failure state (longest proper suffix in the trie), already complete
+**              since it is shallower. The SIG_OUTPUT flags are set last.
+** Parameter:   sSigSet* set
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Sig_Compile(sSigSet* set)
+{
+  uint32  MaxStates = 1;
+  uint32* fail      = NULL;
+  uint32* queue     = NULL;
+  uint32  head      = 0;
+  uint32  tail      = 0;
+
+  for(uint32 i = 0; i < set->count; i++)
+  {
+    MaxStates += set->patterns[i].AnchorLen;
+  }
+
+  set->next   = (uint32*)malloc((size_t)MaxStates * 256U * sizeof(uint32));
+  set->first  = (uint32*)malloc((size_t)MaxStates * sizeof(uint32));
+  set->suffix = (uint32*)malloc((size_t)MaxStates * sizeof(uint32));
+  fail        = (uint32*)malloc((size_t)MaxStates * sizeof(uint32));
+  queue       = (uint32*)malloc((size_t)MaxStates * sizeof(uint32));
+
+  if(set->next == NULL || set->first == NULL || set->suffix == NULL || fail == NULL || queue == NULL)
+  {
+    free(fail);
+    free(queue);
+    return(FALSE);
+  }
+
+  memset(set->next, 0xFF, (size_t)MaxStates * 256U * sizeof(uint32));
+  memset(set->first, 0xFF, (size_t)MaxStates * sizeof(uint32));
+  memset(set->suffix, 0xFF, (size_t)MaxStates * sizeof(uint32));
+  set->states = 1;
+
+  //trie of the anchors, the signatures sharing an anchor are chained on its last state
+  for(uint32 i = 0; i < set->count; i++)
+  {
+    sSigPattern* pattern = &set->patterns[i];
+    uint32       state   = 0;
+
+    for(uint32 k = 0; k < pattern->AnchorLen; k++)
+    {
+      uint32* entry = &set->next[state * 256U + pattern->value[pattern->anchor + k]];
+
+      if(*entry == SIG_NONE)
+      {
+        *entry = set->states++;
+      }
+      state = *entry;
+    }
+    pattern->next     = set->first[state];
+    set->first[state] = i;
+  }
+
+  fail[0] = 0;
+  for(uint32 c = 0; c < 256U; c++)
+  {
+    if(set->next[c] == SIG_NONE)
+    {
+      set->next[c] = 0;
+    }
+    else
+    {
+      fail[set->next[c]] = 0;
+      queue[tail++]      = set->next[c];
+    }
+  }
+
+  while(head < tail)
+  {
+    uint32 state = queue[head++];
+
+    for(uint32 c = 0; c < 256U; c++)
+    {
+      uint32* entry = &set->next[state * 256U + c];
+
+      if(*entry == SIG_NONE)
+      {
+        *entry = set->next[fail[state] * 256U + c];
+      }
+      else
+      {
+        uint32 child = *entry;
+
+        fail[child]        = set->next[fail[state] * 256U + c];
+        set->suffix[child] = (set->first[fail[child]] != SIG_NONE) ? fail[child] : set->suffix[fail[child]];
+        queue[tail++]      = child;
+      }
+    }
+  }
+
+  for(size_t i = 0; i < (size_t)set->states * 256U; i++)
+  {
+    uint32 target = set->next[i];
+    uint32 output = (set->first[target] != SIG_NONE || set->suffix[target] != SIG_NONE) ? SIG_OUTPUT : 0U;
+
+    set->next[i] = (target << 8) | output;
+  }
+
+  free(fail);
+  free(queue);
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_Release
+** Description: free a signature set
+** Parameter:   sSigSet* set
+** Return:      void
+*******************************************************************************************************************/
+void Sig_Release(sSigSet* set)
+{
+  free(set->patterns);
+  free(set->bytes);
+  free(set->next);
+  free(set->first);
+  free(set->suffix);
+  free(set->text);
+  memset(set, 0, sizeof(sSigSet));
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_Verify
+** Description: compare a whole signature with the load image from the address start, which belongs to the
+**              stream of the region (the stream is contiguous, the signature may cross its regions)
+** Parameter:   const sSigScan* scan, uint32 region, uint64 start, const sSigPattern* pattern,
+**              uint32* first (region containing start)
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Sig_Verify(const sSigScan* scan, uint32 region, uint64 start, const sSigPattern* pattern,
+                          uint32* first)
+{
+  const sImageRegion* regions = scan->image->regions;
+  uint32              k       = region;
+
+  while(regions[k].addr > start)
+  {
+    k--;
+  }
+  *first = k;
+
+  for(uint32 i = 0; i < pattern->length; i++)
+  {
+    uint64 addr = start + i;
+
+    if(addr >= regions[k].addr + regions[k].size)
+    {
+      if(k + 1U == scan->image->RegionsNbr || regions[k + 1U].addr != regions[k].addr + regions[k].size)
+      {
+        return(FALSE);
+      }
+      k++;
+    }
+
+    if((regions[k].data[addr - regions[k].addr] & pattern->mask[i]) != pattern->value[i])
+    {
+      return(FALSE);
+    }
+  }
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_Matches
+** Description: check the signatures whose anchor ends at the address end (state and its suffix states)
+** Parameter:   sSigScan* scan, uint32 region, uint64 end, uint32 state
+** Return:      void
+*******************************************************************************************************************/
+static void Sig_Matches(sSigScan* scan, uint32 region, uint64 end, uint32 state)
+{
+  const sSigSet* set = scan->set;
+
+  for(uint32 s = state; s != SIG_NONE && !scan->failed; s = set->suffix[s])
+  {
+    for(uint32 p = set->first[s]; p != SIG_NONE; p = set->patterns[p].next)
+    {
+      const sSigPattern* pattern = &set->patterns[p];
+      uint64             before  = pattern->anchor + pattern->AnchorLen - 1U;
+      uint32             first   = region;
+
+      if(end - scan->StreamStart < before || !Sig_Verify(scan, region, end - before, pattern, &first))
+      {
+        continue;
+      }
+
+      if(scan->HitsNbr == scan->capacity)
+      {
+        uint32   capacity = (scan->capacity == 0) ? 64U : (scan->capacity * 2U);
+        sSigHit* hits     = (sSigHit*)realloc(scan->hits, (size_t)capacity * sizeof(sSigHit));
+
+        if(hits == NULL)
+        {
+          scan->failed = TRUE;
+          return;
+        }
+        scan->hits     = hits;
+        scan->capacity = capacity;
+      }
+
+      scan->hits[scan->HitsNbr].addr    = end - before;
+      scan->hits[scan->HitsNbr].pattern = p;
+      scan->hits[scan->HitsNbr].region  = first;
+      scan->HitsNbr++;
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_ScanLanes
+** Description: run the automaton over a region as SIG_LANES independent lanes, stepped together so that the
+**              table loads of the lanes overlap instead of waiting for each other. A state only depends on the
+**              last SIG_ANCHOR_MAX bytes, so a lane started SIG_ANCHOR_MAX - 1 bytes before its part of the region
+**              is exact from its first byte on; the first lane continues the state of the previous region.
+** Parameter:   sSigScan* scan, uint32 region, uint32 state (entry of the state at the start of the region)
+** Return:      uint32 (entry of the state at the end of the region)
+*******************************************************************************************************************/
+static uint32 Sig_ScanLanes(sSigScan* scan, uint32 region, uint32 state)
+{
+  const uint32* next = scan->set->next;
+  const uint8*  data = scan->image->regions[region].data;
+  uint64        addr = scan->image->regions[region].addr;
+  uint64        size = scan->image->regions[region].size;
+  uint64        part = size / SIG_LANES;
+  uint32        lane[SIG_LANES];
+
+  lane[0] = state;
+  for(uint32 j = 1; j < SIG_LANES; j++)
+  {
+    lane[j] = 0;
+    for(uint64 i = j * part - (SIG_ANCHOR_MAX - 1U); i < j * part; i++)
+    {
+      lane[j] = next[(lane[j] & ~SIG_OUTPUT) + data[i]];
+    }
+  }
+
+  for(uint64 i = 0; i < part; i++)
+  {
+    lane[0] = next[(lane[0] & ~SIG_OUTPUT) + data[i]];
+    lane[1] = next[(lane[1] & ~SIG_OUTPUT) + data[part + i]];
+    lane[2] = next[(lane[2] & ~SIG_OUTPUT) + data[2U * part + i]];
+    lane[3] = next[(lane[3] & ~SIG_OUTPUT) + data[3U * part + i]];
+
+    if(((lane[0] | lane[1] | lane[2] | lane[3]) & SIG_OUTPUT) != 0)
+    {
+      for(uint32 j = 0; j < SIG_LANES; j++)
+      {
+        if((lane[j] & SIG_OUTPUT) != 0)
+        {
+          Sig_Matches(scan, region, addr + j * part + i, SIG_STATE(lane[j]));
+        }
+      }
+    }
+  }
+
+  //the rest of the division belongs to the last lane
+  for(uint64 i = SIG_LANES * part; i < size; i++)
+  {
+    lane[SIG_LANES - 1U] = next[(lane[SIG_LANES - 1U] & ~SIG_OUTPUT) + data[i]];
+
+    if((lane[SIG_LANES - 1U] & SIG_OUTPUT) != 0)
+    {
+      Sig_Matches(scan, region, addr + i, SIG_STATE(lane[SIG_LANES - 1U]));
+    }
+  }
+
+  return(lane[SIG_LANES - 1U]);
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_CompareHits
+** Description: qsort callback, address order then signature order
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Sig_CompareHits(const void* a, const void* b)
+{
+  const sSigHit* x = (const sSigHit*)a;
+  const sSigHit* y = (const sSigHit*)b;
+
+  if(x->addr != y->addr)
+  {
+    return((x->addr < y->addr) ? -1 : 1);
+  }
+  return((x->pattern < y->pattern) ? -1 : ((x->pattern > y->pattern) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Sig_Report
+** Description: search the signatures in the load image and print each hit with its address, its section and the
+**              nearest symbol
+** Parameter:   sElf* elf, const sSigSet* set
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Sig_Report(sElf* elf, const sSigSet* set)
+{
+  sArena*       scratch  = Arena_Thread();
+  sArenaMark    mark     = Arena_Mark(scratch);
+  sImage        image;
+  sSigScan      scan;
+  sImageSymbol* symbols  = NULL;
+  uint32        SymNbr   = 0;
+  uint32        found    = 0;
+  uint8*        seen     = NULL;
+  uint32        state    = 0;
+  char          symbol[MAX_LINE_LEN];
+
+  if(!Image_BuildFromElf(&image, elf))
+  {
+    return(FALSE);
+  }
+
+  memset(&scan, 0, sizeof(scan));
+  scan.set   = set;
+  scan.image = &image;
+
+  for(uint32 r = 0; r < image.RegionsNbr && !scan.failed; r++)
+  {
+    const uint8*  data = image.regions[r].data;
+    uint64        size = image.regions[r].size;
+    const uint32* next = set->next;
+
+    if(r == 0 || image.regions[r].addr != image.regions[r - 1U].addr + image.regions[r - 1U].size)
+    {
+      scan.StreamStart = image.regions[r].addr;
+      state            = 0;
+    }
+
+    if(size < SIG_LANES_MIN)
+    {
+      for(uint64 i = 0; i < size; i++)
+      {
+        state = next[(state & ~SIG_OUTPUT) + data[i]];
+
+        if((state & SIG_OUTPUT) != 0)
+        {
+          Sig_Matches(&scan, r, image.regions[r].addr + i, SIG_STATE(state));
+        }
+      }
+    }
+    else
+    {
+      state = Sig_ScanLanes(&scan, r, state);
+    }
+  }
+
+  printf("\nSIGNATURES : %s (%u signature(s), %u automaton state(s))\n", set->path, set->count, set->states);
+
+  if(scan.failed)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+  }
+
+  if(scan.HitsNbr > 0)
+  {
+    qsort(scan.hits, scan.HitsNbr, sizeof(sSigHit), Sig_CompareHits);
+
+    SymNbr = Image_GetSymbols(elf, &symbols);
+    seen   = (uint8*)Arena_Calloc(scratch, set->count, sizeof(uint8));
+
+    printf("\n%-24s%-18s%-20s%s\n\n", "Signature", "Address", "Section", "Symbol");
+  }
+
+  for(uint32 h = 0; h < scan.HitsNbr; h++)
+  {
+    const sSigHit* hit = &scan.hits[h];
+
+    printf("%-24s0x%-16llx%-20s", set->patterns[hit->pattern].name, (unsigned long long)hit->addr,
+           image.regions[hit->region].name);
+    Image_SymbolName(symbols, SymNbr, hit->addr, symbol, sizeof(symbol));
+    printf("%s\n", symbol);
+
+    if(seen != NULL && !seen[hit->pattern])
+    {
+      seen[hit->pattern] = TRUE;
+      found++;
+    }
+  }
+
+  printf("\n%u hit(s), %u of %u signature(s) found\n", scan.HitsNbr, found, set->count);
+
+  free(scan.hits);
+  Image_Release(&image);
+  Arena_Rewind(scratch, mark);
+  return((boolean)!scan.failed);
+}
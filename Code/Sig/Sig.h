@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __SIG_H__
+#define __SIG_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define SIG_MAX_PATTERNS   4096U      //signatures of one pattern file
+#define SIG_MAX_LEN        1024U      //bytes of one signature
+#define SIG_ANCHOR_MAX     8U         //fully known bytes of a signature searched by the automaton
+#define SIG_NONE           0xFFFFFFFFUL
+#define SIG_OUTPUT         0x80000000UL   //transition flag: the target state ends at least one anchor
+
+//one signature: a byte matches when (byte & mask) == value, a wildcard byte has a zero mask
+typedef struct
+{
+  char*  name;
+  uint8* value;
+  uint8* mask;
+  uint32 length;
+  uint32 anchor;                      //offset of the anchor (the longest run of fully known bytes)
+  uint32 AnchorLen;
+  uint32 next;                        //next signature ending in the same automaton state (SIG_NONE: last)
+}sSigPattern;
+
+//signatures compiled into an Aho-Corasick automaton over their anchors. The transitions are complete (one per
+//state and byte), the SIG_OUTPUT bit of a transition tells that its target state or one of its suffix states
+//ends an anchor.
+typedef struct
+{
+  const char*  path;
+  char*        text;
+  sSigPattern* patterns;
+  uint8*       bytes;                 //values and masks of all the signatures
+  uint32       count;
+  uint32*      next;                  //states x 256 transitions (target state x 256, | SIG_OUTPUT)
+  uint32*      first;                 //per state, first signature ending there (SIG_NONE: none)
+  uint32*      suffix;                //per state, longest proper suffix state ending a signature (SIG_NONE: none)
+  uint32       states;
+}sSigSet;
+
+boolean Sig_Load(sSigSet* set, char* path);
+void    Sig_Release(sSigSet* set);
+boolean Sig_Report(sElf* elf, const sSigSet* set);
+
+#endif
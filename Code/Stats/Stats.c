@@ -0,0 +1,501 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Run statistics (-stats).
+**
+** The CLI brackets each phase (input load, header validation, each requested operation, output flush) with
+** Stats_Begin/Stats_End. The phases are accumulated by name over all the processed files: calls, wall time,
+** process CPU time (all threads) and page faults. The counters add the bytes read and written and the section and
+** symbol counts of the images. When -stats is not given every call returns at its first test.
+**
+** The statistics are kept by the main thread only.
+*******************************************************************************************************************/
+
+#include<Stats.h>
+
+#if defined(_WIN32)
+  #include<psapi.h>
+  #if defined(_MSC_VER)
+    #pragma comment(lib, "psapi.lib")
+  #endif
+#else
+  #include<time.h>
+  #include<sys/resource.h>
+#endif
+
+//accumulated measures of one phase name
+typedef struct
+{
+  const char* name;
+  uint32      calls;
+  double      wall;
+  double      cpu;
+  uint64      faults;
+}sStatsPhase;
+
+//running phase
+typedef struct
+{
+  uint32 phase;
+  double wall;
+  double cpu;
+  uint64 faults;
+}sStatsFrame;
+
+typedef struct
+{
+  boolean     enabled;
+  double      start;
+  double      StartCpu;
+  uint64      StartFaults;
+  sStatsPhase phases[STATS_MAX_PHASES];
+  uint32      PhasesNbr;
+  sStatsFrame frames[STATS_MAX_DEPTH];
+  uint32      depth;
+  uint64      BytesRead;
+  uint64      BytesWritten;
+  uint32      images;
+  uint64      sections;
+  uint64      symbols;
+}sStats;
+
+static sStats Stats;
+
+static uint32 Stats_FindPhase(const char* name);
+static void   Stats_PrintText(FILE* file, double wall, double cpu, uint64 faults, uint64 peak);
+static void   Stats_PrintJson(FILE* file, double wall, double cpu, uint64 faults, uint64 peak);
+
+/*******************************************************************************************************************
+** Function:    Stats_Enable
+** Description: start the statistics of the run
+** Parameter:   void
+** Return:      void
+*******************************************************************************************************************/
+void Stats_Enable(void)
+{
+  memset(&Stats, 0, sizeof(Stats));
+  Stats.enabled     = TRUE;
+  Stats.start       = Stats_Now();
+  Stats.StartCpu    = Stats_CpuTime();
+  Stats.StartFaults = Stats_PageFaults();
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_IsEnabled
+** Description:
+** Parameter:   void
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Stats_IsEnabled(void)
+{
+  return(Stats.enabled);
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_Begin
+** Description: start a measured phase
+** Parameter:   const char* phase (name, the string must stay valid until the report)
+** Return:      uint32 (frame to give to Stats_End, STATS_NONE when disabled)
+*******************************************************************************************************************/
+uint32 Stats_Begin(const char* phase)
+{
+  sStatsFrame* frame = NULL;
+  uint32       index = 0;
+
+  if(!Stats.enabled || Stats.depth >= STATS_MAX_DEPTH)
+  {
+    return(STATS_NONE);
+  }
+
+  index = Stats_FindPhase(phase);
+
+  if(index == STATS_NONE)
+  {
+    return(STATS_NONE);
+  }
+
+  frame         = &Stats.frames[Stats.depth];
+  frame->phase  = index;
+  frame->faults = Stats_PageFaults();
+  frame->cpu    = Stats_CpuTime();
+  frame->wall   = Stats_Now();
+
+  return(Stats.depth++);
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_End
+** Description: close a phase started by Stats_Begin (and the phases nested in it left open)
+** Parameter:   uint32 frame
+** Return:      void
+*******************************************************************************************************************/
+void Stats_End(uint32 frame)
+{
+  double wall   = 0.0;
+  double cpu    = 0.0;
+  uint64 faults = 0;
+
+  if(frame == STATS_NONE || frame >= Stats.depth)
+  {
+    return;
+  }
+
+  wall   = Stats_Now();
+  cpu    = Stats_CpuTime();
+  faults = Stats_PageFaults();
+
+  while(Stats.depth > frame)
+  {
+    sStatsFrame* open  = &Stats.frames[--Stats.depth];
+    sStatsPhase* phase = &Stats.phases[open->phase];
+
+    phase->calls++;
+    phase->wall   += wall - open->wall;
+    phase->cpu    += cpu - open->cpu;
+    phase->faults += faults - open->faults;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_FindPhase
+** Description: get (or add) the accumulator of a phase name
+** Parameter:   const char* name
+** Return:      uint32 (STATS_NONE if the table is full)
+*******************************************************************************************************************/
+static uint32 Stats_FindPhase(const char* name)
+{
+  for(uint32 i = 0; i < Stats.PhasesNbr; i++)
+  {
+    if(0 == strcmp(Stats.phases[i].name, name))
+    {
+      return(i);
+    }
+  }
+
+  if(Stats.PhasesNbr >= STATS_MAX_PHASES)
+  {
+    return(STATS_NONE);
+  }
+
+  Stats.phases[Stats.PhasesNbr].name = name;
+  return(Stats.PhasesNbr++);
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_AddRead
+** Description: count input bytes
+** Parameter:   uint64 bytes
+** Return:      void
+*******************************************************************************************************************/
+void Stats_AddRead(uint64 bytes)
+{
+  Stats.BytesRead += bytes;
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_AddWritten
+** Description: count output bytes
+** Parameter:   uint64 bytes
+** Return:      void
+*******************************************************************************************************************/
+void Stats_AddWritten(uint64 bytes)
+{
+  Stats.BytesWritten += bytes;
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_AddOutputFile
+** Description: count the size of an output file written by an exporter
+** Parameter:   const char* path
+** Return:      void
+*******************************************************************************************************************/
+void Stats_AddOutputFile(const char* path)
+{
+  FILE* file = NULL;
+
+  if(!Stats.enabled || path == NULL)
+  {
+    return;
+  }
+
+  file = fopen(path, "rb");
+  if(file != NULL)
+  {
+    if(0 == fseek(file, 0, SEEK_END))
+    {
+      long size = ftell(file);
+      Stats.BytesWritten += (size > 0) ? (uint64)size : 0;
+    }
+    fclose(file);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_AddImage
+** Description: count one processed ELF image
+** Parameter:   uint32 sections, uint32 symbols
+** Return:      void
+*******************************************************************************************************************/
+void Stats_AddImage(uint32 sections, uint32 symbols)
+{
+  Stats.images++;
+  Stats.sections += sections;
+  Stats.symbols  += symbols;
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_Report
+** Description: print the statistics of the run: as text on stderr (path "-") or as JSON in the file path
+** Parameter:   const char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Stats_Report(const char* path)
+{
+  double wall   = 0.0;
+  double cpu    = 0.0;
+  uint64 faults = 0;
+  uint64 peak   = 0;
+
+  if(!Stats.enabled)
+  {
+    return(FALSE);
+  }
+
+  wall   = Stats_Now() - Stats.start;
+  cpu    = Stats_CpuTime() - Stats.StartCpu;
+  faults = Stats_PageFaults() - Stats.StartFaults;
+  peak   = Stats_PeakRss();
+
+  if(0 == strcmp(path, "-"))
+  {
+    Stats_PrintText(stderr, wall, cpu, faults, peak);
+  }
+  else
+  {
+    FILE* file = fopen(path, "w");
+
+    if(file == NULL)
+    {
+      printf("\n\r error: Cannot open the file %s !\n\r", path);
+      return(FALSE);
+    }
+    Stats_PrintJson(file, wall, cpu, faults, peak);
+
+    if(fclose(file) != 0)
+    {
+      return(FALSE);
+    }
+  }
+
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_PrintText
+** Description:
+** Parameter:   FILE* file, double wall, double cpu, uint64 faults, uint64 peak
+** Return:      void
+*******************************************************************************************************************/
+static void Stats_PrintText(FILE* file, double wall, double cpu, uint64 faults, uint64 peak)
+{
+  fprintf(file, "\nSTATS :\n\n");
+  fprintf(file, " %-12s%8s%14s%14s%14s\n", "phase", "calls", "wall ms", "cpu ms", "page faults");
+
+  for(uint32 i = 0; i < Stats.PhasesNbr; i++)
+  {
+    const sStatsPhase* phase = &Stats.phases[i];
+
+    fprintf(file, " %-12s%8u%14.3f%14.3f%14llu\n", phase->name, phase->calls, phase->wall * 1e3, phase->cpu * 1e3,
+            (unsigned long long)phase->faults);
+  }
+
+  fprintf(file, " %-12s%8s%14.3f%14.3f%14llu\n\n", "total", "", wall * 1e3, cpu * 1e3, (unsigned long long)faults);
+  fprintf(file, " images        : %u\n",   Stats.images);
+  fprintf(file, " sections      : %llu\n", (unsigned long long)Stats.sections);
+  fprintf(file, " symbols       : %llu\n", (unsigned long long)Stats.symbols);
+  fprintf(file, " bytes read    : %llu\n", (unsigned long long)Stats.BytesRead);
+  fprintf(file, " bytes written : %llu\n", (unsigned long long)Stats.BytesWritten);
+  fprintf(file, " peak RSS kB   : %llu\n", (unsigned long long)peak);
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_PrintJson
+** Description:
+** Parameter:   FILE* file, double wall, double cpu, uint64 faults, uint64 peak
+** Return:      void
+*******************************************************************************************************************/
+static void Stats_PrintJson(FILE* file, double wall, double cpu, uint64 faults, uint64 peak)
+{
+  fprintf(file, "{\n");
+  fprintf(file, "  \"wall_ms\": %.3f,\n",       wall * 1e3);
+  fprintf(file, "  \"cpu_ms\": %.3f,\n",        cpu * 1e3);
+  fprintf(file, "  \"page_faults\": %llu,\n",   (unsigned long long)faults);
+  fprintf(file, "  \"peak_rss_kb\": %llu,\n",   (unsigned long long)peak);
+  fprintf(file, "  \"images\": %u,\n",          Stats.images);
+  fprintf(file, "  \"sections\": %llu,\n",      (unsigned long long)Stats.sections);
+  fprintf(file, "  \"symbols\": %llu,\n",       (unsigned long long)Stats.symbols);
+  fprintf(file, "  \"bytes_read\": %llu,\n",    (unsigned long long)Stats.BytesRead);
+  fprintf(file, "  \"bytes_written\": %llu,\n", (unsigned long long)Stats.BytesWritten);
+  fprintf(file, "  \"phases\": [");
+
+  for(uint32 i = 0; i < Stats.PhasesNbr; i++)
+  {
+    const sStatsPhase* phase = &Stats.phases[i];
+
+    fprintf(file, "%s\n    {\"name\": \"%s\", \"calls\": %u, \"wall_ms\": %.3f, \"cpu_ms\": %.3f, \"page_faults\": %llu}",
+            (i == 0) ? "" : ",", phase->name, phase->calls, phase->wall * 1e3, phase->cpu * 1e3,
+            (unsigned long long)phase->faults);
+  }
+
+  fprintf(file, "\n  ]\n}\n");
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_Now
+** Description: monotonic time
+** Parameter:   void
+** Return:      double (seconds)
+*******************************************************************************************************************/
+double Stats_Now(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER count;
+  LARGE_INTEGER frequency;
+
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return((double)count.QuadPart / (double)frequency.QuadPart);
+#else
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return((double)now.tv_sec + ((double)now.tv_nsec / 1e9));
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_CpuTime
+** Description: user + system CPU time of the process (all threads)
+** Parameter:   void
+** Return:      double (seconds)
+*******************************************************************************************************************/
+double Stats_CpuTime(void)
+{
+#if defined(_WIN32)
+  FILETIME creation, exit, kernel, user;
+  ULARGE_INTEGER k, u;
+
+  if(!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+  {
+    return(0.0);
+  }
+  k.LowPart  = kernel.dwLowDateTime;
+  k.HighPart = kernel.dwHighDateTime;
+  u.LowPart  = user.dwLowDateTime;
+  u.HighPart = user.dwHighDateTime;
+  return((double)(k.QuadPart + u.QuadPart) / 1e7);
+#else
+  struct rusage usage;
+
+  if(0 != getrusage(RUSAGE_SELF, &usage))
+  {
+    return(0.0);
+  }
+  return((double)usage.ru_utime.tv_sec + ((double)usage.ru_utime.tv_usec / 1e6) +
+         (double)usage.ru_stime.tv_sec + ((double)usage.ru_stime.tv_usec / 1e6));
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_PageFaults
+** Description: page faults of the process (minor + major on POSIX)
+** Parameter:   void
+** Return:      uint64
+*******************************************************************************************************************/
+uint64 Stats_PageFaults(void)
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return((uint64)counters.PageFaultCount);
+  }
+  return(0);
+#else
+  struct rusage usage;
+
+  if(0 != getrusage(RUSAGE_SELF, &usage))
+  {
+    return(0);
+  }
+  return((uint64)usage.ru_minflt + (uint64)usage.ru_majflt);
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_ResetPeak
+** Description: restart the peak resident set measurement (Linux only, elsewhere the peak is the process peak)
+** Parameter:   void
+** Return:      void
+*******************************************************************************************************************/
+void Stats_ResetPeak(void)
+{
+#if !defined(_WIN32)
+  FILE* file = fopen("/proc/self/clear_refs", "w");
+
+  if(file != NULL)
+  {
+    fputs("5", file);
+    fclose(file);
+  }
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Stats_PeakRss
+** Description: peak resident set size (since the last Stats_ResetPeak)
+** Parameter:   void
+** Return:      uint64 (kB)
+*******************************************************************************************************************/
+uint64 Stats_PeakRss(void)
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS counters;
+
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+  {
+    return((uint64)counters.PeakWorkingSetSize / 1024U);
+  }
+  return(0);
+#else
+  char          line[MAX_LINE_LEN];
+  uint64        peak  = 0;
+  FILE*         file  = fopen("/proc/self/status", "r");
+  struct rusage usage;
+
+  if(file != NULL)
+  {
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+      if(0 == strncmp(line, "VmHWM:", 6))
+      {
+        peak = (uint64)strtoull(&line[6], NULL, 10);
+        break;
+      }
+    }
+    fclose(file);
+  }
+
+  if(peak == 0 && 0 == getrusage(RUSAGE_SELF, &usage))
+  {
+    peak = (uint64)usage.ru_maxrss;
+  }
+  return(peak);
+#endif
+}
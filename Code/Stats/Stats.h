@@ -0,0 +1,33 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __STATS_H__
+#define __STATS_H__
+
+#include<common.h>
+
+#define STATS_MAX_PHASES   32U      //distinct phase names of a run
+#define STATS_MAX_DEPTH    8U       //nested phases
+#define STATS_NONE         0xFFFFFFFFUL
+
+void    Stats_Enable(void);
+boolean Stats_IsEnabled(void);
+uint32  Stats_Begin(const char* phase);
+void    Stats_End(uint32 frame);
+void    Stats_AddRead(uint64 bytes);
+void    Stats_AddWritten(uint64 bytes);
+void    Stats_AddOutputFile(const char* path);
+void    Stats_AddImage(uint32 sections, uint32 symbols);
+boolean Stats_Report(const char* path);
+
+double  Stats_Now(void);
+double  Stats_CpuTime(void);
+uint64  Stats_PageFaults(void);
+void    Stats_ResetPeak(void);
+uint64  Stats_PeakRss(void);
+
+#endif
@@ -0,0 +1,752 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Content-addressed build store (deduplicated archive of ELF files).
+**
+** The ELF file is cut at the section boundaries (section walk), then each piece is split in content defined chunks
+** with a gear rolling hash (FastCDC style normalized chunking), so an insertion only changes the chunks around it.
+** Every chunk is identified by its BLAKE3 hash and stored once in the append-only pack file of the store. A build
+** is a small text file listing the chunk ordinals (pack order) as runs, the file size and its XXH64 checksum. It
+** is named after the file and its checksum (<file name>-<xxh64>.build), so the builds of a same file name from
+** different build directories are all kept, and archiving the same content again is a no-op.
+**
+** The store is opened once per run (see Store_Open), the chunk index is then kept in memory for all the ingests.
+**
+** Pack record:  "EPCK" <LE32 size> <BLAKE3 hash> <data>
+** Build file:   ELFPARSER-BUILD 1
+**               file <size> <xxh64> <chunks> <name>
+**               <first ordinal> <count>            (one line per run of consecutive ordinals, hexadecimal)
+*******************************************************************************************************************/
+
+#include<Store.h>
+#include<Elf.h>
+#include<Thread.h>
+
+#if defined(_MSC_VER)
+  #define STORE_SEEK(file, offset)  _fseeki64((file), (__int64)(offset), SEEK_SET)
+#else
+  #include<sys/types.h>
+  #include<sys/stat.h>
+  #define STORE_SEEK(file, offset)  fseeko((file), (off_t)(offset), SEEK_SET)
+#endif
+
+#define STORE_NONE      0xFFFFFFFFUL
+#define STORE_MASK_S    0xFFFC000000000000ULL   //14 bits: chunk shorter than STORE_CHUNK_AVG
+#define STORE_MASK_L    0xFFC0000000000000ULL   //10 bits: chunk longer than STORE_CHUNK_AVG
+
+//byte range of the ELF file chunked as a whole (a section or the bytes between two sections)
+typedef struct
+{
+  uint64  offset;
+  uint64  size;
+  uint32* sizes;                     //chunk sizes
+  uint32  count;
+}sStorePiece;
+
+//pieces chunked by one parallel loop
+typedef struct
+{
+  const uint8* file;
+  sStorePiece* pieces;
+}sStorePieceJobs;
+
+//chunk of the ingested (or restored) file
+typedef struct
+{
+  const uint8* data;
+  uint32       size;
+  uint32       ordinal;
+  uint8        hash[HASH_BLAKE3_LEN];
+}sStoreFileChunk;
+
+static uint64 StoreGear[256];
+
+static void    Store_InitGear(void);
+static uint32  Store_Cut(const uint8* data, uint64 size);
+static void    Store_ChunkPiece(uint32 index, void* ctx);
+static int     Store_CompareBounds(const void* a, const void* b);
+static void    Store_HashChunk(uint32 index, void* ctx);
+static boolean Store_AddChunk(sStore* store, const uint8* hash, uint64 offset, uint32 size);
+static uint32  Store_FindChunk(const sStore* store, const uint8* hash);
+static boolean Store_GrowIndex(sStore* store);
+static boolean Store_Append(sStore* store, const sStoreFileChunk* chunk);
+static uint32  Store_SplitFile(sElf* elf, sStorePiece** pieces);
+static boolean Store_PathJoin(char* out, const char* dir, const char* name, const char* ext);
+static const char* Store_BaseName(const char* path);
+static void    Store_PutLe32(uint8* out, uint32 value);
+static uint32  Store_GetLe32(const uint8* in);
+
+/*******************************************************************************************************************
+** Function:    Store_InitGear
+** Description: fill the gear table (fixed pseudo random values, the chunk boundaries must never change)
+** Parameter:   void
+** Return:      void
+*******************************************************************************************************************/
+static void Store_InitGear(void)
+{
+  uint64 state = 0x5EEDC0DE0E1FFA57ULL;
+
+  if(StoreGear[0] != 0)
+  {
+    return;
+  }
+
+  for(uint32 i = 0; i < 256; i++)
+  {
+    /* splitmix64 */
+    uint64 z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    StoreGear[i] = z ^ (z >> 31);
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Cut
+** Description: length of the next content defined chunk: the gear hash is checked against a strict mask below
+**              STORE_CHUNK_AVG and a loose one above, which keeps the chunk sizes close to the average
+** Parameter:   const uint8* data, uint64 size
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 Store_Cut(const uint8* data, uint64 size)
+{
+  uint64 h      = 0;
+  uint32 i      = STORE_CHUNK_MIN;
+  uint32 limit  = (size < STORE_CHUNK_MAX) ? (uint32)size : STORE_CHUNK_MAX;
+  uint32 normal = (limit < STORE_CHUNK_AVG) ? limit : STORE_CHUNK_AVG;
+
+  if(size <= STORE_CHUNK_MIN)
+  {
+    return((uint32)size);
+  }
+
+  for(; i < normal; i++)
+  {
+    h = (h << 1) + StoreGear[data[i]];
+    if((h & STORE_MASK_S) == 0)
+    {
+      return(i + 1);
+    }
+  }
+
+  for(; i < limit; i++)
+  {
+    h = (h << 1) + StoreGear[data[i]];
+    if((h & STORE_MASK_L) == 0)
+    {
+      return(i + 1);
+    }
+  }
+  return(limit);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_ChunkPiece
+** Description: parallel job: split one piece of the file in chunks
+** Parameter:   uint32 index, void* ctx (sStorePieceJobs*)
+** Return:      void
+*******************************************************************************************************************/
+static void Store_ChunkPiece(uint32 index, void* ctx)
+{
+  sStorePieceJobs* jobs  = (sStorePieceJobs*)ctx;
+  sStorePiece*     piece = &jobs->pieces[index];
+  const uint8*     data  = jobs->file + piece->offset;
+  uint64       pos   = 0;
+
+  piece->count = 0;
+
+  while(pos < piece->size)
+  {
+    uint32 size = Store_Cut(data + pos, piece->size - pos);
+
+    piece->sizes[piece->count++] = size;
+    pos += size;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Store_HashChunk
+** Description: parallel job: BLAKE3 hash of one chunk
+** Parameter:   uint32 index, void* ctx (sStoreFileChunk*)
+** Return:      void
+*******************************************************************************************************************/
+static void Store_HashChunk(uint32 index, void* ctx)
+{
+  sStoreFileChunk* chunk = &((sStoreFileChunk*)ctx)[index];
+
+  Hash_Blake3(chunk->data, chunk->size, chunk->hash);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_PutLe32 / Store_GetLe32
+** Description: little endian 32 bit fields of the pack records
+*******************************************************************************************************************/
+static void Store_PutLe32(uint8* out, uint32 value)
+{
+  for(uint32 b = 0; b < 4; b++)
+  {
+    out[b] = (uint8)(value >> (8 * b));
+  }
+}
+
+static uint32 Store_GetLe32(const uint8* in)
+{
+  return((uint32)in[0] | ((uint32)in[1] << 8) | ((uint32)in[2] << 16) | ((uint32)in[3] << 24));
+}
+
+/*******************************************************************************************************************
+** Function:    Store_PathJoin
+** Description: out = dir/name[ext] (MAX_LINE_LEN bytes)
+** Parameter:   char* out, const char* dir, const char* name, const char* ext
+** Return:      boolean (FALSE if the path was truncated)
+*******************************************************************************************************************/
+static boolean Store_PathJoin(char* out, const char* dir, const char* name, const char* ext)
+{
+  int length = snprintf(out, MAX_LINE_LEN, "%s/%s%s", dir, name, ext);
+
+  out[MAX_LINE_LEN - 1] = '\0';
+  return((boolean)(length >= 0 && length < (int)MAX_LINE_LEN));
+}
+
+/*******************************************************************************************************************
+** Function:    Store_BaseName
+** Description: file name part of a path
+** Parameter:   const char* path
+** Return:      const char*
+*******************************************************************************************************************/
+static const char* Store_BaseName(const char* path)
+{
+  const char* name = path;
+
+  for(const char* p = path; *p != '\0'; p++)
+  {
+    if(*p == '/' || *p == '\\' || *p == ':')
+    {
+      name = p + 1;
+    }
+  }
+  return(name);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_GrowIndex
+** Description: double the hash index and insert all the chunks again
+** Parameter:   sStore* store
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Store_GrowIndex(sStore* store)
+{
+  uint32  SlotsNbr = (store->SlotsNbr == 0) ? 1024U : (store->SlotsNbr * 2U);
+  uint32* slots    = (uint32*)calloc(SlotsNbr, sizeof(uint32));
+
+  if(slots == NULL)
+  {
+    return(FALSE);
+  }
+
+  for(uint32 c = 0; c < store->ChunksNbr; c++)
+  {
+    uint32 slot = Store_GetLe32(store->chunks[c].hash) & (SlotsNbr - 1U);
+
+    while(slots[slot] != 0)
+    {
+      slot = (slot + 1U) & (SlotsNbr - 1U);
+    }
+    slots[slot] = c + 1U;
+  }
+
+  free(store->slots);
+  store->slots    = slots;
+  store->SlotsNbr = SlotsNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_FindChunk
+** Description: look a chunk up by hash
+** Parameter:   const sStore* store, const uint8* hash
+** Return:      uint32 (chunk ordinal, STORE_NONE if not stored)
+*******************************************************************************************************************/
+static uint32 Store_FindChunk(const sStore* store, const uint8* hash)
+{
+  uint32 slot = 0;
+
+  if(store->SlotsNbr == 0)
+  {
+    return(STORE_NONE);
+  }
+
+  slot = Store_GetLe32(hash) & (store->SlotsNbr - 1U);
+
+  while(store->slots[slot] != 0)
+  {
+    if(0 == memcmp(store->chunks[store->slots[slot] - 1U].hash, hash, HASH_BLAKE3_LEN))
+    {
+      return(store->slots[slot] - 1U);
+    }
+    slot = (slot + 1U) & (store->SlotsNbr - 1U);
+  }
+  return(STORE_NONE);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_AddChunk
+** Description: add a chunk of the pack to the index (the index is kept at most half full)
+** Parameter:   sStore* store, const uint8* hash, uint64 offset, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Store_AddChunk(sStore* store, const uint8* hash, uint64 offset, uint32 size)
+{
+  uint32 slot = 0;
+
+  if(store->ChunksNbr == store->capacity)
+  {
+    uint32       capacity = (store->capacity == 0) ? 1024U : (store->capacity * 2U);
+    sStoreChunk* chunks   = (sStoreChunk*)realloc(store->chunks, (size_t)capacity * sizeof(sStoreChunk));
+
+    if(chunks == NULL)
+    {
+      return(FALSE);
+    }
+    store->chunks   = chunks;
+    store->capacity = capacity;
+  }
+
+  memcpy(store->chunks[store->ChunksNbr].hash, hash, HASH_BLAKE3_LEN);
+  store->chunks[store->ChunksNbr].offset = offset;
+  store->chunks[store->ChunksNbr].size   = size;
+  store->ChunksNbr++;
+
+  if((store->ChunksNbr * 2U) > store->SlotsNbr)
+  {
+    return(Store_GrowIndex(store));
+  }
+
+  slot = Store_GetLe32(hash) & (store->SlotsNbr - 1U);
+  while(store->slots[slot] != 0)
+  {
+    slot = (slot + 1U) & (store->SlotsNbr - 1U);
+  }
+  store->slots[slot] = store->ChunksNbr;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Open
+** Description: open the pack file of the store and index its chunks (only the record headers are read). A run
+**              opens its store once for all its ingests (@list, -watch), the index is then updated in memory.
+** Parameter:   sStore* store, const char* dir, boolean create (create the store if it does not exist)
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Store_Open(sStore* store, const char* dir, boolean create)
+{
+  char  path[MAX_LINE_LEN];
+  uint8 header[STORE_RECORD_HEADER];
+
+  memset(store, 0, sizeof(sStore));
+  strncpy(store->dir, dir, MAX_LINE_LEN - 1);
+  Store_PathJoin(path, dir, STORE_PACK_NAME, "");
+
+  store->pack = fopen(path, "r+b");
+
+  if(store->pack == NULL && create)
+  {
+#if defined(_WIN32)
+    CreateDirectoryA(dir, NULL);
+#else
+    mkdir(dir, 0777);
+#endif
+    store->pack = fopen(path, "w+b");
+  }
+
+  if(store->pack == NULL)
+  {
+    printf("\n\r error: Cannot open the store %s !\n\r", dir);
+    return(FALSE);
+  }
+
+  while(1 == fread(header, STORE_RECORD_HEADER, 1, store->pack))
+  {
+    uint32 size = Store_GetLe32(&header[4]);
+
+    if(0 != memcmp(header, STORE_PACK_MAGIC, 4) ||
+       !Store_AddChunk(store, &header[8], store->PackSize + STORE_RECORD_HEADER, size))
+    {
+      break;
+    }
+
+    store->PackSize += STORE_RECORD_HEADER + (uint64)size;
+    STORE_SEEK(store->pack, store->PackSize);
+  }
+
+  /* a record cut short (interrupted ingest) is not indexed and is overwritten by the next ingest */
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Close
+** Description: close the pack file and free the index
+** Parameter:   sStore* store
+** Return:      void
+*******************************************************************************************************************/
+void Store_Close(sStore* store)
+{
+  if(store->pack != NULL)
+  {
+    fclose(store->pack);
+  }
+  free(store->chunks);
+  free(store->slots);
+  memset(store, 0, sizeof(sStore));
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Append
+** Description: write a new chunk at the end of the pack and index it
+** Parameter:   sStore* store, const sStoreFileChunk* chunk
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Store_Append(sStore* store, const sStoreFileChunk* chunk)
+{
+  uint8 header[STORE_RECORD_HEADER];
+
+  memcpy(header, STORE_PACK_MAGIC, 4);
+  Store_PutLe32(&header[4], chunk->size);
+  memcpy(&header[8], chunk->hash, HASH_BLAKE3_LEN);
+
+  if(0 != STORE_SEEK(store->pack, store->PackSize) ||
+     1 != fwrite(header, STORE_RECORD_HEADER, 1, store->pack) ||
+     1 != fwrite(chunk->data, chunk->size, 1, store->pack) ||
+     !Store_AddChunk(store, chunk->hash, store->PackSize + STORE_RECORD_HEADER, chunk->size))
+  {
+    printf("\n\r error: Cannot write the store pack !\n\r");
+    return(FALSE);
+  }
+
+  store->PackSize += STORE_RECORD_HEADER + (uint64)chunk->size;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_SplitFile
+** Description: cut the file at the section boundaries: one piece per section with file content and one piece per
+**              range between them (headers, padding, section header table)
+** Parameter:   sElf* elf, sStorePiece** pieces (taken from the image arena, sizes not allocated)
+** Return:      uint32 (number of pieces, 0 on error)
+*******************************************************************************************************************/
+static uint32 Store_SplitFile(sElf* elf, sStorePiece** pieces)
+{
+  uint32       size      = elf->size;
+  sElfSection* sections  = NULL;
+  uint32       count     = 0;
+  uint32       PiecesNbr = 0;
+  uint64       cursor    = 0;
+  uint64*      bounds    = NULL;
+  uint32       BoundsNbr = 0;
+
+  if(!Elf_GetSections(elf, &sections, &count))
+  {
+    return(0);
+  }
+
+  bounds  = (uint64*)Arena_Alloc(&elf->arena, ((size_t)count * 2U + 2U) * sizeof(uint64));
+  *pieces = (sStorePiece*)Arena_Calloc(&elf->arena, (size_t)count * 2U + 2U, sizeof(sStorePiece));
+
+  if(bounds == NULL || *pieces == NULL)
+  {
+    return(0);
+  }
+
+  for(uint32 s = 0; s < count; s++)
+  {
+    if(sections[s].data != NULL && sections[s].size > 0)
+    {
+      uint64 start = (uint64)(sections[s].data - elf->Buffer);
+      uint64 end   = start + sections[s].size;
+
+      if(start < size)
+      {
+        bounds[BoundsNbr++] = start;
+        bounds[BoundsNbr++] = (end < size) ? end : size;
+      }
+    }
+  }
+  bounds[BoundsNbr++] = size;
+
+  /* every distinct boundary closes a piece */
+  qsort(bounds, BoundsNbr, sizeof(uint64), Store_CompareBounds);
+
+  for(uint32 i = 0; i < BoundsNbr; i++)
+  {
+    if(bounds[i] > cursor)
+    {
+      (*pieces)[PiecesNbr].offset = cursor;
+      (*pieces)[PiecesNbr].size   = bounds[i] - cursor;
+      PiecesNbr++;
+      cursor = bounds[i];
+    }
+  }
+
+  return(PiecesNbr);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_CompareBounds
+** Description: qsort callback: file offsets in increasing order
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int Store_CompareBounds(const void* a, const void* b)
+{
+  uint64 x = *(const uint64*)a;
+  uint64 y = *(const uint64*)b;
+
+  return((x < y) ? -1 : ((x > y) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    Store_IsBuild
+** Description: check the build file header
+** Parameter:   char* Buffer, uint32 size
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Store_IsBuild(char* Buffer, uint32 size)
+{
+  return((boolean)(Buffer != NULL && size >= STORE_BUILD_MAGIC_LEN && 0 == memcmp(Buffer, STORE_BUILD_MAGIC, STORE_BUILD_MAGIC_LEN)));
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Ingest
+** Description: archive an opened ELF file in the opened store as the build <file name>-<xxh64>.build. Chunking
+**              and hashing run in parallel, the new chunks are appended to the pack in file order.
+** Parameter:   sStore* store, sElf* elf, const char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Store_Ingest(sStore* store, sElf* elf, const char* path)
+{
+  char*            Elf       = elf->Buffer;
+  uint32           size      = elf->size;
+  uint64           checksum  = Hash_Xxh64(Elf, size, 0);
+  char             suffix[32];
+  char             BuildPath[MAX_LINE_LEN];
+  sStorePiece*     pieces    = NULL;
+  uint32           PiecesNbr = 0;
+  sStoreFileChunk* chunks    = NULL;
+  uint32           ChunksNbr = 0;
+  uint32*          SizesBuf  = NULL;
+  sStorePieceJobs  jobs;
+  uint32           NewNbr    = 0;
+  uint64           NewSize   = 0;
+  FILE*            build     = NULL;
+  boolean          result    = TRUE;
+
+  snprintf(suffix, sizeof(suffix), "-%016llx%s", (unsigned long long)checksum, STORE_BUILD_EXT);
+  if(!Store_PathJoin(BuildPath, store->dir, Store_BaseName(path), suffix))
+  {
+    printf("\n\r error: The build path of %s is too long !\n\r", path);
+    return(FALSE);
+  }
+
+  /* same name and checksum: the same content is already archived */
+  build = fopen(BuildPath, "rb");
+  if(build != NULL)
+  {
+    fclose(build);
+    printf("\n\r Stored %s : already in the store\n\r", BuildPath);
+    return(TRUE);
+  }
+
+  PiecesNbr = Store_SplitFile(elf, &pieces);
+
+  if(PiecesNbr == 0)
+  {
+    printf("\n\r error: Cannot split the file %s in chunks !\n\r", path);
+    return(FALSE);
+  }
+
+  /* at most one chunk per STORE_CHUNK_MIN bytes plus the last chunk of each piece */
+  SizesBuf = (uint32*)Arena_Alloc(&elf->arena, ((size_t)size / STORE_CHUNK_MIN + PiecesNbr) * sizeof(uint32));
+  chunks   = (sStoreFileChunk*)Arena_Alloc(&elf->arena, ((size_t)size / STORE_CHUNK_MIN + PiecesNbr) * sizeof(sStoreFileChunk));
+
+  if(SizesBuf == NULL || chunks == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  for(uint32 p = 0, next = 0; p < PiecesNbr; p++)
+  {
+    pieces[p].sizes = &SizesBuf[next];
+    next += (uint32)(pieces[p].size / STORE_CHUNK_MIN) + 1U;
+  }
+
+  Store_InitGear();
+  jobs.file   = (const uint8*)Elf;
+  jobs.pieces = pieces;
+  Thread_ParallelFor(PiecesNbr, Store_ChunkPiece, &jobs);
+
+  for(uint32 p = 0; p < PiecesNbr; p++)
+  {
+    uint64 offset = pieces[p].offset;
+
+    for(uint32 c = 0; c < pieces[p].count; c++)
+    {
+      chunks[ChunksNbr].data = (const uint8*)Elf + offset;
+      chunks[ChunksNbr].size = pieces[p].sizes[c];
+      offset += pieces[p].sizes[c];
+      ChunksNbr++;
+    }
+  }
+
+  Thread_ParallelFor(ChunksNbr, Store_HashChunk, chunks);
+
+  for(uint32 c = 0; c < ChunksNbr && result; c++)
+  {
+    chunks[c].ordinal = Store_FindChunk(store, chunks[c].hash);
+
+    if(chunks[c].ordinal == STORE_NONE)
+    {
+      chunks[c].ordinal = store->ChunksNbr;
+      result = Store_Append(store, &chunks[c]);
+      NewNbr++;
+      NewSize += chunks[c].size;
+    }
+  }
+
+  /* the chunks must be on disk before the build refers to them */
+  if(result && 0 == fflush(store->pack) && NULL != (build = fopen(BuildPath, "wb")))
+  {
+    fprintf(build, "%s\n", STORE_BUILD_MAGIC);
+    fprintf(build, "file %x %llx %x %s\n", size, (unsigned long long)checksum, ChunksNbr,
+            Store_BaseName(path));
+
+    for(uint32 c = 0; c < ChunksNbr; )
+    {
+      uint32 run = 1;
+
+      while(c + run < ChunksNbr && chunks[c + run].ordinal == chunks[c].ordinal + run)
+      {
+        run++;
+      }
+      fprintf(build, "%x %x\n", chunks[c].ordinal, run);
+      c += run;
+    }
+    fclose(build);
+
+    printf("\n\r Stored %s : %u bytes, %u chunks, %u new (%llu bytes)\n\r", BuildPath, size, ChunksNbr, NewNbr,
+           (unsigned long long)NewSize);
+    printf(" Store %s : %u chunks, %llu bytes\n\r", store->dir, store->ChunksNbr, (unsigned long long)store->PackSize);
+  }
+  else
+  {
+    printf("\n\r error: Cannot save the build %s !\n\r", BuildPath);
+    result = FALSE;
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Store_Restore
+** Description: rebuild an archived file from its build file (the store is the directory of the build file).
+**              Every chunk is checked against its hash and the whole file against its checksum.
+** Parameter:   char* Build, uint32 BuildSize, const char* BuildPath, uint32* size
+** Return:      char* (allocated file content, NULL on error)
+*******************************************************************************************************************/
+char* Store_Restore(char* Build, uint32 BuildSize, const char* BuildPath, uint32* size)
+{
+  sStore             store;
+  char               dir[MAX_LINE_LEN];
+  char               name[MAX_LINE_LEN];
+  unsigned int       FileSize  = 0;
+  unsigned int       ChunksNbr = 0;
+  unsigned long long checksum  = 0;
+  char*              line      = NULL;
+  char*              file      = NULL;
+  sStoreFileChunk*   chunks    = NULL;
+  uint32             count     = 0;
+  uint64             pos       = 0;
+  boolean            result    = TRUE;
+
+  strncpy(dir, BuildPath, MAX_LINE_LEN - 1);
+  dir[MAX_LINE_LEN - 1] = '\0';
+  dir[Store_BaseName(dir) - dir] = '\0';
+  if(dir[0] == '\0')
+  {
+    strcpy(dir, ".");
+  }
+
+  line = strchr(Build, '\n');
+
+  if(line == NULL || 4 != sscanf(line + 1, "file %x %llx %x %[^\r\n]", &FileSize, &checksum, &ChunksNbr, name) ||
+     !Store_Open(&store, dir, FALSE))
+  {
+    printf("\n\r error: Bad build file %s !\n\r", BuildPath);
+    return(NULL);
+  }
+
+  file   = (char*)malloc((size_t)FileSize + 1U);
+  chunks = (sStoreFileChunk*)malloc(((size_t)ChunksNbr + 1U) * sizeof(sStoreFileChunk));
+
+  line = strchr(line + 1, '\n');
+
+  while(result && line != NULL && file != NULL && chunks != NULL && (uint32)(line - Build) + 1U < BuildSize)
+  {
+    unsigned int first = 0;
+    unsigned int run   = 0;
+
+    if(2 == sscanf(line + 1, "%x %x", &first, &run))
+    {
+      for(uint32 c = first; c < first + run && result; c++)
+      {
+        result = (boolean)(c < store.ChunksNbr && count < ChunksNbr && pos + store.chunks[c].size <= FileSize &&
+                           0 == STORE_SEEK(store.pack, store.chunks[c].offset) &&
+                           (store.chunks[c].size == 0 || 1 == fread(file + pos, store.chunks[c].size, 1, store.pack)));
+        if(result)
+        {
+          chunks[count].data    = (const uint8*)file + pos;
+          chunks[count].size    = store.chunks[c].size;
+          chunks[count].ordinal = c;
+          pos += store.chunks[c].size;
+          count++;
+        }
+      }
+    }
+    line = strchr(line + 1, '\n');
+  }
+
+  if(result && file != NULL && chunks != NULL && pos == FileSize && count == ChunksNbr)
+  {
+    Thread_ParallelFor(count, Store_HashChunk, chunks);
+
+    for(uint32 c = 0; c < count && result; c++)
+    {
+      result = (boolean)(0 == memcmp(chunks[c].hash, store.chunks[chunks[c].ordinal].hash, HASH_BLAKE3_LEN));
+    }
+    result = (boolean)(result && Hash_Xxh64(file, FileSize, 0) == (uint64)checksum);
+  }
+  else
+  {
+    result = FALSE;
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: The build %s cannot be restored, the store is incomplete or corrupted !\n\r", BuildPath);
+    free(file);
+    file = NULL;
+  }
+  else
+  {
+    file[FileSize] = '\0';
+    *size = FileSize;
+  }
+
+  free(chunks);
+  Store_Close(&store);
+  return(file);
+}
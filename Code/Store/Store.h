@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __STORE_H__
+#define __STORE_H__
+
+#include<common.h>
+#include<Elf.h>
+#include<Hash.h>
+
+#define STORE_BUILD_MAGIC       "ELFPARSER-BUILD 1"
+#define STORE_BUILD_MAGIC_LEN   17U
+#define STORE_BUILD_EXT         ".build"
+#define STORE_PACK_NAME         "chunks.pack"
+#define STORE_PACK_MAGIC        "EPCK"
+#define STORE_RECORD_HEADER     (4U + 4U + HASH_BLAKE3_LEN)   //magic, size, hash
+
+#define STORE_CHUNK_MIN         1024U       //content defined chunking limits
+#define STORE_CHUNK_AVG         4096U
+#define STORE_CHUNK_MAX         32768U
+
+//one unique chunk of the pack file
+typedef struct
+{
+  uint8  hash[HASH_BLAKE3_LEN];
+  uint64 offset;                     //offset of the chunk data in the pack
+  uint32 size;
+}sStoreChunk;
+
+//chunk store: append-only pack file and its in-memory index
+typedef struct
+{
+  char         dir[MAX_LINE_LEN];
+  FILE*        pack;
+  uint64       PackSize;
+  sStoreChunk* chunks;               //in pack order, the position is the chunk ordinal
+  uint32       ChunksNbr;
+  uint32       capacity;
+  uint32*      slots;                //hash index: chunk ordinal + 1, 0 if empty
+  uint32       SlotsNbr;
+}sStore;
+
+boolean Store_Open(sStore* store, const char* dir, boolean create);
+void    Store_Close(sStore* store);
+boolean Store_IsBuild(char* Buffer, uint32 size);
+boolean Store_Ingest(sStore* store, sElf* elf, const char* path);
+char*   Store_Restore(char* Build, uint32 BuildSize, const char* BuildPath, uint32* size);
+
+#endif
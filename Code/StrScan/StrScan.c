@@ -0,0 +1,903 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Printable string extraction (-strings).
+**
+** The scanned content is a stream made of one or more segments (a section, or address contiguous sections of the
+** load image). The stream is classified STRSCAN_BLOCK bytes at a time into two bit masks, printable characters
+** and zero bytes (SSE2 compares and movemask when available). The runs of set bits of a mask are the strings:
+**   ASCII     : the printable mask itself.
+**   UTF-16 LE : a printable byte followed by a zero byte, the even and the odd byte positions are two lanes.
+**   UTF-16 BE : a zero byte followed by a printable byte, same two lanes.
+** A run is found with a bit scan, so a block without any string boundary costs a few instructions, and the runs
+** shorter than the minimum length are skipped by a shift-and of the mask (see StrScan_Runs). The blocks
+** crossing a segment end are copied to a staging buffer; the stream is followed by at least one non-printable
+** padding byte so that every run is closed by the scan itself.
+*******************************************************************************************************************/
+
+#include<StrScan.h>
+#include<Image.h>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+  #define STRSCAN_SSE2
+  #include<emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+  #include<intrin.h>
+#endif
+
+#define STRSCAN_PAD_BYTE    0x01U     //neither printable nor zero
+#define STRSCAN_LANES       5U
+#define STRSCAN_LANE_ASCII  0U
+#define STRSCAN_LANE_LE     1U        //+ byte parity
+#define STRSCAN_LANE_BE     3U        //+ byte parity
+#define STRSCAN_TEXT_CHUNK  256U
+#define STRSCAN_OUT_BUFFER  16384U
+
+#define STRSCAN_IS_PRINTABLE(c)  ((((c) >= 0x20U) && ((c) < 0x7FU)) || ((c) == 0x09U))
+
+//contiguous piece of a scanned stream
+typedef struct
+{
+  uint64       addr;
+  const uint8* data;
+  uint64       size;
+  uint64       offset;                //position in the stream
+  const char*  name;
+}sStrScanSegment;
+
+//one reported string, offset of its first byte in the stream, length in characters
+typedef struct
+{
+  uint64 offset;
+  uint64 length;
+  uint32 encoding;
+}sStrScanHit;
+
+//run of set bits still open at the end of the last block
+typedef struct
+{
+  boolean open;
+  uint64  start;
+}sStrScanLane;
+
+//scan of one stream
+typedef struct
+{
+  const sStrScanSpec*    spec;
+  const sStrScanSegment* segments;
+  uint32                 SegmentsNbr;
+  uint64                 size;
+  sStrScanLane           lanes[STRSCAN_LANES];
+  sStrScanHit*           hits;
+  uint32                 HitsNbr;
+  uint32                 capacity;
+  boolean                failed;
+}sStrScanState;
+
+//report lines waiting to be written
+typedef struct
+{
+  char   buffer[STRSCAN_OUT_BUFFER];
+  size_t fill;
+}sStrScanOut;
+
+static const char* StrScan_Encoding(uint32 encoding);
+static uint32  StrScan_Ctz(uint64 x);
+static uint32  StrScan_Msb(uint64 x);
+static uint32  StrScan_EvenBits(uint64 x);
+static void    StrScan_Classify(const uint8* p, uint64* printable, uint64* zero);
+static void    StrScan_Emit(sStrScanState* scan, uint32 lane, uint64 end);
+static void    StrScan_Runs(sStrScanState* scan, uint32 lane, uint64 mask, uint32 bits, uint64 base);
+static boolean StrScan_ScanStream(sStrScanState* scan);
+static int     StrScan_CompareHits(const void* a, const void* b);
+static void    StrScan_DropTwins(sStrScanState* scan, uint32 keep);
+static void    StrScan_Put(sStrScanOut* out, const char* data, size_t size);
+static void    StrScan_PutField(sStrScanOut* out, const char* text, size_t width);
+static void    StrScan_PrintHits(const sStrScanState* scan);
+static uint32  StrScan_Stream(const sStrScanSpec* spec, sStrScanSegment* segments, uint32 count, uint64* scanned);
+
+/*******************************************************************************************************************
+** Function:    StrScan_ParseSpec
+** Description: parse "[min=<n>][,enc=ascii|utf16|utf16le|utf16be|all][,sec=<name>[+<name>...]|,image]", "-" keeps
+**              the defaults (ASCII strings of at least 4 characters in every section with a content)
+** Parameter:   sStrScanSpec* spec, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean StrScan_ParseSpec(sStrScanSpec* spec, const char* text)
+{
+  char*   item   = NULL;
+  boolean result = TRUE;
+
+  memset(spec, 0, sizeof(sStrScanSpec));
+  spec->min       = STRSCAN_DEFAULT_MIN;
+  spec->encodings = STRSCAN_ASCII;
+
+  if(text == NULL || strlen(text) >= sizeof(spec->copy))
+  {
+    return(FALSE);
+  }
+  strcpy(spec->copy, text);
+
+  if(0 == strcmp(spec->copy, "-"))
+  {
+    return(TRUE);
+  }
+
+  for(item = strtok(spec->copy, ","); item != NULL && result; item = strtok(NULL, ","))
+  {
+    char* value = strchr(item, '=');
+
+    if(0 == strcmp(item, "image"))
+    {
+      spec->image = TRUE;
+      continue;
+    }
+
+    if(value == NULL)
+    {
+      result = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    if(0 == strcmp(item, "min"))
+    {
+      char*         end    = NULL;
+      unsigned long number = strtoul(value, &end, 0);
+
+      spec->min = (uint32)number;
+      result    = (boolean)(end != value && *end == '\0' && number > 0 && number <= 0xFFFFUL);
+    }
+    else if(0 == strcmp(item, "enc"))
+    {
+      if(0 == strcmp(value, "ascii"))                                        { spec->encodings = STRSCAN_ASCII;   }
+      else if(0 == strcmp(value, "utf16") || 0 == strcmp(value, "utf16le")) { spec->encodings = STRSCAN_UTF16LE; }
+      else if(0 == strcmp(value, "utf16be"))                                 { spec->encodings = STRSCAN_UTF16BE; }
+      else if(0 == strcmp(value, "all"))
+      {
+        spec->encodings = STRSCAN_ASCII | STRSCAN_UTF16LE | STRSCAN_UTF16BE;
+      }
+      else
+      {
+        result = FALSE;
+      }
+    }
+    else if(0 == strcmp(item, "sec"))
+    {
+      for(char* name = value; name != NULL && result; )
+      {
+        char* next = strchr(name, '+');
+
+        if(next != NULL)
+        {
+          *next++ = '\0';
+        }
+        if(*name == '\0' || spec->SectionsNbr == STRSCAN_MAX_SECTIONS)
+        {
+          result = FALSE;
+        }
+        else
+        {
+          spec->sections[spec->SectionsNbr++] = name;
+        }
+        name = next;
+      }
+    }
+    else
+    {
+      result = FALSE;
+    }
+  }
+
+  if(result && spec->image && spec->SectionsNbr > 0)
+  {
+    result = FALSE;
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Invalid strings request '%s' (min=<n>,enc=ascii|utf16|utf16be|all,sec=<name>[+<name>]|image) !\n\r",
+           text);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Encoding
+** Description: name of an encoding
+** Parameter:   uint32 encoding (one STRSCAN_ASCII, STRSCAN_UTF16LE or STRSCAN_UTF16BE bit)
+** Return:      const char*
+*******************************************************************************************************************/
+static const char* StrScan_Encoding(uint32 encoding)
+{
+  return((encoding == STRSCAN_ASCII) ? "ascii" : ((encoding == STRSCAN_UTF16LE) ? "utf16le" : "utf16be"));
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Ctz
+** Description: index of the lowest set bit (x != 0)
+** Parameter:   uint64 x
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 StrScan_Ctz(uint64 x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index = 0;
+
+  _BitScanForward64(&index, x);
+  return((uint32)index);
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+
+  if((uint32)x != 0U)
+  {
+    _BitScanForward(&index, (uint32)x);
+    return((uint32)index);
+  }
+  _BitScanForward(&index, (uint32)(x >> 32));
+  return((uint32)index + 32U);
+#else
+  return((uint32)__builtin_ctzll(x));
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Msb
+** Description: index of the highest set bit (x != 0)
+** Parameter:   uint64 x
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 StrScan_Msb(uint64 x)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index = 0;
+
+  _BitScanReverse64(&index, x);
+  return((uint32)index);
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+
+  if((uint32)(x >> 32) != 0U)
+  {
+    _BitScanReverse(&index, (uint32)(x >> 32));
+    return((uint32)index + 32U);
+  }
+  _BitScanReverse(&index, (uint32)x);
+  return((uint32)index);
+#else
+  return(63U - (uint32)__builtin_clzll(x));
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_EvenBits
+** Description: gather the bits 0, 2, 4, ... 62 of x in the bits 0 to 31 of the result
+** Parameter:   uint64 x
+** Return:      uint32
+*******************************************************************************************************************/
+static uint32 StrScan_EvenBits(uint64 x)
+{
+  x &= 0x5555555555555555ULL;
+  x  = (x | (x >> 1))  & 0x3333333333333333ULL;
+  x  = (x | (x >> 2))  & 0x0F0F0F0F0F0F0F0FULL;
+  x  = (x | (x >> 4))  & 0x00FF00FF00FF00FFULL;
+  x  = (x | (x >> 8))  & 0x0000FFFF0000FFFFULL;
+  x  = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+  return((uint32)x);
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Classify
+** Description: bit i of printable is set when p[i] is a printable ASCII character (0x20 to 0x7E, or a tab), bit i
+**              of zero when p[i] is 0 (STRSCAN_BLOCK bytes)
+** Parameter:   const uint8* p, uint64* printable, uint64* zero
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_Classify(const uint8* p, uint64* printable, uint64* zero)
+{
+#if defined(STRSCAN_SSE2)
+  const __m128i low  = _mm_set1_epi8(0x1F);
+  const __m128i high = _mm_set1_epi8(0x7F);
+  const __m128i tab  = _mm_set1_epi8(0x09);
+  const __m128i none = _mm_setzero_si128();
+  uint64        pm   = 0;
+  uint64        zm   = 0;
+
+  for(uint32 i = 0; i < STRSCAN_BLOCK; i += 16U)
+  {
+    __m128i v = _mm_loadu_si128((const __m128i*)(p + i));
+
+    //the bytes from 0x80 are negative in the signed compares, so they fail the low bound
+    __m128i is = _mm_or_si128(_mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high)), _mm_cmpeq_epi8(v, tab));
+
+    pm |= (uint64)(uint32)_mm_movemask_epi8(is) << i;
+    zm |= (uint64)(uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(v, none)) << i;
+  }
+  *printable = pm;
+  *zero      = zm;
+#else
+  uint64 pm = 0;
+  uint64 zm = 0;
+
+  for(uint32 i = 0; i < STRSCAN_BLOCK; i++)
+  {
+    uint8 c = p[i];
+
+    pm |= (uint64)STRSCAN_IS_PRINTABLE(c) << i;
+    zm |= (uint64)(c == 0U) << i;
+  }
+  *printable = pm;
+  *zero      = zm;
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Emit
+** Description: close the open run of a lane at the unit index end, record it when it is long enough
+** Parameter:   sStrScanState* scan, uint32 lane, uint64 end
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_Emit(sStrScanState* scan, uint32 lane, uint64 end)
+{
+  sStrScanLane* run    = &scan->lanes[lane];
+  uint64        length = end - run->start;
+
+  run->open = FALSE;
+
+  if(length < scan->spec->min || scan->failed)
+  {
+    return;
+  }
+
+  if(scan->HitsNbr == scan->capacity)
+  {
+    uint32       capacity = (scan->capacity == 0) ? 256U : (scan->capacity * 2U);
+    sStrScanHit* hits     = (sStrScanHit*)realloc(scan->hits, (size_t)capacity * sizeof(sStrScanHit));
+
+    if(hits == NULL)
+    {
+      scan->failed = TRUE;
+      return;
+    }
+    scan->hits     = hits;
+    scan->capacity = capacity;
+  }
+
+  if(lane == STRSCAN_LANE_ASCII)
+  {
+    scan->hits[scan->HitsNbr].offset   = run->start;
+    scan->hits[scan->HitsNbr].encoding = STRSCAN_ASCII;
+  }
+  else
+  {
+    uint32 parity = (lane - STRSCAN_LANE_LE) & 1U;
+
+    scan->hits[scan->HitsNbr].offset   = 2U * run->start + parity;
+    scan->hits[scan->HitsNbr].encoding = (lane < STRSCAN_LANE_BE) ? STRSCAN_UTF16LE : STRSCAN_UTF16BE;
+  }
+  scan->hits[scan->HitsNbr].length = length;
+  scan->HitsNbr++;
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Runs
+** Description: follow the runs of set bits of one block mask of a lane (bit i is the unit base + i). The run open
+**              since an earlier block is closed at the first clear bit, the last run reaching the end of the block
+**              is left open. The runs inside the block are only visited when they are long enough: their start is
+**              a bit of the window mask, where min set bits begin.
+** Parameter:   sStrScanState* scan, uint32 lane, uint64 mask, uint32 bits, uint64 base
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_Runs(sStrScanState* scan, uint32 lane, uint64 mask, uint32 bits, uint64 base)
+{
+  sStrScanLane* run     = &scan->lanes[lane];
+  uint64        full    = (bits == 64U) ? ~0ULL : ((1ULL << bits) - 1U);
+  uint64        windows = 0;
+  uint32        pos     = 0;
+  uint32        last    = bits;         //start of the run reaching the end of the block (bits: none)
+
+  mask &= full;
+
+  if(run->open)
+  {
+    uint64 rest = ~mask & full;
+
+    if(rest == 0)
+    {
+      return;
+    }
+    pos = StrScan_Ctz(rest);
+    StrScan_Emit(scan, lane, base + pos);
+    mask &= ~0ULL << pos;
+  }
+
+  if(mask == 0)
+  {
+    return;
+  }
+
+  if(((mask >> (bits - 1U)) & 1U) != 0)
+  {
+    uint64 clear = ~mask & full & (~0ULL << pos);
+
+    last  = (clear == 0) ? pos : (StrScan_Msb(clear) + 1U);
+    mask &= (1ULL << last) - 1U;
+  }
+
+  //windows of 1, 2, 4 ... then min bits (the top bit is clear, so the windows vanish before a shift reaches 32)
+  windows = mask;
+  for(uint32 width = 1; width < scan->spec->min && windows != 0; )
+  {
+    uint32 step = (2U * width <= scan->spec->min) ? width : (scan->spec->min - width);
+
+    windows &= windows >> step;
+    width   += step;
+  }
+
+  while(windows != 0)
+  {
+    uint32 start = StrScan_Ctz(windows);
+    uint32 end   = start + StrScan_Ctz(~(mask >> start));
+
+    run->start = base + start;
+    StrScan_Emit(scan, lane, base + end);
+    windows &= ~0ULL << end;
+  }
+
+  if(last < bits)
+  {
+    run->open  = TRUE;
+    run->start = base + last;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_ScanStream
+** Description: classify the stream block by block and record its strings. The blocks are read in place, except
+**              the ones crossing a segment end (or the stream end, padded with STRSCAN_PAD_BYTE).
+** Parameter:   sStrScanState* scan
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean StrScan_ScanStream(sStrScanState* scan)
+{
+  uint8   staging[STRSCAN_BLOCK + 1U];
+  boolean ascii  = (boolean)((scan->spec->encodings & STRSCAN_ASCII) != 0);
+  boolean le     = (boolean)((scan->spec->encodings & STRSCAN_UTF16LE) != 0);
+  boolean be     = (boolean)((scan->spec->encodings & STRSCAN_UTF16BE) != 0);
+  uint64  need   = (le || be) ? (STRSCAN_BLOCK + 1U) : STRSCAN_BLOCK;
+  uint64  blocks = scan->size / STRSCAN_BLOCK + 1U;    //at least one padding byte after the content
+  uint32  s      = 0;
+
+  memset(scan->lanes, 0, sizeof(scan->lanes));
+
+  for(uint64 b = 0; b < blocks && !scan->failed; b++)
+  {
+    uint64       o = b * STRSCAN_BLOCK;
+    const uint8* p = NULL;
+    uint64       printable = 0;
+    uint64       zero      = 0;
+
+    while(s < scan->SegmentsNbr && scan->segments[s].offset + scan->segments[s].size <= o)
+    {
+      s++;
+    }
+
+    if(s < scan->SegmentsNbr && o + need <= scan->segments[s].offset + scan->segments[s].size)
+    {
+      p = scan->segments[s].data + (size_t)(o - scan->segments[s].offset);
+    }
+    else
+    {
+      uint32 j = s;
+
+      for(uint32 i = 0; i < (uint32)need; i++)
+      {
+        while(j < scan->SegmentsNbr && scan->segments[j].offset + scan->segments[j].size <= o + i)
+        {
+          j++;
+        }
+        staging[i] = (j < scan->SegmentsNbr) ? scan->segments[j].data[o + i - scan->segments[j].offset]
+                                             : (uint8)STRSCAN_PAD_BYTE;
+      }
+      p = staging;
+    }
+
+    StrScan_Classify(p, &printable, &zero);
+
+    if(ascii)
+    {
+      StrScan_Runs(scan, STRSCAN_LANE_ASCII, printable, 64U, o);
+    }
+
+    if(le || be)
+    {
+      //masks of the bytes one position further: the block shifted, and the first byte after the block
+      uint64 NextPrintable = (printable >> 1) | ((uint64)STRSCAN_IS_PRINTABLE(p[STRSCAN_BLOCK]) << 63);
+      uint64 NextZero      = (zero >> 1) | ((uint64)(p[STRSCAN_BLOCK] == 0U) << 63);
+
+      if(le)
+      {
+        uint64 units = printable & NextZero;
+
+        StrScan_Runs(scan, STRSCAN_LANE_LE,      StrScan_EvenBits(units),      32U, o / 2U);
+        StrScan_Runs(scan, STRSCAN_LANE_LE + 1U, StrScan_EvenBits(units >> 1), 32U, o / 2U);
+      }
+
+      if(be)
+      {
+        uint64 units = zero & NextPrintable;
+
+        StrScan_Runs(scan, STRSCAN_LANE_BE,      StrScan_EvenBits(units),      32U, o / 2U);
+        StrScan_Runs(scan, STRSCAN_LANE_BE + 1U, StrScan_EvenBits(units >> 1), 32U, o / 2U);
+      }
+    }
+  }
+
+  return((boolean)!scan->failed);
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_CompareHits
+** Description: qsort callback, stream order then encoding
+** Parameter:   const void* a, const void* b
+** Return:      int
+*******************************************************************************************************************/
+static int StrScan_CompareHits(const void* a, const void* b)
+{
+  const sStrScanHit* x = (const sStrScanHit*)a;
+  const sStrScanHit* y = (const sStrScanHit*)b;
+
+  if(x->offset != y->offset)
+  {
+    return((x->offset < y->offset) ? -1 : 1);
+  }
+  return((x->encoding < y->encoding) ? -1 : ((x->encoding > y->encoding) ? 1 : 0));
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_DropTwins
+** Description: "A\0B\0" preceded by a zero byte reads as the same characters in UTF-16 LE and in UTF-16 BE (one
+**              byte earlier). Of such a pair only the encoding of the target byte order is kept (sorted hits).
+** Parameter:   sStrScanState* scan, uint32 keep (STRSCAN_UTF16LE or STRSCAN_UTF16BE)
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_DropTwins(sStrScanState* scan, uint32 keep)
+{
+  uint32 count = 0;
+
+  //the twin of a BE hit at o is the LE hit at o + 1, at most two entries further (an ASCII hit may sit at o + 1);
+  //the dropped hit is marked with a zero length
+  for(uint32 h = 0; h < scan->HitsNbr; h++)
+  {
+    sStrScanHit* hit = &scan->hits[h];
+
+    for(uint32 k = h + 1U; k < scan->HitsNbr && k <= h + 2U && hit->encoding == STRSCAN_UTF16BE; k++)
+    {
+      if(scan->hits[k].encoding == STRSCAN_UTF16LE && scan->hits[k].offset == hit->offset + 1U &&
+         scan->hits[k].length == hit->length)
+      {
+        ((keep == STRSCAN_UTF16LE) ? hit : &scan->hits[k])->length = 0;
+        break;
+      }
+    }
+  }
+
+  for(uint32 h = 0; h < scan->HitsNbr; h++)
+  {
+    if(scan->hits[h].length > 0)
+    {
+      scan->hits[count++] = scan->hits[h];
+    }
+  }
+  scan->HitsNbr = count;
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Put
+** Description: append to the output buffer (written to stdout when full, large pieces are written directly)
+** Parameter:   sStrScanOut* out, const char* data, size_t size
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_Put(sStrScanOut* out, const char* data, size_t size)
+{
+  if(out->fill + size > sizeof(out->buffer))
+  {
+    fwrite(out->buffer, 1, out->fill, stdout);
+    out->fill = 0;
+
+    if(size > sizeof(out->buffer))
+    {
+      fwrite(data, 1, size, stdout);
+      return;
+    }
+  }
+  memcpy(&out->buffer[out->fill], data, size);
+  out->fill += size;
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_PutField
+** Description: append a text left aligned in a column of width characters
+** Parameter:   sStrScanOut* out, const char* text, size_t width
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_PutField(sStrScanOut* out, const char* text, size_t width)
+{
+  static const char blanks[] = "                        ";
+  size_t            size     = strlen(text);
+
+  StrScan_Put(out, text, size);
+
+  while(size < width)
+  {
+    size_t pad = ((width - size) < (sizeof(blanks) - 1U)) ? (width - size) : (sizeof(blanks) - 1U);
+
+    StrScan_Put(out, blanks, pad);
+    size += pad;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_PrintHits
+** Description: print the strings of a scanned stream (in stream order) with their section and address. The lines
+**              are formatted in a buffer, a printf per string would cost more than the scan of the section.
+** Parameter:   const sStrScanState* scan
+** Return:      void
+*******************************************************************************************************************/
+static void StrScan_PrintHits(const sStrScanState* scan)
+{
+  static const char digits[] = "0123456789abcdef";
+  sStrScanOut       out;
+  char              text[STRSCAN_TEXT_CHUNK];
+  uint32            s = 0;
+
+  out.fill = 0;
+
+  for(uint32 h = 0; h < scan->HitsNbr; h++)
+  {
+    const sStrScanHit*     hit     = &scan->hits[h];
+    const sStrScanSegment* segment = NULL;
+    uint64                 step    = (hit->encoding == STRSCAN_ASCII) ? 1U : 2U;
+    uint64                 pos     = hit->offset + ((hit->encoding == STRSCAN_UTF16BE) ? 1U : 0U);
+    uint64                 addr    = 0;
+    uint32                 fill    = sizeof(text);
+
+    while(scan->segments[s].offset + scan->segments[s].size <= hit->offset)
+    {
+      s++;
+    }
+    segment = &scan->segments[s];
+    addr    = segment->addr + hit->offset - segment->offset;
+
+    //0x<address> in a column of 18 characters
+    text[--fill] = '\0';
+    do
+    {
+      text[--fill] = digits[addr & 0xFU];
+      addr >>= 4;
+    }while(addr != 0);
+    text[--fill] = 'x';
+    text[--fill] = '0';
+
+    StrScan_PutField(&out, segment->name, 24U);
+    StrScan_PutField(&out, &text[fill], 18U);
+    StrScan_PutField(&out, StrScan_Encoding(hit->encoding), 10U);
+
+    if(step == 1U && pos + hit->length <= segment->offset + segment->size)
+    {
+      StrScan_Put(&out, (const char*)&segment->data[pos - segment->offset], (size_t)hit->length);
+    }
+    else
+    {
+      uint32 j = s;
+
+      fill = 0;
+      for(uint64 k = 0; k < hit->length; k++, pos += step)
+      {
+        while(scan->segments[j].offset + scan->segments[j].size <= pos)
+        {
+          j++;
+        }
+        text[fill++] = (char)scan->segments[j].data[pos - scan->segments[j].offset];
+
+        if(fill == sizeof(text))
+        {
+          StrScan_Put(&out, text, fill);
+          fill = 0;
+        }
+      }
+      StrScan_Put(&out, text, fill);
+    }
+    StrScan_Put(&out, "\n", 1U);
+  }
+
+  fwrite(out.buffer, 1, out.fill, stdout);
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Stream
+** Description: number the segments of a stream (offsets in the stream) and return how many follow without a gap:
+**              in the load image the sections which are contiguous in memory are scanned as one stream, so that
+**              a string crossing a section boundary is found as a whole
+** Parameter:   const sStrScanSpec* spec, sStrScanSegment* segments, uint32 count, uint64* scanned
+** Return:      uint32 (segments of the stream)
+*******************************************************************************************************************/
+static uint32 StrScan_Stream(const sStrScanSpec* spec, sStrScanSegment* segments, uint32 count, uint64* scanned)
+{
+  uint32 n = 1;
+
+  segments[0].offset = 0;
+
+  while(spec->image && n < count && segments[n - 1].addr + segments[n - 1].size == segments[n].addr)
+  {
+    segments[n].offset = segments[n - 1].offset + segments[n - 1].size;
+    n++;
+  }
+
+  *scanned = segments[n - 1].offset + segments[n - 1].size;
+  return(n);
+}
+
+/*******************************************************************************************************************
+** Function:    StrScan_Report
+** Description: print the printable strings of the selected sections (or of the load image) with the section and
+**              the address where each one starts (for the sections which are not loaded, the offset in the
+**              section)
+** Parameter:   sElf* elf, const char* request (see StrScan_ParseSpec)
+** Return:      boolean
+*******************************************************************************************************************/
+boolean StrScan_Report(sElf* elf, const char* request)
+{
+  sArena*          scratch  = Arena_Thread();
+  sArenaMark       mark     = Arena_Mark(scratch);
+  sStrScanSpec     spec;
+  sStrScanState     scan;
+  sStrScanSegment* segments = NULL;
+  uint32           count    = 0;
+  uint32           streams  = 0;
+  uint64           total    = 0;
+  uint64           strings  = 0;
+  boolean          result   = TRUE;
+
+  if(!StrScan_ParseSpec(&spec, request))
+  {
+    return(FALSE);
+  }
+
+  if(spec.image)
+  {
+    sImage image;
+
+    if(!Image_BuildFromElf(&image, elf))
+    {
+      return(FALSE);
+    }
+
+    segments = (sStrScanSegment*)Arena_Calloc(scratch, image.RegionsNbr + 1U, sizeof(sStrScanSegment));
+
+    for(uint32 i = 0; segments != NULL && i < image.RegionsNbr; i++)
+    {
+      segments[count].addr = image.regions[i].addr;
+      segments[count].data = image.regions[i].data;
+      segments[count].size = image.regions[i].size;
+      segments[count].name = image.regions[i].name;
+      count++;
+    }
+    Image_Release(&image);
+  }
+  else
+  {
+    sElfSection* sections = NULL;
+    uint32       SecNbr   = 0;
+
+    if(!Elf_GetSections(elf, &sections, &SecNbr))
+    {
+      return(FALSE);
+    }
+
+    segments = (sStrScanSegment*)Arena_Calloc(scratch, SecNbr + 1U, sizeof(sStrScanSegment));
+
+    if(segments != NULL && spec.SectionsNbr > 0)
+    {
+      for(uint32 i = 0; i < spec.SectionsNbr; i++)
+      {
+        sElfSection* section = Elf_FindSection(elf, spec.sections[i]);
+
+        if(section == NULL || section->data == NULL)
+        {
+          printf("\n\r error: No section '%s' with a content in the file !\n\r", spec.sections[i]);
+          Arena_Rewind(scratch, mark);
+          return(FALSE);
+        }
+        segments[count].addr = section->addr;
+        segments[count].data = (const uint8*)section->data;
+        segments[count].size = section->size;
+        segments[count].name = section->name;
+        count += (section->size > 0) ? 1U : 0U;
+      }
+    }
+    else
+    {
+      for(uint32 i = 0; segments != NULL && i < SecNbr; i++)
+      {
+        if(sections[i].data != NULL && sections[i].size > 0)
+        {
+          segments[count].addr = sections[i].addr;
+          segments[count].data = (const uint8*)sections[i].data;
+          segments[count].size = sections[i].size;
+          segments[count].name = sections[i].name;
+          count++;
+        }
+      }
+    }
+  }
+
+  if(segments == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    return(FALSE);
+  }
+
+  printf("\nSTRINGS : %s", spec.image ? "load image, " : "");
+  for(uint32 e = STRSCAN_ASCII, sep = 0; e <= STRSCAN_UTF16BE; e <<= 1)
+  {
+    if((spec.encodings & e) != 0)
+    {
+      printf("%s%s", (sep++ > 0) ? "+" : "", StrScan_Encoding(e));
+    }
+  }
+  printf(", at least %u character(s)\n", spec.min);
+  printf("\n%-24s%-18s%-10s%s\n\n", "Section", "Address", "Encoding", "String");
+
+  memset(&scan, 0, sizeof(scan));
+  scan.spec = &spec;
+
+  for(uint32 first = 0; first < count && result; first += scan.SegmentsNbr)
+  {
+    boolean sorted = TRUE;
+
+    scan.segments    = &segments[first];
+    scan.SegmentsNbr = StrScan_Stream(&spec, &segments[first], count - first, &scan.size);
+    scan.HitsNbr     = 0;
+    total           += scan.size;
+    streams++;
+
+    result = StrScan_ScanStream(&scan);
+
+    for(uint32 h = 1; h < scan.HitsNbr && sorted; h++)
+    {
+      sorted = (boolean)(scan.hits[h - 1].offset <= scan.hits[h].offset);
+    }
+    if(!sorted)
+    {
+      qsort(scan.hits, scan.HitsNbr, sizeof(sStrScanHit), StrScan_CompareHits);
+    }
+
+    if((spec.encodings & (STRSCAN_UTF16LE | STRSCAN_UTF16BE)) == (STRSCAN_UTF16LE | STRSCAN_UTF16BE))
+    {
+      StrScan_DropTwins(&scan, Elf_IsBigEndian(elf) ? STRSCAN_UTF16BE : STRSCAN_UTF16LE);
+    }
+
+    StrScan_PrintHits(&scan);
+    strings += scan.HitsNbr;
+  }
+
+  if(!result)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+  }
+
+  printf("\n%llu string(s), %llu byte(s) scanned in %u %s\n", (unsigned long long)strings,
+         (unsigned long long)total, streams, spec.image ? "contiguous range(s)" : "section(s)");
+
+  free(scan.hits);
+  Arena_Rewind(scratch, mark);
+  return(result);
+}
@@ -0,0 +1,36 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __STRSCAN_H__
+#define __STRSCAN_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define STRSCAN_MAX_SECTIONS  32U       //sections named in one request
+#define STRSCAN_DEFAULT_MIN   4U        //shortest reported string (characters)
+#define STRSCAN_BLOCK         64U       //bytes classified per step
+
+#define STRSCAN_ASCII         0x1U
+#define STRSCAN_UTF16LE       0x2U
+#define STRSCAN_UTF16BE       0x4U
+
+//parsed -strings request
+typedef struct
+{
+  uint32  min;
+  uint32  encodings;                  //STRSCAN_ASCII | STRSCAN_UTF16LE | STRSCAN_UTF16BE
+  boolean image;                      //scan the load image instead of the sections
+  char*   sections[STRSCAN_MAX_SECTIONS];
+  uint32  SectionsNbr;                //0: every section with a content in the file
+  char    copy[MAX_LINE_LEN];
+}sStrScanSpec;
+
+boolean StrScan_ParseSpec(sStrScanSpec* spec, const char* text);
+boolean StrScan_Report(sElf* elf, const char* request);
+
+#endif
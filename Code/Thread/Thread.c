@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Thread.h>
+#include<Arena.h>
+
+#if !defined(_WIN32)
+  #include<pthread.h>
+  #include<unistd.h>
+#endif
+
+//shared state of one parallel loop, the workers take the next index from a common counter
+typedef struct
+{
+  volatile long next;
+  uint32        count;
+  pfThreadJob   job;
+  void*         ctx;
+}sThreadLoop;
+
+/*******************************************************************************************************************
+** Function:    Thread_NextIndex
+** Description: atomically take the next index of the loop
+** Parameter:   sThreadLoop* loop
+** Return:      uint32 (count when the loop is done)
+*******************************************************************************************************************/
+static uint32 Thread_NextIndex(sThreadLoop* loop)
+{
+#if defined(_WIN32)
+  long index = InterlockedIncrement(&loop->next) - 1;
+#else
+  long index = __sync_fetch_and_add(&loop->next, 1);
+#endif
+
+  return(((uint32)index < loop->count) ? (uint32)index : loop->count);
+}
+
+/*******************************************************************************************************************
+** Function:    Thread_Worker
+** Description: run jobs until all the indexes of the loop are taken
+** Parameter:   void* param (sThreadLoop*)
+** Return:      void
+*******************************************************************************************************************/
+static void Thread_Worker(void* param)
+{
+  sThreadLoop* loop = (sThreadLoop*)param;
+
+  for(uint32 index = Thread_NextIndex(loop); index < loop->count; index = Thread_NextIndex(loop))
+  {
+    loop->job(index, loop->ctx);
+  }
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI Thread_Entry(LPVOID param)
+{
+  Thread_Worker(param);
+  Arena_ReleaseThread();
+  return(0);
+}
+#else
+static void* Thread_Entry(void* param)
+{
+  Thread_Worker(param);
+  Arena_ReleaseThread();
+  return(NULL);
+}
+#endif
+
+/*******************************************************************************************************************
+** Function:    Thread_GetWorkersNbr
+** Description: number of worker threads used by the parallel loops (one per logical CPU)
+** Parameter:   void
+** Return:      uint32
+*******************************************************************************************************************/
+uint32 Thread_GetWorkersNbr(void)
+{
+  static uint32 workers = 0;
+
+  if(workers == 0)
+  {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    workers = (uint32)info.dwNumberOfProcessors;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = (cpus > 0) ? (uint32)cpus : 1U;
+#endif
+    if(workers == 0)
+    {
+      workers = 1;
+    }
+    if(workers > THREAD_MAX_WORKERS)
+    {
+      workers = THREAD_MAX_WORKERS;
+    }
+  }
+  return(workers);
+}
+
+/*******************************************************************************************************************
+** Function:    Thread_ParallelFor
+** Description: call job(index, ctx) for every index in [0, count), spread over the worker threads.
+**              The calling thread takes part in the loop and the function returns when every job is done.
+**              Falls back to a plain loop when no thread can be started.
+** Parameter:   uint32 count, pfThreadJob job, void* ctx
+** Return:      void
+*******************************************************************************************************************/
+void Thread_ParallelFor(uint32 count, pfThreadJob job, void* ctx)
+{
+  sThreadLoop loop;
+  uint32      workers = Thread_GetWorkersNbr();
+  uint32      started = 0;
+#if defined(_WIN32)
+  HANDLE      threads[THREAD_MAX_WORKERS];
+#else
+  pthread_t   threads[THREAD_MAX_WORKERS];
+#endif
+
+  if(count == 0 || job == NULL)
+  {
+    return;
+  }
+
+  loop.next  = 0;
+  loop.count = count;
+  loop.job   = job;
+  loop.ctx   = ctx;
+
+  if(workers > count)
+  {
+    workers = count;
+  }
+
+  /* the calling thread is the first worker */
+  for(uint32 i = 1; i < workers; i++)
+  {
+#if defined(_WIN32)
+    threads[started] = CreateThread(NULL, 0, Thread_Entry, &loop, 0, NULL);
+    if(threads[started] == NULL)
+    {
+      break;
+    }
+#else
+    if(pthread_create(&threads[started], NULL, Thread_Entry, &loop) != 0)
+    {
+      break;
+    }
+#endif
+    started++;
+  }
+
+  Thread_Worker(&loop);
+
+  for(uint32 i = 0; i < started; i++)
+  {
+#if defined(_WIN32)
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+#else
+    pthread_join(threads[i], NULL);
+#endif
+  }
+}
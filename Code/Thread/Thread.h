@@ -0,0 +1,21 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __THREAD_H__
+#define __THREAD_H__
+
+#include<common.h>
+
+#define THREAD_MAX_WORKERS  64U
+
+//one job of a parallel loop, called once for each index in [0, count)
+typedef void (*pfThreadJob)(uint32 index, void* ctx);
+
+uint32 Thread_GetWorkersNbr(void);
+void   Thread_ParallelFor(uint32 count, pfThreadJob job, void* ctx);
+
+#endif
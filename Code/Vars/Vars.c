@@ -0,0 +1,727 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+/*******************************************************************************************************************
+** Bulk extraction of the initial value of symbols (-vars).
+**
+** The request names the symbols and/or patterns ("sym=cal_gain+tab_*+@vars.txt"), the output format and the output
+** ("fmt=hex|bin|json,out=<path>"). The selection is made in one pass over the symbol table: a symbol name is looked
+** up in the sorted names of the request, then matched against the (few) patterns. The content of a symbol is read
+** in place in the loaded file, through its section (st_shndx, st_value and sh_offset, see Elf_GetSymbols), and is
+** written out without an intermediate copy. A named symbol of a NOBITS section (.bss) has no initial value in the
+** file and is an error, the uninitialized symbols found by a pattern are skipped.
+*******************************************************************************************************************/
+
+#include<Vars.h>
+#include<io.h>
+#include<Stats.h>
+#include<ctype.h>
+
+#define VARS_OUT_BUFFER  0x10000U     //bytes of the output buffer
+
+//buffered output of a report
+typedef struct
+{
+  FILE*  file;
+  uint64 written;
+  size_t fill;
+  char   buffer[VARS_OUT_BUFFER];
+}sVarsOut;
+
+static boolean Vars_AddName(sVarsSpec* spec, char* name);
+static boolean Vars_AddList(sVarsSpec* spec, char* path);
+static boolean Vars_IsPattern(const char* name);
+static int     Vars_CompareNames(const void* a, const void* b);
+static int     Vars_CompareKey(const void* key, const void* name);
+static int     Vars_CompareSymbols(const void* a, const void* b);
+static void    Vars_Flush(sVarsOut* out);
+static void    Vars_Put(sVarsOut* out, const char* data, size_t size);
+static void    Vars_PutText(sVarsOut* out, const char* text);
+static void    Vars_PutHex(sVarsOut* out, const uint8* data, uint64 size);
+static void    Vars_PutJsonString(sVarsOut* out, const char* text);
+static boolean Vars_WriteFiles(const sVarsSpec* spec, const sElfSymbol** selected, uint32 count);
+static void    Vars_WriteRecords(sVarsOut* out, const sVarsSpec* spec, const sElfSymbol** selected, uint32 count,
+                                 const sElfSection* sections, uint32 SecNbr);
+
+/*******************************************************************************************************************
+** Function:    Vars_AddName
+** Description: add a symbol name or pattern to the request
+** Parameter:   sVarsSpec* spec, char* name
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Vars_AddName(sVarsSpec* spec, char* name)
+{
+  if(spec->NamesNbr == spec->capacity)
+  {
+    uint32 capacity = (spec->capacity == 0) ? 64U : 2U * spec->capacity;
+    char** names    = (char**)realloc(spec->names, (size_t)capacity * sizeof(char*));
+
+    if(names == NULL)
+    {
+      printf("\n\r error: Out of memory !\n\r");
+      return(FALSE);
+    }
+    spec->names    = names;
+    spec->capacity = capacity;
+  }
+
+  spec->names[spec->NamesNbr++] = name;
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_AddList
+** Description: add the names of a list file (one name or pattern per line, '#' starts a comment line)
+** Parameter:   sVarsSpec* spec, char* path
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Vars_AddList(sVarsSpec* spec, char* path)
+{
+  char*   text   = NULL;
+  boolean result = TRUE;
+
+  if(spec->ListsNbr == VARS_MAX_LISTS)
+  {
+    return(FALSE);
+  }
+
+  text = (char*)LoadInputFile(path, NULL);
+
+  if(text == NULL)
+  {
+    return(FALSE);
+  }
+  spec->lists[spec->ListsNbr++] = text;
+
+  for(char* line = text; line != NULL && result; )
+  {
+    char* next = strchr(line, '\n');
+
+    if(next != NULL)
+    {
+      *next++ = '\0';
+    }
+
+    while(isspace((unsigned char)*line)) { line++; }
+    line[strcspn(line, " \t\r")] = '\0';
+
+    if(line[0] != '\0' && line[0] != '#')
+    {
+      result = Vars_AddName(spec, line);
+    }
+    line = next;
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_IsPattern
+** Description: tell whether a name holds a wildcard
+** Parameter:   const char* name
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Vars_IsPattern(const char* name)
+{
+  return((boolean)(strpbrk(name, "*?") != NULL));
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_CompareNames
+** Description: qsort callback: the symbol names in alphabetical order, then the patterns
+** Parameter:   const void* a, const void* b (char**)
+** Return:      int
+*******************************************************************************************************************/
+static int Vars_CompareNames(const void* a, const void* b)
+{
+  const char* na = *(const char* const*)a;
+  const char* nb = *(const char* const*)b;
+  boolean     pa = Vars_IsPattern(na);
+  boolean     pb = Vars_IsPattern(nb);
+
+  if(pa != pb)
+  {
+    return(pa ? 1 : -1);
+  }
+  return(strcmp(na, nb));
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_CompareKey
+** Description: bsearch callback: symbol name against a name of the request
+** Parameter:   const void* key (const char*), const void* name (char**)
+** Return:      int
+*******************************************************************************************************************/
+static int Vars_CompareKey(const void* key, const void* name)
+{
+  return(strcmp((const char*)key, *(const char* const*)name));
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_CompareSymbols
+** Description: qsort callback: selected symbols by name, then by address
+** Parameter:   const void* a, const void* b (const sElfSymbol**)
+** Return:      int
+*******************************************************************************************************************/
+static int Vars_CompareSymbols(const void* a, const void* b)
+{
+  const sElfSymbol* sa     = *(const sElfSymbol* const*)a;
+  const sElfSymbol* sb     = *(const sElfSymbol* const*)b;
+  int               result = strcmp(sa->name, sb->name);
+
+  if(result == 0)
+  {
+    result = (sa->value < sb->value) ? -1 : ((sa->value > sb->value) ? 1 : 0);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_Match
+** Description: match a name against a pattern ('*' any string, '?' any character). Only the last '*' is a
+**              backtracking point, so the match needs no recursion.
+** Parameter:   const char* pattern, const char* name
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Vars_Match(const char* pattern, const char* name)
+{
+  const char* star = NULL;
+  const char* mark = NULL;
+
+  while(*name != '\0')
+  {
+    if(*pattern == '*')
+    {
+      star = ++pattern;
+      mark = name;
+    }
+    else if(*pattern == '?' || *pattern == *name)
+    {
+      pattern++;
+      name++;
+    }
+    else if(star != NULL)
+    {
+      pattern = star;
+      name    = ++mark;
+    }
+    else
+    {
+      return(FALSE);
+    }
+  }
+
+  while(*pattern == '*')
+  {
+    pattern++;
+  }
+  return((boolean)(*pattern == '\0'));
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_Flush
+** Description: write the output buffer
+** Parameter:   sVarsOut* out
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_Flush(sVarsOut* out)
+{
+  fwrite(out->buffer, 1, out->fill, out->file);
+  out->written += out->fill;
+  out->fill     = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_Put
+** Description: append to the output buffer, written when full
+** Parameter:   sVarsOut* out, const char* data, size_t size
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_Put(sVarsOut* out, const char* data, size_t size)
+{
+  if(out->fill + size > sizeof(out->buffer))
+  {
+    Vars_Flush(out);
+
+    if(size > sizeof(out->buffer))
+    {
+      fwrite(data, 1, size, out->file);
+      out->written += size;
+      return;
+    }
+  }
+
+  memcpy(&out->buffer[out->fill], data, size);
+  out->fill += size;
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_PutText
+** Description: append a string to the output buffer
+** Parameter:   sVarsOut* out, const char* text
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_PutText(sVarsOut* out, const char* text)
+{
+  Vars_Put(out, text, strlen(text));
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_PutHex
+** Description: append the content of a symbol in hexadecimal, converted directly in the output buffer
+** Parameter:   sVarsOut* out, const uint8* data, uint64 size
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_PutHex(sVarsOut* out, const uint8* data, uint64 size)
+{
+  static const char digits[] = "0123456789ABCDEF";
+
+  while(size > 0)
+  {
+    uint64 chunk = (sizeof(out->buffer) - out->fill) / 2U;
+    char*  p     = &out->buffer[out->fill];
+
+    if(chunk == 0)
+    {
+      Vars_Flush(out);
+      continue;
+    }
+
+    chunk = (chunk < size) ? chunk : size;
+
+    for(uint64 i = 0; i < chunk; i++)
+    {
+      *p++ = digits[data[i] >> 4];
+      *p++ = digits[data[i] & 0x0FU];
+    }
+
+    out->fill += (size_t)(2U * chunk);
+    data      += chunk;
+    size      -= chunk;
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_PutJsonString
+** Description: append a quoted JSON string
+** Parameter:   sVarsOut* out, const char* text
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_PutJsonString(sVarsOut* out, const char* text)
+{
+  Vars_Put(out, "\"", 1);
+
+  for(const char* p = text; *p != '\0'; p++)
+  {
+    char escape[8];
+
+    if(*p == '"' || *p == '\\')
+    {
+      escape[0] = '\\';
+      escape[1] = *p;
+      Vars_Put(out, escape, 2);
+    }
+    else if((unsigned char)*p < 0x20U)
+    {
+      snprintf(escape, sizeof(escape), "\\u%04x", (unsigned int)(unsigned char)*p);
+      Vars_Put(out, escape, 6);
+    }
+    else
+    {
+      Vars_Put(out, p, 1);
+    }
+  }
+
+  Vars_Put(out, "\"", 1);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_ParseSpec
+** Description: parse "sym=<name>[+<name>...][,fmt=hex|bin|json][,out=<path>]". A name is a symbol name, a pattern
+**              ('*', '?') or @<file> (one name or pattern per line). fmt=bin writes one <name>.bin file per symbol
+**              in the directory out. The names are kept for all the images of the run (see Vars_ReleaseSpec).
+** Parameter:   sVarsSpec* spec, const char* text
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Vars_ParseSpec(sVarsSpec* spec, const char* text)
+{
+  char*   item   = NULL;
+  boolean result = TRUE;
+
+  memset(spec, 0, sizeof(sVarsSpec));
+  spec->format = VARS_HEX;
+
+  if(text == NULL || strlen(text) >= sizeof(spec->copy))
+  {
+    result = FALSE;
+  }
+  else
+  {
+    strcpy(spec->copy, text);
+  }
+
+  for(item = result ? strtok(spec->copy, ",") : NULL; item != NULL && result; item = strtok(NULL, ","))
+  {
+    char* value = strchr(item, '=');
+
+    if(value == NULL)
+    {
+      result = FALSE;
+      break;
+    }
+    *value++ = '\0';
+
+    if(0 == strcmp(item, "sym"))
+    {
+      for(char* name = value; name != NULL && result; )
+      {
+        char* next = strchr(name, '+');
+
+        if(next != NULL)
+        {
+          *next++ = '\0';
+        }
+
+        if(*name == '\0')
+        {
+          result = FALSE;
+        }
+        else
+        {
+          result = (name[0] == '@') ? Vars_AddList(spec, &name[1]) : Vars_AddName(spec, name);
+        }
+        name = next;
+      }
+    }
+    else if(0 == strcmp(item, "fmt"))
+    {
+      if(0 == strcmp(value, "hex"))       { spec->format = VARS_HEX;  }
+      else if(0 == strcmp(value, "bin"))  { spec->format = VARS_BIN;  }
+      else if(0 == strcmp(value, "json")) { spec->format = VARS_JSON; }
+      else
+      {
+        result = FALSE;
+      }
+    }
+    else if(0 == strcmp(item, "out"))
+    {
+      spec->out = value;
+      result    = (boolean)(*value != '\0');
+    }
+    else
+    {
+      result = FALSE;
+    }
+  }
+
+  if(result && (spec->NamesNbr == 0 || (spec->format == VARS_BIN && spec->out == NULL)))
+  {
+    result = FALSE;
+  }
+
+  if(result)
+  {
+    uint32 unique = 0;
+
+    qsort(spec->names, spec->NamesNbr, sizeof(char*), Vars_CompareNames);
+
+    /* the names given twice are kept once, so that each symbol is extracted once */
+    for(uint32 i = 0; i < spec->NamesNbr; i++)
+    {
+      if(unique == 0 || 0 != strcmp(spec->names[unique - 1], spec->names[i]))
+      {
+        spec->names[unique++] = spec->names[i];
+      }
+    }
+    spec->NamesNbr = unique;
+
+    while(spec->ExactNbr < spec->NamesNbr && !Vars_IsPattern(spec->names[spec->ExactNbr]))
+    {
+      spec->ExactNbr++;
+    }
+  }
+  else
+  {
+    printf("\n\r error: Bad variables request '%s' (sym=<name>[+<name>|+<pattern>|+@<file>][,fmt=hex|bin|json]"
+           "[,out=<path>]) !\n\r", (text != NULL) ? text : "");
+    Vars_ReleaseSpec(spec);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_ReleaseSpec
+** Description: free the names of a request
+** Parameter:   sVarsSpec* spec
+** Return:      void
+*******************************************************************************************************************/
+void Vars_ReleaseSpec(sVarsSpec* spec)
+{
+  for(uint32 i = 0; i < spec->ListsNbr; i++)
+  {
+    free(spec->lists[i]);
+  }
+
+  free(spec->names);
+  spec->names    = NULL;
+  spec->NamesNbr = 0;
+  spec->ExactNbr = 0;
+  spec->capacity = 0;
+  spec->ListsNbr = 0;
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_WriteFiles
+** Description: write the content of each symbol in <out>/<name>.bin (<name>@<address>.bin for a name defined more
+**              than once). The characters of a name that are not valid in a file name are replaced by '_'.
+** Parameter:   const sVarsSpec* spec, const sElfSymbol** selected (sorted by name), uint32 count
+** Return:      boolean
+*******************************************************************************************************************/
+static boolean Vars_WriteFiles(const sVarsSpec* spec, const sElfSymbol** selected, uint32 count)
+{
+  char    path[MAX_LINE_LEN];
+  char    name[MAX_LINE_LEN];
+  boolean result = TRUE;
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    const sElfSymbol* symbol = selected[i];
+    boolean           twin   = (boolean)((i > 0 && 0 == strcmp(selected[i - 1]->name, symbol->name)) ||
+                                         (i + 1 < count && 0 == strcmp(selected[i + 1]->name, symbol->name)));
+    size_t            length = 0;
+
+    for(const char* p = symbol->name; *p != '\0' && length < sizeof(name) - 1; p++)
+    {
+      name[length++] = (isalnum((unsigned char)*p) || *p == '_' || *p == '.' || *p == '$' || *p == '-') ? *p : '_';
+    }
+    name[length] = '\0';
+
+    if(twin)
+    {
+      snprintf(path, sizeof(path), "%s/%s@%llx.bin", spec->out, name, (unsigned long long)symbol->value);
+    }
+    else
+    {
+      snprintf(path, sizeof(path), "%s/%s.bin", spec->out, name);
+    }
+
+    result = (boolean)(SaveBinaryFile(path, symbol->data, (uint32)symbol->size) && result);
+  }
+  return(result);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_WriteRecords
+** Description: write the hexadecimal lines or the JSON records of the selected symbols
+** Parameter:   sVarsOut* out, const sVarsSpec* spec, const sElfSymbol** selected, uint32 count,
+**              const sElfSection* sections, uint32 SecNbr
+** Return:      void
+*******************************************************************************************************************/
+static void Vars_WriteRecords(sVarsOut* out, const sVarsSpec* spec, const sElfSymbol** selected, uint32 count,
+                              const sElfSection* sections, uint32 SecNbr)
+{
+  char field[64];
+
+  if(spec->format == VARS_JSON)
+  {
+    Vars_PutText(out, "[");
+  }
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    const sElfSymbol* symbol = selected[i];
+
+    if(spec->format == VARS_JSON)
+    {
+      const char* section = (symbol->shndx < SecNbr) ? sections[symbol->shndx].name : "";
+
+      Vars_PutText(out, (i == 0) ? "\n  {\"name\": " : ",\n  {\"name\": ");
+      Vars_PutJsonString(out, symbol->name);
+      snprintf(field, sizeof(field), ", \"address\": \"0x%llx\", \"size\": %llu, \"section\": ",
+               (unsigned long long)symbol->value, (unsigned long long)symbol->size);
+      Vars_PutText(out, field);
+      Vars_PutJsonString(out, section);
+      Vars_PutText(out, ", \"data\": \"");
+      Vars_PutHex(out, (const uint8*)symbol->data, symbol->size);
+      Vars_PutText(out, "\"}");
+    }
+    else
+    {
+      Vars_PutText(out, symbol->name);
+      snprintf(field, sizeof(field), " 0x%llx %llu ", (unsigned long long)symbol->value,
+               (unsigned long long)symbol->size);
+      Vars_PutText(out, field);
+      Vars_PutHex(out, (const uint8*)symbol->data, symbol->size);
+      Vars_PutText(out, "\n");
+    }
+  }
+
+  if(spec->format == VARS_JSON)
+  {
+    Vars_PutText(out, (count > 0) ? "\n]\n" : "]\n");
+  }
+
+  Vars_Flush(out);
+}
+
+/*******************************************************************************************************************
+** Function:    Vars_Report
+** Description: extract the content of the symbols of the request in the requested format
+** Parameter:   sElf* elf, const sVarsSpec* spec
+** Return:      boolean (FALSE if a named symbol is missing or has no content in the file)
+*******************************************************************************************************************/
+boolean Vars_Report(sElf* elf, const sVarsSpec* spec)
+{
+  sArena*            scratch  = Arena_Thread();
+  sArenaMark         mark     = Arena_Mark(scratch);
+  sElfSymbol*        symbols  = NULL;
+  sElfSection*       sections = NULL;
+  uint32             SymNbr   = 0;
+  uint32             SecNbr   = 0;
+  const sElfSymbol** selected = NULL;
+  uint32             count    = 0;
+  uint32             skipped  = 0;
+  uint64             bytes    = 0;
+  uint8*             found    = NULL;
+  boolean            result   = TRUE;
+
+  if(!Elf_GetSymbols(elf, &symbols, &SymNbr) || !Elf_GetSections(elf, &sections, &SecNbr))
+  {
+    printf("\n\r error: No symbol table to extract the variables !\n\r");
+    return(FALSE);
+  }
+
+  selected = (const sElfSymbol**)Arena_Alloc(scratch, ((size_t)SymNbr + 1) * sizeof(sElfSymbol*));
+  found    = (uint8*)Arena_Calloc(scratch, (size_t)spec->ExactNbr + 1, sizeof(uint8));
+
+  if(selected == NULL || found == NULL)
+  {
+    printf("\n\r error: Out of memory !\n\r");
+    Arena_Rewind(scratch, mark);
+    return(FALSE);
+  }
+
+  for(uint32 i = 0; i < SymNbr; i++)
+  {
+    const sElfSymbol* symbol = &symbols[i];
+    uint32            type   = ELF32_ST_TYPE(symbol->info);
+    boolean           nobits = (boolean)(type == STT_COMMON ||
+                                         (symbol->shndx < SecNbr && sections[symbol->shndx].type == SHT_NOBITS));
+    char**            exact  = NULL;
+
+    if(symbol->shndx == 0 || type == STT_SECTIONS || type == STT_FILE || symbol->name[0] == '\0')
+    {
+      continue;
+    }
+
+    exact = (char**)bsearch(symbol->name, spec->names, spec->ExactNbr, sizeof(char*), Vars_CompareKey);
+
+    if(exact != NULL)
+    {
+      found[exact - spec->names] = 1;
+
+      if(nobits)
+      {
+        printf("\n\r error: The symbol '%s' is uninitialized data (%s), it has no content in the file !\n\r",
+               symbol->name, (symbol->shndx < SecNbr) ? sections[symbol->shndx].name : "COMMON");
+        result = FALSE;
+      }
+      else if(symbol->data == NULL)
+      {
+        printf("\n\r error: The symbol '%s' has no content in the file !\n\r", symbol->name);
+        result = FALSE;
+      }
+      else
+      {
+        selected[count++] = symbol;
+      }
+      continue;
+    }
+
+    if(symbol->size == 0 || (type != STT_OBJECT && type != STT_TLS))
+    {
+      continue;
+    }
+
+    for(uint32 p = spec->ExactNbr; p < spec->NamesNbr; p++)
+    {
+      if(Vars_Match(spec->names[p], symbol->name))
+      {
+        if(nobits || symbol->data == NULL)
+        {
+          skipped++;
+        }
+        else
+        {
+          selected[count++] = symbol;
+        }
+        break;
+      }
+    }
+  }
+
+  for(uint32 i = 0; i < spec->ExactNbr; i++)
+  {
+    if(!found[i])
+    {
+      printf("\n\r error: No symbol '%s' to extract !\n\r", spec->names[i]);
+      result = FALSE;
+    }
+  }
+
+  qsort(selected, count, sizeof(sElfSymbol*), Vars_CompareSymbols);
+
+  for(uint32 i = 0; i < count; i++)
+  {
+    bytes += selected[i]->size;
+  }
+
+  if(spec->format == VARS_BIN)
+  {
+    result = (boolean)(Vars_WriteFiles(spec, selected, count) && result);
+  }
+  else
+  {
+    sVarsOut* out = (sVarsOut*)Arena_Alloc(scratch, sizeof(sVarsOut));
+
+    if(out != NULL)
+    {
+      out->file    = (spec->out != NULL) ? fopen(spec->out, "wb") : stdout;
+      out->written = 0;
+      out->fill    = 0;
+    }
+
+    if(out == NULL || out->file == NULL)
+    {
+      printf("\n\r error: Cannot save the file !\n\r");
+      result = FALSE;
+    }
+    else
+    {
+      Vars_WriteRecords(out, spec, selected, count, sections, SecNbr);
+
+      if(out->file != stdout)
+      {
+        Stats_AddWritten(out->written);
+        fclose(out->file);
+      }
+    }
+  }
+
+  /* the report itself is the standard output, the summary is only printed with an output file */
+  if(spec->out != NULL)
+  {
+    printf("\n\r VARIABLES %u symbol(s), %llu byte(s)", count, (unsigned long long)bytes);
+    if(skipped > 0)
+    {
+      printf(", %u uninitialized symbol(s) skipped", skipped);
+    }
+    printf(" -> %s\n\r", spec->out);
+  }
+
+  Arena_Rewind(scratch, mark);
+  return(result);
+}
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __VARS_H__
+#define __VARS_H__
+
+#include<common.h>
+#include<Elf.h>
+
+#define VARS_MAX_LISTS  16U           //@<file> lists of one request
+
+#define VARS_HEX   0U                 //one "<name> <address> <size> <hex bytes>" line per symbol
+#define VARS_BIN   1U                 //one raw file per symbol in a directory
+#define VARS_JSON  2U                 //one record per symbol
+
+//parsed -vars request
+typedef struct
+{
+  char**  names;                      //symbol names (sorted) followed by the patterns ('*' and '?' wildcards)
+  uint32  ExactNbr;                   //symbol names at the start of names
+  uint32  NamesNbr;
+  uint32  capacity;
+  uint32  format;                     //VARS_HEX, VARS_BIN or VARS_JSON
+  char*   out;                        //output file (directory for VARS_BIN), NULL: standard output
+  char*   lists[VARS_MAX_LISTS];      //contents of the @<file> lists
+  uint32  ListsNbr;
+  char    copy[MAX_LINE_LEN];
+}sVarsSpec;
+
+boolean Vars_ParseSpec(sVarsSpec* spec, const char* text);
+void    Vars_ReleaseSpec(sVarsSpec* spec);
+boolean Vars_Report(sElf* elf, const sVarsSpec* spec);
+boolean Vars_Match(const char* pattern, const char* name);
+
+#endif
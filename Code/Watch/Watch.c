@@ -0,0 +1,252 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include<Watch.h>
+
+#if !defined(_WIN32)
+  #include<sys/stat.h>
+  #include<unistd.h>
+#endif
+#if defined(__linux__)
+  #include<sys/inotify.h>
+  #include<poll.h>
+#endif
+
+#define WATCH_INFINITE  0xFFFFFFFFUL
+
+static boolean Watch_Stamp(const sWatch* watch, uint64* stamp, uint64* size);
+static boolean Watch_Next(sWatch* watch, uint32 timeout, boolean* changed);
+
+/*******************************************************************************************************************
+** Function:    Watch_Open
+** Description: start watching a file (the file may not exist yet)
+** Parameter:   sWatch* watch, const char* path
+** Return:      boolean
+*******************************************************************************************************************/
+boolean Watch_Open(sWatch* watch, const char* path)
+{
+  char* separator = NULL;
+
+  memset(watch, 0, sizeof(sWatch));
+  strncpy(watch->path, path, sizeof(watch->path) - 1);
+  strncpy(watch->dir, path, sizeof(watch->dir) - 1);
+
+  separator = strrchr(watch->dir, '/');
+  if(strrchr(watch->dir, '\\') > separator)
+  {
+    separator = strrchr(watch->dir, '\\');
+  }
+
+  if(separator != NULL)
+  {
+    watch->name = &watch->path[separator - watch->dir + 1];
+    separator[(separator == watch->dir) ? 1 : 0] = '\0';
+  }
+  else
+  {
+    watch->name = watch->path;
+    strcpy(watch->dir, ".");
+  }
+
+  Watch_Stamp(watch, &watch->stamp, &watch->size);
+
+#if defined(_WIN32)
+  watch->handle = FindFirstChangeNotificationA(watch->dir, FALSE, FILE_NOTIFY_CHANGE_FILE_NAME |
+                                                                  FILE_NOTIFY_CHANGE_LAST_WRITE |
+                                                                  FILE_NOTIFY_CHANGE_SIZE);
+  return((boolean)(watch->handle != INVALID_HANDLE_VALUE));
+#elif defined(__linux__)
+  watch->fd = inotify_init();
+
+  if(watch->fd < 0)
+  {
+    return(FALSE);
+  }
+
+  if(inotify_add_watch(watch->fd, watch->dir, IN_CLOSE_WRITE | IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_DELETE) < 0)
+  {
+    close(watch->fd);
+    watch->fd = -1;
+    return(FALSE);
+  }
+  return(TRUE);
+#else
+  watch->seen = watch->stamp;
+  return(TRUE);
+#endif
+}
+
+/*******************************************************************************************************************
+** Function:    Watch_Wait
+** Description: block until a new version of the file is written. The change is reported once the file has been
+**              quiet for WATCH_SETTLE_MS (a linker writes its output in several steps) and only if its
+**              modification time or its size differs from the last reported version.
+** Parameter:   sWatch* watch
+** Return:      boolean (FALSE if the file can no longer be watched)
+*******************************************************************************************************************/
+boolean Watch_Wait(sWatch* watch)
+{
+  for(;;)
+  {
+    boolean changed = FALSE;
+    uint64  stamp   = 0;
+    uint64  size    = 0;
+
+    if(!Watch_Next(watch, WATCH_INFINITE, &changed))
+    {
+      return(FALSE);
+    }
+
+    while(changed)
+    {
+      if(!Watch_Next(watch, WATCH_SETTLE_MS, &changed))
+      {
+        return(FALSE);
+      }
+    }
+
+    if(Watch_Stamp(watch, &stamp, &size) && (stamp != watch->stamp || size != watch->size))
+    {
+      watch->stamp = stamp;
+      watch->size  = size;
+      return(TRUE);
+    }
+  }
+}
+
+/*******************************************************************************************************************
+** Function:    Watch_Close
+** Description: stop watching the file
+** Parameter:   sWatch* watch
+** Return:      void
+*******************************************************************************************************************/
+void Watch_Close(sWatch* watch)
+{
+#if defined(_WIN32)
+  if(watch->handle != INVALID_HANDLE_VALUE && watch->handle != NULL)
+  {
+    FindCloseChangeNotification(watch->handle);
+  }
+#elif defined(__linux__)
+  if(watch->fd >= 0)
+  {
+    close(watch->fd);
+  }
+#endif
+  memset(watch, 0, sizeof(sWatch));
+}
+
+/*******************************************************************************************************************
+** Function:    Watch_Stamp
+** Description: get the modification time and the size of the watched file
+** Parameter:   const sWatch* watch, uint64* stamp, uint64* size
+** Return:      boolean (FALSE if the file does not exist)
+*******************************************************************************************************************/
+static boolean Watch_Stamp(const sWatch* watch, uint64* stamp, uint64* size)
+{
+#if defined(_WIN32)
+  WIN32_FILE_ATTRIBUTE_DATA info;
+
+  if(!GetFileAttributesExA(watch->path, GetFileExInfoStandard, &info))
+  {
+    return(FALSE);
+  }
+
+  *stamp = ((uint64)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+  *size  = ((uint64)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+#else
+  struct stat info;
+
+  if(0 != stat(watch->path, &info))
+  {
+    return(FALSE);
+  }
+
+#if defined(__linux__)
+  *stamp = ((uint64)info.st_mtim.tv_sec * 1000000000ULL) + (uint64)info.st_mtim.tv_nsec;
+#else
+  *stamp = (uint64)info.st_mtime;
+#endif
+  *size  = (uint64)info.st_size;
+#endif
+  return(TRUE);
+}
+
+/*******************************************************************************************************************
+** Function:    Watch_Next
+** Description: wait up to timeout ms (WATCH_INFINITE: no limit) for a change notification of the watched file.
+**              Windows notifies the changes of the whole directory, Watch_Wait filters them by the file stamp.
+** Parameter:   sWatch* watch, uint32 timeout, boolean* changed
+** Return:      boolean (FALSE on error)
+*******************************************************************************************************************/
+static boolean Watch_Next(sWatch* watch, uint32 timeout, boolean* changed)
+{
+#if defined(_WIN32)
+  DWORD status = WaitForSingleObject(watch->handle, (timeout == WATCH_INFINITE) ? INFINITE : (DWORD)timeout);
+
+  *changed = (boolean)(status == WAIT_OBJECT_0);
+
+  if(*changed)
+  {
+    return((boolean)FindNextChangeNotification(watch->handle));
+  }
+  return((boolean)(status == WAIT_TIMEOUT));
+#elif defined(__linux__)
+  struct pollfd poller;
+  uint64        events[512];
+  ssize_t       length = 0;
+
+  *changed = FALSE;
+
+  do
+  {
+    poller.fd      = watch->fd;
+    poller.events  = POLLIN;
+    poller.revents = 0;
+
+    switch(poll(&poller, 1, (timeout == WATCH_INFINITE) ? -1 : (int)timeout))
+    {
+      case 0:  return(TRUE);
+      case 1:  break;
+      default: return(FALSE);
+    }
+
+    length = read(watch->fd, events, sizeof(events));
+
+    for(ssize_t offset = 0; offset < length;)
+    {
+      const struct inotify_event* event = (const struct inotify_event*)((const char*)events + offset);
+
+      if(event->len > 0 && 0 == strcmp(event->name, watch->name))
+      {
+        *changed = TRUE;
+      }
+      offset += (ssize_t)(sizeof(struct inotify_event) + event->len);
+    }
+  }while(!*changed && timeout == WATCH_INFINITE);
+
+  return((boolean)(length > 0));
+#else
+  uint64 stamp = 0;
+  uint64 size  = 0;
+
+  *changed = FALSE;
+
+  do
+  {
+    usleep(1000U * ((timeout < WATCH_POLL_MS) ? timeout : WATCH_POLL_MS));
+
+    if(Watch_Stamp(watch, &stamp, &size) && stamp != watch->seen)
+    {
+      watch->seen = stamp;
+      *changed    = TRUE;
+    }
+  }while(!*changed && timeout == WATCH_INFINITE);
+
+  return(TRUE);
+#endif
+}
@@ -0,0 +1,37 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Amine Chalandi 2019 - 2020.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef __WATCH_H__
+#define __WATCH_H__
+
+#include<common.h>
+
+#define WATCH_SETTLE_MS  100U      //quiet time after the last change before the file is reported
+#define WATCH_POLL_MS    250U      //period of the modification check when the system has no notification
+
+//one watched file, the notifications come from its directory so that a file replaced by a rename is seen
+typedef struct
+{
+#if defined(_WIN32)
+  HANDLE handle;
+#elif defined(__linux__)
+  int    fd;
+#else
+  uint64 seen;                     //modification time found by the last check
+#endif
+  char   dir[MAX_LINE_LEN];
+  char   path[MAX_LINE_LEN];
+  char*  name;                     //file name part of path
+  uint64 stamp;                    //modification time of the last reported version
+  uint64 size;
+}sWatch;
+
+boolean Watch_Open(sWatch* watch, const char* path);
+boolean Watch_Wait(sWatch* watch);
+void    Watch_Close(sWatch* watch);
+
+#endif